@@ -1482,6 +1482,20 @@ lineLayer.create(1, {
 /* [LineLayer-create-indexed] */
 }
 
+{
+Ui::NodeHandle node{};
+Float time{}, value{};
+/* [LineLayer-ring-strip] */
+/* Keep the last 512 samples */
+Ui::DataHandle plot = lineLayer.createRingStrip(1, 512, {}, {}, node);
+
+DOXYGEN_ELLIPSIS()
+
+/* Every frame, add the newest sample */
+lineLayer.appendRingStrip(plot, {{time, value}}, {});
+/* [LineLayer-ring-strip] */
+}
+
 {
 /* [LineLayer-style-smoothness] */
 lineLayerShared.setStyle(
@@ -341,6 +341,21 @@ AbstractTheme& AbstractTheme::setTextLayerGlyphCacheSize(const Vector3i& size, c
     return *this;
 }
 
+TextLayerSharedFlags AbstractTheme::textLayerFlags() const {
+    CORRADE_ASSERT(features() >= ThemeFeature::TextLayer,
+        "Ui::AbstractTheme::textLayerFlags(): feature not supported", {});
+    return _textLayerFlags;
+}
+
+AbstractTheme& AbstractTheme::setTextLayerFlags(const TextLayerSharedFlags flags) {
+    CORRADE_ASSERT(features() >= ThemeFeature::TextLayer,
+        "Ui::AbstractTheme::setTextLayerFlags(): feature not supported", *this);
+    CORRADE_ASSERT(flags <= TextLayerSharedFlag::FillGlyphCacheDeferred,
+        "Ui::AbstractTheme::setTextLayerFlags():" << (flags & ~TextLayerSharedFlag::FillGlyphCacheDeferred) << "isn't allowed to be set", *this);
+    _textLayerFlags = flags;
+    return *this;
+}
+
 UnsignedInt AbstractTheme::layoutLayerStyleCount() const {
     CORRADE_ASSERT(features() >= ThemeFeature::LayoutLayer,
         "Ui::AbstractTheme::layoutLayerStyleCount(): feature not supported", {});
@@ -473,6 +488,11 @@ template<class Style> struct Transition {
     Style disabled;
 };
 
+/* The disabled styles are never transitioned from in practice, as the
+   disabled transition gets applied on top of the original style only when
+   drawing. They map to themselves however, as
+   AbstractVisualLayer::Shared::precomputeStyleTransitionTables() evaluates
+   the transitions for all styles. */
 Transition<BaseStyle> styleTransition(const BaseStyle index) {
     switch(index) {
         #define _c(style)                                                   \
@@ -484,7 +504,8 @@ Transition<BaseStyle> styleTransition(const BaseStyle index) {
                 return {BaseStyle::style,                                   \
                         BaseStyle::style ## Disabled};                      \
             case BaseStyle::style ## Disabled:                              \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {BaseStyle::style ## Disabled,                       \
+                        BaseStyle::style ## Disabled};
         #define _cHoveredPressedDisabled(style)                             \
             case BaseStyle::style:                                          \
             case BaseStyle::style ## Hovered:                               \
@@ -495,7 +516,8 @@ Transition<BaseStyle> styleTransition(const BaseStyle index) {
                         BaseStyle::style ## Pressed,                        \
                         BaseStyle::style ## Disabled};                      \
             case BaseStyle::style ## Disabled:                              \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {BaseStyle::style ## Disabled,                       \
+                        BaseStyle::style ## Disabled};
         #define _cHoveredPressedPressedHoveredDisabled(style)               \
             case BaseStyle::style:                                          \
             case BaseStyle::style ## Hovered:                               \
@@ -507,7 +529,8 @@ Transition<BaseStyle> styleTransition(const BaseStyle index) {
                         BaseStyle::style ## PressedHovered,                 \
                         BaseStyle::style ## Disabled};                      \
             case BaseStyle::style ## Disabled:                              \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {BaseStyle::style ## Disabled,                       \
+                        BaseStyle::style ## Disabled};
         #define _cHoveredFocusedDisabled(style)                             \
             case BaseStyle::style:                                          \
             case BaseStyle::style ## Hovered:                               \
@@ -520,7 +543,8 @@ Transition<BaseStyle> styleTransition(const BaseStyle index) {
                         BaseStyle::style ## Focused,                        \
                         BaseStyle::style ## Disabled};                      \
             case BaseStyle::style ## Disabled:                              \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {BaseStyle::style ## Disabled,                       \
+                        BaseStyle::style ## Disabled};
         _c(Default)
         _cHoveredPressedPressedHoveredDisabled(ButtonDefault)
         _cHoveredPressedPressedHoveredDisabled(ButtonPrimary)
@@ -591,7 +615,8 @@ Transition<TextStyle> styleTransition(const TextStyle index) {
                 return {TextStyle::style ## suffix,                         \
                         TextStyle::style ## Disabled ## suffix};            \
             case TextStyle::style ## Disabled ## suffix:                    \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {TextStyle::style ## Disabled ## suffix,             \
+                        TextStyle::style ## Disabled ## suffix};
         #define _cPressedDisabled(style, suffix)                            \
             case TextStyle::style ## suffix:                                \
             case TextStyle::style ## Pressed ## suffix:                     \
@@ -601,7 +626,8 @@ Transition<TextStyle> styleTransition(const TextStyle index) {
                         TextStyle::style ## Pressed ## suffix,              \
                         TextStyle::style ## Disabled ## suffix};            \
             case TextStyle::style ## Disabled ## suffix:                    \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {TextStyle::style ## Disabled ## suffix,             \
+                        TextStyle::style ## Disabled ## suffix};
         #define _cHoveredPressedPressedHoveredDisabled(style, suffix)       \
             case TextStyle::style ## suffix:                                \
             case TextStyle::style ## Hovered ## suffix:                     \
@@ -613,11 +639,13 @@ Transition<TextStyle> styleTransition(const TextStyle index) {
                         TextStyle::style ## PressedHovered ## suffix,       \
                         TextStyle::style ## Disabled ## suffix};            \
             case TextStyle::style ## Disabled ## suffix:                    \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {TextStyle::style ## Disabled ## suffix,             \
+                        TextStyle::style ## Disabled ## suffix};
         #define _cHoveredFocusedBlinkPressedDisabled(style, suffix)         \
             case TextStyle::style ## suffix:                                \
             case TextStyle::style ## Hovered ## suffix:                     \
             case TextStyle::style ## Focused ## suffix:                     \
+            case TextStyle::style ## FocusedBlink ## suffix:                \
             case TextStyle::style ## Pressed ## suffix:                     \
                 return {TextStyle::style ## suffix,                         \
                         TextStyle::style ## Hovered ## suffix,              \
@@ -626,9 +654,9 @@ Transition<TextStyle> styleTransition(const TextStyle index) {
                         TextStyle::style ## Pressed ## suffix,              \
                         TextStyle::style ## Pressed ## suffix,              \
                         TextStyle::style ## Disabled ## suffix};            \
-            case TextStyle::style ## FocusedBlink ## suffix:                \
             case TextStyle::style ## Disabled ## suffix:                    \
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+                return {TextStyle::style ## Disabled ## suffix,             \
+                        TextStyle::style ## Disabled ## suffix};
         _c(Default,)
         _cPressedDisabled(Button,IconOnly)
         _cPressedDisabled(Button,TextOnly)
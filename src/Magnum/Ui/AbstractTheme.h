@@ -590,6 +590,31 @@ class MAGNUM_UI_EXPORT AbstractTheme {
          */
         AbstractTheme& setTextLayerGlyphCacheSize(const Vector3i& size, const Vector2i& padding = {});
 
+        /**
+         * @brief Additional flags for the text layer
+         *
+         * Expects that @ref ThemeFeature::TextLayer is supported. The returned
+         * value is passed to text layer's
+         * @ref TextLayer::Shared::Configuration::setFlags() by
+         * @ref UserInterfaceGL::setTheme(). Call @ref setTextLayerFlags() to
+         * supply additional flags if needed. Empty by default.
+         */
+        TextLayerSharedFlags textLayerFlags() const;
+
+        /**
+         * @brief Set additional text layer flags
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref ThemeFeature::TextLayer is supported and @p flags
+         * is a subset of @ref TextLayerSharedFlag::FillGlyphCacheOnDemand and
+         * @relativeref{TextLayerSharedFlag,FillGlyphCacheDeferred}. If either
+         * is set, the theme is expected to add only glyphs that are required
+         * upfront to the glyph cache and leave the rest to be filled once
+         * actually used.
+         * @see @ref textLayerFlags(), @ref features()
+         */
+        AbstractTheme& setTextLayerFlags(TextLayerSharedFlags flags);
+
         /**
          * @brief Style count for the layout layer
          *
@@ -886,6 +911,7 @@ class MAGNUM_UI_EXPORT AbstractTheme {
         BaseLayerSharedFlags
             _backgroundLayerFlagsAdd, _backgroundLayerFlagsClear,
             _baseLayerFlagsAdd, _baseLayerFlagsClear;
+        TextLayerSharedFlags _textLayerFlags;
 };
 
 }}
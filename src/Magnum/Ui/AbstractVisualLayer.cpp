@@ -37,8 +37,38 @@
 #include "Magnum/Ui/Handle.h"
 #include "Magnum/Ui/Implementation/abstractVisualLayerState.h"
 
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h> /* _BitScanForward() */
+#endif
+
 namespace Magnum { namespace Ui {
 
+namespace {
+
+/* Index of the lowest unset bit in a word that has at least one bit unset.
+   Used for finding a free dynamic style. */
+UnsignedInt findFirstUnset(const UnsignedLong word) {
+    const UnsignedLong unset = ~word;
+    CORRADE_INTERNAL_DEBUG_ASSERT(unset);
+    /* Clang also defines CORRADE_TARGET_GCC, and so does clang-cl */
+    #ifdef CORRADE_TARGET_GCC
+    return __builtin_ctzll(unset);
+    #elif defined(CORRADE_TARGET_MSVC)
+    /* Using the 32-bit variant to work on 32-bit targets as well */
+    unsigned long index;
+    if(_BitScanForward(&index, UnsignedInt(unset)))
+        return index;
+    _BitScanForward(&index, UnsignedInt(unset >> 32));
+    return 32 + index;
+    #else
+    UnsignedInt index = 0;
+    while(!(unset & (1ull << index))) ++index;
+    return index;
+    #endif
+}
+
+}
+
 AbstractVisualLayer::Shared::Shared(Containers::Pointer<State>&& state): _state{Utility::move(state)} {}
 
 AbstractVisualLayer::Shared::Shared(const UnsignedInt styleCount, const UnsignedInt dynamicStyleCount): Shared{Containers::pointer<State>(*this, styleCount, dynamicStyleCount)} {}
@@ -81,54 +111,161 @@ UnsignedInt AbstractVisualLayer::Shared::totalStyleCount() const {
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToInactiveOut() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToInactiveOut;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToInactiveOut)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToInactiveOver() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToInactiveOver;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToInactiveOver)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToFocusedOut() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToFocusedOut;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToFocusedOut)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToFocusedOver() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToFocusedOver;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToFocusedOver)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToPressedOut() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToPressedOut;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToPressedOut)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToPressedOver() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToPressedOver;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToPressedOver)];
 }
 
 auto AbstractVisualLayer::Shared::styleTransitionToDisabled() const -> UnsignedInt(*)(UnsignedInt) {
-    return _state->styleTransitionToDisabled;
+    return _state->styleTransitions[UnsignedInt(Implementation::StyleTransition::ToDisabled)];
 }
 
 AbstractVisualLayer::Shared& AbstractVisualLayer::Shared::setStyleTransition(UnsignedInt(*const toInactiveOut)(UnsignedInt), UnsignedInt(*const toInactiveOver)(UnsignedInt), UnsignedInt(*const toFocusedOut)(UnsignedInt), UnsignedInt(*const toFocusedOver)(UnsignedInt), UnsignedInt(*const toPressedOut)(UnsignedInt), UnsignedInt(*const toPressedOver)(UnsignedInt), UnsignedInt(*const toDisabled)(UnsignedInt)) {
-    _state->styleTransitionToInactiveOut = toInactiveOut ? toInactiveOut :
-        Implementation::styleTransitionPassthrough;
-    _state->styleTransitionToInactiveOver = toInactiveOver ? toInactiveOver :
-        Implementation::styleTransitionPassthrough;
-    _state->styleTransitionToFocusedOut = toFocusedOut ? toFocusedOut :
-        Implementation::styleTransitionPassthrough;
-    _state->styleTransitionToFocusedOver = toFocusedOver ? toFocusedOver :
-        Implementation::styleTransitionPassthrough;
-    _state->styleTransitionToPressedOut = toPressedOut ? toPressedOut :
-        Implementation::styleTransitionPassthrough;
-    _state->styleTransitionToPressedOver = toPressedOver ? toPressedOver :
-        Implementation::styleTransitionPassthrough;
+    State& state = *_state;
+    UnsignedInt(*const transitions[])(UnsignedInt){
+        toInactiveOut,
+        toInactiveOver,
+        toFocusedOut,
+        toFocusedOver,
+        toPressedOut,
+        toPressedOver
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(transitions); ++i)
+        state.styleTransitions[i] = transitions[i] ? transitions[i] :
+            Implementation::styleTransitionPassthrough;
+
     /* Unlike the others, this one can be nullptr, in which case the whole
        transitioning logic in doUpdate() gets replaced with a simple copy.
-       Setting it to a different function then causes doState() in all layers
-       sharing this state return NeedsDataUpdate. */
-    if(_state->styleTransitionToDisabled != toDisabled) {
-        _state->styleTransitionToDisabled = toDisabled;
-        ++_state->styleTransitionToDisabledUpdateStamp;
+       Setting it to a different function, or discarding a table that was set
+       for it, then causes doState() in all layers sharing this state return
+       NeedsDataUpdate. */
+    UnsignedInt(*&stateToDisabled)(UnsignedInt) = state.styleTransitions[UnsignedInt(Implementation::StyleTransition::ToDisabled)];
+    if(stateToDisabled != toDisabled || !state.styleTransitionTables[UnsignedInt(Implementation::StyleTransition::ToDisabled)].isEmpty()) {
+        stateToDisabled = toDisabled;
+        ++state.styleTransitionToDisabledUpdateStamp;
     }
+
+    /* Discard all previously set or precomputed tables */
+    for(Containers::ArrayView<const UnsignedInt>& table: state.styleTransitionTables)
+        table = {};
+    state.styleTransitionTableStorage = {};
+
+    return *this;
+}
+
+AbstractVisualLayer::Shared& AbstractVisualLayer::Shared::setStyleTransitionTables(const Containers::ArrayView<const UnsignedInt>& toInactiveOut, const Containers::ArrayView<const UnsignedInt>& toInactiveOver, const Containers::ArrayView<const UnsignedInt>& toFocusedOut, const Containers::ArrayView<const UnsignedInt>& toFocusedOver, const Containers::ArrayView<const UnsignedInt>& toPressedOut, const Containers::ArrayView<const UnsignedInt>& toPressedOver, const Containers::ArrayView<const UnsignedInt>& toDisabled) {
+    State& state = *_state;
+    const Containers::ArrayView<const UnsignedInt> tables[]{
+        toInactiveOut,
+        toInactiveOver,
+        toFocusedOut,
+        toFocusedOver,
+        toPressedOut,
+        toPressedOver,
+        toDisabled
+    };
+
+    /* Validate and calculate the total size first */
+    std::size_t size = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(tables); ++i) {
+        const Containers::ArrayView<const UnsignedInt> table = tables[i];
+        if(table.isEmpty())
+            continue;
+        CORRADE_ASSERT(table.size() == state.styleCount,
+            "Ui::AbstractVisualLayer::Shared::setStyleTransitionTables(): expected table" << i << "to have either 0 or" << state.styleCount << "items but got" << table.size(), *this);
+        #ifndef CORRADE_NO_ASSERT
+        for(std::size_t j = 0; j != table.size(); ++j)
+            CORRADE_ASSERT(table[j] < state.styleCount,
+                "Ui::AbstractVisualLayer::Shared::setStyleTransitionTables(): style transition from" << j << "to" << table[j] << "in table" << i << "out of range for" << state.styleCount << "styles", *this);
+        #endif
+        size += table.size();
+    }
+
+    /* Reset all functions to their defaults and copy the tables over */
+    for(std::size_t i = 0; i != Containers::arraySize(state.styleTransitions); ++i)
+        state.styleTransitions[i] = i == UnsignedInt(Implementation::StyleTransition::ToDisabled) ? nullptr : Implementation::styleTransitionPassthrough;
+    state.styleTransitionTableStorage = Containers::Array<UnsignedInt>{NoInit, size};
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(tables); ++i) {
+        const Containers::ArrayView<UnsignedInt> table = state.styleTransitionTableStorage.sliceSize(offset, tables[i].size());
+        Utility::copy(tables[i], table);
+        state.styleTransitionTables[i] = table;
+        offset += table.size();
+    }
+
+    /* Conservatively assume the toDisabled transition changed */
+    ++state.styleTransitionToDisabledUpdateStamp;
+
+    return *this;
+}
+
+AbstractVisualLayer::Shared& AbstractVisualLayer::Shared::precomputeStyleTransitionTables() {
+    State& state = *_state;
+
+    /* Count the transitions that aren't a no-op. Those that don't have a
+       function but have a table, which is the case for tables set with
+       setStyleTransitionTables(), are kept. */
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(state.styleTransitions); ++i) {
+        UnsignedInt(*const transition)(UnsignedInt) = state.styleTransitions[i];
+        if((transition && transition != Implementation::styleTransitionPassthrough) || !state.styleTransitionTables[i].isEmpty())
+            ++count;
+    }
+
+    /* Evaluate them for all styles, leaving the no-op transitions without a
+       table. The existing tables are copied to the new storage before the
+       old one gets replaced. */
+    Containers::Array<UnsignedInt> storage{NoInit, count*state.styleCount};
+    Containers::ArrayView<const UnsignedInt> tables[7];
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i != Containers::arraySize(state.styleTransitions); ++i) {
+        UnsignedInt(*const transition)(UnsignedInt) = state.styleTransitions[i];
+        const bool hasFunction = transition && transition != Implementation::styleTransitionPassthrough;
+        if(!hasFunction && state.styleTransitionTables[i].isEmpty())
+            continue;
+
+        const Containers::ArrayView<UnsignedInt> table = storage.sliceSize(offset, state.styleCount);
+        if(hasFunction) for(UnsignedInt style = 0; style != state.styleCount; ++style) {
+            const UnsignedInt nextStyle = transition(style);
+            CORRADE_ASSERT(nextStyle < state.styleCount,
+                "Ui::AbstractVisualLayer::Shared::precomputeStyleTransitionTables(): style transition from" << style << "to" << nextStyle << "in function" << i << "out of range for" << state.styleCount << "styles", *this);
+            table[style] = nextStyle;
+        } else Utility::copy(state.styleTransitionTables[i], table);
+        tables[i] = table;
+        offset += table.size();
+    }
+    CORRADE_INTERNAL_ASSERT(offset == storage.size());
+
+    for(std::size_t i = 0; i != Containers::arraySize(tables); ++i)
+        state.styleTransitionTables[i] = tables[i];
+    state.styleTransitionTableStorage = Utility::move(storage);
+
+    /* The toDisabled table evaluated from a function should have the same
+       outcome as the function or a previously precomputed table, but
+       conservatively assume it changed, same as in
+       setStyleTransitionTables(). A table that was kept is unchanged. */
+    UnsignedInt(*const toDisabled)(UnsignedInt) = state.styleTransitions[UnsignedInt(Implementation::StyleTransition::ToDisabled)];
+    if(toDisabled && toDisabled != Implementation::styleTransitionPassthrough)
+        ++state.styleTransitionToDisabledUpdateStamp;
+
     return *this;
 }
 
@@ -178,9 +315,13 @@ AbstractVisualLayer::Shared& AbstractVisualLayer::Shared::setStyleAnimation(Anim
 
 AbstractVisualLayer::State::State(Shared::State& shared): shared(shared), styleTransitionToDisabledUpdateStamp{shared.styleTransitionToDisabledUpdateStamp} {
     dynamicStyleStorage = Containers::ArrayTuple{
-        {ValueInit, shared.dynamicStyleCount, dynamicStylesUsed},
+        {ValueInit, (shared.dynamicStyleCount + 63)/64, dynamicStylesUsed},
         {ValueInit, shared.dynamicStyleCount, dynamicStyleAnimations}
     };
+    /* Mark the padding bits in the last word as used so they never get
+       allocated */
+    if(const UnsignedInt padding = shared.dynamicStyleCount % 64)
+        dynamicStylesUsed.back() = ~0ull << padding;
 }
 
 AbstractVisualLayer::AbstractVisualLayer(const LayerHandle handle, Containers::Pointer<State>&& state): AbstractLayer{handle}, _state{Utility::move(state)} {}
@@ -235,7 +376,7 @@ void AbstractVisualLayer::setStyleInternal(const UnsignedInt id, const UnsignedI
     CORRADE_INTERNAL_DEBUG_ASSERT(_state->styles.size() == capacity());
     _state->styles[id] = style;
     /* _state->calculatedStyles is filled by AbstractVisualLayer::doUpdate() */
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
     /* If the data is attached and this is a layout layer, the style likely
        affects layout properties. Trigger a layout update as well. */
     /** @todo this is too broad, LayerFeature::Layout may be used also by
@@ -270,21 +411,21 @@ void AbstractVisualLayer::transitionStyleInternal(const LayerDataHandle handle,
 
     /* Perform the transition only if the data is attached */
     const NodeHandle node = this->node(handle);
-    UnsignedInt(*transition)(UnsignedInt) = nullptr;
+    Implementation::StyleTransition transition = Implementation::StyleTransition::None;
     if(node != NodeHandle::Null) {
         const AbstractUserInterface& ui = this->ui();
         const bool hovered = ui.currentHoveredNode() == node;
         if(ui.currentPressedNode() == node) transition = hovered ?
-            sharedState.styleTransitionToPressedOver :
-            sharedState.styleTransitionToPressedOut;
+            Implementation::StyleTransition::ToPressedOver :
+            Implementation::StyleTransition::ToPressedOut;
         else if(ui.currentFocusedNode() == node) transition = hovered ?
-            sharedState.styleTransitionToFocusedOver :
-            sharedState.styleTransitionToFocusedOut;
+            Implementation::StyleTransition::ToFocusedOver :
+            Implementation::StyleTransition::ToFocusedOut;
         else transition = hovered ?
-            sharedState.styleTransitionToInactiveOver :
-            sharedState.styleTransitionToInactiveOut;
+            Implementation::StyleTransition::ToInactiveOver :
+            Implementation::StyleTransition::ToInactiveOut;
     }
-    setStyleInternal(layerDataHandleId(handle), transition ? transition(style) : style);
+    setStyleInternal(layerDataHandleId(handle), sharedState.transitionStyle(transition, style));
 }
 
 void AbstractVisualLayer::transitionStyle(const DataHandle handle, const UnsignedInt style, const Nanoseconds time) {
@@ -310,23 +451,23 @@ void AbstractVisualLayer::transitionStyleInternal(const LayerDataHandle handle,
 
     /* This logic is the same as in transitionStyleInternal(LayerDataHandle,
        UnsignedInt) above but the function delegates elsewhere. The transition
-       function has to be passed through in this case, so the delegated-to
-       function deals with it being nullptr instead of the caller. */
+       has to be passed through in this case, so the delegated-to function
+       deals with it being StyleTransition::None instead of the caller. */
 
     const NodeHandle node = this->node(handle);
-    UnsignedInt(*transition)(UnsignedInt) = nullptr;
+    Implementation::StyleTransition transition = Implementation::StyleTransition::None;
     if(node != NodeHandle::Null) {
         const AbstractUserInterface& ui = this->ui();
         const bool hovered = ui.currentHoveredNode() == node;
         if(ui.currentPressedNode() == node) transition = hovered ?
-            sharedState.styleTransitionToPressedOver :
-            sharedState.styleTransitionToPressedOut;
+            Implementation::StyleTransition::ToPressedOver :
+            Implementation::StyleTransition::ToPressedOut;
         else if(ui.currentFocusedNode() == node) transition = hovered ?
-            sharedState.styleTransitionToFocusedOver :
-            sharedState.styleTransitionToFocusedOut;
+            Implementation::StyleTransition::ToFocusedOver :
+            Implementation::StyleTransition::ToFocusedOut;
         else transition = hovered ?
-            sharedState.styleTransitionToInactiveOver :
-            sharedState.styleTransitionToInactiveOut;
+            Implementation::StyleTransition::ToInactiveOver :
+            Implementation::StyleTransition::ToInactiveOut;
     }
     transitionStyleInternal(
         #ifndef CORRADE_NO_ASSERT
@@ -336,7 +477,7 @@ void AbstractVisualLayer::transitionStyleInternal(const LayerDataHandle handle,
 }
 
 UnsignedInt AbstractVisualLayer::dynamicStyleUsedCount() const {
-    return _state->dynamicStylesUsed.count();
+    return _state->dynamicStyleUsedCount;
 }
 
 Containers::Optional<UnsignedInt> AbstractVisualLayer::allocateDynamicStyle(const AnimationHandle animation) {
@@ -344,33 +485,83 @@ Containers::Optional<UnsignedInt> AbstractVisualLayer::allocateDynamicStyle(cons
     CORRADE_ASSERT(state.shared.dynamicStyleCount,
         "Ui::AbstractVisualLayer::allocateDynamicStyle(): layer has zero dynamic styles", {});
 
-    /** @todo some builtin "find first unset" API, tzcnt etc */
-    for(std::size_t i = 0; i != state.dynamicStylesUsed.size(); ++i) {
-        if(state.dynamicStylesUsed[i])
+    /* All words before dynamicStyleFirstFreeWord are fully used, so start
+       from there and skip fully used words until there's one with a free bit.
+       With the hint being updated on both allocation and recycling this is
+       usually just a single iteration. */
+    for(std::size_t i = state.dynamicStyleFirstFreeWord; i != state.dynamicStylesUsed.size(); ++i) {
+        UnsignedLong& word = state.dynamicStylesUsed[i];
+        if(word == ~0ull)
             continue;
-        state.dynamicStylesUsed.set(i);
-        state.dynamicStyleAnimations[i] = animation;
-        return i;
+
+        const UnsignedInt id = i*64 + findFirstUnset(word);
+        word |= 1ull << (id % 64);
+        state.dynamicStyleAnimations[id] = animation;
+        state.dynamicStyleFirstFreeWord = i;
+        ++state.dynamicStyleUsedCount;
+        return id;
     }
 
+    state.dynamicStyleFirstFreeWord = state.dynamicStylesUsed.size();
     return {};
 }
 
 AnimationHandle AbstractVisualLayer::dynamicStyleAnimation(const UnsignedInt id) const {
     const State& state = *_state;
-    CORRADE_ASSERT(id < state.dynamicStylesUsed.size(),
-        "Ui::AbstractVisualLayer::dynamicStyleAnimation(): index" << id << "out of range for" << state.dynamicStylesUsed.size() << "dynamic styles", {});
+    CORRADE_ASSERT(id < state.shared.dynamicStyleCount,
+        "Ui::AbstractVisualLayer::dynamicStyleAnimation(): index" << id << "out of range for" << state.shared.dynamicStyleCount << "dynamic styles", {});
     return state.dynamicStyleAnimations[id];
 }
 
 void AbstractVisualLayer::recycleDynamicStyle(const UnsignedInt id) {
     State& state = *_state;
-    CORRADE_ASSERT(id < state.dynamicStylesUsed.size(),
-        "Ui::AbstractVisualLayer::recycleDynamicStyle(): index" << id << "out of range for" << state.dynamicStylesUsed.size() << "dynamic styles", );
-    CORRADE_ASSERT(state.dynamicStylesUsed[id],
+    CORRADE_ASSERT(id < state.shared.dynamicStyleCount,
+        "Ui::AbstractVisualLayer::recycleDynamicStyle(): index" << id << "out of range for" << state.shared.dynamicStyleCount << "dynamic styles", );
+    UnsignedLong& word = state.dynamicStylesUsed[id/64];
+    const UnsignedLong bit = 1ull << (id % 64);
+    CORRADE_ASSERT(word & bit,
         "Ui::AbstractVisualLayer::recycleDynamicStyle(): style" << id << "not allocated", );
-    state.dynamicStylesUsed.reset(id);
+    word &= ~bit;
     state.dynamicStyleAnimations[id] = AnimationHandle::Null;
+    --state.dynamicStyleUsedCount;
+    if(id/64 < state.dynamicStyleFirstFreeWord)
+        state.dynamicStyleFirstFreeWord = id/64;
+}
+
+void AbstractVisualLayer::setNeedsUpdate(const LayerStates states) {
+    /* A data update requested this way isn't tied to any particular data, so
+       all of them have to be regenerated */
+    if(states >= LayerState::NeedsDataUpdate)
+        _state->dirtyDataOnly = false;
+    AbstractLayer::setNeedsUpdate(states);
+}
+
+void AbstractVisualLayer::setNeedsDataUpdate(const UnsignedInt id) {
+    State& state = *_state;
+
+    /* If there's no data update pending yet, start marking from scratch and
+       remember that the update is caused only by the marked data. The state()
+       includes also doState(), which reports data updates caused by shared
+       state changes. */
+    if(!(this->state() >= LayerState::NeedsDataUpdate)) {
+        if(state.dirtyData.size() != capacity())
+            state.dirtyData = Containers::BitArray{ValueInit, capacity()};
+        else
+            state.dirtyData.resetAll();
+        state.dirtyDataOnly = true;
+
+    /* Otherwise it's either pending from data marked earlier, or it's an
+       update of all data, for which the bits don't matter. If the capacity
+       changed since the bits were allocated, the ones marked so far would get
+       lost on reallocation, so update all data in that case. Capacity changes
+       only in create(), which needs a data update anyway. */
+    } else if(state.dirtyData.size() != capacity()) {
+        state.dirtyData = Containers::BitArray{ValueInit, capacity()};
+        state.dirtyDataOnly = false;
+    }
+
+    state.dirtyData.set(id);
+    AbstractLayer::setNeedsUpdate(LayerState::NeedsDataUpdate);
 }
 
 AbstractVisualLayer& AbstractVisualLayer::assignAnimator(AbstractVisualLayerStyleAnimator& animator) {
@@ -413,6 +604,18 @@ void AbstractVisualLayer::doUpdate(const LayerStates states, const Containers::S
         state.styles.size() == capacity() &&
         state.calculatedStyles.size() == capacity());
 
+    /* If the data update was caused only by data marked with
+       setNeedsDataUpdate() and nothing else, subclasses can regenerate just
+       those. Has to be decided before the update stamp is synced below, as
+       doState() in subclasses reports data updates caused by shared state
+       changes through those. */
+    state.updateDirtyDataOnly = states >= LayerState::NeedsDataUpdate &&
+        state.dirtyDataOnly &&
+        state.dirtyData.size() == capacity() &&
+        !(doState() >= LayerState::NeedsDataUpdate);
+    if(states >= LayerState::NeedsDataUpdate)
+        state.dirtyDataOnly = false;
+
     /* Transition to disabled styles for all data that are attached to disabled
        nodes, copy the original style index otherwise. It's a copy to avoid a
        complicated logic with transitioning back from the disabled state, which
@@ -422,10 +625,41 @@ void AbstractVisualLayer::doUpdate(const LayerStates states, const Containers::S
        assignment) or if the node enablement changed. */
     if(states & (LayerState::NeedsNodeEnabledUpdate|LayerState::NeedsDataUpdate)) {
         const Shared::State& sharedState = state.shared;
-        if(UnsignedInt(*const toDisabled)(UnsignedInt) = sharedState.styleTransitionToDisabled) {
+
+        /* If neither the data nor the set of visible data changed (which is
+           signalled by NeedsNodeOrderUpdate, which also implies
+           NeedsNodeEnabledUpdate), the calculated styles are up-to-date for
+           all data except for those attached to nodes whose enabled state
+           changed since the last time. Then it's enough to compare the
+           current enabled state to the one recorded last time and transition
+           just the data for which it differs. If the node capacity changed,
+           the recorded state isn't usable anymore. */
+        const bool onlyNodesEnabledChanged =
+            !(states >= LayerState::NeedsDataUpdate) &&
+            !(states >= LayerState::NeedsNodeOrderUpdate) &&
+            state.previousNodesEnabled.size() == nodesEnabled.size();
+        /* Similarly, if the data update was caused only by particular data
+           being marked, it's enough to transition just those in addition */
+        const bool onlyNodesEnabledOrDirtyDataChanged =
+            (onlyNodesEnabledChanged || state.updateDirtyDataOnly) &&
+            !(states >= LayerState::NeedsNodeOrderUpdate) &&
+            state.previousNodesEnabled.size() == nodesEnabled.size();
+        if(state.previousNodesEnabled.size() != nodesEnabled.size())
+            state.previousNodesEnabled = Containers::BitArray{ValueInit, nodesEnabled.size()};
+
+        /* The transition is either a function or a table, with the table
+           taking precedence if both are present */
+        UnsignedInt(*const toDisabled)(UnsignedInt) = sharedState.styleTransitions[UnsignedInt(Implementation::StyleTransition::ToDisabled)];
+        const Containers::ArrayView<const UnsignedInt> toDisabledTable = sharedState.styleTransitionTables[UnsignedInt(Implementation::StyleTransition::ToDisabled)];
+        if(toDisabled || !toDisabledTable.isEmpty()) {
             const Containers::StridedArrayView1D<const NodeHandle> nodes = this->nodes();
             const UnsignedInt styleCount = sharedState.styleCount;
             for(const UnsignedInt id: dataIds) {
+                const UnsignedInt nodeId = nodeHandleId(nodes[id]);
+                const bool enabled = nodesEnabled[nodeId];
+                if(onlyNodesEnabledOrDirtyDataChanged && state.previousNodesEnabled[nodeId] == enabled && !(state.updateDirtyDataOnly && state.dirtyData[id]))
+                    continue;
+
                 /* Can't use the transitionStyleInternal() helper here as it
                    updates state.styles and not state.calculatedStyles */
                 const UnsignedInt style = state.styles[id];
@@ -437,24 +671,19 @@ void AbstractVisualLayer::doUpdate(const LayerStates states, const Containers::S
                    ignored. */
                 const UnsignedInt currentStyle = styleOrAnimationTargetStyle(style).first();
 
-                /** @todo Doing a function call for all data may be a bit
-                    horrible, also especially if the code inside is a giant
-                    switch that the compiler failed to turn into a LUT. Thus,
-                    ideally, the transition should be done only for nodes that
-                    actually changed their disabled status, which means
-                    recording the previous nodesEnabled state, XORing the
-                    current with it, and then performing transition only when
-                    the XOR is 1. Furthermore, that may often be just a very
-                    tiny portion of nodes, so ideally there would be a way to
-                    quickly get just the subset of *data* IDs that actually
-                    changed (and not node IDs), to iterate over them
-                    directly. */
+                /** @todo the data IDs still get iterated even if just a tiny
+                    portion of nodes changed their enabled state, ideally
+                    there would be a way to quickly get just the subset of
+                    *data* IDs that actually changed (and not node IDs), to
+                    iterate over them directly */
                 /* Skipping data that have dynamic styles, those are
                    passthrough */
-                if(currentStyle < styleCount && !nodesEnabled[nodeHandleId(nodes[id])]) {
-                    const UnsignedInt nextStyle = toDisabled(currentStyle);
+                if(currentStyle < styleCount && !enabled) {
+                    const UnsignedInt nextStyle = toDisabledTable.isEmpty() ?
+                        toDisabled(currentStyle) : toDisabledTable[currentStyle];
                     /** @todo a debug assert? or is it negligible compared to
-                        the function call? */
+                        the function call? the table contents are checked
+                        upfront already */
                     CORRADE_ASSERT(nextStyle < styleCount,
                         "Ui::AbstractVisualLayer::update(): style transition from" << currentStyle << "to" << nextStyle << "out of range for" << styleCount << "styles", );
                     state.calculatedStyles[id] = nextStyle;
@@ -464,11 +693,25 @@ void AbstractVisualLayer::doUpdate(const LayerStates states, const Containers::S
                 }
             }
 
+            /* Record the enabled state for next time. Has to be done in a
+               separate loop, as multiple data can be attached to the same
+               node and updating the state already in the above loop would
+               cause the remaining data to be skipped. */
+            for(const UnsignedInt id: dataIds) {
+                const UnsignedInt nodeId = nodeHandleId(nodes[id]);
+                state.previousNodesEnabled.set(nodeId, nodesEnabled[nodeId]);
+            }
+
         /* If the transition function isn't set -- i.e., the transition is an
            identity --, just copy them over. The subclass doUpdate() / doDraw() is
            then assumed to handle that on its own, for example by applying
-           desaturation and fade out globally to all data. */
-        } else Utility::copy(state.styles, state.calculatedStyles);
+           desaturation and fade out globally to all data. If only the node
+           enablement changed, the styles are already copied from last time.
+           The recorded enabled state isn't updated in this case, but a change
+           of the transition function causes NeedsDataUpdate, which doesn't
+           make use of it. */
+        } else if(!onlyNodesEnabledChanged)
+            Utility::copy(state.styles, state.calculatedStyles);
 
         /* Sync the style transition update stamp to not have doState() return
            NeedsDataUpdate again next time it's asked */
@@ -507,7 +750,7 @@ void AbstractVisualLayer::transitionStyleInternal(
     #ifndef CORRADE_NO_ASSERT
     const char* messagePrefix,
     #endif
-    const UnsignedInt dataId, UnsignedInt(*const transition)(UnsignedInt), const Nanoseconds time, AnimationHandle(*transitionAnimation)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), const UnsignedInt style
+    const UnsignedInt dataId, const Implementation::StyleTransition transition, const Nanoseconds time, AnimationHandle(*transitionAnimation)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), const UnsignedInt style
 ) {
     const State& state = *_state;
     const Shared::State& sharedState = state.shared;
@@ -532,10 +775,10 @@ void AbstractVisualLayer::transitionStyleInternal(
        or the explicitly supplied target style */
     const UnsignedInt styleToTransition = style != ~UnsignedInt{} ? style : currentStyleAnimation.first();
     /* When called from the explicit transitionStyle() call, the transition may
-       be nullptr in case the data isn't attached to any node (and thus it
-       makes no sense to transition it based on node state). Use the original
-       style unchanged in that case. */
-    const UnsignedInt nextStyle = transition ? transition(styleToTransition) : styleToTransition;
+       be StyleTransition::None in case the data isn't attached to any node
+       (and thus it makes no sense to transition it based on node state). The
+       original style is used unchanged in that case. */
+    const UnsignedInt nextStyle = sharedState.transitionStyle(transition, styleToTransition);
     CORRADE_ASSERT(nextStyle < sharedState.styleCount,
         messagePrefix << "style transition from" << styleToTransition << "to" << nextStyle << "out of range for" << sharedState.styleCount << "styles", );
 
@@ -607,7 +850,7 @@ void AbstractVisualLayer::transitionStyleInternal(
        so if any of them is non-null it means it's valid. */
     if(animation == AnimationHandle::Null && persistentAnimation == AnimationHandle::Null) {
         currentStyle = nextStyle;
-        setNeedsUpdate(LayerState::NeedsDataUpdate);
+        setNeedsDataUpdate(dataId);
         /* If the data is attached and this is a layout layer, the style likely
            affects layout properties. Trigger a layout update as well. If the
            style transition is done by an animation, the animator may or may
@@ -638,9 +881,9 @@ void AbstractVisualLayer::doPointerPressEvent(const UnsignedInt dataId, PointerE
        from the application). Pressed state has a priority over focused state,
        so isNodeFocused() is ignored in this case. */
     const Shared::State& sharedState = _state->shared;
-    UnsignedInt(*const transition)(UnsignedInt) = event.isNodeHovered() ?
-        sharedState.styleTransitionToPressedOver :
-        sharedState.styleTransitionToPressedOut;
+    const Implementation::StyleTransition transition = event.isNodeHovered() ?
+        Implementation::StyleTransition::ToPressedOver :
+        Implementation::StyleTransition::ToPressedOut;
     transitionStyleInternal(
         #ifndef CORRADE_NO_ASSERT
         "Ui::AbstractVisualLayer::pointerPressEvent():",
@@ -664,13 +907,13 @@ void AbstractVisualLayer::doPointerReleaseEvent(const UnsignedInt dataId, Pointe
        don't support hover like touches, or if move events aren't propagated
        from the application) */
     const Shared::State& sharedState = _state->shared;
-    UnsignedInt(*const transition)(UnsignedInt) = event.isNodeFocused() ?
+    const Implementation::StyleTransition transition = event.isNodeFocused() ?
         event.isNodeHovered() ?
-            sharedState.styleTransitionToFocusedOver :
-            sharedState.styleTransitionToFocusedOut :
+            Implementation::StyleTransition::ToFocusedOver :
+            Implementation::StyleTransition::ToFocusedOut :
         event.isNodeHovered() ?
-            sharedState.styleTransitionToInactiveOver :
-            sharedState.styleTransitionToInactiveOut;
+            Implementation::StyleTransition::ToInactiveOver :
+            Implementation::StyleTransition::ToInactiveOut;
     transitionStyleInternal(
         #ifndef CORRADE_NO_ASSERT
         "Ui::AbstractVisualLayer::pointerReleaseEvent():",
@@ -697,10 +940,10 @@ void AbstractVisualLayer::doPointerEnterEvent(const UnsignedInt dataId, PointerM
 
     /* Transition the style to over */
     const Shared::State& sharedState = _state->shared;
-    UnsignedInt(*const transition)(UnsignedInt) = event.isCaptured() ?
-        sharedState.styleTransitionToPressedOver : event.isNodeFocused() ?
-            sharedState.styleTransitionToFocusedOver :
-            sharedState.styleTransitionToInactiveOver;
+    const Implementation::StyleTransition transition = event.isCaptured() ?
+        Implementation::StyleTransition::ToPressedOver : event.isNodeFocused() ?
+            Implementation::StyleTransition::ToFocusedOver :
+            Implementation::StyleTransition::ToInactiveOver;
     transitionStyleInternal(
         #ifndef CORRADE_NO_ASSERT
         "Ui::AbstractVisualLayer::pointerEnterEvent():",
@@ -715,10 +958,10 @@ void AbstractVisualLayer::doPointerLeaveEvent(const UnsignedInt dataId, PointerM
 
     /* Transition the style to out */
     const Shared::State& sharedState = _state->shared;
-    UnsignedInt(*const transition)(UnsignedInt) = event.isCaptured() ?
-        sharedState.styleTransitionToPressedOut : event.isNodeFocused() ?
-            sharedState.styleTransitionToFocusedOut :
-            sharedState.styleTransitionToInactiveOut;
+    const Implementation::StyleTransition transition = event.isCaptured() ?
+        Implementation::StyleTransition::ToPressedOut : event.isNodeFocused() ?
+            Implementation::StyleTransition::ToFocusedOut :
+            Implementation::StyleTransition::ToInactiveOut;
     transitionStyleInternal(
         #ifndef CORRADE_NO_ASSERT
         "Ui::AbstractVisualLayer::pointerLeaveEvent():",
@@ -734,7 +977,7 @@ void AbstractVisualLayer::doPointerCancelEvent(const UnsignedInt dataId, Pointer
         #ifndef CORRADE_NO_ASSERT
         "Ui::AbstractVisualLayer::pointerCancelEvent():",
         #endif
-        dataId, _state->shared.styleTransitionToInactiveOut, event.time(), nullptr);
+        dataId, Implementation::StyleTransition::ToInactiveOut, event.time(), nullptr);
 }
 
 void AbstractVisualLayer::doFocusEvent(const UnsignedInt dataId, FocusEvent& event) {
@@ -742,9 +985,9 @@ void AbstractVisualLayer::doFocusEvent(const UnsignedInt dataId, FocusEvent& eve
        style gets a priority */
     if(!event.isNodePressed()) {
         const Shared::State& sharedState = _state->shared;
-        UnsignedInt(*const transition)(UnsignedInt) = event.isNodeHovered() ?
-            sharedState.styleTransitionToFocusedOver :
-            sharedState.styleTransitionToFocusedOut;
+        const Implementation::StyleTransition transition = event.isNodeHovered() ?
+            Implementation::StyleTransition::ToFocusedOver :
+            Implementation::StyleTransition::ToFocusedOut;
         transitionStyleInternal(
             #ifndef CORRADE_NO_ASSERT
             "Ui::AbstractVisualLayer::focusEvent():",
@@ -760,9 +1003,9 @@ void AbstractVisualLayer::doBlurEvent(const UnsignedInt dataId, FocusEvent& even
        style gets a priority */
     if(!event.isNodePressed()) {
         const Shared::State& sharedState = _state->shared;
-        UnsignedInt(*const transition)(UnsignedInt) = event.isNodeHovered() ?
-            sharedState.styleTransitionToInactiveOver :
-            sharedState.styleTransitionToInactiveOut;
+        const Implementation::StyleTransition transition = event.isNodeHovered() ?
+            Implementation::StyleTransition::ToInactiveOver :
+            Implementation::StyleTransition::ToInactiveOut;
         transitionStyleInternal(
             #ifndef CORRADE_NO_ASSERT
             "Ui::AbstractVisualLayer::blurEvent():",
@@ -789,20 +1032,20 @@ void AbstractVisualLayer::doVisibilityLostEvent(const UnsignedInt dataId, Visibi
        not a formerly focused node that's now pressed, in which case it stays
        pressed. */
     if(currentStyle < sharedState.styleCount && !event.isNodePressed()) {
-        UnsignedInt(*const transition)(UnsignedInt) = event.isNodeHovered() ?
-            sharedState.styleTransitionToInactiveOver :
-            sharedState.styleTransitionToInactiveOut;
+        const Implementation::StyleTransition transition = event.isNodeHovered() ?
+            Implementation::StyleTransition::ToInactiveOver :
+            Implementation::StyleTransition::ToInactiveOut;
         /* Not using transitionStyleInternal() in this case because this
            function is called from within update(), meaning one can't just fire
            animations like a madman in the middle of _that_ */
-        const UnsignedInt nextStyle = transition(currentStyle);
+        const UnsignedInt nextStyle = sharedState.transitionStyle(transition, currentStyle);
         CORRADE_ASSERT(nextStyle < sharedState.styleCount,
             "Ui::AbstractVisualLayer::visibilityLostEvent(): style transition from" << currentStyle << "to" << nextStyle << "out of range for" << sharedState.styleCount << "styles", );
         /* If the transitioned style is different from the current one (or the
            one that's the animation target), update it */
         if(nextStyle != currentStyle) {
             style = nextStyle;
-            setNeedsUpdate(LayerState::NeedsDataUpdate);
+            setNeedsDataUpdate(dataId);
         }
     }
 }
@@ -818,18 +1061,22 @@ void AbstractVisualLayer::DebugIntegration::print(Debug& debug, const AbstractVi
         debug << "with dynamic style" << style - layer.shared().styleCount() << Debug::newline;
     } else {
         /* Collect all transitioned styles */
-        const UnsignedInt styleInactiveOut = layer.shared().styleTransitionToInactiveOut()(style);
-        const UnsignedInt styleInactiveOver = layer.shared().styleTransitionToInactiveOver()(style);
-        const UnsignedInt styleFocusedOut = layer.shared().styleTransitionToFocusedOut()(style);
-        const UnsignedInt styleFocusedOver = layer.shared().styleTransitionToFocusedOver()(style);
-        const UnsignedInt stylePressedOut = layer.shared().styleTransitionToPressedOut()(style);
-        const UnsignedInt stylePressedOver = layer.shared().styleTransitionToPressedOver()(style);
+        /* Going through the internal state in order to pick up the
+           transition tables as well */
+        const auto& sharedState = layer._state->shared;
+        const UnsignedInt styleInactiveOut = sharedState.transitionStyle(Implementation::StyleTransition::ToInactiveOut, style);
+        const UnsignedInt styleInactiveOver = sharedState.transitionStyle(Implementation::StyleTransition::ToInactiveOver, style);
+        const UnsignedInt styleFocusedOut = sharedState.transitionStyle(Implementation::StyleTransition::ToFocusedOut, style);
+        const UnsignedInt styleFocusedOver = sharedState.transitionStyle(Implementation::StyleTransition::ToFocusedOver, style);
+        const UnsignedInt stylePressedOut = sharedState.transitionStyle(Implementation::StyleTransition::ToPressedOut, style);
+        const UnsignedInt stylePressedOver = sharedState.transitionStyle(Implementation::StyleTransition::ToPressedOver, style);
         /* If disabled transition isn't set, assume it's the same as inactive
            out (which it should as when a node gets disabled it goes through
            pointer out and pointer release) */
         const UnsignedInt styleDisabled =
-            layer.shared().styleTransitionToDisabled() ?
-                layer.shared().styleTransitionToDisabled()(style) : styleInactiveOut;
+            sharedState.styleTransitions[UnsignedInt(Implementation::StyleTransition::ToDisabled)] ||
+            !sharedState.styleTransitionTables[UnsignedInt(Implementation::StyleTransition::ToDisabled)].isEmpty() ?
+                sharedState.transitionStyle(Implementation::StyleTransition::ToDisabled, style) : styleInactiveOut;
 
         const auto printStyle = [&debug, this](UnsignedInt style) {
             Containers::StringView name;
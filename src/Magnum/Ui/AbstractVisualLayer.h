@@ -35,6 +35,10 @@
 
 namespace Magnum { namespace Ui {
 
+namespace Implementation {
+    enum class StyleTransition: UnsignedByte;
+}
+
 /**
 @brief Base for visual data layers
 @m_since_latest_{extras}
@@ -360,7 +364,10 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer: public AbstractLayer {
          * When not used anymore, the index should be passed to
          * @ref recycleDynamicStyle() to make it available for allocation
          * again. If there are no free dynamic styles left, returns
-         * @relativeref{Corrade,Containers::NullOpt}.
+         * @relativeref{Corrade,Containers::NullOpt}. The lowest free index is
+         * always returned. The search skips 64 used dynamic styles at a time
+         * and remembers where the first free one is, so allocation stays
+         * cheap even with thousands of dynamic styles.
          *
          * If the dynamic style is driven by an animation, its handle can be
          * passed to the @p animation argument to retrieve later with
@@ -408,6 +415,16 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer: public AbstractLayer {
          */
         void recycleDynamicStyle(UnsignedInt id);
 
+        /**
+         * @brief Set the layer state
+         *
+         * Same as @ref AbstractLayer::setNeedsUpdate(), except that if
+         * @p state contains @ref LayerState::NeedsDataUpdate, all data get
+         * regenerated in the next @ref update() and not just the ones changed
+         * through per-data setters such as @ref setStyle().
+         */
+        void setNeedsUpdate(LayerStates state);
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -425,6 +442,12 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer: public AbstractLayer {
         AbstractVisualLayerStyleAnimator* defaultStyleAnimator() const;
         AbstractVisualLayer& setDefaultStyleAnimator(AbstractVisualLayerStyleAnimator* animator);
 
+        /* Marks given data as needing an update and sets
+           LayerState::NeedsDataUpdate. If no other data update is pending,
+           the subclass doUpdate() then regenerates and uploads just the
+           marked data instead of all of them. Used by per-data setters. */
+        MAGNUM_UI_LOCAL void setNeedsDataUpdate(UnsignedInt id);
+
         /* Can't be MAGNUM_UI_LOCAL otherwise deriving from this class in
            tests causes linker errors */
         LayerFeatures doFeatures() const override;
@@ -445,7 +468,7 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer: public AbstractLayer {
             #ifndef CORRADE_NO_ASSERT
             const char* messagePrefix,
             #endif
-            UnsignedInt dataId, UnsignedInt(*const transition)(UnsignedInt), Nanoseconds time, AnimationHandle(*transitionAnimation)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), UnsignedInt style = ~UnsignedInt{});
+            UnsignedInt dataId, Implementation::StyleTransition transition, Nanoseconds time, AnimationHandle(*transitionAnimation)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), UnsignedInt style = ~UnsignedInt{});
 
         /* Can't be MAGNUM_UI_LOCAL otherwise deriving from this class in
            tests causes linker errors */
@@ -540,7 +563,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          *      now it thinks the return type is auto, sigh; same below
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToInactiveOut() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -548,7 +572,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to an inactive over state
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToInactiveOver() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -556,7 +581,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to a focused out state
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToFocusedOut() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -564,7 +590,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to a focused over state
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToFocusedOver() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -572,7 +599,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to a pressed out state
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToPressedOut() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -580,7 +608,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to a pressed over state
          *
          * Is never @cpp nullptr @ce, if not set it returns a pointer to a
-         * function that returns the argument unchanged.
+         * function that returns the argument unchanged. That's also the case
+         * after calling @ref setStyleTransitionTables().
          */
         auto styleTransitionToPressedOver() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -588,7 +617,8 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * @brief Style transition to a disabled state
          *
          * Unlike other transition functions, this one is @cpp nullptr @ce if
-         * not set.
+         * not set. It's also @cpp nullptr @ce after calling
+         * @ref setStyleTransitionTables().
          */
         auto styleTransitionToDisabled() const -> UnsignedInt(*)(UnsignedInt);
 
@@ -653,6 +683,15 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
          * are constructed using this shared instance. The other transition
          * functions don't cause any @ref LayerState to be set, as they're only
          * used directly in event handlers.
+         *
+         * The functions are called for every affected data on every event and
+         * in case of @p toDisabled for every visible data on every node
+         * enablement change. If they're expensive, for example containing a
+         * large @cpp switch @ce the compiler fails to turn into a lookup
+         * table, call @ref precomputeStyleTransitionTables() afterwards.
+         * Calling this function discards any tables set previously by
+         * @ref precomputeStyleTransitionTables() or
+         * @ref setStyleTransitionTables().
          */
         Shared& setStyleTransition(UnsignedInt(*toInactiveOut)(UnsignedInt), UnsignedInt(*toInactiveOver)(UnsignedInt), UnsignedInt(*toFocusedOut)(UnsignedInt), UnsignedInt(*toFocusedOver)(UnsignedInt), UnsignedInt(*toPressedOut)(UnsignedInt), UnsignedInt(*toPressedOver)(UnsignedInt), UnsignedInt(*toDisabled)(UnsignedInt));
 
@@ -700,6 +739,70 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::Shared {
             return setStyleTransition<StyleIndex, toInactive, toInactive, toFocused, toFocused, toPressed, toPressed, toDisabled>();
         }
 
+        /**
+         * @brief Set style transition tables
+         * @return Reference to self (for method chaining)
+         *
+         * Alternative to @ref setStyleTransition() "setStyleTransition(UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt), UnsignedInt(*)(UnsignedInt))"
+         * taking precomputed tables instead of functions, with the
+         * transitioned style for a style `i` being the `i`-th item of the
+         * table. Each table is expected to be either empty, in which case
+         * given transition is a no-op, keeping the same index, or have a size
+         * equal to @ref styleCount(). All indices in the tables are expected to
+         * be less than @ref styleCount(). The contents are copied, so the views
+         * don't need to stay in scope after the call.
+         *
+         * Looking up a transition in a table is just a single indexed load,
+         * compared to an indirect function call for every affected data.
+         * Calling this function resets all transition functions to their
+         * default, the tables are then used instead of them until
+         * @ref setStyleTransition() is called again. The function always
+         * causes @ref LayerState::NeedsDataUpdate to be set on all layers that
+         * are constructed using this shared instance.
+         * @see @ref precomputeStyleTransitionTables()
+         */
+        Shared& setStyleTransitionTables(const Containers::ArrayView<const UnsignedInt>& toInactiveOut, const Containers::ArrayView<const UnsignedInt>& toInactiveOver, const Containers::ArrayView<const UnsignedInt>& toFocusedOut, const Containers::ArrayView<const UnsignedInt>& toFocusedOver, const Containers::ArrayView<const UnsignedInt>& toPressedOut, const Containers::ArrayView<const UnsignedInt>& toPressedOver, const Containers::ArrayView<const UnsignedInt>& toDisabled);
+
+        /**
+         * @brief Set style transition tables without hover state
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setStyleTransitionTables() with @p toInactive
+         * used for both @p toInactiveOut and @p toInactiveOver, @p toFocused
+         * used for both @p toFocusedOut and @p toFocusedOver and @p toPressed
+         * used for both @p toPressedOut and @p toPressedOver.
+         */
+        Shared& setStyleTransitionTables(const Containers::ArrayView<const UnsignedInt>& toInactive, const Containers::ArrayView<const UnsignedInt>& toFocused, const Containers::ArrayView<const UnsignedInt>& toPressed, const Containers::ArrayView<const UnsignedInt>& toDisabled) {
+            return setStyleTransitionTables(toInactive, toInactive, toFocused, toFocused, toPressed, toPressed, toDisabled);
+        }
+
+        /**
+         * @brief Precompute style transition tables from the transition functions
+         * @return Reference to self (for method chaining)
+         *
+         * Evaluates the transition functions currently set with
+         * @ref setStyleTransition() for all @ref styleCount() styles and uses
+         * the results instead of calling the functions in event handlers and
+         * when updating disabled styles. Transitions that are a no-op are
+         * skipped, for a @ref styleTransitionToDisabled() that's
+         * @cpp nullptr @ce no table is created either. Note that the
+         * functions thus get called also for styles that are never
+         * transitioned from in practice, such as disabled styles. Expects
+         * that the functions return an index that's less than
+         * @ref styleCount() for every style.
+         *
+         * Unlike with @ref setStyleTransitionTables(), the functions are kept
+         * and are still returned from @ref styleTransitionToInactiveOut() and
+         * others. Tables set with @ref setStyleTransitionTables() for
+         * transitions that have no function are kept as well. The tables are
+         * discarded on the next @ref setStyleTransition() call, call this
+         * function again afterwards to recalculate them. If
+         * @ref styleTransitionToDisabled() is set, the function causes
+         * @ref LayerState::NeedsDataUpdate to be set on all layers that are
+         * constructed using this shared instance.
+         */
+        Shared& precomputeStyleTransitionTables();
+
         /**
          * @brief Style animation on pointer enter
          * @todoc without the trailing return, Doxygen thinks it's a variable,
@@ -1013,6 +1116,15 @@ class MAGNUM_UI_EXPORT AbstractVisualLayer::DebugIntegration {
     }                                                                       \
     template<class StyleIndex, StyleIndex(*toInactive)(StyleIndex), StyleIndex(*toFocused)(StyleIndex), StyleIndex(*toPressed)(StyleIndex), StyleIndex(*toDisabled)(StyleIndex)> Shared& setStyleTransition() { \
         return static_cast<Shared&>(AbstractVisualLayer::Shared::setStyleTransition<StyleIndex, toInactive, toFocused, toPressed, toDisabled>()); \
+    }                                                                       \
+    Shared& setStyleTransitionTables(const Containers::ArrayView<const UnsignedInt>& toInactiveOut, const Containers::ArrayView<const UnsignedInt>& toInactiveOver, const Containers::ArrayView<const UnsignedInt>& toFocusedOut, const Containers::ArrayView<const UnsignedInt>& toFocusedOver, const Containers::ArrayView<const UnsignedInt>& toPressedOut, const Containers::ArrayView<const UnsignedInt>& toPressedOver, const Containers::ArrayView<const UnsignedInt>& toDisabled) { \
+        return static_cast<Shared&>(AbstractVisualLayer::Shared::setStyleTransitionTables(toInactiveOut, toInactiveOver, toFocusedOut, toFocusedOver, toPressedOut, toPressedOver, toDisabled)); \
+    }                                                                       \
+    Shared& setStyleTransitionTables(const Containers::ArrayView<const UnsignedInt>& toInactive, const Containers::ArrayView<const UnsignedInt>& toFocused, const Containers::ArrayView<const UnsignedInt>& toPressed, const Containers::ArrayView<const UnsignedInt>& toDisabled) { \
+        return static_cast<Shared&>(AbstractVisualLayer::Shared::setStyleTransitionTables(toInactive, toFocused, toPressed, toDisabled)); \
+    }                                                                       \
+    Shared& precomputeStyleTransitionTables() {                             \
+        return static_cast<Shared&>(AbstractVisualLayer::Shared::precomputeStyleTransitionTables()); \
     }
 #define _MAGNUMEXTRAS_UI_ABSTRACTVISUALLAYER_SHARED_SUBCLASS_ANIMATION_IMPLEMENTATION(Animator) \
     Shared& setStyleAnimation(AnimationHandle(*onEnter)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onLeave)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onFocus)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onBlur)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onPress)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onRelease)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*onTransition)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle), AnimationHandle(*persistent)(AbstractVisualLayerStyleAnimator&, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle)) { \
@@ -57,11 +57,14 @@ Debug& operator<<(Debug& debug, const BaseLayerSharedFlag value) {
         _c(NoOutline)
         _c(TextureMask)
         _c(SubdividedQuads)
+        _c(InstancedQuads)
+        _c(BackgroundBlurDualFilter)
+        _c(ShaderStyleAnimation)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << Debug::hex << UnsignedByte(value) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << Debug::hex << UnsignedShort(value) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const BaseLayerSharedFlags value) {
@@ -69,16 +72,22 @@ Debug& operator<<(Debug& debug, const BaseLayerSharedFlags value) {
         BaseLayerSharedFlag::TextureMask,
         /* Implied by TextureMask, has to be after */
         BaseLayerSharedFlag::Textured,
+        BaseLayerSharedFlag::BackgroundBlurDualFilter,
+        /* Implied by BackgroundBlurDualFilter, has to be after */
         BaseLayerSharedFlag::BackgroundBlur,
         BaseLayerSharedFlag::NoRoundedCorners,
         BaseLayerSharedFlag::NoOutline,
-        BaseLayerSharedFlag::SubdividedQuads
+        BaseLayerSharedFlag::SubdividedQuads,
+        BaseLayerSharedFlag::InstancedQuads,
+        BaseLayerSharedFlag::ShaderStyleAnimation
     });
 }
 
 BaseLayer::Shared::State::State(Shared& self, const Configuration& configuration): AbstractVisualLayer::Shared::State{self, configuration.styleCount(), configuration.dynamicStyleCount()},
     /* The radius is always at most 31, so can be a byte */
     backgroundBlurRadius{UnsignedByte(configuration.backgroundBlurRadius())},
+    /* The factor is at most 4, so can be a byte as well */
+    backgroundBlurDownscale{UnsignedByte(configuration.backgroundBlurDownscale())},
     flags{configuration.flags()},
     styleUniformCount{configuration.styleUniformCount()}
 {
@@ -96,6 +105,8 @@ BaseLayer::Shared::Shared(Containers::Pointer<State>&& state): AbstractVisualLay
         "Ui::BaseLayer::Shared: expected non-zero total style count", );
     CORRADE_ASSERT(!(s.flags & BaseLayerSharedFlag::SubdividedQuads) || !(s.flags & (BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag::NoRoundedCorners)),
         "Ui::BaseLayer::Shared:" << BaseLayerSharedFlag::SubdividedQuads << "and" << (s.flags & (BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag::NoRoundedCorners)) << "are mutually exclusive", );
+    CORRADE_ASSERT(!(s.flags >= (BaseLayerSharedFlag::SubdividedQuads|BaseLayerSharedFlag::InstancedQuads)),
+        "Ui::BaseLayer::Shared:" << BaseLayerSharedFlag::SubdividedQuads << "and" << BaseLayerSharedFlag::InstancedQuads << "are mutually exclusive", );
 }
 
 BaseLayer::Shared::Shared(const Configuration& configuration): Shared{Containers::pointer<State>(*this, configuration)} {}
@@ -114,6 +125,10 @@ UnsignedInt BaseLayer::Shared::backgroundBlurRadius() const {
     return static_cast<const State&>(*_state).backgroundBlurRadius;
 }
 
+UnsignedInt BaseLayer::Shared::backgroundBlurDownscale() const {
+    return static_cast<const State&>(*_state).backgroundBlurDownscale;
+}
+
 void BaseLayer::Shared::setStyleInternal(const BaseLayerCommonStyleUniform& commonUniform, const Containers::ArrayView<const BaseLayerStyleUniform> uniforms, const Containers::StridedArrayView1D<const Vector4>& stylePaddings) {
     State& state = static_cast<State&>(*_state);
     CORRADE_ASSERT(uniforms.size() == state.styleUniformCount,
@@ -200,11 +215,26 @@ BaseLayer::Shared::Configuration& BaseLayer::Shared::Configuration::setBackgroun
     return *this;
 }
 
+BaseLayer::Shared::Configuration& BaseLayer::Shared::Configuration::setBackgroundBlurDownscale(const UnsignedInt factor) {
+    CORRADE_ASSERT(factor == 1 || factor == 2 || factor == 4,
+        "Ui::BaseLayer::Shared::Configuration::setBackgroundBlurDownscale(): expected factor to be 1, 2 or 4, got" << factor, *this);
+    _backgroundBlurDownscale = factor;
+    return *this;
+}
+
 BaseLayer::State::State(Shared::State& shared): AbstractVisualLayer::State{shared}, styleUpdateStamp{shared.styleUpdateStamp} {
     dynamicStyleStorage = Containers::ArrayTuple{
         {ValueInit, shared.dynamicStyleCount, dynamicStyleUniforms},
         {ValueInit, shared.dynamicStyleCount, dynamicStylePaddings},
+        {NoInit, shared.flags >= BaseLayerSharedFlag::ShaderStyleAnimation ? shared.dynamicStyleCount : 0, dynamicStyleInterpolations},
     };
+
+    /* Initially each dynamic style interpolates just between itself, i.e.
+       is drawn with its own uniform */
+    for(std::size_t i = 0; i != dynamicStyleInterpolations.size(); ++i) {
+        const UnsignedInt uniform = shared.styleUniformCount + i;
+        dynamicStyleInterpolations[i] = {{uniform, uniform}, 0.0f};
+    }
 }
 
 BaseLayer::BaseLayer(const LayerHandle handle, Containers::Pointer<State>&& state): AbstractVisualLayer{handle, Utility::move(state)} {}
@@ -290,6 +320,15 @@ void BaseLayer::setDynamicStyle(const UnsignedInt id, const BaseLayerStyleUnifor
     setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
     state.dynamicStyleChanged = true;
 
+    /* If the style animations are interpolated in the shader, make the
+       dynamic style reference just itself, in case it was used by an
+       animation before */
+    if(!state.dynamicStyleInterpolations.isEmpty()) {
+        const UnsignedInt styleUniform = static_cast<const Shared::State&>(state.shared).styleUniformCount + id;
+        state.dynamicStyleInterpolations[id] = {{styleUniform, styleUniform}, 0.0f};
+        state.dynamicStyleInterpolationChanged = true;
+    }
+
     /* Mark the layer as needing a full data update only if the padding
        actually changes, otherwise it's enough to just upload the uniforms */
     if(state.dynamicStylePaddings[id] != padding) {
@@ -322,6 +361,11 @@ DataHandle BaseLayer::create(const UnsignedInt style, const NodeHandle node) {
         data.textureCoordinateOffset = state.defaultTextureCoordinateOffset;
         data.textureCoordinateSize = state.defaultTextureCoordinateSize;
     }
+
+    /* AbstractLayer::create() set LayerState::NeedsDataUpdate already, but
+       if there are other data marked for an update already, this one has to
+       be among them */
+    setNeedsDataUpdate(id);
     return handle;
 }
 
@@ -351,7 +395,7 @@ void BaseLayer::setColor(const LayerDataHandle handle, const Color4& color) {
 
 void BaseLayer::setColorInternal(const UnsignedInt id, const Color4& color) {
     static_cast<State&>(*_state).data[id].color = color;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 void BaseLayer::setOutlineWidth(const DataHandle handle, const Vector4& width) {
@@ -380,7 +424,7 @@ void BaseLayer::setOutlineWidth(const LayerDataHandle handle, const Vector4& wid
 
 void BaseLayer::setOutlineWidthInternal(const UnsignedInt id, const Vector4& width) {
     static_cast<State&>(*_state).data[id].outlineWidth = width;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 Vector4 BaseLayer::padding(const DataHandle handle) const {
@@ -409,7 +453,7 @@ void BaseLayer::setPadding(const LayerDataHandle handle, const Vector4& padding)
 
 void BaseLayer::setPaddingInternal(const UnsignedInt id, const Vector4& padding) {
     static_cast<State&>(*_state).data[id].padding = padding;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 Containers::Pair<Vector3, Vector2> BaseLayer::textureCoordinates(const DataHandle handle) const {
@@ -451,7 +495,7 @@ void BaseLayer::setTextureCoordinatesInternal(const UnsignedInt id, const Vector
     Implementation::BaseLayerData& data = state.data[id];
     data.textureCoordinateOffset = offset;
     data.textureCoordinateSize = size;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 LayerFeatures BaseLayer::doFeatures() const {
@@ -499,6 +543,8 @@ void BaseLayer::doAdvanceAnimations(const Nanoseconds time, const Containers::Mu
             factorStorage.prefix(capacity),
             removeStorage.prefix(capacity),
             state.dynamicStyleUniforms,
+            stridedArrayView(state.dynamicStyleInterpolations).slice(&Implementation::BaseLayerStyleInterpolation::uniforms),
+            stridedArrayView(state.dynamicStyleInterpolations).slice(&Implementation::BaseLayerStyleInterpolation::factor),
             state.dynamicStylePaddings,
             stridedArrayView(state.data).slice(&Implementation::BaseLayerData::style));
     }
@@ -509,6 +555,10 @@ void BaseLayer::doAdvanceAnimations(const Nanoseconds time, const Containers::Mu
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
         state.dynamicStyleChanged = true;
     }
+    if(updates >= BaseLayerStyleAnimatorUpdate::Interpolation) {
+        setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+        state.dynamicStyleInterpolationChanged = true;
+    }
 }
 
 LayerStates BaseLayer::doState() const {
@@ -547,11 +597,17 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
        node order changed. Flattening the logic for less indentation, first the
        less-data-heavy case with just a single quad for every data but a more
        complicated fragment shader. Keep the checks in sync with
-       BaseLayerGL::doUpdate(). */
+       BaseLayerGL::doUpdate().
+
+       The indices depend only on the data ID order, so if the data update was
+       caused only by particular data being marked with setNeedsDataUpdate(),
+       such as from setColor() or setStyle(), they don't need to be touched. */
+    const bool dirtyDataOnly = state.updateDirtyDataOnly;
+    const Containers::BitArrayView dirtyData = state.dirtyData;
     const bool updateIndices =
         states >= LayerState::NeedsNodeOrderUpdate ||
-        states >= LayerState::NeedsDataUpdate;
-    if(updateIndices && !(sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads)) {
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    if(updateIndices && !(sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads) && !(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads)) {
         arrayResize(state.indices, NoInit, dataIds.size()*6);
         for(UnsignedInt i = 0; i != dataIds.size(); ++i) {
             const UnsignedInt vertexOffset = dataIds[i]*4;
@@ -656,25 +712,62 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         }
     }
 
+    /* All indices got regenerated in both cases above, so all of them need to
+       be uploaded */
+    if(updateIndices && !(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads))
+        state.indexDirtyRange.add(0, state.indices.size()*sizeof(UnsignedInt));
+
     /* Fill in vertex data if the data themselves, the node offset/size or node
-       enablement (and thus calculated styles) changed. Again flattening the
-       logic for less indentation, first the less-data-heavy case with just a
-       single quad for every data. Keep the checks in sync with
-       BaseLayerGL::doUpdate(). */
-    /** @todo split this further to just position-related data update and other
-        data if it shows to help with perf */
-    const bool updateVertices =
+       enablement (and thus calculated styles) changed. The vertex attributes
+       are split into two groups -- positions, center distances and texture
+       coordinates depend on node offsets, sizes and paddings, while colors,
+       outline widths and style uniforms depend on node opacities. Node
+       enablement affects both, as the calculated style picks both the padding
+       and the uniform. Each group is then updated only if something it
+       depends on changed, so for example an opacity animation doesn't
+       recalculate any positions.
+
+       Data that aren't drawn don't get updated at all. That's fine, as a
+       change in the set of drawn data always comes together with
+       NeedsNodeEnabledUpdate (implied by UserInterfaceState::NeedsNodeClipUpdate)
+       or NeedsNodeOffsetSizeUpdate together with NeedsNodeOpacityUpdate
+       (implied by NeedsAttachmentUpdate), which update both groups.
+
+       If the data update was caused only by particular data being marked,
+       the group is updated only for those, unless something else the group
+       depends on changed as well, in which case it's updated for all drawn
+       data. Only the ranges of data that were actually updated are then
+       marked for upload.
+
+       Again flattening the logic for less indentation, first the
+       less-data-heavy case with just a single quad for every data. Keep the
+       checks in sync with BaseLayerGL::doUpdate(). */
+    const bool updateAllPositions =
         states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+        states >= LayerState::NeedsNodeEnabledUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    const bool updateAllAppearance =
         states >= LayerState::NeedsNodeEnabledUpdate ||
         states >= LayerState::NeedsNodeOpacityUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    const bool updatePositions = updateAllPositions ||
         states >= LayerState::NeedsDataUpdate;
-    if(updateVertices && !(sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads)) {
+    const bool updateAppearance = updateAllAppearance ||
+        states >= LayerState::NeedsDataUpdate;
+    const bool updateVertices = updatePositions || updateAppearance;
+    const bool updateAllVertices = updateAllPositions || updateAllAppearance;
+    if(updateVertices && !(sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads) && !(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads)) {
         /* Resize the vertex array to fit all data, make a view on the common
            type prefix */
         const std::size_t typeSize = sharedState.flags & BaseLayerSharedFlag::Textured ?
             sizeof(Implementation::BaseLayerTexturedVertex) :
             sizeof(Implementation::BaseLayerVertex);
         arrayResize(state.vertices, NoInit, capacity()*4*typeSize);
+
+        /* Only the drawn data get updated, mark the range they span */
+        for(const UnsignedInt dataId: dataIds)
+            if(updateAllVertices || dirtyData[dataId])
+                state.vertexDirtyRange.add(dataId*4*typeSize, (dataId + 1)*4*typeSize);
         const Containers::StridedArrayView1D<Implementation::BaseLayerVertex> vertices{
             state.vertices,
             reinterpret_cast<Implementation::BaseLayerVertex*>(state.vertices.data()),
@@ -684,9 +777,12 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         /* Convert smoothness from a pixel value to the UI coordinates */
         const Float smoothness = sharedState.smoothness*(state.uiSize/Vector2{state.framebufferSize}).max();
 
-        /* Fill in quad corner positions and colors */
+        /* Fill in quad corner positions */
         const Containers::StridedArrayView1D<const NodeHandle> nodes = this->nodes();
-        for(const UnsignedInt dataId: dataIds) {
+        if(updatePositions) for(const UnsignedInt dataId: dataIds) {
+            if(!updateAllPositions && !dirtyData[dataId])
+                continue;
+
             const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
             const Implementation::BaseLayerData& data = state.data[dataId];
 
@@ -718,31 +814,49 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
             const Vector2 max = offset + nodeSizes[nodeId] - Math::gather<'z', 'w'>(padding);
             const Vector2 sizeHalf = (max - min)*0.5f;
             const Vector2 sizeHalfNegative = -sizeHalf;
-            const Float opacity = nodeOpacities[nodeId];
             for(UnsignedByte i = 0; i != 4; ++i) {
                 Implementation::BaseLayerVertex& vertex = vertices[dataId*4 + i];
 
                 /* ✨ */
                 vertex.position = Math::lerp(min, max, BitVector2{i});
                 vertex.centerDistance = Math::lerp(sizeHalfNegative, sizeHalf, BitVector2{i});
+            }
+        }
+
+        /* Fill in outline widths, colors and styles */
+        if(updateAppearance) for(const UnsignedInt dataId: dataIds) {
+            if(!updateAllAppearance && !dirtyData[dataId])
+                continue;
+
+            const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
+            const Implementation::BaseLayerData& data = state.data[dataId];
+
+            const Color4 color = data.color*nodeOpacities[nodeId];
+            /* For dynamic styles the uniform mapping is implicit and they're
+               placed right after all non-dynamic styles */
+            const UnsignedInt styleUniform = data.calculatedStyle < sharedState.styleCount ?
+                sharedState.styles[data.calculatedStyle].uniform :
+                sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
+            for(UnsignedByte i = 0; i != 4; ++i) {
+                Implementation::BaseLayerVertex& vertex = vertices[dataId*4 + i];
                 vertex.outlineWidth = data.outlineWidth;
-                vertex.color = data.color*opacity;
-                /* For dynamic styles the uniform mapping is implicit and
-                   they're placed right after all non-dynamic styles */
-                vertex.styleUniform = data.calculatedStyle < sharedState.styleCount ?
-                    sharedState.styles[data.calculatedStyle].uniform :
-                    sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
+                vertex.color = color;
+                vertex.styleUniform = styleUniform;
             }
         }
 
-        /* Fill in also quad texture coordinates if enabled */
-        if(sharedState.flags & BaseLayerSharedFlag::Textured) {
+        /* Fill in also quad texture coordinates if enabled. They depend on
+           the quad size, so they're updated together with positions. */
+        if(updatePositions && (sharedState.flags & BaseLayerSharedFlag::Textured)) {
             /* Doing it like this instead of casting the typeless
                state.vertices array to ensure it's not accidentally in some
                entirely different type */
             const Containers::ArrayView<Implementation::BaseLayerTexturedVertex> texturedVertices = Containers::arrayCast<Implementation::BaseLayerTexturedVertex>(vertices).asContiguous();
 
             for(const UnsignedInt dataId: dataIds) {
+                if(!updateAllPositions && !dirtyData[dataId])
+                    continue;
+
                 const Implementation::BaseLayerData& data = state.data[dataId];
 
                 /* Expand the texture coordinates to match the position
@@ -779,6 +893,11 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
             sizeof(Implementation::BaseLayerSubdividedTexturedVertex) :
             sizeof(Implementation::BaseLayerSubdividedVertex);
         arrayResize(state.vertices, NoInit, capacity()*16*typeSize);
+
+        /* Only the drawn data get updated, mark the range they span */
+        for(const UnsignedInt dataId: dataIds)
+            if(updateAllVertices || dirtyData[dataId])
+                state.vertexDirtyRange.add(dataId*16*typeSize, (dataId + 1)*16*typeSize);
         const Containers::StridedArrayView1D<Implementation::BaseLayerSubdividedVertex> vertices{
             state.vertices,
             reinterpret_cast<Implementation::BaseLayerSubdividedVertex*>(state.vertices.data()),
@@ -800,23 +919,13 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
             |   |   |   |
             8---9---13-12 */
         const Containers::StridedArrayView1D<const NodeHandle> nodes = this->nodes();
-        for(const UnsignedInt dataId: dataIds) {
+        if(updatePositions) for(const UnsignedInt dataId: dataIds) {
+            if(!updateAllPositions && !dirtyData[dataId])
+                continue;
+
             const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
             const Implementation::BaseLayerData& data = state.data[dataId];
 
-            /* All 16 vertices get the same color and style */
-            const Float opacity = nodeOpacities[nodeId];
-            for(std::size_t i = 0; i != 16; ++i) {
-                Implementation::BaseLayerSubdividedVertex& vertex = vertices[dataId*16 + i];
-
-                vertex.color = data.color*opacity;
-                /* For dynamic styles the uniform mapping is implicit and
-                   they're placed right after all non-dynamic styles */
-                vertex.styleUniform = data.calculatedStyle < sharedState.styleCount ?
-                    sharedState.styles[data.calculatedStyle].uniform :
-                    sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
-            }
-
             /* Note that here, compared to the non-SubdividedQuads case above,
                the padding *does not* include the smoothness expansion. This is
                because the shader has to do expansion for outline width and
@@ -847,6 +956,27 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                     vertex.centerDistanceY = centerDistanceY;
                 }
             }
+        }
+
+        if(updateAppearance) for(const UnsignedInt dataId: dataIds) {
+            if(!updateAllAppearance && !dirtyData[dataId])
+                continue;
+
+            const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
+            const Implementation::BaseLayerData& data = state.data[dataId];
+
+            /* All 16 vertices get the same color and style */
+            const Color4 color = data.color*nodeOpacities[nodeId];
+            /* For dynamic styles the uniform mapping is implicit and they're
+               placed right after all non-dynamic styles */
+            const UnsignedInt styleUniform = data.calculatedStyle < sharedState.styleCount ?
+                sharedState.styles[data.calculatedStyle].uniform :
+                sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
+            for(std::size_t i = 0; i != 16; ++i) {
+                Implementation::BaseLayerSubdividedVertex& vertex = vertices[dataId*16 + i];
+                vertex.color = color;
+                vertex.styleUniform = styleUniform;
+            }
 
             /* All left vertices get the left outline width in the x coordinate
                and all right vertices get the right outline width */
@@ -863,11 +993,15 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                 vertices[dataId*16 + i].outlineWidth.y() = data.outlineWidth.w();
         }
 
-        /* Fill in also quad texture coordinates if enabled */
-        if(sharedState.flags & BaseLayerSharedFlag::Textured) {
+        /* Fill in also quad texture coordinates if enabled. Same as in the
+           single quad case, they depend on the quad size. */
+        if(updatePositions && (sharedState.flags & BaseLayerSharedFlag::Textured)) {
             const Containers::ArrayView<Implementation::BaseLayerSubdividedTexturedVertex> texturedVertices = Containers::arrayCast<Implementation::BaseLayerSubdividedTexturedVertex>(vertices).asContiguous();
 
             for(const UnsignedInt dataId: dataIds) {
+                if(!updateAllPositions && !dirtyData[dataId])
+                    continue;
+
                 const Implementation::BaseLayerData& data = state.data[dataId];
 
                 /* The texture coordinates are Y-flipped compared to the
@@ -905,6 +1039,89 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         }
     }
 
+    /* Finally the instanced case with a single instance record for every
+       data. Compared to the above, the instances are stored in the draw order
+       and not indexed by data ID, as there's no index buffer to reorder them
+       with, so they're regenerated on both data and node order changes. If
+       the data update was caused only by particular data being marked and
+       nothing else changed, the draw order is the same as last time and just
+       the instances of the marked data get regenerated. */
+    if((updateIndices || updateVertices) && sharedState.flags >= BaseLayerSharedFlag::InstancedQuads) {
+        const bool updateAllInstances = updateIndices || updateAllVertices;
+
+        /* Resize the instance array to fit all drawn data, make a view on the
+           common type prefix */
+        const std::size_t typeSize = sharedState.flags & BaseLayerSharedFlag::Textured ?
+            sizeof(Implementation::BaseLayerTexturedInstance) :
+            sizeof(Implementation::BaseLayerInstance);
+        arrayResize(state.vertices, NoInit, dataIds.size()*typeSize);
+        if(updateAllInstances)
+            state.vertexDirtyRange.add(0, state.vertices.size());
+        else for(std::size_t i = 0; i != dataIds.size(); ++i)
+            if(dirtyData[dataIds[i]])
+                state.vertexDirtyRange.add(i*typeSize, (i + 1)*typeSize);
+        const Containers::StridedArrayView1D<Implementation::BaseLayerInstance> instances{
+            state.vertices,
+            reinterpret_cast<Implementation::BaseLayerInstance*>(state.vertices.data()),
+            dataIds.size(),
+            std::ptrdiff_t(typeSize)};
+
+        /* Convert smoothness from a pixel value to the UI coordinates */
+        const Float smoothness = sharedState.smoothness*(state.uiSize/Vector2{state.framebufferSize}).max();
+
+        /* Fill in the quad rectangles and colors. The padding and smoothness
+           expansion is the same as in the non-instanced single quad case, the
+           vertex shader then interpolates the corners from min and max. */
+        const Containers::StridedArrayView1D<const NodeHandle> nodes = this->nodes();
+        for(std::size_t i = 0; i != dataIds.size(); ++i) {
+            const UnsignedInt dataId = dataIds[i];
+            if(!updateAllInstances && !dirtyData[dataId])
+                continue;
+
+            const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
+            const Implementation::BaseLayerData& data = state.data[dataId];
+
+            Vector4 padding = data.padding - Vector4{smoothness};
+            if(data.calculatedStyle < sharedState.styleCount)
+                padding += sharedState.styles[data.calculatedStyle].padding;
+            else {
+                CORRADE_INTERNAL_DEBUG_ASSERT(data.calculatedStyle < sharedState.styleCount + sharedState.dynamicStyleCount);
+                padding += state.dynamicStylePaddings[data.calculatedStyle - sharedState.styleCount];
+            }
+
+            Implementation::BaseLayerInstance& instance = instances[i];
+            const Vector2 offset = nodeOffsets[nodeId];
+            instance.min = offset + padding.xy();
+            instance.max = offset + nodeSizes[nodeId] - Math::gather<'z', 'w'>(padding);
+            instance.outlineWidth = data.outlineWidth;
+            instance.color = data.color*nodeOpacities[nodeId];
+            /* For dynamic styles the uniform mapping is implicit and they're
+               placed right after all non-dynamic styles */
+            instance.styleUniform = data.calculatedStyle < sharedState.styleCount ?
+                sharedState.styles[data.calculatedStyle].uniform :
+                sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
+        }
+
+        /* Fill in also texture coordinates if enabled, calculated the same way
+           as in the non-instanced single quad case */
+        if(sharedState.flags & BaseLayerSharedFlag::Textured) {
+            const Containers::ArrayView<Implementation::BaseLayerTexturedInstance> texturedInstances = Containers::arrayCast<Implementation::BaseLayerTexturedInstance>(instances).asContiguous();
+
+            for(std::size_t i = 0; i != dataIds.size(); ++i) {
+                if(!updateAllInstances && !dirtyData[dataIds[i]])
+                    continue;
+
+                const Implementation::BaseLayerData& data = state.data[dataIds[i]];
+
+                const Vector2 paddedQuadSizeWithoutSmoothness = instances[i].max - instances[i].min - Vector2{2.0f*smoothness};
+                const Vector2 smoothnessExpansion = data.textureCoordinateSize*smoothness/paddedQuadSizeWithoutSmoothness*Vector2::yScale(-1.0f);
+
+                texturedInstances[i].textureCoordinateMin = {data.textureCoordinateOffset.xy() + Vector2::yAxis(data.textureCoordinateSize.y()) - smoothnessExpansion, data.textureCoordinateOffset.z()};
+                texturedInstances[i].textureCoordinateMax = data.textureCoordinateOffset.xy() + Vector2::xAxis(data.textureCoordinateSize.x()) + smoothnessExpansion;
+            }
+        }
+    }
+
     /* Fill in quads for background blur. They're present only if the layer has
        background blur (and thus compositing) enabled and need to be updated
        only if the compositing rects actually changed */
@@ -915,8 +1132,10 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         /* Expand the quads to include the total blur radius among all passes,
            which is calculated as sqrt(passCount*radius*radius), plus extra
            padding to match smoothness expansion of the rendered quads. The
-           radius is in pixels, convert it to match the [-1, +1] coordinates,
-           i.e. multiply by 2.
+           radius is in pixels of the (potentially downscaled) blur
+           framebuffer, so it's multiplied by the downscale factor to get
+           framebuffer pixels. Then convert it to match the [-1, +1]
+           coordinates, i.e. multiply by 2.
 
            Note that both the `sharedState.backgroundBlurRadius` as well as
            `sharedState.smoothness` are in pixels so they don't need any
@@ -924,7 +1143,7 @@ void BaseLayer::doUpdate(const LayerStates states, const Containers::StridedArra
            converted to be UI-size-relative. */
         /** @todo exclude the cutoff from this? how does the sqrt count into
             that? take a max of count*radiusWithCutoff and this? */
-        const Vector2 blurRadiusPadding = Math::sqrt(Float(state.backgroundBlurPassCount))*(sharedState.backgroundBlurRadius + sharedState.smoothness)*state.uiSize/Vector2{state.framebufferSize};
+        const Vector2 blurRadiusPadding = Math::sqrt(Float(state.backgroundBlurPassCount))*(sharedState.backgroundBlurRadius*sharedState.backgroundBlurDownscale + sharedState.smoothness)*state.uiSize/Vector2{state.framebufferSize};
 
         for(std::size_t i = 0; i != compositeRectOffsets.size(); ++i) {
             const Vector2 min = compositeRectOffsets[i] - blurRadiusPadding;
@@ -691,6 +691,14 @@ top-level hierarchies underneath. To avoid performance issues, it's thus
 recommended to switch to non-blurred layers when stacking reaches a certain
 level.
 
+For large blur radii, the blur can be additionally performed at a half or a
+quarter of the framebuffer resolution using
+@ref BaseLayer::Shared::Configuration::setBackgroundBlurDownscale(), which
+reduces the cost of each pass considerably with a barely noticeable loss in
+quality. Alternatively, @ref BaseLayerSharedFlag::BackgroundBlurDualFilter
+switches to a blur algorithm whose cost doesn't depend on the radius or pass
+count at all.
+
 @m_class{m-row}
 
 @parblock
@@ -844,6 +852,12 @@ a lot more data needs to be uploaded to the GPU, so this flag is only useful
 when the gains in fragment processing time outweigh the additional vertex data
 overhead.
 
+If the bottleneck is instead in generating and uploading the vertex data, for
+example with thousands of quads that change every frame, enabling
+@ref BaseLayerSharedFlag::InstancedQuads makes the layer upload just a single
+instance record per quad instead of four vertices and six indices, with the
+quad expanded in the vertex shader. The visual output is again the same.
+
 In case of background blur, smaller blur radii need less texture samples and
 thus are faster. Besides that, the second argument passed to
 @ref BaseLayer::Shared::Configuration::setBackgroundBlurRadius() is a cutoff
@@ -855,6 +869,21 @@ for decreased blur quality. Finally, @ref setBackgroundBlurPassCount() can be
 used to perform a blur of smaller radius in multiple passes, in case a bigger
 radius is hitting hardware or implementation limits.
 
+For large blur radii or pass counts it may be worth enabling
+@ref BaseLayerSharedFlag::BackgroundBlurDualFilter, which approximates the
+Gaussian blur with a chain of downsample and upsample passes. The cost of it
+is then roughly constant, independently of the radius and pass count.
+
+@subsection Ui-BaseLayer-performance-animations Style animation overhead
+
+Every running @ref BaseLayerStyleAnimator animation occupies a dynamic style,
+whose uniform contents are interpolated on the CPU and uploaded to the GPU
+every frame, along with all other dynamic styles. With many concurrent
+animations, such as when a list of items fades in, this can become a
+bottleneck. Enabling @ref BaseLayerSharedFlag::ShaderStyleAnimation moves the
+interpolation to the shader, with just a single factor per dynamic style
+updated every frame, at the cost of a slightly more complex shader.
+
 @subsection Ui-BaseLayer-performance-layers Balancing draw call overhead and shader complexity
 
 Depending on a concrete use case and target platform, it might be beneficial to
@@ -1390,7 +1419,7 @@ class MAGNUM_UI_EXPORT BaseLayer: public AbstractVisualLayer {
     @ref BaseLayer::Shared::Configuration::setFlags(),
     @ref BaseLayer::Shared::flags()
 */
-enum class BaseLayerSharedFlag: UnsignedByte {
+enum class BaseLayerSharedFlag: UnsignedShort {
     /**
      * Textured drawing. If enabled, the @ref BaseLayerStyleUniform::topColor
      * and @relativeref{BaseLayerStyleUniform,bottomColor} is multiplied with a
@@ -1517,6 +1546,77 @@ enum class BaseLayerSharedFlag: UnsignedByte {
      * @relativeref{BaseLayerSharedFlag,NoOutline} optimizations.
      */
     SubdividedQuads = 1 << 5,
+
+    /**
+     * Render the quads using instancing. Instead of four vertices and six
+     * indices, just a single instance record containing the quad rectangle,
+     * color, outline width, style and texture coordinates is generated for
+     * every data and the quad corners are expanded from it in the vertex
+     * shader, reducing the amount of data generated on the CPU and uploaded
+     * to the GPU to roughly a quarter. As the instances are stored in the
+     * draw order, they're regenerated also on every node order change. The
+     * visual output is exactly the same with and without this flag enabled.
+     *
+     * See @ref Ui-BaseLayer-performance-shaders "Configuring BaseLayer shader complexity"
+     * for more information. Mutually exclusive with
+     * @ref BaseLayerSharedFlag::SubdividedQuads. When used with
+     * @ref BaseLayerGL, drawing uses a base instance if
+     * @gl_extension{ARB,base_instance} on desktop GL,
+     * @gl_extension{ANGLE,base_vertex_base_instance} on OpenGL ES or
+     * @webgl_extension{WEBGL,draw_instanced_base_vertex_base_instance} on
+     * WebGL is available. Otherwise the instance attributes are bound at a
+     * different offset for every draw, which adds a bit of overhead for
+     * layers drawn in many pieces, such as with many clip rects.
+     */
+    InstancedQuads = 1 << 6,
+
+    /**
+     * Blur the background using a dual-filter blur instead of a Gaussian
+     * blur. The background is progressively downsampled to a chain of
+     * half-sized textures and then upsampled back, with the level count and
+     * sample offsets picked to approximate the Gaussian blur of given
+     * @ref BaseLayer::Shared::Configuration::setBackgroundBlurRadius() "radius"
+     * and @ref BaseLayer::setBackgroundBlurPassCount() "pass count".
+     * Compared to the Gaussian blur, whose cost grows with both the radius
+     * and the pass count, the cost of the dual-filter blur stays roughly
+     * constant, making it considerably faster for large blur radii at the
+     * cost of a slightly blockier look. Implies
+     * @ref BaseLayerSharedFlag::BackgroundBlur.
+     *
+     * The cutoff passed to
+     * @ref BaseLayer::Shared::Configuration::setBackgroundBlurRadius() is
+     * ignored with this flag. Unlike with the Gaussian blur, a radius of
+     * @cpp 0 @ce still results in a slight blur.
+     * @see @ref Ui-BaseLayer-performance-shaders
+     */
+    BackgroundBlurDualFilter = BackgroundBlur|(1 << 7),
+
+    /**
+     * Interpolate style animations in the shader. By default,
+     * @ref BaseLayerStyleAnimator calculates interpolated
+     * @ref BaseLayerStyleUniform contents on the CPU every frame and writes
+     * them into a dynamic style, causing all dynamic style uniforms to be
+     * uploaded again. With this flag enabled, each dynamic style references
+     * a source and target style uniform together with an interpolation
+     * factor instead and the shader blends between the two. A running
+     * animation then updates just the factor, and only the source and target
+     * references and factors of all dynamic styles get uploaded, which is
+     * roughly a sixth of the data. Dynamic styles set with
+     * @ref BaseLayer::setDynamicStyle() reference just themselves and are
+     * drawn the same as without this flag. Style paddings are still
+     * interpolated on the CPU.
+     *
+     * The visual output is the same as without this flag, but the style
+     * values have to be fetched and blended twice in both the vertex and the
+     * fragment shader, which makes the drawing slightly more expensive. Has
+     * no effect if @ref BaseLayer::Shared::Configuration::setDynamicStyleCount()
+     * is zero. See @ref Ui-BaseLayer-performance-animations for more
+     * information.
+     *
+     * See @ref TextLayerSharedFlag::ShaderStyleAnimation for an equivalent
+     * in @ref TextLayer.
+     */
+    ShaderStyleAnimation = 1 << 8
 };
 
 /**
@@ -1578,6 +1678,15 @@ class MAGNUM_UI_EXPORT BaseLayer::Shared: public AbstractVisualLayer::Shared {
          */
         UnsignedInt backgroundBlurRadius() const;
 
+        /**
+         * @brief Background blur downscale factor
+         *
+         * Has an effect only if @ref BaseLayerSharedFlag::BackgroundBlur is
+         * present in @ref flags().
+         * @see @ref Configuration::setBackgroundBlurDownscale()
+         */
+        UnsignedInt backgroundBlurDownscale() const;
+
         /**
          * @brief Set style data with implicit mapping between styles and uniforms
          * @param commonUniform Common style uniform data
@@ -1804,16 +1913,47 @@ class MAGNUM_UI_EXPORT BaseLayer::Shared::Configuration {
          * Initial @p radius is @cpp 4 @ce and @p cutoff is
          * @cpp 0.5f/255.0f @ce, i.e. weights that don't contribute any value
          * even when combined from both sides of the blur circle for an
-         * 8-bit-per-channel render target are ignored.
+         * 8-bit-per-channel render target are ignored. With
+         * @ref BaseLayerSharedFlag::BackgroundBlurDualFilter the @p radius is
+         * only approximated and @p cutoff is ignored.
          */
         Configuration& setBackgroundBlurRadius(UnsignedInt radius, Float cutoff = 0.5f/255.0f);
 
+        /** @brief Background blur downscale factor */
+        UnsignedInt backgroundBlurDownscale() const {
+            return _backgroundBlurDownscale;
+        }
+
+        /**
+         * @brief Set background blur downscale factor
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p factor is either @cpp 1 @ce, @cpp 2 @ce or
+         * @cpp 4 @ce. With a value larger than @cpp 1 @ce the blur passes are
+         * performed at half or quarter of the framebuffer resolution and the
+         * result is bilinearly upsampled when drawing, reducing the cost of
+         * each pass to roughly a quarter or a sixteenth. As the blur radius is
+         * in pixels of the downscaled framebuffer, the effective blur radius
+         * gets multiplied by @p factor --- a radius of @cpp 4 @ce with a
+         * factor of @cpp 2 @ce has approximately the same effect as a radius
+         * of @cpp 8 @ce at full resolution, but at a fraction of the cost.
+         * The tradeoff is a loss of detail, which however isn't really
+         * noticeable with larger blur radii.
+         *
+         * Note that this value has an effect only if
+         * @ref BaseLayerSharedFlag::BackgroundBlur is present in
+         * @ref flags(). Initial value is @cpp 1 @ce, i.e. the blur being done
+         * at full resolution.
+         */
+        Configuration& setBackgroundBlurDownscale(UnsignedInt factor);
+
     private:
         UnsignedInt _styleUniformCount, _styleCount;
         UnsignedInt _dynamicStyleCount = 0;
         BaseLayerSharedFlags _flags;
         UnsignedInt _backgroundBlurRadius = 4;
         Float _backgroundBlurCutoff = 0.5f/255.0f;
+        UnsignedInt _backgroundBlurDownscale = 1;
 };
 
 /**
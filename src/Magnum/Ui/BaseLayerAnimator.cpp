@@ -51,6 +51,7 @@ Debug& operator<<(Debug& debug, const BaseLayerStyleAnimatorUpdate value) {
         _c(Uniform)
         _c(Padding)
         _c(Style)
+        _c(Interpolation)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -62,7 +63,8 @@ Debug& operator<<(Debug& debug, const BaseLayerStyleAnimatorUpdates value) {
     return Containers::enumSetDebugOutput(debug, value, "Ui::BaseLayerStyleAnimatorUpdates{}", {
         BaseLayerStyleAnimatorUpdate::Uniform,
         BaseLayerStyleAnimatorUpdate::Padding,
-        BaseLayerStyleAnimatorUpdate::Style
+        BaseLayerStyleAnimatorUpdate::Style,
+        BaseLayerStyleAnimatorUpdate::Interpolation
     });
 }
 
@@ -75,6 +77,9 @@ struct Animation {
     BaseLayerStyleUniform sourceUniform{NoInit}, targetUniform{NoInit};
     Vector4 sourcePadding{NoInit}, targetPadding{NoInit};
     UnsignedInt expectedStyle, sourceStyle, targetStyle, dynamicStyle;
+    /* Used instead of sourceUniform and targetUniform if
+       BaseLayerSharedFlag::ShaderStyleAnimation is enabled */
+    UnsignedInt sourceUniformId, targetUniformId;
     bool uniformDifferent;
     /* 7/3 bytes free */
     Float(*easing)(Float);
@@ -176,6 +181,10 @@ auto BaseLayerStyleAnimator::easing(const AnimatorDataHandle handle) const -> Fl
 }
 
 BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds time, const Containers::MutableBitArrayView active, const Containers::MutableBitArrayView started, const Containers::MutableBitArrayView stopped, const Containers::StridedArrayView1D<Float>& factors, const Containers::MutableBitArrayView remove, const Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
+    return advance(time, active, started, stopped, factors, remove, dynamicStyleUniforms, {}, {}, dynamicStylePaddings, dataStyles);
+}
+
+BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds time, const Containers::MutableBitArrayView active, const Containers::MutableBitArrayView started, const Containers::MutableBitArrayView stopped, const Containers::StridedArrayView1D<Float>& factors, const Containers::MutableBitArrayView remove, const Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
     /* The time...remove fields are checked inside update() right below, no
        need to repeat the check here again, especially since it's an internal
        API */
@@ -206,6 +215,14 @@ BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds
             dynamicStyleUniforms.size() == layerSharedState.dynamicStyleCount &&
             dynamicStylePaddings.size() == layerSharedState.dynamicStyleCount,
             "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style uniform and padding views to have a size of" << layerSharedState.dynamicStyleCount << "but got" << dynamicStyleUniforms.size() << "and" << dynamicStylePaddings.size(), {});
+        const bool interpolateInShader = layerSharedState.flags >= BaseLayerSharedFlag::ShaderStyleAnimation;
+        #ifndef CORRADE_NO_ASSERT
+        const std::size_t expectedInterpolationCount = interpolateInShader ? layerSharedState.dynamicStyleCount : 0;
+        #endif
+        CORRADE_ASSERT(
+            dynamicStyleInterpolationUniforms.size() == expectedInterpolationCount &&
+            dynamicStyleInterpolationFactors.size() == expectedInterpolationCount,
+            "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of" << expectedInterpolationCount << "but got" << dynamicStyleInterpolationUniforms.size() << "and" << dynamicStyleInterpolationFactors.size(), {});
         CORRADE_ASSERT(layerSharedState.setStyleCalled,
             "Ui::BaseLayerStyleAnimator::advance(): no style data was set on the layer", {});
 
@@ -215,7 +232,9 @@ BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds
         if(updatesBase.first())
             updates |= BaseLayerStyleAnimatorUpdate::Style;
         if(updatesBase.second())
-            updates |= BaseLayerStyleAnimatorUpdate::Uniform;
+            updates |= interpolateInShader ?
+                BaseLayerStyleAnimatorUpdate::Interpolation :
+                BaseLayerStyleAnimatorUpdate::Uniform;
 
         /** @todo some way to iterate set bits */
         for(std::size_t i = 0; i != active.size(); ++i) {
@@ -242,8 +261,13 @@ BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds
                    *data* may still be the same even if the ID is different,
                    but checking for that is too much work and any reasonable
                    style should deduplicate those anyway. */
-                animation.sourceUniform = layerSharedState.styleUniforms[sourceStyleData.uniform];
-                animation.targetUniform = layerSharedState.styleUniforms[targetStyleData.uniform];
+                if(interpolateInShader) {
+                    animation.sourceUniformId = sourceStyleData.uniform;
+                    animation.targetUniformId = targetStyleData.uniform;
+                } else {
+                    animation.sourceUniform = layerSharedState.styleUniforms[sourceStyleData.uniform];
+                    animation.targetUniform = layerSharedState.styleUniforms[targetStyleData.uniform];
+                }
                 animation.uniformDifferent = sourceStyleData.uniform != targetStyleData.uniform;
             }
 
@@ -261,13 +285,25 @@ BaseLayerStyleAnimatorUpdates BaseLayerStyleAnimator::advance(const Nanoseconds
 
             const Float factor = animation.easing(factors[i]);
 
+            /* If interpolating in the shader, reference the source and target
+               uniform and update just the factor. Same as below, if the source
+               and target uniforms are the same, the factor isn't reported as
+               changed, except for the first ever switch to the dynamic style
+               which is handled in the base advance() above. */
+            if(interpolateInShader) {
+                dynamicStyleInterpolationUniforms[animation.dynamicStyle] = {animation.sourceUniformId, animation.targetUniformId};
+                if(animation.uniformDifferent) {
+                    dynamicStyleInterpolationFactors[animation.dynamicStyle] = factor;
+                    updates |= BaseLayerStyleAnimatorUpdate::Interpolation;
+                } else dynamicStyleInterpolationFactors[animation.dynamicStyle] = 0.0f;
+
             /* Interpolate the uniform. If the source and target uniforms were
                the same, just copy one of them and don't report that the
                uniforms got changed. The only exception is the first ever
                switch to the dynamic uniform in which case the data has to be
                uploaded. That's handled in the animation.styleDynamic
                allocation above. */
-            if(animation.uniformDifferent) {
+            } else if(animation.uniformDifferent) {
                 BaseLayerStyleUniform uniform{NoInit};
                 #define _c(member) uniform.member = Math::lerp(             \
                     animation.sourceUniform.member,                         \
@@ -68,7 +68,15 @@ enum class BaseLayerStyleAnimatorUpdate: UnsignedByte {
      * Style assignment. Equivalently to calling @ref BaseLayer::setStyle(),
      * causes @ref LayerState::NeedsDataUpdate to be set.
      */
-    Style = 1 << 2
+    Style = 1 << 2,
+
+    /**
+     * Style interpolation references and factors. Returned instead of
+     * @ref BaseLayerStyleAnimatorUpdate::Uniform if
+     * @ref BaseLayerSharedFlag::ShaderStyleAnimation is enabled, causes
+     * @ref LayerState::NeedsCommonDataUpdate to be set.
+     */
+    Interpolation = 1 << 3
 };
 
 /**
@@ -181,7 +189,10 @@ The animation interpolates all properties of @ref BaseLayerStyleUniform
 including outline width and corner radius, as well as the style padding value.
 All style data are fetched from @ref BaseLayer::Shared at animation start,
 meaning that you can reuse existing animations even after the style is updated.
-At the moment, only animation between predefined styles is possible.
+At the moment, only animation between predefined styles is possible. If
+@ref BaseLayerSharedFlag::ShaderStyleAnimation is enabled for the layer, the
+uniforms aren't interpolated on the CPU but in the shader, with just the
+interpolation factor updated every frame.
 
 @section Ui-BaseLayerStyleAnimator-robustness Resolving style conflicts
 
@@ -474,9 +485,52 @@ class MAGNUM_UI_EXPORT BaseLayerStyleAnimator: public AbstractVisualLayerStyleAn
          * should be large enough to contain any valid layer data ID.
          * @ref BaseLayer::Shared::setStyle() is expected to be already called
          * for the layer this animator is assigned to.
+         *
+         * Can be used only if @ref BaseLayerSharedFlag::ShaderStyleAnimation
+         * isn't enabled for the layer, otherwise use the overload below.
          */
         BaseLayerStyleAnimatorUpdates advance(Nanoseconds time, Containers::MutableBitArrayView activeStorage, Containers::MutableBitArrayView startedStorage, Containers::MutableBitArrayView stoppedStorage, const Containers::StridedArrayView1D<Float>& factorStorage, Containers::MutableBitArrayView removeStorage, Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles);
 
+        /**
+         * @brief Advance the animations with shader-side interpolation
+         * @param[in] time                      Time to which to advance
+         * @param[in,out] activeStorage         Storage for the animator to put
+         *      a mask of active animations into
+         * @param[in,out] startedStorage        Storage for the animator to put
+         *      a mask of started animations into
+         * @param[in,out] stoppedStorage        Storage for the animator to put
+         *      a mask of stopped animations into
+         * @param[in,out] factorStorage         Storage for the animator to put
+         *      animation interpolation factors into
+         * @param[in,out] removeStorage         Storage for the animator to put
+         *      a mask of animations to remove into
+         * @param[in,out] dynamicStyleUniforms  Uniforms to animate indexed by
+         *      dynamic style ID
+         * @param[in,out] dynamicStyleInterpolationUniforms Source and target
+         *      uniform IDs to interpolate between, indexed by dynamic style ID
+         * @param[in,out] dynamicStyleInterpolationFactors Factors to
+         *      interpolate the uniforms with, indexed by dynamic style ID
+         * @param[in,out] dynamicStylePaddings  Paddings to animate indexed by
+         *      dynamic style ID
+         * @param[in,out] dataStyles            Style assignments of all layer
+         *      data indexed by data ID
+         * @return Style properties that were updated by the animation
+         *
+         * Like @ref advance(Nanoseconds, Containers::MutableBitArrayView, Containers::MutableBitArrayView, Containers::MutableBitArrayView, const Containers::StridedArrayView1D<Float>&, Containers::MutableBitArrayView, Containers::ArrayView<BaseLayerStyleUniform>, const Containers::StridedArrayView1D<Vector4>&, const Containers::StridedArrayView1D<UnsignedInt>&),
+         * but if @ref BaseLayerSharedFlag::ShaderStyleAnimation is enabled for
+         * the layer, instead of interpolating @p dynamicStyleUniforms, it
+         * writes IDs of the source and target style uniforms to
+         * @p dynamicStyleInterpolationUniforms and the eased interpolation
+         * factor to @p dynamicStyleInterpolationFactors, returning
+         * @ref BaseLayerStyleAnimatorUpdate::Interpolation instead of
+         * @relativeref{BaseLayerStyleAnimatorUpdate,Uniform}. Expects that
+         * @p dynamicStyleInterpolationUniforms and
+         * @p dynamicStyleInterpolationFactors have a size of
+         * @ref BaseLayer::Shared::dynamicStyleCount() if the flag is enabled
+         * and are empty otherwise.
+         */
+        BaseLayerStyleAnimatorUpdates advance(Nanoseconds time, Containers::MutableBitArrayView activeStorage, Containers::MutableBitArrayView startedStorage, Containers::MutableBitArrayView stoppedStorage, const Containers::StridedArrayView1D<Float>& factorStorage, Containers::MutableBitArrayView removeStorage, Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles);
+
     private:
         struct State;
 
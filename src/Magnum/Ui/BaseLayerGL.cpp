@@ -27,7 +27,9 @@
 #include "BaseLayerGL.h"
 
 #include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Utility/Format.h>
 #include <Corrade/Utility/Resource.h>
@@ -35,9 +37,7 @@
 #include <Magnum/GL/AbstractShaderProgram.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/Context.h>
-#ifndef MAGNUM_TARGET_GLES
 #include <Magnum/GL/Extensions.h>
-#endif
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/Mesh.h>
 #include <Magnum/GL/Renderer.h>
@@ -51,6 +51,7 @@
 #include "Magnum/Ui/Implementation/baseLayerState.h"
 #include "Magnum/Ui/Implementation/blurCoefficients.h"
 #include "Magnum/Ui/Implementation/BlurShaderGL.h"
+#include "Magnum/Ui/Implementation/bufferUploadGL.h"
 
 #ifdef MAGNUM_UI_BUILD_STATIC
 static void importShaderResources() {
@@ -79,7 +80,9 @@ class BaseShaderGL: public GL::AbstractShaderProgram {
             NoRoundedCorners = 1 << 2,
             NoOutline = 1 << 3,
             TextureMask = 1 << 4,
-            SubdividedQuads = 1 << 5
+            SubdividedQuads = 1 << 5,
+            InstancedQuads = 1 << 6,
+            ShaderStyleAnimation = 1 << 7
         };
 
         typedef Containers::EnumSet<Flag> Flags;
@@ -97,8 +100,14 @@ class BaseShaderGL: public GL::AbstractShaderProgram {
         typedef GL::Attribute<3, Vector4> Color4;
         typedef GL::Attribute<4, UnsignedInt> Style;
         typedef GL::Attribute<5, Vector3> TextureCoordinates;
+        /* Only if InstancedQuads are set, with the OutlineWidth, Color4, Style
+           and TextureCoordinates being per-instance as well */
+        typedef GL::Attribute<0, Vector4> InstanceQuad;
+        typedef GL::Attribute<6, Vector2> InstanceTextureCoordinatesMax;
 
-        explicit BaseShaderGL(Flags flags, UnsignedInt styleCount);
+        /* The dynamicStyleCount is used only if ShaderStyleAnimation is
+           set, styleCount includes it */
+        explicit BaseShaderGL(Flags flags, UnsignedInt styleCount, UnsignedInt dynamicStyleCount);
 
         BaseShaderGL& setProjection(const Vector2& scaling, const Float pixelScaling) {
             /* XY is Y-flipped scale from the UI size to the 2x2 unit square,
@@ -140,7 +149,7 @@ CORRADE_ENUMSET_OPERATORS(BaseShaderGL::Flags)
 #pragma clang diagnostic pop
 #endif
 
-BaseShaderGL::BaseShaderGL(const Flags flags, const UnsignedInt styleCount): _flags{flags} {
+BaseShaderGL::BaseShaderGL(const Flags flags, const UnsignedInt styleCount, const UnsignedInt dynamicStyleCount): _flags{flags} {
     GL::Context& context = GL::Context::current();
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::explicit_attrib_location);
@@ -163,17 +172,24 @@ BaseShaderGL::BaseShaderGL(const Flags flags, const UnsignedInt styleCount): _fl
         #endif
     });
 
+    const Containers::String shaderStyleAnimationDefines = flags & Flag::ShaderStyleAnimation ? Utility::format(
+        "#define SHADER_STYLE_ANIMATION\n"
+        "#define DYNAMIC_STYLE_COUNT {}\n", dynamicStyleCount) : Containers::String{};
+
     GL::Shader vert{version, GL::Shader::Type::Vertex};
     vert.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(flags & Flag::BackgroundBlur ? "#define BACKGROUND_BLUR\n"_s : ""_s)
         .addSource(flags & Flag::Textured ? "#define TEXTURED\n"_s : ""_s)
         .addSource(flags & Flag::NoOutline ? "#define NO_OUTLINE\n"_s : ""_s)
         .addSource(flags & Flag::SubdividedQuads ? "#define SUBDIVIDED_QUADS\n"_s : ""_s)
+        .addSource(flags & Flag::InstancedQuads ? "#define INSTANCED_QUADS\n"_s : ""_s)
         .addSource(rs.getString("compatibility.glsl"_s))
         .addSource(rs.getString("BaseShader.vert"_s));
 
     GL::Shader frag{version, GL::Shader::Type::Fragment};
     frag.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(flags & Flag::BackgroundBlur ? "#define BACKGROUND_BLUR\n"_s : ""_s)
         .addSource(flags & Flag::Textured ? "#define TEXTURED\n"_s : ""_s)
         .addSource(flags & Flag::NoRoundedCorners ? "#define NO_ROUNDED_CORNERS\n"_s : ""_s)
@@ -329,6 +345,66 @@ BlurShaderGL::BlurShaderGL(UnsignedInt radius, Float limit) {
     }
 }
 
+DualFilterBlurShaderGL::DualFilterBlurShaderGL(const Mode mode) {
+    using namespace Containers::Literals;
+
+    GL::Context& context = GL::Context::current();
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::explicit_attrib_location);
+    #endif
+
+    #ifdef MAGNUM_UI_BUILD_STATIC
+    importShaderResources();
+    #endif
+
+    Utility::Resource rs{"MagnumUi"_s};
+
+    const GL::Version version = context.supportedVersion({
+        #ifndef MAGNUM_TARGET_GLES
+        GL::Version::GL330
+        #else
+        GL::Version::GLES300
+            #ifndef MAGNUM_TARGET_WEBGL
+            , GL::Version::GLES310
+            #endif
+        #endif
+    });
+
+    GL::Shader vert{version, GL::Shader::Type::Vertex};
+    vert.addSource(rs.getString("compatibility.glsl"_s))
+        .addSource(rs.getString("BlurShader.vert"_s));
+
+    GL::Shader frag{version, GL::Shader::Type::Fragment};
+    frag.addSource(rs.getString("compatibility.glsl"_s))
+        .addSource(mode == Mode::Downsample ?
+            "#define DOWNSAMPLE\n"_s : "#define UPSAMPLE\n"_s)
+        .addSource(rs.getString("DualFilterBlurShader.frag"_s));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(vert.compile() && frag.compile());
+
+    attachShaders({vert, frag});
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>())
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(version < GL::Version::GLES310)
+    #endif
+    {
+        _projectionUniform = uniformLocation("projection"_s);
+        _offsetUniform = uniformLocation("sampleOffset"_s);
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>())
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(version < GL::Version::GLES310)
+    #endif
+    {
+        setUniform(uniformLocation("textureData"_s), TextureBinding);
+    }
+}
+
 struct BaseLayerGL::Shared::State: BaseLayer::Shared::State {
     explicit State(Shared& self, const Configuration& configuration);
 
@@ -337,12 +413,28 @@ struct BaseLayerGL::Shared::State: BaseLayer::Shared::State {
        has its own copy instead */
     GL::Buffer styleBuffer{NoCreate};
 
-    /* These are created only if Flag::BackgroundBlur is enabled */
+    /* These are created only if Flag::BackgroundBlur is enabled. The
+       horizontal texture contains the final blur output, with
+       Flag::BackgroundBlurDualFilter the vertical texture and the Gaussian
+       blur shader aren't created. */
     GL::Texture2D backgroundBlurTextureVertical{NoCreate},
                   backgroundBlurTextureHorizontal{NoCreate};
     GL::Framebuffer backgroundBlurFramebufferVertical{NoCreate},
                     backgroundBlurFramebufferHorizontal{NoCreate};
     BlurShaderGL backgroundBlurShader{NoCreate};
+
+    /* These are created only if Flag::BackgroundBlurDualFilter is enabled.
+       The textures are progressively halved in size, with the first being
+       half the size of backgroundBlurTextureHorizontal, which is the level 0
+       the upsampling ends at. */
+    Containers::Array<GL::Texture2D> backgroundBlurLevelTextures;
+    Containers::Array<GL::Framebuffer> backgroundBlurLevelFramebuffers;
+    DualFilterBlurShaderGL backgroundBlurDownsampleShader{NoCreate},
+        backgroundBlurUpsampleShader{NoCreate};
+
+    /* Used only if Flag::InstancedQuads is enabled. If not set, the instance
+       attributes get bound at an offset for every draw instead. */
+    bool baseInstanceSupported = false;
 };
 
 BaseLayerGL::Shared::State::State(Shared& self, const Configuration& configuration): BaseLayer::Shared::State{self, configuration}, shader{
@@ -352,13 +444,31 @@ BaseLayerGL::Shared::State::State(Shared& self, const Configuration& configurati
     _c(NoRoundedCorners)|
     _c(NoOutline)|
     _c(TextureMask)|
-    _c(SubdividedQuads),
+    _c(SubdividedQuads)|
+    _c(InstancedQuads)|
+    /* Interpolation in the shader makes sense only with dynamic styles */
+    (configuration.dynamicStyleCount() ? _c(ShaderStyleAnimation) : BaseShaderGL::Flags{}),
     #undef _c
-    configuration.styleUniformCount() + configuration.dynamicStyleCount()}
+    configuration.styleUniformCount() + configuration.dynamicStyleCount(),
+    configuration.dynamicStyleCount()}
 {
+    /* Drawing a subset of the instances uses a base instance if available */
+    if(configuration.flags() >= BaseLayerSharedFlag::InstancedQuads) {
+        #ifndef MAGNUM_TARGET_GLES
+        baseInstanceSupported = GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>();
+        #elif !defined(MAGNUM_TARGET_WEBGL)
+        baseInstanceSupported = GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::base_vertex_base_instance>();
+        #else
+        baseInstanceSupported = GL::Context::current().isExtensionSupported<GL::Extensions::WEBGL::draw_instanced_base_vertex_base_instance>();
+        #endif
+    }
+
     if(!dynamicStyleCount)
         styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(BaseLayerCommonStyleUniform) + sizeof(BaseLayerStyleUniform)*styleUniformCount}};
-    if(configuration.flags() & BaseLayerSharedFlag::BackgroundBlur)
+    if(configuration.flags() >= BaseLayerSharedFlag::BackgroundBlurDualFilter) {
+        backgroundBlurDownsampleShader = DualFilterBlurShaderGL{DualFilterBlurShaderGL::Mode::Downsample};
+        backgroundBlurUpsampleShader = DualFilterBlurShaderGL{DualFilterBlurShaderGL::Mode::Upsample};
+    } else if(configuration.flags() & BaseLayerSharedFlag::BackgroundBlur)
         backgroundBlurShader = BlurShaderGL{configuration.backgroundBlurRadius(), configuration.backgroundBlurCutoff()};
 }
 
@@ -375,37 +485,39 @@ void BaseLayerGL::Shared::doSetStyle(const BaseLayerCommonStyleUniform& commonUn
     state.styleBuffer.setSubData(sizeof(BaseLayerCommonStyleUniform), uniforms);
 }
 
-struct BaseLayerGL::State: BaseLayer::State {
-    explicit State(Shared::State& shared): BaseLayer::State{shared} {}
-
-    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array},
-        indexBuffer{GL::Buffer::TargetHint::ElementArray};
-    GL::Mesh mesh;
-    Vector2 clipScale;
-
-    /* Used only if Flag::Textured is enabled. Is non-owning if
-       setTexture(GL::Texture2DArray&) was called, owning if
-       setTexture(GL::Texture2DArray&&). */
-    GL::Texture2DArray texture{NoCreate};
-
-    /* Used only if shared.dynamicStyleCount is non-zero, in which case it's
-       created during the first doUpdate(). Even though the size is known in
-       advance, the NoCreate'd state is used to correctly perform the first
-       ever style upload without having to implicitly set any LayerStates. */
-    GL::Buffer styleBuffer{NoCreate};
+namespace {
 
-    /* Used only if Flag::BackgroundBlur is enabled */
-    GL::Buffer backgroundBlurVertexBuffer{NoCreate};
-    GL::Buffer backgroundBlurIndexBuffer{NoCreate};
-    GL::Mesh backgroundBlurMesh{NoCreate};
-};
+/* Called from the constructor and then again each time the buffers get
+   recreated. With instanced quads and no base instance support it's called
+   also for each distinct first instance to draw in `instanceOffset`. */
+void setupMesh(GL::Mesh& mesh, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, const BaseLayerSharedFlags flags, const UnsignedInt instanceOffset = 0) {
+    /* Instanced quads have no per-vertex attributes and no indices, the four
+       corners are drawn as a triangle strip and expanded from the instance
+       rectangle in the shader based on the vertex ID */
+    if(flags >= BaseLayerSharedFlag::InstancedQuads) {
+        mesh.setPrimitive(GL::MeshPrimitive::TriangleStrip)
+            .setCount(4);
+        if(flags & BaseLayerSharedFlag::Textured) {
+            mesh.addVertexBufferInstanced(vertexBuffer, 1, instanceOffset*sizeof(Implementation::BaseLayerTexturedInstance),
+                BaseShaderGL::InstanceQuad{},
+                BaseShaderGL::OutlineWidth{},
+                BaseShaderGL::Color4{},
+                BaseShaderGL::Style{},
+                BaseShaderGL::TextureCoordinates{},
+                BaseShaderGL::InstanceTextureCoordinatesMax{});
+        } else {
+            mesh.addVertexBufferInstanced(vertexBuffer, 1, instanceOffset*sizeof(Implementation::BaseLayerInstance),
+                BaseShaderGL::InstanceQuad{},
+                BaseShaderGL::OutlineWidth{},
+                BaseShaderGL::Color4{},
+                BaseShaderGL::Style{});
+        }
+        return;
+    }
 
-BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLayer{handle, Containers::pointer<State>(static_cast<Shared::State&>(*sharedState_._state))} {
-    auto& state = static_cast<State&>(*_state);
-    Shared::State& sharedState = static_cast<Shared::State&>(state.shared);
-    if(!(sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads)) {
-        if(sharedState.flags & BaseLayerSharedFlag::Textured) {
-            state.mesh.addVertexBuffer(state.vertexBuffer, 0,
+    if(!(flags >= BaseLayerSharedFlag::SubdividedQuads)) {
+        if(flags & BaseLayerSharedFlag::Textured) {
+            mesh.addVertexBuffer(vertexBuffer, 0,
                 BaseShaderGL::Position{},
                 BaseShaderGL::CenterDistance{},
                 BaseShaderGL::OutlineWidth{},
@@ -413,7 +525,7 @@ BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLa
                 BaseShaderGL::Style{},
                 BaseShaderGL::TextureCoordinates{});
         } else {
-            state.mesh.addVertexBuffer(state.vertexBuffer, 0,
+            mesh.addVertexBuffer(vertexBuffer, 0,
                 BaseShaderGL::Position{},
                 BaseShaderGL::CenterDistance{},
                 BaseShaderGL::OutlineWidth{},
@@ -421,8 +533,8 @@ BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLa
                 BaseShaderGL::Style{});
         }
     } else {
-        if(sharedState.flags & BaseLayerSharedFlag::Textured) {
-            state.mesh.addVertexBuffer(state.vertexBuffer, 0,
+        if(flags & BaseLayerSharedFlag::Textured) {
+            mesh.addVertexBuffer(vertexBuffer, 0,
                 BaseShaderGL::Position{},
                 BaseShaderGL::SubdividedQuadOutlineWidth{},
                 BaseShaderGL::Color4{},
@@ -430,7 +542,7 @@ BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLa
                 BaseShaderGL::SubdividedQuadCenterDistanceYTextureScale{},
                 BaseShaderGL::TextureCoordinates{});
         } else {
-            state.mesh.addVertexBuffer(state.vertexBuffer, 0,
+            mesh.addVertexBuffer(vertexBuffer, 0,
                 BaseShaderGL::Position{},
                 BaseShaderGL::SubdividedQuadOutlineWidth{},
                 BaseShaderGL::Color4{},
@@ -438,7 +550,62 @@ BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLa
                 BaseShaderGL::SubdividedQuadCenterDistanceY{});
         }
     }
-    state.mesh.setIndexBuffer(state.indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+    mesh.setIndexBuffer(indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+}
+
+/* Size of the framebuffers the background blur is done in, rounded up. Used
+   also to calculate sizes of the dual-filter blur levels. */
+Vector2i backgroundBlurSize(const Vector2i& framebufferSize, const UnsignedInt downscale) {
+    return (framebufferSize + Vector2i{Int(downscale) - 1})/Int(downscale);
+}
+
+/* Max count of levels the dual-filter blur downsamples to. With 8 levels the
+   variance reaches ~20k, which is way more than a Gaussian blur of the max
+   radius would produce in any sane pass count. */
+constexpr UnsignedInt BackgroundBlurMaxLevelCount = 8;
+
+}
+
+struct BaseLayerGL::State: BaseLayer::State {
+    explicit State(Shared::State& shared): BaseLayer::State{shared} {}
+
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array},
+        indexBuffer{GL::Buffer::TargetHint::ElementArray};
+    BufferUploadGL vertexUpload, indexUpload;
+    GL::Mesh mesh;
+    Vector2 clipScale;
+
+    /* Used only if setBufferStreamingEnabled() is set */
+    BufferStreamGL bufferStream;
+    bool bufferStreaming = false;
+
+    /* Used only if Flag::InstancedQuads is enabled and base instance isn't
+       supported. Meshes with the instance attributes bound at given instance
+       offset, created by doDraw() the first time an offset is drawn from and
+       cleared by doUpdate() when the offsets or the buffers change. */
+    Containers::Array<Containers::Pair<UnsignedInt, GL::Mesh>> instanceOffsetMeshes;
+
+    /* Used only if Flag::Textured is enabled. Is non-owning if
+       setTexture(GL::Texture2DArray&) was called, owning if
+       setTexture(GL::Texture2DArray&&). */
+    GL::Texture2DArray texture{NoCreate};
+
+    /* Used only if shared.dynamicStyleCount is non-zero, in which case it's
+       created during the first doUpdate(). Even though the size is known in
+       advance, the NoCreate'd state is used to correctly perform the first
+       ever style upload without having to implicitly set any LayerStates. */
+    GL::Buffer styleBuffer{NoCreate};
+
+    /* Used only if Flag::BackgroundBlur is enabled */
+    GL::Buffer backgroundBlurVertexBuffer{NoCreate};
+    GL::Buffer backgroundBlurIndexBuffer{NoCreate};
+    GL::Mesh backgroundBlurMesh{NoCreate};
+};
+
+BaseLayerGL::BaseLayerGL(const LayerHandle handle, Shared& sharedState_): BaseLayer{handle, Containers::pointer<State>(static_cast<Shared::State&>(*sharedState_._state))} {
+    auto& state = static_cast<State&>(*_state);
+    Shared::State& sharedState = static_cast<Shared::State&>(state.shared);
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, sharedState.flags);
 
     if(sharedState.flags >= BaseLayerSharedFlag::BackgroundBlur) {
         state.backgroundBlurVertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
@@ -464,6 +631,31 @@ BaseLayerGL& BaseLayerGL::setTexture(GL::Texture2DArray&& texture) {
     return *this;
 }
 
+bool BaseLayerGL::isBufferStreamingEnabled() const {
+    return static_cast<const State&>(*_state).bufferStreaming;
+}
+
+BaseLayerGL& BaseLayerGL::setBufferStreamingEnabled(const bool enabled) {
+    auto& state = static_cast<State&>(*_state);
+    if(state.bufferStreaming == enabled)
+        return *this;
+
+    /* Persistently mapped buffers have an immutable storage that can't be
+       used by the regular upload path and vice versa, so start from scratch
+       and trigger a full upload */
+    state.bufferStreaming = enabled;
+    state.vertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+    state.indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+    state.vertexUpload = BufferUploadGL{};
+    state.indexUpload = BufferUploadGL{};
+    bufferStreamReset(state.bufferStream);
+    state.mesh = GL::Mesh{};
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, static_cast<Shared::State&>(state.shared).flags);
+    state.instanceOffsetMeshes = {};
+    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    return *this;
+}
+
 LayerFeatures BaseLayerGL::doFeatures() const {
     return BaseLayer::doFeatures()|LayerFeature::DrawUsesBlending|LayerFeature::DrawUsesScissor;
 }
@@ -481,19 +673,57 @@ void BaseLayerGL::doSetSize(const Vector2& size, const Vector2i& framebufferSize
     state.clipScale = Vector2{framebufferSize}/size;
 
     if(sharedState.flags & BaseLayerSharedFlag::BackgroundBlur) {
-        sharedState.backgroundBlurShader.setProjection(size);
-
-        (sharedState.backgroundBlurTextureVertical = GL::Texture2D{})
-            .setWrapping(GL::SamplerWrapping::ClampToEdge)
-            .setStorage(1, GL::TextureFormat::RGBA8, framebufferSize);
+        if(sharedState.flags >= BaseLayerSharedFlag::BackgroundBlurDualFilter) {
+            sharedState.backgroundBlurDownsampleShader.setProjection(size);
+            sharedState.backgroundBlurUpsampleShader.setProjection(size);
+        } else
+            sharedState.backgroundBlurShader.setProjection(size);
+
+        /* If downscaling is enabled, the blur is done in a smaller
+           framebuffer, rounded up to not lose the last row / column. The
+           projection is the same, the viewport takes care of the scaling. The
+           textures are linearly filtered so the final draw upsamples them
+           bilinearly. */
+        const Vector2i blurSize = backgroundBlurSize(framebufferSize, sharedState.backgroundBlurDownscale);
         (sharedState.backgroundBlurTextureHorizontal = GL::Texture2D{})
+            .setMinificationFilter(GL::SamplerFilter::Linear, GL::SamplerMipmap::Base)
+            .setMagnificationFilter(GL::SamplerFilter::Linear)
             .setWrapping(GL::SamplerWrapping::ClampToEdge)
-            .setStorage(1, GL::TextureFormat::RGBA8, framebufferSize);
-
-        (sharedState.backgroundBlurFramebufferVertical = GL::Framebuffer{{{}, framebufferSize}})
-            .attachTexture(GL::Framebuffer::ColorAttachment{0}, sharedState.backgroundBlurTextureVertical, 0);
-        (sharedState.backgroundBlurFramebufferHorizontal = GL::Framebuffer{{{}, framebufferSize}})
+            .setStorage(1, GL::TextureFormat::RGBA8, blurSize);
+        (sharedState.backgroundBlurFramebufferHorizontal = GL::Framebuffer{{{}, blurSize}})
             .attachTexture(GL::Framebuffer::ColorAttachment{0}, sharedState.backgroundBlurTextureHorizontal, 0);
+
+        /* The dual-filter blur needs a chain of progressively halved
+           textures instead of the second full-size one. Stop before the
+           smallest level would get smaller than 2x2, there's nothing to gain
+           from going further. */
+        if(sharedState.flags >= BaseLayerSharedFlag::BackgroundBlurDualFilter) {
+            UnsignedInt levelCount = 1;
+            while(levelCount != BackgroundBlurMaxLevelCount && backgroundBlurSize(blurSize, 1 << (levelCount + 1)).min() >= 2)
+                ++levelCount;
+
+            sharedState.backgroundBlurLevelTextures = Containers::Array<GL::Texture2D>{DirectInit, levelCount, NoCreate};
+            sharedState.backgroundBlurLevelFramebuffers = Containers::Array<GL::Framebuffer>{DirectInit, levelCount, NoCreate};
+            for(UnsignedInt i = 0; i != levelCount; ++i) {
+                const Vector2i levelSize = backgroundBlurSize(blurSize, 1 << (i + 1));
+                (sharedState.backgroundBlurLevelTextures[i] = GL::Texture2D{})
+                    .setMinificationFilter(GL::SamplerFilter::Linear, GL::SamplerMipmap::Base)
+                    .setMagnificationFilter(GL::SamplerFilter::Linear)
+                    .setWrapping(GL::SamplerWrapping::ClampToEdge)
+                    .setStorage(1, GL::TextureFormat::RGBA8, levelSize);
+                (sharedState.backgroundBlurLevelFramebuffers[i] = GL::Framebuffer{{{}, levelSize}})
+                    .attachTexture(GL::Framebuffer::ColorAttachment{0}, sharedState.backgroundBlurLevelTextures[i], 0);
+            }
+
+        } else {
+            (sharedState.backgroundBlurTextureVertical = GL::Texture2D{})
+                .setMinificationFilter(GL::SamplerFilter::Linear, GL::SamplerMipmap::Base)
+                .setMagnificationFilter(GL::SamplerFilter::Linear)
+                .setWrapping(GL::SamplerWrapping::ClampToEdge)
+                .setStorage(1, GL::TextureFormat::RGBA8, blurSize);
+            (sharedState.backgroundBlurFramebufferVertical = GL::Framebuffer{{{}, blurSize}})
+                .attachTexture(GL::Framebuffer::ColorAttachment{0}, sharedState.backgroundBlurTextureVertical, 0);
+        }
     }
 }
 
@@ -506,24 +736,81 @@ void BaseLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
        changed, it should be accompanied by NeedsCommonDataUpdate being set in
        order to be correctly handled below. */
     const bool sharedStyleChanged = sharedState.styleUpdateStamp != state.styleUpdateStamp;
-    CORRADE_INTERNAL_ASSERT(!sharedState.dynamicStyleCount || (!sharedStyleChanged && !state.dynamicStyleChanged) || states >= LayerState::NeedsCommonDataUpdate);
+    CORRADE_INTERNAL_ASSERT(!sharedState.dynamicStyleCount || (!sharedStyleChanged && !state.dynamicStyleChanged && !state.dynamicStyleInterpolationChanged) || states >= LayerState::NeedsCommonDataUpdate);
 
     BaseLayer::doUpdate(states, dataIds, clipRectIds, clipRectDataCounts, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, clipRectOffsets, clipRectSizes, compositeRectOffsets, compositeRectSizes);
 
     /* The branching here mirrors how BaseLayer::doUpdate() restricts the
-       updates. Keep in sync. */
-    if(states >= LayerState::NeedsNodeOrderUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
-        state.indexBuffer.setData(state.indices);
-        state.mesh.setCount(state.indices.size());
-    }
-    if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
-       states >= LayerState::NeedsNodeEnabledUpdate ||
-       states >= LayerState::NeedsNodeOpacityUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
-        state.vertexBuffer.setData(state.vertices);
+       updates. Keep in sync. With buffer streaming, both vertices and
+       indices are written to a new place every time, so the branches are
+       merged. */
+    if(state.bufferStreaming) {
+        if(states >= LayerState::NeedsNodeOrderUpdate ||
+           states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+           states >= LayerState::NeedsNodeEnabledUpdate ||
+           states >= LayerState::NeedsNodeOpacityUpdate ||
+           states >= LayerState::NeedsDataUpdate)
+        {
+            const std::size_t vertexStride = sharedState.flags >= BaseLayerSharedFlag::InstancedQuads ?
+                (sharedState.flags & BaseLayerSharedFlag::Textured ?
+                    sizeof(Implementation::BaseLayerTexturedInstance) :
+                    sizeof(Implementation::BaseLayerInstance)) :
+                sharedState.flags >= BaseLayerSharedFlag::SubdividedQuads ?
+                (sharedState.flags & BaseLayerSharedFlag::Textured ?
+                    sizeof(Implementation::BaseLayerSubdividedTexturedVertex) :
+                    sizeof(Implementation::BaseLayerSubdividedVertex)) :
+                (sharedState.flags & BaseLayerSharedFlag::Textured ?
+                    sizeof(Implementation::BaseLayerTexturedVertex) :
+                    sizeof(Implementation::BaseLayerVertex));
+            if(bufferStreamUpload(state.vertexBuffer, state.indexBuffer, state.bufferStream, state.vertices, vertexStride, state.indices)) {
+                state.mesh = GL::Mesh{};
+                setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, sharedState.flags);
+            }
+            /* The instances are at a different base offset after every
+               upload, and the buffers may have been recreated, so the meshes
+               used without base instance support have to be set up again */
+            arrayClear(state.instanceOffsetMeshes);
+            /* With instanced quads the count is always 4, and the instance
+               count is set in doDraw() */
+            if(!(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads))
+                state.mesh.setCount(state.indices.size());
+        }
+
+        /* Everything got copied, so the modified ranges aren't needed */
+        state.vertexDirtyRange.reset();
+        state.indexDirtyRange.reset();
+    } else if(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads) {
+        /* With a different draw order the data get drawn from different
+           instance offsets, so the meshes used without base instance support
+           would be mostly unused. They stay valid otherwise, as the buffer is
+           only ever reallocated in place. */
+        if(states >= LayerState::NeedsNodeOrderUpdate)
+            arrayClear(state.instanceOffsetMeshes);
+
+        /* Instances are in draw order, so they change with node order as
+           well. There are no indices to upload. */
+        if(states >= LayerState::NeedsNodeOrderUpdate ||
+           states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+           states >= LayerState::NeedsNodeEnabledUpdate ||
+           states >= LayerState::NeedsNodeOpacityUpdate ||
+           states >= LayerState::NeedsDataUpdate)
+        {
+            bufferUploadDirty(state.vertexBuffer, state.vertexUpload, state.vertices, state.vertexDirtyRange);
+        }
+    } else {
+        if(states >= LayerState::NeedsNodeOrderUpdate ||
+           states >= LayerState::NeedsDataUpdate)
+        {
+            bufferUploadDirty(state.indexBuffer, state.indexUpload, state.indices, state.indexDirtyRange);
+            state.mesh.setCount(state.indices.size());
+        }
+        if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+           states >= LayerState::NeedsNodeEnabledUpdate ||
+           states >= LayerState::NeedsNodeOpacityUpdate ||
+           states >= LayerState::NeedsDataUpdate)
+        {
+            bufferUploadDirty(state.vertexBuffer, state.vertexUpload, state.vertices, state.vertexDirtyRange);
+        }
     }
     if(states >= LayerState::NeedsCompositeOffsetSizeUpdate && sharedState.flags & BaseLayerSharedFlag::BackgroundBlur) {
         state.backgroundBlurIndexBuffer.setData(state.backgroundBlurIndices);
@@ -538,7 +825,9 @@ void BaseLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
         const bool needsFirstUpload = !state.styleBuffer.id();
         if(needsFirstUpload) {
             /** @todo check if DynamicDraw has any effect on perf */
-            state.styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(BaseLayerCommonStyleUniform) + sizeof(BaseLayerStyleUniform)*(sharedState.styleUniformCount + sharedState.dynamicStyleCount)}, GL::BufferUsage::DynamicDraw};
+            /* With ShaderStyleAnimation the style interpolations are placed
+               after all style uniforms, otherwise the view is empty */
+            state.styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(BaseLayerCommonStyleUniform) + sizeof(BaseLayerStyleUniform)*(sharedState.styleUniformCount + sharedState.dynamicStyleCount) + sizeof(Implementation::BaseLayerStyleInterpolation)*state.dynamicStyleInterpolations.size()}, GL::BufferUsage::DynamicDraw};
         }
         if(needsFirstUpload || sharedStyleChanged) {
             state.styleBuffer.setSubData(0, {&sharedState.commonStyleUniform, 1});
@@ -550,6 +839,12 @@ void BaseLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
             state.styleBuffer.setSubData(sizeof(BaseLayerCommonStyleUniform) + sizeof(BaseLayerStyleUniform)*sharedState.styleUniformCount, state.dynamicStyleUniforms);
             state.dynamicStyleChanged = false;
         }
+        /* With ShaderStyleAnimation, a running animation changes just the
+           interpolations, which are a fraction of the size of the uniforms */
+        if(!state.dynamicStyleInterpolations.isEmpty() && (needsFirstUpload || state.dynamicStyleInterpolationChanged)) {
+            state.styleBuffer.setSubData(sizeof(BaseLayerCommonStyleUniform) + sizeof(BaseLayerStyleUniform)*(sharedState.styleUniformCount + sharedState.dynamicStyleCount), state.dynamicStyleInterpolations);
+            state.dynamicStyleInterpolationChanged = false;
+        }
     }
 }
 
@@ -562,20 +857,69 @@ void BaseLayerGL::doComposite(AbstractRenderer& renderer, const Containers::Stri
         .setIndexOffset(offset*6)
         .setCount(count*6);
 
+    const Vector2i blurSize = backgroundBlurSize(state.framebufferSize, sharedState.backgroundBlurDownscale);
+
+    /* The dual-filter blur downsamples the input through a chain of
+       progressively halved textures and then upsamples it back, with the
+       level count and tap offsets picked to approximate the variance of the
+       Gaussian blur with given radius and pass count. Thus, instead of
+       repeating the whole process for each pass, the pass count affects just
+       the level count and offsets, and the cost stays roughly constant. For
+       both the downsample and the upsample, the offset is a half-texel of the
+       lower-resolution texture of the pair. Same as with the Gaussian blur
+       below, only the area covered by the mesh is processed. */
+    if(sharedState.flags >= BaseLayerSharedFlag::BackgroundBlurDualFilter) {
+        Float offsetScale;
+        const UnsignedInt levelCount = dualFilterBlurParameters(sharedState.backgroundBlurRadius, state.backgroundBlurPassCount, sharedState.backgroundBlurLevelTextures.size(), offsetScale);
+
+        GL::Texture2D* input = &rendererGL.compositingTexture();
+        for(UnsignedInt i = 0; i != levelCount; ++i) {
+            sharedState.backgroundBlurLevelFramebuffers[i].bind();
+            sharedState.backgroundBlurDownsampleShader
+                .setOffset(0.5f*offsetScale/Vector2{backgroundBlurSize(blurSize, 1 << (i + 1))})
+                .bindTexture(*input)
+                .draw(state.backgroundBlurMesh);
+            input = &sharedState.backgroundBlurLevelTextures[i];
+        }
+
+        /* The last upsample goes into the same texture the Gaussian blur
+           ends in, which is what doDraw() binds */
+        for(UnsignedInt i = levelCount; i != 0; --i) {
+            if(i == 1)
+                sharedState.backgroundBlurFramebufferHorizontal.bind();
+            else
+                sharedState.backgroundBlurLevelFramebuffers[i - 2].bind();
+            sharedState.backgroundBlurUpsampleShader
+                .setOffset(0.5f*offsetScale/Vector2{backgroundBlurSize(blurSize, 1 << i)})
+                .bindTexture(*input)
+                .draw(state.backgroundBlurMesh);
+            if(i != 1)
+                input = &sharedState.backgroundBlurLevelTextures[i - 2];
+        }
+
+        return;
+    }
+
     /* Perform the blur in as many passes as desired. For the first pass the
        input is the compositing framebuffer texture, successive passes take
-       output of the previous horizontal blur for the next vertical blur. */
+       output of the previous horizontal blur for the next vertical blur. The
+       mesh contains just the composite rects expanded by the blur radius, so
+       only the area that actually gets blurred is processed. If downscaling
+       is enabled, the first pass samples the full-resolution compositing
+       texture at the downscaled texel size, which the linear filtering takes
+       care of. */
+    const Vector2 blurTexelSize = 1.0f/Vector2{blurSize};
     GL::Texture2D* input = &rendererGL.compositingTexture();
     for(UnsignedInt i = 0; i != state.backgroundBlurPassCount; ++i) {
         sharedState.backgroundBlurFramebufferVertical.bind();
         sharedState.backgroundBlurShader
-            .setDirection(Vector2::yAxis(1.0f/state.framebufferSize.y()))
+            .setDirection(Vector2::yAxis(blurTexelSize.y()))
             .bindTexture(*input)
             .draw(state.backgroundBlurMesh);
 
         sharedState.backgroundBlurFramebufferHorizontal.bind();
         sharedState.backgroundBlurShader
-            .setDirection(Vector2::xAxis(1.0f/state.framebufferSize.x()))
+            .setDirection(Vector2::xAxis(blurTexelSize.x()))
             .bindTexture(sharedState.backgroundBlurTextureVertical)
             .draw(state.backgroundBlurMesh);
 
@@ -618,11 +962,44 @@ void BaseLayerGL::doDraw(const Containers::StridedArrayView1D<const UnsignedInt>
             {clipRectOffset_.x(), state.framebufferSize.y() - clipRectOffset_.y() - clipRectSize.y()},
             clipRectSize));
 
-        state.mesh
-            .setIndexOffset(clipDataOffset*drawSize)
-            .setCount(clipRectDataCount*drawSize);
-        sharedState.shader
-            .draw(state.mesh);
+        /* Instanced quads are in draw order, so the data offset is directly
+           the instance offset. Without base instance support a mesh with the
+           instance attributes bound at the offset is used instead, set up
+           the first time given offset is drawn from and then reused until
+           the next doUpdate() that changes the offsets. */
+        if(sharedState.flags >= BaseLayerSharedFlag::InstancedQuads) {
+            const UnsignedInt instanceOffset = state.bufferStream.baseVertex + clipDataOffset;
+            if(sharedState.baseInstanceSupported) {
+                state.mesh
+                    .setBaseInstance(instanceOffset)
+                    .setInstanceCount(clipRectDataCount);
+                sharedState.shader
+                    .draw(state.mesh);
+            } else {
+                /* There's usually just a handful of clip rects, so a linear
+                   search is fine */
+                GL::Mesh* mesh = nullptr;
+                for(Containers::Pair<UnsignedInt, GL::Mesh>& j: state.instanceOffsetMeshes) {
+                    if(j.first() == instanceOffset) {
+                        mesh = &j.second();
+                        break;
+                    }
+                }
+                if(!mesh) {
+                    mesh = &arrayAppend(state.instanceOffsetMeshes, InPlaceInit, instanceOffset, GL::Mesh{}).second();
+                    setupMesh(*mesh, state.vertexBuffer, state.indexBuffer, sharedState.flags, instanceOffset);
+                }
+                mesh->setInstanceCount(clipRectDataCount);
+                sharedState.shader
+                    .draw(*mesh);
+            }
+        } else {
+            state.mesh
+                .setIndexOffset(state.bufferStream.indexOffset + clipDataOffset*drawSize)
+                .setCount(clipRectDataCount*drawSize);
+            sharedState.shader
+                .draw(state.mesh);
+        }
 
         clipDataOffset += clipRectDataCount;
     }
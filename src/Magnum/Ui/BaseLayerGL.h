@@ -108,6 +108,31 @@ class MAGNUM_UI_EXPORT BaseLayerGL: public BaseLayer {
          */
         BaseLayerGL& setTexture(GL::Texture2DArray&& texture);
 
+        /**
+         * @brief Whether buffer streaming is enabled
+         *
+         * @see @ref setBufferStreamingEnabled()
+         */
+        bool isBufferStreamingEnabled() const;
+
+        /**
+         * @brief Enable or disable buffer streaming
+         * @return Reference to self (for method chaining)
+         *
+         * Meant for layers whose data change every frame, such as when
+         * animated. If enabled and @gl_extension{ARB,buffer_storage} (or
+         * @gl_extension{EXT,buffer_storage} on OpenGL ES) is supported,
+         * vertex and index data are written to a triple-buffered
+         * persistently mapped ring, with fences making sure a part of it
+         * isn't overwritten while the GPU still draws from it. Otherwise,
+         * which is always the case on OpenGL ES 2.0 and WebGL, the buffers
+         * are orphaned on every upload. If disabled, only the
+         * changed parts of the buffers are uploaded. Changing the value
+         * recreates the GPU buffers and causes
+         * @ref LayerState::NeedsDataUpdate to be set. Disabled by default.
+         */
+        BaseLayerGL& setBufferStreamingEnabled(bool enabled);
+
         /* Overloads to remove a WTF factor from method chaining order */
         #ifndef DOXYGEN_GENERATING_OUTPUT
         BaseLayerGL& setBackgroundBlurPassCount(UnsignedInt count) {
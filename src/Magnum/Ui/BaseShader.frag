@@ -33,6 +33,15 @@ struct StyleEntry {
     mediump vec4 innerOutlineCornerRadius;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 0
@@ -40,6 +49,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessInnerOutlineSmoothnessBackgroundBlurAlphaReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #define commonStyle_smoothness smoothnessInnerOutlineSmoothnessBackgroundBlurAlphaReserved.x
@@ -68,7 +80,14 @@ layout(binding = 1)
 uniform lowp sampler2D backgroundBlurTextureData;
 #endif
 
+#ifndef SHADER_STYLE_ANIMATION
 flat in mediump uint interpolatedStyle;
+#define styleValue(member) styles[interpolatedStyle].member
+#else
+flat in mediump uvec2 interpolatedStyles; /* source, target */
+flat in mediump float interpolatedStyleFactor;
+#define styleValue(member) mix(styles[interpolatedStyles.x].member, styles[interpolatedStyles.y].member, interpolatedStyleFactor)
+#endif
 NOPERSPECTIVE in lowp vec4 interpolatedColor;
 #ifndef SUBDIVIDED_QUADS
 flat in mediump vec2 halfQuadSize;
@@ -102,7 +121,7 @@ void main() {
     {
         #ifndef NO_ROUNDED_CORNERS
         /* Rounded corner centers */
-        mediump vec4 radius = styles[interpolatedStyle].cornerRadius;
+        mediump vec4 radius = styleValue(cornerRadius);
         mediump vec2 c0 = vec2(-halfQuadSize.x + radius[0], -halfQuadSize.y + radius[0]);
         mediump vec2 c1 = vec2(-halfQuadSize.x + radius[1], +halfQuadSize.y - radius[1]);
         mediump vec2 c2 = vec2(+halfQuadSize.x - radius[2], -halfQuadSize.y + radius[2]);
@@ -140,7 +159,7 @@ void main() {
     {
         #ifndef NO_ROUNDED_CORNERS
         /* Outline rounded corner centers */
-        mediump vec4 radius = styles[interpolatedStyle].innerOutlineCornerRadius;
+        mediump vec4 radius = styleValue(innerOutlineCornerRadius);
         mediump vec2 c0 = vec2(outlineQuadSize.x + radius[0], outlineQuadSize.y + radius[0]);
         mediump vec2 c1 = vec2(outlineQuadSize.x + radius[1], outlineQuadSize.w - radius[1]);
         mediump vec2 c2 = vec2(outlineQuadSize.z - radius[2], outlineQuadSize.y + radius[2]);
@@ -204,7 +223,7 @@ void main() {
 
     /* Outline color, optionally with the texture alpha affecting it as well */
     #ifndef NO_OUTLINE
-    lowp vec4 outlineColor = styles[interpolatedStyle].outlineColor;
+    lowp vec4 outlineColor = styleValue(outlineColor);
     #ifdef TEXTURE_MASK
     outlineColor *= textureColor.a;
     #endif
@@ -33,6 +33,15 @@ struct StyleEntry {
     mediump vec4 innerOutlineCornerRadius;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 0
@@ -40,6 +49,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessInnerOutlineSmoothnessBackgroundBlurAlphaReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #define commonStyle_smoothness smoothnessInnerOutlineSmoothnessBackgroundBlurAlphaReserved.x
@@ -53,9 +65,16 @@ layout(location = 0)
 uniform highp vec3 projection; /* xy = UI size to unit square scaling,
                                   z = pixel smoothness to UI size scaling */
 
+#ifndef INSTANCED_QUADS
 layout(location = 0) in highp vec2 position;
+#else
+/* Per-instance quad rectangle, min and max */
+layout(location = 0) in highp vec4 quad;
+#endif
 #ifndef SUBDIVIDED_QUADS
+#ifndef INSTANCED_QUADS
 layout(location = 1) in mediump vec2 centerDistance;
+#endif
 #ifndef NO_OUTLINE
 layout(location = 2) in mediump vec4 outlineWidth;
 #endif
@@ -72,10 +91,24 @@ layout(location = 2) in mediump vec2 outlineWidth;
 layout(location = 3) in lowp vec4 color;
 layout(location = 4) in mediump uint style;
 #ifdef TEXTURED
+#ifndef INSTANCED_QUADS
 layout(location = 5) in mediump vec3 textureCoordinates;
+#else
+/* Texture coordinates corresponding to the min and max quad corner, the
+   layer is taken from the min */
+layout(location = 5) in mediump vec3 textureCoordinatesMin;
+layout(location = 6) in mediump vec2 textureCoordinatesMax;
+#endif
 #endif
 
+#ifndef SHADER_STYLE_ANIMATION
 flat out mediump uint interpolatedStyle;
+#define styleValue(member) styles[style].member
+#else
+flat out mediump uvec2 interpolatedStyles; /* source, target */
+flat out mediump float interpolatedStyleFactor;
+#define styleValue(member) mix(styles[sourceStyle].member, styles[targetStyle].member, styleFactor)
+#endif
 NOPERSPECTIVE out lowp vec4 interpolatedColor;
 #ifdef TEXTURED
 NOPERSPECTIVE out mediump vec3 interpolatedTextureCoordinates;
@@ -95,7 +128,37 @@ NOPERSPECTIVE out mediump float innerOutlineCornerRadius;
 #endif
 
 void main() {
+    #ifndef SHADER_STYLE_ANIMATION
     interpolatedStyle = style;
+    #else
+    /* Dynamic styles reference a source and target style to interpolate
+       between, which is the dynamic style itself if it's not animated. Other
+       styles are used as-is. */
+    mediump uint sourceStyle = style;
+    mediump uint targetStyle = style;
+    mediump float styleFactor = 0.0;
+    if(style >= uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT)) {
+        mediump uint dynamicStyle = style - uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT);
+        sourceStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.x;
+        targetStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.y;
+        styleFactor = styleInterpolations[dynamicStyle].factor;
+    }
+    interpolatedStyles = uvec2(sourceStyle, targetStyle);
+    interpolatedStyleFactor = styleFactor;
+    #endif
+
+    /* Instanced quads are drawn as a four-vertex triangle strip, going through
+       the corners in order top left, bottom left, top right, bottom right.
+       Calculate the per-vertex inputs from the per-instance rectangle, the
+       rest is then the same as with the non-instanced single quad. */
+    #ifdef INSTANCED_QUADS
+    mediump vec2 corner = vec2(float(gl_VertexID >> 1), float(gl_VertexID & 1));
+    highp vec2 position = mix(quad.xy, quad.zw, corner);
+    mediump vec2 centerDistance = (corner - vec2(0.5))*(quad.zw - quad.xy);
+    #ifdef TEXTURED
+    mediump vec3 textureCoordinates = vec3(mix(textureCoordinatesMin.xy, textureCoordinatesMax, corner), textureCoordinatesMin.z);
+    #endif
+    #endif
 
     /* Case with just a single quad -- the position, center distance and
        texture coordinates all already contain the smoothness expansion */
@@ -106,7 +169,7 @@ void main() {
     #ifndef NO_OUTLINE
     /* Calculate the outline quad size here already to save a vec4 load in each
        fragment shader invocation */
-    mediump vec4 combinedOutlineWidth = styles[style].outlineWidth + outlineWidth;
+    mediump vec4 combinedOutlineWidth = styleValue(outlineWidth) + outlineWidth;
     outlineQuadSize = vec4(-halfQuadSize + combinedOutlineWidth.xy,
                            +halfQuadSize - combinedOutlineWidth.zw);
     #endif
@@ -114,7 +177,7 @@ void main() {
        fragment shader invocation. Have to extrapolate to again undo the quad
        expansion, i.e. at a top/bottom edge it should still be exactly the
        (alpha-faded) top/bottom color no matter what the smoothness is. */
-    interpolatedColor = mix(styles[style].topColor, styles[style].bottomColor, 0.5*centerDistance.y/halfQuadSize.y + 0.5)*color;
+    interpolatedColor = mix(styleValue(topColor), styleValue(bottomColor), 0.5*centerDistance.y/halfQuadSize.y + 0.5)*color;
     interpolatedCenterDistance = centerDistance;
     #ifdef TEXTURED
     /* Texture coordinates are already containing the smoothness expansion,
@@ -154,25 +217,25 @@ void main() {
        drivers don't allow access with a dynamic index, so this works
        everywhere. */
     if(cornerId == 0) {         /* Top left */
-        cornerRadius = styles[style].cornerRadius.x;
-        innerOutlineCornerRadius = styles[style].innerOutlineCornerRadius.x;
-        totalOutlineWidth += vec2(styles[style].outlineWidth.x,
-                                  styles[style].outlineWidth.y);
+        cornerRadius = styleValue(cornerRadius).x;
+        innerOutlineCornerRadius = styleValue(innerOutlineCornerRadius).x;
+        totalOutlineWidth += vec2(styleValue(outlineWidth).x,
+                                  styleValue(outlineWidth).y);
     } else if(cornerId == 1) {  /* Top right */
-        cornerRadius = styles[style].cornerRadius.z;
-        innerOutlineCornerRadius = styles[style].innerOutlineCornerRadius.z;
-        totalOutlineWidth += vec2(styles[style].outlineWidth.z,
-                                  styles[style].outlineWidth.y);
+        cornerRadius = styleValue(cornerRadius).z;
+        innerOutlineCornerRadius = styleValue(innerOutlineCornerRadius).z;
+        totalOutlineWidth += vec2(styleValue(outlineWidth).z,
+                                  styleValue(outlineWidth).y);
     } else if(cornerId == 2) {  /* Bottom left */
-        cornerRadius = styles[style].cornerRadius.y;
-        innerOutlineCornerRadius = styles[style].innerOutlineCornerRadius.y;
-        totalOutlineWidth += vec2(styles[style].outlineWidth.x,
-                                  styles[style].outlineWidth.w);
+        cornerRadius = styleValue(cornerRadius).y;
+        innerOutlineCornerRadius = styleValue(innerOutlineCornerRadius).y;
+        totalOutlineWidth += vec2(styleValue(outlineWidth).x,
+                                  styleValue(outlineWidth).w);
     } else if(cornerId == 3) {  /* Bottom right */
-        cornerRadius = styles[style].cornerRadius.w;
-        innerOutlineCornerRadius = styles[style].innerOutlineCornerRadius.w;
-        totalOutlineWidth += vec2(styles[style].outlineWidth.z,
-                                  styles[style].outlineWidth.w);
+        cornerRadius = styleValue(cornerRadius).w;
+        innerOutlineCornerRadius = styleValue(innerOutlineCornerRadius).w;
+        totalOutlineWidth += vec2(styleValue(outlineWidth).z,
+                                  styleValue(outlineWidth).w);
     } else {
         /* Without this, NV says "warning C7050: "<ver>" might be used before
            being initialized". It isn't, as cornerId is only ever those four
@@ -222,7 +285,7 @@ void main() {
 
     /* Compared to the non-SUBDIVIDED_QUADS case above, here it's both
        interpolated and extrapolated */
-    interpolatedColor = mix(styles[style].topColor, styles[style].bottomColor, 0.5*(centerDistanceY + shift.y)/abs(centerDistanceY) + 0.5)*color;
+    interpolatedColor = mix(styleValue(topColor), styleValue(bottomColor), 0.5*(centerDistanceY + shift.y)/abs(centerDistanceY) + 0.5)*color;
 
     #ifdef TEXTURED
     interpolatedTextureCoordinates = textureCoordinates + vec3(shift*textureScale, 0.0);
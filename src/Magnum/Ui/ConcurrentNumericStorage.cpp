@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConcurrentNumericStorage.h"
+
+#include <atomic>
+#include <new>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Half.h>
+#include <Magnum/Math/Time.h>
+
+namespace Magnum { namespace Ui {
+
+namespace {
+
+/* The values are stored as a tightly packed array of atomics in memory
+   allocated by AbstractStorage::createConcurrent(). With all supported types
+   being at most 64-bit, each is a single lock-free atomic, so there's no need
+   for a seqlock or double buffering for readers to never see a torn value.
+   That's however only if the platform has lock-free atomics of given size,
+   otherwise the std::atomic would silently fall back to a lock, making the
+   publisher no longer wait-free. The std::atomic<T>::is_always_lock_free
+   constant is C++17, so the check is done with the C++11 ATOMIC_*_LOCK_FREE
+   macros for a builtin type of the same size instead, and the 64-bit types
+   are not instantiated at all if the platform doesn't guarantee them to be
+   lock-free. */
+template<std::size_t> struct AtomicLockFree;
+template<> struct AtomicLockFree<1> { enum: int { Value = ATOMIC_CHAR_LOCK_FREE }; };
+template<> struct AtomicLockFree<2> { enum: int { Value = ATOMIC_SHORT_LOCK_FREE }; };
+template<> struct AtomicLockFree<4> { enum: int { Value = ATOMIC_INT_LOCK_FREE }; };
+template<> struct AtomicLockFree<8> { enum: int { Value = ATOMIC_LLONG_LOCK_FREE }; };
+
+inline std::size_t linearizeIndex(const Containers::Size3D& size, const Containers::Size3D& index) {
+    return (index[0]*size[1] + index[1])*size[2] + index[2];
+}
+
+}
+
+template<class T> void ConcurrentNumericStorage<T>::create(const T& value) {
+    static_assert(AtomicLockFree<sizeof(T)>::Value == 2,
+        "atomics of this size aren't always lock-free on this platform");
+    const Containers::Size3D size = this->size();
+    const std::size_t count = size[0]*size[1]*size[2];
+    std::atomic<T>* const values = static_cast<std::atomic<T>*>(createConcurrent(count*sizeof(std::atomic<T>)));
+    for(std::size_t i = 0; i != count; ++i)
+        new(values + i) std::atomic<T>{value};
+}
+
+template<class T> typename ConcurrentNumericStorage<T>::Type ConcurrentNumericStorage<T>::query(const ConcurrentNumericStorage<T>& storage, const Containers::Size3D& index) {
+    /* Index validity is checked by the StorageQuery constructor already. The
+       value itself is atomic, and everything published before the storage was
+       marked as dirty is made visible by DataLayer::doPreUpdate() already, so
+       a relaxed load is enough. Explicit casting because Half isn't
+       implicitly convertible to Float. */
+    const std::atomic<T>* const values = storage.AbstractStorage::data<const std::atomic<T>>();
+    return static_cast<typename ConcurrentNumericStorage<T>::Type>(values[linearizeIndex(storage.size(), index)].load(std::memory_order_relaxed));
+}
+
+template<class T> void ConcurrentNumericStorage<T>::Publisher::publish(const Containers::Size3D& index, const T& value) const {
+    /* Called from arbitrary threads, so the assertion is debug-only and
+       doesn't stream the index and size into the message to not format any
+       output here */
+    CORRADE_DEBUG_ASSERT(index[0] < _size[0] && index[1] < _size[1] && index[2] < _size[2],
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): index out of range", );
+    /* The release in setDirtyConcurrent() makes this store visible to the
+       layer once it picks up the dirty flag, so it can be relaxed */
+    static_cast<std::atomic<T>*>(_data)[linearizeIndex(_size, index)].store(value, std::memory_order_relaxed);
+    AbstractStorage::setDirtyConcurrent(_data);
+}
+
+#define _c(type)                                                            \
+template MAGNUM_UI_EXPORT void ConcurrentNumericStorage<type>::create(const type&); \
+template MAGNUM_UI_EXPORT typename ConcurrentNumericStorage<type>::Type ConcurrentNumericStorage<type>::query(const ConcurrentNumericStorage<type>&, const Containers::Size3D&); \
+template MAGNUM_UI_EXPORT void ConcurrentNumericStorage<type>::Publisher::publish(const Containers::Size3D&, const type&) const;
+_c(UnsignedByte)
+_c(Byte)
+_c(UnsignedShort)
+_c(Short)
+_c(UnsignedInt)
+_c(Int)
+#if ATOMIC_LLONG_LOCK_FREE == 2
+_c(UnsignedLong)
+_c(Long)
+#endif
+_c(Float)
+#if ATOMIC_LLONG_LOCK_FREE == 2
+_c(Double)
+#endif
+/* Same Clang-on-Unix shared library issue as described in NumericStorage.cpp,
+   export the whole classes for the non-builtin types there */
+#if defined(CORRADE_TARGET_CLANG) && !defined(CORRADE_TARGET_WINDOWS) && !defined(MAGNUM_UI_BUILD_STATIC)
+#undef _c
+#define _c(type)                                                            \
+template class MAGNUM_UI_EXPORT ConcurrentNumericStorage<type>;             \
+template class MAGNUM_UI_EXPORT ConcurrentNumericStorage<type>::Publisher;
+#endif
+_c(Half)
+_c(Deg)
+_c(Rad)
+_c(Seconds)
+#if ATOMIC_LLONG_LOCK_FREE == 2
+_c(Nanoseconds)
+#endif
+#undef _c
+
+}}
@@ -0,0 +1,439 @@
+#ifndef Magnum_Ui_ConcurrentNumericStorage_h
+#define Magnum_Ui_ConcurrentNumericStorage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Ui::ConcurrentNumericStorage
+ * @m_since_latest_{extras}
+ */
+
+#include <Corrade/Utility/DebugAssert.h>
+
+#include "Magnum/Ui/NumericStorage.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Multi-dimensional storage for numeric types updated from other threads
+@m_since_latest_{extras}
+
+Owns typed numeric data for use with @ref DataLayer, which, unlike
+@ref NumericStorage, can be written to from arbitrary threads without any
+locking and without having to marshal the updates to the thread the user
+interface lives in. Meant for values produced at high rates elsewhere, such as
+telemetry or progress of background jobs, where the user interface is only
+interested in the freshest value at the time it gets updated.
+
+The values are written through a @ref Publisher instance retrieved using
+@ref publisher(), which can be freely copied to and used from other threads.
+Each published value gets stored atomically and the storage marked as dirty
+via @ref AbstractStorage::setDirtyConcurrent(). The @ref DataLayer then
+returns @ref LayerState::NeedsCommonDataUpdate from @ref DataLayer::state() and
+the next @ref AbstractUserInterface::update() calls all data bound to the
+storage with the latest published values, no matter how many times they were
+published in between.
+
+Each storage item is updated independently, there's no guarantee that values
+published to different items at the same time from a producer are all picked
+up in the same update. Publishing to the same item from multiple threads is
+allowed, but it's unspecified which of the values ends up being shown. The
+@ref publisher() instances are not allowed to be used anymore once the storage
+is removed, for that reason it's not recommended to combine this class with
+@ref StorageFlag::ReferenceCounted.
+
+The queries returned from @ref value() and @ref operator[]() are immutable, as
+the values are meant to be controlled solely by the producers. The template is
+explicitly instantiated for the same types as @ref NumericStorage, including
+the expansion of types smaller than 32 bits to @ref Type. The values are
+stored as @ref std::atomic and the class is only instantiated for types for
+which the atomics are guaranteed to be lock-free. On platforms where 64-bit
+atomics aren't, such as some 32-bit targets, which is signalled by
+@cpp ATOMIC_LLONG_LOCK_FREE @ce not being @cpp 2 @ce, the
+@relativeref{Magnum,UnsignedLong}, @relativeref{Magnum,Long},
+@relativeref{Magnum,Double} and @relativeref{Magnum,Nanoseconds}
+instantiations aren't available.
+*/
+template<class T> class ConcurrentNumericStorage: public AbstractStorage {
+    public:
+        /**
+         * @brief Storage type
+         *
+         * Note that to reduce combinatorial explosion, the types retured by
+         * queries don't always match the actual storage type. See @ref Type
+         * for details.
+         */
+        typedef T StorageType;
+
+        /**
+         * @brief Query type
+         *
+         * Same as @ref NumericStorage::Type, see its documentation for more
+         * information.
+         */
+        typedef typename Implementation::NumericStorageQueryTraits<T>::Type Type;
+
+        class Publisher;
+
+        /**
+         * @brief Construct a value-initialized single-item storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, 1} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, ValueInitT, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, 1, 1}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 1D storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, size} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, ValueInitT, std::size_t size, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, 1, size}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 2D storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, size[0], size[1]} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, ValueInitT, const Containers::Size2D& size, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, size[0], size[1]}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 3D storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p value being @cpp T{} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, ValueInitT, const Containers::Size3D& size, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, size, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized single-item storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, 1} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, ValueInitT, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, 1, 1}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 1D storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, size} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, ValueInitT, std::size_t size, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, 1, size}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 2D storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, size[0], size[1]} @ce and @p value being
+         * @cpp T{} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, ValueInitT, const Containers::Size2D& size, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, size[0], size[1]}, T{}, flags} {}
+
+        /**
+         * @brief Construct a value-initialized 3D storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p value being @cpp T{} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, ValueInitT, const Containers::Size3D& size, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, size, T{}, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized single-item storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, 1} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, DirectInitT, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, 1, 1}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 1D storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, size} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, DirectInitT, std::size_t size, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, 1, size}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 2D storage
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, size[0], size[1]} @ce.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, DirectInitT, const Containers::Size2D& size, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{layer, DirectInit, {1, size[0], size[1]}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 3D storage
+         * @param layer     Data layer to create the storage in
+         * @param size      Storage size
+         * @param value     Value to initialize the storage with
+         * @param flags     Storage flags
+         *
+         * Expects that the @p size is non-empty. The storage memory is
+         * allocated using @ref AbstractStorage::createConcurrent(), meaning
+         * it's never stored in-place and @ref isAllocated() is always
+         * @cpp true @ce.
+         *
+         * Delegates to @ref AbstractStorage::AbstractStorage(DataLayer&, const Containers::Size3D&, StorageFlags),
+         * see its documentation for detailed description of all constraints.
+         */
+        explicit ConcurrentNumericStorage(DataLayer& layer, DirectInitT, const Containers::Size3D& size, const T& value, StorageFlags flags = {}): AbstractStorage{layer, size, flags} {
+            create(value);
+        }
+
+        /**
+         * @brief Construct a direct-initialized single-item storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, 1} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, DirectInitT, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, 1, 1}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 1D storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, 1, size} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, DirectInitT, std::size_t size, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, 1, size}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 2D storage using the default @ref DataLayer in given user interface
+         *
+         * Equivalent to calling @ref ConcurrentNumericStorage(UserInterface&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * with @p size being @cpp {1, size[0], size[1]} @ce.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, DirectInitT, const Containers::Size2D& size, const T& value, StorageFlags flags = {}): ConcurrentNumericStorage{ui, DirectInit, {1, size[0], size[1]}, value, flags} {}
+
+        /**
+         * @brief Construct a direct-initialized 3D storage using the default @ref DataLayer in given user interface
+         *
+         * Like @ref ConcurrentNumericStorage(DataLayer&, DirectInitT, const Containers::Size3D&, const T&, StorageFlags)
+         * but using the default @ref DataLayer available through
+         * @ref UserInterface::dataLayer(). Expects that the @p ui contains a
+         * @ref DataLayer instance.
+         */
+        template<class UserInterface> explicit ConcurrentNumericStorage(UserInterface& ui, DirectInitT, const Containers::Size3D& size, const T& value, StorageFlags flags = {}): AbstractStorage{ui, size, flags} {
+            create(value);
+        }
+
+        /**
+         * @brief Publisher for writing values from arbitrary threads
+         *
+         * The returned instance references the storage memory directly and
+         * not the @ref DataLayer, so it can be copied to and used from other
+         * threads. It's valid until the storage is removed.
+         */
+        Publisher publisher() const;
+
+        /**
+         * @brief Single-item storage value
+         *
+         * Expects that @ref size() is @cpp {1, 1, 1} @ce. If it's not, use one
+         * of the @ref operator[]() overloads.
+         *
+         * See documentation of @ref operator[](const Containers::Size3D&) const
+         * for details about what is all supported by the returned query.
+         */
+        StorageQuery<Type> value() const;
+
+        /**
+         * @brief Single-item storage value
+         *
+         * Equivalent to @ref value(), see its documentation for more
+         * information.
+         */
+        operator StorageQuery<Type>() const { return value(); }
+
+        /**
+         * @brief Single-item storage value
+         *
+         * Equivalent to @ref value(), see its documentation for more
+         * information.
+         */
+        StorageQuery<Type> operator->() const { return value(); }
+
+        /**
+         * @brief 1D storage value at given index
+         *
+         * Expects that @ref size() is @cpp {1, 1, size} @ce and @p index is
+         * less than `size`. Use @ref operator[](const Containers::Size2D&) const
+         * for indexing a 2D storage and @ref operator[](const Containers::Size3D&) const
+         * for indexing a 3D storage.
+         *
+         * See documentation of @ref operator[](const Containers::Size3D&) const
+         * for details about what is all supported by the returned query.
+         */
+        StorageQuery<Type> operator[](std::size_t index) const;
+
+        /**
+         * @brief 2D storage value at given index
+         *
+         * Expects that @ref size() is @cpp {1, size[0], size[1]} @ce and
+         * @p index is less than `size`. Use
+         * @ref operator[](const Containers::Size3D&) const for indexing a 3D
+         * storage.
+         *
+         * See documentation of @ref operator[](const Containers::Size3D&) const
+         * for details about what is all supported by the returned query.
+         */
+        StorageQuery<Type> operator[](const Containers::Size2D& index) const;
+
+        /**
+         * @brief 3D storage value at given index
+         *
+         * Expects that @p index is less than @ref size().
+         *
+         * The returned query is immutable and returns the value most recently
+         * published through @ref publisher(). It doesn't support any
+         * @ref StorageOperation.
+         */
+        StorageQuery<Type> operator[](const Containers::Size3D& index) const;
+
+    private:
+        /* Common internals used by operator[]() */
+        static Type query(const ConcurrentNumericStorage<T>& storage, const Containers::Size3D& index);
+
+        /* Called from the DataLayer& or the UserInterface& constructors. Same
+           as with NumericStorage the UserInterface& constructors delegate to
+           the AbstractStorage UserInterface& constructor which performs
+           various assertions, so this has to be a member function and not a
+           constructor. */
+        void create(const T& value);
+};
+
+/**
+@brief Publisher for @ref ConcurrentNumericStorage values
+@m_since_latest_{extras}
+
+Retrieved from @ref ConcurrentNumericStorage::publisher(). All functions are
+lock-free and safe to be called from any thread, as they don't access the
+@ref DataLayer the storage belongs to. The index and dimension count checks
+are debug-only assertions that print just a fixed message, without the
+offending index, to not format any output on the publishing thread.
+*/
+template<class T> class ConcurrentNumericStorage<T>::Publisher {
+    public:
+        /** @brief Storage size */
+        Containers::Size3D size() const { return _size; }
+
+        /**
+         * @brief Publish a single-item storage value
+         *
+         * Expects that @ref size() is @cpp {1, 1, 1} @ce. If it's not, use one
+         * of the @ref publish(std::size_t, const T&) const overloads.
+         */
+        void publish(const T& value) const {
+            CORRADE_DEBUG_ASSERT(_size[0] == 1 && _size[1] == 1 && _size[2] == 1,
+                "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a single-item storage", );
+            publish(Containers::Size3D{}, value);
+        }
+
+        /**
+         * @brief Publish a 1D storage value at given index
+         *
+         * Expects that @ref size() is @cpp {1, 1, size} @ce and @p index is
+         * less than `size`.
+         */
+        void publish(std::size_t index, const T& value) const {
+            CORRADE_DEBUG_ASSERT(_size[0] == 1 && _size[1] == 1,
+                "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a 1D storage", );
+            publish(Containers::Size3D{0, 0, index}, value);
+        }
+
+        /**
+         * @brief Publish a 2D storage value at given index
+         *
+         * Expects that @ref size() is @cpp {1, size[0], size[1]} @ce and
+         * @p index is less than `size`.
+         */
+        void publish(const Containers::Size2D& index, const T& value) const {
+            CORRADE_DEBUG_ASSERT(_size[0] == 1,
+                "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a 2D storage", );
+            publish(Containers::Size3D{0, index[0], index[1]}, value);
+        }
+
+        /**
+         * @brief Publish a 3D storage value at given index
+         *
+         * Expects that @p index is less than @ref size(). Atomically stores
+         * @p value and marks the storage as dirty, causing all data bound to
+         * it to be updated with the latest value in the next
+         * @ref AbstractUserInterface::update().
+         */
+        void publish(const Containers::Size3D& index, const T& value) const;
+
+    private:
+        friend ConcurrentNumericStorage<T>;
+
+        explicit Publisher(void* data, const Containers::Size3D& size): _data{data}, _size{size} {}
+
+        void* _data;
+        Containers::Size3D _size;
+};
+
+template<class T> typename ConcurrentNumericStorage<T>::Publisher ConcurrentNumericStorage<T>::publisher() const {
+    return Publisher{AbstractStorage::data<void>(), size()};
+}
+
+template<class T> StorageQuery<typename ConcurrentNumericStorage<T>::Type> ConcurrentNumericStorage<T>::value() const {
+    /* The StorageQuery requires lambdas so can't just pass the query() static
+       function by pointer. There are no operations supported, so the
+       operation argument is unused. */
+    return {*this, StorageOperations{}, [](const ConcurrentNumericStorage<T>& storage, StorageOperation) {
+        return ConcurrentNumericStorage<T>::query(storage, {});
+    }};
+}
+
+template<class T> StorageQuery<typename ConcurrentNumericStorage<T>::Type> ConcurrentNumericStorage<T>::operator[](const std::size_t index) const {
+    return {*this, index, StorageOperations{}, [](const ConcurrentNumericStorage<T>& storage, const std::size_t index, StorageOperation) {
+        return ConcurrentNumericStorage<T>::query(storage, {0, 0, index});
+    }};
+}
+
+template<class T> StorageQuery<typename ConcurrentNumericStorage<T>::Type> ConcurrentNumericStorage<T>::operator[](const Containers::Size2D& index) const {
+    return {*this, index, StorageOperations{}, [](const ConcurrentNumericStorage<T>& storage, const Containers::Size2D& index, StorageOperation) {
+        return ConcurrentNumericStorage<T>::query(storage, {0, index[0], index[1]});
+    }};
+}
+
+template<class T> StorageQuery<typename ConcurrentNumericStorage<T>::Type> ConcurrentNumericStorage<T>::operator[](const Containers::Size3D& index) const {
+    return {*this, index, StorageOperations{}, [](const ConcurrentNumericStorage<T>& storage, const Containers::Size3D& index, StorageOperation) {
+        return ConcurrentNumericStorage<T>::query(storage, index);
+    }};
+}
+
+}}
+
+#endif
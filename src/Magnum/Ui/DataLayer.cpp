@@ -26,14 +26,21 @@
 
 #include "DataLayer.h"
 
+#include <atomic>
+#include <new>
 #include <Corrade/Containers/BitArrayView.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Time.h>
 #include <Magnum/Math/Vector3.h>
 
 #include "Magnum/Ui/Handle.h"
 
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h> /* _BitScanForward() */
+#endif
+
 namespace Magnum { namespace Ui {
 
 Debug& operator<<(Debug& debug, const DataLayerStorageHandle value) {
@@ -148,11 +155,68 @@ Debug& operator<<(Debug& debug, const StorageUpdateState value) {
 
 namespace {
 
-/* Abusing last two bits of the StorageFlag enum to prevent clashing with newly
-   added flags */
+/* Abusing the last two bits of the StorageFlag enum to prevent clashing with
+   newly added flags. Concurrent storages are always allocated as well. */
 constexpr StorageFlag StorageFlagAllocated = StorageFlag(1 << (sizeof(StorageFlag)*8 - 1));
-constexpr StorageFlag StorageFlagDirty = StorageFlag(1 << (sizeof(StorageFlag)*8 - 2));
-constexpr StorageFlags StorageFlagMask = ~(StorageFlagAllocated|StorageFlagDirty);
+constexpr StorageFlag StorageFlagConcurrent = StorageFlag(1 << (sizeof(StorageFlag)*8 - 2));
+constexpr StorageFlags StorageFlagMask = ~(StorageFlagAllocated|StorageFlagConcurrent);
+
+/* Placed in front of memory returned from AbstractStorage::createConcurrent(),
+   padded to keep the data after it 16-byte aligned. The dirty flag is set from
+   AbstractStorage::setDirtyConcurrent() from arbitrary threads, polled by
+   DataLayer::doState() and consumed in DataLayer::doPreUpdate(). */
+struct ConcurrentStorageHeader {
+    std::atomic<bool> dirty{false};
+};
+
+enum: std::size_t { ConcurrentStorageHeaderSize = 16 };
+
+static_assert(sizeof(ConcurrentStorageHeader) <= ConcurrentStorageHeaderSize,
+    "ConcurrentStorageHeader doesn't fit into the padding");
+
+inline ConcurrentStorageHeader& concurrentStorageHeader(void* const data) {
+    return *reinterpret_cast<ConcurrentStorageHeader*>(static_cast<char*>(data) - ConcurrentStorageHeaderSize);
+}
+
+void deleteConcurrentStorage(void* const data, std::size_t) {
+    /* The header is trivially destructible, so no need to call its
+       destructor */
+    delete[] (static_cast<char*>(data) - ConcurrentStorageHeaderSize);
+}
+
+/* Helpers for bit arrays stored as whole words, see DataLayer::State for
+   why they're not Containers::BitArray */
+inline bool isBitSet(const Containers::ArrayView<const UnsignedLong> words, const UnsignedInt id) {
+    return words[id >> 6] & (1ull << (id & 63));
+}
+
+inline void setBit(const Containers::ArrayView<UnsignedLong> words, const UnsignedInt id) {
+    words[id >> 6] |= 1ull << (id & 63);
+}
+
+inline void resetBit(const Containers::ArrayView<UnsignedLong> words, const UnsignedInt id) {
+    words[id >> 6] &= ~(1ull << (id & 63));
+}
+
+/* Expects that the word is non-zero */
+UnsignedInt findFirstSet(const UnsignedLong word) {
+    CORRADE_INTERNAL_DEBUG_ASSERT(word);
+    /* Clang also defines CORRADE_TARGET_GCC, and so does clang-cl */
+    #ifdef CORRADE_TARGET_GCC
+    return __builtin_ctzll(word);
+    #elif defined(CORRADE_TARGET_MSVC)
+    /* Using the 32-bit variant to work on 32-bit targets as well */
+    unsigned long index;
+    if(_BitScanForward(&index, UnsignedInt(word)))
+        return index;
+    _BitScanForward(&index, UnsignedInt(word >> 32));
+    return 32 + index;
+    #else
+    UnsignedInt index = 0;
+    while(!(word & (1ull << index))) ++index;
+    return index;
+    #endif
+}
 
 union StorageData {
     explicit StorageData() noexcept: used{} {}
@@ -191,9 +255,8 @@ union StorageData {
 
         /* If contains StorageFlagAllocated, the data.allocated references an
            external allocation, otherwise everything is stored inside
-           data.inPlace. If contains StorageFlagDirty, the data got updated
-           since last doUpdate() call. StorageFlagDirty gets cleared after
-           doUpdate() is called. */
+           data.inPlace. Whether the storage is dirty is tracked in
+           DataLayer::State::dirtyStorages instead. */
         StorageFlags flags{NoInit};
 
         /* 1 byte free */
@@ -271,34 +334,35 @@ static_assert(
     offsetof(StorageData::Used, size) == offsetof(StorageData::Free, size),
     "StorageData::Used and Free layout not compatible");
 
-enum: UnsignedInt {
-    /* For Data::storageIdDirty */
-    DataIsDirty = 1 << Implementation::DataLayerStorageHandleIdBits,
-};
-
 struct Data {
-    /* First Implementation::DataLayerStorageHandleIdBits (20 bits) is storage
-       index. Since the storage is reference-counted and thus not allowed to be
-       removed while data reference it, we don't need to store the
-       DataLayerStorageHandle generation.
-
-       The following bit denotes whether the data is dirty, to force an update
-       even if the storage itself isn't. Is set upon data creation and after
-       changing data properties, such as by DataLayer::setIndex(), and
-       explicitly with DataLayer::setDirty(). */
-    UnsignedInt storageIdDirty;
+    /* Storage index. Since the storage is reference-counted and thus not
+       allowed to be removed while data reference it, we don't need to store
+       the DataLayerStorageHandle generation. Whether the data is dirty is
+       tracked in DataLayer::State::dirtyData. */
+    UnsignedInt storageId;
     /* Operations supported by the updater function */
     StorageOperations operations;
     /* 2 bytes free */
+    /* Previous and next data referencing the same storage, or ~UnsignedInt{}
+       if this is the first / last one. The list head is in
+       DataLayer::State::storageFirstData. Used to propagate dirty storage
+       state only to data bound to it. */
+    UnsignedInt previousData, nextData;
     /* Linearized storage index (basically a linear data position as if the 3D
        storage would be contiguous). The logic is that with a byte-sized
        storage, we wouldn't be able to address more than 32/64 bits anyway, so
        there's no point in storing 3*4/8 bytes. The value is accessed through
        linearizeIndex() and delinearizeIndex(). */
     std::size_t linearizedIndex;
+    /* Minimal interval between consecutive calls, set with
+       DataLayer::setUpdateInterval(), and animation time of the last call.
+       The last call time is Nanoseconds::min() initially so the first call
+       isn't delayed. */
+    Nanoseconds updateInterval;
+    Nanoseconds lastUpdate;
 
     Containers::FunctionData function;
-    void(*call)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, DataHandle, Containers::FunctionData&);
+    void(*call)(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, DataHandle, Containers::FunctionData&);
     /* Nullptr if the data binding is immutable */
     /** @todo to save space the layer could maintain a separate array
         containing just the updater pointers and have them referenced from here
@@ -321,8 +385,40 @@ struct DataLayer::State {
        there's no (first/next/last) free storage. */
     UnsignedInt firstFreeStorage = ~UnsignedInt{};
     UnsignedInt lastFreeStorage = ~UnsignedInt{};
+    /* Indexed by storage ID, first data referencing given storage or
+       ~UnsignedInt{} if there's none. See Data::previousData and nextData. */
+    Containers::Array<UnsignedInt> storageFirstData;
 
     Containers::Array<Data> data;
+
+    /* Bits for storages that got marked as dirty since the last doPreUpdate(),
+       bits for data that are dirty, either because they were just created,
+       their properties changed or they were explicitly marked with
+       DataLayer::setDirty(), and bits for StorageFlag::ReferenceCounted
+       storages that have no references and are thus meant to be removed in
+       the next doPreUpdate(). 64 items per word, the first two have the
+       size matching storage capacity, the last matches data capacity.
+       Additionally there are bits for storages created with
+       AbstractStorage::createConcurrent(), which have their dirty state
+       tracked in an atomic ConcurrentStorageHeader::dirty flag and which
+       doState() and doPreUpdate() go through to pick it up, again sized to
+       storage capacity.
+
+       Stored as whole words instead of a Containers::BitArray in order to be
+       able to grow them together with the storage and data arrays and to
+       skip 64 clean items at a time in doPreUpdate(), which then does work
+       mostly proportional to the amount of dirty items and not the total
+       data count. */
+    Containers::Array<UnsignedLong> dirtyStorages;
+    Containers::Array<UnsignedLong> unreferencedStorages;
+    Containers::Array<UnsignedLong> concurrentStorages;
+    Containers::Array<UnsignedLong> dirtyData;
+
+    /* Earliest time at which a dirty data with a non-zero update interval,
+       whose call was postponed in doPreUpdate(), can be called, or
+       Nanoseconds::max() if there's no such data. Compared against
+       AbstractUserInterface::animationTime() in doState(). */
+    Nanoseconds nextDeferredUpdate = Nanoseconds::max();
 };
 
 DataLayer::State::~State() {
@@ -429,19 +525,30 @@ DataLayerStorageHandle DataLayer::createStorage(const Containers::Size3D& size,
         CORRADE_ASSERT(state.storages.size() < 1 << Implementation::DataLayerStorageHandleIdBits,
             "Ui::AbstractStorage: can only have at most" << (1 << Implementation::DataLayerStorageHandleIdBits) << "storages", {});
         storage = &arrayAppend(state.storages, InPlaceInit);
+        arrayAppend(state.storageFirstData, ~UnsignedInt{});
+        if(state.storages.size() > state.dirtyStorages.size()*64) {
+            arrayAppend(state.dirtyStorages, ValueInit, 1);
+            arrayAppend(state.unreferencedStorages, ValueInit, 1);
+            arrayAppend(state.concurrentStorages, ValueInit, 1);
+        }
     }
 
+    /* The storage isn't dirty upon creation. Its dirty bit and the first data
+       index were either zero-initialized above or reset in
+       removeStorageInternal(). */
     storage->used.size = size;
-    /* StorageFlagDirty isn't set upon creation */
     storage->used.flags = flags;
     storage->used.referenceCount = 0;
 
     /* Set NeedsCommonDataUpdate if the storage is reference-counted, to remove
        it immediately at the next update if it stays unused */
-    if(flags >= StorageFlag::ReferenceCounted)
+    const UnsignedInt id = storage - state.storages;
+    if(flags >= StorageFlag::ReferenceCounted) {
+        setBit(state.unreferencedStorages, id);
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+    }
 
-    return dataLayerStorageHandle(storage - state.storages, storage->used.generation);
+    return dataLayerStorageHandle(id, storage->used.generation);
 }
 
 void* DataLayer::createStorageAllocated(const DataLayerStorageHandle handle, void* const data, const std::size_t dataSize, void(*const deleter)(void*, std::size_t)) {
@@ -464,6 +571,31 @@ void* DataLayer::createStorageAllocated(const DataLayerStorageHandle handle, voi
     return data;
 }
 
+void* DataLayer::createStorageConcurrent(const DataLayerStorageHandle handle, const std::size_t dataSize) {
+    /* The handle should be valid because this should only be called from
+       AbstractStorage subclass constructors where the handle is created right
+       before, but just to be sure */
+    CORRADE_INTERNAL_DEBUG_ASSERT(isHandleValid(handle));
+
+    /* The memory is allocated together with the header containing the dirty
+       flag, which makes it possible for setDirtyConcurrent() to not need to
+       access the layer at all. The storage data pointer points past the
+       header, so storageData() and doPreUpdate() don't need to special-case
+       it in any way. */
+    char* const allocation = new char[ConcurrentStorageHeaderSize + dataSize];
+    new(allocation) ConcurrentStorageHeader{};
+    void* const data = allocation + ConcurrentStorageHeaderSize;
+
+    const UnsignedInt id = dataLayerStorageHandleId(handle);
+    StorageData* const storage = &_state->storages[id];
+    storage->used.flags |= StorageFlagAllocated|StorageFlagConcurrent;
+    storage->used.data.allocated.data = data;
+    storage->used.data.allocated.dataSize = dataSize;
+    storage->used.data.allocated.deleter = deleteConcurrentStorage;
+    setBit(_state->concurrentStorages, id);
+    return data;
+}
+
 auto DataLayer::createStorageInPlace(const DataLayerStorageHandle handle) -> char(&)[Implementation::DataLayerStorageMaxInPlaceSize] {
     /* The handle should be valid because this should only be called from
        AbstractStorage subclass constructors where the handle is created right
@@ -521,6 +653,8 @@ void DataLayer::removeStorageInternal(const UnsignedInt id) {
        no-longer-referenced reference-counted storages from doPreUpdate() also
        doesn't need this function to do the same redundant check. */
     CORRADE_INTERNAL_DEBUG_ASSERT(storage.used.referenceCount == 0);
+    /* With no references there should be no data in the list either */
+    CORRADE_INTERNAL_DEBUG_ASSERT(state.storageFirstData[id] == ~UnsignedInt{});
 
     /* Increase the storage generation so existing handles pointing to this
        storage are invalidated. Wrap around to 0 if it goes over the generation
@@ -538,6 +672,12 @@ void DataLayer::removeStorageInternal(const UnsignedInt id) {
        StorageFlagAllocated, or doPreUpdate() doesn't attempt to remove a
        StorageFlag::ReferenceCounted storage with zero referemces, etc. */
     storage.used.flags = {};
+    /* Clear also the dirty and unreferenced bits so a recycled storage starts
+       from a clean state and doPreUpdate() doesn't attempt to remove it
+       again */
+    resetBit(state.dirtyStorages, id);
+    resetBit(state.unreferencedStorages, id);
+    resetBit(state.concurrentStorages, id);
 
     /* Put the storage at the end of the free list (while they're allocated
        from the front) to not exhaust the generation counter too fast. If the
@@ -575,13 +715,13 @@ bool DataLayer::isStorageAllocated(const DataLayerStorageHandle handle) const {
 bool DataLayer::isStorageDirty(const StorageHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::DataLayer::isStorageDirty(): invalid handle" << handle, {});
-    return _state->storages[storageHandleId(handle)].used.flags >= StorageFlagDirty;
+    return isBitSet(_state->dirtyStorages, storageHandleId(handle));
 }
 
 bool DataLayer::isStorageDirty(const DataLayerStorageHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::DataLayer::isStorageDirty(): invalid handle" << handle, {});
-    return _state->storages[dataLayerStorageHandleId(handle)].used.flags >= StorageFlagDirty;
+    return isBitSet(_state->dirtyStorages, dataLayerStorageHandleId(handle));
 }
 
 void DataLayer::setStorageDirty(const StorageHandle handle) {
@@ -597,11 +737,11 @@ void DataLayer::setStorageDirty(const DataLayerStorageHandle handle) {
 }
 
 void DataLayer::setStorageDirtyInternal(const UnsignedInt id) {
-    StorageData& storage = _state->storages[id];
-    storage.used.flags |= StorageFlagDirty;
+    State& state = *_state;
+    setBit(state.dirtyStorages, id);
 
     /* Trigger layer update only if the storage is actually used */
-    if(storage.used.referenceCount != 0)
+    if(state.storages[id].used.referenceCount != 0)
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
 }
 
@@ -696,10 +836,6 @@ inline Containers::Size3D delinearizeIndex(const Containers::Size3D& size, std::
     return out;
 }
 
-inline UnsignedInt extractStorageId(const UnsignedInt storageIdDirty) {
-    return storageIdDirty & ((1 << Implementation::DataLayerStorageHandleIdBits) - 1);
-}
-
 }
 
 DataHandle DataLayer::create(const AbstractStorageQuery& query, const Implementation::StorageCallOoverload overload, Containers::FunctionData&& function, const NodeHandle node) {
@@ -725,19 +861,35 @@ DataHandle DataLayer::create(const AbstractStorageQuery& query, const Implementa
     const UnsignedInt storageId = dataLayerStorageHandleId(query._storage);
     StorageData& storageData = state.storages[storageId];
 
-    /* Increase storage reference count */
+    /* Increase storage reference count. If it's reference-counted, it's no
+       longer a candidate for removal. */
     ++storageData.used.referenceCount;
+    resetBit(state.unreferencedStorages, storageId);
 
     const DataHandle handle = AbstractLayer::create(node);
     const UnsignedInt id = dataHandleId(handle);
-    if(id >= state.data.size())
+    if(id >= state.data.size()) {
         /* Can't use NoInit because of non-trivial types */
         arrayResize(state.data, ValueInit, id + 1);
+        if(state.data.size() > state.dirtyData.size()*64)
+            arrayResize(state.dirtyData, ValueInit, (state.data.size() + 63)/64);
+    }
     Data& data = state.data[id];
 
+    /* Put the data at the front of the list of data referencing the
+       storage */
+    data.storageId = storageId;
+    data.previousData = ~UnsignedInt{};
+    data.nextData = state.storageFirstData[storageId];
+    if(data.nextData != ~UnsignedInt{})
+        state.data[data.nextData].previousData = id;
+    state.storageFirstData[storageId] = id;
+
     /* The data binding is implicitly dirty upon creation */
-    data.storageIdDirty = storageId|DataIsDirty;
+    setBit(state.dirtyData, id);
     data.operations = query._operations;
+    data.updateInterval = {};
+    data.lastUpdate = Nanoseconds::min();
     /* While the 3D size is 3*4/8 bytes, in practice addressing anything with a
        >4/8 byte address is impossible, thus the 3D index gets linearized into
        a single size_t value */
@@ -771,16 +923,32 @@ void DataLayer::removeInternal(const UnsignedInt id) {
        destructors */
     data.function = {};
 
+    /* Reset the dirty bit so doPreUpdate() doesn't attempt to call the update
+       function on removed data */
+    resetBit(state.dirtyData, id);
+
+    /* Remove the data from the list of data referencing the storage */
+    const UnsignedInt storageId = data.storageId;
+    if(data.previousData != ~UnsignedInt{})
+        state.data[data.previousData].nextData = data.nextData;
+    else {
+        CORRADE_INTERNAL_DEBUG_ASSERT(state.storageFirstData[storageId] == id);
+        state.storageFirstData[storageId] = data.nextData;
+    }
+    if(data.nextData != ~UnsignedInt{})
+        state.data[data.nextData].previousData = data.previousData;
+
     /* Decrement storage reference count */
-    const UnsignedInt storageId = extractStorageId(data.storageIdDirty);
     StorageData& storage = state.storages[storageId];
     CORRADE_INTERNAL_DEBUG_ASSERT(storage.used.referenceCount > 0);
     --storage.used.referenceCount;
 
     /* If the storage is reference-counted and has zero references, mark the
        layer for update so it removes the storage on the next update */
-    if(storage.used.flags >= StorageFlag::ReferenceCounted && storage.used.referenceCount == 0)
+    if(storage.used.flags >= StorageFlag::ReferenceCounted && storage.used.referenceCount == 0) {
+        setBit(state.unreferencedStorages, storageId);
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+    }
 }
 
 bool DataLayer::isAllocated(const DataHandle handle) const {
@@ -798,13 +966,13 @@ bool DataLayer::isAllocated(const LayerDataHandle handle) const {
 bool DataLayer::isDirty(const DataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::DataLayer::isDirty(): invalid handle" << handle, {});
-    return _state->data[dataHandleId(handle)].storageIdDirty & DataIsDirty;
+    return isBitSet(_state->dirtyData, dataHandleId(handle));
 }
 
 bool DataLayer::isDirty(const LayerDataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::DataLayer::isDirty(): invalid handle" << handle, {});
-    return _state->data[layerDataHandleId(handle)].storageIdDirty & DataIsDirty;
+    return isBitSet(_state->dirtyData, layerDataHandleId(handle));
 }
 
 void DataLayer::setDirty(const DataHandle handle) {
@@ -820,14 +988,15 @@ void DataLayer::setDirty(const LayerDataHandle handle) {
 }
 
 void DataLayer::setDirtyInternal(const UnsignedInt id) {
-    Data& data = _state->data[id];
+    State& state = *_state;
 
     /* If the data is already dirty, the corresponding state should be set as
-       well. In other words, we don't need to branch and set the state only if
-       not dirty already. */
-    CORRADE_INTERNAL_DEBUG_ASSERT(!(data.storageIdDirty & DataIsDirty) || state() >= LayerState::NeedsCommonDataUpdate);
+       well, unless its call got postponed due to an update interval. In other
+       words, we don't need to branch and set the state only if not dirty
+       already. */
+    CORRADE_INTERNAL_DEBUG_ASSERT(!isBitSet(state.dirtyData, id) || this->state() >= LayerState::NeedsCommonDataUpdate || state.data[id].updateInterval != Nanoseconds{});
 
-    data.storageIdDirty |= DataIsDirty;
+    setBit(state.dirtyData, id);
     setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
 }
 
@@ -845,7 +1014,7 @@ StorageHandle DataLayer::storage(const LayerDataHandle handle) const {
 
 inline StorageHandle DataLayer::storageInternal(const UnsignedInt id) const {
     const State& state = *_state;
-    const UnsignedInt storageId = extractStorageId(state.data[id].storageIdDirty);
+    const UnsignedInt storageId = state.data[id].storageId;
     return storageHandle(handle(), storageId, state.storages[storageId].used.generation);
 }
 
@@ -864,7 +1033,7 @@ Containers::Size3D DataLayer::index(const LayerDataHandle handle) const {
 inline Containers::Size3D DataLayer::indexInternal(const UnsignedInt id) const {
     const State& state = *_state;
     const Data& data = state.data[id];
-    return delinearizeIndex(state.storages[extractStorageId(data.storageIdDirty)].used.size, data.linearizedIndex);
+    return delinearizeIndex(state.storages[data.storageId].used.size, data.linearizedIndex);
 }
 
 void DataLayer::setIndex(const DataHandle handle, const std::size_t index) {
@@ -882,7 +1051,7 @@ void DataLayer::setIndex(const LayerDataHandle handle, const std::size_t index)
 void DataLayer::setIndexInternal(const UnsignedInt id, const std::size_t index) {
     #ifndef CORRADE_NO_ASSERT
     State& state = *_state;
-    const Containers::Size3D& size = state.storages[extractStorageId(state.data[id].storageIdDirty)].used.size;
+    const Containers::Size3D& size = state.storages[state.data[id].storageId].used.size;
     #endif
     CORRADE_ASSERT(size[0] == 1 && size[1] == 1,
         "Ui::DataLayer::setIndex(): expected a 1D storage but got a size of" << size, );
@@ -904,7 +1073,7 @@ void DataLayer::setIndex(const LayerDataHandle handle, const Containers::Size2D&
 void DataLayer::setIndexInternal(const UnsignedInt id, const Containers::Size2D& index) {
     #ifndef CORRADE_NO_ASSERT
     State& state = *_state;
-    const Containers::Size3D& size = state.storages[extractStorageId(state.data[id].storageIdDirty)].used.size;
+    const Containers::Size3D& size = state.storages[state.data[id].storageId].used.size;
     #endif
     CORRADE_ASSERT(size[0] == 1,
         "Ui::DataLayer::setIndex(): expected a 2D storage but got a size of" << size, );
@@ -926,7 +1095,7 @@ void DataLayer::setIndex(const LayerDataHandle handle, const Containers::Size3D&
 void DataLayer::setIndexInternal(const UnsignedInt id, const Containers::Size3D& index) {
     State& state = *_state;
     Data& data = state.data[id];
-    const Containers::Size3D& size = state.storages[extractStorageId(data.storageIdDirty)].used.size;
+    const Containers::Size3D& size = state.storages[data.storageId].used.size;
     CORRADE_ASSERT(index[0] < size[0] && index[1] < size[1] && index[2] < size[2],
         "Ui::DataLayer::setIndex(): index" << index << "out of range for" << size << "elements", );
     const std::size_t linearizedIndex = linearizeIndex(size, index);
@@ -935,11 +1104,48 @@ void DataLayer::setIndexInternal(const UnsignedInt id, const Containers::Size3D&
        with NeedsCommonDataUpdate */
     if(data.linearizedIndex != linearizedIndex) {
         data.linearizedIndex = linearizedIndex;
-        data.storageIdDirty |= DataIsDirty;
+        setBit(state.dirtyData, id);
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
     }
 }
 
+Nanoseconds DataLayer::updateInterval(const DataHandle handle) const {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::DataLayer::updateInterval(): invalid handle" << handle, {});
+    return _state->data[dataHandleId(handle)].updateInterval;
+}
+
+Nanoseconds DataLayer::updateInterval(const LayerDataHandle handle) const {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::DataLayer::updateInterval(): invalid handle" << handle, {});
+    return _state->data[layerDataHandleId(handle)].updateInterval;
+}
+
+void DataLayer::setUpdateInterval(const DataHandle handle, const Nanoseconds interval) {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::DataLayer::setUpdateInterval(): invalid handle" << handle, );
+    setUpdateIntervalInternal(dataHandleId(handle), interval);
+}
+
+void DataLayer::setUpdateInterval(const LayerDataHandle handle, const Nanoseconds interval) {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::DataLayer::setUpdateInterval(): invalid handle" << handle, );
+    setUpdateIntervalInternal(layerDataHandleId(handle), interval);
+}
+
+void DataLayer::setUpdateIntervalInternal(const UnsignedInt id, const Nanoseconds interval) {
+    CORRADE_ASSERT(interval >= Nanoseconds{},
+        "Ui::DataLayer::setUpdateInterval(): expected non-negative interval, got" << interval, );
+    State& state = *_state;
+    state.data[id].updateInterval = interval;
+
+    /* If the data is dirty, its call might have been postponed with the
+       previous interval. Trigger an update to re-evaluate it with the new
+       one. */
+    if(isBitSet(state.dirtyData, id))
+        setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+}
+
 bool DataLayer::isMutable(const DataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::DataLayer::isMutable(): invalid handle" << handle, {});
@@ -1126,7 +1332,7 @@ StorageUpdateState DataLayer::updateInternal(
         messagePrefix << "data binding is immutable", {});
     CORRADE_ASSERT(data.operations >= operation,
         messagePrefix << operation << "not supported", {});
-    const UnsignedInt storageId = extractStorageId(data.storageIdDirty);
+    const UnsignedInt storageId = data.storageId;
     const StorageData& storage = state.storages[storageId];
     const StorageUpdateState updateState = data.updater(*this, dataLayerStorageHandle(storageId, state.storages[storageId].used.generation), delinearizeIndex(storage.used.size, data.linearizedIndex), operation, value);
     /* All operations except Set are expected to return only Success */
@@ -1139,6 +1345,31 @@ LayerFeatures DataLayer::doFeatures() const {
     return {};
 }
 
+LayerStates DataLayer::doState() const {
+    const State& state = *_state;
+
+    /* If there's a data with a postponed call and its interval already
+       passed, it's time to call it. The UI is guaranteed to be present if
+       there's any postponed data, see doPreUpdate(). */
+    if(state.nextDeferredUpdate != Nanoseconds::max() && ui().animationTime() >= state.nextDeferredUpdate)
+        return LayerState::NeedsCommonDataUpdate;
+
+    /* Concurrent storages are marked as dirty from other threads without the
+       layer knowing, so poll their flags. Only storages used by some data are
+       interesting, as only those would result in any update being done. If an
+       unused one is dirty, the flag gets picked up by the next doPreUpdate()
+       anyway, and data newly bound to it are dirty on creation. */
+    for(std::size_t i = 0; i != state.concurrentStorages.size(); ++i) {
+        for(UnsignedLong word = state.concurrentStorages[i]; word; word &= word - 1) {
+            const StorageData& storage = state.storages[i*64 + findFirstSet(word)];
+            if(storage.used.referenceCount && concurrentStorageHeader(storage.used.data.allocated.data).dirty.load(std::memory_order_relaxed))
+                return LayerState::NeedsCommonDataUpdate;
+        }
+    }
+
+    return {};
+}
+
 void DataLayer::doClean(const Containers::BitArrayView dataIdsToRemove) {
     /** @todo some way to iterate bits */
     for(std::size_t i = 0; i != dataIdsToRemove.size(); ++i) {
@@ -1156,68 +1387,121 @@ void DataLayer::doPreUpdate(const LayerStates state_) {
     #endif
     CORRADE_INTERNAL_ASSERT(state_ == LayerState::NeedsCommonDataUpdate);
 
-    /** @todo once fast bit traversal is a thing, for faster updates might want
-        to maintain per-data and per-storage dirty bits in dedicated BitArrays
-        and data->storage mapping as well, which then gets used to map
-        per-storage dirty bits to per-data and ultimately traverse only those
-        that are set */
-
-    /* Go through all data and fire updates on data that are dirty or data
-       associated with storages that are dirty */
+    /* Pick up dirty flags set from other threads on concurrent storages.
+       The acquire pairs with the release in setDirtyConcurrent(), making
+       everything written to the storage before marking it dirty visible to
+       the queries below. The relaxed load first avoids an atomic
+       read-modify-write on storages that didn't change. */
     State& state = *_state;
-    const Containers::StridedArrayView1D<const UnsignedShort> generations = this->generations();
-    const LayerHandle layerHandle = handle();
-    for(std::size_t i = 0; i != state.data.size(); ++i) {
-        Data& data = state.data[i];
-
-        /* Data with null functions are removed, skip those */
-        if(!data.function)
-            continue;
+    for(std::size_t i = 0; i != state.concurrentStorages.size(); ++i) {
+        for(UnsignedLong word = state.concurrentStorages[i]; word; word &= word - 1) {
+            const UnsignedInt storageId = i*64 + findFirstSet(word);
+            std::atomic<bool>& dirty = concurrentStorageHeader(state.storages[storageId].used.data.allocated.data).dirty;
+            if(dirty.load(std::memory_order_relaxed) && dirty.exchange(false, std::memory_order_acquire))
+                setBit(state.dirtyStorages, storageId);
+        }
+    }
 
-        /* If neither the data nor the storage is dirty, skip */
-        const UnsignedInt storageId = extractStorageId(data.storageIdDirty);
-        const StorageData& storage = state.storages[storageId];
-        if(!(data.storageIdDirty & DataIsDirty) &&
-           !(storage.used.flags >= StorageFlagDirty))
-            continue;
+    /* Propagate dirty storages to all data referencing them. The work done
+       is proportional to the amount of dirty storages and data bound to them,
+       not the total data count. */
+    for(std::size_t i = 0; i != state.dirtyStorages.size(); ++i) {
+        for(UnsignedLong word = state.dirtyStorages[i]; word; word &= word - 1) {
+            const UnsignedInt storageId = i*64 + findFirstSet(word);
+            for(UnsignedInt id = state.storageFirstData[storageId]; id != ~UnsignedInt{}; id = state.data[id].nextData)
+                setBit(state.dirtyData, id);
+        }
+    }
 
-        /** @todo to avoid too many nested function calls, we could also pass
-            the data pointer directly to the call function instead of it having
-            to go through AbstractStorage::data() -> DataLayer::storageData()
-            each time. In other words, AbstractStorage would have an ability to
-            use a cached data member pointer, by default a storage instantiated
-            through DataLayer::storage<T>() would query it from the layer every
-            time (as in-place pointers can change on reallocation), but here
-            it'd use the cached value. */
-        data.call(
-            *this, dataLayerStorageHandle(storageId, storage.used.generation),
-            delinearizeIndex(storage.used.size, data.linearizedIndex),
-            dataHandle(layerHandle, i, generations[i]),
-            data.function);
-
-        /* Update got called, reset the data dirty bit if it's set */
-        data.storageIdDirty &= ~DataIsDirty;
+    /* Go through all dirty data and fire updates on them, in order of their
+       IDs. Data with an update interval that were called too recently are
+       skipped, staying dirty, and the earliest time any of them can be called
+       is remembered for doState(). Without a UI there's no time source and
+       the intervals are ignored.
+
+       The word is re-read from the live array after every call, as the called
+       functions can remove data, which clears their dirty bit in
+       removeInternal(), and those mustn't be called anymore. Bits that were
+       already visited in this pass are masked away so deferred data, which
+       stay dirty, and data marked dirty again by a called function aren't
+       visited twice. */
+    const Containers::StridedArrayView1D<const UnsignedShort> generations = this->generations();
+    const LayerHandle layerHandle = handle();
+    const bool hasTime = hasUi();
+    const Nanoseconds time = hasTime ? ui().animationTime() : Nanoseconds{};
+    state.nextDeferredUpdate = Nanoseconds::max();
+    for(std::size_t i = 0; i != state.dirtyData.size(); ++i) {
+        UnsignedLong visited = 0;
+        for(UnsignedLong word; (word = state.dirtyData[i] & ~visited); ) {
+            const UnsignedInt bit = findFirstSet(word);
+            visited |= 1ull << bit;
+            const UnsignedInt id = i*64 + bit;
+            Data& data = state.data[id];
+            /* Removed data have the dirty bit cleared in removeInternal() */
+            CORRADE_INTERNAL_DEBUG_ASSERT(data.function);
+
+            if(hasTime && data.updateInterval != Nanoseconds{}) {
+                /* The lastUpdate is Nanoseconds::min() initially, adding a
+                   non-negative interval to it can't overflow */
+                const Nanoseconds next = data.lastUpdate + data.updateInterval;
+                if(time < next) {
+                    if(next < state.nextDeferredUpdate)
+                        state.nextDeferredUpdate = next;
+                    continue;
+                }
+                data.lastUpdate = time;
+            }
+
+            /* Resolve the storage data pointer here and pass it to the call
+               function directly, so AbstractStorage::data() in the query
+               doesn't need to go through DataLayer::storageData() with all
+               its checks for every call. It's resolved right before each call
+               and not once for all data upfront as the in-place storage
+               pointers change if the storages array gets reallocated, which
+               can happen if a previously called function creates a new
+               storage. */
+            StorageData& storage = state.storages[data.storageId];
+            data.call(
+                *this, dataLayerStorageHandle(data.storageId, storage.used.generation),
+                storage.used.flags >= StorageFlagAllocated ?
+                    storage.used.data.allocated.data :
+                    storage.used.data.inPlace,
+                delinearizeIndex(storage.used.size, data.linearizedIndex),
+                dataHandle(layerHandle, id, generations[id]),
+                data.function);
+
+            /* Update got called, reset the data dirty bit */
+            resetBit(state.dirtyData, id);
+        }
     }
 
-    /* Once all data are updated, reset the storage dirty bits as well */
-    for(std::size_t i = 0; i != state.storages.size(); ++i) {
-        StorageData& storage = state.storages[i];
-        /* This can be safely done even on removed storages, as the flags field
-           is preserved (but cleared, so this is a no-op). */
-        storage.used.flags &= ~StorageFlagDirty;
-
-        /* If the storage is reference-counted and has zero references, remove
-           it. Storages have their flags cleared on removal, so this branch
-           shouldn't be entered for removed storages (which have the size set
-           to zero). */
-        if(storage.used.flags >= StorageFlag::ReferenceCounted && storage.used.referenceCount == 0) {
-            CORRADE_INTERNAL_DEBUG_ASSERT(storage.used.size[0]);
-            removeStorageInternal(i);
+    /* Once all data are updated, reset the storage dirty bits as well. This
+       is done for unused storages too. */
+    for(UnsignedLong& word: state.dirtyStorages)
+        word = 0;
+
+    /* Remove reference-counted storages that have zero references. The bits
+       are cleared in removeStorageInternal(). */
+    for(std::size_t i = 0; i != state.unreferencedStorages.size(); ++i) {
+        for(UnsignedLong word = state.unreferencedStorages[i]; word; word &= word - 1) {
+            const UnsignedInt storageId = i*64 + findFirstSet(word);
+            #ifndef CORRADE_NO_DEBUG_ASSERT
+            const StorageData& storage = state.storages[storageId];
+            #endif
+            CORRADE_INTERNAL_DEBUG_ASSERT(storage.used.size[0] && storage.used.flags >= StorageFlag::ReferenceCounted && storage.used.referenceCount == 0);
+            removeStorageInternal(storageId);
         }
     }
 }
 
-AbstractStorageQuery::AbstractStorageQuery(const AbstractStorage& storage, const Containers::Size3D& index, const StorageOperations operations, void(*(*const call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, DataHandle, Containers::FunctionData&), StorageUpdateState(*const updater)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation, const void*)): _layer{&storage.layer()}, _storage{storageHandleStorage(storage.handle())}, _operations{operations}, _index{index}, _call{call}, _updater{updater} {
+void AbstractStorage::setDirtyConcurrent(void* const data) {
+    /* Not asserting on null data as that would involve the (not thread-safe)
+       Debug output in a function that's called from other threads. The
+       release pairs with the acquire in DataLayer::doPreUpdate(). */
+    concurrentStorageHeader(data).dirty.store(true, std::memory_order_release);
+}
+
+AbstractStorageQuery::AbstractStorageQuery(const AbstractStorage& storage, const Containers::Size3D& index, const StorageOperations operations, void(*(*const call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, DataHandle, Containers::FunctionData&), StorageUpdateState(*const updater)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation, const void*)): _layer{&storage.layer()}, _storage{storageHandleStorage(storage.handle())}, _operations{operations}, _index{index}, _call{call}, _updater{updater} {
     /* The class is always constructed through the StorageQuery subclass, so
        make the assertions mention that to reduce confusion */
     CORRADE_ASSERT(_layer->isHandleValid(_storage),
@@ -272,8 +272,8 @@ enum class StorageFlag: UnsignedByte {
      */
     ReferenceCounted = 1 << 0,
 
-    /* Last two bits used internally for distinguishing alocated and dirty
-       storage */
+    /* Last two bits used internally for distinguishing allocated and
+       concurrent storage */
 };
 
 /**
@@ -1076,6 +1076,62 @@ class MAGNUM_UI_EXPORT DataLayer: public AbstractLayer {
          */
         void setIndex(LayerDataHandle handle, const Containers::Size3D& index);
 
+        /**
+         * @brief Minimal interval between update function calls for given data
+         *
+         * Expects that @p handle is valid. Default is a zero interval, i.e.
+         * the update function is called in every update where the data is
+         * dirty.
+         * @see @ref isHandleValid(DataHandle) const
+         */
+        Nanoseconds updateInterval(DataHandle handle) const;
+
+        /**
+         * @brief Minimal interval between update function calls for given data assuming it belongs to this layer
+         *
+         * Like @ref updateInterval(DataHandle) const but without checking that
+         * @p handle indeed belongs to this layer. See its documentation for
+         * more information.
+         * @see @ref isHandleValid(LayerDataHandle) const,
+         *      @ref dataHandleData()
+         */
+        Nanoseconds updateInterval(LayerDataHandle handle) const;
+
+        /**
+         * @brief Set a minimal interval between update function calls for given data
+         *
+         * Expects that @p handle is valid and @p interval is not negative. If
+         * the data gets dirty sooner than @p interval after its update
+         * function was last called, the call is postponed until the interval
+         * passes, with the data staying dirty in the meantime. As the value is
+         * queried from the storage only at the time of the call, any number of
+         * storage changes in between get coalesced into a single call with
+         * the latest value. Useful for example for labels displaying values
+         * that change every frame, where reformatting and reshaping the text
+         * that often is both wasteful and unreadable.
+         *
+         * The time is taken from @ref AbstractUserInterface::animationTime(),
+         * which means the application is expected to call
+         * @ref AbstractUserInterface::advanceAnimations() regularly for the
+         * postponed calls to eventually happen. Once the interval passes,
+         * @ref state() contains @ref LayerState::NeedsCommonDataUpdate again.
+         * If the layer isn't a part of a user interface, the interval is
+         * ignored. A zero @p interval disables the throttling.
+         * @see @ref isHandleValid(DataHandle) const, @ref isDirty()
+         */
+        void setUpdateInterval(DataHandle handle, Nanoseconds interval);
+
+        /**
+         * @brief Set a minimal interval between update function calls for given data assuming it belongs to this layer
+         *
+         * Like @ref setUpdateInterval(DataHandle, Nanoseconds) but without
+         * checking that @p handle indeed belongs to this layer. See its
+         * documentation for more information.
+         * @see @ref isHandleValid(LayerDataHandle) const,
+         *      @ref dataHandleData()
+         */
+        void setUpdateInterval(LayerDataHandle handle, Nanoseconds interval);
+
         /**
          * @brief Whether given data binding is mutable
          *
@@ -1323,10 +1379,11 @@ class MAGNUM_UI_EXPORT DataLayer: public AbstractLayer {
         friend AbstractStorage;
         template<class> friend class StorageQuery; /* calls create() */
 
-        /* These four are called from within AbstractStorage */
+        /* These five are called from within AbstractStorage */
         DataLayerStorageHandle createStorage(const Containers::Size3D& size, StorageFlags flags);
         auto createStorageInPlace(DataLayerStorageHandle handle) -> char(&)[Implementation::DataLayerStorageMaxInPlaceSize];
         void* createStorageAllocated(DataLayerStorageHandle handle, void* data, std::size_t dataSize, void(*deleter)(void*, std::size_t));
+        void* createStorageConcurrent(DataLayerStorageHandle handle, std::size_t dataSize);
         void* storageData(DataLayerStorageHandle handle);
 
         MAGNUM_UI_LOCAL void removeStorageInternal(UnsignedInt id);
@@ -1346,6 +1403,7 @@ class MAGNUM_UI_EXPORT DataLayer: public AbstractLayer {
         MAGNUM_UI_LOCAL void setIndexInternal(UnsignedInt id, std::size_t index);
         MAGNUM_UI_LOCAL void setIndexInternal(UnsignedInt id, const Containers::Size2D& index);
         MAGNUM_UI_LOCAL void setIndexInternal(UnsignedInt id, const Containers::Size3D& index);
+        MAGNUM_UI_LOCAL void setUpdateIntervalInternal(UnsignedInt id, Nanoseconds interval);
         StorageUpdateState setInternal(DataHandle handle, const void* value);
         StorageUpdateState setInternal(LayerDataHandle handle, const void* value);
         MAGNUM_UI_LOCAL void updateInternal(
@@ -1366,6 +1424,7 @@ class MAGNUM_UI_EXPORT DataLayer: public AbstractLayer {
             LayerDataHandle handle, StorageOperation operation, const void* value);
 
         MAGNUM_UI_LOCAL LayerFeatures doFeatures() const override;
+        MAGNUM_UI_LOCAL LayerStates doState() const override;
         MAGNUM_UI_LOCAL void doClean(Containers::BitArrayView dataIdsToRemove) override;
         MAGNUM_UI_LOCAL void doPreUpdate(LayerStates state) override;
 
@@ -1637,6 +1696,48 @@ class MAGNUM_UI_EXPORT AbstractStorage {
             return static_cast<T*>(_layer->createStorageAllocated(_handle, data, size, deleter));
         }
 
+        /**
+         * @brief Create a storage that's updated concurrently
+         * @param size      Size of the data in bytes
+         * @return Pointer to the allocated data
+         *
+         * Allocates @p size bytes of memory owned by the layer, aligned to at
+         * least @cpp 8 @ce bytes and staying at the same location for the
+         * whole storage lifetime. Contrary to @ref createAllocated() or
+         * @ref createInPlace(), the memory is meant to be written to also from
+         * threads other than the one the layer lives in, with each
+         * modification announced through @ref setDirtyConcurrent() instead of
+         * @ref setDirty(). The layer polls for such modifications in
+         * @ref DataLayer::state() and calls data bound to the storage in the
+         * next @ref AbstractUserInterface::update(). It's the subclass
+         * responsibility to initialize the memory and to ensure all accesses
+         * to it are free of data races, such as by going only through atomic
+         * types. See @ref ConcurrentNumericStorage for an example.
+         *
+         * The returned memory is deleted when the storage is removed, at
+         * which point no other thread is allowed to access it anymore.
+         * @see @ref isAllocated()
+         */
+        void* createConcurrent(std::size_t size) {
+            return _layer->createStorageConcurrent(_handle, size);
+        }
+
+        /**
+         * @brief Mark a concurrently updated storage as dirty
+         * @param data      Pointer returned from @ref createConcurrent()
+         *
+         * Lock-free and safe to be called from any thread, as it touches only
+         * a flag next to @p data and not the layer itself. All writes to
+         * @p data done by the calling thread before this function is called
+         * are guaranteed to be visible to queries executed in the next
+         * @ref AbstractUserInterface::update(). If the storage is used by any
+         * data, @ref DataLayer::state() then contains
+         * @ref LayerState::NeedsCommonDataUpdate. Calling this function
+         * multiple times before the update results in the bound data getting
+         * called just once.
+         */
+        static void setDirtyConcurrent(void* data);
+
         /**
          * @brief Storage data
          *
@@ -1651,9 +1752,16 @@ class MAGNUM_UI_EXPORT AbstractStorage {
          * @ref AbstractStorage implementation to detect this on its own,
          * especially considering the storage may be just a view on memory
          * managed elsewhere.
+         *
+         * When called from a query executed as part of a data update in
+         * @ref AbstractUserInterface::update(), the pointer is resolved by
+         * the layer upfront and this function doesn't need to call into it
+         * at all. Don't save copies of the storage instance passed to the
+         * query for use outside of it, as the in-place storage pointer may
+         * become invalid once new storages are created.
          */
         template<class T> T* data() const {
-            return static_cast<T*>(_layer->storageData(_handle));
+            return static_cast<T*>(_data ? _data : _layer->storageData(_handle));
         }
 
     private:
@@ -1667,8 +1775,13 @@ class MAGNUM_UI_EXPORT AbstractStorage {
 
         /* Used by StorageLambda and also DataLayer::storageInternal() */
         explicit AbstractStorage(DataLayer& layer, DataLayerStorageHandle handle): _layer{&layer}, _handle{handle} {}
+        /* Used by Implementation::StorageQuery with a data pointer resolved
+           by DataLayer::doPreUpdate(), or nullptr */
+        explicit AbstractStorage(DataLayer& layer, DataLayerStorageHandle handle, void* data): _layer{&layer}, _data{data}, _handle{handle} {}
 
         DataLayer* _layer;
+        /* If non-null, returned from data() instead of querying the layer */
+        void* _data{};
         DataLayerStorageHandle _handle;
         /* 0/4 bytes free, but with explicit padding to make non-trivial
            subclasses fail to compile. Update when changing the members. */
@@ -1832,7 +1945,7 @@ class MAGNUM_UI_EXPORT AbstractStorageQuery {
            getters */
         friend DataLayer;
 
-        explicit AbstractStorageQuery(const AbstractStorage& storage, const Containers::Size3D& index, StorageOperations operations, void(*(*call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, DataHandle, Containers::FunctionData&), StorageUpdateState(*updater)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation, const void*));
+        explicit AbstractStorageQuery(const AbstractStorage& storage, const Containers::Size3D& index, StorageOperations operations, void(*(*call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, DataHandle, Containers::FunctionData&), StorageUpdateState(*updater)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation, const void*));
 
         MAGNUM_UI_LOCAL StorageUpdateState updateInternal(
             #ifndef CORRADE_NO_ASSERT
@@ -1855,7 +1968,7 @@ class MAGNUM_UI_EXPORT AbstractStorageQuery {
            to defer a choice of particular overload until the StorageQuery is
            passed to DataLayer::onUpdate() without having to store them as
            several 8-byte pointer members. */
-        void(*(*_call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, DataHandle, Containers::FunctionData&);
+        void(*(*_call)(Implementation::StorageCallOoverload))(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, DataHandle, Containers::FunctionData&);
         StorageUpdateState(*_updater)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation, const void*);
 };
 
@@ -2242,7 +2355,7 @@ template<class T> class StorageQuery: public AbstractStorageQuery {
            arguments when calling a constructor. */
         template<UnsignedInt dimensions, class Storage, class F, class G> explicit StorageQuery(const Storage& storage, const Containers::Size3D& index, StorageOperations operations, Implementation::StorageArgs<dimensions, F, G>);
 
-        T(*_query)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, StorageOperation);
+        T(*_query)(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, StorageOperation);
 };
 
 template<class Storage> Storage DataLayer::storage(const StorageHandle handle) {
@@ -2273,38 +2386,42 @@ namespace Implementation {
        StorageQuery constructor, and in case of the updater also nullptr
        instead of a lambda */
     template<class Storage, class T, class F> struct StorageQuery<0, Storage, T, F> {
-        static T call(DataLayer& layer, const DataLayerStorageHandle handle, const Containers::Size3D&, const StorageOperation operation) {
+        static T call(DataLayer& layer, const DataLayerStorageHandle handle, void* const data, const Containers::Size3D&, const StorageOperation operation) {
             /* With a non-capturing lambda, all we need for calling it is the F
                type, there's no point in storing the (empty) `query` instance
                itself. Could also do `*reinterpret_cast<F*>(nullptr)` but
                casting from an empty struct doesn't break the "`this` pointer
-               is never null" rule and avoids compiler warnings. */
+               is never null" rule and avoids compiler warnings.
+
+               The `data` is either the storage data pointer resolved by
+               DataLayer::doPreUpdate() or nullptr, in which case
+               AbstractStorage::data() queries it from the layer. */
             struct {} empty;
-            const AbstractStorage storage{layer, handle};
+            const AbstractStorage storage{layer, handle, data};
             return reinterpret_cast<F&>(empty)(static_cast<const Storage&>(storage), operation);
         }
     };
     template<class Storage, class T, class F> struct StorageQuery<1, Storage, T, F> {
-        static T call(DataLayer& layer, const DataLayerStorageHandle handle, const Containers::Size3D& index, const StorageOperation operation) {
+        static T call(DataLayer& layer, const DataLayerStorageHandle handle, void* const data, const Containers::Size3D& index, const StorageOperation operation) {
             /* See above for why we're casting from an empty struct */
             struct {} empty;
-            const AbstractStorage storage{layer, handle};
+            const AbstractStorage storage{layer, handle, data};
             return reinterpret_cast<F&>(empty)(static_cast<const Storage&>(storage), index[2], operation);
         }
     };
     template<class Storage, class T, class F> struct StorageQuery<2, Storage, T, F> {
-        static T call(DataLayer& layer, const DataLayerStorageHandle handle, const Containers::Size3D& index, const StorageOperation operation) {
+        static T call(DataLayer& layer, const DataLayerStorageHandle handle, void* const data, const Containers::Size3D& index, const StorageOperation operation) {
             /* See above for why we're casting from an empty struct */
             struct {} empty;
-            const AbstractStorage storage{layer, handle};
+            const AbstractStorage storage{layer, handle, data};
             return reinterpret_cast<F&>(empty)(static_cast<const Storage&>(storage), {index[1], index[2]}, operation);
         }
     };
     template<class Storage, class T, class F> struct StorageQuery<3, Storage, T, F> {
-        static T call(DataLayer& layer, const DataLayerStorageHandle handle, const Containers::Size3D& index, const StorageOperation operation) {
+        static T call(DataLayer& layer, const DataLayerStorageHandle handle, void* const data, const Containers::Size3D& index, const StorageOperation operation) {
             /* See above for why we're casting from an empty struct */
             struct {} empty;
-            const AbstractStorage storage{layer, handle};
+            const AbstractStorage storage{layer, handle, data};
             return reinterpret_cast<F&>(empty)(static_cast<const Storage&>(storage), index, operation);
         }
     };
@@ -2360,27 +2477,27 @@ namespace Implementation {
        which signature is used in a particular DataLayer::onUpdate() call. Done
        this way to not have to several store pointers to all possible overloads
        in each Ui::StorageQuery instance. */
-    template<UnsignedInt dimensions, class T, class Storage, class F> static auto storageCall(StorageCallOoverload overload) -> void(*)(DataLayer&, DataLayerStorageHandle, const Containers::Size3D&, DataHandle, Containers::FunctionData&) {
+    template<UnsignedInt dimensions, class T, class Storage, class F> static auto storageCall(StorageCallOoverload overload) -> void(*)(DataLayer&, DataLayerStorageHandle, void*, const Containers::Size3D&, DataHandle, Containers::FunctionData&) {
         switch(overload) {
             case StorageCallOoverload::ByReference:
-                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
-                    static_cast<Containers::Function<void(const T&)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation{}));
+                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, void* const storageData, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
+                    static_cast<Containers::Function<void(const T&)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation{}));
                 };
             case StorageCallOoverload::ByValue:
-                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
-                    static_cast<Containers::Function<void(T)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation{}));
+                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, void* const storageData, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
+                    static_cast<Containers::Function<void(T)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation{}));
                 };
             case StorageCallOoverload::ByValueMinMax:
-                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
-                    static_cast<Containers::Function<void(T, T, T)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation{}), StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation::Min), StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation::Max));
+                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, void* const storageData, const Containers::Size3D& index, DataHandle, Containers::FunctionData& result) {
+                    static_cast<Containers::Function<void(T, T, T)>&>(result)(StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation{}), StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation::Min), StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation::Max));
                 };
             case StorageCallOoverload::HandleByReference:
-                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, const Containers::Size3D& index, DataHandle dataHandle, Containers::FunctionData& result) {
-                    static_cast<Containers::Function<void(DataHandle, const T&)>&>(result)(dataHandle, StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation{}));
+                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, void* const storageData, const Containers::Size3D& index, DataHandle dataHandle, Containers::FunctionData& result) {
+                    static_cast<Containers::Function<void(DataHandle, const T&)>&>(result)(dataHandle, StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation{}));
                 };
             case StorageCallOoverload::HandleByValue:
-                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, const Containers::Size3D& index, DataHandle dataHandle, Containers::FunctionData& result) {
-                    static_cast<Containers::Function<void(DataHandle, T)>&>(result)(dataHandle, StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, index, StorageOperation{}));
+                return [](DataLayer& layer, const DataLayerStorageHandle storageHandle, void* const storageData, const Containers::Size3D& index, DataHandle dataHandle, Containers::FunctionData& result) {
+                    static_cast<Containers::Function<void(DataHandle, T)>&>(result)(dataHandle, StorageQuery<dimensions, Storage, T, F>::call(layer, storageHandle, storageData, index, StorageOperation{}));
                 };
         }
         CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -2447,8 +2564,8 @@ template<class T> StorageQuery<T>::operator T() const {
        non-default-constructible T */
     CORRADE_ASSERT(_layer->isHandleValid(_storage),
         "Ui::StorageQuery: invalid handle" << storageHandle(_layer->handle(), _storage),
-        _query(*_layer, _storage, _index, StorageOperation{}));
-    return _query(*_layer, _storage, _index, StorageOperation{});
+        _query(*_layer, _storage, nullptr, _index, StorageOperation{}));
+    return _query(*_layer, _storage, nullptr, _index, StorageOperation{});
 }
 
 template<class T> T StorageQuery<T>::min() const {
@@ -2456,11 +2573,11 @@ template<class T> T StorageQuery<T>::min() const {
        non-default-constructible T */
     CORRADE_ASSERT(_layer->isHandleValid(_storage),
         "Ui::StorageQuery::min(): invalid handle" << storageHandle(_layer->handle(), _storage),
-        _query(*_layer, _storage, _index, StorageOperation::Min));
+        _query(*_layer, _storage, nullptr, _index, StorageOperation::Min));
     CORRADE_ASSERT(_operations >= StorageOperation::Min,
         "Ui::StorageQuery::min():" << StorageOperation::Min << "not supported",
-        _query(*_layer, _storage, _index, StorageOperation::Min));
-    return _query(*_layer, _storage, _index, StorageOperation::Min);
+        _query(*_layer, _storage, nullptr, _index, StorageOperation::Min));
+    return _query(*_layer, _storage, nullptr, _index, StorageOperation::Min);
 }
 
 template<class T> T StorageQuery<T>::max() const {
@@ -2468,11 +2585,11 @@ template<class T> T StorageQuery<T>::max() const {
        non-default-constructible T */
     CORRADE_ASSERT(_layer->isHandleValid(_storage),
         "Ui::StorageQuery::max(): invalid handle" << storageHandle(_layer->handle(), _storage),
-        _query(*_layer, _storage, _index, StorageOperation::Max));
+        _query(*_layer, _storage, nullptr, _index, StorageOperation::Max));
     CORRADE_ASSERT(_operations >= StorageOperation::Max,
         "Ui::StorageQuery::max():" << StorageOperation::Max << "not supported",
-        _query(*_layer, _storage, _index, StorageOperation::Max));
-    return _query(*_layer, _storage, _index, StorageOperation::Max);
+        _query(*_layer, _storage, nullptr, _index, StorageOperation::Max));
+    return _query(*_layer, _storage, nullptr, _index, StorageOperation::Max);
 }
 #endif
 
@@ -0,0 +1,75 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Dual-filter blur, based on the "Bandwidth-Efficient Rendering" talk by
+   Marius Bjørge, SIGGRAPH 2015. The offset is a half-texel of the
+   lower-resolution texture of each downsample / upsample pair, scaled by the
+   desired spread. */
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp vec2 sampleOffset;
+
+#ifdef EXPLICIT_BINDING
+layout(binding = 6)
+#endif
+uniform lowp sampler2D textureData;
+
+in mediump vec2 textureCoordinates;
+
+out lowp vec4 fragmentColor;
+
+void main() {
+    #ifdef DOWNSAMPLE
+    /* Center with a weight of 4 and the four diagonal neighbors with a weight
+       of 1 each */
+    fragmentColor.rgb = (
+        texture(textureData, textureCoordinates).rgb*4.0 +
+        texture(textureData, textureCoordinates + sampleOffset).rgb +
+        texture(textureData, textureCoordinates - sampleOffset).rgb +
+        texture(textureData, textureCoordinates + vec2(sampleOffset.x, -sampleOffset.y)).rgb +
+        texture(textureData, textureCoordinates - vec2(sampleOffset.x, -sampleOffset.y)).rgb
+    )*(1.0/8.0);
+    #elif defined(UPSAMPLE)
+    /* Four axis-aligned neighbors a full source texel away with a weight of 1
+       each and four diagonal neighbors with a weight of 2 each */
+    fragmentColor.rgb = (
+        texture(textureData, textureCoordinates + vec2(-2.0*sampleOffset.x, 0.0)).rgb +
+        texture(textureData, textureCoordinates + vec2( 2.0*sampleOffset.x, 0.0)).rgb +
+        texture(textureData, textureCoordinates + vec2(0.0, -2.0*sampleOffset.y)).rgb +
+        texture(textureData, textureCoordinates + vec2(0.0,  2.0*sampleOffset.y)).rgb +
+        texture(textureData, textureCoordinates + sampleOffset).rgb*2.0 +
+        texture(textureData, textureCoordinates - sampleOffset).rgb*2.0 +
+        texture(textureData, textureCoordinates + vec2(sampleOffset.x, -sampleOffset.y)).rgb*2.0 +
+        texture(textureData, textureCoordinates - vec2(sampleOffset.x, -sampleOffset.y)).rgb*2.0
+    )*(1.0/12.0);
+    #else
+    #error expected either DOWNSAMPLE or UPSAMPLE to be defined
+    #endif
+
+    fragmentColor.a = 1.0;
+}
@@ -26,11 +26,14 @@
 
 #include "Formatter.h"
 
-#include <cerrno> /** @todo throw away once Corrade has standalone formatters */
-#include <cinttypes> /* PRIi64, PRIu64 */ /** @todo throw away also, ugh */
-#include <cstdio> /** @todo throw away once Corrade has integer parsers */
+#include <cerrno> /** @todo throw away once there's a float parser */
+#include <cmath>
+#include <cstdio> /** @todo throw away once all float formatting is handled */
+#include <cstdlib> /** @todo throw away once there's a float parser */
+#include <cstring>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Utility/Assert.h>
 
@@ -134,20 +137,10 @@ namespace {
 
 template<class> struct ParseTraits;
 /* It was
-    constexpr static long long(*parser)(const char*, char**, int) = std::strtoll;
+    constexpr static float(*parser)(const char*, char**) = std::strtof;
    etc. at first, but GCC 4.8 says such a thing isn't a constant expression. So
-   making inline wrappers instead, which should be fine as this code isn't
-   perf critical. Once Corrade has its own integer parsers, this all can go. */
-template<> struct ParseTraits<Long> {
-    static long long parser(const char* string, char** end, int base) {
-        return std::strtoll(string, end, base);
-    }
-};
-template<> struct ParseTraits<UnsignedLong> {
-    static unsigned long long parser(const char* string, char** end, int base) {
-        return std::strtoull(string, end, base);
-    }
-};
+   making inline wrappers instead. Integers have a dedicated parser below, once
+   there's a dedicated float parser as well, this all can go. */
 template<> struct ParseTraits<Float> {
     static Float parser(const char* string, char** end) {
         return std::strtof(string, end);
@@ -159,69 +152,24 @@ template<> struct ParseTraits<Double> {
     }
 };
 
+/* The integer parsers don't need the input to be null-terminated anymore,
+   but the requirement is kept for consistency with FloatFormatter::parse(),
+   which still goes through std::strto[df](). */
 Containers::StringView parsePrepareDecimal(const Containers::StringView text) {
-    /* Return the original view to not cause a crash inside std::strto[u]ll()
-       when testing with graceful assertions, because of course it just crashes
-       instead of doing something reasonable */
     CORRADE_ASSERT(text.flags() >= Containers::StringViewFlag::NullTerminated,
-        "Ui::DecimalFormatter::parse(): text is not null-terminated", text);
+        "Ui::DecimalFormatter::parse(): text is not null-terminated", {});
 
-    /* Trim whitespace from both ends of the string. Trimming of initial spaces
-       is done by std::strto[u]ll() as well but as we need to do the same at
-       the end, we can just do both for symmetry and more control. */
+    /* Trim whitespace from both ends of the string */
     return text.trimmed();
 }
 
-Containers::String parsePrepareHexadecimal(/*mutable*/ Containers::StringView text) {
-    /* Compared to above, here a default-constructed String is already
-       null-terminated so this doesn't cause a crash when testing with
-       graceful assertions */
+Containers::StringView parsePrepareHexadecimal(const Containers::StringView text) {
     CORRADE_ASSERT(text.flags() >= Containers::StringViewFlag::NullTerminated,
         "Ui::HexadecimalFormatter::parse(): text is not null-terminated", {});
 
-    /* Trim whitespace from both ends of the string first, same as in the
-       decimal case above */
-    text = text.trimmed();
-
-    /* On Emscripten (musl) the parser happily accepts just the 0x / 0X prefix
-       alone, with no digits after. Other platforms treat that as an error and
-       so should we. The code responsible for the parsing looks like this and
-       ... I don't think I want to dig deeper.
-        https://git.musl-libc.org/cgit/musl/tree/src/internal/intscan.c?id=5122f9f3c99fee366167c5de98b31546312921ab#n41 */
-    #ifdef CORRADE_TARGET_EMSCRIPTEN
-    if(text == "0x"_s || text == "0X"_s ||
-       text == "+0x"_s || text == "+0X"_s ||
-       text == "-0x"_s || text == "-0X"_s)
-        /* Return an empty (null-terminated) string which should fail on its
-           own */
-        return {};
-    #endif
-
-    /* If the text has a hash prefix and it isn't just the prefix alone,
-       replace it with a zero to make std::strto[u]ll() understand it. It
-       understands the 0x / 0X prefix on its own, no need to do anything for
-       that one. Alternatively I could also pass just the contents after the
-       prefix, but that'd require me to handle negation manually, which is
-       nasty given that signed types don't have a symmetric range. */
-    std::size_t hashPosition = ~std::size_t{};
-    if(text.hasPrefix('#'))
-        hashPosition = 0;
-    else if(text.hasPrefix("-#") || text.hasPrefix("+#"))
-        hashPosition = 1;
-    if(hashPosition != ~std::size_t{} && hashPosition + 1 != text.size()) {
-        /* The longest representable hexadecimal value is 16 bytes long, which
-           easily fits in the SSO along with a prefix and sign, and all spaces
-           were trimmed above already. Worst case the string has many leading
-           zeros, in which case the copy will allocate, but that should be
-           rare. */
-        Containers::String copy{text};
-        copy[hashPosition] = '0';
-        return copy;
-    }
-
-    /* Otherwise return a view wrapped in a String. As the input is always
-       null-terminated this will never make a copy. */
-    return Containers::String::nullTerminatedView(text);
+    /* Trim whitespace from both ends of the string, same as in the decimal
+       case above */
+    return text.trimmed();
 }
 
 Containers::StringView parsePrepareFloat(/*mutable*/ Containers::StringView text) {
@@ -254,44 +202,105 @@ Containers::StringView parsePrepareFloat(/*mutable*/ Containers::StringView text
     return text.trimmed();
 }
 
-/* The actual parsing is implemented just for 64-bit types, because that's what
-   C++ provides, and std::atoi() is dangerous and useless because it has no
-   error reporting or base specification whatsoever */
-template<class T> ParseState parseLong(const Containers::StringView text, T& value, const Int base) {
+/* Value of a digit in base up to 36, or an invalid value if the character
+   isn't a digit at all */
+inline UnsignedInt parseDigit(const char c) {
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    /* Setting the 0x20 bit converts uppercase letters to lowercase and keeps
+       lowercase letters unchanged */
+    const char lowercase = c|0x20;
+    if(lowercase >= 'a' && lowercase <= 'z')
+        return lowercase - 'a' + 10;
+    return ~UnsignedInt{};
+}
+
+/* The actual parsing is implemented just for 64-bit types, the 32-bit
+   variants delegate to it below. Compared to std::strto[u]ll() it doesn't
+   need to deal with locales or errno, and doesn't need the input to be
+   null-terminated. */
+template<class T> ParseState parseLong(const Containers::StringView text, T& value, const UnsignedInt base) {
     /* Assumes that text was processed by parsePrepareDecimal() or
        parsePrepareHexadecimal() first, in particular with all leading and
        trailing whitespace trimmed already */
+    const char* i = text.begin();
+    const char* const end = text.end();
+
+    bool negative = false;
+    if(i != end && (*i == '+' || *i == '-')) {
+        negative = *i == '-';
+        ++i;
+    }
 
     /* If we're parsing an unsigned type and this is a negative value, treat
        that as a failure. In comparison, std::strtoull() treats that just as a
        range error (and for -0 not even that) but for the UI feedback I feel it
        should be a more catastrophical failure. */
-    if(std::is_unsigned<T>::value && text.hasPrefix('-'))
+    if(std::is_unsigned<T>::value && negative)
         return ParseState::Failed;
 
-    /* Reset errno so we can detect an overflow below and attempt a parse. If
-       the text was non-empty (and not just whitespace) in the first place and
-       the parsing consumed it until the (potentially trimmed) end, we parsed
-       successfully. Worst case it may have overflown. */
-    errno = 0;
-    char* end{};
-    value = ParseTraits<T>::parser(text.begin(), &end, base);
-    if(text && end == text.end()) {
-        if(errno == ERANGE)
+    /* Hexadecimal values can have either a 0x / 0X or a # prefix, but not
+       both. Just the prefix alone with no digits after is an error. */
+    if(base == 16) {
+        if(end - i >= 2 && i[0] == '0' && (i[1] == 'x' || i[1] == 'X'))
+            i += 2;
+        else if(i != end && *i == '#')
+            ++i;
+    }
+
+    /* If the text was empty or there's no digits after the sign or prefix,
+       it's an error */
+    if(i == end)
+        return ParseState::Failed;
+
+    /* Parse all digits. If the value overflows, remember that but continue
+       to check that the rest is valid, as an invalid character anywhere is a
+       failure and not a clamp. */
+    UnsignedLong result = 0;
+    bool overflow = false;
+    for(; i != end; ++i) {
+        const UnsignedInt digit = parseDigit(*i);
+        if(digit >= base)
+            return ParseState::Failed;
+        if(result > (~UnsignedLong{} - digit)/base)
+            overflow = true;
+        else
+            result = result*base + digit;
+    }
+
+    /* For unsigned types the only possible clamped value is the max */
+    if(std::is_unsigned<T>::value) {
+        if(overflow) {
+            value = Math::TypeTraits<T>::max();
             return ParseState::Clamped;
-        CORRADE_INTERNAL_ASSERT(errno == 0);
+        }
+        value = result;
         return ParseState::Success;
     }
 
-    /* If the text was empty or the parsing didn't consume everything, it's an
-       error */
-    return ParseState::Failed;
+    /* For signed types the negative range is one larger than the positive */
+    const UnsignedLong limit = UnsignedLong(Math::TypeTraits<Long>::max()) + (negative ? 1 : 0);
+    if(overflow || result > limit) {
+        value = negative ? Math::TypeTraits<T>::min() : Math::TypeTraits<T>::max();
+        return ParseState::Clamped;
+    }
+    /* Negating the unsigned value instead of the signed one in order to
+       handle the min value, which doesn't have a positive counterpart. For
+       unsigned types this warns on MSVC ("warning C4146: unary minus operator
+       applied to unsigned type") even though the branch is never taken. */
+    #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
+    #pragma warning(push)
+    #pragma warning(disable: 4146)
+    #endif
+    value = negative ? T(-result) : T(result);
+    #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
+    #pragma warning(pop)
+    #endif
+    return ParseState::Success;
 }
 
-/* The 32-bit variants need to do extra bounds checks. It would be amazing if I
-   had access to PROPER 32-bit variants of std::strto*() as well, not just a
-   stupid `long` / `long long` distinction which in practice is useless. */
-ParseState parseInt(const Containers::StringView text, Int& value, const Int base) {
+/* The 32-bit variants need to do extra bounds checks */
+ParseState parseInt(const Containers::StringView text, Int& value, const UnsignedInt base) {
     /* Parse into a 64bit value first */
     Long parsedValue;
     const ParseState state = parseLong(text, parsedValue, base);
@@ -325,7 +334,7 @@ ParseState parseInt(const Containers::StringView text, Int& value, const Int bas
 
 /* Like above, but an unsigned case where the clamped value can be just one.
    Comments omitted for terseness. */
-ParseState parseInt(const Containers::StringView text, UnsignedInt& value, const Int base) {
+ParseState parseInt(const Containers::StringView text, UnsignedInt& value, const UnsignedInt base) {
     UnsignedLong parsedValue;
     const ParseState state = parseLong(text, parsedValue, base);
 
@@ -432,34 +441,342 @@ FloatFormatter& FloatFormatter::setPrecision(const Int precision) {
 
 namespace {
 
-/** @todo throw away all this once Corrade has standalone formatters */
-template<class> constexpr const char* decimalFormatString();
-template<> constexpr const char* decimalFormatString<UnsignedInt>() {
-    return "%.*u";
+/* The longest formatted values. For integers it's the largest possible
+   _minWidth value and a plus or minus, for hexadecimal values additionally a
+   prefix. For floats it's the largest possible digit count (309 digits for the
+   11-bit exponent in 64-bit doubles), a sign, a period and the max _precision
+   value. */
+constexpr std::size_t DecimalMaxSize = 255 + 1;
+constexpr std::size_t HexadecimalMaxSize = 255 + 1 + 2;
+constexpr std::size_t FloatMaxSize = 309 + 1 + 1 + 255;
+
+/* Formatting two decimal digits at a time halves the count of (relatively
+   expensive) divisions */
+constexpr char DecimalDigitPairs[]{
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"
+};
+
+/* Writes decimal digits of the value backwards, ending at `end`, and returns
+   a pointer to the first digit. Writes nothing for a zero value, which is
+   what's desired for a zero min width. The longest 64-bit value has 20
+   digits. */
+template<class T> char* formatDecimalDigitsBackwards(char* end, T value) {
+    while(value >= 100) {
+        const std::size_t pair = std::size_t(value % 100)*2;
+        value /= 100;
+        *--end = DecimalDigitPairs[pair + 1];
+        *--end = DecimalDigitPairs[pair];
+    }
+    if(value >= 10) {
+        *--end = DecimalDigitPairs[std::size_t(value)*2 + 1];
+        *--end = DecimalDigitPairs[std::size_t(value)*2];
+    } else if(value)
+        *--end = char('0' + value);
+    return end;
 }
-template<> constexpr const char* decimalFormatString<UnsignedLong>() {
-    return "%.*" PRIu64; /* how trash can we get, eh? */
+
+/* Like formatDecimalDigitsBackwards(), but hexadecimal. The longest 64-bit
+   value has 16 digits. */
+template<class T> char* formatHexadecimalDigitsBackwards(char* end, T value, const bool uppercase) {
+    const char* const digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+    for(; value; value >>= 4)
+        *--end = digits[value & 0xf];
+    return end;
 }
 
+/* Copies the digits to the output, padded with leading zeros to be at least
+   minWidth long, and returns the total size */
+std::size_t formatZeroPadded(char* const output, const char* const digits, const std::size_t size, const std::size_t minWidth) {
+    const std::size_t padding = minWidth > size ? minWidth - size : 0;
+    std::memset(output, '0', padding);
+    std::memcpy(output + padding, digits, size);
+    return padding + size;
 }
 
-template<class T> inline void DecimalFormatter::format(TextLayer& layer, const LayerDataHandle data, const T value) const {
-    /** @todo throw away all this once Corrade has standalone formatters */
-    /* The output size can be at most the largest possible _minWidth value,
-       a plus or minus, and a null terminator */
-    char output[255 + 1 + 1];
-    /* While we can use + in the format string to have an explict plus, this is
-       consistent with the hexadecimal case (where printf doesn't even support
-       negative numbers) */
+constexpr UnsignedLong PowersOf10[]{
+    1ull,
+    10ull,
+    100ull,
+    1000ull,
+    10000ull,
+    100000ull,
+    1000000ull,
+    10000000ull,
+    100000000ull,
+    1000000000ull,
+    10000000000ull,
+    100000000000ull,
+    1000000000000ull,
+    10000000000000ull,
+    100000000000000ull,
+    1000000000000000ull,
+    10000000000000000ull,
+    100000000000000000ull,
+    1000000000000000000ull,
+    10000000000000000000ull
+};
+
+/* Full 128-bit result of a 64-bit multiplication. Not using unsigned __int128
+   or _umul128() as neither is portable. */
+void multiply(const UnsignedLong a, const UnsignedLong b, UnsignedLong& high, UnsignedLong& low) {
+    const UnsignedLong aLow = a & 0xffffffffull, aHigh = a >> 32;
+    const UnsignedLong bLow = b & 0xffffffffull, bHigh = b >> 32;
+    const UnsignedLong lowLow = aLow*bLow;
+    const UnsignedLong lowHigh = aLow*bHigh;
+    const UnsignedLong highLow = aHigh*bLow;
+    const UnsignedLong middle = (lowLow >> 32) + (lowHigh & 0xffffffffull) + (highLow & 0xffffffffull);
+    low = (middle << 32)|(lowLow & 0xffffffffull);
+    high = aHigh*bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
+
+/* Calculates value*10^scale for a finite non-negative value and scale at most
+   19, rounded to an integer. The calculation is done on the exact binary
+   value, i.e. mantissa*10^scale/2^-exponent, and rounds half to even, which
+   is what printf() does as well. The mantissa has 53 bits and 10^19 has 64,
+   so the product always fits into 128 bits. Returns false if the result
+   doesn't fit into 64 bits. */
+bool formatScaleRound(const Double value, const UnsignedInt scale, UnsignedLong& out) {
+    UnsignedLong bits;
+    std::memcpy(&bits, &value, sizeof(Double));
+    const UnsignedInt biasedExponent = (bits >> 52) & 0x7ff;
+    UnsignedLong mantissa = bits & ((1ull << 52) - 1);
+    Int exponent;
+    if(biasedExponent) {
+        mantissa |= 1ull << 52;
+        exponent = Int(biasedExponent) - 1075;
+    /* Denormals */
+    } else exponent = -1074;
+
+    UnsignedLong high, low;
+    multiply(mantissa, PowersOf10[scale], high, low);
+
+    /* For a non-negative exponent the value is an integer already, it only
+       has to fit */
+    if(exponent >= 0) {
+        if(high || exponent >= 64 || (exponent && low >> (64 - exponent)))
+            return false;
+        out = low << exponent;
+        return true;
+    }
+
+    /* The product is less than 2^117, so shifting by 118 bits or more makes
+       it less than a half, which rounds to zero */
+    const UnsignedInt shift = -exponent;
+    if(shift >= 118) {
+        out = 0;
+        return true;
+    }
+
+    /* Split the product into a quotient and a remainder, and calculate what
+       a half is for given shift */
+    UnsignedLong quotientHigh, quotientLow, remainderHigh, remainderLow, halfHigh, halfLow;
+    if(shift < 64) {
+        quotientHigh = high >> shift;
+        quotientLow = (low >> shift)|(high << (64 - shift));
+        remainderHigh = 0;
+        remainderLow = low & ((1ull << shift) - 1);
+        halfHigh = 0;
+        halfLow = 1ull << (shift - 1);
+    } else if(shift == 64) {
+        quotientHigh = 0;
+        quotientLow = high;
+        remainderHigh = 0;
+        remainderLow = low;
+        halfHigh = 0;
+        halfLow = 1ull << 63;
+    } else {
+        quotientHigh = 0;
+        quotientLow = high >> (shift - 64);
+        remainderHigh = high & ((1ull << (shift - 64)) - 1);
+        remainderLow = low;
+        halfHigh = 1ull << (shift - 65);
+        halfLow = 0;
+    }
+    if(quotientHigh)
+        return false;
+
+    /* Round up if the remainder is more than a half, or exactly a half and
+       the quotient is odd */
+    if(remainderHigh > halfHigh || (remainderHigh == halfHigh && (remainderLow > halfLow || (remainderLow == halfLow && (quotientLow & 1))))) {
+        if(quotientLow == ~UnsignedLong{})
+            return false;
+        ++quotientLow;
+    }
+
+    out = quotientLow;
+    return true;
+}
+
+/* Formats an integer value with given count of its digits being after the
+   decimal point, i.e. the %f format */
+std::size_t formatFixed(char* const output, const UnsignedLong value, const UnsignedInt decimals) {
+    char digits[20];
+    char* const digitsEnd = digits + sizeof(digits);
+    const char* const digitsBegin = formatDecimalDigitsBackwards(digitsEnd, value);
+    /* There's always at least one digit before the decimal point */
+    std::size_t size = formatZeroPadded(output, digitsBegin, digitsEnd - digitsBegin, decimals + 1);
+    if(decimals) {
+        std::memmove(output + size - decimals + 1, output + size - decimals, decimals);
+        output[size - decimals] = '.';
+        ++size;
+    }
+    return size;
+}
+
+enum class FloatNotation {
+    General,    /* %g */
+    Decimal,    /* %f */
+    Exponent    /* %e */
+};
+
+/* MinGW prints the exponent with three decimals always, match that to not
+   have the output differ from the snprintf() fallback */
+#ifdef CORRADE_TARGET_MINGW
+constexpr std::size_t FloatExponentMinWidth = 3;
+#else
+constexpr std::size_t FloatExponentMinWidth = 2;
+#endif
+
+/* Formats a finite non-negative value without a sign, with output matching
+   printf(). Handles the cases where the significant digits can be calculated
+   with 64-bit integers, which is all common values with reasonable precision,
+   returns 0 otherwise. */
+std::size_t formatFloat(char* const output, const Double value, const FloatNotation notation, const UnsignedInt precision, const bool uppercase) {
+    /* In the decimal notation the precision is directly the count of digits
+       after the decimal point */
+    if(notation == FloatNotation::Decimal) {
+        UnsignedLong scaled;
+        if(precision > 19 || !formatScaleRound(value, precision, scaled))
+            return 0;
+        return formatFixed(output, scaled, precision);
+    }
+
+    /* In the exponent notation the precision is the count of digits after the
+       decimal point, in the general notation the count of significant digits,
+       with zero treated as one */
+    const UnsignedInt digitCount = notation == FloatNotation::Exponent ? precision + 1 : precision ? precision : 1;
+    if(digitCount > 19)
+        return 0;
+
+    /* Find the decimal exponent and the significant digits. The initial
+       estimate can be off by one, and the rounding can make the value have
+       one digit more, in which case the exponent is adjusted and the digits
+       recalculated. A zero value has a zero exponent. */
+    Int exponent = 0;
+    UnsignedLong scaled = 0;
+    if(value != 0.0) {
+        exponent = Int(std::floor(std::log10(value)));
+        for(Int i = 0; ; ++i) {
+            const Int scale = Int(digitCount) - 1 - exponent;
+            if(i == 3 || scale < 0 || scale > 19 || !formatScaleRound(value, scale, scaled))
+                return 0;
+            if(scaled >= PowersOf10[digitCount])
+                ++exponent;
+            else if(scaled < PowersOf10[digitCount - 1])
+                --exponent;
+            else break;
+        }
+    }
+
+    /* The general notation uses the exponent form only for very small values
+       and values that have more integer digits than the precision, in which
+       case it has trailing zeros removed */
+    std::size_t size;
+    if(notation == FloatNotation::Exponent || exponent < -4 || exponent >= Int(digitCount)) {
+        char digits[20];
+        char* const digitsEnd = digits + sizeof(digits);
+        const char* const digitsBegin = formatDecimalDigitsBackwards(digitsEnd, scaled);
+        /* Zero is formatted as no digits, pad it */
+        formatZeroPadded(output, digitsBegin, digitsEnd - digitsBegin, digitCount);
+
+        char* const fraction = output + 1;
+        std::size_t fractionSize = digitCount - 1;
+        if(notation == FloatNotation::General)
+            while(fractionSize && fraction[fractionSize - 1] == '0')
+                --fractionSize;
+        if(fractionSize) {
+            std::memmove(fraction + 1, fraction, fractionSize);
+            fraction[0] = '.';
+            size = 2 + fractionSize;
+        } else size = 1;
+
+        output[size++] = uppercase ? 'E' : 'e';
+        output[size++] = exponent < 0 ? '-' : '+';
+        char exponentDigits[3];
+        char* const exponentDigitsEnd = exponentDigits + sizeof(exponentDigits);
+        const char* const exponentDigitsBegin = formatDecimalDigitsBackwards(exponentDigitsEnd, UnsignedInt(exponent < 0 ? -exponent : exponent));
+        size += formatZeroPadded(output + size, exponentDigitsBegin, exponentDigitsEnd - exponentDigitsBegin, FloatExponentMinWidth);
+
+    } else {
+        const UnsignedInt decimals = digitCount - 1 - exponent;
+        size = formatFixed(output, scaled, decimals);
+        if(notation == FloatNotation::General && decimals) {
+            while(output[size - 1] == '0')
+                --size;
+            if(output[size - 1] == '.')
+                --size;
+        }
+    }
+
+    return size;
+}
+
+/* Common implementation of the batch formatInto() variants. The `maxSize` is
+   the space needed by `format` to produce any value, if the remaining space in
+   the buffer is smaller, the value is formatted into a temporary and then
+   copied. */
+template<std::size_t maxSize, class T, class F> std::size_t formatBatchInto(
+    #ifndef CORRADE_NO_ASSERT
+    const char* const messagePrefix,
+    #endif
+    const F& format, const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets
+) {
+    CORRADE_ASSERT(offsets.size() == values.size() + 1,
+        messagePrefix << "expected" << values.size() + 1 << "offsets for" << values.size() << "values but got" << offsets.size(), {});
+
+    char* const data = buffer.data();
+    std::size_t offset = 0;
+    for(std::size_t i = 0; i != values.size(); ++i) {
+        offsets[i] = offset;
+        if(buffer.size() - offset >= maxSize) {
+            offset += format(data + offset, values[i]);
+            continue;
+        }
+
+        char output[maxSize];
+        const std::size_t size = format(output, values[i]);
+        CORRADE_ASSERT(size <= buffer.size() - offset,
+            messagePrefix << "expected a buffer with at least" << offset + size << "bytes to fit value" << i << "but got" << buffer.size(), {});
+        std::memcpy(data + offset, output, size);
+        offset += size;
+    }
+
+    offsets[values.size()] = offset;
+    return offset;
+}
+
+}
+
+template<class T> std::size_t DecimalFormatter::formatInternal(char* const output, const T value) const {
+    /* The explicit plus is handled here for consistency with the hexadecimal
+       case */
     typename std::make_unsigned<T>::type unsignedValue;
-    std::size_t begin = 0;
+    std::size_t size = 0;
     if(value < 0) {
-        /* Interestingly enough this *does* seem to correctly handle
-           -0x80000000 (and the corresponding 64-bit value), producing
-           0x80000000 even though it doesn't fit into a signed type. For
-           unsigned types this warns on MSVC ("warning C4146: unary minus
-           operator applied to unsigned type") because ugh stupid thing. Yeah
-           yeah if constexpr would solve this etc etc. I know. */
+        /* This correctly handles -0x80000000 (and the corresponding 64-bit
+           value), producing 0x80000000 even though it doesn't fit into a
+           signed type. For unsigned types this warns on MSVC ("warning C4146:
+           unary minus operator applied to unsigned type") because ugh stupid
+           thing. Yeah yeah if constexpr would solve this etc etc. I know. */
         #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
         #pragma warning(push)
         #pragma warning(disable: 4146)
@@ -468,17 +785,81 @@ template<class T> inline void DecimalFormatter::format(TextLayer& layer, const L
         #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
         #pragma warning(pop)
         #endif
-        output[begin++] = '-';
+        output[size++] = '-';
     } else {
         unsignedValue = value;
         /* If the value is zero and min width is zero, nothing should be
            printed even with ExplicitPlus */
         if(_flags >= Flag::ExplicitPlus && (value || _minWidth))
-            output[begin++] = '+';
+            output[size++] = '+';
     }
-    const std::size_t size = begin + std::snprintf(output + begin, Containers::arraySize(output) - begin, decimalFormatString<typename std::make_unsigned<T>::type>(), Int(_minWidth), unsignedValue);
-    CORRADE_INTERNAL_ASSERT(size < Containers::arraySize(output));
-    layer.setText(data, {output, size}, {});
+
+    char digits[20];
+    char* const digitsEnd = digits + sizeof(digits);
+    const char* const digitsBegin = formatDecimalDigitsBackwards(digitsEnd, unsignedValue);
+    size += formatZeroPadded(output + size, digitsBegin, digitsEnd - digitsBegin, _minWidth);
+    CORRADE_INTERNAL_DEBUG_ASSERT(size <= DecimalMaxSize);
+    return size;
+}
+
+template<class T> inline void DecimalFormatter::format(TextLayer& layer, const LayerDataHandle data, const T value) const {
+    char output[DecimalMaxSize];
+    layer.setText(data, {output, formatInternal(output, value)}, {});
+}
+
+template<class T> std::size_t DecimalFormatter::formatIntoInternal(const Containers::MutableStringView buffer, const T value) const {
+    /* If the buffer is large enough for any value, format directly into it */
+    if(buffer.size() >= DecimalMaxSize)
+        return formatInternal(buffer.data(), value);
+
+    char output[DecimalMaxSize];
+    const std::size_t size = formatInternal(output, value);
+    CORRADE_ASSERT(size <= buffer.size(),
+        "Ui::DecimalFormatter::formatInto(): expected a buffer with at least" << size << "bytes but got" << buffer.size(), {});
+    std::memcpy(buffer.data(), output, size);
+    return size;
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Int value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const UnsignedInt value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Long value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const UnsignedLong value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+template<class T> std::size_t DecimalFormatter::formatIntoInternal(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatBatchInto<DecimalMaxSize>(
+        #ifndef CORRADE_NO_ASSERT
+        "Ui::DecimalFormatter::formatInto():",
+        #endif
+        [this](char* const output, const T value) {
+            return formatInternal(output, value);
+        }, buffer, values, offsets);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Int>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedInt>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Long>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t DecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedLong>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
 }
 
 void DecimalFormatter::operator()(TextLayer& layer, const DataHandle data, const Int value) const {
@@ -529,36 +910,13 @@ void DecimalFormatter::operator()(TextLayer& layer, const LayerDataHandle data,
     format(layer, data, value);
 }
 
-namespace {
-
-/** @todo throw away all this once Corrade has standalone formatters */
-template<class> constexpr const char* hexadecimalFormatString(bool);
-template<> constexpr const char* hexadecimalFormatString<UnsignedInt>(bool uppercase) {
-    return uppercase ? "%.*X" : "%.*x";
-}
-template<> constexpr const char* hexadecimalFormatString<UnsignedLong>(bool uppercase) {
-    return uppercase ? "%.*llX" : "%.*llx";
-}
-
-}
-
-template<class T> void HexadecimalFormatter::format(TextLayer& layer, const LayerDataHandle data, const T value) const {
-    /** @todo throw away all this once Corrade has standalone formatters */
-    /* The output size can be at most the largest possible _minWidth value,
-       a plus or minus, a prefix, and a null terminator */
-    char output[255 + 1 + 2 + 1];
-    /* While we can use + in the format string to have an explict plus, it
-       doesn't when prefix is involved, and as printf doesn't support signed
-       hexadecimal numbers we'd have to handle - explicitly anyway */
+template<class T> std::size_t HexadecimalFormatter::formatInternal(char* const output, const T value) const {
+    /* printf() doesn't support signed hexadecimal numbers and doesn't put the
+       explicit plus before the prefix, so the sign is handled explicitly */
     typename std::make_unsigned<T>::type unsignedValue;
-    std::size_t begin = 0;
+    std::size_t size = 0;
     if(value < 0) {
-        /* Interestingly enough this *does* seem to correctly handle
-           -0x80000000 (and the corresponding 64-bit value), producing
-           0x80000000 even though it doesn't fit into a signed type. For
-           unsigned types this warns on MSVC ("warning C4146: unary minus
-           operator applied to unsigned type") because ugh stupid thing. Yeah
-           yeah if constexpr would solve this etc etc. I know. */
+        /* Same as in DecimalFormatter::formatInternal() */
         #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
         #pragma warning(push)
         #pragma warning(disable: 4146)
@@ -567,27 +925,91 @@ template<class T> void HexadecimalFormatter::format(TextLayer& layer, const Laye
         #if defined(CORRADE_TARGET_MSVC) && !defined(CORRADE_TARGET_CLANG_CL)
         #pragma warning(pop)
         #endif
-        output[begin++] = '-';
+        output[size++] = '-';
     } else {
         unsignedValue = value;
         /* If the value is zero and min width is zero, nothing should be
            printed even with ExplicitPlus */
         if(_flags >= Flag::ExplicitPlus && (value || _minWidth))
-            output[begin++] = '+';
+            output[size++] = '+';
     }
     /* If the value is zero and min width is zero, nothing should be printed
        even with BasePrefix / HashPrefix */
     if(value || _minWidth) {
         if(_flags >= Flag::HashPrefix)
-            output[begin++] = '#';
+            output[size++] = '#';
         else if(_flags >= Flag::BasePrefix) {
-            output[begin++] = '0';
-            output[begin++] = _flags >= Flag::Uppercase ? 'X' : 'x';
+            output[size++] = '0';
+            output[size++] = _flags >= Flag::Uppercase ? 'X' : 'x';
         }
     }
-    const std::size_t size = begin + std::snprintf(output + begin, Containers::arraySize(output) - begin, hexadecimalFormatString<typename std::make_unsigned<T>::type>(_flags >= Flag::Uppercase), Int(_minWidth), unsignedValue);
-    CORRADE_INTERNAL_ASSERT(size < Containers::arraySize(output));
-    layer.setText(data, {output, size}, {});
+
+    char digits[16];
+    char* const digitsEnd = digits + sizeof(digits);
+    const char* const digitsBegin = formatHexadecimalDigitsBackwards(digitsEnd, unsignedValue, _flags >= Flag::Uppercase);
+    size += formatZeroPadded(output + size, digitsBegin, digitsEnd - digitsBegin, _minWidth);
+    CORRADE_INTERNAL_DEBUG_ASSERT(size <= HexadecimalMaxSize);
+    return size;
+}
+
+template<class T> void HexadecimalFormatter::format(TextLayer& layer, const LayerDataHandle data, const T value) const {
+    char output[HexadecimalMaxSize];
+    layer.setText(data, {output, formatInternal(output, value)}, {});
+}
+
+template<class T> std::size_t HexadecimalFormatter::formatIntoInternal(const Containers::MutableStringView buffer, const T value) const {
+    /* Same as in DecimalFormatter::formatIntoInternal() */
+    if(buffer.size() >= HexadecimalMaxSize)
+        return formatInternal(buffer.data(), value);
+
+    char output[HexadecimalMaxSize];
+    const std::size_t size = formatInternal(output, value);
+    CORRADE_ASSERT(size <= buffer.size(),
+        "Ui::HexadecimalFormatter::formatInto(): expected a buffer with at least" << size << "bytes but got" << buffer.size(), {});
+    std::memcpy(buffer.data(), output, size);
+    return size;
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Int value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const UnsignedInt value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Long value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const UnsignedLong value) const {
+    return formatIntoInternal(buffer, value);
+}
+
+template<class T> std::size_t HexadecimalFormatter::formatIntoInternal(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatBatchInto<HexadecimalMaxSize>(
+        #ifndef CORRADE_NO_ASSERT
+        "Ui::HexadecimalFormatter::formatInto():",
+        #endif
+        [this](char* const output, const T value) {
+            return formatInternal(output, value);
+        }, buffer, values, offsets);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Int>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedInt>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Long>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t HexadecimalFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedLong>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
 }
 
 void HexadecimalFormatter::operator()(TextLayer& layer, const DataHandle data, const Int value) const {
@@ -638,44 +1060,107 @@ void HexadecimalFormatter::operator()(TextLayer& layer, const LayerDataHandle da
     format(layer, data, value);
 }
 
-void FloatFormatter::format(TextLayer& layer, const LayerDataHandle data, const Double value) const {
-    /** @todo throw away all this once Corrade has standalone formatters */
-    /* Format string. Either "%.*S" or "%+.*S", where `S` is picked below.
-       Compared to DecimalFormatter / HexadecimalFormatter here printf() itself
-       is tasked with formatting the explicit plus because we have no special
-       cases to deal with. */
+std::size_t FloatFormatter::formatInternal(char* const output, const Double value) const {
+    /* If neither decimal or exponent printing is forced (or both are, which is
+       the same), use the general notation */
+    FloatNotation notation;
+    if(!(_flags & (Flag::Decimal|Flag::Exponent)) ||
+        _flags >= (Flag::Decimal|Flag::Exponent))
+        notation = FloatNotation::General;
+    else if(_flags >= Flag::Decimal)
+        notation = FloatNotation::Decimal;
+    else if(_flags >= Flag::Exponent)
+        notation = FloatNotation::Exponent;
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    /* Finite values are formatted directly if possible. The sign is printed
+       also for a negative zero, same as printf() does. */
+    if(std::isfinite(value)) {
+        std::size_t size = 0;
+        if(std::signbit(value))
+            output[size++] = '-';
+        else if(_flags >= Flag::ExplicitPlus)
+            output[size++] = '+';
+        if(const std::size_t valueSize = formatFloat(output + size, std::abs(value), notation, _precision, _flags >= Flag::Uppercase))
+            return size + valueSize;
+    }
+
+    /* Otherwise, such as for infinities, NaNs, huge values or huge precision,
+       delegate to printf(), with a format string that's either "%.*S" or
+       "%+.*S", where `S` is picked below. Compared to DecimalFormatter /
+       HexadecimalFormatter here printf() itself is tasked with formatting the
+       explicit plus because we have no special cases to deal with. */
+    /** @todo throw away once the above handles all cases */
     char formatString[6]{'%', 0, 0, 0, 0, 0};
     std::size_t formatStringBegin = 1;
     if(_flags >= Flag::ExplicitPlus)
         formatString[formatStringBegin++] = '+';
     formatString[formatStringBegin++] = '.';
     formatString[formatStringBegin++] = '*';
-
-    /* If neither decimal or exponent printing is forced (or both are, which is
-       the same), use the general printer */
-    if(!(_flags & (Flag::Decimal|Flag::Exponent)) ||
-        _flags >= (Flag::Decimal|Flag::Exponent))
+    if(notation == FloatNotation::General)
         formatString[formatStringBegin++] = _flags >= Flag::Uppercase ? 'G' : 'g';
-    else if(_flags >= Flag::Decimal)
+    else if(notation == FloatNotation::Decimal)
         formatString[formatStringBegin++] = _flags >= Flag::Uppercase ? 'F' : 'f';
-    else if(_flags >= Flag::Exponent)
+    else if(notation == FloatNotation::Exponent)
         formatString[formatStringBegin++] = _flags >= Flag::Uppercase ? 'E' : 'e';
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-    /* The output size can be at most the largest possible digit count (309
-       digits for the 11-bit exponent in 64-bit doubles), a sign, a period,
-       the max _precision value and a null terminator */
-    char output[309 + 1 + 1 + 255 + 1];
-    const std::size_t size = std::snprintf(output, Containers::arraySize(output), formatString, Int(_precision), value);
-    CORRADE_INTERNAL_ASSERT(size < Containers::arraySize(output));
-    layer.setText(data, {output, size}, {});
+    /* The output is expected to have space for a null terminator as well */
+    const std::size_t size = std::snprintf(output, FloatMaxSize + 1, formatString, Int(_precision), value);
+    CORRADE_INTERNAL_ASSERT(size <= FloatMaxSize);
+    return size;
+}
+
+void FloatFormatter::format(TextLayer& layer, const LayerDataHandle data, const Double value) const {
+    char output[FloatMaxSize + 1];
+    layer.setText(data, {output, formatInternal(output, value)}, {});
+}
+
+std::size_t FloatFormatter::formatInto(const Containers::MutableStringView buffer, const Double value) const {
+    /* Same as in DecimalFormatter::formatIntoInternal(), with the extra byte
+       for the null terminator written by the snprintf() fallback */
+    if(buffer.size() >= FloatMaxSize + 1)
+        return formatInternal(buffer.data(), value);
+
+    char output[FloatMaxSize + 1];
+    const std::size_t size = formatInternal(output, value);
+    CORRADE_ASSERT(size <= buffer.size(),
+        "Ui::FloatFormatter::formatInto(): expected a buffer with at least" << size << "bytes but got" << buffer.size(), {});
+    std::memcpy(buffer.data(), output, size);
+    return size;
+}
+
+std::size_t FloatFormatter::formatInto(const Containers::MutableStringView buffer, const Float value) const {
+    /** @todo stop delegating to Double once there's a dedicated code path for
+        float printing (with smaller LUTs and such) */
+    return formatInto(buffer, Double(value));
+}
+
+template<class T> std::size_t FloatFormatter::formatIntoInternal(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    /* Extra byte for the null terminator written by the snprintf() fallback,
+       same as in formatInto() above */
+    return formatBatchInto<FloatMaxSize + 1>(
+        #ifndef CORRADE_NO_ASSERT
+        "Ui::FloatFormatter::formatInto():",
+        #endif
+        [this](char* const output, const T value) {
+            return formatInternal(output, value);
+        }, buffer, values, offsets);
+}
+
+std::size_t FloatFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Float>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
+}
+
+std::size_t FloatFormatter::formatInto(const Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Double>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const {
+    return formatIntoInternal(buffer, values, offsets);
 }
 
 void FloatFormatter::operator()(TextLayer& layer, const DataHandle data, const Float value) const {
     CORRADE_ASSERT(layer.isHandleValid(data),
         "Ui::FloatFormatter: invalid handle" << data, );
     /** @todo stop delegating to Double once there's a dedicated code path for
-        float printing (with smaller LUTs and such), printf doesn't do that */
+        float printing (with smaller LUTs and such) */
     return format(layer, dataHandleData(data), Double(value));
 }
 
@@ -695,7 +1180,7 @@ void FloatFormatter::operator()(TextLayer& layer, const LayerDataHandle data, co
     CORRADE_ASSERT(layer.isHandleValid(data),
         "Ui::FloatFormatter: invalid handle" << data, );
     /** @todo stop delegating to Double once there's a dedicated code path for
-        float printing (with smaller LUTs and such), printf doesn't do that */
+        float printing (with smaller LUTs and such) */
     return format(layer, data, Double(value));
 }
 
@@ -228,8 +228,59 @@ class MAGNUM_UI_EXPORT DecimalFormatter {
         /** @overload */
         void operator()(TextLayer& layer, LayerDataHandle data, UnsignedLong value) const;
 
+        /**
+         * @brief Format a value into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Produces the same output as @ref operator()(TextLayer&, DataHandle, Int) const
+         * but writes it into @p buffer instead of passing it to a
+         * @ref TextLayer. The output isn't null-terminated, returns its size
+         * in bytes. Expects that @p buffer is large enough to fit the output.
+         * The output is never longer than @cpp 256 @ce bytes, i.e. the max
+         * @ref setMinWidth() and a sign, so a buffer of that size is always
+         * sufficient. Doesn't allocate and doesn't use
+         * @cpp std::snprintf() @ce internally, making it suitable for
+         * formatting large amounts of values into a single memory location.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, Int value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, UnsignedInt value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, Long value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, UnsignedLong value) const;
+
+        /**
+         * @brief Format a list of values into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Formats all @p values one after another into @p buffer, each with
+         * the same output as @ref formatInto(Containers::MutableStringView, Int) const.
+         * Expects that @p offsets has one item more than @p values. The
+         * @cpp i @ce-th value is then the @cpp offsets[i] @ce to
+         * @cpp offsets[i + 1] @ce range of @p buffer and the last item of
+         * @p offsets, which is also returned, is the total output size.
+         * Expects that @p buffer is large enough to fit the output,
+         * @cpp 256 @ce bytes times the value count is always sufficient.
+         *
+         * Compared to formatting each value separately, this allows a whole
+         * column of values to be formatted in a single pass without any
+         * per-value allocation, with the resulting slices passed to
+         * @ref TextLayer::setText() or used in any other way.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Int>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedInt>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Long>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedLong>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+
     private:
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatInternal(char* output, T value) const;
         template<class T> MAGNUM_UI_LOCAL void format(TextLayer& layer, LayerDataHandle data, T value) const;
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatIntoInternal(Containers::MutableStringView buffer, T value) const;
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatIntoInternal(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
 
         Flags _flags;
         UnsignedByte _minWidth;
@@ -424,8 +475,59 @@ class MAGNUM_UI_EXPORT HexadecimalFormatter {
         /** @overload */
         void operator()(TextLayer& layer, LayerDataHandle data, UnsignedLong value) const;
 
+        /**
+         * @brief Format a value into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Produces the same output as @ref operator()(TextLayer&, DataHandle, Int) const
+         * but writes it into @p buffer instead of passing it to a
+         * @ref TextLayer. The output isn't null-terminated, returns its size
+         * in bytes. Expects that @p buffer is large enough to fit the output.
+         * The output is never longer than @cpp 258 @ce bytes, i.e. the max
+         * @ref setMinWidth(), a sign and a base prefix, so a buffer of that
+         * size is always sufficient. Doesn't allocate and doesn't use
+         * @cpp std::snprintf() @ce internally, making it suitable for
+         * formatting large amounts of values into a single memory location.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, Int value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, UnsignedInt value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, Long value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, UnsignedLong value) const;
+
+        /**
+         * @brief Format a list of values into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Formats all @p values one after another into @p buffer, each with
+         * the same output as @ref formatInto(Containers::MutableStringView, Int) const.
+         * Expects that @p offsets has one item more than @p values. The
+         * @cpp i @ce-th value is then the @cpp offsets[i] @ce to
+         * @cpp offsets[i + 1] @ce range of @p buffer and the last item of
+         * @p offsets, which is also returned, is the total output size.
+         * Expects that @p buffer is large enough to fit the output,
+         * @cpp 258 @ce bytes times the value count is always sufficient.
+         *
+         * Compared to formatting each value separately, this allows a whole
+         * column of values to be formatted in a single pass without any
+         * per-value allocation, with the resulting slices passed to
+         * @ref TextLayer::setText() or used in any other way.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Int>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedInt>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Long>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const UnsignedLong>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+
     private:
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatInternal(char* output, T value) const;
         template<class T> MAGNUM_UI_LOCAL void format(TextLayer& layer, LayerDataHandle data, T value) const;
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatIntoInternal(Containers::MutableStringView buffer, T value) const;
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatIntoInternal(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
 
         Flags _flags;
         UnsignedByte _minWidth;
@@ -622,8 +724,56 @@ class MAGNUM_UI_EXPORT FloatFormatter {
         /** @overload */
         void operator()(TextLayer& layer, LayerDataHandle data, Double value) const;
 
+        /**
+         * @brief Format a value into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Produces the same output as @ref operator()(TextLayer&, DataHandle, Float) const
+         * but writes it into @p buffer instead of passing it to a
+         * @ref TextLayer. The output isn't null-terminated, returns its size
+         * in bytes. Expects that @p buffer is large enough to fit the output.
+         * The output is never longer than @cpp 566 @ce bytes, i.e. the
+         * longest integral part of a @relativeref{Magnum,Double}, a sign, a
+         * period and the max @ref setPrecision(), so a buffer of that size
+         * is always sufficient.
+         *
+         * Doesn't allocate. Values with up to 19 significant digits, which
+         * includes the default @ref precision(), are formatted without using
+         * @cpp std::snprintf() @ce, which makes it suitable for formatting
+         * large amounts of values into a single memory location. Other values
+         * fall back to @cpp std::snprintf() @ce, in which case the output is
+         * the same but the formatting is slower.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, Float value) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, Double value) const;
+
+        /**
+         * @brief Format a list of values into a buffer
+         * @m_since_latest_{extras}
+         *
+         * Formats all @p values one after another into @p buffer, each with
+         * the same output as @ref formatInto(Containers::MutableStringView, Float) const.
+         * Expects that @p offsets has one item more than @p values. The
+         * @cpp i @ce-th value is then the @cpp offsets[i] @ce to
+         * @cpp offsets[i + 1] @ce range of @p buffer and the last item of
+         * @p offsets, which is also returned, is the total output size.
+         * Expects that @p buffer is large enough to fit the output,
+         * @cpp 566 @ce bytes times the value count is always sufficient.
+         *
+         * Compared to formatting each value separately, this allows a whole
+         * column of values to be formatted in a single pass without any
+         * per-value allocation, with the resulting slices passed to
+         * @ref TextLayer::setText() or used in any other way.
+         */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Float>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+        /** @overload */
+        std::size_t formatInto(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const Double>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
+
     private:
+        MAGNUM_UI_LOCAL std::size_t formatInternal(char* output, Double value) const;
         MAGNUM_UI_LOCAL void format(TextLayer& layer, LayerDataHandle data, Double value) const;
+        template<class T> MAGNUM_UI_LOCAL std::size_t formatIntoInternal(Containers::MutableStringView buffer, const Containers::StridedArrayView1D<const T>& values, const Containers::StridedArrayView1D<UnsignedInt>& offsets) const;
 
         Flags _flags;
         UnsignedByte _precision;
@@ -87,6 +87,54 @@ BlurShaderGL: public GL::AbstractShaderProgram {
             _directionUniform = 1;
 };
 
+/* Used by BaseLayerSharedFlag::BackgroundBlurDualFilter, the constructor is
+   again implemented in BaseLayerGL.cpp */
+class
+/* Exported only for tests (which have graceful assert enabled) */
+#ifdef CORRADE_GRACEFUL_ASSERT
+MAGNUM_UI_EXPORT
+#endif
+DualFilterBlurShaderGL: public GL::AbstractShaderProgram {
+    private:
+        enum: Int {
+            /* Same as BlurShaderGL::TextureBinding */
+            TextureBinding = 6
+        };
+
+    public:
+        typedef GL::Attribute<0, Vector2> Position;
+
+        enum class Mode {
+            Downsample,
+            Upsample
+        };
+
+        explicit DualFilterBlurShaderGL(NoCreateT): GL::AbstractShaderProgram{NoCreate} {}
+        explicit DualFilterBlurShaderGL(Mode mode);
+
+        DualFilterBlurShaderGL& setProjection(const Vector2& scaling) {
+            /* Same as BlurShaderGL::setProjection() */
+            setUniform(_projectionUniform, Vector2{2.0f, -2.0f}/scaling);
+            return *this;
+        }
+
+        /* Half-texel of the lower-resolution texture in the downsample /
+           upsample pair, scaled by the desired spread */
+        DualFilterBlurShaderGL& setOffset(const Vector2& offset) {
+            setUniform(_offsetUniform, offset);
+            return *this;
+        }
+
+        DualFilterBlurShaderGL& bindTexture(GL::Texture2D& texture) {
+            texture.bind(TextureBinding);
+            return *this;
+        }
+
+    private:
+        Int _projectionUniform = 0,
+            _offsetUniform = 1;
+};
+
 }}
 
 #endif
@@ -31,7 +31,9 @@
    header gets published) eventually possibly also 3rd party renderer
    implementations */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/BitArray.h>
 #include <Corrade/Containers/BitArrayView.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StridedArrayView.h>
@@ -42,6 +44,21 @@ namespace Magnum { namespace Ui {
 
 namespace Implementation {
     constexpr UnsignedInt styleTransitionPassthrough(UnsignedInt index) { return index; }
+
+    /* Index into AbstractVisualLayer::Shared::State::styleTransitions and
+       styleTransitionTables */
+    enum class StyleTransition: UnsignedByte {
+        ToInactiveOut,
+        ToInactiveOver,
+        ToFocusedOut,
+        ToFocusedOver,
+        ToPressedOut,
+        ToPressedOver,
+        ToDisabled,
+        /* Not an index, keeps the style unchanged. Used by the explicit
+           transitionStyle() for data not attached to any node. */
+        None
+    };
 }
 
 struct AbstractVisualLayer::Shared::State {
@@ -64,16 +81,35 @@ struct AbstractVisualLayer::Shared::State {
        similar APIs. Gets updated when the Shared instance itself is moved. */
     Containers::Reference<Shared> self;
 
+    /* Performs given transition, using the table if present and calling the
+       function otherwise. Expects that `style` is less than styleCount and
+       that the transition isn't ToDisabled with neither a function nor a
+       table set. */
+    UnsignedInt transitionStyle(Implementation::StyleTransition transition, UnsignedInt style) const {
+        if(transition == Implementation::StyleTransition::None)
+            return style;
+        const Containers::ArrayView<const UnsignedInt> table = styleTransitionTables[UnsignedInt(transition)];
+        return table.isEmpty() ? styleTransitions[UnsignedInt(transition)](style) : table[style];
+    }
+
     UnsignedInt styleCount, dynamicStyleCount;
-    UnsignedInt(*styleTransitionToInactiveOut)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    UnsignedInt(*styleTransitionToInactiveOver)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    UnsignedInt(*styleTransitionToFocusedOut)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    UnsignedInt(*styleTransitionToFocusedOver)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    UnsignedInt(*styleTransitionToPressedOut)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    UnsignedInt(*styleTransitionToPressedOver)(UnsignedInt) = Implementation::styleTransitionPassthrough;
-    /* Unlike the others, this one can be nullptr, in which case the whole
-       logic in doUpdate() gets skipped */
-    UnsignedInt(*styleTransitionToDisabled)(UnsignedInt) = nullptr;
+    /* Indexed by Implementation::StyleTransition. Unlike the others, the
+       ToDisabled one can be nullptr, in which case the whole logic in
+       doUpdate() gets skipped, unless there's a table for it. */
+    UnsignedInt(*styleTransitions[7])(UnsignedInt){
+        Implementation::styleTransitionPassthrough,
+        Implementation::styleTransitionPassthrough,
+        Implementation::styleTransitionPassthrough,
+        Implementation::styleTransitionPassthrough,
+        Implementation::styleTransitionPassthrough,
+        Implementation::styleTransitionPassthrough,
+        nullptr
+    };
+    /* Indexed by Implementation::StyleTransition, each either empty or having
+       styleCount items, pointing into styleTransitionTableStorage. If
+       non-empty, used instead of the corresponding function. */
+    Containers::ArrayView<const UnsignedInt> styleTransitionTables[7];
+    Containers::Array<UnsignedInt> styleTransitionTableStorage;
 
     /* Unlike transitions above, these are simply not used if nullptr */
     AnimationHandle(*styleAnimationOnEnter)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle) = nullptr;
@@ -85,8 +121,9 @@ struct AbstractVisualLayer::Shared::State {
     AnimationHandle(*styleAnimationOnTransition)(AbstractVisualLayerStyleAnimator&, UnsignedInt, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle) = nullptr;
     AnimationHandle(*styleAnimationPersistent)(AbstractVisualLayerStyleAnimator&, UnsignedInt, Nanoseconds, LayerDataHandle, AnimatorDataHandle) = nullptr;
 
-    /* Incremented every time the styleTransitionToDisabled pointer is changed.
-       There's a corresponding styleTransitionToDisabledUpdateStamp variable in
+    /* Incremented every time the ToDisabled style transition function or
+       table is changed. There's a corresponding
+       styleTransitionToDisabledUpdateStamp variable in
        AbstractVisualLayer::State that doState() compares to this one,
        returning LayerState::NeedsDataUpdate if it differs. */
     UnsignedShort styleTransitionToDisabledUpdateStamp = 0;
@@ -109,17 +146,38 @@ struct AbstractVisualLayer::State {
         that */
     virtual ~State() = default;
 
-    /* Has bits set for dynamic styles that are used */
+    /* Has bits set for dynamic styles that are used, 64 styles per word.
+       Padding bits past dynamicStyleCount in the last word are always set so
+       the allocation doesn't need to special-case them. Stored as whole words
+       instead of a BitArrayView in order to skip fully used words and find
+       the first free bit in a single instruction. */
     /** @todo the allocation could be shared with subclass data */
     Containers::ArrayTuple dynamicStyleStorage;
-    Containers::MutableBitArrayView dynamicStylesUsed;
+    Containers::ArrayView<UnsignedLong> dynamicStylesUsed;
     Containers::ArrayView<AnimationHandle> dynamicStyleAnimations;
+    /* Count of bits set in dynamicStylesUsed, excluding the padding */
+    UnsignedInt dynamicStyleUsedCount = 0;
+    /* All words before this one are known to be fully used. Equal to the
+       dynamicStylesUsed size if all dynamic styles are used. */
+    UnsignedInt dynamicStyleFirstFreeWord = 0;
 
     /* These views are assumed to point to subclass own data and maintained to
        have its size always match layer capacity. The `calculatedStyles` are a
        copy of `styles` with additional transitions applied for disabled
        nodes, which is performed in the layer doUpdate(). */
     Containers::StridedArrayView1D<UnsignedInt> styles, calculatedStyles;
+    /* Enabled state of nodes at the time the `calculatedStyles` were last
+       calculated in doUpdate(), indexed by node ID. Used to perform the
+       disabled style transition only for data attached to nodes whose enabled
+       state changed since. Only bits for nodes the visible data are attached
+       to are updated, the rest is stale. Empty initially, sized to node
+       capacity once first needed. */
+    Containers::BitArray previousNodesEnabled;
+    /* Data marked with setNeedsDataUpdate(), indexed by data ID. Reset when
+       the first data is marked after an update, sized to layer capacity.
+       Empty initially. If `updateDirtyDataOnly` below is set, the subclass
+       doUpdate() regenerates just these instead of all data. */
+    Containers::BitArray dirtyData;
     /* 99% of internal accesses to the Shared instance need the State struct,
        so saving it directly to avoid an extra indirection, In some cases the
        public API reference is needed (mainly for user-side access, such as
@@ -146,7 +204,15 @@ struct AbstractVisualLayer::State {
        expanded to 32 bits. */
     UnsignedShort styleTransitionToDisabledUpdateStamp;
 
-    /* 2/6 bytes free used by the derived structs */
+    /* Set by setNeedsDataUpdate() if no data update was pending before,
+       cleared by setNeedsUpdate() with LayerState::NeedsDataUpdate and in
+       doUpdate(). There, if it was set and doState() doesn't report a data
+       update caused by shared state changes, `updateDirtyDataOnly` is set
+       for the subclass doUpdate() to use. */
+    bool dirtyDataOnly = false;
+    bool updateDirtyDataOnly = false;
+
+    /* 0/4 bytes free used by the derived structs */
 };
 
 }}
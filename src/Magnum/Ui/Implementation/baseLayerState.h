@@ -34,6 +34,7 @@
 
 #include "Magnum/Ui/BaseLayer.h"
 #include "Magnum/Ui/Implementation/abstractVisualLayerState.h"
+#include "Magnum/Ui/Implementation/dirtyRange.h"
 
 namespace Magnum { namespace Ui {
 
@@ -46,6 +47,17 @@ struct BaseLayerStyle {
     Vector4 padding;
 };
 
+/* Used if BaseLayerSharedFlag::ShaderStyleAnimation is enabled, one for each
+   dynamic style. The shader then uses the source and target uniform
+   interpolated with the factor instead of the dynamic style uniform itself.
+   Matches the std140 layout of StyleInterpolationEntry in BaseShader.vert and
+   BaseShader.frag. */
+struct BaseLayerStyleInterpolation {
+    Vector2ui uniforms;
+    Float factor;
+    Int:32;
+};
+
 }
 
 struct BaseLayer::Shared::State: AbstractVisualLayer::Shared::State {
@@ -62,13 +74,16 @@ struct BaseLayer::Shared::State: AbstractVisualLayer::Shared::State {
        so the second and subsequent passes don't tap outside. The radius is
        always at most 31, so can be a byte. */
     UnsignedByte backgroundBlurRadius;
+    /* Used by BaseLayerGL to size the blur framebuffers and by BaseLayer to
+       scale the radius to full framebuffer pixels. Either 1, 2 or 4. */
+    UnsignedByte backgroundBlurDownscale;
 
     BaseLayerSharedFlags flags;
 
     #ifndef CORRADE_NO_ASSERT
     bool setStyleCalled = false;
     #endif
-    /* 1 byte free, 2 bytes free w/ CORRADE_NO_ASSERT */
+    /* 3 bytes free, 4 w/ CORRADE_NO_ASSERT */
 
     /* Can't be inferred from styleUniforms.size() as those are non-empty only
        if dynamicStyleCount is non-zero */
@@ -134,6 +149,24 @@ struct BaseLayerSubdividedTexturedVertex {
     Vector3 textureCoordinates;
 };
 
+/* Used if InstancedQuads is enabled. The min and max is with the smoothness
+   expansion included, same as positions in BaseLayerVertex. */
+struct BaseLayerInstance {
+    Vector2 min;
+    Vector2 max;
+    Vector4 outlineWidth;
+    Color4 color;
+    UnsignedInt styleUniform;
+};
+
+struct BaseLayerTexturedInstance {
+    BaseLayerInstance instance;
+    /* Texture coordinates corresponding to the min and max position, i.e.
+       Y-flipped, the layer is taken from the min */
+    Vector3 textureCoordinateMin;
+    Vector2 textureCoordinateMax;
+};
+
 static_assert(
     offsetof(BaseLayerSubdividedTexturedVertex, vertex) == 0 &&
     offsetof(BaseLayerSubdividedTexturedVertex, textureScale) == offsetof(BaseLayerSubdividedVertex, centerDistanceY) + sizeof(BaseLayerSubdividedVertex::centerDistanceY),
@@ -161,15 +194,23 @@ struct BaseLayer::State: AbstractVisualLayer::State {
        style (which is triggered by differing styleUpdateStamp) and the dynamic
        part */
     bool dynamicStyleChanged = false;
+    /* Same as above, but for dynamicStyleInterpolations, which are uploaded
+       separately */
+    bool dynamicStyleInterpolationChanged = false;
 
-    /* 3 bytes free */
+    /* 2 bytes free */
 
     Containers::Array<Implementation::BaseLayerData> data;
     /* Is either Implementation::BaseLayerVertex, BaseLayerTexturedVertex,
        BaseLayerSubdividedVertex or BaseLayerSubdividedTexturedVertex based on
-       whether texturing / SubdividedQuads is enabled */
+       whether texturing / SubdividedQuads is enabled. If InstancedQuads is
+       enabled, it's BaseLayerInstance or BaseLayerTexturedInstance in draw
+       order instead, and `indices` stay empty. */
     Containers::Array<char> vertices;
     Containers::Array<UnsignedInt> indices;
+    /* Parts of `vertices` and `indices` modified since the last upload, in
+       bytes */
+    Implementation::DirtyRange vertexDirtyRange, indexDirtyRange;
 
     /* Used for scaling the smoothness expansion to actual pixels, for clipping
        rects in BaseLayerGL and for expanding compositing rects for blur radius
@@ -190,6 +231,10 @@ struct BaseLayer::State: AbstractVisualLayer::State {
     Containers::ArrayTuple dynamicStyleStorage;
     Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms;
     Containers::ArrayView<Vector4> dynamicStylePaddings;
+    /* Used only if shared.dynamicStyleCount is non-zero and
+       BaseLayerSharedFlag::ShaderStyleAnimation is enabled, empty
+       otherwise */
+    Containers::ArrayView<Implementation::BaseLayerStyleInterpolation> dynamicStyleInterpolations;
 };
 
 }}
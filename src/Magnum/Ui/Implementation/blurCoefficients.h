@@ -115,6 +115,41 @@ void interpolateBlurCoefficientsInto(const Containers::ArrayView<const Float> di
     CORRADE_INTERNAL_ASSERT(i == discrete.size());
 }
 
+/* Calculates level count and tap offset scale for a dual-filter blur to
+   have approximately the same variance as a Gaussian blur of given radius
+   applied given count of times, returning the level count and filling the
+   offset scale. The offset scale is relative to a half-texel of the
+   lower-resolution level of each downsample / upsample pair.
+
+   The binomial coefficients for given radius have a variance of `radius/2`,
+   which adds up over the passes. For the dual filter, each level `i` with a
+   texel size `d = 2^i` adds `d^2/16 + (s*d)^2/8` to the variance of the
+   downsample, where the first term is from the bilinear filtering and the
+   second from the four diagonal taps at given offset scale `s`, and
+   `d^2/6 + (s*d)^2/3` to the variance of the upsample. Together that's
+   `d^2*11/48*(1 + 2*s^2)`, with the sum of `d^2` over `L` levels being
+   `4*(4^L - 1)/3`. The level count is picked as the largest for which the
+   variance with a zero offset scale doesn't exceed the target, and the offset
+   scale then fills the rest. The result is thus continuous in the variance,
+   with the offset scale staying between 0 and roughly 1.41 unless the level
+   count is capped. */
+UnsignedInt dualFilterBlurParameters(const UnsignedInt radius, const UnsignedInt passCount, const UnsignedInt maxLevelCount, Float& offsetScale) {
+    CORRADE_INTERNAL_ASSERT(maxLevelCount >= 1);
+    const Float variance = passCount*radius*0.5f;
+
+    UnsignedInt levelCount = 1;
+    Float levelVariance = 11.0f/48.0f*4.0f;
+    for(; levelCount != maxLevelCount; ++levelCount) {
+        const Float nextLevelVariance = levelVariance + 11.0f/48.0f*Float(1ull << 2*(levelCount + 1));
+        if(nextLevelVariance > variance)
+            break;
+        levelVariance = nextLevelVariance;
+    }
+
+    offsetScale = Math::sqrt(Math::max(0.0f, (variance/levelVariance - 1.0f)*0.5f));
+    return levelCount;
+}
+
 }}}
 
 #endif
@@ -0,0 +1,213 @@
+#ifndef Magnum_Ui_Implementation_bufferUploadGL_h
+#define Magnum_Ui_Implementation_bufferUploadGL_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring> /* std::memcpy() */
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/GL/Context.h>
+#include <Magnum/GL/Extensions.h>
+#include <Magnum/GL/OpenGL.h>
+#include <Magnum/Math/Functions.h>
+
+#include "Magnum/Ui/Implementation/dirtyRange.h"
+
+/* Shared between BaseLayerGL, LineLayerGL and TextLayerGL */
+
+namespace Magnum { namespace Ui { namespace {
+
+/* Capacity of a GL buffer, used to upload only the parts that changed as long
+   as the data fit */
+struct BufferUploadGL {
+    std::size_t capacity = 0;
+};
+
+/* Uploads the data to the buffer. If it doesn't fit, the buffer is
+   reallocated with a geometric growth and everything is uploaded. Otherwise
+   only the range the layer doUpdate() marked as modified is uploaded. The
+   range is reset afterwards. The buffer isn't shrunk if the data get smaller,
+   the draw count limits what's actually used. */
+void bufferUploadDirty(GL::Buffer& buffer, BufferUploadGL& state, const Containers::ArrayView<const void> data, Implementation::DirtyRange& dirtyRange) {
+    const char* const bytes = static_cast<const char*>(data.data());
+    const std::size_t size = data.size();
+
+    if(size > state.capacity) {
+        state.capacity = Math::max(size, state.capacity*2);
+        buffer.setData({nullptr, state.capacity}, GL::BufferUsage::DynamicDraw);
+        buffer.setSubData(0, data);
+
+    /* The range may reach past the data end if the data got smaller since it
+       was marked */
+    } else {
+        const std::size_t end = Math::min(dirtyRange.end, size);
+        if(dirtyRange.begin < end)
+            buffer.setSubData(dirtyRange.begin, Containers::arrayView(bytes + dirtyRange.begin, end - dirtyRange.begin));
+    }
+
+    dirtyRange.reset();
+}
+
+/* Ring used by the opt-in buffer streaming mode. If buffer storage is
+   available, the vertex and index buffers are persistently mapped and split
+   into BufferStreamSegmentCount segments, each upload goes to the next
+   segment and fences make sure a segment isn't overwritten while the GPU
+   still draws from it. Otherwise, and always on ES2 and WebGL where neither
+   buffer storage nor fence syncs are available, the buffers are orphaned on
+   every upload. */
+constexpr UnsignedInt BufferStreamSegmentCount = 3;
+
+struct BufferStreamGL {
+    explicit BufferStreamGL() = default;
+    /* The fences are deleted in the destructor, disallow copies */
+    BufferStreamGL(const BufferStreamGL&) = delete;
+    ~BufferStreamGL() {
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        for(GLsync fence: fences)
+            if(fence) glDeleteSync(fence);
+        #endif
+    }
+
+    BufferStreamGL& operator=(const BufferStreamGL&) = delete;
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    GLsync fences[BufferStreamSegmentCount]{};
+    /* Whole mapped ring */
+    Containers::ArrayView<char> vertexMemory;
+    Containers::ArrayView<UnsignedInt> indexMemory;
+    /* Size of a single segment, in bytes for vertices and in indices for
+       indices */
+    std::size_t vertexCapacity = 0;
+    std::size_t indexCapacity = 0;
+    UnsignedInt segment = 0;
+    #endif
+    /* Offset of the currently used segment in the index buffer, to be added
+       to index offsets of all draws. Always 0 if orphaning is used. */
+    UnsignedInt indexOffset = 0;
+    /* Offset of the currently used segment in the vertex buffer, in
+       vertices. Already included in the uploaded indices, used only by
+       instanced draws that have no indices. Always 0 if orphaning is used. */
+    UnsignedInt baseVertex = 0;
+};
+
+bool bufferStreamPersistentMappingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>();
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    return GL::Context::current().isExtensionSupported<GL::Extensions::EXT::buffer_storage>();
+    #else
+    return false;
+    #endif
+}
+
+/* Resets the ring to its initial state, to be called when the buffers it
+   was used with get replaced */
+void bufferStreamReset(BufferStreamGL& state) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    for(GLsync& fence: state.fences) {
+        if(fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    state.vertexMemory = nullptr;
+    state.indexMemory = nullptr;
+    state.vertexCapacity = 0;
+    state.indexCapacity = 0;
+    state.segment = 0;
+    #endif
+    state.indexOffset = 0;
+    state.baseVertex = 0;
+}
+
+/* Uploads both vertices and indices. Returns true if the buffers had to be
+   recreated, in which case the mesh using them has to be set up again. */
+bool bufferStreamUpload(GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, BufferStreamGL& state, const Containers::ArrayView<const void> vertices, const std::size_t vertexStride, const Containers::ArrayView<const UnsignedInt> indices) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(bufferStreamPersistentMappingSupported()) {
+        bool recreated = false;
+        if(vertices.size() > state.vertexCapacity || indices.size() > state.indexCapacity) {
+            /* Immutable storage can't be resized, so allocate new buffers
+               with a geometric growth. The old ones get deleted once the GPU
+               is done with them, so the fences aren't needed anymore. The
+               vertex capacity stays a multiple of the stride as both the
+               previous capacity and the data size are. */
+            const std::size_t vertexCapacity = Math::max(vertices.size(), state.vertexCapacity*2);
+            const std::size_t indexCapacity = Math::max(indices.size(), state.indexCapacity*2);
+            bufferStreamReset(state);
+            state.vertexCapacity = vertexCapacity;
+            state.indexCapacity = indexCapacity;
+
+            const GL::Buffer::StorageFlags storageFlags = GL::Buffer::StorageFlag::MapWrite|GL::Buffer::StorageFlag::MapPersistent|GL::Buffer::StorageFlag::MapCoherent;
+            const GL::Buffer::MapFlags mapFlags = GL::Buffer::MapFlag::Write|GL::Buffer::MapFlag::Persistent|GL::Buffer::MapFlag::Coherent;
+            const std::size_t vertexSize = Math::max(state.vertexCapacity, std::size_t{1})*BufferStreamSegmentCount;
+            const std::size_t indexSize = Math::max(state.indexCapacity, std::size_t{1})*sizeof(UnsignedInt)*BufferStreamSegmentCount;
+            vertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+            vertexBuffer.setStorage({nullptr, vertexSize}, storageFlags);
+            state.vertexMemory = vertexBuffer.map(0, vertexSize, mapFlags);
+            indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+            indexBuffer.setStorage({nullptr, indexSize}, storageFlags);
+            state.indexMemory = Containers::arrayCast<UnsignedInt>(indexBuffer.map(0, indexSize, mapFlags));
+            recreated = true;
+
+        /* Otherwise fence everything submitted so far, which includes all
+           draws from the current segment, and move to the next segment,
+           waiting until the GPU is done with it if needed */
+        } else {
+            state.fences[state.segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            state.segment = (state.segment + 1) % BufferStreamSegmentCount;
+            if(GLsync& fence = state.fences[state.segment]) {
+                while(glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        /* The indices are offset to point to vertices in the current
+           segment, which avoids a dependency on base vertex support */
+        const std::size_t vertexOffset = state.segment*state.vertexCapacity;
+        if(!vertices.isEmpty())
+            std::memcpy(state.vertexMemory.data() + vertexOffset, vertices.data(), vertices.size());
+        const UnsignedInt baseVertex = vertexOffset/vertexStride;
+        UnsignedInt* const indexMemory = state.indexMemory.data() + state.segment*state.indexCapacity;
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            indexMemory[i] = indices[i] + baseVertex;
+        state.indexOffset = state.segment*state.indexCapacity;
+        state.baseVertex = baseVertex;
+        return recreated;
+    }
+    #else
+    static_cast<void>(vertexStride);
+    #endif
+
+    /* Orphaning, the driver can allocate a new storage instead of waiting
+       until the GPU finishes drawing from the previous one */
+    vertexBuffer.setData(vertices, GL::BufferUsage::StreamDraw);
+    indexBuffer.setData(indices, GL::BufferUsage::StreamDraw);
+    return false;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef Magnum_Ui_Implementation_dirtyRange_h
+#define Magnum_Ui_Implementation_dirtyRange_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstddef>
+
+namespace Magnum { namespace Ui { namespace Implementation {
+
+/* Byte range of a layer vertex or index array that was modified by doUpdate()
+   and has to be uploaded. Accumulated by the layer doUpdate(), the GL
+   implementations then upload just this range and reset it. Kept as a single
+   range to keep the upload to one call, in practice the modified parts are
+   either everything that's drawn or a single localized change. */
+struct DirtyRange {
+    bool isEmpty() const { return begin >= end; }
+
+    void add(std::size_t begin, std::size_t end) {
+        if(begin < this->begin) this->begin = begin;
+        if(end > this->end) this->end = end;
+    }
+
+    void reset() {
+        begin = ~std::size_t{};
+        end = 0;
+    }
+
+    std::size_t begin = ~std::size_t{};
+    std::size_t end = 0;
+};
+
+}}}
+
+#endif
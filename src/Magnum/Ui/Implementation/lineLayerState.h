@@ -34,6 +34,7 @@
 
 #include "Magnum/Ui/LineLayer.h"
 #include "Magnum/Ui/Implementation/abstractVisualLayerState.h"
+#include "Magnum/Ui/Implementation/dirtyRange.h"
 
 namespace Magnum { namespace Ui {
 
@@ -102,6 +103,28 @@ struct LineLayerRun {
        for calculating index buffer size, each such join is two additional
        triangles. */
     UnsignedInt joinCount;
+    /* If set to ~UnsignedInt{}, given run isn't a ring strip. Otherwise
+       `pointCount` is the ring capacity and `indexCount` is twice that, with
+       index pair `i` always being a segment from point `i` to point `i + 1`
+       (wrapping around). Only `ringPointCount` points starting at
+       `ringPointOffset` are valid, and only the `ringPointCount - 1` segments
+       between them get drawn, the remaining ones are ignored. Both are
+       relative to the run, so recompaction doesn't need to touch them. */
+    UnsignedInt ringPointOffset;
+    UnsignedInt ringPointCount;
+    /* Used only for ring strips. Range of segments modified by
+       appendRingStrip() since the last doUpdate(), starting at
+       `ringDirtySegmentOffset` and wrapping around. The doUpdate() then
+       regenerates and marks for upload just the vertices and indices of these
+       segments, if nothing else caused the whole data to be regenerated. */
+    UnsignedInt ringDirtySegmentOffset;
+    UnsignedInt ringDirtySegmentCount;
+    /* Used only for ring strips. Offset of the run in the `indices` array,
+       filled when the index data are generated in doUpdate(), or
+       ~UnsignedInt{} if the run isn't drawn. Ring strips have a fixed amount
+       of indices for each segment, whether it's drawn or not, so the indices
+       of a particular segment can be updated without touching the rest. */
+    UnsignedInt ringIndexDrawOffset;
 };
 
 struct LineLayerData {
@@ -183,6 +206,10 @@ struct LineLayer::State: AbstractVisualLayer::State {
        order. */
     Containers::Array<UnsignedInt> indices;
     Containers::Array<UnsignedInt> indexDrawOffsets;
+
+    /* Parts of `vertices` and `indices` modified since the last upload, in
+       bytes */
+    Implementation::DirtyRange vertexDirtyRange, indexDirtyRange;
 };
 
 }}
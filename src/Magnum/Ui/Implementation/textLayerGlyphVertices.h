@@ -0,0 +1,314 @@
+#ifndef Magnum_Ui_Implementation_textLayerGlyphVertices_h
+#define Magnum_Ui_Implementation_textLayerGlyphVertices_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Complex.h>
+
+#include "Magnum/Ui/Implementation/textLayerState.h"
+
+#ifdef CORRADE_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_AVX
+#include <immintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+/* Kernels used by TextLayer::doUpdate() to fill per-vertex properties of a
+   glyph run, with variants for various instruction sets. The best variant for
+   the current CPU is picked in the TextLayer::State constructor. Extracted
+   here for easier testing of all variants against each other.
+
+   All inputs are passed by value so they're local to the loop. When they were
+   read from the layer data directly in the loop, the compiler had to assume
+   the vertex writes may alias them and reload them in every iteration,
+   preventing it from keeping them in registers.
+
+   The vertex layout is interleaved, so the SIMD variants load and store each
+   vertex position or color separately and only the arithmetic is done on
+   multiple vertices at once. The color and style fill is just stores, so
+   there's no AVX variant for it. */
+
+namespace Magnum { namespace Ui { namespace Implementation { namespace {
+
+TextLayerFillGlyphVertexColorStyleFunction fillGlyphVertexColorStyleImplementation(CORRADE_CPU_DECLARE(Cpu::Scalar)) {
+    return [](const Containers::StridedArrayView1D<TextLayerVertex>& vertices, const Color4 color, const UnsignedInt styleUniform) {
+        for(TextLayerVertex& vertex: vertices) {
+            vertex.color = color;
+            vertex.styleUniform = styleUniform;
+        }
+    };
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+CORRADE_ENABLE_SSE2 TextLayerFillGlyphVertexColorStyleFunction fillGlyphVertexColorStyleImplementation(CORRADE_CPU_DECLARE(Cpu::Sse2)) {
+    return [](const Containers::StridedArrayView1D<TextLayerVertex>& vertices, const Color4 color, const UnsignedInt styleUniform) CORRADE_ENABLE_SSE2 {
+        const __m128 colorSse = _mm_loadu_ps(color.data());
+        for(TextLayerVertex& vertex: vertices) {
+            _mm_storeu_ps(vertex.color.data(), colorSse);
+            vertex.styleUniform = styleUniform;
+        }
+    };
+}
+#endif
+
+#ifdef CORRADE_ENABLE_NEON
+CORRADE_ENABLE_NEON TextLayerFillGlyphVertexColorStyleFunction fillGlyphVertexColorStyleImplementation(CORRADE_CPU_DECLARE(Cpu::Neon)) {
+    return [](const Containers::StridedArrayView1D<TextLayerVertex>& vertices, const Color4 color, const UnsignedInt styleUniform) CORRADE_ENABLE_NEON {
+        const float32x4_t colorNeon = vld1q_f32(color.data());
+        for(TextLayerVertex& vertex: vertices) {
+            vst1q_f32(vertex.color.data(), colorNeon);
+            vertex.styleUniform = styleUniform;
+        }
+    };
+}
+#endif
+
+CORRADE_CPU_DISPATCHER_BASE(fillGlyphVertexColorStyleImplementation)
+
+/* The glyph quad positions are produced with Y up, the Y flip makes them
+   consistent with the UI coordinate system being Y down. The SIMD variants
+   negate Y by flipping the sign bit, which gives the same result as the
+   scalar subtraction. */
+TextLayerTranslateGlyphVertexPositionsFunction translateGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Scalar)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation) {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        for(Vector2& position: positions)
+            position = {x + position.x(), y - position.y()};
+    };
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+CORRADE_ENABLE_SSE2 TextLayerTranslateGlyphVertexPositionsFunction translateGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Sse2)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation) CORRADE_ENABLE_SSE2 {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        const __m128 t = _mm_setr_ps(x, y, x, y);
+        const __m128 flipY = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+
+        /* Two positions at a time */
+        std::size_t i = 0;
+        for(const std::size_t max = positions.size() & ~std::size_t{1}; i != max; i += 2) {
+            Vector2& p0 = positions[i];
+            Vector2& p1 = positions[i + 1];
+            const __m128 p = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p0.data())), reinterpret_cast<const __m64*>(p1.data()));
+            const __m128 r = _mm_add_ps(t, _mm_xor_ps(p, flipY));
+            _mm_storel_pi(reinterpret_cast<__m64*>(p0.data()), r);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p1.data()), r);
+        }
+
+        /* Remaining position, if any */
+        for(const std::size_t max = positions.size(); i != max; ++i) {
+            Vector2& position = positions[i];
+            position = {x + position.x(), y - position.y()};
+        }
+    };
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX
+CORRADE_ENABLE_AVX TextLayerTranslateGlyphVertexPositionsFunction translateGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Avx)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation) CORRADE_ENABLE_AVX {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        const __m256 t = _mm256_setr_ps(x, y, x, y, x, y, x, y);
+        const __m256 flipY = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+
+        /* Four positions, i.e. a whole glyph quad, at a time */
+        std::size_t i = 0;
+        for(const std::size_t max = positions.size() & ~std::size_t{3}; i != max; i += 4) {
+            Vector2& p0 = positions[i];
+            Vector2& p1 = positions[i + 1];
+            Vector2& p2 = positions[i + 2];
+            Vector2& p3 = positions[i + 3];
+            const __m128 p01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p0.data())), reinterpret_cast<const __m64*>(p1.data()));
+            const __m128 p23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p2.data())), reinterpret_cast<const __m64*>(p3.data()));
+            const __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(p01), p23, 1);
+            const __m256 r = _mm256_add_ps(t, _mm256_xor_ps(p, flipY));
+            const __m128 r01 = _mm256_castps256_ps128(r);
+            const __m128 r23 = _mm256_extractf128_ps(r, 1);
+            _mm_storel_pi(reinterpret_cast<__m64*>(p0.data()), r01);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p1.data()), r01);
+            _mm_storel_pi(reinterpret_cast<__m64*>(p2.data()), r23);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p3.data()), r23);
+        }
+
+        /* Remaining positions, if any */
+        for(const std::size_t max = positions.size(); i != max; ++i) {
+            Vector2& position = positions[i];
+            position = {x + position.x(), y - position.y()};
+        }
+    };
+}
+#endif
+
+#ifdef CORRADE_ENABLE_NEON
+CORRADE_ENABLE_NEON TextLayerTranslateGlyphVertexPositionsFunction translateGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Neon)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation) CORRADE_ENABLE_NEON {
+        const float32x2_t t = vld1_f32(translation.data());
+        const Float flipYData[]{1.0f, -1.0f};
+        const float32x2_t flipY = vld1_f32(flipYData);
+        for(Vector2& position: positions)
+            vst1_f32(position.data(), vadd_f32(t, vmul_f32(vld1_f32(position.data()), flipY)));
+    };
+}
+#endif
+
+CORRADE_CPU_DISPATCHER_BASE(translateGlyphVertexPositionsImplementation)
+
+/* Here the Y flip is done before the rotation, which causes positive rotation
+   angle to be interpreted clockwise. It's folded into the rotation, so
+   instead of transformVector(position*Vector2::yScale(-1.0f)), which is
+   (c*x + s*y, s*x - c*y) for a complex number c + is, a single 2x2 matrix
+   multiplication is done. The SIMD variants calculate it as
+   (c, s)*x + (s, -c)*y, with the same order of operations as the scalar
+   variant. */
+TextLayerTransformGlyphVertexPositionsFunction transformGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Scalar)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation, const Complex rotationScaling) {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        const Float c = rotationScaling.real();
+        const Float s = rotationScaling.imaginary();
+        for(Vector2& position: positions) {
+            const Float px = position.x();
+            const Float py = position.y();
+            position = {x + (c*px + s*py), y + (s*px - c*py)};
+        }
+    };
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+CORRADE_ENABLE_SSE2 TextLayerTransformGlyphVertexPositionsFunction transformGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Sse2)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation, const Complex rotationScaling) CORRADE_ENABLE_SSE2 {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        const Float c = rotationScaling.real();
+        const Float s = rotationScaling.imaginary();
+        const __m128 t = _mm_setr_ps(x, y, x, y);
+        const __m128 cs = _mm_setr_ps(c, s, c, s);
+        const __m128 sc = _mm_setr_ps(s, -c, s, -c);
+
+        /* Two positions at a time */
+        std::size_t i = 0;
+        for(const std::size_t max = positions.size() & ~std::size_t{1}; i != max; i += 2) {
+            Vector2& p0 = positions[i];
+            Vector2& p1 = positions[i + 1];
+            const __m128 p = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p0.data())), reinterpret_cast<const __m64*>(p1.data()));
+            const __m128 px = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m128 py = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+            const __m128 r = _mm_add_ps(t, _mm_add_ps(_mm_mul_ps(cs, px), _mm_mul_ps(sc, py)));
+            _mm_storel_pi(reinterpret_cast<__m64*>(p0.data()), r);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p1.data()), r);
+        }
+
+        /* Remaining position, if any */
+        for(const std::size_t max = positions.size(); i != max; ++i) {
+            Vector2& position = positions[i];
+            const Float px = position.x();
+            const Float py = position.y();
+            position = {x + (c*px + s*py), y + (s*px - c*py)};
+        }
+    };
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX
+CORRADE_ENABLE_AVX TextLayerTransformGlyphVertexPositionsFunction transformGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Avx)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation, const Complex rotationScaling) CORRADE_ENABLE_AVX {
+        const Float x = translation.x();
+        const Float y = translation.y();
+        const Float c = rotationScaling.real();
+        const Float s = rotationScaling.imaginary();
+        const __m256 t = _mm256_setr_ps(x, y, x, y, x, y, x, y);
+        const __m256 cs = _mm256_setr_ps(c, s, c, s, c, s, c, s);
+        const __m256 sc = _mm256_setr_ps(s, -c, s, -c, s, -c, s, -c);
+
+        /* Four positions, i.e. a whole glyph quad, at a time. The shuffles
+           operate on each 128-bit half separately, so it's the same as in
+           the SSE2 variant. */
+        std::size_t i = 0;
+        for(const std::size_t max = positions.size() & ~std::size_t{3}; i != max; i += 4) {
+            Vector2& p0 = positions[i];
+            Vector2& p1 = positions[i + 1];
+            Vector2& p2 = positions[i + 2];
+            Vector2& p3 = positions[i + 3];
+            const __m128 p01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p0.data())), reinterpret_cast<const __m64*>(p1.data()));
+            const __m128 p23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p2.data())), reinterpret_cast<const __m64*>(p3.data()));
+            const __m256 p = _mm256_insertf128_ps(_mm256_castps128_ps256(p01), p23, 1);
+            const __m256 px = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m256 py = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+            const __m256 r = _mm256_add_ps(t, _mm256_add_ps(_mm256_mul_ps(cs, px), _mm256_mul_ps(sc, py)));
+            const __m128 r01 = _mm256_castps256_ps128(r);
+            const __m128 r23 = _mm256_extractf128_ps(r, 1);
+            _mm_storel_pi(reinterpret_cast<__m64*>(p0.data()), r01);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p1.data()), r01);
+            _mm_storel_pi(reinterpret_cast<__m64*>(p2.data()), r23);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(p3.data()), r23);
+        }
+
+        /* Remaining positions, if any */
+        for(const std::size_t max = positions.size(); i != max; ++i) {
+            Vector2& position = positions[i];
+            const Float px = position.x();
+            const Float py = position.y();
+            position = {x + (c*px + s*py), y + (s*px - c*py)};
+        }
+    };
+}
+#endif
+
+#ifdef CORRADE_ENABLE_NEON
+CORRADE_ENABLE_NEON TextLayerTransformGlyphVertexPositionsFunction transformGlyphVertexPositionsImplementation(CORRADE_CPU_DECLARE(Cpu::Neon)) {
+    return [](const Containers::StridedArrayView1D<Vector2>& positions, const Vector2 translation, const Complex rotationScaling) CORRADE_ENABLE_NEON {
+        const Float c = rotationScaling.real();
+        const Float s = rotationScaling.imaginary();
+        const float32x2_t t = vld1_f32(translation.data());
+        const Float csData[]{c, s};
+        const Float scData[]{s, -c};
+        const float32x2_t cs = vld1_f32(csData);
+        const float32x2_t sc = vld1_f32(scData);
+        for(Vector2& position: positions) {
+            const float32x2_t p = vld1_f32(position.data());
+            const float32x2_t px = vdup_lane_f32(p, 0);
+            const float32x2_t py = vdup_lane_f32(p, 1);
+            vst1_f32(position.data(), vadd_f32(t, vadd_f32(vmul_f32(cs, px), vmul_f32(sc, py))));
+        }
+    };
+}
+#endif
+
+CORRADE_CPU_DISPATCHER_BASE(transformGlyphVertexPositionsImplementation)
+
+}}}}
+
+#endif
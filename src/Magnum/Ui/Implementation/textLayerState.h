@@ -44,6 +44,7 @@
 #include "Magnum/Ui/TextLayer.h"
 #include "Magnum/Ui/TextProperties.h"
 #include "Magnum/Ui/Implementation/abstractVisualLayerState.h"
+#include "Magnum/Ui/Implementation/dirtyRange.h"
 
 namespace Magnum { namespace Ui {
 
@@ -63,6 +64,10 @@ struct TextLayerFont {
     /* Glyph mapping for createGlyph() and setGlyph(). If empty, trivial
        mapping is used. */
     Containers::Array<UnsignedInt> glyphMapping;
+    /* Set if TextLayerSharedFlag::FillGlyphCacheOnDemand is enabled and
+       filling the glyph cache failed, in which case it isn't attempted
+       again */
+    bool glyphCacheFull;
 };
 
 struct TextLayerStyle {
@@ -87,6 +92,48 @@ struct TextLayerEditingStyle {
     Vector4 padding;
 };
 
+struct TextLayerShapeCacheEntry {
+    /* Font, script, language, directions, alignment, features and the text
+       itself, serialized by shapeCacheKey() in TextLayer.cpp and compared
+       byte-by-byte */
+    Containers::Array<char> key;
+    /* Positions and cache-global IDs of the shaped glyphs. Clusters aren't
+       stored as editable text doesn't go through the cache. */
+    Containers::Array<Vector2> glyphPositions;
+    Containers::Array<UnsignedInt> glyphIds;
+    Range2D rectangle;
+    UnsignedLong hash;
+    /* Glyph run scale, unused if there are no glyphs */
+    Float scale;
+    /* Alignment resolved based on the layout and shape direction */
+    Text::Alignment alignment;
+    /* 3 bytes free */
+    /* Neighbors in the LRU list, with `previous` being the more recently
+       used one. ~0 at either end of the list. */
+    UnsignedInt previous, next;
+};
+
+/* Shaping result cache, empty if disabled. Operated on by shapeCacheFind(),
+   shapeCacheInsert() and shapeCacheClear() in TextLayer.cpp. */
+struct TextLayerShapeCache {
+    /* The entries are allocated upfront and the first `usedCount` of them are
+       used, which allows their arrays to be reused when an entry gets
+       evicted */
+    Containers::Array<TextLayerShapeCacheEntry> entries;
+    /* Open-addressed hash table with linear probing, containing indices into
+       `entries` or ~0 for empty buckets. Its size is a power of two at least
+       twice the entry count to keep the probe sequences short. */
+    Containers::Array<UnsignedInt> buckets;
+    /* Key of the text being currently shaped, reused to avoid allocating for
+       each lookup */
+    Containers::Array<char> key;
+    UnsignedInt usedCount = 0;
+    /* Most and least recently used entry, ~0 if the cache is empty */
+    UnsignedInt mostRecent = ~UnsignedInt{},
+        leastRecent = ~UnsignedInt{};
+    std::size_t hitCount = 0, missCount = 0;
+};
+
 }
 
 struct TextLayer::Shared::State: AbstractVisualLayer::Shared::State {
@@ -118,7 +165,9 @@ struct TextLayer::Shared::State: AbstractVisualLayer::Shared::State {
        those are non-empty only if dynamicStyleCount is non-zero */
     UnsignedInt styleUniformCount, editingStyleUniformCount;
 
-    /* 0/4 bytes free */
+    /* Fraction of unused glyph data at which TextLayer::doUpdate()
+       recompacts the glyph runs */
+    Float recompactionThreshold;
 
     /* Glyph cache used by all fonts. It's expected to know about each font
        that's added. */
@@ -152,6 +201,9 @@ struct TextLayer::Shared::State: AbstractVisualLayer::Shared::State {
        unused if dynamicStyleCount is 0. */
     Containers::ArrayView<TextLayerEditingStyleUniform> editingStyleUniforms;
     TextLayerCommonEditingStyleUniform commonEditingStyleUniform{NoInit};
+
+    /* Shaping result cache, see TextLayerShapeCache for details */
+    Implementation::TextLayerShapeCache shapeCache;
 };
 
 namespace Implementation {
@@ -181,6 +233,22 @@ struct TextLayerGlyphRun {
     Float scale;
 };
 
+/* A glyph whose cache ID is still 0 because it's waiting to be added to the
+   glyph cache with TextLayer::fillPendingGlyphs(), used if
+   TextLayerSharedFlag::FillGlyphCacheDeferred is enabled. If the run is
+   marked as unused or belongs to different data, the glyph is discarded.
+   Recompaction in doUpdate() updates the run reference. */
+struct TextLayerPendingGlyph {
+    UnsignedInt data;
+    UnsignedInt glyphRun;
+    /* Index of the glyph in the run */
+    UnsignedInt glyph;
+    /* Index into TextLayer::Shared::State::fonts and font-specific glyph ID
+       to add to the cache */
+    UnsignedInt font;
+    UnsignedInt fontGlyphId;
+};
+
 struct TextLayerEditData {
     /* Current editing position or the next free item if the item is unused */
     union {
@@ -281,6 +349,24 @@ struct TextLayerDistanceFieldVertex {
     Float invertedRunScale;
 };
 
+/* Used if TextLayerSharedFlag::CompactVertices is enabled. Texture
+   coordinates are normalized, the layer and style index is converted to a
+   float / uint in the shader. Positions are in absolute UI coordinates, so
+   they stay 32-bit. */
+struct TextLayerCompactVertex {
+    Vector2 position;
+    Vector2us textureCoordinates;
+    UnsignedShort textureLayer;
+    UnsignedShort styleUniform;
+    Color4ub color;
+};
+
+struct TextLayerCompactDistanceFieldVertex {
+    /* Again has to be a member and not a base class */
+    TextLayerCompactVertex vertex;
+    Float invertedRunScale;
+};
+
 struct TextLayerEditingVertex {
     Vector2 position;
     Vector2 centerDistance;
@@ -297,6 +383,18 @@ struct TextLayerDynamicStyle {
     Vector4 padding;
 };
 
+/* Used if TextLayerSharedFlag::ShaderStyleAnimation is enabled, one for each
+   dynamic style uniform and dynamic editing style uniform. The shader then
+   uses the source and target uniform interpolated with the factor instead of
+   the dynamic uniform itself. Matches the std140 layout of
+   StyleInterpolationEntry in TextShader.vert, TextShader.frag,
+   TextEditingShader.vert and TextEditingShader.frag. */
+struct TextLayerStyleInterpolation {
+    Vector2ui uniforms;
+    Float factor;
+    Int:32;
+};
+
 /* Deliberately named differently from TextLayer::dynamicStyleCursorStyle() etc
    to avoid those being called instead by accident */
 inline UnsignedInt cursorStyleForDynamicStyle(UnsignedInt id) {
@@ -314,6 +412,11 @@ inline UnsignedInt selectionStyleTextUniformForDynamicStyle(UnsignedInt dynamicS
 }
 /* textStyleForDynamicCursorStyle would be 2*id + 1 */
 
+/* Glyph vertex kernels, implemented in textLayerGlyphVertices.h */
+typedef void(*TextLayerFillGlyphVertexColorStyleFunction)(const Containers::StridedArrayView1D<TextLayerVertex>&, Color4, UnsignedInt);
+typedef void(*TextLayerTranslateGlyphVertexPositionsFunction)(const Containers::StridedArrayView1D<Vector2>&, Vector2);
+typedef void(*TextLayerTransformGlyphVertexPositionsFunction)(const Containers::StridedArrayView1D<Vector2>&, Vector2, Complex);
+
 }
 
 struct TextLayer::State: AbstractVisualLayer::State {
@@ -339,13 +442,23 @@ struct TextLayer::State: AbstractVisualLayer::State {
        (editing) part */
     bool dynamicStyleChanged = false;
     bool dynamicEditingStyleChanged = false;
+    /* Same as above, but for dynamicStyleInterpolations and
+       dynamicEditingStyleInterpolations, which are uploaded separately */
+    bool dynamicStyleInterpolationChanged = false;
+    bool dynamicEditingStyleInterpolationChanged = false;
 
     TextLayerFlags flags;
-    /* 3/7 bytes free */
+    /* 1/5 bytes free */
+
+    /* Glyph vertex kernels for the instruction sets the CPU supports, picked
+       in the constructor */
+    Implementation::TextLayerFillGlyphVertexColorStyleFunction fillGlyphVertexColorStyle;
+    Implementation::TextLayerTranslateGlyphVertexPositionsFunction translateGlyphVertexPositions;
+    Implementation::TextLayerTransformGlyphVertexPositionsFunction transformGlyphVertexPositions;
 
     /* Glyph / text data. Only the items referenced from `glyphRuns` /
        `textRuns` are valid, the rest is unused space that gets recompacted
-       during each doUpdate(). */
+       during doUpdate(). */
     Containers::Array<Implementation::TextLayerGlyphData> glyphData;
     Containers::Array<char> textData;
 
@@ -362,11 +475,24 @@ struct TextLayer::State: AbstractVisualLayer::State {
     /* Glyph / text runs. Each run is a complete text belogning to one text
        layer data. Ordered by the offset. Removed items get marked as unused,
        new items get put at the end, modifying an item means a removal and an
-       addition. Gets recompacted during each doUpdate(), this process results
-       in the static texts being eventually pushed to the front of the
-       buffer (which doesn't need to be updated as often). */
+       addition. Gets recompacted during doUpdate(), this process results in
+       the static texts being eventually pushed to the front of the buffer
+       (which doesn't need to be updated as often). */
     Containers::Array<Implementation::TextLayerGlyphRun> glyphRuns;
     Containers::Array<Implementation::TextLayerTextRun> textRuns;
+    /* Lowest glyph / text run marked as unused since the last recompaction,
+       or ~UnsignedInt{} if there's none. As the runs are ordered by offset,
+       everything before stays in place and the recompaction in doUpdate()
+       only needs to go from there. The glyph count is then compared against
+       Shared::State::recompactionThreshold to decide whether it's worth
+       recompacting the glyph data at all. */
+    UnsignedInt firstUnusedGlyphRun = ~UnsignedInt{};
+    UnsignedInt firstUnusedTextRun = ~UnsignedInt{};
+    UnsignedInt unusedGlyphCount = 0;
+
+    /* Glyphs waiting for the glyph cache to be filled, used only if
+       TextLayerSharedFlag::FillGlyphCacheDeferred is enabled */
+    Containers::Array<Implementation::TextLayerPendingGlyph> pendingGlyphs;
 
     /* Data for each text. Index to `glyphRus` and optionally `textRuns` above
        and `editData` below, a style index and other properties. */
@@ -385,8 +511,13 @@ struct TextLayer::State: AbstractVisualLayer::State {
     /* Vertex data, ultimately built from `glyphData` combined with color and
        style index from `data`. Is either Implementation::TextLayerVertex or
        TextLayerDistanceFieldVertex based on whether Flag::DistanceField is
-       enabled */
+       enabled, or their compact variants if Flag::CompactVertices is
+       enabled. */
     Containers::Array<char> vertices;
+    /* If Flag::CompactVertices is enabled, vertices for a single glyph run
+       are generated here first and then packed to `vertices`. Only ever
+       grows. */
+    Containers::Array<Implementation::TextLayerVertex> compactVertexScratch;
     /* Vertex data for cursor and selection rectangles */
     Containers::Array<Implementation::TextLayerEditingVertex> editingVertices;
 
@@ -402,6 +533,11 @@ struct TextLayer::State: AbstractVisualLayer::State {
     Containers::Array<UnsignedInt> editingIndices;
     Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> indexDrawOffsets;
 
+    /* Parts of `vertices`, `editingVertices`, `indices` and `editingIndices`
+       modified since the last upload, in bytes */
+    Implementation::DirtyRange vertexDirtyRange, editingVertexDirtyRange,
+        indexDirtyRange, editingIndexDirtyRange;
+
     /* All these are used only if shared.dynamicStyleCount is non-zero */
 
     /* Each dynamic style points here with TextLayerDynamicStyle::featureOffset
@@ -424,6 +560,11 @@ struct TextLayer::State: AbstractVisualLayer::State {
     /* If dynamic styles include editing styles, the size is
        2*dynamicStyleCount, otherwise it's empty */
     Containers::ArrayView<Vector4> dynamicEditingStylePaddings;
+    /* Used only if TextLayerSharedFlag::ShaderStyleAnimation is enabled,
+       empty otherwise. Then the sizes are the same as of
+       dynamicStyleUniforms and dynamicEditingStyleUniforms. */
+    Containers::ArrayView<Implementation::TextLayerStyleInterpolation> dynamicStyleInterpolations;
+    Containers::ArrayView<Implementation::TextLayerStyleInterpolation> dynamicEditingStyleInterpolations;
 };
 
 }}
@@ -26,6 +26,7 @@
 
 #include "Label.h"
 
+#include <cstring>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Containers/Function.h> /* for DataLayer::onUpdate() */
 #include <Corrade/Utility/Assert.h>
@@ -149,6 +150,37 @@ Label::Label(const Anchor anchor, const Containers::StringView text, const TextP
 
 Label::Label(const Anchor anchor, const Containers::StringView text, const LabelStyle style): Label{anchor, text, {}, style} {}
 
+namespace {
+
+/* The binding gets called also if the value itself didn't change, such as
+   when a different index of a multi-dimensional storage got changed or when a
+   value got set to the same thing again. Remember the last formatted value and
+   skip the formatting and text shaping in that case, as the formatted output
+   would be the same as well. The values are compared bitwise and not with
+   operator== as a negative zero compares equal to a positive one but is
+   formatted with a sign. The first call always formats, even if the value
+   is the same as the default-initialized `previous`. A struct and not a
+   mutable lambda because C++11 can't initialize the extra captures. */
+template<class T, class Formatter> struct FormattingBinding {
+    explicit FormattingBinding(TextLayer& textLayer, LayerDataHandle textData, const Formatter& formatter): textLayer(textLayer), textData{textData}, formatter(formatter) {}
+
+    void operator()(const T value) {
+        if(hasPrevious && std::memcmp(&value, &previous, sizeof(T)) == 0)
+            return;
+        formatter(textLayer, textData, value);
+        previous = value;
+        hasPrevious = true;
+    }
+
+    TextLayer& textLayer;
+    LayerDataHandle textData;
+    Formatter formatter;
+    T previous{};
+    bool hasPrevious = false;
+};
+
+}
+
 template<class T, class Formatter> Label::Label(std::nullptr_t, const Anchor anchor, const StorageQuery<T>& query, const Formatter& formatter, const LabelStyle style): Widget{anchor}, _style{style}, _icon{Icon::None} {
     /** @todo cannot delegate to the non-data-binding constructor because it
         completely omits the text data if empty, any better solution so I don't
@@ -163,9 +195,7 @@ template<class T, class Formatter> Label::Label(std::nullptr_t, const Anchor anc
         const LayerDataHandle textData = _textData;
         /* Leaving query validity checks on doUpdate() as that'd be a lot of
            duplication, the assumption is that StorageQuery is short-lived */
-        _dataBindingData = query.onUpdate([&textLayer, textData, formatter](const T value) {
-            formatter(textLayer, textData, value);
-        }, node());
+        _dataBindingData = query.onUpdate(FormattingBinding<T, Formatter>{textLayer, textData, formatter}, node());
     }
 }
 
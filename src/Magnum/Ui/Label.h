@@ -104,6 +104,17 @@ class MAGNUM_UI_EXPORT Label: public Widget {
          * constructors and their overloads to explicitly supply a configured
          * @ref DecimalFormatter or @ref HexadecimalFormatter instance.
          *
+         * The value is formatted only if it differs from the previously
+         * formatted one, so for example changes to other values in the same
+         * storage don't cause the text to be reshaped. This applies also to
+         * explicitly marking the binding as dirty with
+         * @ref DataLayer::setDirty() on @ref dataBindingData(), which thus
+         * can't be used to force the text to be formatted again. If you need
+         * that, construct a label without a data binding and pass a lambda
+         * calling @ref setText() on it to @ref StorageQuery::onUpdate(). For
+         * values that change too often to be readable, limit the update rate
+         * with @ref DataLayer::setUpdateInterval() on @ref dataBindingData().
+         *
          * Note that it's not possible to supply custom @ref TextProperties
          * this way. If you need to override these, construct a label without a
          * data binding and then pass a lambda calling @ref setText() on it to
@@ -179,6 +190,12 @@ class MAGNUM_UI_EXPORT Label: public Widget {
          * constructor and its overloads to explicitly supply a configured
          * @ref FloatFormatter instance.
          *
+         * Same as with the integer overloads, the value is formatted only if
+         * it differs from the previously formatted one. The values are
+         * compared bitwise, so for example a change from @cpp 0.0f @ce to
+         * @cpp -0.0f @ce is formatted again, while a NaN with the same bit
+         * pattern as the previous one isn't.
+         *
          * Note that it's not possible to supply custom @ref TextProperties
          * this way. If you need to override these, construct a label without a
          * data binding and then pass a lambda calling @ref setText() on it to
@@ -29,6 +29,7 @@
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Swizzle.h>
 
 #include "Magnum/Ui/Handle.h"
@@ -202,6 +203,95 @@ LineLayer::LineLayer(const LayerHandle handle, Containers::Pointer<State>&& stat
 
 LineLayer::LineLayer(const LayerHandle handle, Shared& shared): LineLayer{handle, Containers::pointer<State>(static_cast<Shared::State&>(*shared._state))} {}
 
+namespace {
+
+/* Marks `count` ring strip segments starting at `begin` (and wrapping around)
+   for regeneration in doUpdate(). The run has just a single dirty range, so if
+   there's one already, the result is the shorter of the two ranges that cover
+   both. */
+void markRingStripSegmentsDirty(Implementation::LineLayerRun& run, UnsignedInt begin, UnsignedInt count) {
+    const UnsignedInt capacity = run.pointCount;
+    if(begin >= capacity)
+        begin -= capacity;
+    if(count >= capacity) {
+        run.ringDirtySegmentOffset = 0;
+        run.ringDirtySegmentCount = capacity;
+        return;
+    }
+
+    if(!run.ringDirtySegmentCount) {
+        run.ringDirtySegmentOffset = begin;
+        run.ringDirtySegmentCount = count;
+        return;
+    }
+
+    /* Either extend the existing range to the end of the new one, or extend
+       the new range to the end of the existing one */
+    const UnsignedInt existingBegin = run.ringDirtySegmentOffset;
+    const UnsignedInt existingCount = run.ringDirtySegmentCount;
+    const UnsignedInt countFromExisting = Math::max(existingCount, (begin + capacity - existingBegin) % capacity + count);
+    const UnsignedInt countFromNew = Math::max(count, (existingBegin + capacity - begin) % capacity + existingCount);
+    if(countFromExisting <= countFromNew) {
+        run.ringDirtySegmentCount = Math::min(countFromExisting, capacity);
+    } else {
+        run.ringDirtySegmentOffset = begin;
+        run.ringDirtySegmentCount = Math::min(countFromNew, capacity);
+    }
+}
+
+/* Whether given ring strip segment is between the points that are present */
+bool isRingStripSegmentDrawn(const Implementation::LineLayerRun& run, const UnsignedInt segment) {
+    const UnsignedInt capacity = run.pointCount;
+    return (segment + capacity - run.ringPointOffset) % capacity + 1 < run.ringPointCount;
+}
+
+/* Ring strips have a fixed amount of 12 indices for each segment, 6 for the
+   segment itself and 6 for a join with the next one, so indices of a single
+   segment can be regenerated without touching the others. Segments that
+   aren't drawn and joins that aren't present degenerate to a single vertex.
+   See doUpdate() for details about the index order. */
+void fillRingStripSegmentIndices(const Containers::ArrayView<UnsignedInt> indexData, const Implementation::LineLayerRun& run, const Containers::ArrayView<const Implementation::LineLayerPointIndex> pointIndices, const UnsignedInt vertexOffset, const UnsignedInt segment) {
+    CORRADE_INTERNAL_DEBUG_ASSERT(indexData.size() == 12);
+    const UnsignedInt segmentVertexOffset = vertexOffset + segment*4;
+    if(!isRingStripSegmentDrawn(run, segment)) {
+        for(UnsignedInt& i: indexData)
+            i = segmentVertexOffset;
+        return;
+    }
+
+    indexData[0] = segmentVertexOffset + 2;
+    indexData[1] = segmentVertexOffset + 0;
+    indexData[2] = segmentVertexOffset + 1;
+
+    indexData[3] = segmentVertexOffset + 1;
+    indexData[4] = segmentVertexOffset + 3;
+    indexData[5] = segmentVertexOffset + 2;
+
+    /* Unlike with strips and loops, the join is always added from the end of
+       the segment, including the join that wraps around the end of the
+       capacity. The neighbor is then always the second index of the next
+       segment, so the closer point is the first one. */
+    const UnsignedInt neighbor = pointIndices[segment*2 + 1].neighbor;
+    if(neighbor == ~UnsignedInt{}) {
+        for(UnsignedInt& i: indexData.exceptPrefix(6))
+            i = segmentVertexOffset + 3;
+        return;
+    }
+
+    CORRADE_INTERNAL_DEBUG_ASSERT(neighbor & 1);
+    const UnsignedInt joinVertexOffset = vertexOffset + (neighbor - 1)*2;
+
+    indexData[6] = segmentVertexOffset + 2;
+    indexData[7] = segmentVertexOffset + 3;
+    indexData[8] = joinVertexOffset + 0;
+
+    indexData[9] = joinVertexOffset + 0;
+    indexData[10] = segmentVertexOffset + 3;
+    indexData[11] = joinVertexOffset + 1;
+}
+
+}
+
 UnsignedInt LineLayer::createRun(const UnsignedInt dataId, const UnsignedInt indexCount, const UnsignedInt pointCount) {
     State& state = static_cast<State&>(*_state);
     const UnsignedInt run = state.runs.size();
@@ -209,7 +299,7 @@ UnsignedInt LineLayer::createRun(const UnsignedInt dataId, const UnsignedInt ind
     const UnsignedInt pointIndexOffset = state.pointIndices.size();
     arrayAppend(state.points, NoInit, pointCount);
     arrayAppend(state.pointIndices, NoInit, indexCount);
-    arrayAppend(state.runs, InPlaceInit, pointOffset, pointCount, pointIndexOffset, indexCount, dataId, 0u);
+    arrayAppend(state.runs, InPlaceInit, pointOffset, pointCount, pointIndexOffset, indexCount, dataId, 0u, 0u, ~UnsignedInt{}, 0u, 0u, ~UnsignedInt{});
     return run;
 }
 
@@ -379,6 +469,107 @@ void LineLayer::fillLoopIndices(const char*
     }
 }
 
+void LineLayer::fillRingStripIndices(const UnsignedInt dataId) {
+    State& state = static_cast<State&>(*_state);
+    Implementation::LineLayerRun& run = state.runs[state.data[dataId].run];
+
+    /* A 0, 1, 1, 2, 2, 3, ..., n - 1, 0 index sequence, same as for a loop.
+       Unlike with strips and loops, these stay the same for the whole
+       lifetime of the run, and only the neighbors get updated in
+       appendRingStripPoints() as points get added and dropped. With no points
+       there are no neighbors either. */
+    const UnsignedInt capacity = run.pointCount;
+    const Containers::ArrayView<Implementation::LineLayerPointIndex> pointIndices = state.pointIndices.sliceSize(run.indexOffset, run.indexCount);
+    for(UnsignedInt i = 0; i != capacity; ++i) {
+        pointIndices[i*2 + 0].index = i;
+        pointIndices[i*2 + 0].neighbor = ~UnsignedInt{};
+        pointIndices[i*2 + 1].index = i + 1 == capacity ? 0 : i + 1;
+        pointIndices[i*2 + 1].neighbor = ~UnsignedInt{};
+    }
+
+    /* Vertex data get generated in doUpdate() for the whole run, including the
+       segments that aren't drawn, so initialize all points to avoid reading
+       uninitialized memory there */
+    for(Implementation::LineLayerPoint& point: state.points.sliceSize(run.pointOffset, run.pointCount)) {
+        point.position = {};
+        point.color = Color4{1.0f};
+    }
+
+    run.joinCount = 0;
+    run.ringPointOffset = 0;
+    run.ringPointCount = 0;
+    run.ringDirtySegmentOffset = 0;
+    run.ringDirtySegmentCount = 0;
+}
+
+void LineLayer::appendRingStripPoints(const char*
+    #ifndef CORRADE_NO_ASSERT
+    const messagePrefix
+    #endif
+, const UnsignedInt dataId, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
+    CORRADE_ASSERT(colors.isEmpty() || colors.size() == points.size(),
+        messagePrefix << "expected either no or" << points.size() << "colors, got" << colors.size(), );
+
+    State& state = static_cast<State&>(*_state);
+    Implementation::LineLayerRun& run = state.runs[state.data[dataId].run];
+    CORRADE_INTERNAL_DEBUG_ASSERT(run.ringPointCount != ~UnsignedInt{});
+    const UnsignedInt capacity = run.pointCount;
+    const Containers::ArrayView<Implementation::LineLayerPoint> pointData = state.points.sliceSize(run.pointOffset, run.pointCount);
+    const Containers::ArrayView<Implementation::LineLayerPointIndex> pointIndices = state.pointIndices.sliceSize(run.indexOffset, run.indexCount);
+
+    /* Points that would get dropped again by the end of this call don't need
+       to be added at all, so the work done is proportional to the appended
+       count and never larger than the capacity */
+    for(std::size_t i = points.size() > capacity ? points.size() - capacity : 0; i != points.size(); ++i) {
+        /* If the ring is full, drop the oldest point. The segment starting at
+           it isn't drawn anymore, and the following segment becomes the first
+           one, thus it has no neighbor at its begin. */
+        if(run.ringPointCount == capacity) {
+            /* The dropped segment and the new first one change. The new point
+               is put right before the dropped one, so the segments it affects
+               are directly preceding, mark them all as a single range. */
+            markRingStripSegmentsDirty(run, run.ringPointOffset + capacity - 2, 4);
+            run.ringPointOffset = run.ringPointOffset + 1 == capacity ? 0 : run.ringPointOffset + 1;
+            --run.ringPointCount;
+            pointIndices[run.ringPointOffset*2].neighbor = ~UnsignedInt{};
+        }
+
+        /* Put the new point right after the newest one, into the slot that
+           was either unused or just freed above */
+        UnsignedInt point = run.ringPointOffset + run.ringPointCount;
+        if(point >= capacity)
+            point -= capacity;
+        pointData[point].position = points[i];
+        if(colors.isEmpty())
+            pointData[point].color = Color4{1.0f};
+        else
+            pointData[point].color = colors[i];
+        ++run.ringPointCount;
+
+        /* If this isn't the first point, the segment ending at it becomes the
+           last one in the strip, thus with no neighbor at its end. If it isn't
+           the first segment either, join it with the previous one. Same as in
+           fillStripIndices(), the neighbor is not a point index but an index
+           index, pointing to the further point of the neighboring segment. */
+        if(run.ringPointCount >= 2) {
+            /* The segment ending at the new point gets drawn, and the
+               previous one gets a join with it and a new next position */
+            markRingStripSegmentsDirty(run, point + capacity - 2, 2);
+            const UnsignedInt segment = point ? point - 1 : capacity - 1;
+            pointIndices[segment*2 + 1].neighbor = ~UnsignedInt{};
+            if(run.ringPointCount >= 3) {
+                const UnsignedInt previousSegment = segment ? segment - 1 : capacity - 1;
+                pointIndices[segment*2 + 0].neighbor = previousSegment*2 + 0;
+                pointIndices[previousSegment*2 + 1].neighbor = segment*2 + 1;
+            } else pointIndices[segment*2 + 0].neighbor = ~UnsignedInt{};
+        }
+    }
+
+    /* Same as in fillStripIndices(), except that there can be also just a
+       single point, which draws nothing */
+    run.joinCount = run.ringPointCount >= 2 ? (run.ringPointCount - 2)*2 : 0;
+}
+
 void LineLayer::fillPoints(const char*
     #ifndef CORRADE_NO_ASSERT
     const messagePrefix
@@ -424,6 +615,12 @@ DataHandle LineLayer::createInternal(const char*
     data.color = Color4{1.0f};
     data.padding = Vector4{};
 
+    /* AbstractLayer::create() set LayerState::NeedsDataUpdate already, but
+       the new run affects the vertex and index layout of all data, so make
+       sure it isn't treated as an update of just data marked with
+       setNeedsDataUpdate() */
+    setNeedsUpdate(LayerState::NeedsDataUpdate);
+
     /* Asserting after populating the run and returning the data handle to not
        cause issues in the caller when testing graceful asserts */
     CORRADE_ASSERT(style < sharedState.styleCount + sharedState.dynamicStyleCount,
@@ -470,6 +667,28 @@ DataHandle LineLayer::createLoop(const UnsignedInt style, const std::initializer
     return createLoop(style, Containers::stridedArrayView(points), Containers::stridedArrayView(colors), node);
 }
 
+DataHandle LineLayer::createRingStrip(const UnsignedInt style, const UnsignedInt capacity, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors, const NodeHandle node) {
+    CORRADE_ASSERT(capacity >= 2,
+        "Ui::LineLayer::createRingStrip(): expected capacity to be at least 2, got" << capacity, {});
+    /* The whole capacity is reserved upfront, with a segment slot for every
+       point including the one that wraps around */
+    const DataHandle handle = createInternal("Ui::LineLayer::createRingStrip():", style, 2*capacity, capacity, node);
+    fillRingStripIndices(dataHandleId(handle));
+    appendRingStripPoints("Ui::LineLayer::createRingStrip():", dataHandleId(handle), points, colors);
+
+    /* The whole run gets generated in doUpdate() due to the NeedsDataUpdate
+       set by createInternal(), so there's no need to track the segments
+       touched by the initial append */
+    State& state = static_cast<State&>(*_state);
+    state.runs[state.data[dataHandleId(handle)].run].ringDirtySegmentCount = 0;
+
+    return handle;
+}
+
+DataHandle LineLayer::createRingStrip(const UnsignedInt style, const UnsignedInt capacity, const std::initializer_list<Vector2> points, std::initializer_list<Color4> colors, const NodeHandle node) {
+    return createRingStrip(style, capacity, Containers::stridedArrayView(points), Containers::stridedArrayView(colors), node);
+}
+
 void LineLayer::remove(const DataHandle handle) {
     AbstractVisualLayer::remove(handle);
     removeInternal(dataHandleId(handle));
@@ -505,29 +724,61 @@ void LineLayer::removeInternal(const UnsignedInt id) {
 UnsignedInt LineLayer::indexCount(const DataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::LineLayer::indexCount(): invalid handle" << handle, {});
-    const State& state = static_cast<const State&>(*_state);
-    return state.runs[state.data[dataHandleId(handle)].run].indexCount;
+    return indexCountInternal(dataHandleId(handle));
 }
 
 UnsignedInt LineLayer::indexCount(const LayerDataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::LineLayer::indexCount(): invalid handle" << handle, {});
-    const State& state = static_cast<const State&>(*_state);
-    return state.runs[state.data[layerDataHandleId(handle)].run].indexCount;
+    return indexCountInternal(layerDataHandleId(handle));
 }
 
 UnsignedInt LineLayer::pointCount(const DataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::LineLayer::pointCount(): invalid handle" << handle, {});
-    const State& state = static_cast<const State&>(*_state);
-    return state.runs[state.data[dataHandleId(handle)].run].pointCount;
+    return pointCountInternal(dataHandleId(handle));
 }
 
 UnsignedInt LineLayer::pointCount(const LayerDataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::LineLayer::pointCount(): invalid handle" << handle, {});
+    return pointCountInternal(layerDataHandleId(handle));
+}
+
+UnsignedInt LineLayer::indexCountInternal(const UnsignedInt id) const {
+    const State& state = static_cast<const State&>(*_state);
+    const Implementation::LineLayerRun& run = state.runs[state.data[id].run];
+    /* For ring strips report the indices of the points actually present, not
+       of the whole capacity */
+    if(run.ringPointCount != ~UnsignedInt{})
+        return run.ringPointCount >= 2 ? 2*run.ringPointCount - 2 : 0;
+    return run.indexCount;
+}
+
+UnsignedInt LineLayer::pointCountInternal(const UnsignedInt id) const {
+    const State& state = static_cast<const State&>(*_state);
+    const Implementation::LineLayerRun& run = state.runs[state.data[id].run];
+    if(run.ringPointCount != ~UnsignedInt{})
+        return run.ringPointCount;
+    return run.pointCount;
+}
+
+UnsignedInt LineLayer::ringStripCapacity(const DataHandle handle) const {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::LineLayer::ringStripCapacity(): invalid handle" << handle, {});
+    return ringStripCapacityInternal(dataHandleId(handle));
+}
+
+UnsignedInt LineLayer::ringStripCapacity(const LayerDataHandle handle) const {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::LineLayer::ringStripCapacity(): invalid handle" << handle, {});
+    return ringStripCapacityInternal(layerDataHandleId(handle));
+}
+
+UnsignedInt LineLayer::ringStripCapacityInternal(const UnsignedInt id) const {
     const State& state = static_cast<const State&>(*_state);
-    return state.runs[state.data[layerDataHandleId(handle)].run].pointCount;
+    const Implementation::LineLayerRun& run = state.runs[state.data[id].run];
+    return run.ringPointCount != ~UnsignedInt{} ? run.pointCount : 0;
 }
 
 void LineLayer::setLine(const DataHandle handle, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
@@ -560,7 +811,7 @@ void LineLayer::setLineInternal(const UnsignedInt id, const Containers::StridedA
     {
         Implementation::LineLayerData& data = state.data[id];;
         Implementation::LineLayerRun& run = state.runs[data.run];
-        if(run.indexCount != indices.size() || run.pointCount != points.size()) {
+        if(run.indexCount != indices.size() || run.pointCount != points.size() || run.ringPointCount != ~UnsignedInt{}) {
             /* The run will be removed during the next recompaction in
                doUpdate(). Both `indexOffset` and `pointOffset` are marked to
                avoid inconsistency. */
@@ -607,17 +858,19 @@ void LineLayer::setLineStripInternal(const UnsignedInt id, const Containers::Str
        mark it as unused and create a new one. Compared to the TextLayer, where
        the assumption is that text updates are almost never the same length,
        here it's quite likely. */
+    bool runReused = true;
     {
         Implementation::LineLayerData& data = state.data[id];;
         Implementation::LineLayerRun& run = state.runs[data.run];
         const UnsignedInt indexCount = points.isEmpty() ? 0 : points.size()*2 - 2;
-        if(run.indexCount != indexCount || run.pointCount != points.size()) {
+        if(run.indexCount != indexCount || run.pointCount != points.size() || run.ringPointCount != ~UnsignedInt{}) {
             /* The run will be removed during the next recompaction in
                doUpdate(). Both `indexOffset` and `pointOffset` are marked to
                avoid inconsistency. */
             run.indexOffset = ~UnsignedInt{};
             run.pointOffset = ~UnsignedInt{};
 
+            runReused = false;
             data.run = createRun(id, indexCount, points.size());
         }
     }
@@ -629,7 +882,13 @@ void LineLayer::setLineStripInternal(const UnsignedInt id, const Containers::Str
     fillPoints("Ui::LineLayer::setLineStrip():", id, points, colors);
     fillStripIndices("Ui::LineLayer::setLineStrip():", id);
 
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    /* If the run got reused, only vertices of this data change, as the
+       strip / loop index topology is the same for the same point count.
+       Otherwise the runs get recompacted, which affects all data. */
+    if(runReused)
+        setNeedsDataUpdate(id);
+    else
+        setNeedsUpdate(LayerState::NeedsDataUpdate);
 }
 
 void LineLayer::setLineLoop(const DataHandle handle, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
@@ -659,17 +918,19 @@ void LineLayer::setLineLoopInternal(const UnsignedInt id, const Containers::Stri
        mark it as unused and create a new one. Compared to the TextLayer, where
        the assumption is that text updates are almost never the same length,
        here it's quite likely. */
+    bool runReused = true;
     {
         Implementation::LineLayerData& data = state.data[id];;
         Implementation::LineLayerRun& run = state.runs[data.run];
         const UnsignedInt indexCount = points.size()*2;
-        if(run.indexCount != indexCount || run.pointCount != points.size()) {
+        if(run.indexCount != indexCount || run.pointCount != points.size() || run.ringPointCount != ~UnsignedInt{}) {
             /* The run will be removed during the next recompaction in
                doUpdate(). Both `indexOffset` and `pointOffset` are marked to
                avoid inconsistency. */
             run.indexOffset = ~UnsignedInt{};
             run.pointOffset = ~UnsignedInt{};
 
+            runReused = false;
             data.run = createRun(id, indexCount, points.size());
         }
     }
@@ -681,7 +942,50 @@ void LineLayer::setLineLoopInternal(const UnsignedInt id, const Containers::Stri
     fillLoopIndices("Ui::LineLayer::setLineLoop():", id);
     fillPoints("Ui::LineLayer::setLineLoop():", id, points, colors);
 
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    /* If the run got reused, only vertices of this data change, as the
+       strip / loop index topology is the same for the same point count.
+       Otherwise the runs get recompacted, which affects all data. */
+    if(runReused)
+        setNeedsDataUpdate(id);
+    else
+        setNeedsUpdate(LayerState::NeedsDataUpdate);
+}
+
+void LineLayer::appendRingStrip(const DataHandle handle, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::LineLayer::appendRingStrip(): invalid handle" << handle, );
+    appendRingStripInternal(dataHandleId(handle), points, colors);
+}
+
+void LineLayer::appendRingStrip(const DataHandle handle, const std::initializer_list<Vector2> points, const std::initializer_list<Color4> colors) {
+    appendRingStrip(handle, Containers::stridedArrayView(points), Containers::stridedArrayView(colors));
+}
+
+void LineLayer::appendRingStrip(const LayerDataHandle handle, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
+    CORRADE_ASSERT(isHandleValid(handle),
+        "Ui::LineLayer::appendRingStrip(): invalid handle" << handle, );
+    appendRingStripInternal(layerDataHandleId(handle), points, colors);
+}
+
+void LineLayer::appendRingStrip(const LayerDataHandle handle, const std::initializer_list<Vector2> points, const std::initializer_list<Color4> colors) {
+    appendRingStrip(handle, Containers::stridedArrayView(points), Containers::stridedArrayView(colors));
+}
+
+void LineLayer::appendRingStripInternal(const UnsignedInt id, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors) {
+    #ifndef CORRADE_NO_ASSERT
+    State& state = static_cast<State&>(*_state);
+    #endif
+    CORRADE_ASSERT(state.runs[state.data[id].run].ringPointCount != ~UnsignedInt{},
+        "Ui::LineLayer::appendRingStrip(): line wasn't created with createRingStrip()", );
+
+    /* Unlike setLine*(), the run is always reused, only the points and
+       neighbors affected by the append get updated */
+    appendRingStripPoints("Ui::LineLayer::appendRingStrip():", id, points, colors);
+
+    /* Only the segments marked dirty by appendRingStripPoints() get
+       regenerated and uploaded in doUpdate(), the rest of the data stays the
+       same, so there's no need for NeedsDataUpdate */
+    setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
 }
 
 Color4 LineLayer::color(const DataHandle handle) const {
@@ -710,7 +1014,7 @@ void LineLayer::setColor(const LayerDataHandle handle, const Color4& color) {
 
 void LineLayer::setColorInternal(const UnsignedInt id, const Color4& color) {
     static_cast<State&>(*_state).data[id].color = color;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 Containers::Optional<LineAlignment> LineLayer::alignment(const DataHandle handle) const {
@@ -745,7 +1049,7 @@ void LineLayer::setAlignment(const LayerDataHandle handle, const Containers::Opt
 
 void LineLayer::setAlignmentInternal(const UnsignedInt id, const Containers::Optional<LineAlignment> alignment) {
     static_cast<State&>(*_state).data[id].alignment = alignment ? *alignment : LineAlignment(0xff);
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 Vector4 LineLayer::padding(const DataHandle handle) const {
@@ -774,7 +1078,7 @@ void LineLayer::setPadding(const LayerDataHandle handle, const Vector4& padding)
 
 void LineLayer::setPaddingInternal(const UnsignedInt id, const Vector4& padding) {
     static_cast<State&>(*_state).data[id].padding = padding;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 LayerFeatures LineLayer::doFeatures() const {
@@ -807,6 +1111,108 @@ void LineLayer::doClean(const Containers::BitArrayView dataIdsToRemove) {
        remove(). See a comment there for more information. */
 }
 
+void LineLayer::fillVertices(const UnsignedInt dataId, const Vector2& nodeOffset, const Vector2& nodeSize, const Float nodeOpacity, const UnsignedInt indexBegin, const UnsignedInt indexEnd, const bool updatePositions, const bool updateAppearance) {
+    auto& state = static_cast<State&>(*_state);
+    auto& sharedState = static_cast<Shared::State&>(state.shared);
+    const Implementation::LineLayerData& data = state.data[dataId];
+    const Implementation::LineLayerRun& run = state.runs[data.run];
+    /* Always whole segments */
+    CORRADE_INTERNAL_DEBUG_ASSERT(indexBegin % 2 == 0 && indexEnd % 2 == 0 && indexEnd <= run.indexCount);
+
+    /* Fill in vertices in the same order as the original runs */
+    const Containers::ArrayView<const Implementation::LineLayerPointIndex> pointIndices = state.pointIndices.sliceSize(run.indexOffset, run.indexCount);
+    const Containers::StridedArrayView1D<const Implementation::LineLayerPoint> points = state.points.sliceSize(run.pointOffset, run.pointCount);
+    const Containers::StridedArrayView1D<Implementation::LineLayerVertex> vertexData = state.vertices.sliceSize(run.indexOffset*2, run.indexCount*2);
+
+    if(updatePositions) {
+        /* Align the run relative to the node area */
+        const Vector4 padding = data.padding + sharedState.styles[data.calculatedStyle].padding;
+        Vector2 offset = nodeOffset + padding.xy();
+        const Vector2 size = nodeSize - padding.xy() - Math::gather<'z', 'w'>(padding);
+        /* If per-data alignment is set, use that, otherwise take one
+           from the style */
+        const LineAlignment alignment = data.alignment != LineAlignment(0xff) ?
+            data.alignment : sharedState.styles[data.calculatedStyle].alignment;
+        const UnsignedByte alignmentHorizontal = UnsignedByte(alignment) & Implementation::LineAlignmentHorizontal;
+        if(alignmentHorizontal == Implementation::LineAlignmentLeft) {
+            offset.x() += 0.0f;
+        } else if(alignmentHorizontal == Implementation::LineAlignmentRight) {
+            offset.x() += size.x();
+        } else if(alignmentHorizontal == Implementation::LineAlignmentCenter) {
+            offset.x() += size.x()*0.5f;
+        } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        const UnsignedByte alignmentVertical = UnsignedByte(alignment) & Implementation::LineAlignmentVertical;
+        if(alignmentVertical == Implementation::LineAlignmentTop) {
+            offset.y() += 0.0f;
+        } else if(alignmentVertical == Implementation::LineAlignmentBottom) {
+            offset.y() += size.y();
+        } else if(alignmentVertical == Implementation::LineAlignmentMiddle) {
+            offset.y() += size.y()*0.5f;
+        } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+        /* Position is the same for both copies of the segment
+           endpoint. If this is the first index of the pair, the
+           previous position is from the potential connected neighbor,
+           if any, the next position is the second position in the
+           pair. If this is the second index of the pair, the previous
+           position is the first position in the pair, the next
+           position is from the potential connected neigbor, if any.
+
+           The neigbor is not the point index but the index index as
+           we need to know its position in the output vertex stream in
+           the index buffer population in doUpdate(), thus there's one extra
+           indirection. */
+        for(std::size_t i = indexBegin; i != indexEnd; ++i) {
+            const Vector2 position = points[pointIndices[i].index].position + offset;
+            const Vector2 neighborPosition = pointIndices[i].neighbor != ~UnsignedInt{} ?
+                points[pointIndices[pointIndices[i].neighbor].index].position + offset : offset;
+            vertexData[i*2 + 0].position =
+                vertexData[i*2 + 1].position =
+                    position;
+            if((i & 1) == 0) {
+                vertexData[i*2 + 0].previousPosition =
+                    vertexData[i*2 + 1].previousPosition =
+                        neighborPosition;
+                vertexData[i*2 + 0].nextPosition =
+                    vertexData[i*2 + 1].nextPosition =
+                        points[pointIndices[i + 1].index].position + offset;
+            } else {
+                vertexData[i*2 + 0].previousPosition =
+                    vertexData[i*2 + 1].previousPosition =
+                        points[pointIndices[i - 1].index].position + offset;
+                vertexData[i*2 + 0].nextPosition =
+                    vertexData[i*2 + 1].nextPosition =
+                        neighborPosition;
+            }
+        }
+    }
+
+    if(updateAppearance) {
+        const Color4 color = data.color*nodeOpacity;
+        /* Annotation is the lower 3 bits, style index is above that */
+        const UnsignedInt styleUniform = sharedState.styles[data.calculatedStyle].uniform << 3;
+        for(std::size_t i = indexBegin; i != indexEnd; ++i) {
+            /* Color is the same for both copies of the segment
+               endpoint */
+            vertexData[i*2 + 0].color =
+                vertexData[i*2 + 1].color =
+                    points[pointIndices[i].index].color*color;
+
+            /* If this is the first index of the pair, it's marked as a
+               Begin. First of the two copies of the segment endpoint
+               gets marked as Up. Additionally, if there's a connected
+               neighbor, both are marked as Join. */
+            UnsignedInt annotation = styleUniform;
+            if((i & 1) == 0)
+                annotation |= Implementation::LineVertexAnnotationBegin;
+            if(pointIndices[i].neighbor != ~UnsignedInt{})
+                annotation |= Implementation::LineVertexAnnotationJoin;
+            vertexData[i*2 + 0].annotationStyleUniform = annotation|Implementation::LineVertexAnnotationUp;
+            vertexData[i*2 + 1].annotationStyleUniform = annotation;
+        }
+    }
+}
+
 void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArrayView1D<const UnsignedInt>& dataIds, const Containers::StridedArrayView1D<const UnsignedInt>& clipRectIds, const Containers::StridedArrayView1D<const UnsignedInt>& clipRectDataCounts, const Containers::StridedArrayView1D<const Vector2>& nodeOffsets, const Containers::StridedArrayView1D<const Vector2>& nodeSizes, const Containers::StridedArrayView1D<const Float>& nodeOpacities, const Containers::BitArrayView nodesEnabled, const Containers::StridedArrayView1D<const Vector2>& clipRectOffsets, const Containers::StridedArrayView1D<const Vector2>& clipRectSizes, const Containers::StridedArrayView1D<const Vector2>& compositeRectOffsets, const Containers::StridedArrayView1D<const Vector2>& compositeRectSizes) {
     /* The base implementation populates data.calculatedStyle */
     AbstractVisualLayer::doUpdate(states, dataIds, clipRectIds, clipRectDataCounts, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, clipRectOffsets, clipRectSizes, compositeRectOffsets, compositeRectSizes);
@@ -820,13 +1226,21 @@ void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArra
 
     /* Recompact the line data by removing unused runs. Do this only if data
        actually change, this isn't affected by anything node-related */
-    /** @todo further restrict this to just NeedsCommonDataUpdate which gets
+    /** @todo further restrict this to just a dedicated state which gets
         set by setLine*(), remove() etc that actually produces unused runs, but
         not setColor() and such? the recompaction however implies a need to
         update the actual index buffer etc anyway, so a dedicated state won't
         make that update any smaller, and we'd now trigger it from clean() and
         remove() as well, which we didn't need to before */
-    if(states >= LayerState::NeedsDataUpdate) {
+    /* If the data update was caused only by particular data being marked
+       with setNeedsDataUpdate(), such as from setColor() or setStyle(), their
+       runs didn't change size and no new runs were added, so the recompaction
+       as well as index generation can be skipped and only vertices of the
+       marked data get regenerated below. Unused runs from remove() stay in
+       place until the next full data update. */
+    const bool dirtyDataOnly = state.updateDirtyDataOnly;
+    const Containers::BitArrayView dirtyData = state.dirtyData;
+    if(states >= LayerState::NeedsDataUpdate && !dirtyDataOnly) {
         std::size_t outputPointIndexOffset = 0;
         std::size_t outputPointOffset = 0;
         std::size_t outputRunOffset = 0;
@@ -887,38 +1301,69 @@ void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArra
     /* Fill in indices in desired order if either the data themselves or the
        node order changed. Keep the checks in sync with
        LineLayerGL::doUpdate(). */
-    if(states >= LayerState::NeedsNodeOrderUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
+    const bool updateIndices =
+        states >= LayerState::NeedsNodeOrderUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    if(updateIndices) {
         /* Index offsets for each run, plus one more for the last run */
         arrayResize(state.indexDrawOffsets, NoInit, dataIds.size() + 1);
 
-        /* Calculate how many line segments and joins we'll draw */
+        /* Ring strips that end up not being drawn have no indices to update
+           in the partial update below */
+        for(Implementation::LineLayerRun& run: state.runs)
+            run.ringIndexDrawOffset = ~UnsignedInt{};
+
+        /* Calculate how many line segments and joins we'll draw. For ring
+           strips it's 12 indices for every segment in the capacity, see
+           fillRingStripSegmentIndices() for details. */
         UnsignedInt drawSegmentCount = 0;
         UnsignedInt drawJoinCount = 0;
+        UnsignedInt drawRingSegmentCount = 0;
         for(const UnsignedInt id: dataIds) {
             const Implementation::LineLayerData& data = state.data[id];
             const Implementation::LineLayerRun& run = state.runs[data.run];
             /* Every two indices is one segment */
             CORRADE_INTERNAL_DEBUG_ASSERT(run.indexCount % 2 == 0);
-            drawSegmentCount += run.indexCount/2;
-            drawJoinCount += run.joinCount;
+            if(run.ringPointCount == ~UnsignedInt{}) {
+                drawSegmentCount += run.indexCount/2;
+                drawJoinCount += run.joinCount;
+            } else drawRingSegmentCount += run.indexCount/2;
         }
 
         /* Generate index data */
-        arrayResize(state.indices, NoInit, drawSegmentCount*6 + drawJoinCount*3);
+        const UnsignedInt drawIndexCount = drawSegmentCount*6 + drawJoinCount*3 + drawRingSegmentCount*12;
+        arrayResize(state.indices, NoInit, drawIndexCount);
         UnsignedInt indexOffset = 0;
         for(std::size_t i = 0; i != dataIds.size(); ++i) {
             const Implementation::LineLayerData& data = state.data[dataIds[i]];
-            const Implementation::LineLayerRun& run = state.runs[data.run];
+            Implementation::LineLayerRun& run = state.runs[data.run];
 
             /* Generate indices in draw order. Remeber the offset for each data
                to draw from later. */
             state.indexDrawOffsets[i] = indexOffset;
             const Containers::ArrayView<const Implementation::LineLayerPointIndex> pointIndices = state.pointIndices.sliceSize(run.indexOffset, run.indexCount);
+            /* The output vertices are in the order defined by the input index
+               buffer, and for every pair of input indices defining a line
+               segment we have four output vertices */
+            const UnsignedInt vertexOffset = (run.indexOffset/2)*4;
+
+            /* Ring strips have all segment slots in the capacity filled,
+               remember where they are for partial updates of just the
+               segments changed by appendRingStrip() */
+            if(run.ringPointCount != ~UnsignedInt{}) {
+                const UnsignedInt runSegmentCapacity = run.indexCount/2;
+                const Containers::ArrayView<UnsignedInt> indexData = state.indices.sliceSize(indexOffset, runSegmentCapacity*12);
+                for(UnsignedInt j = 0; j != runSegmentCapacity; ++j)
+                    fillRingStripSegmentIndices(indexData.sliceSize(j*12, 12), run, pointIndices, vertexOffset, j);
+                run.ringIndexDrawOffset = indexOffset;
+                indexOffset += indexData.size();
+                continue;
+            }
+
             /* Every two input indices is one segment, every segment is six
                output indices, every pair of joins is two triangles */
-            const Containers::ArrayView<UnsignedInt> indexData = state.indices.sliceSize(indexOffset, (run.indexCount/2)*6 + run.joinCount*3);
+            const UnsignedInt segmentCount = run.indexCount/2;
+            const Containers::ArrayView<UnsignedInt> indexData = state.indices.sliceSize(indexOffset, segmentCount*6 + run.joinCount*3);
 
             /* The order is chosen in a way that makes it possible to interpret
                the 6 indices as 3 lines instead of 2 triangles, and
@@ -934,11 +1379,7 @@ void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArra
 
                This matches what's done in MeshTools::generateLines(). */
             std::size_t runIndexOffset = 0;
-            /* The output vertices are in the order defined by the input index
-               buffer, and for every pair of input indices defining a line
-               segment we have four output vertices */
-            const UnsignedInt vertexOffset = (run.indexOffset/2)*4;
-            for(std::size_t j = 0, jMax = run.indexCount/2; j != jMax; ++j) {
+            for(std::size_t j = 0; j != segmentCount; ++j) {
                 const UnsignedInt segmentVertexOffset = vertexOffset + j*4;
 
                 indexData[runIndexOffset++] = segmentVertexOffset + 2;
@@ -992,21 +1433,35 @@ void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArra
             indexOffset += indexData.size();
         }
 
-        CORRADE_INTERNAL_ASSERT(indexOffset == drawSegmentCount*6 + drawJoinCount*3);
+        CORRADE_INTERNAL_ASSERT(indexOffset == drawIndexCount);
         state.indexDrawOffsets[dataIds.size()] = indexOffset;
+
+        /* All indices got regenerated, so all of them need to be uploaded */
+        state.indexDirtyRange.add(0, state.indices.size()*sizeof(UnsignedInt));
     }
 
     /* Fill in vertex data if the data themselves, the node offset/size or node
        enablement (and thus calculated styles) or opacities (and thus
-       calculated colors) changed. Keep the checks in sync with
-       LineLayerGL::doUpdate(). */
-    /** @todo split this further to just position-related data update and other
-        data if it shows to help with perf */
-    if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
-       states >= LayerState::NeedsNodeEnabledUpdate ||
-       states >= LayerState::NeedsNodeOpacityUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
+       calculated colors) changed. Similarly to BaseLayer, the vertex
+       attributes are split into two groups -- positions depend on node
+       offsets, sizes, paddings and alignment, while colors and style uniforms
+       depend on node opacities. Node enablement affects both, as the
+       calculated style picks the padding, alignment and the uniform. Each
+       group is then updated only if something it depends on changed. Data
+       that aren't drawn don't get updated at all, see BaseLayer::doUpdate()
+       for why that's fine. If the data update was caused only by particular
+       data being marked, both groups are updated just for those, and for all
+       drawn data only if something else they depend on changed as well. Keep
+       the checks in sync with LineLayerGL::doUpdate(). */
+    const bool updateAllPositions =
+        states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+        states >= LayerState::NeedsNodeEnabledUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    const bool updateAllAppearance =
+        states >= LayerState::NeedsNodeEnabledUpdate ||
+        states >= LayerState::NeedsNodeOpacityUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    if(updateAllPositions || updateAllAppearance || states >= LayerState::NeedsDataUpdate) {
         /* Calculate how many points are there in total. For each segment
            defined by the input index buffer we'll have two points, so
            basically removing the indexing, and then further duplicating them
@@ -1020,117 +1475,69 @@ void LineLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         /* Generate vertex data */
         arrayResize(state.vertices, NoInit, totalPointCount*2);
         for(const UnsignedInt dataId: dataIds) {
+            const bool dirty = dirtyDataOnly && dirtyData[dataId];
+            const bool updatePositions = updateAllPositions || dirty;
+            const bool updateAppearance = updateAllAppearance || dirty;
+            if(!updatePositions && !updateAppearance)
+                continue;
+
             const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
-            const Implementation::LineLayerData& data = state.data[dataId];
-            const Implementation::LineLayerRun& run = state.runs[data.run];
+            const Implementation::LineLayerRun& run = state.runs[state.data[dataId].run];
+            fillVertices(dataId, nodeOffsets[nodeId], nodeSizes[nodeId], nodeOpacities[nodeId], 0, run.indexCount, updatePositions, updateAppearance);
+            state.vertexDirtyRange.add(run.indexOffset*2*sizeof(Implementation::LineLayerVertex), (run.indexOffset + run.indexCount)*2*sizeof(Implementation::LineLayerVertex));
+        }
+    }
+
+    /* Regenerate just the ring strip segments changed by appendRingStrip(),
+       unless the whole vertex and index data got regenerated above already.
+       Ring strips that aren't drawn don't get updated at all, same as above.
+       Keep the checks in sync with LineLayerGL::doUpdate(). */
+    if(states >= LayerState::NeedsCommonDataUpdate) {
+        const Containers::StridedArrayView1D<const Ui::NodeHandle> nodes = this->nodes();
+        for(Implementation::LineLayerRun& run: state.runs) {
+            if(run.indexOffset == ~UnsignedInt{} ||
+               run.ringPointCount == ~UnsignedInt{} ||
+               !run.ringDirtySegmentCount)
+                continue;
+
+            const UnsignedInt segmentBegin = run.ringDirtySegmentOffset;
+            const UnsignedInt segmentCount = run.ringDirtySegmentCount;
+            run.ringDirtySegmentCount = 0;
+            if(run.ringIndexDrawOffset == ~UnsignedInt{})
+                continue;
 
-            /* Fill in vertices in the same order as the original runs */
-            /** @todo ideally this would only be done if some text actually
-                changes, not on every visibility change */
+            /* The vertices of ring strips marked with setNeedsDataUpdate()
+               got regenerated above completely */
+            const bool verticesUpdated = (updateAllPositions && updateAllAppearance) || (dirtyDataOnly && dirtyData[run.data]);
+
+            /* The dirty range can wrap around the end of the capacity, in
+               which case it's two contiguous ranges */
+            const UnsignedInt capacity = run.pointCount;
+            const UnsignedInt segmentRanges[][2]{
+                {segmentBegin, Math::min(segmentBegin + segmentCount, capacity)},
+                {0, segmentBegin + segmentCount > capacity ? segmentBegin + segmentCount - capacity : 0}
+            };
+            const UnsignedInt nodeId = nodeHandleId(nodes[run.data]);
             const Containers::ArrayView<const Implementation::LineLayerPointIndex> pointIndices = state.pointIndices.sliceSize(run.indexOffset, run.indexCount);
-            const Containers::StridedArrayView1D<const Implementation::LineLayerPoint> points = state.points.sliceSize(run.pointOffset, run.pointCount);
-            const Containers::StridedArrayView1D<Implementation::LineLayerVertex> vertexData = state.vertices.sliceSize(run.indexOffset*2, run.indexCount*2);
-            for(std::size_t i = 0, iMax = run.indexCount; i != iMax; ++i) {
-                /* Position and color is the same for both copies of the
-                   segment endpoint */
-                vertexData[i*2 + 0].position =
-                    vertexData[i*2 + 1].position =
-                        points[pointIndices[i].index].position;
-                vertexData[i*2 + 0].color =
-                    vertexData[i*2 + 1].color =
-                        points[pointIndices[i].index].color;
-
-                /* If this is the first index of the pair, it's marked as a
-                   Begin. The previous position is from the potential connected
-                   neighbor, if any, the next position is the second position
-                   in the pair. */
-                if((i & 1) == 0) {
-                    vertexData[i*2 + 0].annotationStyleUniform =
-                        vertexData[i*2 + 1].annotationStyleUniform =
-                            Implementation::LineVertexAnnotationBegin;
-                    vertexData[i*2 + 0].previousPosition =
-                        vertexData[i*2 + 1].previousPosition =
-                            pointIndices[i].neighbor != ~UnsignedInt{} ?
-                                /* The neigbor is not the point index but the
-                                   index index as we need to know its position
-                                   in the output vertex stream in the index
-                                   buffer population above, thus there's one
-                                   extra indirection */
-                                points[pointIndices[pointIndices[i].neighbor].index].position : Vector2{};
-                    vertexData[i*2 + 0].nextPosition =
-                        vertexData[i*2 + 1].nextPosition =
-                            points[pointIndices[i + 1].index].position;
-
-                /* If this is the second index of the pair, it's not marked as
-                   Begin. The previous position is the first position in the
-                   pair, the next position is from the potential connected
-                   neigbor, if any. */
-                } else {
-                    vertexData[i*2 + 0].annotationStyleUniform =
-                        vertexData[i*2 + 1].annotationStyleUniform =
-                            0;
-                    vertexData[i*2 + 0].previousPosition =
-                        vertexData[i*2 + 1].previousPosition =
-                            points[pointIndices[i - 1].index].position;
-                    vertexData[i*2 + 0].nextPosition =
-                        vertexData[i*2 + 1].nextPosition =
-                            pointIndices[i].neighbor != ~UnsignedInt{} ?
-                                /* The neigbor is not the point index but the
-                                   index index as we need to know its position
-                                   in the output vertex stream in the index
-                                   buffer population above, thus there's one
-                                   extra indirection */
-                                points[pointIndices[pointIndices[i].neighbor].index].position : Vector2{};
+            const UnsignedInt vertexOffset = (run.indexOffset/2)*4;
+            for(const auto& range: segmentRanges) {
+                if(range[0] == range[1])
+                    continue;
+
+                /* Every segment is two indices and four vertices */
+                if(!verticesUpdated) {
+                    fillVertices(run.data, nodeOffsets[nodeId], nodeSizes[nodeId], nodeOpacities[nodeId], range[0]*2, range[1]*2, true, true);
+                    state.vertexDirtyRange.add((run.indexOffset + range[0]*2)*2*sizeof(Implementation::LineLayerVertex), (run.indexOffset + range[1]*2)*2*sizeof(Implementation::LineLayerVertex));
                 }
 
-                /* First of the two copies of the segment endpoint gets marked
-                   as Up. Additionally, if there's a connected neighbor, it's
-                   marked as Join. */
-                vertexData[i*2 + 0].annotationStyleUniform |=
-                    Implementation::LineVertexAnnotationUp;
-                if(pointIndices[i].neighbor != ~UnsignedInt{}) {
-                    vertexData[i*2 + 0].annotationStyleUniform |=
-                        Implementation::LineVertexAnnotationJoin;
-                    vertexData[i*2 + 1].annotationStyleUniform |=
-                        Implementation::LineVertexAnnotationJoin;
+                /* Every segment is 12 indices */
+                if(!updateIndices) {
+                    const Containers::ArrayView<UnsignedInt> indexData = state.indices.sliceSize(run.ringIndexDrawOffset, capacity*12);
+                    for(UnsignedInt j = range[0]; j != range[1]; ++j)
+                        fillRingStripSegmentIndices(indexData.sliceSize(j*12, 12), run, pointIndices, vertexOffset, j);
+                    state.indexDirtyRange.add((run.ringIndexDrawOffset + range[0]*12)*sizeof(UnsignedInt), (run.ringIndexDrawOffset + range[1]*12)*sizeof(UnsignedInt));
                 }
             }
-
-            /* Align the run relative to the node area */
-            const Vector4 padding = data.padding + sharedState.styles[data.calculatedStyle].padding;
-            Vector2 offset = nodeOffsets[nodeId] + padding.xy();
-            const Vector2 size = nodeSizes[nodeId] - padding.xy() - Math::gather<'z', 'w'>(padding);
-            /* If per-data alignment is set, use that, otherwise take one from
-               the style */
-            const LineAlignment alignment = data.alignment != LineAlignment(0xff) ?
-                data.alignment : sharedState.styles[data.calculatedStyle].alignment;
-            const UnsignedByte alignmentHorizontal = UnsignedByte(alignment) & Implementation::LineAlignmentHorizontal;
-            if(alignmentHorizontal == Implementation::LineAlignmentLeft) {
-                offset.x() += 0.0f;
-            } else if(alignmentHorizontal == Implementation::LineAlignmentRight) {
-                offset.x() += size.x();
-            } else if(alignmentHorizontal == Implementation::LineAlignmentCenter) {
-                offset.x() += size.x()*0.5f;
-            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-            const UnsignedByte alignmentVertical = UnsignedByte(alignment) & Implementation::LineAlignmentVertical;
-            if(alignmentVertical == Implementation::LineAlignmentTop) {
-                offset.y() += 0.0f;
-            } else if(alignmentVertical == Implementation::LineAlignmentBottom) {
-                offset.y() += size.y();
-            } else if(alignmentVertical == Implementation::LineAlignmentMiddle) {
-                offset.y() += size.y()*0.5f;
-            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            /* Translate the (aligned) run, fill color and style */
-            const Float opacity = nodeOpacities[nodeId];
-            for(Implementation::LineLayerVertex& vertex: vertexData) {
-                vertex.position += offset;
-                vertex.previousPosition += offset;
-                vertex.nextPosition += offset;
-                vertex.color *= data.color*opacity;
-                /* Annotation is the lower 3 bits, style index is above that */
-                vertex.annotationStyleUniform |= sharedState.styles[data.calculatedStyle].uniform << 3;
-            }
         }
     }
 
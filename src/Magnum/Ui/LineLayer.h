@@ -724,6 +724,20 @@ Changing the point / index count is supported however and internally there's
 also no distinction between a strip, loop or an indexed line, so a strip can be
 safely changed to a loop etc.
 
+For lines that continuously grow, such as real-time plots, there's
+@ref createRingStrip() that reserves space for a fixed count of points upfront,
+with @ref appendRingStrip() then adding new points to the end. Once the
+capacity is reached, the oldest points are dropped. The append only touches
+the points being added and their immediate neighbors, instead of filling the
+whole line again, and the line never needs to be reallocated. Similarly, the
+subsequent @ref update() regenerates and uploads just the vertex and index data
+of the segments affected by the append:
+
+@snippet Ui.cpp LineLayer-ring-strip
+
+A ring strip can be changed to a regular line with @ref setLineStrip(),
+@ref setLineLoop() or @ref setLine(), but not the other way around.
+
 @section Ui-LineLayer-debug-integration Debug layer integration
 
 When using @ref Ui-DebugLayer-node-inspect "DebugLayer node inspect" and
@@ -1017,6 +1031,85 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
             return createLoop(UnsignedInt(style), points, colors, node);
         }
 
+        /**
+         * @brief Create a ring line strip
+         * @param style         Style index
+         * @param capacity      Max count of points in the strip
+         * @param points        Initial line strip points, in UI units
+         * @param colors        Optional per-point colors
+         * @param node          Node to attach to
+         * @return New data handle
+         *
+         * Creates a line strip with space for @p capacity points, which is
+         * expected to be at least @cpp 2 @ce. The @p points and @p colors are
+         * then added as if @ref appendRingStrip() was called, meaning that if
+         * there's more than @p capacity points, only the last @p capacity
+         * ones are kept. The @p colors are expected to be either empty or
+         * have the same size as @p points, if empty, the points are white.
+         * Unlike with @ref createStrip(), the @p points can also be a single
+         * point, which isn't drawn until another point is appended. See
+         * @ref create(UnsignedInt, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<const Vector4>&, NodeHandle)
+         * for more information about other arguments.
+         * @see @ref ringStripCapacity(), @ref setAlignment()
+         */
+        /* This one takes Vector4 instead of Color4 because color views are
+           implicitly convertible to vectors but not the other way around */
+        DataHandle createRingStrip(UnsignedInt style, UnsignedInt capacity, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors, NodeHandle node =
+            #ifdef DOXYGEN_GENERATING_OUTPUT
+            NodeHandle::Null
+            #else
+            NodeHandle{} /* To not have to include Handle.h */
+            #endif
+        );
+        /** @overload */
+        /* This one takes a Color4 instead of Vector4 in order to have e.g.
+           0x993366_rgbf implicitly converted to 0x993366ff_rgbaf */
+        DataHandle createRingStrip(UnsignedInt style, UnsignedInt capacity, std::initializer_list<Vector2> points, std::initializer_list<Color4> colors, NodeHandle node =
+            #ifdef DOXYGEN_GENERATING_OUTPUT
+            NodeHandle::Null
+            #else
+            NodeHandle{} /* To not have to include Handle.h */
+            #endif
+        );
+
+        /**
+         * @brief Create a ring line strip with a style index in a concrete enum type
+         *
+         * Casts @p style to @relativeref{Magnum,UnsignedInt} and delegates to
+         * @ref createRingStrip(UnsignedInt, UnsignedInt, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<const Vector4>&, NodeHandle).
+         */
+        template<class StyleIndex
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            /* Accept any enum except NodeHandle to prevent create(node, ...)
+               from being called by mistake */
+            , typename std::enable_if<std::is_enum<StyleIndex>::value && !std::is_same<StyleIndex, NodeHandle>::value, int>::type = 0
+            #endif
+        > DataHandle createRingStrip(StyleIndex style, UnsignedInt capacity, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors, NodeHandle node =
+            #ifdef DOXYGEN_GENERATING_OUTPUT
+            NodeHandle::Null
+            #else
+            NodeHandle{} /* To not have to include Handle.h */
+            #endif
+        ) {
+            return createRingStrip(UnsignedInt(style), capacity, points, colors, node);
+        }
+        /** @overload */
+        template<class StyleIndex
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            /* Accept any enum except NodeHandle to prevent create(node, ...)
+               from being called by mistake */
+            , typename std::enable_if<std::is_enum<StyleIndex>::value && !std::is_same<StyleIndex, NodeHandle>::value, int>::type = 0
+            #endif
+        > DataHandle createRingStrip(StyleIndex style, UnsignedInt capacity, std::initializer_list<Vector2> points, std::initializer_list<Color4> colors, NodeHandle node =
+            #ifdef DOXYGEN_GENERATING_OUTPUT
+            NodeHandle::Null
+            #else
+            NodeHandle{} /* To not have to include Handle.h */
+            #endif
+        ) {
+            return createRingStrip(UnsignedInt(style), capacity, points, colors, node);
+        }
+
         /**
          * @brief Remove a line
          *
@@ -1039,8 +1132,10 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
          * Count of indices passed to @ref create() or @ref setLine(). In case
          * of @ref createStrip() / @ref setLineStrip() the count is
          * @cpp 2*pointCount - 2 @ce, in case of @ref createLoop() /
-         * @ref setLineLoop() the count is @cpp 2*pointCount @ce. Expects that
-         * @p handle is valid.
+         * @ref setLineLoop() the count is @cpp 2*pointCount @ce. In case of
+         * @ref createRingStrip() the count is @cpp 2*pointCount - 2 @ce for
+         * the points currently present, or @cpp 0 @ce if there's less than
+         * two. Expects that @p handle is valid.
          * @see @ref isHandleValid(DataHandle) const, @ref pointCount()
          */
         UnsignedInt indexCount(DataHandle handle) const;
@@ -1061,7 +1156,9 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
          *
          * Count of points passed to @ref create(), @ref createStrip(),
          * @ref createLoop(), @ref setLine(), @ref setLineStrip() or
-         * @ref setLineLoop(). Expects that @p handle is valid.
+         * @ref setLineLoop(). In case of @ref createRingStrip() it's the count
+         * of points currently present, which is at most
+         * @ref ringStripCapacity(). Expects that @p handle is valid.
          * @see @ref isHandleValid(DataHandle) const, @ref indexCount()
          */
         UnsignedInt pointCount(DataHandle handle) const;
@@ -1077,6 +1174,28 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
          */
         UnsignedInt pointCount(LayerDataHandle handle) const;
 
+        /**
+         * @brief Ring line strip capacity
+         *
+         * Capacity passed to @ref createRingStrip(). If the line wasn't
+         * created with @ref createRingStrip() or was subsequently changed with
+         * @ref setLine(), @ref setLineStrip() or @ref setLineLoop(), returns
+         * @cpp 0 @ce. Expects that @p handle is valid.
+         * @see @ref isHandleValid(DataHandle) const, @ref pointCount()
+         */
+        UnsignedInt ringStripCapacity(DataHandle handle) const;
+
+        /**
+         * @brief Ring line strip capacity assuming it belongs to this layer
+         *
+         * Like @ref ringStripCapacity(DataHandle) const but without checking
+         * that @p handle indeed belongs to this layer. See its documentation
+         * for more information.
+         * @see @ref isHandleValid(LayerDataHandle) const,
+         *      @ref dataHandleData()
+         */
+        UnsignedInt ringStripCapacity(LayerDataHandle handle) const;
+
         /**
          * @brief Set line data
          *
@@ -1188,6 +1307,46 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
         /** @overload */
         void setLineLoop(LayerDataHandle handle, std::initializer_list<Vector2> points, std::initializer_list<Color4> colors);
 
+        /**
+         * @brief Append points to a ring line strip
+         *
+         * Expects that @p handle is valid and that the line was created with
+         * @ref createRingStrip() and not subsequently changed with
+         * @ref setLine(), @ref setLineStrip() or @ref setLineLoop(). The
+         * @p colors are expected to be either empty or have the same size as
+         * @p points, if empty, the points are white. The points are added
+         * after the last point in the strip, if the strip is at its
+         * @ref ringStripCapacity(), the oldest points are dropped to make
+         * space. The operation is proportional to the count of appended
+         * points, not to the capacity.
+         *
+         * Calling this function causes @ref LayerState::NeedsCommonDataUpdate
+         * to be set. Unlike with @ref LayerState::NeedsDataUpdate, the
+         * subsequent @ref update() then regenerates only the vertex and
+         * index data of the segments affected by the append.
+         * @see @ref isHandleValid(DataHandle) const, @ref pointCount()
+         */
+        /* This one takes Vector4 instead of Color4 because color views are
+           implicitly convertible to vectors but not the other way around */
+        void appendRingStrip(DataHandle handle, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
+        /** @overload */
+        /* This one takes a Color4 instead of Vector4 in order to have e.g.
+           0x993366_rgbf implicitly converted to 0x993366ff_rgbaf */
+        void appendRingStrip(DataHandle handle, std::initializer_list<Vector2> points, std::initializer_list<Color4> colors);
+
+        /**
+         * @brief Append points to a ring line strip assuming it belongs to this layer
+         *
+         * Like @ref appendRingStrip(DataHandle, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<const Vector4>&)
+         * but without checking that @p handle indeed belongs to this layer.
+         * See its documentation for more information.
+         * @see @ref isHandleValid(LayerDataHandle) const,
+         *      @ref dataHandleData()
+         */
+        void appendRingStrip(LayerDataHandle handle, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
+        /** @overload */
+        void appendRingStrip(LayerDataHandle handle, std::initializer_list<Vector2> points, std::initializer_list<Color4> colors);
+
         /**
          * @brief Custom line color
          *
@@ -1371,14 +1530,18 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
 
     private:
         /* (Transitively) used by create(), createStrip(), createLoop(),
-           setLine(), setLineStrip() and setLineLoop() */
+           createRingStrip(), setLine(), setLineStrip(), setLineLoop() and
+           appendRingStrip() */
         MAGNUM_UI_LOCAL UnsignedInt createRun(UnsignedInt dataId, UnsignedInt indexCount, UnsignedInt pointCount);
         MAGNUM_UI_LOCAL void fillIndices(const char* messagePrefix, UnsignedInt dataId, const Containers::StridedArrayView1D<const UnsignedInt>& indices);
         MAGNUM_UI_LOCAL void fillStripIndices(const char* messagePrefix, UnsignedInt dataId);
         MAGNUM_UI_LOCAL void fillLoopIndices(const char* messagePrefix, UnsignedInt dataId);
+        MAGNUM_UI_LOCAL void fillRingStripIndices(UnsignedInt dataId);
+        MAGNUM_UI_LOCAL void appendRingStripPoints(const char* messagePrefix, UnsignedInt dataId, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
         MAGNUM_UI_LOCAL void fillPoints(const char* messagePrefix, UnsignedInt dataId, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
 
-        /* Used by create(), createLoop() and createStrip() */
+        /* Used by create(), createLoop(), createStrip() and
+           createRingStrip() */
         MAGNUM_UI_LOCAL DataHandle createInternal(const char* messagePrefix, UnsignedInt style, UnsignedInt indexCount, UnsignedInt pointCount, NodeHandle node);
         /* Used by remove() */
         MAGNUM_UI_LOCAL void removeInternal(UnsignedInt id);
@@ -1386,6 +1549,13 @@ class MAGNUM_UI_EXPORT LineLayer: public AbstractVisualLayer {
         MAGNUM_UI_LOCAL void setLineInternal(UnsignedInt id, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
         MAGNUM_UI_LOCAL void setLineStripInternal(UnsignedInt id, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
         MAGNUM_UI_LOCAL void setLineLoopInternal(UnsignedInt id, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
+        MAGNUM_UI_LOCAL void appendRingStripInternal(UnsignedInt id, const Containers::StridedArrayView1D<const Vector2>& points, const Containers::StridedArrayView1D<const Vector4>& colors);
+        MAGNUM_UI_LOCAL UnsignedInt indexCountInternal(UnsignedInt id) const;
+        MAGNUM_UI_LOCAL UnsignedInt pointCountInternal(UnsignedInt id) const;
+        MAGNUM_UI_LOCAL UnsignedInt ringStripCapacityInternal(UnsignedInt id) const;
+
+        /* Used by doUpdate() */
+        MAGNUM_UI_LOCAL void fillVertices(UnsignedInt dataId, const Vector2& nodeOffset, const Vector2& nodeSize, Float nodeOpacity, UnsignedInt indexBegin, UnsignedInt indexEnd, bool updatePositions, bool updateAppearance);
 
         MAGNUM_UI_LOCAL void setColorInternal(UnsignedInt id, const Color4& color);
         MAGNUM_UI_LOCAL Containers::Optional<LineAlignment> alignmentInternal(UnsignedInt id) const;
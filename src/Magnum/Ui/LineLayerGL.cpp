@@ -41,6 +41,7 @@
 #include <Magnum/GL/Shader.h>
 #include <Magnum/GL/Version.h>
 
+#include "Magnum/Ui/Implementation/bufferUploadGL.h"
 #include "Magnum/Ui/Implementation/lineLayerState.h"
 
 #ifdef MAGNUM_UI_BUILD_STATIC
@@ -204,28 +205,66 @@ void LineLayerGL::Shared::doSetStyle(const LineLayerCommonStyleUniform& commonUn
     state.styleBuffer.setSubData(sizeof(LineLayerCommonStyleUniform), uniforms);
 }
 
+namespace {
+
+/* Called from the constructor and then again each time the buffers get
+   recreated */
+void setupMesh(GL::Mesh& mesh, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer) {
+    mesh.addVertexBuffer(vertexBuffer, 0,
+        LineShaderGL::Position{},
+        LineShaderGL::PreviousPosition{},
+        LineShaderGL::NextPosition{},
+        LineShaderGL::Color4{},
+        LineShaderGL::AnnotationStyle{});
+    mesh.setIndexBuffer(indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+}
+
+}
+
 struct LineLayerGL::State: LineLayer::State {
     explicit State(Shared::State& shared): LineLayer::State{shared} {}
 
     GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array},
         indexBuffer{GL::Buffer::TargetHint::ElementArray};
+    BufferUploadGL vertexUpload, indexUpload;
     GL::Mesh mesh;
 
+    /* Used only if setBufferStreamingEnabled() is set */
+    BufferStreamGL bufferStream;
+    bool bufferStreaming = false;
+
     #ifndef CORRADE_NO_ASSERT
     bool setSizeCalled = false;
     #endif
-    /* 3 / 7 bytes free, 0 w/ CORRADE_NO_ASSERT */
 };
 
 LineLayerGL::LineLayerGL(const LayerHandle handle, Shared& sharedState_): LineLayer{handle, Containers::pointer<State>(static_cast<Shared::State&>(*sharedState_._state))} {
     auto& state = static_cast<State&>(*_state);
-    state.mesh.addVertexBuffer(state.vertexBuffer, 0,
-        LineShaderGL::Position{},
-        LineShaderGL::PreviousPosition{},
-        LineShaderGL::NextPosition{},
-        LineShaderGL::Color4{},
-        LineShaderGL::AnnotationStyle{});
-    state.mesh.setIndexBuffer(state.indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer);
+}
+
+bool LineLayerGL::isBufferStreamingEnabled() const {
+    return static_cast<const State&>(*_state).bufferStreaming;
+}
+
+LineLayerGL& LineLayerGL::setBufferStreamingEnabled(const bool enabled) {
+    auto& state = static_cast<State&>(*_state);
+    if(state.bufferStreaming == enabled)
+        return *this;
+
+    /* Persistently mapped buffers have an immutable storage that can't be
+       used by the regular upload path and vice versa, so start from scratch
+       and trigger a full upload */
+    state.bufferStreaming = enabled;
+    state.vertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+    state.indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+    state.vertexUpload = BufferUploadGL{};
+    state.indexUpload = BufferUploadGL{};
+    bufferStreamReset(state.bufferStream);
+    state.mesh = GL::Mesh{};
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer);
+    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    return *this;
 }
 
 LayerFeatures LineLayerGL::doFeatures() const {
@@ -251,21 +290,44 @@ void LineLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
     LineLayer::doUpdate(states, dataIds, clipRectIds, clipRectDataCounts, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, clipRectOffsets, clipRectSizes, compositeRectOffsets, compositeRectSizes);
 
     /* The branching here mirrors how LineLayer::doUpdate() restricts the
-       updates */
-    if(states >= LayerState::NeedsNodeOrderUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
-        state.indexBuffer.setData(state.indices);
-        state.mesh.setCount(state.indices.size());
-    }
-    if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
-       states >= LayerState::NeedsNodeEnabledUpdate ||
-       states >= LayerState::NeedsNodeOpacityUpdate ||
-       states >= LayerState::NeedsDataUpdate
+       updates. With buffer streaming, both vertices and indices are written
+       to a new place every time, so the branches are merged. */
+    if(state.bufferStreaming) {
+        if(states >= LayerState::NeedsNodeOrderUpdate ||
+           states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+           states >= LayerState::NeedsNodeEnabledUpdate ||
+           states >= LayerState::NeedsNodeOpacityUpdate ||
+           states >= LayerState::NeedsDataUpdate ||
+           states >= LayerState::NeedsCommonDataUpdate)
+        {
+            if(bufferStreamUpload(state.vertexBuffer, state.indexBuffer, state.bufferStream, state.vertices, sizeof(Implementation::LineLayerVertex), state.indices)) {
+                state.mesh = GL::Mesh{};
+                setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer);
+            }
+            state.mesh.setCount(state.indices.size());
+        }
 
-    )
-    {
-        state.vertexBuffer.setData(state.vertices);
+        /* Everything got copied, so the modified ranges aren't needed */
+        state.vertexDirtyRange.reset();
+        state.indexDirtyRange.reset();
+    } else {
+        /* NeedsCommonDataUpdate is set by LineLayer::appendRingStrip(), which
+           modifies only a part of both vertices and indices */
+        if(states >= LayerState::NeedsNodeOrderUpdate ||
+           states >= LayerState::NeedsDataUpdate ||
+           states >= LayerState::NeedsCommonDataUpdate)
+        {
+            bufferUploadDirty(state.indexBuffer, state.indexUpload, state.indices, state.indexDirtyRange);
+            state.mesh.setCount(state.indices.size());
+        }
+        if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+           states >= LayerState::NeedsNodeEnabledUpdate ||
+           states >= LayerState::NeedsNodeOpacityUpdate ||
+           states >= LayerState::NeedsDataUpdate ||
+           states >= LayerState::NeedsCommonDataUpdate)
+        {
+            bufferUploadDirty(state.vertexBuffer, state.vertexUpload, state.vertices, state.vertexDirtyRange);
+        }
     }
 }
 
@@ -283,7 +345,7 @@ void LineLayerGL::doDraw(const Containers::StridedArrayView1D<const UnsignedInt>
     sharedState.shader.bindStyleBuffer(sharedState.styleBuffer);
 
     state.mesh
-        .setIndexOffset(state.indexDrawOffsets[offset])
+        .setIndexOffset(state.bufferStream.indexOffset + state.indexDrawOffsets[offset])
         .setCount(state.indexDrawOffsets[offset + count] - state.indexDrawOffsets[offset]);
     sharedState.shader
         .draw(state.mesh);
@@ -84,6 +84,29 @@ class MAGNUM_UI_EXPORT LineLayerGL: public LineLayer {
         /** @overload */
         inline const Shared& shared() const;
 
+        /**
+         * @brief Whether buffer streaming is enabled
+         *
+         * @see @ref setBufferStreamingEnabled()
+         */
+        bool isBufferStreamingEnabled() const;
+
+        /**
+         * @brief Enable or disable buffer streaming
+         * @return Reference to self (for method chaining)
+         *
+         * Useful for line data that get updated every frame, such as live
+         * plots. If enabled, vertex and index data are written to a
+         * triple-buffered persistently mapped ring if
+         * @gl_extension{ARB,buffer_storage} (or
+         * @gl_extension{EXT,buffer_storage} on OpenGL ES) is available, or
+         * the buffers get orphaned on every upload otherwise. See
+         * @ref BaseLayerGL::setBufferStreamingEnabled() for more information.
+         * Changing the value causes @ref LayerState::NeedsDataUpdate to be
+         * set. Disabled by default.
+         */
+        LineLayerGL& setBufferStreamingEnabled(bool enabled);
+
     protected:
         /**
          * @copybrief AbstractLayer::doDraw()
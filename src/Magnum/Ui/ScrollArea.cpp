@@ -41,6 +41,7 @@
 #include "Magnum/Ui/SnapLayout.h"
 #include "Magnum/Ui/SnapLayouter.h"
 #include "Magnum/Ui/UserInterface.h"
+#include "Magnum/Ui/Implementation/scrollAreaStorage.h"
 
 namespace Magnum { namespace Ui {
 
@@ -70,202 +71,10 @@ Debug& operator<<(Debug& debug, const ScrollAreaFlags value) {
 
 using Implementation::BaseStyle;
 using Implementation::LayoutStyle;
+using Implementation::ScrollAreaStorage;
 
 namespace {
 
-/* Scroll area properties in either horizontal or vertical direction */
-struct ScrollAreaStorage: AbstractStorage {
-    struct Data {
-        /* Width or height of the clipping scroll area view */
-        Float viewSize;
-        /* Size of the associated scrollbar, for mapping thumb movement to
-           contents offset in a way that causes the thumb to be ultimately
-           positioned exactly by the offset it was dragged by */
-        Float scrollbarSize;
-        /* Size of the actual contents. If larger than viewSize, a scrollbar
-           thumb is shown in a position appropriate for contents offset, if
-           smaller, the thumb is hidden. */
-        Float contentsSize = 2;
-        /* Offset of the contents inside the view. Is exactly what's passed to
-           ui.setNodeOffsetX() / setNodeOffsetY(), thus is also negaitve. */
-        Float contentsOffset;
-    };
-
-    /* Right now the storage is private to the ScrollArea widget and thus is
-       ReferenceCounted to not leak it once the ScrollArea is removed */
-    explicit ScrollAreaStorage(DataLayer& layer): AbstractStorage{layer, StorageFlag::ReferenceCounted} {
-        /* Zero-initialize the size and offset values. The assumption is that
-           the Data is sufficiently small to fit in-place even on 32-bit. If it
-           wouldn't, this won't compile. */
-        *createInPlace<Data>() = {};
-    }
-
-    /* Called from ui.genericLayouter() on each layout update, refreshes
-       internal state to match current UI node sizes, marks the storage as
-       dirty if it changes, and returns current thumb offset and size. The min
-       thumb size should be coming from the thumb node layout properties. */
-    Containers::Pair<Float, Float> update(const Float viewSize, const Float scrollbarSize, const Float contentsSize, /*mutable*/ Float contentsOffset, const Float minThumbSize) {
-        /* Expect that nobody fiddled with the offset from outside, making it
-           larger than 0 (i.e., moved before the begin). OTOH, it can overflow
-           on the other side, for example if the view was scrolled to the end
-           and the view then got larger due to window resize (or vice versa, if
-           the view stays the same but the contents shrink). Clamp the offset
-           in that case so the storage has it correct. */
-        CORRADE_INTERNAL_ASSERT(contentsOffset <= 0.0f);
-        contentsOffset = Math::max(contentsOffset, Math::min(viewSize - contentsSize, 0.0f));
-
-        /* The thumb size is ratio of the contents and view size applied to the
-           actual scrollbar length, but at least the min size so it doesn't get
-           too small to aim for. On the other hand, if the contents are not
-           larger than the view, the thumb is made zero-size and thus
-           invisible, effectively disabling scrolling. */
-        const Float thumbSize = contentsSize <= viewSize ? 0.0f :
-            Math::max(scrollbarSize*viewSize/contentsSize, minThumbSize);
-        /* The offset is then ratio of the contents offset to size of the
-           contents outside of the visible view (i.e., 0% is when the contents
-           top/left edge is at the view top/left edge but 100% is when the
-           contents bottom/right edge is at the view bottom/right edge) applied
-           to the remaining length of the scrollbar where the thumb can move.
-           The contents node offset is negative, while thumb offset is
-           positive, so it's divided by a negative value to flip its sign.
-           Again, if contents size is not larger than view size, the thumb is
-           put at zero offset, as otherwise the offset could become a NaN. */
-        const Float thumbOffset = contentsSize <= viewSize ? 0.0f :
-            (scrollbarSize - thumbSize)*contentsOffset/(viewSize - contentsSize);
-
-        /* Note that we're *not* calling setDirty() if the offset changes as
-           a result of this update, such as when it got clamped above. The
-           storage being dirty results in setNodeOffset() to be called on the
-           UI, but this update function is called during a layout step, at
-           which point it's too late for anything to pick up the change to the
-           node offset. Best case it'd result in the change being applied next
-           frame, which is still too late and would result in weird hiccups.
-           Instead, the same clamp operation (and the same assert) is done via
-           another generic layout, which ensures that the actual offset used
-           by the layout is in bounds as well. Then, once the view gets
-           scrolled via an event, setDirty() called from there will turn the
-           original node offset in the UI and the layout node offset back in
-           sync. */
-        /** @todo may want to actually mark as dirty if the storage ever gets
-            public and user code can attach to it being dirty, but for that
-            need to first fix that the LayerState gets actually preserved
-            beyond the UI update (right now, if setDirty() is called here, the
-            storage stays marked as dirty, but the LayerState is reset back to
-            empty as this whole process happens inside layer update which
-            clears LayerState at the end */
-
-        Data& data = *AbstractStorage::data<Data>();
-        data.viewSize = viewSize;
-        data.scrollbarSize = scrollbarSize;
-        data.contentsSize = contentsSize;
-        data.contentsOffset = contentsOffset;
-        return {thumbOffset, thumbSize};
-    }
-
-    /* When this changes, the storage is marked as dirty, and setNodeOffset*()
-       gets called on the contents node */
-    StorageQuery<Float> contentsOffset() const {
-        return {*this, {}, [](const ScrollAreaStorage& storage, StorageOperation) {
-            return storage.data<Data>()->contentsOffset;
-        }};
-    }
-
-    /* When this changes, the storage is *not* marked as dirty, as it currently
-       isn't used to update anything in the UI, is only a getter for
-       diagnostics */
-    Float contentsPercentage() const {
-        const Data& data = *AbstractStorage::data<Data>();
-
-        /* If the contents are not larger than the view or update() wasn't
-           called yet (which could thus result in division by zero below),
-           we're not scrolled anywhere */
-        if(!data.viewSize || data.contentsSize <= data.viewSize) {
-            CORRADE_INTERNAL_ASSERT(!data.contentsOffset);
-            return 0.0f;
-        }
-
-        /* The offset is stored negative to match what's sent to
-           setNodeOffset*(), turn it into a ratio to size of the contents
-           outside of the visible view, negative to flip the sign */
-        return 100.0f*data.contentsOffset/(data.viewSize - data.contentsSize);
-    }
-
-    /* Scroll to a particular percentage, called from
-       ScrollArea::scrollToPercentage*() */
-    /** @todo these are const because otherwise capturing a ScrollAreaStorage
-        instance inside a lambda makes it impossible to call anything on it,
-        figure out if that's alright of if there's a better usage pattern */
-    void scrollToPercentage(Float percentage) const {
-        Data& data = *AbstractStorage::data<Data>();
-
-        /* If the contents are not larger than the view or update() wasn't
-           called yet (which would lead to scroll percentage out of the
-           [0, 100] range), exit without doing anything */
-        if(!data.viewSize || data.contentsSize <= data.viewSize) {
-            CORRADE_INTERNAL_ASSERT(!data.contentsOffset);
-            return;
-        }
-
-        /* Turn the percentage into a clamped ratio and apply it to the size of
-           the contents outside of the visible view. The offset is negative, so
-           multiply the percentage by a negative value to flip the sign. */
-        const Float contentsOffset = (data.viewSize - data.contentsSize)*Math::clamp(percentage*0.01f, 0.0f, 1.0f);
-
-        /* Mark the storage as dirty only if the offset actually changes,
-           e.g. scrolling to exactly the current position won't do
-           anything */
-        if(Math::notEqual(data.contentsOffset, contentsOffset)) {
-            data.contentsOffset = contentsOffset;
-            setDirty();
-        }
-    }
-
-    /* Scroll the view by given delta, i.e. the delta being interpreted
-       directly as the value to add to the node offset */
-    /** @todo these are const because otherwise capturing a ScrollAreaStorage
-        instance inside a lambda makes it impossible to call anything on it,
-        figure out if that's alright of if there's a better usage pattern */
-    void scrollViewBy(Float delta) const {
-        Data& data = *AbstractStorage::data<Data>();
-
-        /* In practice this function should always be called with the UI
-           already laid out, so with update() called */
-        CORRADE_INTERNAL_ASSERT(data.viewSize);
-
-        /* The offset is negative, so a positive delta decreases it. Clamp it
-           so it's between 0 and (negative) size of the contents outside of the
-           visible view. If contents are not larger than the view, the
-           resulting offset should be zero, as otherwise it'd lead to scroll
-           percentage out of the [0, 100] range. */
-        const Float contentsOffset = Math::clamp(data.contentsOffset + delta, data.viewSize - data.contentsSize, 0.0f);
-        CORRADE_INTERNAL_ASSERT(data.contentsSize > data.viewSize || !contentsOffset);
-
-        /* Mark the storage as dirty only if the offset actually changes, e.g.
-           scrolling forward at the end won't do anything */
-        if(Math::notEqual(data.contentsOffset, contentsOffset)) {
-            data.contentsOffset = contentsOffset;
-            setDirty();
-        }
-    }
-
-    /* Scroll the thumb by given delta, i.e. resulting in the thumb (not the
-       view) ultimately moving by given delta, thus correctly following the
-       pointer */
-    /** @todo these are const because otherwise capturing a ScrollAreaStorage
-        instance inside a lambda makes it impossible to call anything on it,
-        figure out if that's alright of if there's a better usage pattern */
-    void scrollThumbBy(Float delta) const {
-        Data& data = *AbstractStorage::data<Data>();
-
-        /* Scroll by the ratio of the delta to size of the scrollbar applied to
-           whole size of the contents, but interpreting the delta in the other
-           direction (because while dragging the view forward scrolls backward,
-           dragging the thumb forward scrolls forward). The scrollViewBy()
-           function then takes care of all clamping, marking as dirty etc. */
-        scrollViewBy(-data.contentsSize*delta/data.scrollbarSize);
-    }
-};
-
 /* Calculates a positive/negative offset for scrolling on the X/Y scrollbar,
    where both horizontal and vertical wheel as well as 2D scroll on the
    touchpad should work.
@@ -92,6 +92,8 @@ struct AbstractThemeTest: TestSuite::Tester {
     void textLayerGlyphCacheSizeNoTextFeature();
     void textLayerGlyphCacheSizeFeaturesNotSupported();
     void setTextLayerGlyphCacheSize();
+    void setTextLayerFlags();
+    void setTextLayerFlagsInvalid();
 
     void layoutLayer();
     void layoutLayerNotSupported();
@@ -327,6 +329,8 @@ AbstractThemeTest::AbstractThemeTest() {
               &AbstractThemeTest::textLayerGlyphCacheSizeNoTextFeature,
               &AbstractThemeTest::textLayerGlyphCacheSizeFeaturesNotSupported,
               &AbstractThemeTest::setTextLayerGlyphCacheSize,
+              &AbstractThemeTest::setTextLayerFlags,
+              &AbstractThemeTest::setTextLayerFlagsInvalid,
 
               &AbstractThemeTest::layoutLayer,
               &AbstractThemeTest::layoutLayerNotSupported,
@@ -981,6 +985,8 @@ void AbstractThemeTest::textLayerNotSupported() {
     theme.textLayerGlyphCacheSize(ThemeFeature::TextLayer);
     theme.textLayerGlyphCachePadding();
     theme.setTextLayerGlyphCacheSize({});
+    theme.textLayerFlags();
+    theme.setTextLayerFlags({});
     CORRADE_COMPARE_AS(out,
         "Ui::AbstractTheme::textLayerStyleUniformCount(): feature not supported\n"
         "Ui::AbstractTheme::textLayerStyleCount(): feature not supported\n"
@@ -991,7 +997,9 @@ void AbstractThemeTest::textLayerNotSupported() {
         "Ui::AbstractTheme::textLayerGlyphCacheFormat(): feature not supported\n"
         "Ui::AbstractTheme::textLayerGlyphCacheSize(): feature not supported\n"
         "Ui::AbstractTheme::textLayerGlyphCachePadding(): feature not supported\n"
-        "Ui::AbstractTheme::setTextLayerGlyphCacheSize(): feature not supported\n",
+        "Ui::AbstractTheme::setTextLayerGlyphCacheSize(): feature not supported\n"
+        "Ui::AbstractTheme::textLayerFlags(): feature not supported\n"
+        "Ui::AbstractTheme::setTextLayerFlags(): feature not supported\n",
         TestSuite::Compare::String);
 }
 
@@ -1182,6 +1190,44 @@ void AbstractThemeTest::setTextLayerGlyphCacheSize() {
     CORRADE_COMPARE(theme.textLayerGlyphCachePadding(), (Vector2i{4, 2}));
 }
 
+void AbstractThemeTest::setTextLayerFlags() {
+    struct: AbstractTheme {
+        ThemeFeatures doFeatures() const override {
+            return ThemeFeature::TextLayer;
+        }
+        bool doApply(UserInterface&, ThemeFeatures, PluginManager::Manager<Text::AbstractFont>*) const override { return {}; }
+    } theme;
+
+    /* By default there are no flags */
+    CORRADE_COMPARE(theme.textLayerFlags(), TextLayerSharedFlags{});
+
+    theme.setTextLayerFlags(TextLayerSharedFlag::FillGlyphCacheOnDemand);
+    CORRADE_COMPARE(theme.textLayerFlags(), TextLayerSharedFlag::FillGlyphCacheOnDemand);
+
+    theme.setTextLayerFlags(TextLayerSharedFlag::FillGlyphCacheDeferred);
+    CORRADE_COMPARE(theme.textLayerFlags(), TextLayerSharedFlag::FillGlyphCacheDeferred);
+
+    /* Setting no flags returns to the previous state */
+    theme.setTextLayerFlags({});
+    CORRADE_COMPARE(theme.textLayerFlags(), TextLayerSharedFlags{});
+}
+
+void AbstractThemeTest::setTextLayerFlagsInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: AbstractTheme {
+        ThemeFeatures doFeatures() const override {
+            return ThemeFeature::TextLayer;
+        }
+        bool doApply(UserInterface&, ThemeFeatures, PluginManager::Manager<Text::AbstractFont>*) const override { return {}; }
+    } theme;
+
+    Containers::String out;
+    Error redirectError{&out};
+    theme.setTextLayerFlags(TextLayerSharedFlag::DistanceField|TextLayerSharedFlag::FillGlyphCacheOnDemand);
+    CORRADE_COMPARE(out, "Ui::AbstractTheme::setTextLayerFlags(): Ui::TextLayerSharedFlag::DistanceField isn't allowed to be set\n");
+}
+
 void AbstractThemeTest::layoutLayer() {
     struct: AbstractTheme {
         ThemeFeatures doFeatures() const override {
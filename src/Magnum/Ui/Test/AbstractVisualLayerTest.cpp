@@ -79,6 +79,7 @@ struct AbstractVisualLayerTest: TestSuite::Tester {
     void styleOutOfRange();
 
     void dynamicStyleAllocateRecycle();
+    void dynamicStyleAllocateRecycleMany();
     void dynamicStyleAllocateNoDynamicStyles();
     void dynamicStyleAllocateRecycleInvalid();
 
@@ -88,10 +89,15 @@ struct AbstractVisualLayerTest: TestSuite::Tester {
     void eventStyleTransitionNodeNoLongerFocusable();
     void eventStyleTransitionNoHover();
     void eventStyleTransitionDisabled();
+    void eventStyleTransitionDisabledOnlyChanged();
     void eventStyleTransitionNoCapture();
     void eventStyleTransitionOutOfRange();
     void eventStyleTransitionInvalidAnimation();
     void eventStyleTransitionDynamicStyle();
+    void eventStyleTransitionTables();
+    void eventStyleTransitionTablesPrecomputed();
+    void eventStyleTransitionTablesPrecomputedAfterSet();
+    void eventStyleTransitionTablesInvalid();
 
     void sharedNeedsUpdateStatePropagatedToLayers();
 
@@ -886,6 +892,7 @@ AbstractVisualLayerTest::AbstractVisualLayerTest() {
         Containers::arraySize(StyleOutOfRangeData));
 
     addTests({&AbstractVisualLayerTest::dynamicStyleAllocateRecycle,
+              &AbstractVisualLayerTest::dynamicStyleAllocateRecycleMany,
               &AbstractVisualLayerTest::dynamicStyleAllocateNoDynamicStyles,
               &AbstractVisualLayerTest::dynamicStyleAllocateRecycleInvalid});
 
@@ -905,6 +912,8 @@ AbstractVisualLayerTest::AbstractVisualLayerTest() {
     addInstancedTests({&AbstractVisualLayerTest::eventStyleTransitionDisabled},
         Containers::arraySize(EventStyleTransitionDisabledData));
 
+    addTests({&AbstractVisualLayerTest::eventStyleTransitionDisabledOnlyChanged});
+
     addInstancedTests({&AbstractVisualLayerTest::eventStyleTransitionNoCapture},
         Containers::arraySize(EventStyleTransitionNoCaptureData));
 
@@ -922,6 +931,11 @@ AbstractVisualLayerTest::AbstractVisualLayerTest() {
     addInstancedTests({&AbstractVisualLayerTest::eventStyleTransitionDynamicStyle},
         Containers::arraySize(EventStyleTransitionDynamicStyleData));
 
+    addTests({&AbstractVisualLayerTest::eventStyleTransitionTables,
+              &AbstractVisualLayerTest::eventStyleTransitionTablesPrecomputed,
+              &AbstractVisualLayerTest::eventStyleTransitionTablesPrecomputedAfterSet,
+              &AbstractVisualLayerTest::eventStyleTransitionTablesInvalid});
+
     addTests({&AbstractVisualLayerTest::sharedNeedsUpdateStatePropagatedToLayers});
 
     addInstancedTests({&AbstractVisualLayerTest::debugIntegration},
@@ -2878,6 +2892,61 @@ void AbstractVisualLayerTest::dynamicStyleAllocateRecycle() {
     CORRADE_COMPARE(layer.allocateDynamicStyle(), Containers::NullOpt);
 }
 
+void AbstractVisualLayerTest::dynamicStyleAllocateRecycleMany() {
+    /* Like dynamicStyleAllocateRecycle(), but with the count spanning several
+       64-bit words and not being a multiple of 64 */
+
+    struct LayerShared: AbstractVisualLayer::Shared {
+        explicit LayerShared(UnsignedInt styleCount, UnsignedInt dynamicStyleCount): AbstractVisualLayer::Shared{styleCount, dynamicStyleCount} {}
+    } shared{3, 200};
+
+    struct Layer: AbstractVisualLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): AbstractVisualLayer{handle, shared} {}
+
+        using AbstractVisualLayer::create;
+    } layer{layerHandle(0, 1), shared};
+
+    /* Allocating all gives them in order */
+    for(UnsignedInt i = 0; i != 200; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(layer.allocateDynamicStyle(AnimationHandle(i + 1)), i);
+    }
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 200);
+    CORRADE_COMPARE(layer.dynamicStyleAnimation(63), AnimationHandle(64));
+    CORRADE_COMPARE(layer.dynamicStyleAnimation(64), AnimationHandle(65));
+    CORRADE_COMPARE(layer.dynamicStyleAnimation(199), AnimationHandle(200));
+
+    /* The padding bits in the last word don't get allocated */
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), Containers::NullOpt);
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 200);
+
+    /* Recycle a few in various words, in random order */
+    layer.recycleDynamicStyle(199);
+    layer.recycleDynamicStyle(64);
+    layer.recycleDynamicStyle(130);
+    layer.recycleDynamicStyle(63);
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 196);
+    CORRADE_COMPARE(layer.dynamicStyleAnimation(130), AnimationHandle::Null);
+
+    /* Allocating picks the lowest free each time, including ones from words
+       before the last allocated one */
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 63);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 64);
+    layer.recycleDynamicStyle(5);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 5);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 130);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 199);
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 200);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), Containers::NullOpt);
+
+    /* Recycling after everything was used makes it possible to allocate
+       again */
+    layer.recycleDynamicStyle(150);
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 199);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), 150);
+    CORRADE_COMPARE(layer.allocateDynamicStyle(), Containers::NullOpt);
+}
+
 void AbstractVisualLayerTest::dynamicStyleAllocateNoDynamicStyles() {
     struct LayerShared: AbstractVisualLayer::Shared {
         explicit LayerShared(UnsignedInt styleCount, UnsignedInt dynamicStyleCount): AbstractVisualLayer::Shared{styleCount, dynamicStyleCount} {}
@@ -6079,6 +6148,81 @@ void AbstractVisualLayerTest::eventStyleTransitionDisabled() {
     CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataWhite)]), StyleIndex::White);
 }
 
+void AbstractVisualLayerTest::eventStyleTransitionDisabledOnlyChanged() {
+    AbstractUserInterface ui{{100, 100}};
+
+    NodeHandle nodeGreen = ui.createNode({}, {100, 100});
+    NodeHandle nodeRed = ui.createNode({}, {100, 100}, NodeFlag::Disabled);
+    NodeHandle nodeBlue = ui.createNode({}, {100, 100});
+
+    StyleLayerShared shared{StyleCount, 0};
+    StyleLayer& layer = ui.setLayerInstance(Containers::pointer<StyleLayer>(ui.createLayer(), shared));
+    DataHandle dataGreen = layer.create(StyleIndex::Green, nodeGreen);
+    DataHandle dataRed = layer.create(StyleIndex::Red, nodeRed);
+    /* Two data attached to the same node, both should get transitioned */
+    DataHandle dataBlue1 = layer.create(StyleIndex::Blue, nodeBlue);
+    DataHandle dataBlue2 = layer.create(StyleIndex::Blue, nodeBlue);
+
+    static Int called;
+    called = 0;
+    shared.setStyleTransition(
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        nullptr,
+        [](UnsignedInt s) {
+            ++called;
+            return UnsignedInt(styleIndexTransitionToDisabled(StyleIndex(s)));
+        });
+
+    /* The first update goes through all data, but calls the transition only
+       for the disabled ones */
+    ui.update();
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataGreen)]), StyleIndex::Green);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataRed)]), StyleIndex::RedBlueDisabled);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue1)]), StyleIndex::Blue);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue2)]), StyleIndex::Blue);
+
+    /* Disabling just the blue node should call the transition only for the
+       two data attached to it, the red data isn't touched again */
+    called = 0;
+    ui.setNodeFlags(nodeBlue, NodeFlag::Disabled);
+    CORRADE_COMPARE(ui.state(), UserInterfaceState::NeedsNodeEnabledUpdate);
+    ui.update();
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataGreen)]), StyleIndex::Green);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataRed)]), StyleIndex::RedBlueDisabled);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue1)]), StyleIndex::RedBlueDisabled);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue2)]), StyleIndex::RedBlueDisabled);
+
+    /* Enabling the red node again resets just its data to the original style,
+       without calling the transition */
+    called = 0;
+    ui.setNodeFlags(nodeRed, NodeFlags{});
+    CORRADE_COMPARE(ui.state(), UserInterfaceState::NeedsNodeEnabledUpdate);
+    ui.update();
+    CORRADE_COMPARE(called, 0);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataGreen)]), StyleIndex::Green);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataRed)]), StyleIndex::Red);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue1)]), StyleIndex::RedBlueDisabled);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue2)]), StyleIndex::RedBlueDisabled);
+
+    /* Changing a style causes NeedsDataUpdate, which goes through all data
+       again */
+    called = 0;
+    layer.setStyle(dataGreen, StyleIndex::GreenHover);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    ui.update();
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataGreen)]), StyleIndex::GreenHover);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataRed)]), StyleIndex::Red);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue1)]), StyleIndex::RedBlueDisabled);
+    CORRADE_COMPARE(StyleIndex(layer.stateData().calculatedStyles[dataHandleId(dataBlue2)]), StyleIndex::RedBlueDisabled);
+}
+
 void AbstractVisualLayerTest::eventStyleTransitionNoCapture() {
     auto&& data = EventStyleTransitionNoCaptureData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -7133,6 +7277,258 @@ UnsignedInt typeErasedTransition2(UnsignedInt style) {
     return style*3;
 }
 
+void AbstractVisualLayerTest::eventStyleTransitionTables() {
+    /* Verifies just the basics, the event handling logic is the same for
+       functions and tables and is tested thoroughly in eventStyleTransition()
+       and elsewhere */
+
+    enum Style {
+        Inactive,
+        InactiveHover,
+        Pressed,
+        PressedHover,
+        Disabled
+    };
+
+    StyleLayerShared shared{5, 0};
+
+    AbstractUserInterface ui{{100, 100}};
+
+    NodeHandle node = ui.createNode({1.0f, 1.0f}, {2.0f, 2.0f});
+    NodeHandle nodeDisabled = ui.createNode({10.0f, 10.0f}, {2.0f, 2.0f}, NodeFlag::Disabled);
+
+    StyleLayer& layer = ui.setLayerInstance(Containers::pointer<StyleLayer>(ui.createLayer(), shared));
+    DataHandle layerData = layer.create(Inactive, node);
+    DataHandle layerDataDisabled = layer.create(InactiveHover, nodeDisabled);
+    DataHandle layerDataNotAttached = layer.create(Inactive);
+
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Focused transitions are a no-op. StyleLayerShared uses the
+       *_SHARED_SUBCLASS_IMPLEMENTATION() macro, this verifies that the
+       override does what's expected. */
+    const UnsignedInt toInactiveOut[]{Inactive, Inactive, Inactive, Inactive, Disabled};
+    const UnsignedInt toInactiveOver[]{InactiveHover, InactiveHover, InactiveHover, InactiveHover, Disabled};
+    const UnsignedInt toPressedOut[]{Pressed, Pressed, Pressed, Pressed, Disabled};
+    const UnsignedInt toPressedOver[]{PressedHover, PressedHover, PressedHover, PressedHover, Disabled};
+    const UnsignedInt toDisabled[]{Disabled, Disabled, Disabled, Disabled, Disabled};
+    StyleLayerShared& chaining = shared.setStyleTransitionTables(
+        toInactiveOut,
+        toInactiveOver,
+        {},
+        {},
+        toPressedOut,
+        toPressedOver,
+        toDisabled);
+    CORRADE_COMPARE(&chaining, &shared);
+
+    /* The functions are reset to the defaults, the toDisabled change is
+       signalled to the layer */
+    CORRADE_COMPARE(shared.styleTransitionToInactiveOut()(PressedHover), UnsignedInt(PressedHover));
+    CORRADE_COMPARE(shared.styleTransitionToPressedOver()(Inactive), UnsignedInt(Inactive));
+    CORRADE_VERIFY(!shared.styleTransitionToDisabled());
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+    ui.update();
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerData)], UnsignedInt(Inactive));
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(Disabled));
+
+    /* Hover, press and release go through the tables */
+    {
+        PointerMoveEvent event{{}, PointerEventSource::Mouse, {}, {}, true, 0, {}};
+        CORRADE_VERIFY(ui.pointerMoveEvent({2.0f, 2.0f}, event));
+        CORRADE_COMPARE(layer.style(layerData), UnsignedInt(InactiveHover));
+    } {
+        PointerEvent event{{}, PointerEventSource::Mouse, Pointer::MouseLeft, true, 0, {}};
+        CORRADE_VERIFY(ui.pointerPressEvent({2.0f, 2.0f}, event));
+        CORRADE_COMPARE(layer.style(layerData), UnsignedInt(PressedHover));
+    } {
+        PointerMoveEvent event{{}, PointerEventSource::Mouse, {}, {}, true, 0, {}};
+        CORRADE_VERIFY(ui.pointerMoveEvent({50.0f, 50.0f}, event));
+        CORRADE_COMPARE(layer.style(layerData), UnsignedInt(Pressed));
+    } {
+        PointerEvent event{{}, PointerEventSource::Mouse, Pointer::MouseLeft, true, 0, {}};
+        CORRADE_VERIFY(ui.pointerReleaseEvent({50.0f, 50.0f}, event));
+        CORRADE_COMPARE(layer.style(layerData), UnsignedInt(Inactive));
+    }
+
+    /* The explicit transition goes through them as well, if the data isn't
+       attached the style is used as-is */
+    layer.transitionStyle(layerData, Pressed);
+    CORRADE_COMPARE(layer.style(layerData), UnsignedInt(Inactive));
+    layer.transitionStyle(layerDataNotAttached, Pressed);
+    CORRADE_COMPARE(layer.style(layerDataNotAttached), UnsignedInt(Pressed));
+
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Setting functions again discards the tables, which is a change for the
+       toDisabled transition as well */
+    shared.setStyleTransition(nullptr, nullptr, nullptr, nullptr);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    layer.transitionStyle(layerData, Pressed);
+    CORRADE_COMPARE(layer.style(layerData), UnsignedInt(Pressed));
+
+    ui.update();
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(InactiveHover));
+}
+
+Int transitionTablesToInactiveOutCalled = 0;
+Int transitionTablesToDisabledCalled = 0;
+
+void AbstractVisualLayerTest::eventStyleTransitionTablesPrecomputed() {
+    StyleLayerShared shared{StyleCount, 0};
+
+    AbstractUserInterface ui{{100, 100}};
+
+    NodeHandle node = ui.createNode({1.0f, 1.0f}, {2.0f, 2.0f});
+    NodeHandle nodeDisabled = ui.createNode({10.0f, 10.0f}, {2.0f, 2.0f}, NodeFlag::Disabled);
+
+    StyleLayer& layer = ui.setLayerInstance(Containers::pointer<StyleLayer>(ui.createLayer(), shared));
+    DataHandle layerData = layer.create(StyleIndex::Red, node);
+    DataHandle layerDataDisabled = layer.create(StyleIndex::Blue, nodeDisabled);
+
+    transitionTablesToInactiveOutCalled = 0;
+    transitionTablesToDisabledCalled = 0;
+    shared.setStyleTransition(
+        [](UnsignedInt s) {
+            ++transitionTablesToInactiveOutCalled;
+            /* Not using styleIndexTransitionToInactiveOut() as it fails for
+               disabled styles */
+            return s == UnsignedInt(StyleIndex::RedPressed) ?
+                UnsignedInt(StyleIndex::Red) : s;
+        },
+        nullptr,
+        nullptr,
+        [](UnsignedInt s) {
+            ++transitionTablesToDisabledCalled;
+            return s == UnsignedInt(StyleIndex::Blue) ?
+                UnsignedInt(StyleIndex::RedBlueDisabled) : s;
+        });
+
+    /* Precomputing calls each function that's set exactly once for every
+       style, the functions are kept */
+    StyleLayerShared& chaining = shared.precomputeStyleTransitionTables();
+    CORRADE_COMPARE(&chaining, &shared);
+    CORRADE_COMPARE(transitionTablesToInactiveOutCalled, Int(StyleCount));
+    CORRADE_COMPARE(transitionTablesToDisabledCalled, Int(StyleCount));
+    CORRADE_VERIFY(shared.styleTransitionToDisabled());
+
+    /* Neither the update nor explicit transitions call the functions
+       anymore */
+    ui.update();
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(StyleIndex::RedBlueDisabled));
+    layer.transitionStyle(layerData, StyleIndex::RedPressed);
+    CORRADE_COMPARE(layer.style<StyleIndex>(layerData), StyleIndex::Red);
+    CORRADE_COMPARE(transitionTablesToInactiveOutCalled, Int(StyleCount));
+    CORRADE_COMPARE(transitionTablesToDisabledCalled, Int(StyleCount));
+
+    /* Setting the same functions again discards the tables, causing the
+       functions to be called again */
+    shared.setStyleTransition(
+        shared.styleTransitionToInactiveOut(),
+        nullptr,
+        nullptr,
+        shared.styleTransitionToDisabled());
+    layer.transitionStyle(layerData, StyleIndex::RedPressed);
+    CORRADE_COMPARE(layer.style<StyleIndex>(layerData), StyleIndex::Red);
+    CORRADE_COMPARE(transitionTablesToInactiveOutCalled, Int(StyleCount) + 1);
+}
+
+void AbstractVisualLayerTest::eventStyleTransitionTablesPrecomputedAfterSet() {
+    enum Style {
+        Inactive,
+        InactiveHover,
+        Pressed,
+        PressedHover,
+        Disabled
+    };
+
+    StyleLayerShared shared{5, 0};
+
+    AbstractUserInterface ui{{100, 100}};
+
+    NodeHandle node = ui.createNode({1.0f, 1.0f}, {2.0f, 2.0f});
+    NodeHandle nodeDisabled = ui.createNode({10.0f, 10.0f}, {2.0f, 2.0f}, NodeFlag::Disabled);
+
+    StyleLayer& layer = ui.setLayerInstance(Containers::pointer<StyleLayer>(ui.createLayer(), shared));
+    DataHandle layerData = layer.create(Pressed, node);
+    DataHandle layerDataDisabled = layer.create(InactiveHover, nodeDisabled);
+
+    const UnsignedInt toInactiveOut[]{Inactive, Inactive, Inactive, Inactive, Disabled};
+    const UnsignedInt toDisabled[]{Disabled, Disabled, Disabled, Disabled, Disabled};
+    shared.setStyleTransitionTables(
+        toInactiveOut,
+        {},
+        {},
+        {},
+        {},
+        {},
+        toDisabled);
+
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(Disabled));
+
+    /* Precomputing has no functions to evaluate, so the tables that were set
+       are kept, including the toDisabled one. It's unchanged, so the layer
+       doesn't need an update either. */
+    shared.precomputeStyleTransitionTables();
+    CORRADE_VERIFY(!shared.styleTransitionToDisabled());
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    layer.transitionStyle(layerData, PressedHover);
+    CORRADE_COMPARE(layer.style(layerData), UnsignedInt(Inactive));
+
+    /* Setting the style again triggers a data update, in which the disabled
+       style still gets transitioned through the table */
+    layer.setStyle(layerDataDisabled, InactiveHover);
+    ui.update();
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(Disabled));
+
+    /* With a toDisabled function, precomputing evaluates a new table from it,
+       which is signalled to the layer */
+    shared.setStyleTransition(nullptr, nullptr, nullptr,
+        [](UnsignedInt) { return UnsignedInt(Disabled); });
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    shared.precomputeStyleTransitionTables();
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+    ui.update();
+    CORRADE_COMPARE(layer.stateData().calculatedStyles[dataHandleId(layerDataDisabled)], UnsignedInt(Disabled));
+}
+
+void AbstractVisualLayerTest::eventStyleTransitionTablesInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    StyleLayerShared shared{3, 0};
+
+    const UnsignedInt valid[]{2, 1, 0};
+    const UnsignedInt wrongSize[]{2, 1, 0, 1};
+    const UnsignedInt outOfRange[]{2, 3, 0};
+
+    Containers::String out;
+    Error redirectError{&out};
+    shared.setStyleTransitionTables(valid, valid, wrongSize, valid, {}, {}, {});
+    shared.setStyleTransitionTables(valid, valid, valid, valid, valid, {}, outOfRange);
+    shared.setStyleTransition(
+        nullptr,
+        nullptr,
+        [](UnsignedInt s) {
+            return s == 1 ? 3u : s;
+        },
+        nullptr);
+    shared.precomputeStyleTransitionTables();
+    CORRADE_COMPARE_AS(out,
+        "Ui::AbstractVisualLayer::Shared::setStyleTransitionTables(): expected table 2 to have either 0 or 3 items but got 4\n"
+        "Ui::AbstractVisualLayer::Shared::setStyleTransitionTables(): style transition from 1 to 3 in table 6 out of range for 3 styles\n"
+        "Ui::AbstractVisualLayer::Shared::precomputeStyleTransitionTables(): style transition from 1 to 3 in function 4 out of range for 3 styles\n",
+        TestSuite::Compare::String);
+}
+
 void AbstractVisualLayerTest::sharedNeedsUpdateStatePropagatedToLayers() {
     struct LayerShared: AbstractVisualLayer::Shared {
         explicit LayerShared(UnsignedInt styleCount, UnsignedInt dynamicStyleCount): AbstractVisualLayer::Shared{styleCount, dynamicStyleCount} {}
@@ -48,6 +48,7 @@ struct BaseLayerGLBenchmark: GL::OpenGLTester {
     void teardown();
 
     void vertex();
+    void vertexAnimated();
     void fragment();
 
     private:
@@ -78,6 +79,14 @@ const struct {
         BaseLayerSharedFlag::SubdividedQuads},
 };
 
+const struct {
+    const char* name;
+    bool bufferStreaming;
+} VertexAnimatedData[]{
+    {"", false},
+    {"buffer streaming", true},
+};
+
 const struct {
     const char* name;
     UnsignedInt dynamicStyleCount;
@@ -116,6 +125,12 @@ BaseLayerGLBenchmark::BaseLayerGLBenchmark() {
         &BaseLayerGLBenchmark::teardown,
         BenchmarkType::GpuTime);
 
+    addInstancedBenchmarks({&BaseLayerGLBenchmark::vertexAnimated}, 10,
+        Containers::arraySize(VertexAnimatedData),
+        &BaseLayerGLBenchmark::setupVertex,
+        &BaseLayerGLBenchmark::teardown,
+        BenchmarkType::WallTime);
+
     addInstancedBenchmarks({&BaseLayerGLBenchmark::fragment}, 10,
         Containers::arraySize(FragmentData),
         &BaseLayerGLBenchmark::setupFragment,
@@ -211,6 +226,55 @@ void BaseLayerGLBenchmark::vertex() {
         TestSuite::Compare::around(Color4{1.0f/255.0f, 1.0f/255.0f}));
 }
 
+void BaseLayerGLBenchmark::vertexAnimated() {
+    auto&& data = VertexAnimatedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Like vertex(), but moving all nodes every frame to benchmark the
+       vertex data upload. Measuring wall time as the point is to catch the
+       CPU waiting for the GPU. */
+
+    AbstractUserInterface ui{VertexBenchmarkSize};
+    ui.setRendererInstance(Containers::pointer<RendererGL>());
+
+    BaseLayerGL::Shared shared{BaseLayer::Shared::Configuration{1}};
+    shared.setStyle(BaseLayerCommonStyleUniform{}, {
+        BaseLayerStyleUniform{}
+            .setColor(0xff3366_rgbf)
+    }, {});
+
+    BaseLayerGL& layer = ui.setLayerInstance(Containers::pointer<BaseLayerGL>(ui.createLayer(), shared));
+    layer.setBufferStreamingEnabled(data.bufferStreaming);
+    CORRADE_COMPARE(layer.isBufferStreamingEnabled(), data.bufferStreaming);
+
+    NodeHandle root = ui.createNode({}, ui.size());
+    for(Int x = 0; x != VertexBenchmarkSize.x(); ++x)
+        for(Int y = 0; y != VertexBenchmarkSize.y(); ++y) {
+            NodeHandle node = ui.createNode(root, {Float(x), Float(y)}, Vector2{1.0f});
+            layer.create(0, node);
+        }
+
+    ui.update();
+    CORRADE_COMPARE(ui.state(), UserInterfaceStates{});
+
+    Int frame = 0;
+    CORRADE_BENCHMARK(20) {
+        ui.setNodeOffset(root, {Float(frame++ % 2), 0.0f});
+        ui.draw();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Verify just one pixel, the BaseLayerGLTest does the rest */
+    Image2D out = _framebuffer.read({{}, VertexBenchmarkSize}, {PixelFormat::RGBA8Unorm});
+    CORRADE_COMPARE_WITH(
+        Math::unpack<Color4>(
+            out.pixels<Color4ub>()[std::size_t(VertexBenchmarkSize.y()/2)]
+                                  [std::size_t(VertexBenchmarkSize.x()/2)]),
+        0xff3366_rgbf,
+        TestSuite::Compare::around(Color4{1.0f/255.0f, 1.0f/255.0f}));
+}
+
 void BaseLayerGLBenchmark::fragment() {
     auto&& data = FragmentData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
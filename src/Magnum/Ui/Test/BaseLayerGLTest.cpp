@@ -37,17 +37,21 @@
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Animation/Easing.h>
 #include <Magnum/DebugTools/CompareImage.h>
+#include <Magnum/GL/Extensions.h>
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/TextureArray.h>
 #include <Magnum/GL/TextureFormat.h>
 #include <Magnum/GL/OpenGLTester.h>
+#include <Magnum/Math/Time.h>
 #include <Magnum/Math/Vector2.h>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ImageData.h>
 
 #include "Magnum/Ui/AbstractUserInterface.h"
+#include "Magnum/Ui/BaseLayerAnimator.h"
 #include "Magnum/Ui/BaseLayerGL.h"
 #include "Magnum/Ui/Event.h"
 #include "Magnum/Ui/Handle.h"
@@ -96,6 +100,7 @@ struct BaseLayerGLTest: GL::OpenGLTester {
     /* The SubdividedQuads flag shouldn't cover any codepaths for dynamic
        styles that weren't already tested above, done "just in case" */
     template<BaseLayerSharedFlag flag = BaseLayerSharedFlag{}> void renderDynamicStyles();
+    template<BaseLayerSharedFlag flag = BaseLayerSharedFlag{}> void renderShaderStyleAnimation();
 
     void renderOrDrawCompositeSetup();
     void renderOrDrawCompositeTeardown();
@@ -110,7 +115,8 @@ struct BaseLayerGLTest: GL::OpenGLTester {
     void drawTeardown();
     void drawOrder();
     void drawOrderComposite();
-    void drawClipping();
+    template<BaseLayerSharedFlag flag = BaseLayerSharedFlag{}> void drawClipping();
+    void drawPartialUpload();
 
     void eventStyleTransition();
 
@@ -123,6 +129,17 @@ struct BaseLayerGLTest: GL::OpenGLTester {
 using namespace Containers::Literals;
 using namespace Math::Literals;
 
+/* If not supported, BaseLayerSharedFlag::InstancedQuads draws with the
+   instance attributes bound at an offset instead. To test that path on a
+   driver that supports it, run the test with --magnum-disable-extensions. */
+#ifndef MAGNUM_TARGET_GLES
+typedef GL::Extensions::ARB::base_instance BaseInstanceExtension;
+#elif !defined(MAGNUM_TARGET_WEBGL)
+typedef GL::Extensions::ANGLE::base_vertex_base_instance BaseInstanceExtension;
+#else
+typedef GL::Extensions::WEBGL::draw_instanced_base_vertex_base_instance BaseInstanceExtension;
+#endif
+
 const struct {
     const char* name;
     UnsignedInt dynamicStyleCount;
@@ -297,10 +314,12 @@ const struct {
 
 const struct {
     const char* name;
-    bool partialUpdate;
+    bool partialUpdate, bufferStreaming;
 } RenderChangeStyleData[]{
-    {"", false},
-    {"partial update", true},
+    {"", false, false},
+    {"partial update", true, false},
+    {"buffer streaming", false, true},
+    {"buffer streaming, partial update", true, true},
 };
 
 const struct {
@@ -589,6 +608,21 @@ const struct {
         false, false, false, true},
 };
 
+const struct {
+    const char* name;
+    BaseLayerSharedFlags flags;
+    Nanoseconds time;
+} RenderShaderStyleAnimationData[]{
+    {"at the start", {}, 10_nsec},
+    {"a quarter in", {}, 35_nsec},
+    {"in the middle", {}, 60_nsec},
+    {"in the middle, no outline",
+        BaseLayerSharedFlag::NoOutline, 60_nsec},
+    {"in the middle, no rounded corners",
+        BaseLayerSharedFlag::NoRoundedCorners, 60_nsec},
+    {"almost at the end", {}, 109_nsec},
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -740,6 +774,41 @@ const struct {
             /* Premultiplied alpha */
             .setColor(0xffffffff_rgbaf*0.5f),
         0.75f, 0.226f},
+    /* The dual-filter blur only approximates the Gaussian blur, so it's
+       compared to a dedicated output. Compared to the Gaussian output it
+       differs by up to 1.5, with a mean of 0.27. Similarly to
+       BlurShaderGLTest::renderDualFilter(), the thresholds cover the
+       difference to bilinear filtering done at full precision. */
+    {"background blur dual filter, 50% opacity", "composite-background-blur-50-dual-filter.png",
+        BaseLayerSharedFlag::BackgroundBlurDualFilter, {}, {}, {},
+        BaseLayerCommonStyleUniform{}
+            .setSmoothness(1.0f),
+        BaseLayerStyleUniform{}
+            .setCornerRadius(12.0f)
+            /* Premultiplied alpha */
+            .setColor(0xffffffff_rgbaf*0.5f),
+        1.25f, 0.35f},
+    /* The pass count gets folded into the level count and offset scale
+       instead of repeating the whole process. The variance is 4*2/2 = 4, i.e.
+       twice the variance of radius 4 above, so the output is different. */
+    {"background blur dual filter, 50% opacity, radius 2, 4 passes", "composite-background-blur-50-dual-filter-r2-4.png",
+        BaseLayerSharedFlag::BackgroundBlurDualFilter, 2, {}, 4,
+        BaseLayerCommonStyleUniform{}
+            .setSmoothness(1.0f),
+        BaseLayerStyleUniform{}
+            .setCornerRadius(12.0f)
+            /* Premultiplied alpha */
+            .setColor(0xffffffff_rgbaf*0.5f),
+        1.25f, 0.35f},
+    {"background blur dual filter, 50% opacity, radius 31", "composite-background-blur-50-r31-dual-filter.png",
+        BaseLayerSharedFlag::BackgroundBlurDualFilter, 31, {}, {},
+        BaseLayerCommonStyleUniform{}
+            .setSmoothness(1.0f),
+        BaseLayerStyleUniform{}
+            .setCornerRadius(12.0f)
+            /* Premultiplied alpha */
+            .setColor(0xffffffff_rgbaf*0.5f),
+        1.25f, 0.35f},
 };
 
 const struct {
@@ -861,6 +930,15 @@ const struct {
         BaseLayerSharedFlag::BackgroundBlur}
 };
 
+const struct {
+    const char* name;
+    BaseLayerSharedFlags flags;
+} DrawPartialUploadData[]{
+    {"", {}},
+    {"subdivided quads", BaseLayerSharedFlag::SubdividedQuads},
+    {"instanced quads", BaseLayerSharedFlag::InstancedQuads},
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -901,14 +979,16 @@ BaseLayerGLTest::BaseLayerGLTest() {
     /* MSVC needs explicit type due to default template args */
     addInstancedTests<BaseLayerGLTest>({
         &BaseLayerGLTest::render,
-        &BaseLayerGLTest::render<BaseLayerSharedFlag::SubdividedQuads>},
+        &BaseLayerGLTest::render<BaseLayerSharedFlag::SubdividedQuads>,
+        &BaseLayerGLTest::render<BaseLayerSharedFlag::InstancedQuads>},
         Containers::arraySize(RenderData),
         &BaseLayerGLTest::renderSetup,
         &BaseLayerGLTest::renderTeardown);
 
     addInstancedTests<BaseLayerGLTest>({
         &BaseLayerGLTest::renderCustomColor,
-        &BaseLayerGLTest::renderCustomColor<BaseLayerSharedFlag::SubdividedQuads>},
+        &BaseLayerGLTest::renderCustomColor<BaseLayerSharedFlag::SubdividedQuads>,
+        &BaseLayerGLTest::renderCustomColor<BaseLayerSharedFlag::InstancedQuads>},
         Containers::arraySize(RenderCustomColorData),
         &BaseLayerGLTest::renderSetup,
         &BaseLayerGLTest::renderTeardown);
@@ -936,7 +1016,8 @@ BaseLayerGLTest::BaseLayerGLTest() {
 
     addInstancedTests<BaseLayerGLTest>({
         &BaseLayerGLTest::renderTextured,
-        &BaseLayerGLTest::renderTextured<BaseLayerSharedFlag::SubdividedQuads>},
+        &BaseLayerGLTest::renderTextured<BaseLayerSharedFlag::SubdividedQuads>,
+        &BaseLayerGLTest::renderTextured<BaseLayerSharedFlag::InstancedQuads>},
         Containers::arraySize(RenderTexturedData),
         &BaseLayerGLTest::renderSetup,
         &BaseLayerGLTest::renderTeardown);
@@ -969,6 +1050,14 @@ BaseLayerGLTest::BaseLayerGLTest() {
         &BaseLayerGLTest::renderSetup,
         &BaseLayerGLTest::renderTeardown);
 
+    addInstancedTests<BaseLayerGLTest>({
+        &BaseLayerGLTest::renderShaderStyleAnimation,
+        &BaseLayerGLTest::renderShaderStyleAnimation<BaseLayerSharedFlag::SubdividedQuads>,
+        &BaseLayerGLTest::renderShaderStyleAnimation<BaseLayerSharedFlag::InstancedQuads>},
+        Containers::arraySize(RenderShaderStyleAnimationData),
+        &BaseLayerGLTest::renderSetup,
+        &BaseLayerGLTest::renderTeardown);
+
     addInstancedTests<BaseLayerGLTest>({
         &BaseLayerGLTest::renderComposite,
         &BaseLayerGLTest::renderComposite<BaseLayerSharedFlag::SubdividedQuads>},
@@ -1005,11 +1094,18 @@ BaseLayerGLTest::BaseLayerGLTest() {
         &BaseLayerGLTest::renderOrDrawCompositeSetup,
         &BaseLayerGLTest::renderOrDrawCompositeTeardown);
 
-    addInstancedTests({&BaseLayerGLTest::drawClipping},
+    addInstancedTests<BaseLayerGLTest>({
+        &BaseLayerGLTest::drawClipping,
+        &BaseLayerGLTest::drawClipping<BaseLayerSharedFlag::InstancedQuads>},
         Containers::arraySize(DrawClippingData),
         &BaseLayerGLTest::drawSetup,
         &BaseLayerGLTest::drawTeardown);
 
+    addInstancedTests({&BaseLayerGLTest::drawPartialUpload},
+        Containers::arraySize(DrawPartialUploadData),
+        &BaseLayerGLTest::drawSetup,
+        &BaseLayerGLTest::drawTeardown);
+
     addTests({&BaseLayerGLTest::eventStyleTransition},
         &BaseLayerGLTest::renderSetup,
         &BaseLayerGLTest::renderTeardown);
@@ -1065,6 +1161,7 @@ void BaseLayerGLTest::construct() {
     CORRADE_COMPARE(&layer.shared(), &shared);
     /* Const overload */
     CORRADE_COMPARE(&static_cast<const BaseLayerGL&>(layer).shared(), &shared);
+    CORRADE_VERIFY(!layer.isBufferStreamingEnabled());
 }
 
 void BaseLayerGLTest::constructDerived() {
@@ -1208,7 +1305,8 @@ void BaseLayerGLTest::renderTeardown() {
 template<BaseLayerSharedFlag flag> void BaseLayerGLTest::render() {
     auto&& data = RenderData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
-    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" : "");
+    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" :
+        flag == BaseLayerSharedFlag::InstancedQuads ? "Flag::InstancedQuads" : "");
 
     if(flag == BaseLayerSharedFlag::SubdividedQuads && (data.flags & (BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag::NoRoundedCorners)))
         CORRADE_SKIP(flag << "and" << data.flags << "are mutually exclusive");
@@ -1266,7 +1364,8 @@ template<BaseLayerSharedFlag flag> void BaseLayerGLTest::render() {
 template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderCustomColor() {
     auto&& data = RenderCustomColorData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
-    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" : "");
+    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" :
+        flag == BaseLayerSharedFlag::InstancedQuads ? "Flag::InstancedQuads" : "");
 
     /* Basically the same as the "gradient" case in render(), except that the
        color is additionally taken from the data and node opacity as well */
@@ -1477,7 +1576,10 @@ template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderChangeStyle() {
     };
     layerShared.setStyle(BaseLayerCommonStyleUniform{}, uniforms, {});
 
-    BaseLayer& layer = ui.setLayerInstance(Containers::pointer<BaseLayerGL>(ui.createLayer(), layerShared));
+    BaseLayerGL& layer = ui.setLayerInstance(Containers::pointer<BaseLayerGL>(ui.createLayer(), layerShared));
+    /* With a partial update, the second upload goes to a different part of
+       the streaming buffer */
+    layer.setBufferStreamingEnabled(data.bufferStreaming);
 
     NodeHandle node = ui.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
     DataHandle nodeData = layer.create(0, node);
@@ -1514,7 +1616,8 @@ template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderChangeStyle() {
 template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderTextured() {
     auto&& data = RenderTexturedData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
-    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" : "");
+    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" :
+        flag == BaseLayerSharedFlag::InstancedQuads ? "Flag::InstancedQuads" : "");
 
     if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.load("StbImageImporter") & PluginManager::LoadState::Loaded))
@@ -1955,6 +2058,87 @@ template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderDynamicStyles() {
         DebugTools::CompareImageToFile{_manager});
 }
 
+template<BaseLayerSharedFlag flag> void BaseLayerGLTest::renderShaderStyleAnimation() {
+    auto&& data = RenderShaderStyleAnimationData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    setTestCaseTemplateName(flag == BaseLayerSharedFlag::SubdividedQuads ? "Flag::SubdividedQuads" :
+        flag == BaseLayerSharedFlag::InstancedQuads ? "Flag::InstancedQuads" : "");
+
+    if(flag == BaseLayerSharedFlag::SubdividedQuads && (data.flags & (BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag::NoRoundedCorners)))
+        CORRADE_SKIP(flag << "and" << data.flags << "are mutually exclusive");
+
+    /* Render the same animation first with the style interpolated on the CPU
+       and then in the shader. The output should be the same. */
+    Containers::Optional<Image2D> images[2];
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION((i ? "ShaderStyleAnimation" : "CPU interpolation"));
+
+        AbstractUserInterface ui{RenderSize};
+        ui.setRendererInstance(Containers::pointer<RendererGL>());
+
+        BaseLayerGL::Shared layerShared{
+            BaseLayer::Shared::Configuration{3, 2}
+                .addFlags(data.flags|flag)
+                .addFlags(i ? BaseLayerSharedFlag::ShaderStyleAnimation : BaseLayerSharedFlags{})
+                .setDynamicStyleCount(1)
+        };
+        /* Every property that the shader interpolates is different between
+           the two styles */
+        layerShared.setStyle(
+            BaseLayerCommonStyleUniform{}
+                .setSmoothness(1.0f),
+            {BaseLayerStyleUniform{},
+             BaseLayerStyleUniform{}
+                .setColor(0x2f83ccff_rgbaf, 0x1f52ffff_rgbaf)
+                .setOutlineColor(0xdcdcdcff_rgbaf)
+                .setOutlineWidth({2.0f, 4.0f, 2.0f, 8.0f})
+                .setCornerRadius({4.0f, 8.0f, 12.0f, 16.0f})
+                .setInnerOutlineCornerRadius(2.0f),
+             BaseLayerStyleUniform{}
+                .setColor(0xa5c9eaff_rgbaf, 0xdcdcdcff_rgbaf*0.5f)
+                .setOutlineColor(0xc7cf2fff_rgbaf)
+                .setOutlineWidth({10.0f, 2.0f, 6.0f, 2.0f})
+                .setCornerRadius({20.0f, 2.0f, 8.0f, 0.0f})
+                .setInnerOutlineCornerRadius({8.0f, 0.0f, 4.0f, 10.0f})},
+            /* To verify it's not using the style ID as uniform ID */
+            {1, 2},
+            {});
+
+        BaseLayerGL& layer = ui.setLayerInstance(Containers::pointer<BaseLayerGL>(ui.createLayer(), layerShared));
+
+        Containers::Pointer<BaseLayerStyleAnimator> animatorInstance{InPlaceInit, ui.createAnimator()};
+        layer.assignAnimator(*animatorInstance);
+        BaseLayerStyleAnimator& animator = ui.setAnimatorInstance(Utility::move(animatorInstance));
+
+        NodeHandle node = ui.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
+        DataHandle layerData = layer.create(0, node);
+        animator.create(0, 1, Animation::Easing::linear, 10_nsec, 100_nsec, layerData);
+
+        /* The data is switched to the only dynamic style for the duration of
+           the animation */
+        ui.advanceAnimations(data.time);
+        CORRADE_COMPARE(layer.style(layerData), 2);
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        ui.draw();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        images[i] = _framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm});
+    }
+
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Same problem is with all builtin shaders, so this doesn't seem to be a
+       bug in the base layer shader code */
+    if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+        CORRADE_SKIP("UBOs with dynamically indexed arrays don't seem to work on SwiftShader, can't test.");
+    #endif
+    /* There may be slight differences due to the interpolation being done
+       with a different precision */
+    CORRADE_COMPARE_WITH(*images[1], *images[0],
+        (DebugTools::CompareImage{0.75f, 0.01f}));
+}
+
 void BaseLayerGLTest::renderOrDrawCompositeSetup() {
     /* Using the framebuffer inside the RendererGL instead, thus this can be
        also shared for all render*() and draw*() cases */
@@ -2472,16 +2656,24 @@ void BaseLayerGLTest::drawOrderComposite() {
         (DebugTools::CompareImageToFile{_manager, 0.75f, 0.282f}));
 }
 
-void BaseLayerGLTest::drawClipping() {
+template<BaseLayerSharedFlag flag> void BaseLayerGLTest::drawClipping() {
     auto&& data = DrawClippingData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
+    /* Instanced quads are drawn with a different instance offset for each
+       clip rect, so this verifies the base instance is used correctly or, if
+       not supported, that the instance attributes get bound at the right
+       offset */
+    setTestCaseTemplateName(flag != BaseLayerSharedFlag::InstancedQuads ? "" :
+        GL::Context::current().isExtensionSupported<BaseInstanceExtension>() ?
+            "Flag::InstancedQuads" : "Flag::InstancedQuads, no base instance");
 
     /* X is divided by 10, Y by 100 when rendering. Window size (for events)
        isn't used for anything here. */
     AbstractUserInterface ui{{640.0f, 6400.0f}, {1.0f, 1.0f}, DrawSize};
     ui.setRendererInstance(Containers::pointer<RendererGL>());
 
-    BaseLayerGL::Shared layerShared{BaseLayer::Shared::Configuration{3}};
+    BaseLayerGL::Shared layerShared{BaseLayer::Shared::Configuration{3}
+        .addFlags(flag)};
     layerShared.setStyle(BaseLayerCommonStyleUniform{}, {
         BaseLayerStyleUniform{}         /* 0, red */
             .setColor(0xff0000_rgbf),
@@ -2561,6 +2753,105 @@ void BaseLayerGLTest::drawClipping() {
         DebugTools::CompareImageToFile{_manager});
 }
 
+void BaseLayerGLTest::drawPartialUpload() {
+    auto&& data = DrawPartialUploadData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Same problem is with all builtin shaders, so this doesn't seem to be a
+       bug in the base layer shader code */
+    if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+        CORRADE_SKIP("UBOs with dynamically indexed arrays don't seem to work on SwiftShader, can't test.");
+    #endif
+
+    /* Verifies that uploading just the modified parts of the vertex and index
+       buffers, and reallocating the buffers once the data don't fit anymore,
+       results in the same output as a full upload would. The modified ranges
+       themselves are checked in BaseLayerTest::updateDirtyRanges(). */
+
+    AbstractUserInterface ui{DrawSize};
+    ui.setRendererInstance(Containers::pointer<RendererGL>());
+
+    BaseLayerGL::Shared layerShared{BaseLayer::Shared::Configuration{3}
+        .addFlags(data.flags)};
+    layerShared.setStyle(BaseLayerCommonStyleUniform{}, {
+        BaseLayerStyleUniform{}         /* 0, red */
+            .setColor(0xff0000_rgbf),
+        BaseLayerStyleUniform{}         /* 1, green */
+            .setColor(0x00ff00_rgbf),
+        BaseLayerStyleUniform{}         /* 2, blue */
+            .setColor(0x0000ff_rgbf)
+    }, {});
+
+    BaseLayer& layer = ui.setLayerInstance(Containers::pointer<BaseLayerGL>(ui.createLayer(), layerShared));
+
+    NodeHandle topLeft = ui.createNode({0.0f, 0.0f}, {32.0f, 32.0f});
+    NodeHandle topRight = ui.createNode({32.0f, 0.0f}, {32.0f, 32.0f});
+    NodeHandle bottomLeft = ui.createNode({0.0f, 32.0f}, {32.0f, 32.0f});
+    NodeHandle bottomRight = ui.createNode({32.0f, 32.0f}, {32.0f, 32.0f});
+    DataHandle topLeftData = layer.create(0, topLeft);
+    DataHandle topRightData = layer.create(1, topRight);
+
+    /* The framebuffer is Y up, the UI Y down */
+    const auto pixelAt = [&](Int x, Int y) {
+        return _framebuffer.read(Range2Di::fromSize({x, DrawSize.y() - y - 1}, {1, 1}), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()[0][0];
+    };
+
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(pixelAt(16, 16), 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 16), 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixelAt(16, 48), 0x00000000_rgba);
+    CORRADE_COMPARE(pixelAt(48, 48), 0x00000000_rgba);
+
+    /* Changing a style of a single data uploads only a part of the buffer
+       that fits into the existing capacity */
+    layer.setStyle(topRightData, 2);
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(pixelAt(16, 16), 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 16), 0x0000ffff_rgba);
+    CORRADE_COMPARE(pixelAt(16, 48), 0x00000000_rgba);
+    CORRADE_COMPARE(pixelAt(48, 48), 0x00000000_rgba);
+
+    /* Adding a lot more data makes the buffers grow, with everything uploaded
+       again. Only the last data attached to given node is visible. */
+    for(std::size_t i = 0; i != 63; ++i)
+        layer.create(0, bottomLeft);
+    layer.create(1, bottomLeft);
+    layer.create(2, bottomRight);
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(pixelAt(16, 16), 0xff0000ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 16), 0x0000ffff_rgba);
+    CORRADE_COMPARE(pixelAt(16, 48), 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 48), 0x0000ffff_rgba);
+
+    /* Removing a data and hiding a node shrinks the index buffer, but the
+       buffer capacity stays. Changing a node offset then updates only the
+       vertices for the moved data. */
+    layer.remove(topLeftData);
+    ui.addNodeFlags(bottomRight, NodeFlag::Hidden);
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(pixelAt(16, 16), 0x00000000_rgba);
+    CORRADE_COMPARE(pixelAt(48, 16), 0x0000ffff_rgba);
+    CORRADE_COMPARE(pixelAt(16, 48), 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 48), 0x00000000_rgba);
+
+    ui.setNodeOffset(topRight, {0.0f, 0.0f});
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    ui.draw();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(pixelAt(16, 16), 0x0000ffff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 16), 0x00000000_rgba);
+    CORRADE_COMPARE(pixelAt(16, 48), 0x00ff00ff_rgba);
+    CORRADE_COMPARE(pixelAt(48, 48), 0x00000000_rgba);
+}
+
 void BaseLayerGLTest::eventStyleTransition() {
     /* Switches between the "default" and "gradient" cases from render() after
        a press event, and subsequently to a disabled style, which is "default"
@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Animation/Easing.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Time.h>
+
+#include "Magnum/Ui/AbstractUserInterface.h"
+#include "Magnum/Ui/BaseLayer.h"
+#include "Magnum/Ui/BaseLayerAnimator.h"
+#include "Magnum/Ui/Handle.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct BaseLayerStyleAnimatorBenchmark: TestSuite::Tester {
+    explicit BaseLayerStyleAnimatorBenchmark();
+
+    void advance();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    UnsignedInt count;
+} AdvanceData[]{
+    {"1000 animations", 1000},
+    {"10000 animations", 10000},
+};
+
+BaseLayerStyleAnimatorBenchmark::BaseLayerStyleAnimatorBenchmark() {
+    addInstancedBenchmarks({&BaseLayerStyleAnimatorBenchmark::advance}, 10,
+        Containers::arraySize(AdvanceData));
+}
+
+void BaseLayerStyleAnimatorBenchmark::advance() {
+    auto&& data = AdvanceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Benchmarks creating thousands of concurrent style animations, each
+       allocating a dynamic style on the first advance and recycling it once
+       it stops, as happens for example when a large list gets hovered over
+       or scrolled through */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared{BaseLayer::Shared::Configuration{2}
+        .setDynamicStyleCount(data.count)
+    };
+    shared.setStyle(BaseLayerCommonStyleUniform{},
+        {BaseLayerStyleUniform{}
+            .setColor(0xff3366_rgbf),
+         BaseLayerStyleUniform{}
+            .setColor(0x9933ff_rgbf)},
+        {});
+
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+    };
+
+    AbstractUserInterface ui{{100, 100}};
+
+    BaseLayer& layer = ui.setLayerInstance(Containers::pointer<Layer>(ui.createLayer(), shared));
+
+    Containers::Pointer<BaseLayerStyleAnimator> animatorInstance{InPlaceInit, ui.createAnimator()};
+    layer.assignAnimator(*animatorInstance);
+    BaseLayerStyleAnimator& animator = ui.setAnimatorInstance(Utility::move(animatorInstance));
+
+    Containers::Array<DataHandle> layerData{NoInit, data.count};
+    for(DataHandle& i: layerData)
+        i = layer.create(0);
+
+    Nanoseconds time = 0_nsec;
+    UnsignedInt maxDynamicStyleUsedCount = 0;
+    UnsignedInt frame = 0;
+    CORRADE_BENCHMARK(10) {
+        /* Alternate between animating from the first to the second style and
+           back */
+        const UnsignedInt source = frame++ % 2;
+        for(std::size_t i = 0; i != layerData.size(); ++i)
+            animator.create(source, 1 - source, Animation::Easing::linear, time, 10_nsec, layerData[i]);
+
+        /* Allocates a dynamic style for every animation */
+        ui.advanceAnimations(time + 5_nsec);
+        if(layer.dynamicStyleUsedCount() > maxDynamicStyleUsedCount)
+            maxDynamicStyleUsedCount = layer.dynamicStyleUsedCount();
+
+        /* Stops all animations, recycling the dynamic styles */
+        ui.advanceAnimations(time + 15_nsec);
+        time += 101_nsec;
+    }
+
+    CORRADE_COMPARE(maxDynamicStyleUsedCount, data.count);
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 0);
+    CORRADE_COMPARE(animator.usedCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::BaseLayerStyleAnimatorBenchmark)
@@ -71,6 +71,7 @@ struct BaseLayerStyleAnimatorTest: TestSuite::Tester {
 
     void advance();
     void advanceProperties();
+    void advanceShaderStyleAnimation();
     void advanceNoFreeDynamicStyles();
     void advanceConflictingAnimations();
     void advanceExternalStyleChanges();
@@ -78,6 +79,7 @@ struct BaseLayerStyleAnimatorTest: TestSuite::Tester {
     void advanceInvalid();
 
     void layerAdvance();
+    void layerAdvanceShaderStyleAnimation();
     void uiAdvance();
     void uiAdvanceEventTransition();
 };
@@ -306,7 +308,8 @@ BaseLayerStyleAnimatorTest::BaseLayerStyleAnimatorTest() {
     addInstancedTests({&BaseLayerStyleAnimatorTest::advanceProperties},
         Containers::arraySize(AdvancePropertiesData));
 
-    addTests({&BaseLayerStyleAnimatorTest::advanceNoFreeDynamicStyles});
+    addTests({&BaseLayerStyleAnimatorTest::advanceShaderStyleAnimation,
+              &BaseLayerStyleAnimatorTest::advanceNoFreeDynamicStyles});
 
     addInstancedTests({&BaseLayerStyleAnimatorTest::advanceConflictingAnimations},
         Containers::arraySize(AdvanceConflictingAnimationsData));
@@ -320,7 +323,8 @@ BaseLayerStyleAnimatorTest::BaseLayerStyleAnimatorTest() {
     addInstancedTests({&BaseLayerStyleAnimatorTest::layerAdvance},
         Containers::arraySize(LayerAdvanceData));
 
-    addTests({&BaseLayerStyleAnimatorTest::uiAdvance,
+    addTests({&BaseLayerStyleAnimatorTest::layerAdvanceShaderStyleAnimation,
+              &BaseLayerStyleAnimatorTest::uiAdvance,
               &BaseLayerStyleAnimatorTest::uiAdvanceEventTransition});
 }
 
@@ -1254,6 +1258,98 @@ void BaseLayerStyleAnimatorTest::advanceProperties() {
     }
 }
 
+void BaseLayerStyleAnimatorTest::advanceShaderStyleAnimation() {
+    /* Like advanceProperties(), but with the interpolation done in the shader
+       instead */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared{BaseLayer::Shared::Configuration{4, 3}
+        .setDynamicStyleCount(2)
+        .addFlags(BaseLayerSharedFlag::ShaderStyleAnimation)
+    };
+
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+    } layer{layerHandle(0, 1), shared};
+
+    DataHandle layerData1 = layer.create(0);
+    DataHandle layerData2 = layer.create(0);
+
+    BaseLayerStyleAnimator animator{animatorHandle(0, 1)};
+    layer.assignAnimator(animator);
+
+    /* Style 1 and 2 share the same uniform, so the second animation doesn't
+       need to interpolate anything */
+    AnimationHandle animation1 = animator.create(2, 0, Animation::Easing::linear, 0_nsec, 20_nsec, layerData1);
+    AnimationHandle animation2 = animator.create(1, 2, Animation::Easing::linear, 0_nsec, 20_nsec, layerData2);
+    shared.setStyle(
+        BaseLayerCommonStyleUniform{},
+        {BaseLayerStyleUniform{},
+         BaseLayerStyleUniform{},
+         BaseLayerStyleUniform{},
+         BaseLayerStyleUniform{}},
+        {3, 2, 2},
+        {});
+
+    const auto advance = [&](Nanoseconds time, Containers::ArrayView<BaseLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
+        UnsignedByte activeStorage[1];
+        UnsignedByte startedStorage[1];
+        UnsignedByte stoppedStorage[1];
+        Float factorStorage[2];
+        UnsignedByte removeStorage[1];
+        Vector4 dynamicStylePaddings[2];
+
+        return animator.advance(time,
+            Containers::MutableBitArrayView{activeStorage, 0, 2},
+            Containers::MutableBitArrayView{startedStorage, 0, 2},
+            Containers::MutableBitArrayView{stoppedStorage, 0, 2},
+            factorStorage,
+            Containers::MutableBitArrayView{removeStorage, 0, 2},
+            dynamicStyleUniforms, dynamicStyleInterpolationUniforms, dynamicStyleInterpolationFactors, dynamicStylePaddings, dataStyles);
+    };
+
+    /* The uniforms are not touched at all, only the interpolations */
+    BaseLayerStyleUniform uniforms[2];
+    uniforms[0].setColor(0xff3366_rgbf);
+    uniforms[1].setColor(0xff3366_rgbf);
+    Vector2ui interpolationUniforms[2];
+    Float interpolationFactors[2];
+    UnsignedInt dataStyles[]{666, 666};
+
+    /* Advancing to 5 allocates dynamic styles, switches to them and fills the
+       interpolation data. Interpolation is reported together with Style in
+       order to ensure the data is uploaded even though it won't subsequently
+       change for the second animation. */
+    CORRADE_COMPARE(advance(5_nsec, uniforms, interpolationUniforms, interpolationFactors, dataStyles), BaseLayerStyleAnimatorUpdate::Interpolation|BaseLayerStyleAnimatorUpdate::Style);
+    CORRADE_COMPARE(animator.dynamicStyle(animation1), 0);
+    CORRADE_COMPARE(animator.dynamicStyle(animation2), 1);
+    CORRADE_COMPARE(interpolationUniforms[0], (Vector2ui{2, 3}));
+    CORRADE_COMPARE(interpolationUniforms[1], (Vector2ui{2, 2}));
+    CORRADE_COMPARE(interpolationFactors[0], 0.25f);
+    CORRADE_COMPARE(interpolationFactors[1], 0.0f);
+    CORRADE_COMPARE(uniforms[0].topColor, 0xff3366_rgbf);
+    CORRADE_COMPARE(uniforms[1].topColor, 0xff3366_rgbf);
+    CORRADE_COMPARE(dataStyles[0], 4);
+    CORRADE_COMPARE(dataStyles[1], 5);
+
+    /* Advancing to 15 changes just the factor of the first */
+    CORRADE_COMPARE(advance(15_nsec, uniforms, interpolationUniforms, interpolationFactors, dataStyles), BaseLayerStyleAnimatorUpdate::Interpolation);
+    CORRADE_COMPARE(interpolationUniforms[0], (Vector2ui{2, 3}));
+    CORRADE_COMPARE(interpolationFactors[0], 0.75f);
+    CORRADE_COMPARE(interpolationFactors[1], 0.0f);
+    CORRADE_COMPARE(uniforms[0].topColor, 0xff3366_rgbf);
+
+    /* Advancing to 25 changes only the Style */
+    CORRADE_COMPARE(advance(25_nsec, uniforms, interpolationUniforms, interpolationFactors, dataStyles), BaseLayerStyleAnimatorUpdate::Style);
+    CORRADE_VERIFY(!animator.isHandleValid(animation1));
+    CORRADE_VERIFY(!animator.isHandleValid(animation2));
+    CORRADE_COMPARE(dataStyles[0], 0);
+    CORRADE_COMPARE(dataStyles[1], 2);
+}
+
 void BaseLayerStyleAnimatorTest::advanceNoFreeDynamicStyles() {
     struct LayerShared: BaseLayer::Shared {
         explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
@@ -1665,6 +1761,20 @@ void BaseLayerStyleAnimatorTest::advanceInvalid() {
     animator.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, data);
     animator.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, data);
 
+    LayerShared sharedShaderStyleAnimation{BaseLayer::Shared::Configuration{2}
+        .setDynamicStyleCount(2)
+        .addFlags(BaseLayerSharedFlag::ShaderStyleAnimation)
+    };
+    Layer layerShaderStyleAnimation{layerHandle(1, 1), sharedShaderStyleAnimation};
+
+    BaseLayerStyleAnimator animatorShaderStyleAnimation{animatorHandle(1, 1)};
+    layerShaderStyleAnimation.assignAnimator(animatorShaderStyleAnimation);
+
+    DataHandle dataShaderStyleAnimation = layerShaderStyleAnimation.create(0);
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, dataShaderStyleAnimation);
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, dataShaderStyleAnimation);
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, dataShaderStyleAnimation);
+
     Containers::BitArray mask{NoInit, 3};
     Containers::BitArray maskInvalid{NoInit, 4};
     Float factors[3];
@@ -1673,6 +1783,8 @@ void BaseLayerStyleAnimatorTest::advanceInvalid() {
     BaseLayerStyleUniform dynamicStyleUniformsInvalid[3];
     Vector4 dynamicStylePaddings[2];
     Vector4 dynamicStylePaddingsInvalid[3];
+    Vector2ui dynamicStyleInterpolationUniforms[2];
+    Float dynamicStyleInterpolationFactors[2];
 
     Containers::String out;
     Error redirectError{&out};
@@ -1684,6 +1796,9 @@ void BaseLayerStyleAnimatorTest::advanceInvalid() {
 
     animator.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniforms, dynamicStylePaddingsInvalid, {});
     animator.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniformsInvalid, dynamicStylePaddings, {});
+    animator.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniforms, dynamicStyleInterpolationUniforms, dynamicStyleInterpolationFactors, dynamicStylePaddings, {});
+    animatorShaderStyleAnimation.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniforms, dynamicStylePaddings, {});
+    animatorShaderStyleAnimation.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniforms, dynamicStyleInterpolationUniforms, Containers::arrayView(dynamicStyleInterpolationFactors).prefix(1), dynamicStylePaddings, {});
     /* All views correct but the layer doesn't have styles set */
     animator.advance({}, mask, mask, mask, factors, mask, dynamicStyleUniforms, dynamicStylePaddings, {});
     CORRADE_COMPARE_AS(out,
@@ -1698,6 +1813,9 @@ void BaseLayerStyleAnimatorTest::advanceInvalid() {
 
         "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style uniform and padding views to have a size of 2 but got 2 and 3\n"
         "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style uniform and padding views to have a size of 2 but got 3 and 2\n"
+        "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 0 but got 2 and 2\n"
+        "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 2 but got 0 and 0\n"
+        "Ui::BaseLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 2 but got 2 and 1\n"
         "Ui::BaseLayerStyleAnimator::advance(): no style data was set on the layer\n",
         TestSuite::Compare::String);
 }
@@ -1804,6 +1922,100 @@ void BaseLayerStyleAnimatorTest::layerAdvance() {
     CORRADE_VERIFY(!layer.stateData().dynamicStyleChanged);
 }
 
+void BaseLayerStyleAnimatorTest::layerAdvanceShaderStyleAnimation() {
+    /* Like layerAdvance(), but verifying just the differences with the
+       interpolation done in the shader */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared{BaseLayer::Shared::Configuration{3}
+        .setDynamicStyleCount(2)
+        .addFlags(BaseLayerSharedFlag::ShaderStyleAnimation)
+    };
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+
+        BaseLayer::State& stateData() {
+            return static_cast<BaseLayer::State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Initially the dynamic styles reference themselves */
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations.size(), 2);
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{3, 3}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.0f);
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[1].uniforms, (Vector2ui{4, 4}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[1].factor, 0.0f);
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    DataHandle data = layer.create(2);
+
+    BaseLayerStyleAnimator animator{animatorHandle(0, 1)};
+    layer.assignAnimator(animator);
+
+    animator.create(0, 1, Animation::Easing::linear, 0_nsec, 20_nsec, data);
+
+    shared.setStyle(
+        BaseLayerCommonStyleUniform{},
+        {BaseLayerStyleUniform{}
+            .setColor(Color4{0.25f}),
+         BaseLayerStyleUniform{}
+            .setColor(Color4{0.75f}),
+         BaseLayerStyleUniform{}},
+        {});
+
+    Containers::BitArray activeStorage{NoInit, 1};
+    Containers::BitArray startedStorage{NoInit, 1};
+    Containers::BitArray stoppedStorage{NoInit, 1};
+    Float factorStorage[1];
+    Containers::BitArray removeStorage{NoInit, 1};
+
+    /* Advancing to 1/4 sets the style and the interpolation, the uniform
+       stays untouched */
+    layer.advanceAnimations(5_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 1);
+    CORRADE_COMPARE(layer.style(data), shared.styleCount() + 0);
+    CORRADE_COMPARE(layer.dynamicStyleUniforms()[0].topColor, Color4{1.0f});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{0, 1}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.25f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+
+    /* Advancing to 1/2 updates just the interpolation */
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    layer.stateData().dynamicStyleInterpolationChanged = false;
+    layer.advanceAnimations(10_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{0, 1}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.5f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+
+    /* Advancing to the end switches to the final style, no interpolation
+       update */
+    layer.update(LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    layer.stateData().dynamicStyleInterpolationChanged = false;
+    layer.advanceAnimations(20_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 0);
+    CORRADE_COMPARE(layer.style(data), 1);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleInterpolationChanged);
+
+    /* Setting the dynamic style directly makes it reference itself again */
+    layer.setDynamicStyle(0, BaseLayerStyleUniform{}, {});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{3, 3}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.0f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+}
+
 void BaseLayerStyleAnimatorTest::uiAdvance() {
     /* Verifies that removing a data with an animation attached properly cleans
        the attached dynamic style (if there's any) in
@@ -126,6 +126,9 @@ struct BaseLayerTest: TestSuite::Tester {
 
     void updateEmpty();
     void updateDataOrder();
+    void updateInstancedQuads();
+    void updatePartialVertexData();
+    void updateDirtyRanges();
     void updateNoStyleSet();
 
     void sharedNeedsUpdateStatePropagatedToLayers();
@@ -383,6 +386,27 @@ const struct {
         LayerState::NeedsCompositeOffsetSizeUpdate, false, false, true},
 };
 
+const struct {
+    const char* name;
+    bool textured;
+    Float smoothness;
+} UpdateInstancedQuadsData[]{
+    {"", false, 0.0f},
+    {"textured", true, 0.0f},
+    {"smoothness expansion", false, 1.0f},
+    {"textured, smoothness expansion", true, 1.0f},
+};
+
+const struct {
+    const char* name;
+    BaseLayerSharedFlags flags;
+} UpdatePartialVertexDataData[]{
+    {"", {}},
+    {"textured", BaseLayerSharedFlag::Textured},
+    {"subdivided", BaseLayerSharedFlag::SubdividedQuads},
+    {"textured + subdivided", BaseLayerSharedFlag::Textured|BaseLayerSharedFlag::SubdividedQuads},
+};
+
 enum class Enum: UnsignedShort {};
 
 Debug& operator<<(Debug& debug, Enum value) {
@@ -595,6 +619,14 @@ BaseLayerTest::BaseLayerTest() {
     addInstancedTests({&BaseLayerTest::updateDataOrder},
         Containers::arraySize(UpdateDataOrderData));
 
+    addInstancedTests({&BaseLayerTest::updateInstancedQuads},
+        Containers::arraySize(UpdateInstancedQuadsData));
+
+    addInstancedTests({&BaseLayerTest::updatePartialVertexData},
+        Containers::arraySize(UpdatePartialVertexDataData));
+
+    addTests({&BaseLayerTest::updateDirtyRanges});
+
     addInstancedTests({&BaseLayerTest::updateNoStyleSet},
         Containers::arraySize(UpdateNoStyleSetData));
 
@@ -995,8 +1027,8 @@ void BaseLayerTest::sharedDebugFlag() {
 
 void BaseLayerTest::sharedDebugFlags() {
     Containers::String out;
-    Debug{&out} << (BaseLayerSharedFlag::BackgroundBlur|BaseLayerSharedFlag(0x80)) << BaseLayerSharedFlags{};
-    CORRADE_COMPARE(out, "Ui::BaseLayerSharedFlag::BackgroundBlur|Ui::BaseLayerSharedFlag(0x80) Ui::BaseLayerSharedFlags{}\n");
+    Debug{&out} << (BaseLayerSharedFlag::BackgroundBlur|BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag(0xfc00)) << BaseLayerSharedFlags{};
+    CORRADE_COMPARE(out, "Ui::BaseLayerSharedFlag::BackgroundBlur|Ui::BaseLayerSharedFlag::NoOutline|Ui::BaseLayerSharedFlag(0xfc00) Ui::BaseLayerSharedFlags{}\n");
 }
 
 void BaseLayerTest::sharedDebugFlagSupersets() {
@@ -1005,6 +1037,13 @@ void BaseLayerTest::sharedDebugFlagSupersets() {
         Containers::String out;
         Debug{&out} << (BaseLayerSharedFlag::Textured|BaseLayerSharedFlag::TextureMask);
         CORRADE_COMPARE(out, "Ui::BaseLayerSharedFlag::TextureMask\n");
+
+    /* BackgroundBlurDualFilter is a superset of BackgroundBlur, so only one
+       should get printed */
+    } {
+        Containers::String out;
+        Debug{&out} << (BaseLayerSharedFlag::BackgroundBlur|BaseLayerSharedFlag::BackgroundBlurDualFilter);
+        CORRADE_COMPARE(out, "Ui::BaseLayerSharedFlag::BackgroundBlurDualFilter\n");
     }
 }
 
@@ -1062,17 +1101,20 @@ void BaseLayerTest::sharedConfigurationSetters() {
     CORRADE_COMPARE(configuration.flags(), BaseLayerSharedFlags{});
     CORRADE_COMPARE(configuration.backgroundBlurRadius(), 4);
     CORRADE_COMPARE(configuration.backgroundBlurCutoff(), 0.5f/255.0f);
+    CORRADE_COMPARE(configuration.backgroundBlurDownscale(), 1);
 
     configuration
         .setDynamicStyleCount(9)
         .setFlags(BaseLayerSharedFlag::BackgroundBlur)
         .addFlags(BaseLayerSharedFlag(0xe0))
         .clearFlags(BaseLayerSharedFlag(0x70))
-        .setBackgroundBlurRadius(16, 0.1f);
+        .setBackgroundBlurRadius(16, 0.1f)
+        .setBackgroundBlurDownscale(2);
     CORRADE_COMPARE(configuration.dynamicStyleCount(), 9);
     CORRADE_COMPARE(configuration.flags(), BaseLayerSharedFlag::BackgroundBlur|BaseLayerSharedFlag(0x80));
     CORRADE_COMPARE(configuration.backgroundBlurRadius(), 16);
     CORRADE_COMPARE(configuration.backgroundBlurCutoff(), 0.1f);
+    CORRADE_COMPARE(configuration.backgroundBlurDownscale(), 2);
 }
 
 void BaseLayerTest::sharedConfigurationSettersInvalid() {
@@ -1084,11 +1126,21 @@ void BaseLayerTest::sharedConfigurationSettersInvalid() {
     configuration.setBackgroundBlurRadius(31);
     /* This also */
     configuration.setBackgroundBlurRadius(2, 150.0f);
+    /* All these should be okay as well */
+    configuration.setBackgroundBlurDownscale(1);
+    configuration.setBackgroundBlurDownscale(2);
+    configuration.setBackgroundBlurDownscale(4);
 
     Containers::String out;
     Error redirectError{&out};
     configuration.setBackgroundBlurRadius(32);
-    CORRADE_COMPARE(out, "Ui::BaseLayer::Shared::Configuration::setBackgroundBlurRadius(): radius 32 too large\n");
+    configuration.setBackgroundBlurDownscale(0);
+    configuration.setBackgroundBlurDownscale(3);
+    CORRADE_COMPARE_AS(out,
+        "Ui::BaseLayer::Shared::Configuration::setBackgroundBlurRadius(): radius 32 too large\n"
+        "Ui::BaseLayer::Shared::Configuration::setBackgroundBlurDownscale(): expected factor to be 1, 2 or 4, got 0\n"
+        "Ui::BaseLayer::Shared::Configuration::setBackgroundBlurDownscale(): expected factor to be 1, 2 or 4, got 3\n",
+        TestSuite::Compare::String);
 }
 
 void BaseLayerTest::sharedConstruct() {
@@ -1100,12 +1152,14 @@ void BaseLayerTest::sharedConstruct() {
         .setDynamicStyleCount(4)
         .addFlags(BaseLayerSharedFlag::BackgroundBlur)
         .setBackgroundBlurRadius(13)
+        .setBackgroundBlurDownscale(4)
     };
     CORRADE_COMPARE(shared.styleUniformCount(), 3);
     CORRADE_COMPARE(shared.styleCount(), 5);
     CORRADE_COMPARE(shared.dynamicStyleCount(), 4);
     CORRADE_COMPARE(shared.flags(), BaseLayerSharedFlag::BackgroundBlur);
     CORRADE_COMPARE(shared.backgroundBlurRadius(), 13);
+    CORRADE_COMPARE(shared.backgroundBlurDownscale(), 4);
     /** @todo verify also the cutoff once there's a getter */
 }
 
@@ -1188,11 +1242,13 @@ void BaseLayerTest::sharedConstructInvalid() {
     Shared{Shared::Configuration{1}.addFlags(BaseLayerSharedFlag::SubdividedQuads|BaseLayerSharedFlag::NoRoundedCorners)};
     Shared{Shared::Configuration{1}.addFlags(BaseLayerSharedFlag::SubdividedQuads|BaseLayerSharedFlag::NoOutline)};
     Shared{Shared::Configuration{1}.addFlags(BaseLayerSharedFlag::SubdividedQuads|BaseLayerSharedFlag::NoOutline|BaseLayerSharedFlag::NoRoundedCorners)};
+    Shared{Shared::Configuration{1}.addFlags(BaseLayerSharedFlag::SubdividedQuads|BaseLayerSharedFlag::InstancedQuads)};
     CORRADE_COMPARE_AS(out,
         "Ui::BaseLayer::Shared: expected non-zero total style count\n"
         "Ui::BaseLayer::Shared: Ui::BaseLayerSharedFlag::SubdividedQuads and Ui::BaseLayerSharedFlag::NoRoundedCorners are mutually exclusive\n"
         "Ui::BaseLayer::Shared: Ui::BaseLayerSharedFlag::SubdividedQuads and Ui::BaseLayerSharedFlag::NoOutline are mutually exclusive\n"
-        "Ui::BaseLayer::Shared: Ui::BaseLayerSharedFlag::SubdividedQuads and Ui::BaseLayerSharedFlag::NoRoundedCorners|Ui::BaseLayerSharedFlag::NoOutline are mutually exclusive\n",
+        "Ui::BaseLayer::Shared: Ui::BaseLayerSharedFlag::SubdividedQuads and Ui::BaseLayerSharedFlag::NoRoundedCorners|Ui::BaseLayerSharedFlag::NoOutline are mutually exclusive\n"
+        "Ui::BaseLayer::Shared: Ui::BaseLayerSharedFlag::SubdividedQuads and Ui::BaseLayerSharedFlag::InstancedQuads are mutually exclusive\n",
         TestSuite::Compare::String);
 }
 
@@ -2455,6 +2511,12 @@ void BaseLayerTest::updateDataOrder() {
        states */
     UnsignedInt dataIds[]{9, 7, 3};
 
+    /* Partial updates fill only a subset of the vertex attributes, do a full
+       update first to have the rest filled as well. Which attributes get
+       updated for which states is verified in updatePartialVertexData(). */
+    if(data.expectVertexDataUpdated && !(data.states >= LayerState::NeedsDataUpdate))
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+
     /* Test also compositing mesh generation if background blur is enabled */
     if(data.backgroundBlurPassCount) {
         /* These are completely unrelated to the actual nodes being rendered,
@@ -2861,6 +2923,349 @@ void BaseLayerTest::updateDataOrder() {
     }
 }
 
+void BaseLayerTest::updateInstancedQuads() {
+    auto&& data = UpdateInstancedQuadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Verifies that the instance data match the four quad corners generated
+       by a layer without BaseLayerSharedFlag::InstancedQuads, just in draw
+       order instead of being indexed by data ID. The actual visual output is
+       checked in BaseLayerGLTest. */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    };
+
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+        const BaseLayer::State& stateData() const {
+            return static_cast<const BaseLayer::State&>(*_state);
+        }
+    };
+
+    BaseLayer::Shared::Configuration configuration{4, 3};
+    configuration.setDynamicStyleCount(1);
+    if(data.textured)
+        configuration.addFlags(BaseLayerSharedFlag::Textured);
+
+    LayerShared shared{configuration};
+    LayerShared sharedInstanced{BaseLayer::Shared::Configuration{configuration}
+        .addFlags(BaseLayerSharedFlag::InstancedQuads)};
+
+    Layer layer{layerHandle(0, 1), shared};
+    Layer layerInstanced{layerHandle(1, 1), sharedInstanced};
+
+    NodeHandle node2 = nodeHandle(2, 0x111);
+    NodeHandle node5 = nodeHandle(5, 0xccc);
+
+    Vector2 nodeOffsets[6];
+    Vector2 nodeSizes[6];
+    Float nodeOpacities[6];
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::MutableBitArrayView nodesEnabled{nodesEnabledData, 0, 6};
+    nodeOffsets[2] = {1.0f, 2.0f};
+    nodeSizes[2] = {10.0f, 15.0f};
+    nodeOpacities[2] = 0.4f;
+    nodeOffsets[5] = {3.0f, 4.0f};
+    nodeSizes[5] = {20.0f, 5.0f};
+    nodeOpacities[5] = 0.9f;
+    nodesEnabled.set(5);
+
+    LayerShared* shareds[]{&shared, &sharedInstanced};
+    for(LayerShared* s: shareds) s->setStyle(
+        BaseLayerCommonStyleUniform{}
+            .setSmoothness(data.smoothness, 10000.0f),
+        {BaseLayerStyleUniform{}, BaseLayerStyleUniform{},
+         BaseLayerStyleUniform{}, BaseLayerStyleUniform{}},
+        {3, 1, 0},
+        {{}, {1.0f, 0.5f, 0.25f, 2.0f}, {}});
+
+    Layer* layers[]{&layer, &layerInstanced};
+    for(Layer* l: layers) {
+        l->create(0);                                                   /* 0 */
+        DataHandle data1 = l->create(1, node5);
+        l->create(0);                                                   /* 2 */
+        DataHandle data3 = l->create(2, node2);
+        /* Dynamic style, which has the uniform mapping implicit */
+        DataHandle data4 = l->create(3, node5);
+
+        l->setColor(data1, 0xff336699_rgbaf);
+        l->setOutlineWidth(data1, {1.0f, 2.0f, 3.0f, 4.0f});
+        l->setPadding(data1, {0.5f, 1.0f, 1.5f, 0.25f});
+        l->setColor(data3, 0x11223344_rgbaf);
+        l->setOutlineWidth(data3, 2.0f);
+        l->setColor(data4, 0x663399_rgbf);
+        l->setDynamicStyle(0, BaseLayerStyleUniform{}, {0.25f, 0.0f, 1.0f, 0.0f});
+
+        if(data.textured) {
+            l->setTextureCoordinates(data1, {0.25f, 0.5f, 37.0f}, {0.5f, 0.125f});
+            l->setTextureCoordinates(data4, {0.0f, 0.75f, 2.0f}, {0.25f, 0.25f});
+        }
+
+        l->setSize({25, 50}, {250, 5000});
+    }
+
+    /* Update both with the same data in a non-trivial order */
+    UnsignedInt dataIds[]{4, 1, 3};
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    layerInstanced.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+
+    /* There's no index buffer in the instanced case */
+    CORRADE_COMPARE_AS(layerInstanced.stateData().indices,
+        Containers::ArrayView<const UnsignedInt>{},
+        TestSuite::Compare::Container);
+
+    const auto verify = [&](Containers::ArrayView<const UnsignedInt> expectedDataIds) {
+        std::size_t typeSize = data.textured ?
+            sizeof(Implementation::BaseLayerTexturedVertex) :
+            sizeof(Implementation::BaseLayerVertex);
+        std::size_t instanceTypeSize = data.textured ?
+            sizeof(Implementation::BaseLayerTexturedInstance) :
+            sizeof(Implementation::BaseLayerInstance);
+        Containers::StridedArrayView1D<const Implementation::BaseLayerVertex> vertices{
+            layer.stateData().vertices,
+            reinterpret_cast<const Implementation::BaseLayerVertex*>(layer.stateData().vertices.data()),
+            layer.stateData().vertices.size()/typeSize, std::ptrdiff_t(typeSize)};
+        Containers::StridedArrayView1D<const Implementation::BaseLayerInstance> instances{
+            layerInstanced.stateData().vertices,
+            reinterpret_cast<const Implementation::BaseLayerInstance*>(layerInstanced.stateData().vertices.data()),
+            layerInstanced.stateData().vertices.size()/instanceTypeSize, std::ptrdiff_t(instanceTypeSize)};
+        CORRADE_COMPARE(instances.size(), expectedDataIds.size());
+
+        for(std::size_t i = 0; i != expectedDataIds.size(); ++i) {
+            CORRADE_ITERATION(i);
+            const UnsignedInt vertexOffset = expectedDataIds[i]*4;
+            CORRADE_COMPARE(instances[i].min, vertices[vertexOffset + 0].position);
+            CORRADE_COMPARE(instances[i].max, vertices[vertexOffset + 3].position);
+            CORRADE_COMPARE(instances[i].outlineWidth, vertices[vertexOffset + 0].outlineWidth);
+            CORRADE_COMPARE(instances[i].color, vertices[vertexOffset + 0].color);
+            CORRADE_COMPARE(instances[i].styleUniform, vertices[vertexOffset + 0].styleUniform);
+
+            if(data.textured) {
+                const auto& texturedVertices = Containers::arrayCast<const Implementation::BaseLayerTexturedVertex>(vertices);
+                const auto& texturedInstances = Containers::arrayCast<const Implementation::BaseLayerTexturedInstance>(instances);
+                CORRADE_COMPARE(texturedInstances[i].textureCoordinateMin, texturedVertices[vertexOffset + 0].textureCoordinates);
+                CORRADE_COMPARE(texturedInstances[i].textureCoordinateMax, texturedVertices[vertexOffset + 3].textureCoordinates.xy());
+            }
+        }
+    };
+    {
+        CORRADE_ITERATION("data update");
+        verify(dataIds);
+    }
+
+    /* A node order change alone doesn't need the non-instanced vertices to be
+       touched, but the instances have to be regenerated in the new order */
+    UnsignedInt dataIdsReordered[]{3, 4};
+    layerInstanced.update(LayerState::NeedsNodeOrderUpdate, dataIdsReordered, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    {
+        CORRADE_ITERATION("node order update");
+        verify(dataIdsReordered);
+    }
+}
+
+void BaseLayerTest::updatePartialVertexData() {
+    auto&& data = UpdatePartialVertexDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Verifies that node offset/size updates touch only the positions and
+       node opacity updates only the colors. The rest is checked thoroughly in
+       updateDataOrder(). */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared{BaseLayer::Shared::Configuration{1}
+        .setFlags(data.flags)};
+    shared.setStyle(BaseLayerCommonStyleUniform{},
+        {BaseLayerStyleUniform{}},
+        {});
+
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+        const BaseLayer::State& stateData() const {
+            return static_cast<const BaseLayer::State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    layer.create(0, nodeHandle(1, 1));
+    layer.setSize({100, 100}, {100, 100});
+
+    Vector2 nodeOffsets[2];
+    Vector2 nodeSizes[2];
+    Float nodeOpacities[2];
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::MutableBitArrayView nodesEnabled{nodesEnabledData, 0, 2};
+    nodeOffsets[1] = {1.0f, 2.0f};
+    nodeSizes[1] = {10.0f, 15.0f};
+    nodeOpacities[1] = 1.0f;
+    UnsignedInt dataIds[]{0};
+
+    /* Make a view on the position and color of the first vertex, which is
+       enough to verify what got updated */
+    const auto firstVertexPosition = [&]() {
+        return data.flags >= BaseLayerSharedFlag::SubdividedQuads ?
+            reinterpret_cast<const Implementation::BaseLayerSubdividedVertex*>(layer.stateData().vertices.data())->position :
+            reinterpret_cast<const Implementation::BaseLayerVertex*>(layer.stateData().vertices.data())->position;
+    };
+    const auto firstVertexColor = [&]() {
+        return data.flags >= BaseLayerSharedFlag::SubdividedQuads ?
+            reinterpret_cast<const Implementation::BaseLayerSubdividedVertex*>(layer.stateData().vertices.data())->color :
+            reinterpret_cast<const Implementation::BaseLayerVertex*>(layer.stateData().vertices.data())->color;
+    };
+
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(firstVertexPosition(), (Vector2{1.0f, 2.0f}));
+    CORRADE_COMPARE(firstVertexColor(), Color4{1.0f});
+
+    /* Changing just the offset updates the position but not the color, even
+       though the opacity changed as well */
+    nodeOffsets[1] = {3.0f, 4.0f};
+    nodeOpacities[1] = 0.5f;
+    layer.update(LayerState::NeedsNodeOffsetSizeUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(firstVertexPosition(), (Vector2{3.0f, 4.0f}));
+    CORRADE_COMPARE(firstVertexColor(), Color4{1.0f});
+
+    /* And vice versa */
+    nodeOffsets[1] = {5.0f, 6.0f};
+    layer.update(LayerState::NeedsNodeOpacityUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(firstVertexPosition(), (Vector2{3.0f, 4.0f}));
+    CORRADE_COMPARE(firstVertexColor(), (Color4{0.5f, 0.5f}));
+}
+
+void BaseLayerTest::updateDirtyRanges() {
+    /* Verifies that just the parts of the vertex and index data that got
+       regenerated are marked for upload by the GL implementation */
+
+    struct LayerShared: BaseLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): BaseLayer::Shared{configuration} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared{BaseLayer::Shared::Configuration{1}};
+    shared.setStyle(BaseLayerCommonStyleUniform{},
+        {BaseLayerStyleUniform{}},
+        {});
+
+    struct Layer: BaseLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): BaseLayer{handle, shared} {}
+        BaseLayer::State& stateData() {
+            return static_cast<BaseLayer::State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    layer.create(0, nodeHandle(0, 1));
+    layer.create(0, nodeHandle(1, 1));
+    layer.create(0, nodeHandle(2, 1));
+    layer.create(0, nodeHandle(3, 1));
+    layer.setSize({100, 100}, {100, 100});
+
+    Vector2 nodeOffsets[4]{};
+    Vector2 nodeSizes[4]{};
+    Float nodeOpacities[4]{1.0f, 1.0f, 1.0f, 1.0f};
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::MutableBitArrayView nodesEnabled{nodesEnabledData, 0, 4};
+    constexpr std::size_t VertexSize = 4*sizeof(Implementation::BaseLayerVertex);
+
+    /* Initially nothing is marked */
+    CORRADE_VERIFY(layer.stateData().vertexDirtyRange.isEmpty());
+    CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+
+    /* Drawing the two middle data marks their vertices and all indices */
+    {
+        UnsignedInt dataIds[]{2, 1};
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 1*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 3*VertexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, 2*6*sizeof(UnsignedInt));
+    }
+
+    /* The GL implementation resets the ranges after upload */
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Changing just node offsets for the last data marks only its vertices
+       and no indices */
+    {
+        UnsignedInt dataIds[]{3};
+        layer.update(LayerState::NeedsNodeOffsetSizeUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 3*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 4*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+
+    /* Without a reset the ranges accumulate, for example if the GL
+       implementation wasn't updated in between */
+    {
+        UnsignedInt dataIds[]{0};
+        layer.update(LayerState::NeedsNodeOpacityUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 4*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Changing a color of one of the drawn data marks only its vertices and
+       no indices, even though it's a data update */
+    {
+        layer.setColor(layerDataHandle(1, 1), 0xff3366_rgbf);
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+        UnsignedInt dataIds[]{2, 1};
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 1*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 2*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+
+    /* Changing data that aren't drawn doesn't mark anything */
+    {
+        layer.setColor(layerDataHandle(0, 1), 0xff3366_rgbf);
+        layer.setPadding(layerDataHandle(3, 1), 2.0f);
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+        UnsignedInt dataIds[]{2, 1};
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_VERIFY(layer.stateData().vertexDirtyRange.isEmpty());
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+
+    /* A per-data change together with a node opacity change updates all drawn
+       data */
+    {
+        layer.setOutlineWidth(layerDataHandle(2, 1), 3.0f);
+
+        UnsignedInt dataIds[]{2, 1};
+        layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsNodeOpacityUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 1*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 3*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+
+    /* A data update that isn't tied to particular data, such as a change of
+       the UI to framebuffer size ratio, regenerates everything that's drawn
+       even if some data were marked before */
+    {
+        layer.setColor(layerDataHandle(1, 1), 0x3366ff_rgbf);
+        layer.setSize({100, 100}, {200, 200});
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+        UnsignedInt dataIds[]{2, 1};
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 1*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 3*VertexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, 2*6*sizeof(UnsignedInt));
+    }
+}
+
 void BaseLayerTest::updateNoStyleSet() {
     auto&& data = UpdateNoStyleSetData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
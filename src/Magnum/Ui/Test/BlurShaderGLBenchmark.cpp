@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
@@ -49,6 +50,8 @@ struct BlurShaderGLBenchmark: GL::OpenGLTester {
     void teardown();
     void benchmark();
     void benchmarkCustom16Cutoff8();
+    void benchmarkDownscaleRegion();
+    void benchmarkDualFilter();
 
     private:
         GL::Mesh _square;
@@ -71,6 +74,35 @@ const struct {
     {"radius 0, limit 0", 0, 0.0f, 0.0f},
 };
 
+const struct {
+    const char* name;
+    Int downscale;
+    Float regionWidth;
+} BenchmarkDownscaleRegionData[]{
+    {"full resolution, whole area", 1, 1.0f},
+    {"half resolution, whole area", 2, 1.0f},
+    {"quarter resolution, whole area", 4, 1.0f},
+    {"full resolution, quarter-width sidebar", 1, 0.25f},
+    {"half resolution, quarter-width sidebar", 2, 0.25f},
+    {"quarter resolution, quarter-width sidebar", 4, 0.25f},
+};
+
+const struct {
+    const char* name;
+    /* Level count and offset scale as calculated by
+       dualFilterBlurParameters() for given radius and pass count */
+    UnsignedInt levelCount;
+    Float offsetScale;
+} BenchmarkDualFilterData[]{
+    /* Compare to "radius 4, limit 0" in benchmark() */
+    {"radius 4", 1, 0.76871f},
+    /* Compare to "radius 16, limit 0" in benchmark() */
+    {"radius 16", 2, 0.61051f},
+    {"radius 31", 2, 1.09129f},
+    /* A Gaussian with 16 passes would need 16x the time of radius 31 */
+    {"radius 31, 16 passes", 4, 1.04472f},
+};
+
 BlurShaderGLBenchmark::BlurShaderGLBenchmark() {
     addInstancedBenchmarks({&BlurShaderGLBenchmark::benchmark},
         10, Containers::arraySize(BenchmarkData),
@@ -84,6 +116,18 @@ BlurShaderGLBenchmark::BlurShaderGLBenchmark() {
         &BlurShaderGLBenchmark::teardown,
         BenchmarkType::GpuTime);
 
+    /* Doesn't use the setup / teardown as it needs differently sized
+       framebuffers */
+    addInstancedBenchmarks({&BlurShaderGLBenchmark::benchmarkDownscaleRegion},
+        10, Containers::arraySize(BenchmarkDownscaleRegionData),
+        BenchmarkType::GpuTime);
+
+    addInstancedBenchmarks({&BlurShaderGLBenchmark::benchmarkDualFilter},
+        10, Containers::arraySize(BenchmarkDualFilterData),
+        &BlurShaderGLBenchmark::setup,
+        &BlurShaderGLBenchmark::teardown,
+        BenchmarkType::GpuTime);
+
     /* The builtin shader asumes Y down, origin top left and takes an extra
        projection scale uniform which then flips it to Y up. The other variants
        in this test don't take a projection scale, so craft the data to have
@@ -237,6 +281,164 @@ void BlurShaderGLBenchmark::benchmarkCustom16Cutoff8() {
         TestSuite::Compare::around(Color4{data.benchmarkEpsilon, data.benchmarkEpsilon}));
 }
 
+void BlurShaderGLBenchmark::benchmarkDownscaleRegion() {
+    auto&& data = BenchmarkDownscaleRegionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Mirrors what BaseLayerGL::doComposite() does with
+       BaseLayer::Shared::Configuration::setBackgroundBlurDownscale() and
+       composite rects covering just a part of the framebuffer. The input is
+       always full resolution, the intermediate textures are downscaled and
+       only the region gets drawn. */
+    const Vector2i size = BenchmarkSize/data.downscale;
+
+    GL::Texture2D input;
+    input
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RGBA8, BenchmarkSize)
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, BenchmarkSize, Containers::Array<Color4ub>{DirectInit, std::size_t(BenchmarkSize.product()), 0x336699ff_rgba}});
+
+    GL::Texture2D vertical;
+    vertical
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RGBA8, size);
+    GL::Framebuffer verticalFramebuffer{{{}, size}};
+    verticalFramebuffer
+        .attachTexture(GL::Framebuffer::ColorAttachment{0}, vertical, 0);
+
+    GL::Texture2D horizontal;
+    horizontal
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RGBA8, size);
+    GL::Framebuffer horizontalFramebuffer{{{}, size}};
+    horizontalFramebuffer
+        .attachTexture(GL::Framebuffer::ColorAttachment{0}, horizontal, 0);
+
+    /* Same as _square, just with the right edge moved to given fraction of
+       the width */
+    GL::Mesh region;
+    region
+        .setPrimitive(GL::MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .addVertexBuffer(GL::Buffer{GL::Buffer::TargetHint::Array, {
+            Vector2{0.0f, -2.0f},
+            Vector2{2.0f*data.regionWidth, -2.0f},
+            Vector2{0.0f,  0.0f},
+            Vector2{2.0f*data.regionWidth,  0.0f},
+        }}, 0, BlurShaderGL::Position{});
+
+    BlurShaderGL shader{8, 0.5f/255.0f};
+    shader.setProjection({2.0f, -2.0f});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Texture2D* next = &input;
+
+    CORRADE_BENCHMARK(10) {
+        /* Vertical */
+        verticalFramebuffer.bind();
+        shader
+            .setDirection(Vector2::yAxis(1.0f/size.y()))
+            .bindTexture(*next)
+            .draw(region);
+
+        /* Horizontal */
+        horizontalFramebuffer.bind();
+        shader
+            .setDirection(Vector2::xAxis(1.0f/size.x()))
+            .bindTexture(vertical)
+            .draw(region);
+
+        next = &horizontal;
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D out = horizontalFramebuffer.read({{}, size}, {PixelFormat::RGBA8Unorm});
+    CORRADE_COMPARE_WITH(
+        Math::unpack<Color4>(
+            out.pixels<Color4ub>()[std::size_t(size.y()/2)]
+                                  [std::size_t(size.x()*data.regionWidth/2)]),
+        0x336699ff_rgbaf,
+        TestSuite::Compare::around(Color4{0.1f, 0.1f}));
+}
+
+void BlurShaderGLBenchmark::benchmarkDualFilter() {
+    auto&& data = BenchmarkDualFilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    GL::Texture2D input;
+    input
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::RGBA8, BenchmarkSize)
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, BenchmarkSize, Containers::Array<Color4ub>{DirectInit, std::size_t(BenchmarkSize.product()), 0x336699ff_rgba}});
+
+    /* Mirrors what BaseLayerGL::doComposite() does with
+       BaseLayerSharedFlag::BackgroundBlurDualFilter */
+    Containers::Array<GL::Texture2D> levels{DirectInit, data.levelCount, NoCreate};
+    Containers::Array<GL::Framebuffer> levelFramebuffers{DirectInit, data.levelCount, NoCreate};
+    for(UnsignedInt i = 0; i != data.levelCount; ++i) {
+        const Vector2i levelSize = BenchmarkSize/(1 << (i + 1));
+        (levels[i] = GL::Texture2D{})
+            .setMinificationFilter(GL::SamplerFilter::Linear)
+            .setMagnificationFilter(GL::SamplerFilter::Linear)
+            .setWrapping(GL::SamplerWrapping::ClampToEdge)
+            .setStorage(1, GL::TextureFormat::RGBA8, levelSize);
+        (levelFramebuffers[i] = GL::Framebuffer{{{}, levelSize}})
+            .attachTexture(GL::Framebuffer::ColorAttachment{0}, levels[i], 0);
+    }
+
+    DualFilterBlurShaderGL downsample{DualFilterBlurShaderGL::Mode::Downsample};
+    DualFilterBlurShaderGL upsample{DualFilterBlurShaderGL::Mode::Upsample};
+    downsample.setProjection({2.0f, -2.0f});
+    upsample.setProjection({2.0f, -2.0f});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_BENCHMARK(10) {
+        GL::Texture2D* source = &input;
+        for(UnsignedInt i = 0; i != data.levelCount; ++i) {
+            levelFramebuffers[i].bind();
+            downsample
+                .setOffset(0.5f*data.offsetScale/Vector2{BenchmarkSize/(1 << (i + 1))})
+                .bindTexture(*source)
+                .draw(_square);
+            source = &levels[i];
+        }
+
+        for(UnsignedInt i = data.levelCount; i != 0; --i) {
+            if(i == 1)
+                _horizontalFramebuffer.bind();
+            else
+                levelFramebuffers[i - 2].bind();
+            upsample
+                .setOffset(0.5f*data.offsetScale/Vector2{BenchmarkSize/(1 << i)})
+                .bindTexture(*source)
+                .draw(_square);
+            if(i != 1)
+                source = &levels[i - 2];
+        }
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D out = _horizontalFramebuffer.read({{}, BenchmarkSize}, {PixelFormat::RGBA8Unorm});
+    CORRADE_COMPARE_WITH(
+        Math::unpack<Color4>(
+            out.pixels<Color4ub>()[std::size_t(BenchmarkSize.y()/2)]
+                                  [std::size_t(BenchmarkSize.x()/2)]),
+        0x336699ff_rgbaf,
+        TestSuite::Compare::around(Color4{0.1f, 0.1f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Ui::Test::BlurShaderGLBenchmark)
@@ -24,6 +24,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Iterable.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
@@ -65,6 +66,7 @@ struct BlurShaderGLTest: GL::OpenGLTester {
     void teardown();
     void render();
     void renderCustom16Cutoff8();
+    void renderDualFilter();
 
     private:
         GL::Mesh _square;
@@ -149,6 +151,34 @@ const struct {
         0.75f, 0.077f, {1.25f, 0.645f}},
 };
 
+const struct {
+    const char* name;
+    const char* filename;
+    /* Level count and offset scale as calculated by
+       dualFilterBlurParameters() for given radius and a single pass, to
+       verify the approximation is close to the Gaussian blur of the same
+       radius */
+    UnsignedInt radius, levelCount;
+    Float offsetScale;
+    Float maxThreshold, meanThreshold;
+} RenderDualFilterData[]{
+    /* The dual-filter blur isn't a Gaussian, so it's compared against a
+       dedicated output instead of blur-3.png etc. Compared to those, the
+       difference is up to 15 around sharp edges, with a mean of 0.5 to 0.8.
+       The outputs are from llvmpipe, the thresholds cover the difference to
+       bilinear filtering done at full precision, which adds up over the
+       levels. */
+    {"radius 7", "blur-dual-filter-7.png",
+        7, 1, 1.18705f,
+        1.25f, 0.46f},
+    {"radius 16", "blur-dual-filter-16.png",
+        16, 2, 0.61051f,
+        1.25f, 0.46f},
+    {"radius 31", "blur-dual-filter-31.png",
+        31, 2, 1.09129f,
+        1.25f, 0.46f},
+};
+
 BlurShaderGLTest::BlurShaderGLTest() {
     addInstancedTests({&BlurShaderGLTest::render},
         Containers::arraySize(RenderData),
@@ -160,6 +190,11 @@ BlurShaderGLTest::BlurShaderGLTest() {
         &BlurShaderGLTest::setup,
         &BlurShaderGLTest::teardown);
 
+    addInstancedTests({&BlurShaderGLTest::renderDualFilter},
+        Containers::arraySize(RenderDualFilterData),
+        &BlurShaderGLTest::setup,
+        &BlurShaderGLTest::teardown);
+
     /* Prefer the StbImageImporter so we can keep files small but always import
        them as four-channel */
     if(PluginManager::PluginMetadata* metadata = _importerManager.metadata("StbImageImporter")) {
@@ -374,6 +409,86 @@ void BlurShaderGLTest::renderCustom16Cutoff8() {
         (DebugTools::CompareImageToFile{_importerManager, data.maxThreshold, data.meanThreshold}));
 }
 
+void BlurShaderGLTest::renderDualFilter() {
+    auto&& data = RenderDualFilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_importerManager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_importerManager.load("StbImageImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / StbImageImporter plugins not found.");
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _importerManager.loadAndInstantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Path::join(UI_TEST_DIR, "BaseLayerTestFiles/blur-input.png")));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), RenderSize);
+
+    GL::Texture2D input;
+    input
+        .setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::textureFormat(image->format()), image->size())
+        .setSubImage(0, {}, *image);
+
+    /* Progressively halved levels, rounded up, same as in BaseLayerGL */
+    Containers::Array<GL::Texture2D> levels{DirectInit, data.levelCount, NoCreate};
+    Containers::Array<GL::Framebuffer> levelFramebuffers{DirectInit, data.levelCount, NoCreate};
+    Containers::Array<Vector2i> levelSizes{NoInit, data.levelCount};
+    for(UnsignedInt i = 0; i != data.levelCount; ++i) {
+        const Int divisor = 1 << (i + 1);
+        levelSizes[i] = (RenderSize + Vector2i{divisor - 1})/divisor;
+        (levels[i] = GL::Texture2D{})
+            .setMinificationFilter(GL::SamplerFilter::Linear)
+            .setMagnificationFilter(GL::SamplerFilter::Linear)
+            .setWrapping(GL::SamplerWrapping::ClampToEdge)
+            .setStorage(1, GL::TextureFormat::RGBA8, levelSizes[i]);
+        (levelFramebuffers[i] = GL::Framebuffer{{{}, levelSizes[i]}})
+            .attachTexture(GL::Framebuffer::ColorAttachment{0}, levels[i], 0);
+    }
+
+    DualFilterBlurShaderGL downsample{DualFilterBlurShaderGL::Mode::Downsample};
+    DualFilterBlurShaderGL upsample{DualFilterBlurShaderGL::Mode::Upsample};
+    /* Internally this divides {2, -2}, resulting in an identity to match other
+       vertex shaders in this test */
+    downsample.setProjection({2.0f, -2.0f});
+    upsample.setProjection({2.0f, -2.0f});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Downsample, the offset is always a half-texel of the smaller texture */
+    GL::Texture2D* source = &input;
+    for(UnsignedInt i = 0; i != data.levelCount; ++i) {
+        levelFramebuffers[i].bind();
+        downsample
+            .setOffset(0.5f*data.offsetScale/Vector2{levelSizes[i]})
+            .bindTexture(*source)
+            .draw(_square);
+        source = &levels[i];
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Upsample, with the last pass going to the full-size framebuffer */
+    for(UnsignedInt i = data.levelCount; i != 0; --i) {
+        if(i == 1)
+            _horizontalFramebuffer.bind();
+        else
+            levelFramebuffers[i - 2].bind();
+        upsample
+            .setOffset(0.5f*data.offsetScale/Vector2{levelSizes[i - 1]})
+            .bindTexture(*source)
+            .draw(_square);
+        if(i != 1)
+            source = &levels[i - 2];
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE_WITH(_horizontalFramebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm}),
+        Utility::Path::join({UI_TEST_DIR, "BaseLayerTestFiles", data.filename}),
+        (DebugTools::CompareImageToFile{_importerManager, data.maxThreshold, data.meanThreshold}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Ui::Test::BlurShaderGLTest)
@@ -39,6 +39,8 @@ struct BlurShaderTest: TestSuite::Tester {
     void blurCoefficientsLimitTooLarge();
 
     void interpolatedBlurCoefficients();
+
+    void dualFilterBlurParameters();
 };
 
 const struct {
@@ -61,6 +63,30 @@ const struct {
     {"odd, 7 coefficients, 4 interpolated, first at the center", 10, 7, 4},
 };
 
+const struct {
+    const char* name;
+    UnsignedInt radius, passCount, maxLevelCount;
+    UnsignedInt expectedLevelCount;
+    Float expectedOffsetScale;
+} DualFilterBlurParametersData[]{
+    /* A single level with zero offsets is the minimum possible, producing a
+       larger variance than requested */
+    {"radius 0", 0, 1, 8, 1, 0.0f},
+    {"radius 1", 1, 1, 8, 1, 0.0f},
+    {"radius 4", 4, 1, 8, 1, 0.76871f},
+    {"radius 7", 7, 1, 8, 1, 1.18705f},
+    /* Here it switches to two levels, with the offsets getting smaller
+       again */
+    {"radius 16", 16, 1, 8, 2, 0.61051f},
+    {"radius 31", 31, 1, 8, 2, 1.09129f},
+    /* The pass count multiplies the variance, so this is the same as
+       radius 16 */
+    {"radius 1, 16 passes", 1, 16, 8, 2, 0.61051f},
+    {"radius 31, 16 passes", 31, 16, 8, 4, 1.04472f},
+    /* If the level count is capped, the offsets get larger to compensate */
+    {"radius 31, 16 passes, max 2 levels", 31, 16, 2, 2, 5.15311f},
+};
+
 BlurShaderTest::BlurShaderTest() {
     addInstancedTests({&BlurShaderTest::blurCoefficients},
         Containers::arraySize(BlurCoefficientsData));
@@ -69,6 +95,9 @@ BlurShaderTest::BlurShaderTest() {
 
     addInstancedTests({&BlurShaderTest::interpolatedBlurCoefficients},
         Containers::arraySize(InterpolatedBlurCoefficientsData));
+
+    addInstancedTests({&BlurShaderTest::dualFilterBlurParameters},
+        Containers::arraySize(DualFilterBlurParametersData));
 }
 
 void BlurShaderTest::blurCoefficients() {
@@ -187,6 +216,26 @@ void BlurShaderTest::interpolatedBlurCoefficients() {
     }
 }
 
+void BlurShaderTest::dualFilterBlurParameters() {
+    auto&& data = DualFilterBlurParametersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Float offsetScale;
+    UnsignedInt levelCount = Ui::dualFilterBlurParameters(data.radius, data.passCount, data.maxLevelCount, offsetScale);
+    CORRADE_COMPARE(levelCount, data.expectedLevelCount);
+    CORRADE_COMPARE_WITH(offsetScale, data.expectedOffsetScale,
+        TestSuite::Compare::around(0.00001f));
+
+    /* Unless clamped at the minimum, the variance calculated from the output
+       should match the variance of the Gaussian blur */
+    if(offsetScale != 0.0f) {
+        Float levelVarianceSum = 0.0f;
+        for(UnsignedInt i = 1; i <= levelCount; ++i)
+            levelVarianceSum += Float(1 << 2*i);
+        CORRADE_COMPARE(11.0f/48.0f*levelVarianceSum*(1.0f + 2.0f*offsetScale*offsetScale), data.passCount*data.radius*0.5f);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Ui::BlurShaderTest)
@@ -0,0 +1,554 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Magnum/Math/Half.h>
+#include <Magnum/Math/Time.h>
+#include <Magnum/Math/Vector2.h> /* AbstractUserInterface constructor size */
+
+#include "Magnum/Ui/ConcurrentNumericStorage.h"
+#include "Magnum/Ui/Handle.h"
+#include "Magnum/Ui/UserInterface.h"
+
+#ifdef CORRADE_BUILD_MULTITHREADED
+#include <thread>
+#endif
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct ConcurrentNumericStorageTest: TestSuite::Tester {
+    explicit ConcurrentNumericStorageTest();
+
+    template<class T> void constructValueInit();
+    template<class T> void constructDirectInit();
+
+    /* Verifies that both publishing and querying accesses the right data
+       index in all dimensions */
+    void access3D();
+    void access2D();
+    void access1D();
+    void access();
+
+    void publishInvalid();
+
+    /* Verifies that publishing marks the storage as dirty only through the
+       layer state and that the data get updated with the latest value */
+    void update();
+    void updateUnused();
+    void updateRemoved();
+    void updateThreaded();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    bool implicitLayer;
+} ConstructData[]{
+    {"", false},
+    {"implicit layer", true}
+};
+
+ConcurrentNumericStorageTest::ConcurrentNumericStorageTest() {
+    addInstancedTests<ConcurrentNumericStorageTest>({
+        &ConcurrentNumericStorageTest::constructValueInit<UnsignedByte>,
+        &ConcurrentNumericStorageTest::constructValueInit<Byte>,
+        &ConcurrentNumericStorageTest::constructValueInit<UnsignedShort>,
+        &ConcurrentNumericStorageTest::constructValueInit<Short>,
+        &ConcurrentNumericStorageTest::constructValueInit<UnsignedInt>,
+        &ConcurrentNumericStorageTest::constructValueInit<Int>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructValueInit<UnsignedLong>,
+        &ConcurrentNumericStorageTest::constructValueInit<Long>,
+        #endif
+        &ConcurrentNumericStorageTest::constructValueInit<Float>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructValueInit<Double>,
+        #endif
+        &ConcurrentNumericStorageTest::constructValueInit<Half>,
+        &ConcurrentNumericStorageTest::constructValueInit<Deg>,
+        &ConcurrentNumericStorageTest::constructValueInit<Rad>,
+        &ConcurrentNumericStorageTest::constructValueInit<Seconds>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructValueInit<Nanoseconds>,
+        #endif
+
+        &ConcurrentNumericStorageTest::constructDirectInit<UnsignedByte>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Byte>,
+        &ConcurrentNumericStorageTest::constructDirectInit<UnsignedShort>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Short>,
+        &ConcurrentNumericStorageTest::constructDirectInit<UnsignedInt>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Int>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructDirectInit<UnsignedLong>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Long>,
+        #endif
+        &ConcurrentNumericStorageTest::constructDirectInit<Float>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructDirectInit<Double>,
+        #endif
+        &ConcurrentNumericStorageTest::constructDirectInit<Half>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Deg>,
+        &ConcurrentNumericStorageTest::constructDirectInit<Rad>,
+        #if ATOMIC_LLONG_LOCK_FREE == 2
+        &ConcurrentNumericStorageTest::constructDirectInit<Nanoseconds>,
+        #endif
+        &ConcurrentNumericStorageTest::constructDirectInit<Seconds>},
+        Containers::arraySize(ConstructData));
+
+    addTests({&ConcurrentNumericStorageTest::access3D,
+              &ConcurrentNumericStorageTest::access2D,
+              &ConcurrentNumericStorageTest::access1D,
+              &ConcurrentNumericStorageTest::access,
+
+              &ConcurrentNumericStorageTest::publishInvalid,
+
+              &ConcurrentNumericStorageTest::update,
+              &ConcurrentNumericStorageTest::updateUnused,
+              &ConcurrentNumericStorageTest::updateRemoved,
+              &ConcurrentNumericStorageTest::updateThreaded});
+}
+
+template<class> struct StorageTraits;
+template<> struct StorageTraits<UnsignedByte> {
+    static const char* name() { return "UnsignedByte"; }
+    static UnsignedByte value() { return 167; }
+};
+template<> struct StorageTraits<Byte> {
+    static const char* name() { return "Byte"; }
+    static Byte value() { return -112; }
+};
+template<> struct StorageTraits<UnsignedShort> {
+    static const char* name() { return "UnsignedShort"; }
+    static UnsignedShort value() { return 56343; }
+};
+template<> struct StorageTraits<Short> {
+    static const char* name() { return "Short"; }
+    static Short value() { return -31765; }
+};
+template<> struct StorageTraits<UnsignedInt> {
+    static const char* name() { return "UnsignedInt"; }
+    static UnsignedInt value() { return 3267676658; }
+};
+template<> struct StorageTraits<Int> {
+    static const char* name() { return "Int"; }
+    static Int value() { return -1945467672; }
+};
+template<> struct StorageTraits<UnsignedLong> {
+    static const char* name() { return "UnsignedLong"; }
+    static UnsignedLong value() { return 1000111222333444ull; }
+};
+template<> struct StorageTraits<Long> {
+    static const char* name() { return "Long"; }
+    static Long value() { return -1000111222333444ll; }
+};
+template<> struct StorageTraits<Float> {
+    static const char* name() { return "Float"; }
+    static Float value() { return 3.14159264f; }
+};
+template<> struct StorageTraits<Double> {
+    static const char* name() { return "Double"; }
+    static Double value() { return 1e100; }
+};
+template<> struct StorageTraits<Half> {
+    static const char* name() { return "Half"; }
+    static Half value() { return 3.14159264_h; }
+};
+template<> struct StorageTraits<Deg> {
+    static const char* name() { return "Deg"; }
+    static Deg value() { return 180.0_degf; }
+};
+template<> struct StorageTraits<Rad> {
+    static const char* name() { return "Rad"; }
+    static Rad value() { return 3.14159264_radf; }
+};
+template<> struct StorageTraits<Seconds> {
+    static const char* name() { return "Seconds"; }
+    static Seconds value() { return 3.14159264_sec; }
+};
+template<> struct StorageTraits<Nanoseconds> {
+    static const char* name() { return "Nanoseconds"; }
+    static Nanoseconds value() { return -1000111222333444_nsec; }
+};
+
+template<class T> void ConcurrentNumericStorageTest::constructValueInit() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    setTestCaseTemplateName(StorageTraits<T>::name());
+
+    /* Either this instance or the implicit one below gets used */
+    DataLayer layer{layerHandle(0, 1)};
+
+    struct Interface: UserInterface {
+        explicit Interface(NoCreateT): UserInterface{NoCreate} {}
+    } ui{NoCreate};
+    ui.setDataLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    ConcurrentNumericStorage<T> storage = data.implicitLayer ?
+        ConcurrentNumericStorage<T>{ui, ValueInit, {3, 2, 1}, StorageFlags{0x18}} :
+        ConcurrentNumericStorage<T>{layer, ValueInit, {3, 2, 1}, StorageFlags{0x18}};
+    CORRADE_COMPARE(&storage.layer(), data.implicitLayer ? &ui.dataLayer() : &layer);
+    /* The storage is always allocated, even if it'd fit in-place, and the
+       internal flag for it isn't exposed */
+    CORRADE_VERIFY(storage.isAllocated());
+    CORRADE_VERIFY(!storage.isDirty());
+    CORRADE_COMPARE(storage.flags(), StorageFlags{0x18});
+    CORRADE_COMPARE(storage.size(), (Containers::Size3D{3, 2, 1}));
+    CORRADE_COMPARE(storage.publisher().size(), (Containers::Size3D{3, 2, 1}));
+
+    /* Verify at least one element to ensure the operator[]() is implemented
+       for all types. For Half the storage gets expanded to Float and the two
+       types aren't implicitly convertible to each other so I have to cast. */
+    CORRADE_COMPARE((storage[{2, 1, 0}]),
+        static_cast<typename ConcurrentNumericStorage<T>::Type>(T{}));
+    /* The query is immutable, with no operations */
+    CORRADE_VERIFY(!storage[{2, 1, 0}].isMutable());
+    CORRADE_COMPARE(storage[{2, 1, 0}].operations(), StorageOperations{});
+
+    /* Checked with a static_assert() for a builtin type of the same size in
+       the implementation already, verify that it holds for the actual type
+       as well */
+    CORRADE_VERIFY(std::atomic<T>{}.is_lock_free());
+}
+
+template<class T> void ConcurrentNumericStorageTest::constructDirectInit() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    setTestCaseTemplateName(StorageTraits<T>::name());
+
+    /* Either this instance or the implicit one below gets used */
+    DataLayer layer{layerHandle(0, 1)};
+
+    struct Interface: UserInterface {
+        explicit Interface(NoCreateT): UserInterface{NoCreate} {}
+    } ui{NoCreate};
+    ui.setDataLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    ConcurrentNumericStorage<T> storage = data.implicitLayer ?
+        ConcurrentNumericStorage<T>{ui, DirectInit, {3, 2, 1}, StorageTraits<T>::value(), StorageFlags{0x18}} :
+        ConcurrentNumericStorage<T>{layer, DirectInit, {3, 2, 1}, StorageTraits<T>::value(), StorageFlags{0x18}};
+    CORRADE_COMPARE(&storage.layer(), data.implicitLayer ? &ui.dataLayer() : &layer);
+    CORRADE_VERIFY(storage.isAllocated());
+    CORRADE_VERIFY(!storage.isDirty());
+    CORRADE_COMPARE(storage.flags(), StorageFlags{0x18});
+    CORRADE_COMPARE(storage.size(), (Containers::Size3D{3, 2, 1}));
+
+    CORRADE_COMPARE((storage[{0, 0, 0}]),
+        static_cast<typename ConcurrentNumericStorage<T>::Type>(StorageTraits<T>::value()));
+    CORRADE_COMPARE((storage[{2, 1, 0}]),
+        static_cast<typename ConcurrentNumericStorage<T>::Type>(StorageTraits<T>::value()));
+
+    /* Publishing a value goes through as well */
+    storage.publisher().publish({1, 0, 0}, T{});
+    CORRADE_COMPARE((storage[{1, 0, 0}]),
+        static_cast<typename ConcurrentNumericStorage<T>::Type>(T{}));
+    CORRADE_COMPARE((storage[{2, 1, 0}]),
+        static_cast<typename ConcurrentNumericStorage<T>::Type>(StorageTraits<T>::value()));
+}
+
+void ConcurrentNumericStorageTest::access3D() {
+    DataLayer layer{layerHandle(0, 1)};
+
+    ConcurrentNumericStorage<Int> storage{layer, ValueInit, {2, 3, 4}};
+    ConcurrentNumericStorage<Int>::Publisher publisher = storage.publisher();
+    publisher.publish({1, 2, 3}, 1337);
+    publisher.publish({0, 1, 2}, -7);
+    publisher.publish({1, 0, 0}, 26);
+
+    CORRADE_COMPARE((storage[{1, 2, 3}]), 1337);
+    CORRADE_COMPARE((storage[{0, 1, 2}]), -7);
+    CORRADE_COMPARE((storage[{1, 0, 0}]), 26);
+    CORRADE_COMPARE((storage[{0, 0, 0}]), 0);
+    CORRADE_COMPARE((storage[{1, 2, 2}]), 0);
+    CORRADE_COMPARE((storage[{0, 2, 3}]), 0);
+}
+
+void ConcurrentNumericStorageTest::access2D() {
+    DataLayer layer{layerHandle(0, 1)};
+
+    ConcurrentNumericStorage<Int> storage{layer, ValueInit, {3, 4}};
+    ConcurrentNumericStorage<Int>::Publisher publisher = storage.publisher();
+    CORRADE_COMPARE(publisher.size(), (Containers::Size3D{1, 3, 4}));
+    publisher.publish({2, 3}, 1337);
+    publisher.publish({1, 2}, -7);
+
+    CORRADE_COMPARE((storage[{2, 3}]), 1337);
+    CORRADE_COMPARE((storage[{1, 2}]), -7);
+    CORRADE_COMPARE((storage[{0, 0}]), 0);
+    CORRADE_COMPARE((storage[{2, 2}]), 0);
+    CORRADE_COMPARE((storage[{1, 3}]), 0);
+}
+
+void ConcurrentNumericStorageTest::access1D() {
+    DataLayer layer{layerHandle(0, 1)};
+
+    ConcurrentNumericStorage<Int> storage{layer, ValueInit, 5};
+    ConcurrentNumericStorage<Int>::Publisher publisher = storage.publisher();
+    CORRADE_COMPARE(publisher.size(), (Containers::Size3D{1, 1, 5}));
+    publisher.publish(3, 1337);
+    publisher.publish(4, -7);
+
+    CORRADE_COMPARE(storage[3], 1337);
+    CORRADE_COMPARE(storage[4], -7);
+    CORRADE_COMPARE(storage[0], 0);
+    CORRADE_COMPARE(storage[2], 0);
+}
+
+void ConcurrentNumericStorageTest::access() {
+    DataLayer layer{layerHandle(0, 1)};
+
+    ConcurrentNumericStorage<Int> storage{layer, DirectInit, 26};
+    CORRADE_COMPARE(storage.value(), 26);
+
+    storage.publisher().publish(1337);
+
+    /* Verifying both the explicit and implicit query */
+    StorageQuery<Int> query1 = storage.value();
+    StorageQuery<Int> query2 = storage;
+    CORRADE_COMPARE(query1.storage(), storage.handle());
+    CORRADE_COMPARE(query2.storage(), storage.handle());
+    CORRADE_COMPARE(query1.index(), (Containers::Size3D{0, 0, 0}));
+    CORRADE_COMPARE(query2.index(), (Containers::Size3D{0, 0, 0}));
+    CORRADE_VERIFY(!query1.isMutable());
+    CORRADE_VERIFY(!query2.isMutable());
+    CORRADE_COMPARE(query1, 1337);
+    CORRADE_COMPARE(query2, 1337);
+    CORRADE_COMPARE(storage->operations(), StorageOperations{});
+}
+
+void ConcurrentNumericStorageTest::publishInvalid() {
+    CORRADE_SKIP_IF_NO_DEBUG_ASSERT();
+
+    DataLayer layer{layerHandle(0, 1)};
+    ConcurrentNumericStorage<Int> storage1D{layer, ValueInit, 15};
+    ConcurrentNumericStorage<Int> storage2D{layer, ValueInit, {3, 7}};
+    ConcurrentNumericStorage<Int> storage3D{layer, ValueInit, {4, 2, 5}};
+
+    Containers::String out;
+    Error redirectError{&out};
+    storage1D.publisher().publish(15, 0);
+    storage2D.publisher().publish({2, 7}, 0);
+    storage3D.publisher().publish({3, 2, 5}, 0);
+    /* Single-item, 1D and 2D APIs for a storage with more dimensions */
+    storage1D.publisher().publish(0);
+    storage2D.publisher().publish(3, 0);
+    storage3D.publisher().publish({1, 1}, 0);
+    /* The messages are deliberately without the index and size, as they're
+       printed from the publishing thread */
+    CORRADE_COMPARE_AS(out,
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): index out of range\n"
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): index out of range\n"
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): index out of range\n"
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a single-item storage\n"
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a 1D storage\n"
+        "Ui::ConcurrentNumericStorage::Publisher::publish(): expected a 2D storage\n",
+        TestSuite::Compare::String);
+}
+
+void ConcurrentNumericStorageTest::update() {
+    AbstractUserInterface ui{{100, 100}};
+    DataLayer& layer = ui.setLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    ConcurrentNumericStorage<UnsignedShort> storage{layer, DirectInit, 3, 176};
+    ConcurrentNumericStorage<UnsignedShort>::Publisher publisher = storage.publisher();
+
+    /* The query is always at least a 32-bit type */
+    struct {
+        Int called = 0;
+        UnsignedInt expected;
+    } state;
+    storage[1].onUpdate([&state](UnsignedInt value) {
+        CORRADE_COMPARE(value, state.expected);
+        ++state.called;
+    });
+
+    /* The callback gets called on the first update */
+    state.expected = 176;
+    {
+        CORRADE_ITERATION(__FILE__ ":" CORRADE_LINE_STRING);
+        ui.update();
+    }
+    CORRADE_COMPARE(state.called, 1);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Publishing doesn't touch the layer directly, it's only visible when the
+       state is queried */
+    publisher.publish(1, 97);
+    CORRADE_VERIFY(!storage.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+
+    /* Publishing several times in a row results in just the last value being
+       propagated, in a single call */
+    publisher.publish(1, 98);
+    publisher.publish(1, 99);
+    state.expected = 99;
+    {
+        CORRADE_ITERATION(__FILE__ ":" CORRADE_LINE_STRING);
+        ui.update();
+    }
+    CORRADE_COMPARE(state.called, 2);
+    CORRADE_VERIFY(!storage.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Publishing to a different index still updates all data bound to the
+       storage, same as with other storages */
+    publisher.publish(2, 1337);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    {
+        CORRADE_ITERATION(__FILE__ ":" CORRADE_LINE_STRING);
+        ui.update();
+    }
+    CORRADE_COMPARE(state.called, 3);
+    CORRADE_COMPARE(storage[2], 1337);
+
+    /* Marking the storage as dirty from the UI thread works too */
+    storage.setDirty();
+    CORRADE_VERIFY(storage.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    {
+        CORRADE_ITERATION(__FILE__ ":" CORRADE_LINE_STRING);
+        ui.update();
+    }
+    CORRADE_COMPARE(state.called, 4);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+}
+
+void ConcurrentNumericStorageTest::updateUnused() {
+    AbstractUserInterface ui{{100, 100}};
+    DataLayer& layer = ui.setLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    ConcurrentNumericStorage<Float> storage{layer, ValueInit};
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Publishing to a storage that isn't used by any data doesn't trigger an
+       update */
+    storage.publisher().publish(3.5f);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Creating data bound to it does, and the data get the latest value */
+    Int called = 0;
+    storage->onUpdate([&called](Float value) {
+        CORRADE_COMPARE(value, 3.5f);
+        ++called;
+    });
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate);
+    ui.update();
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+}
+
+void ConcurrentNumericStorageTest::updateRemoved() {
+    AbstractUserInterface ui{{100, 100}};
+    DataLayer& layer = ui.setLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    /* Create and remove a concurrent storage, and create a regular one that
+       reuses its slot. It shouldn't be treated as concurrent anymore. */
+    StorageHandle removed;
+    {
+        ConcurrentNumericStorage<Int> storage{layer, ValueInit};
+        storage.publisher().publish(1337);
+        removed = storage.handle();
+    }
+    layer.removeStorage(removed);
+
+    NumericStorage<Int> storage{layer, DirectInit, 26};
+    CORRADE_COMPARE(storageHandleId(storage.handle()), storageHandleId(removed));
+    CORRADE_VERIFY(!storage.isAllocated());
+
+    Int called = 0;
+    storage->onUpdate([&called](Int value) {
+        CORRADE_COMPARE(value, 26);
+        ++called;
+    });
+    ui.update();
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+}
+
+void ConcurrentNumericStorageTest::updateThreaded() {
+    #ifndef CORRADE_BUILD_MULTITHREADED
+    CORRADE_SKIP("CORRADE_BUILD_MULTITHREADED is not enabled, can't test");
+    #elif defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_SKIP("Not built with pthreads, can't test");
+    #else
+    AbstractUserInterface ui{{100, 100}};
+    DataLayer& layer = ui.setLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    /* Two producer threads, each publishing an increasing sequence to its own
+       item, while the UI thread keeps updating until both are done */
+    enum: UnsignedInt { Count = 100000 };
+    ConcurrentNumericStorage<UnsignedInt> storage{layer, ValueInit, 2};
+
+    /* As each item is a single atomic and the values are only ever
+       increasing, the update functions should never see a value smaller than
+       what they saw before. The values aren't compared directly in the
+       functions as it'd spam the output with many thousands of failures if
+       something goes wrong. */
+    struct {
+        UnsignedInt last = 0;
+        UnsignedInt decreased = 0;
+    } state[2];
+    for(std::size_t i: {0, 1}) storage[i].onUpdate([&state, i](UnsignedInt value) {
+        if(value < state[i].last) ++state[i].decreased;
+        state[i].last = value;
+    });
+
+    std::atomic<Int> running{2};
+    const auto produce = [&running](ConcurrentNumericStorage<UnsignedInt>::Publisher publisher, std::size_t index) {
+        for(UnsignedInt i = 1; i <= Count; ++i)
+            publisher.publish(index, i);
+        --running;
+    };
+    std::thread producer0{produce, storage.publisher(), 0};
+    std::thread producer1{produce, storage.publisher(), 1};
+
+    while(running)
+        ui.update();
+
+    producer0.join();
+    producer1.join();
+
+    /* Once all producers are done, the final values are picked up either by
+       the loop above or by this update */
+    ui.update();
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE(storage[0], UnsignedInt(Count));
+    CORRADE_COMPARE(storage[1], UnsignedInt(Count));
+    for(std::size_t i: {0, 1}) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(state[i].last, UnsignedInt(Count));
+        CORRADE_COMPARE(state[i].decreased, 0);
+    }
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::ConcurrentNumericStorageTest)
@@ -26,6 +26,7 @@
 
 #include <Corrade/Containers/BitArrayView.h>
 #include <Corrade/Containers/Function.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/Iterable.h> /** @todo remove once NeedsDataClean doesn't need to be handled */
@@ -34,6 +35,7 @@
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Magnum/Math/Time.h>
 #include <Magnum/Math/Vector2.h> /* for referenceCounted() */
 
 #include "Magnum/Ui/AbstractAnimator.h" /** @todo remove once NeedsDataClean doesn't need to be handled */
@@ -106,6 +108,9 @@ struct DataLayerTest: TestSuite::Tester {
     void setIndex();
     void setIndexInvalid();
 
+    void setUpdateInterval();
+    void setUpdateIntervalInvalid();
+
     /* Tests both the DataLayer and StorageQuery value updating APIs */
     void updateValue();
     void updateValueInvalid();
@@ -118,11 +123,16 @@ struct DataLayerTest: TestSuite::Tester {
     /* No updateEmpty() like in other layers as doUpdate() currently isn't
        implemented at all */
     void update();
+    void updateMany();
+    void updateStorageReallocation();
+    void updateRemoveFromCallback();
+    void updateInterval();
 
     void referenceCounted();
 };
 
 using namespace Containers::Literals;
+using namespace Math::Literals;
 
 const struct {
     const char* name;
@@ -269,7 +279,10 @@ DataLayerTest::DataLayerTest() {
               &DataLayerTest::setDirty,
 
               &DataLayerTest::setIndex,
-              &DataLayerTest::setIndexInvalid});
+              &DataLayerTest::setIndexInvalid,
+
+              &DataLayerTest::setUpdateInterval,
+              &DataLayerTest::setUpdateIntervalInvalid});
 
     addInstancedTests({&DataLayerTest::updateValue},
         Containers::arraySize(UpdateValueData));
@@ -282,7 +295,11 @@ DataLayerTest::DataLayerTest() {
         Containers::arraySize(IndexLinearizationData));
 
     addTests({&DataLayerTest::clean,
-              &DataLayerTest::update});
+              &DataLayerTest::update,
+              &DataLayerTest::updateMany,
+              &DataLayerTest::updateStorageReallocation,
+              &DataLayerTest::updateRemoveFromCallback,
+              &DataLayerTest::updateInterval});
 
     addInstancedTests({&DataLayerTest::referenceCounted},
         Containers::arraySize(ReferenceCountedData));
@@ -3294,6 +3311,102 @@ void DataLayerTest::setIndexInvalid() {
         TestSuite::Compare::String);
 }
 
+void DataLayerTest::setUpdateInterval() {
+    struct DummyStorage: AbstractStorage {
+        explicit DummyStorage(DataLayer& layer): AbstractStorage{layer} {}
+
+        StorageQuery<Int> operator->() const {
+            return {*this, {}, [](const DummyStorage&, StorageOperation) {
+                return 667;
+            }};
+        }
+    };
+
+    DataLayer layer{layerHandle(0, 1)};
+    DummyStorage storage{layer};
+
+    /* Create a few dummy data to verify it doesn't always update the first */
+    storage->onUpdate([](const Int&) {});
+    storage->onUpdate([](const Int&) {});
+
+    Int called = 0;
+    DataHandle data = storage->onUpdate([&called](const Int&) {
+        ++called;
+    });
+
+    /* The interval is zero by default */
+    CORRADE_COMPARE(layer.updateInterval(data), 0_nsec);
+    CORRADE_COMPARE(layer.updateInterval(dataHandleData(data)), 0_nsec);
+
+    layer.setUpdateInterval(data, 15_nsec);
+    CORRADE_COMPARE(layer.updateInterval(data), 15_nsec);
+    CORRADE_COMPARE(layer.updateInterval(dataHandleData(data)), 15_nsec);
+
+    /* LayerDataHandle overload */
+    layer.setUpdateInterval(dataHandleData(data), 37_nsec);
+    CORRADE_COMPARE(layer.updateInterval(data), 37_nsec);
+    CORRADE_COMPARE(layer.updateInterval(dataHandleData(data)), 37_nsec);
+
+    /* Without a UI there's no time source, so the interval is ignored and the
+       function is called every time the data is dirty */
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(!layer.isDirty(data));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    layer.setDirty(data);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(called, 2);
+    CORRADE_VERIFY(!layer.isDirty(data));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Setting an interval on a data that isn't dirty doesn't set any state */
+    layer.setUpdateInterval(data, 0_nsec);
+    CORRADE_COMPARE(layer.updateInterval(data), 0_nsec);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Removing and recreating the data resets the interval back to zero */
+    layer.setUpdateInterval(data, 15_nsec);
+    layer.remove(data);
+    DataHandle data2 = storage->onUpdate([](const Int&) {});
+    CORRADE_COMPARE(dataHandleId(data2), dataHandleId(data));
+    CORRADE_COMPARE(layer.updateInterval(data2), 0_nsec);
+}
+
+void DataLayerTest::setUpdateIntervalInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* Invalid handles passed to setUpdateInterval() tested in invalidHandle()
+       below */
+
+    struct DummyStorage: AbstractStorage {
+        explicit DummyStorage(DataLayer& layer): AbstractStorage{layer} {}
+
+        StorageQuery<Int> operator->() const {
+            return {*this, {}, [](const DummyStorage&, StorageOperation) -> Int {
+                CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+            }};
+        }
+    };
+
+    DataLayer layer{layerHandle(0, 1)};
+    DummyStorage storage{layer};
+
+    DataHandle data = storage->onUpdate([](const Int&) {});
+
+    Containers::String out;
+    Error redirectError{&out};
+    layer.setUpdateInterval(data, -1_nsec);
+    layer.setUpdateInterval(dataHandleData(data), -1_nsec);
+    CORRADE_COMPARE_AS(out,
+        "Ui::DataLayer::setUpdateInterval(): expected non-negative interval, got Nanoseconds(-1)\n"
+        "Ui::DataLayer::setUpdateInterval(): expected non-negative interval, got Nanoseconds(-1)\n",
+        TestSuite::Compare::String);
+}
+
 void DataLayerTest::updateValue() {
     auto&& data = UpdateValueData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -3548,6 +3661,10 @@ void DataLayerTest::invalidHandle() {
     layer.setIndex(LayerDataHandle::Null, {0, 0});
     layer.setIndex(DataHandle::Null, {0, 0, 0});
     layer.setIndex(LayerDataHandle::Null, {0, 0, 0});
+    layer.updateInterval(DataHandle::Null);
+    layer.updateInterval(LayerDataHandle::Null);
+    layer.setUpdateInterval(DataHandle::Null, {});
+    layer.setUpdateInterval(LayerDataHandle::Null, {});
     layer.isMutable(DataHandle::Null);
     layer.isMutable(LayerDataHandle::Null);
     layer.operations(DataHandle::Null);
@@ -3583,6 +3700,10 @@ void DataLayerTest::invalidHandle() {
         "Ui::DataLayer::setIndex(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::DataLayer::setIndex(): invalid handle Ui::DataHandle::Null\n"
         "Ui::DataLayer::setIndex(): invalid handle Ui::LayerDataHandle::Null\n"
+        "Ui::DataLayer::updateInterval(): invalid handle Ui::DataHandle::Null\n"
+        "Ui::DataLayer::updateInterval(): invalid handle Ui::LayerDataHandle::Null\n"
+        "Ui::DataLayer::setUpdateInterval(): invalid handle Ui::DataHandle::Null\n"
+        "Ui::DataLayer::setUpdateInterval(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::DataLayer::isMutable(): invalid handle Ui::DataHandle::Null\n"
         "Ui::DataLayer::isMutable(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::DataLayer::operations(): invalid handle Ui::DataHandle::Null\n"
@@ -3964,6 +4085,348 @@ void DataLayerTest::update() {
     CORRADE_COMPARE(layer.state(), LayerStates{});
 }
 
+void DataLayerTest::updateMany() {
+    /* Like update(), but with enough data and storages for the dirty bits to
+       span multiple words, interleaved and with some removed from the middle,
+       verifying only data associated with dirty storages get updated */
+
+    DataLayer layer{layerHandle(0, 1)};
+
+    struct Storage: AbstractStorage {
+        explicit Storage(DataLayer& layer): AbstractStorage{layer} {}
+
+        StorageQuery<Int> value() const {
+            return {*this, {}, [](const Storage&, StorageOperation) {
+                return 0;
+            }};
+        }
+    };
+
+    /* 150 storages in total, with only storage 0, 50 and 100 used */
+    const auto createUnusedStorages = [&layer](std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i)
+            Storage{layer};
+    };
+    Storage storage0{layer};
+    createUnusedStorages(49);
+    Storage storage50{layer};
+    createUnusedStorages(49);
+    Storage storage100{layer};
+    createUnusedStorages(48);
+    Storage storage149{layer};
+    CORRADE_COMPARE(layer.storageUsedCount(), 150);
+
+    /* 300 data, alternating between storage 0, 50 and 100 */
+    const Storage* const storages[]{&storage0, &storage50, &storage100};
+    Int called[300]{};
+    DataHandle data[300];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = storages[i % 3]->value().onUpdate([&called, i](const Int&) {
+            ++called[i];
+        });
+
+    /* Remove every fifth data to have holes in the per-storage lists */
+    for(std::size_t i = 0; i < Containers::arraySize(data); i += 5)
+        layer.remove(data[i]);
+    layer.cleanData({});
+
+    /* The first update calls all remaining data */
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], i % 5 ? 1 : 0);
+    }
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Marking one storage dirty calls only the data associated with it */
+    storage50.setDirty();
+    CORRADE_VERIFY(storage50.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], !(i % 5) ? 0 : i % 3 == 1 ? 2 : 1);
+    }
+    CORRADE_VERIFY(!storage50.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Marking an unused storage past the first word dirty calls nothing, but
+       the dirty bit gets reset again */
+    storage149.setDirty();
+    CORRADE_VERIFY(storage149.isDirty());
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], !(i % 5) ? 0 : i % 3 == 1 ? 2 : 1);
+    }
+    CORRADE_VERIFY(!storage149.isDirty());
+
+    /* Marking a data past the first word and a storage dirty calls both, the
+       data just once even if it's associated with the dirty storage */
+    layer.setDirty(data[298]);
+    layer.setDirty(data[299]);
+    storage100.setDirty();
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i],
+            !(i % 5) ? 0 :
+            i == 298 ? 3 :
+            i % 3 == 2 ? 2 :
+            i % 3 == 1 ? 2 : 1);
+    }
+    CORRADE_VERIFY(!layer.isDirty(data[298]));
+    CORRADE_VERIFY(!layer.isDirty(data[299]));
+    CORRADE_VERIFY(!storage100.isDirty());
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+}
+
+void DataLayerTest::updateStorageReallocation() {
+    /* The layer passes storage data pointers to the query functions directly
+       in doPreUpdate(). Verify that it's done correctly for both in-place and
+       allocated storages and that it isn't stale if the storage array gets
+       reallocated by one of the update functions. */
+
+    DataLayer layer{layerHandle(0, 1)};
+
+    struct InPlaceStorage: AbstractStorage {
+        explicit InPlaceStorage(DataLayer& layer, Int value): AbstractStorage{layer} {
+            *createInPlace<Int>() = value;
+        }
+
+        StorageQuery<Int> value() const {
+            return {*this, {}, [](const InPlaceStorage& storage, StorageOperation) {
+                return *storage.data<Int>();
+            }};
+        }
+    };
+
+    struct AllocatedStorage: AbstractStorage {
+        explicit AllocatedStorage(DataLayer& layer, Int* value): AbstractStorage{layer} {
+            createAllocated(value, 0, [](void*, std::size_t) {});
+        }
+
+        StorageQuery<Int> value() const {
+            return {*this, {}, [](const AllocatedStorage& storage, StorageOperation) {
+                return *storage.data<Int>();
+            }};
+        }
+    };
+
+    Int allocatedValue = 1337;
+    InPlaceStorage inPlace1{layer, 17};
+    AllocatedStorage allocated{layer, &allocatedValue};
+
+    /* The first update function creates enough storages to make the storage
+       array reallocate, the second then should still get the correct in-place
+       value */
+    Int values[3]{};
+    inPlace1.value().onUpdate([&layer, &values](const Int& value) {
+        values[0] = value;
+        for(std::size_t i = 0; i != 100; ++i)
+            InPlaceStorage{layer, 0};
+    });
+    inPlace1.value().onUpdate([&values](const Int& value) {
+        values[1] = value;
+    });
+    allocated.value().onUpdate([&values](const Int& value) {
+        values[2] = value;
+    });
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    CORRADE_COMPARE(layer.storageUsedCount(), 102);
+    CORRADE_COMPARE_AS(Containers::arrayView(values), Containers::arrayView({
+        17, 17, 1337
+    }), TestSuite::Compare::Container);
+}
+
+void DataLayerTest::updateRemoveFromCallback() {
+    /* An update function removing other data that are dirty as well. Data
+       that are removed before they get to be called shouldn't be called,
+       both if they're in the same dirty bit word as the removing data and
+       if they're in a later one. */
+
+    DataLayer layer{layerHandle(0, 1)};
+
+    struct Storage: AbstractStorage {
+        explicit Storage(DataLayer& layer): AbstractStorage{layer} {}
+
+        StorageQuery<Int> value() const {
+            return {*this, {}, [](const Storage&, StorageOperation) {
+                return 0;
+            }};
+        }
+    } storage{layer};
+
+    /* Data 10 removes data 5, which was already called, data 20, which is in
+       the same word, and data 80, which is in the next word */
+    Int called[100]{};
+    DataHandle data[100];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        if(i == 10) data[i] = storage.value().onUpdate([&layer, &called, &data](const Int&) {
+            ++called[10];
+            layer.remove(data[5]);
+            layer.remove(data[20]);
+            layer.remove(data[80]);
+        });
+        else data[i] = storage.value().onUpdate([&called, i](const Int&) {
+            ++called[i];
+        });
+    }
+
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], i == 20 || i == 80 ? 0 : 1);
+    }
+    CORRADE_VERIFY(!layer.isHandleValid(data[5]));
+    CORRADE_VERIFY(!layer.isHandleValid(data[20]));
+    CORRADE_VERIFY(!layer.isHandleValid(data[80]));
+    CORRADE_COMPARE(layer.usedCount(), 97);
+
+    /* The removed data stay uncalled when the storage is marked dirty
+       again, the remaining ones get called once more. Data 10 gets called
+       again as well, but the handles it removes are stale now, so skip it
+       by removing it first. */
+    layer.remove(data[10]);
+    storage.setDirty();
+    layer.preUpdate(LayerState::NeedsCommonDataUpdate);
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(called[i], i == 20 || i == 80 ? 0 : i == 5 || i == 10 ? 1 : 2);
+    }
+}
+
+void DataLayerTest::updateInterval() {
+    struct ValueStorage: AbstractStorage {
+        explicit ValueStorage(DataLayer& layer): AbstractStorage{layer} {
+            *createInPlace<Int>() = 0;
+        }
+
+        void set(Int value) {
+            *data<Int>() = value;
+            setDirty();
+        }
+
+        StorageQuery<Int> operator->() const {
+            return {*this, {}, [](const ValueStorage& storage, StorageOperation) {
+                return *storage.data<Int>();
+            }};
+        }
+    };
+
+    /* Note that the referenced variables have to be *before* the UI in
+       order for them to be still in scope when the UI (and thus the layer)
+       destructor destructs remaining functions. ASan complains otherwise. */
+    Containers::Array<Int> throttled, unthrottled;
+
+    AbstractUserInterface ui{{100, 100}};
+    DataLayer& layer = ui.setLayerInstance(Containers::pointer<DataLayer>(ui.createLayer()));
+
+    ValueStorage storage{layer};
+    DataHandle throttledData = storage->onUpdate([&throttled](const Int& value) {
+        arrayAppend(throttled, value);
+    });
+    storage->onUpdate([&unthrottled](const Int& value) {
+        arrayAppend(unthrottled, value);
+    });
+    layer.setUpdateInterval(throttledData, 10_nsec);
+
+    /* The first call isn't delayed */
+    ui.advanceAnimations(100_nsec);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Changing the value sooner than the interval calls only the unthrottled
+       function, the throttled data stays dirty */
+    storage.set(1);
+    ui.advanceAnimations(103_nsec);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(layer.isDirty(throttledData));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* More changes in the meantime get coalesced */
+    storage.set(2);
+    ui.advanceAnimations(106_nsec);
+    ui.update();
+    storage.set(3);
+    ui.advanceAnimations(109_nsec);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0, 1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(layer.isDirty(throttledData));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Once the interval passes, the layer asks for an update on its own even
+       if nothing changed, and only the latest value is passed to the
+       throttled function */
+    ui.advanceAnimations(110_nsec);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0, 1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!layer.isDirty(throttledData));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Changing the value after more than the interval passed calls it
+       directly again */
+    ui.advanceAnimations(125_nsec);
+    storage.set(4);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0, 3, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0, 1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+
+    /* Changing the interval while the call is postponed re-evaluates it on
+       the next update */
+    storage.set(5);
+    ui.advanceAnimations(127_nsec);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0, 3, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(layer.isDirty(throttledData));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    layer.setUpdateInterval(throttledData, 0_nsec);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    ui.update();
+    CORRADE_COMPARE_AS(throttled, Containers::arrayView({
+        0, 3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unthrottled, Containers::arrayView({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!layer.isDirty(throttledData));
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+}
+
 void DataLayerTest::referenceCounted() {
     auto&& data = ReferenceCountedData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <cstdio>
+#include <cstdlib>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Format.h>
+
+#include "Magnum/Ui/Formatter.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct FormatterBenchmark: TestSuite::Tester {
+    explicit FormatterBenchmark();
+
+    void formatDecimal();
+    void formatDecimalBatch();
+    void formatDecimalSnprintf();
+    void formatHexadecimal();
+    void formatHexadecimalSnprintf();
+    void formatFloat();
+    void formatFloatBatch();
+    void formatFloatSnprintf();
+
+    void parseDecimal();
+    void parseDecimalStrtol();
+    void parseHexadecimal();
+    void parseHexadecimalStrtol();
+
+    private:
+        Containers::Array<Int> _ints;
+        Containers::Array<Float> _floats;
+        /* Total formatted sizes, to verify both variants produce the same
+           amount of text */
+        std::size_t _decimalSize = 0, _hexadecimalSize = 0, _floatSize = 0;
+        Containers::Array<Containers::String> _decimalText, _hexadecimalText;
+};
+
+/* Count of values formatted or parsed in a single benchmark iteration,
+   roughly corresponding to a large table being updated every frame */
+constexpr std::size_t Count = 10000;
+
+FormatterBenchmark::FormatterBenchmark() {
+    addBenchmarks({&FormatterBenchmark::formatDecimal,
+                   &FormatterBenchmark::formatDecimalBatch,
+                   &FormatterBenchmark::formatDecimalSnprintf,
+                   &FormatterBenchmark::formatHexadecimal,
+                   &FormatterBenchmark::formatHexadecimalSnprintf,
+                   &FormatterBenchmark::formatFloat,
+                   &FormatterBenchmark::formatFloatBatch,
+                   &FormatterBenchmark::formatFloatSnprintf,
+
+                   &FormatterBenchmark::parseDecimal,
+                   &FormatterBenchmark::parseDecimalStrtol,
+                   &FormatterBenchmark::parseHexadecimal,
+                   &FormatterBenchmark::parseHexadecimalStrtol}, 10);
+
+    /* A deterministic mix of short and long, positive and negative values */
+    _ints = Containers::Array<Int>{NoInit, Count};
+    _floats = Containers::Array<Float>{NoInit, Count};
+    UnsignedInt seed = 1337;
+    for(std::size_t i = 0; i != Count; ++i) {
+        seed = seed*1664525u + 1013904223u;
+        _ints[i] = Int(seed) >> (i % 24);
+        _floats[i] = Float(_ints[i])/Float(1 << (i % 16));
+    }
+
+    /* Formatted text for the parsing benchmarks. Each value is a separate
+       string, as the parsers expect null-terminated input. */
+    _decimalText = Containers::Array<Containers::String>{Count};
+    _hexadecimalText = Containers::Array<Containers::String>{Count};
+    for(std::size_t i = 0; i != Count; ++i) {
+        _decimalText[i] = Utility::format("{}", _ints[i]);
+        _hexadecimalText[i] = Utility::format("{:x}", UnsignedInt(_ints[i]));
+        _decimalSize += _decimalText[i].size();
+        _hexadecimalSize += _hexadecimalText[i].size();
+        _floatSize += Utility::format("{}", _floats[i]).size();
+    }
+}
+
+void FormatterBenchmark::formatDecimal() {
+    const DecimalFormatter formatter;
+
+    char buffer[256];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Int i: _ints)
+            size += formatter.formatInto(bufferView, i);
+    }
+
+    CORRADE_COMPARE(size, _decimalSize);
+}
+
+void FormatterBenchmark::formatDecimalBatch() {
+    const DecimalFormatter formatter;
+
+    Containers::String buffer{NoInit, Count*256};
+    Containers::Array<UnsignedInt> offsets{NoInit, Count + 1};
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        size += formatter.formatInto(buffer, _ints, offsets);
+    }
+
+    CORRADE_COMPARE(size, _decimalSize);
+}
+
+void FormatterBenchmark::formatDecimalSnprintf() {
+    char buffer[256];
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Int i: _ints)
+            size += std::snprintf(buffer, sizeof(buffer), "%i", i);
+    }
+
+    CORRADE_COMPARE(size, _decimalSize);
+}
+
+void FormatterBenchmark::formatHexadecimal() {
+    const HexadecimalFormatter formatter;
+
+    char buffer[258];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Int i: _ints)
+            size += formatter.formatInto(bufferView, UnsignedInt(i));
+    }
+
+    CORRADE_COMPARE(size, _hexadecimalSize);
+}
+
+void FormatterBenchmark::formatHexadecimalSnprintf() {
+    char buffer[258];
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Int i: _ints)
+            size += std::snprintf(buffer, sizeof(buffer), "%x", UnsignedInt(i));
+    }
+
+    CORRADE_COMPARE(size, _hexadecimalSize);
+}
+
+void FormatterBenchmark::formatFloat() {
+    const FloatFormatter formatter;
+
+    char buffer[566];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Float i: _floats)
+            size += formatter.formatInto(bufferView, i);
+    }
+
+    CORRADE_COMPARE(size, _floatSize);
+}
+
+void FormatterBenchmark::formatFloatBatch() {
+    const FloatFormatter formatter;
+
+    Containers::String buffer{NoInit, Count*(566 + 1)};
+    Containers::Array<UnsignedInt> offsets{NoInit, Count + 1};
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        size += formatter.formatInto(buffer, _floats, offsets);
+    }
+
+    CORRADE_COMPARE(size, _floatSize);
+}
+
+void FormatterBenchmark::formatFloatSnprintf() {
+    char buffer[566 + 1];
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Float i: _floats)
+            size += std::snprintf(buffer, sizeof(buffer), "%.*g", 6, Double(i));
+    }
+
+    CORRADE_COMPARE(size, _floatSize);
+}
+
+void FormatterBenchmark::parseDecimal() {
+    Long sum = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Containers::String& i: _decimalText) {
+            Int value;
+            DecimalFormatter::parse(i, value);
+            sum += value;
+        }
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void FormatterBenchmark::parseDecimalStrtol() {
+    Long sum = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Containers::String& i: _decimalText)
+            sum += Int(std::strtol(i.data(), nullptr, 10));
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void FormatterBenchmark::parseHexadecimal() {
+    UnsignedLong sum = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Containers::String& i: _hexadecimalText) {
+            UnsignedInt value;
+            HexadecimalFormatter::parse(i, value);
+            sum += value;
+        }
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+void FormatterBenchmark::parseHexadecimalStrtol() {
+    UnsignedLong sum = 0;
+    CORRADE_BENCHMARK(1) {
+        for(const Containers::String& i: _hexadecimalText)
+            sum += UnsignedInt(std::strtoul(i.data(), nullptr, 16));
+    }
+
+    CORRADE_VERIFY(sum);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::FormatterBenchmark)
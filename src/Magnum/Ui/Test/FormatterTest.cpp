@@ -24,11 +24,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <Corrade/Containers/ArrayView.h> /* arraySize() */
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h> /* addFont() glyphMapping */
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/Format.h>
 #include <Magnum/PixelFormat.h>
@@ -73,6 +75,15 @@ struct FormatterTest: TestSuite::Tester {
     void formatFloatLayerDataHandle();
     template<class T, class U> void formatInvalid();
 
+    void formatDecimalInto();
+    void formatHexadecimalInto();
+    void formatFloatInto();
+    void formatIntoBufferTooSmall();
+    template<class T> void formatDecimalIntoBatch();
+    template<class T> void formatHexadecimalIntoBatch();
+    template<class T> void formatFloatIntoBatch();
+    void formatIntoBatchInvalid();
+
     void parseDecimal();
     void parseDecimalFailed();
     void parseHexadecimal();
@@ -639,6 +650,81 @@ const struct {
       /* 123456789012345                                                255 */
         "000000000000000", nullptr},
 
+    /* The following are primarily testing the rounding in the internal
+       formatting implementation, which should match printf() */
+    {"rounding a tie to even, decimal",
+        FloatFormatter::Flag::Decimal, 2,
+        0.125f, 0.0,
+        "0.12", nullptr},
+    {"rounding a tie to even, decimal, odd",
+        FloatFormatter::Flag::Decimal, 2,
+        0.375f, 0.0,
+        "0.38", nullptr},
+    {"rounding a tie to even, decimal, zero precision",
+        FloatFormatter::Flag::Decimal, 0,
+        2.5f, 0.0,
+        "2", nullptr},
+    {"rounding a tie to even, decimal, zero precision, odd",
+        FloatFormatter::Flag::Decimal, 0,
+        3.5f, 0.0,
+        "4", nullptr},
+    {"rounding to the next power of ten", {}, {},
+        9.999999f, 0.0,
+        "10", nullptr},
+    {"rounding to the next power of ten, exponent",
+        FloatFormatter::Flag::Exponent, 2,
+        9.999f, 0.0,
+        /* MinGW prints the exponent with three decimals always */
+        #ifdef CORRADE_TARGET_MINGW
+        "1.00e+001",
+        #else
+        "1.00e+01",
+        #endif
+        nullptr},
+    {"rounding to more digits than precision", {}, {},
+        123456.7f, 0.0,
+        "123457", nullptr},
+    {"more digits than precision", {}, {},
+        1234567.0f, 0.0,
+        #ifdef CORRADE_TARGET_MINGW
+        "1.23457e+006",
+        #else
+        "1.23457e+06",
+        #endif
+        nullptr},
+    {"small value, default, switching to exponent", {}, {},
+        0.00001f, 0.0,
+        #ifdef CORRADE_TARGET_MINGW
+        "1e-005",
+        #else
+        "1e-05",
+        #endif
+        nullptr},
+    {"small value, default, not yet switching to exponent", {}, {},
+        0.0001f, 0.0,
+        "0.0001", nullptr},
+    {"small value, default, switching to exponent, uppercase",
+        FloatFormatter::Flag::Uppercase, {},
+        0.00001f, 0.0,
+        #ifdef CORRADE_TARGET_MINGW
+        "1E-005",
+        #else
+        "1E-05",
+        #endif
+        nullptr},
+    /* This has 17 significant digits in the output, which is still handled by
+       the internal implementation */
+    {"double value, decimal, large precision",
+        FloatFormatter::Flag::Decimal, 16,
+        0.0f, 0.1,
+        "0.1000000000000000", nullptr},
+    /* This has 21 significant digits, which goes through the printf()
+       fallback */
+    {"double value, decimal, larger precision",
+        FloatFormatter::Flag::Decimal, 20,
+        0.0f, 0.1,
+        "0.10000000000000000555", nullptr},
+
     {"zero", {}, {},
         0.0f, 0.0,
         "0", nullptr},
@@ -1236,15 +1322,15 @@ const struct {
     {"positive uppercase hex prefix alone", "+0X"},
     {"negative hex prefix alone", "-0x"},
     {"negative uppercase hex prefix alone", "-0X"},
-    /* Internally if a # is found, the string is copied and the # gets replaced
-       with 0 before passing it further. But replacing it the wrong way could
-       cause invalid inputs to be treated as valid, so test that these fail as
-       they should. */
+    /* The # is treated as an equivalent of a 0x prefix, but it shouldn't be
+       treated as a 0 in any other way, so test that these fail as they
+       should. */
     {"multiple hash prefixes", "###abcdef"}, /* 000abcdef is valid */
     {"hash prefix in the middle", "a#bcdef"}, /* a0bcdef is valid */
     {"hash prefix alone", "#"}, /* 0 is valid */
     {"positive hash prefix alone", "+#"}, /* 0 is valid */
     {"negative hash prefix alone", "-#"}, /* 0 is valid */
+    {"hash prefix followed by x", "#xabcdef"}, /* 0xabcdef is valid */
 
     /* Cases that currently fail but maybe eventually shouldn't? */
     {"space in the middle", "feed cafe"},
@@ -1493,6 +1579,29 @@ FormatterTest::FormatterTest() {
         &FormatterTest::formatInvalid<FloatFormatter, Float>,
         &FormatterTest::formatInvalid<FloatFormatter, Double>});
 
+    addInstancedTests({&FormatterTest::formatDecimalInto},
+        Containers::arraySize(FormatDecimalData));
+
+    addInstancedTests({&FormatterTest::formatHexadecimalInto},
+        Containers::arraySize(FormatHexadecimalData));
+
+    addInstancedTests({&FormatterTest::formatFloatInto},
+        Containers::arraySize(FormatFloatData));
+
+    addTests<FormatterTest>({
+        &FormatterTest::formatIntoBufferTooSmall,
+        &FormatterTest::formatDecimalIntoBatch<Int>,
+        &FormatterTest::formatDecimalIntoBatch<UnsignedInt>,
+        &FormatterTest::formatDecimalIntoBatch<Long>,
+        &FormatterTest::formatDecimalIntoBatch<UnsignedLong>,
+        &FormatterTest::formatHexadecimalIntoBatch<Int>,
+        &FormatterTest::formatHexadecimalIntoBatch<UnsignedInt>,
+        &FormatterTest::formatHexadecimalIntoBatch<Long>,
+        &FormatterTest::formatHexadecimalIntoBatch<UnsignedLong>,
+        &FormatterTest::formatFloatIntoBatch<Float>,
+        &FormatterTest::formatFloatIntoBatch<Double>,
+        &FormatterTest::formatIntoBatchInvalid});
+
     addInstancedTests({&FormatterTest::parseDecimal},
         Containers::arraySize(ParseDecimalData));
 
@@ -1941,6 +2050,339 @@ template<class T, class U> void FormatterTest::formatInvalid() {
         TestSuite::Compare::String);
 }
 
+void FormatterTest::formatDecimalInto() {
+    auto&& data = FormatDecimalData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Only one or the other should be non-zero */
+    CORRADE_INTERNAL_ASSERT(!data.value || !data.valueUnsigned);
+
+    DecimalFormatter formatter{data.flags};
+    if(data.minWidth)
+        formatter.setMinWidth(*data.minWidth);
+
+    /* Test with all possible type variants, same as in formatDecimal(). The
+       buffer is exactly as large as the longest possible output, and the
+       second variant has exactly the size of the expected output, which goes
+       through a different code path internally. */
+    char buffer[256];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    const Containers::MutableStringView exact{buffer, std::strlen(data.expected)};
+
+    /* 32-bit signed type */
+    {
+        const Int value = data.valueUnsigned ? Int(data.valueUnsigned) : Int(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned && data.value >= -(1ll << 31) && data.value < (1ll << 31)) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 32-bit unsigned type */
+    {
+        const UnsignedInt value = data.valueUnsigned ? UnsignedInt(data.valueUnsigned) : UnsignedInt(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned && data.value >= 0 && data.value < (1ll << 32)) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 64-bit signed type */
+    {
+        const Long value = data.valueUnsigned ? Long(data.valueUnsigned) : data.value;
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 64-bit unsigned type */
+    {
+        const UnsignedLong value = data.valueUnsigned ? data.valueUnsigned : UnsignedLong(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(data.valueUnsigned || data.value >= 0) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+}
+
+void FormatterTest::formatHexadecimalInto() {
+    auto&& data = FormatHexadecimalData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Only one or the other should be non-zero */
+    CORRADE_INTERNAL_ASSERT(!data.value || !data.valueUnsigned);
+
+    HexadecimalFormatter formatter{data.flags};
+    if(data.minWidth)
+        formatter.setMinWidth(*data.minWidth);
+
+    /* Same as in formatDecimalInto() */
+    char buffer[258];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    const Containers::MutableStringView exact{buffer, std::strlen(data.expected)};
+
+    /* 32-bit signed type */
+    {
+        const Int value = data.valueUnsigned ? Int(data.valueUnsigned) : Int(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned && data.value >= -(1ll << 31) && data.value < (1ll << 31)) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 32-bit unsigned type */
+    {
+        const UnsignedInt value = data.valueUnsigned ? UnsignedInt(data.valueUnsigned) : UnsignedInt(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned && data.value >= 0 && data.value < (1ll << 32)) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 64-bit signed type */
+    {
+        const Long value = data.valueUnsigned ? Long(data.valueUnsigned) : data.value;
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueUnsigned) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 64-bit unsigned type */
+    {
+        const UnsignedLong value = data.valueUnsigned ? data.valueUnsigned : UnsignedLong(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(data.valueUnsigned || data.value >= 0) {
+            CORRADE_COMPARE(out, data.expected);
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE(Containers::StringView{exact}, data.expected);
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+}
+
+void FormatterTest::formatFloatInto() {
+    auto&& data = FormatFloatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Only one or the other should be non-zero */
+    CORRADE_INTERNAL_ASSERT(!data.value || !data.valueDouble);
+
+    FloatFormatter formatter{data.flags};
+    if(data.precision)
+        formatter.setPrecision(*data.precision);
+
+    /* Same as in formatDecimalInto() */
+    char buffer[566];
+    const Containers::MutableStringView bufferView{buffer, sizeof(buffer)};
+    const Containers::MutableStringView exact{buffer, std::strlen(data.expected)};
+
+    /* 32-bit type */
+    {
+        const Float value = data.valueDouble ? Float(data.valueDouble) : data.value;
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        if(!data.valueDouble) {
+            {
+                CORRADE_EXPECT_FAIL_IF(data.xfail, data.xfail);
+                CORRADE_COMPARE_AS(out,
+                    data.expected,
+                    TestSuite::Compare::String);
+            }
+            if(!data.xfail) {
+                CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+                CORRADE_COMPARE_AS(Containers::StringView{exact},
+                    data.expected,
+                    TestSuite::Compare::String);
+            }
+        } else CORRADE_VERIFY(out != data.expected);
+    }
+
+    /* 64-bit type. This should pass always. */
+    {
+        const Double value = data.valueDouble ? data.valueDouble : Double(data.value);
+        Containers::StringView out{buffer, formatter.formatInto(bufferView, value)};
+        {
+            CORRADE_EXPECT_FAIL_IF(data.xfail, data.xfail);
+            CORRADE_COMPARE_AS(out,
+                data.expected,
+                TestSuite::Compare::String);
+        }
+        if(!data.xfail) {
+            CORRADE_COMPARE(formatter.formatInto(exact, value), exact.size());
+            CORRADE_COMPARE_AS(Containers::StringView{exact},
+                data.expected,
+                TestSuite::Compare::String);
+        }
+    }
+}
+
+void FormatterTest::formatIntoBufferTooSmall() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char buffer[8];
+
+    /* Exactly the size should be fine */
+    CORRADE_COMPARE(DecimalFormatter{}.formatInto({buffer, 5}, -1337), 5);
+    CORRADE_COMPARE(HexadecimalFormatter{HexadecimalFormatter::Flag::BasePrefix}.formatInto({buffer, 6}, 0xcafe), 6);
+    CORRADE_COMPARE(FloatFormatter{}.formatInto({buffer, 6}, 13.375f), 6);
+
+    Containers::String out;
+    Error redirectError{&out};
+    DecimalFormatter{}.formatInto({buffer, 4}, -1337);
+    DecimalFormatter{}.formatInto({buffer, 4}, 13370ull);
+    HexadecimalFormatter{HexadecimalFormatter::Flag::BasePrefix}.formatInto({buffer, 5}, 0xcafe);
+    HexadecimalFormatter{HexadecimalFormatter::Flag::BasePrefix}.formatInto({buffer, 5}, 0xcafeu);
+    FloatFormatter{}.formatInto({buffer, 5}, 13.375f);
+    FloatFormatter{}.formatInto({buffer, 5}, 13.375);
+    /* Going through the printf() fallback */
+    FloatFormatter{}.formatInto({buffer, 2}, Constants::inf());
+    CORRADE_COMPARE_AS(out,
+        "Ui::DecimalFormatter::formatInto(): expected a buffer with at least 5 bytes but got 4\n"
+        "Ui::DecimalFormatter::formatInto(): expected a buffer with at least 5 bytes but got 4\n"
+        "Ui::HexadecimalFormatter::formatInto(): expected a buffer with at least 6 bytes but got 5\n"
+        "Ui::HexadecimalFormatter::formatInto(): expected a buffer with at least 6 bytes but got 5\n"
+        "Ui::FloatFormatter::formatInto(): expected a buffer with at least 6 bytes but got 5\n"
+        "Ui::FloatFormatter::formatInto(): expected a buffer with at least 6 bytes but got 5\n"
+        "Ui::FloatFormatter::formatInto(): expected a buffer with at least 3 bytes but got 2\n",
+        TestSuite::Compare::String);
+}
+
+template<class T> void FormatterTest::formatDecimalIntoBatch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Values interleaved with other data to verify the strides are taken into
+       account */
+    struct Value {
+        T value;
+        Int other;
+    } values[]{
+        {T(1337), 0},
+        {T(0), 0},
+        {T(7), 0},
+        {T(65535), 0}
+    };
+
+    DecimalFormatter formatter{DecimalFormatter::Flag::ExplicitPlus};
+    formatter.setMinWidth(2);
+
+    /* The buffer is large enough to format everything directly at first but
+       not at the end, going through the temporary there */
+    char buffer[256 + 5];
+    UnsignedInt offsets[5];
+    CORRADE_COMPARE(formatter.formatInto(
+        Containers::MutableStringView{buffer, sizeof(buffer)},
+        Containers::stridedArrayView(values).slice(&Value::value),
+        offsets), 17);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<UnsignedInt>({
+        0, 5, 8, 11, 17
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE((Containers::StringView{buffer, 17}), "+1337+00+07+65535");
+}
+
+template<class T> void FormatterTest::formatHexadecimalIntoBatch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Same as formatDecimalIntoBatch() */
+    struct Value {
+        T value;
+        Int other;
+    } values[]{
+        {T(0xcafe), 0},
+        {T(0), 0},
+        {T(0xa), 0},
+        {T(0xbeef), 0}
+    };
+
+    HexadecimalFormatter formatter{HexadecimalFormatter::Flag::BasePrefix|HexadecimalFormatter::Flag::Uppercase};
+    formatter.setMinWidth(2);
+
+    char buffer[258 + 5];
+    UnsignedInt offsets[5];
+    CORRADE_COMPARE(formatter.formatInto(
+        Containers::MutableStringView{buffer, sizeof(buffer)},
+        Containers::stridedArrayView(values).slice(&Value::value),
+        offsets), 20);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<UnsignedInt>({
+        0, 6, 10, 14, 20
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE((Containers::StringView{buffer, 20}), "0XCAFE0X000X0A0XBEEF");
+}
+
+template<class T> void FormatterTest::formatFloatIntoBatch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* Same as formatDecimalIntoBatch() */
+    struct Value {
+        T value;
+        Int other;
+    } values[]{
+        {T(13.37), 0},
+        {T(-0.5), 0},
+        /* Goes through the printf() fallback */
+        {Constants::inf(), 0},
+        {T(2.5), 0}
+    };
+
+    FloatFormatter formatter{FloatFormatter::Flag::Decimal};
+    formatter.setPrecision(1);
+
+    char buffer[566 + 1 + 5];
+    UnsignedInt offsets[5];
+    CORRADE_COMPARE(formatter.formatInto(
+        Containers::MutableStringView{buffer, sizeof(buffer)},
+        Containers::stridedArrayView(values).slice(&Value::value),
+        offsets), 14);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<UnsignedInt>({
+        0, 4, 8, 11, 14
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE((Containers::StringView{buffer, 14}), "13.4-0.5inf2.5");
+}
+
+void FormatterTest::formatIntoBatchInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Int ints[]{1337, 13370};
+    const Double doubles[]{13.37, 133.7};
+    char buffer[16];
+    UnsignedInt offsets[3];
+
+    /* Exactly the size should be fine */
+    CORRADE_COMPARE(DecimalFormatter{}.formatInto({buffer, 9}, ints, offsets), 9);
+    CORRADE_COMPARE(HexadecimalFormatter{}.formatInto({buffer, 7}, ints, offsets), 7);
+    CORRADE_COMPARE(FloatFormatter{}.formatInto({buffer, 10}, doubles, offsets), 10);
+
+    Containers::String out;
+    Error redirectError{&out};
+    DecimalFormatter{}.formatInto({buffer, 16}, ints, Containers::arrayView(offsets).prefix(2));
+    HexadecimalFormatter{}.formatInto({buffer, 16}, ints, Containers::arrayView(offsets).prefix(2));
+    FloatFormatter{}.formatInto({buffer, 16}, doubles, Containers::arrayView(offsets).prefix(2));
+    DecimalFormatter{}.formatInto({buffer, 8}, ints, offsets);
+    HexadecimalFormatter{}.formatInto({buffer, 6}, ints, offsets);
+    FloatFormatter{}.formatInto({buffer, 9}, doubles, offsets);
+    CORRADE_COMPARE_AS(out,
+        "Ui::DecimalFormatter::formatInto(): expected 3 offsets for 2 values but got 2\n"
+        "Ui::HexadecimalFormatter::formatInto(): expected 3 offsets for 2 values but got 2\n"
+        "Ui::FloatFormatter::formatInto(): expected 3 offsets for 2 values but got 2\n"
+        "Ui::DecimalFormatter::formatInto(): expected a buffer with at least 9 bytes to fit value 1 but got 8\n"
+        "Ui::HexadecimalFormatter::formatInto(): expected a buffer with at least 7 bytes to fit value 1 but got 6\n"
+        "Ui::FloatFormatter::formatInto(): expected a buffer with at least 10 bytes to fit value 1 but got 9\n",
+        TestSuite::Compare::String);
+}
+
 void FormatterTest::parseDecimal() {
     auto&& data = ParseDecimalData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -33,6 +33,7 @@
 #include "Magnum/Ui/Formatter.h"
 #include "Magnum/Ui/Icon.h"
 #include "Magnum/Ui/Label.h"
+#include "Magnum/Ui/NumericStorage.h"
 #include "Magnum/Ui/Storage.h"
 #include "Magnum/Ui/TextProperties.h"
 #include "Magnum/Ui/Test/WidgetTester.hpp"
@@ -63,6 +64,8 @@ struct LabelTest: WidgetTester {
     template<class T, class Formatter> void constructStorageQueryFormatter();
     template<class T, class Formatter> void constructStorageQueryFormatterNonOwned();
     template<class T, class Formatter> void constructStorageQueryFormatterStateless();
+    void constructStorageQueryFormatterUnchangedValue();
+    void constructStorageQueryFormatterChangedValue();
     void constructNoCreate();
 
     void setStyle();
@@ -210,6 +213,11 @@ LabelTest::LabelTest() {
        &WidgetTester::setup,
        &WidgetTester::teardown);
 
+    addTests<LabelTest>({&LabelTest::constructStorageQueryFormatterUnchangedValue,
+                         &LabelTest::constructStorageQueryFormatterChangedValue},
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
     addTests<LabelTest>({&LabelTest::constructNoCreate},
         &WidgetTester::setupNoCreate,
         &WidgetTester::teardownNoCreate);
@@ -676,6 +684,82 @@ template<class T, class Formatter> void LabelTest::constructStorageQueryFormatte
     CORRADE_COMPARE((data.customDataLayer ? *customDataLayer : ui.dataLayer()).usedCount(), 1);
 }
 
+void LabelTest::constructStorageQueryFormatterUnchangedValue() {
+    /* Changing a different index of the same storage marks the label binding
+       as dirty as well, but as the value it's bound to is the same, it
+       shouldn't get formatted again */
+    NumericStorage<Int> storage{ui, ValueInit, 2, StorageFlag::ReferenceCounted};
+    storage[0]->set(17);
+
+    Label label{Anchor{root, {}, {32, 16}}, storage[0]};
+
+    /* Mark the text data as editable so we can subsequently query the contents
+       set by the DataLayer */
+    ui.textLayer().setText(label.textData(), "nothing here!", {}, TextDataFlag::Editable);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "17");
+
+    /* Overwrite the text to detect whether the formatter got called */
+    ui.textLayer().setText(label.textData(), "unchanged", {}, TextDataFlag::Editable);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "unchanged");
+
+    /* Changing the other value calls the binding but it doesn't format
+       anything */
+    storage[1]->set(33);
+    CORRADE_VERIFY(ui.dataLayer().isDirty(label.dataBindingData()));
+    ui.update();
+    CORRADE_VERIFY(!ui.dataLayer().isDirty(label.dataBindingData()));
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "unchanged");
+
+    /* Setting the same value again doesn't either */
+    storage[0]->set(17);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "unchanged");
+
+    /* Neither does marking the binding itself as dirty */
+    ui.dataLayer().setDirty(label.dataBindingData());
+    ui.update();
+    CORRADE_VERIFY(!ui.dataLayer().isDirty(label.dataBindingData()));
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "unchanged");
+
+    /* Changing the bound value does */
+    storage[0]->set(-5);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "-5");
+}
+
+void LabelTest::constructStorageQueryFormatterChangedValue() {
+    /* Cases where the value compares equal to the previous one but the
+       formatting still has to happen */
+    NumericStorage<Float> storage{ui, ValueInit, StorageFlag::ReferenceCounted};
+
+    Label label{Anchor{root, {}, {32, 16}}, storage};
+
+    /* The first update formats even though the value is the same as the
+       default-initialized previous value in the binding */
+    ui.textLayer().setText(label.textData(), "nothing here!", {}, TextDataFlag::Editable);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "0");
+
+    /* A negative zero is equal to a positive one but is formatted
+       differently */
+    storage->set(-0.0f);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "-0");
+
+    /* And back */
+    storage->set(0.0f);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "0");
+
+    /* Setting the same zero again is skipped */
+    ui.textLayer().setText(label.textData(), "unchanged", {}, TextDataFlag::Editable);
+    storage->set(0.0f);
+    ui.update();
+    CORRADE_COMPARE(ui.textLayer().text(label.textData()), "unchanged");
+}
+
 void LabelTest::constructNoCreate() {
     Label label{NoCreate};
     CORRADE_VERIFY(!label.hasDataBinding());
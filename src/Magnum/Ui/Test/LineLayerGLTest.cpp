@@ -73,11 +73,13 @@ struct LineLayerGLTest: GL::OpenGLTester {
     void render();
     void renderStrip();
     void renderLoop();
+    void renderRingStrip();
     void renderSmoothness();
     void renderCustomColor();
     void renderPaddingAlignment();
     void renderChangeStyle();
     void renderChangeLine();
+    void renderBufferStreaming();
 
     void drawSetup();
     void drawTeardown();
@@ -535,7 +537,8 @@ LineLayerGLTest::LineLayerGLTest() {
         &LineLayerGLTest::renderTeardown);
 
     addTests({&LineLayerGLTest::renderStrip,
-              &LineLayerGLTest::renderLoop},
+              &LineLayerGLTest::renderLoop,
+              &LineLayerGLTest::renderRingStrip},
         &LineLayerGLTest::renderSetup,
         &LineLayerGLTest::renderTeardown);
 
@@ -564,6 +567,10 @@ LineLayerGLTest::LineLayerGLTest() {
         &LineLayerGLTest::renderSetup,
         &LineLayerGLTest::renderTeardown);
 
+    addTests({&LineLayerGLTest::renderBufferStreaming},
+        &LineLayerGLTest::renderSetup,
+        &LineLayerGLTest::renderTeardown);
+
     addInstancedTests({&LineLayerGLTest::drawOrder},
         Containers::arraySize(DrawOrderData),
         &LineLayerGLTest::drawSetup,
@@ -614,6 +621,7 @@ void LineLayerGLTest::construct() {
     CORRADE_COMPARE(&layer.shared(), &shared);
     /* Const overload */
     CORRADE_COMPARE(&static_cast<const LineLayerGL&>(layer).shared(), &shared);
+    CORRADE_VERIFY(!layer.isBufferStreamingEnabled());
 }
 
 void LineLayerGLTest::constructDerived() {
@@ -860,6 +868,88 @@ void LineLayerGLTest::renderLoop() {
         DebugTools::CompareImageToFile{_manager});
 }
 
+void LineLayerGLTest::renderRingStrip() {
+    /* Verifies that a ring strip renders the same as a regular strip with
+       the same points, both before and after the ring wraps around. The
+       points are appended over several frames to go through the partial
+       update of just the appended segments, and the output is compared to a
+       regular strip drawn by a second user interface. */
+
+    const auto setup = [](AbstractUserInterface& ui, LineLayerGL::Shared& layerShared) -> LineLayer& {
+        ui.setRendererInstance(Containers::pointer<RendererGL>());
+        layerShared.setStyle(
+            LineLayerCommonStyleUniform{},
+            {LineLayerStyleUniform{}
+                .setWidth(8.0f)
+                /* Semi-transparent to verify there are no overlaps except
+                   where desired */
+                .setColor(0xffffffff_rgbaf*0.75f)},
+            {LineAlignment::MiddleCenter},
+            {});
+        return ui.setLayerInstance(Containers::pointer<LineLayerGL>(ui.createLayer(), layerShared));
+    };
+
+    AbstractUserInterface ui{RenderSize};
+    LineLayerGL::Shared layerShared{LineLayer::Shared::Configuration{1}};
+    LineLayer& layer = setup(ui, layerShared);
+
+    AbstractUserInterface expectedUi{RenderSize};
+    LineLayerGL::Shared expectedLayerShared{LineLayer::Shared::Configuration{1}};
+    LineLayer& expectedLayer = setup(expectedUi, expectedLayerShared);
+
+    /* A zig-zag with a varying amplitude, so the joins are all different */
+    Vector2 points[16];
+    for(std::size_t i = 0; i != Containers::arraySize(points); ++i)
+        points[i] = {-52.0f + i*7.0f, (i % 2 ? 1.0f : -1.0f)*(8.0f + (i % 3)*4.0f)};
+
+    NodeHandle node = ui.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
+    DataHandle ring = layer.createRingStrip(0, 6,
+        Containers::arrayView(points).prefix(3), {}, node);
+
+    NodeHandle expectedNode = expectedUi.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
+    DataHandle expected = expectedLayer.createStrip(0,
+        Containers::arrayView(points).prefix(3), {}, expectedNode);
+
+    /* Each item is the end of the appended range, the first one appends
+       nothing, the second one fills the ring partially, the rest makes it
+       wrap around, the last one exactly to the end of the capacity */
+    const std::size_t appendEnds[]{3, 5, 8, 13, 16};
+    std::size_t appendBegin = 3;
+    for(const std::size_t appendEnd: appendEnds) {
+        CORRADE_ITERATION(appendEnd);
+
+        layer.appendRingStrip(ring,
+            Containers::arrayView(points).slice(appendBegin, appendEnd), {});
+        appendBegin = appendEnd;
+
+        const std::size_t pointCount = appendEnd < 6 ? appendEnd : 6;
+        CORRADE_COMPARE(layer.pointCount(ring), UnsignedInt(pointCount));
+        expectedLayer.setLineStrip(expected,
+            Containers::arrayView(points).slice(appendEnd - pointCount, appendEnd), {});
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        ui.draw();
+        Image2D actual = _framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm});
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        expectedUi.draw();
+        Image2D expectedImage = _framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm});
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Same problem is with all builtin shaders, so this doesn't seem to be
+           a bug in the line layer shader code */
+        if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+            CORRADE_SKIP("UBOs with dynamically indexed arrays don't seem to work on SwiftShader, can't test.");
+        #endif
+        /* The triangles are the same, just possibly in a different order, so
+           the output should be the same except for rounding differences */
+        CORRADE_COMPARE_WITH(actual, expectedImage,
+            (DebugTools::CompareImage{0.75f, 0.01f}));
+    }
+}
+
 void LineLayerGLTest::renderSmoothness() {
     auto&& data = RenderSmoothnessData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1207,6 +1297,81 @@ void LineLayerGLTest::renderChangeLine() {
         DebugTools::CompareImageToFile{_manager});
 }
 
+void LineLayerGLTest::renderBufferStreaming() {
+    /* Same as renderChangeLine() with a strip, except that the line gets
+       changed over several frames with buffer streaming enabled, which cycles
+       through all segments of the persistently mapped ring if buffer storage
+       is supported, and in the middle gets larger than a segment, causing the
+       ring to be reallocated. Only the last frame is compared, drawn from a
+       segment that's not the first one. */
+
+    AbstractUserInterface ui{RenderSize};
+    ui.setRendererInstance(Containers::pointer<RendererGL>());
+
+    LineLayerGL::Shared layerShared{LineLayer::Shared::Configuration{1}};
+    layerShared.setStyle(
+        LineLayerCommonStyleUniform{},
+        {LineLayerStyleUniform{}
+            .setWidth(12.0f)
+            .setColor(0xffffffff_rgbaf*0.75f)},
+        {LineAlignment::MiddleCenter},
+        {});
+    LineLayerGL& layer = ui.setLayerInstance(Containers::pointer<LineLayerGL>(ui.createLayer(), layerShared));
+    layer.setBufferStreamingEnabled(true);
+    CORRADE_VERIFY(layer.isBufferStreamingEnabled());
+
+    NodeHandle node = ui.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
+    DataHandle nodeData = layer.createStrip(0, {
+        {-16.0f, 0.0f}, {16.0f, 0.0f}
+    }, {}, node);
+
+    /* A zig-zag that's way larger than the initial buffer capacity */
+    Vector2 manyPoints[64];
+    for(std::size_t i = 0; i != Containers::arraySize(manyPoints); ++i)
+        manyPoints[i] = {-48.0f + i*1.5f, i % 2 ? 16.0f : -16.0f};
+
+    for(std::size_t frame = 0; frame != 8; ++frame) {
+        if(frame == 4)
+            layer.setLineStrip(nodeData, manyPoints, {});
+        else layer.setLineStrip(nodeData, {
+            {-16.0f + frame, 0.0f}, {16.0f, frame*1.0f}
+        }, {});
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        ui.draw();
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    layer.setLineStrip(nodeData, {
+        {-48.0f, -16.0f},
+        { 48.0f, -16.0f},
+        { 48.0f,  16.0f},
+        {-48.0f,  16.0f},
+    }, {});
+    CORRADE_COMPARE_AS(ui.state(),
+        UserInterfaceState::NeedsDataUpdate,
+        TestSuite::Compare::GreaterOrEqual);
+
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    ui.draw();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.load("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.load("StbImageImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / StbImageImporter plugins not found.");
+
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Same problem is with all builtin shaders, so this doesn't seem to be a
+       bug in the line layer shader code */
+    if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+        CORRADE_SKIP("UBOs with dynamically indexed arrays don't seem to work on SwiftShader, can't test.");
+    #endif
+    CORRADE_COMPARE_WITH(_framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm}),
+        Utility::Path::join(UI_TEST_DIR, "LineLayerTestFiles/strip.png"),
+        DebugTools::CompareImageToFile{_manager});
+}
+
 constexpr Vector2i DrawSize{64, 64};
 
 void LineLayerGLTest::drawSetup() {
@@ -32,6 +32,7 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Format.h>
 
 #include "Magnum/Ui/AbstractUserInterface.h" /* for debugIntegration() */
@@ -100,6 +101,7 @@ struct LineLayerTest: TestSuite::Tester {
     void createSetIndicesNeighbors();
     void createSetStripIndicesNeighbors();
     void createSetLoopIndicesNeighbors();
+    void createAppendRingStripIndicesNeighbors();
     void createStyleOutOfRange();
 
     void setColor();
@@ -114,6 +116,9 @@ struct LineLayerTest: TestSuite::Tester {
     void updateCleanDataOrder();
     void updateAlignment();
     void updatePadding();
+    void updatePartialVertexData();
+    void updateDirtyRanges();
+    void updateRingStripDirtyRanges();
     void updateNoStyleSet();
 
     void sharedNeedsUpdateStatePropagatedToLayers();
@@ -349,6 +354,7 @@ LineLayerTest::LineLayerTest() {
               &LineLayerTest::createSetIndicesNeighbors,
               &LineLayerTest::createSetStripIndicesNeighbors,
               &LineLayerTest::createSetLoopIndicesNeighbors,
+              &LineLayerTest::createAppendRingStripIndicesNeighbors,
               &LineLayerTest::createStyleOutOfRange,
 
               &LineLayerTest::setColor,
@@ -368,7 +374,10 @@ LineLayerTest::LineLayerTest() {
                        &LineLayerTest::updatePadding},
         Containers::arraySize(UpdateAlignmentPaddingData));
 
-    addTests({&LineLayerTest::updateNoStyleSet,
+    addTests({&LineLayerTest::updatePartialVertexData,
+              &LineLayerTest::updateDirtyRanges,
+              &LineLayerTest::updateRingStripDirtyRanges,
+              &LineLayerTest::updateNoStyleSet,
 
               &LineLayerTest::sharedNeedsUpdateStatePropagatedToLayers});
 
@@ -1974,6 +1983,246 @@ void LineLayerTest::createSetStripIndicesNeighbors() {
         TestSuite::Compare::Container);
 }
 
+void LineLayerTest::createAppendRingStripIndicesNeighbors() {
+    /* Verifies neighbor calculation and various edge cases for ring strips */
+
+    struct LayerShared: LineLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): LineLayer::Shared{configuration} {}
+
+        void doSetStyle(const LineLayerCommonStyleUniform&, Containers::ArrayView<const LineLayerStyleUniform>) override {}
+    } shared{LineLayer::Shared::Configuration{1}};
+
+    /* Needed in order to be able to call update() */
+    shared.setStyle(LineLayerCommonStyleUniform{},
+        {LineLayerStyleUniform{}},
+        {{}},
+        {});
+
+    struct Layer: LineLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): LineLayer{handle, shared} {}
+
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* A regular strip to verify the ring strip runs are placed after it and
+       that it isn't treated as a ring */
+    DataHandle strip = layer.createStrip(0, {{}, {}}, {}, nodeHandle(0, 1));
+
+    /* A ring strip with space for four points, two of them used initially */
+    DataHandle ring = layer.createRingStrip(0, 4, {
+        {1.0f, 0.0f}, {2.0f, 0.0f}
+    }, {
+        0xff3366_rgbf, 0x3366ff_rgbf
+    }, nodeHandle(0, 1));
+
+    /* A ring strip with just a single point, which draws nothing. Capacity
+       of less than two is invalid, tested in createSetInvalid() below. */
+    DataHandle singlePointRing = layer.createRingStrip(0, 2, {{}}, {}, nodeHandle(0, 1));
+
+    CORRADE_COMPARE(layer.ringStripCapacity(strip), 0);
+    CORRADE_COMPARE(layer.ringStripCapacity(ring), 4);
+    CORRADE_COMPARE(layer.ringStripCapacity(dataHandleData(singlePointRing)), 2);
+    CORRADE_COMPARE(layer.pointCount(ring), 2);
+    CORRADE_COMPARE(layer.indexCount(ring), 2);
+    CORRADE_COMPARE(layer.pointCount(singlePointRing), 1);
+    CORRADE_COMPARE(layer.indexCount(singlePointRing), 0);
+
+    /* The runs are always allocated for the whole capacity */
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::indexCount), Containers::arrayView({
+        2u, 8u, 4u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::indexOffset), Containers::arrayView({
+        0u, 2u, 10u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::pointCount), Containers::arrayView({
+        2u, 4u, 2u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::pointOffset), Containers::arrayView({
+        0u, 2u, 6u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::joinCount), Containers::arrayView({
+        0u, 0u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointOffset), Containers::arrayView({
+        0u, 0u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointCount), Containers::arrayView({
+        0xffffffffu, 2u, 1u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::arrayCast<Containers::Pair<UnsignedInt, UnsignedInt>>(layer.stateData().pointIndices)), (Containers::arrayView<Containers::Pair<UnsignedInt, UnsignedInt>>({
+        /* strip */
+        {0, 0xffffffffu}, {1, 0xffffffffu},
+
+        /* ring, index pairs are always consecutive points, wrapping around,
+           with neighbors only between the segments that are used */
+        {0, 0xffffffffu}, {1, 0xffffffffu},
+        {1, 0xffffffffu}, {2, 0xffffffffu},
+        {2, 0xffffffffu}, {3, 0xffffffffu},
+        {3, 0xffffffffu}, {0, 0xffffffffu},
+
+        /* singlePointRing */
+        {0, 0xffffffffu}, {1, 0xffffffffu},
+        {1, 0xffffffffu}, {0, 0xffffffffu},
+    })), TestSuite::Compare::Container);
+
+    /* Appending until the capacity is reached connects the new segments to
+       the previous ones, same as with a strip */
+    layer.appendRingStrip(ring, {{3.0f, 0.0f}, {4.0f, 0.0f}}, {});
+    CORRADE_COMPARE(layer.pointCount(ring), 4);
+    CORRADE_COMPARE(layer.indexCount(ring), 6);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::joinCount), Containers::arrayView({
+        0u, 2*2u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointCount), Containers::arrayView({
+        0xffffffffu, 4u, 1u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::arrayCast<Containers::Pair<UnsignedInt, UnsignedInt>>(layer.stateData().pointIndices).sliceSize(2, 8)), (Containers::arrayView<Containers::Pair<UnsignedInt, UnsignedInt>>({
+        {0, 0xffffffffu}, {1, 3},
+        {1, 0}, {2, 5},
+        {2, 2}, {3, 0xffffffffu},
+        /* The segment wrapping around isn't used */
+        {3, 0xffffffffu}, {0, 0xffffffffu},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::position).sliceSize(2, 4), Containers::arrayView<Vector2>({
+        {1.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}, {4.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::color).sliceSize(2, 4), Containers::arrayView<Color4>({
+        0xff3366_rgbf, 0x3366ff_rgbf, 0xffffff_rgbf, 0xffffff_rgbf
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsNodeOffsetSizeUpdate|LayerState::NeedsAttachmentUpdate|LayerState::NeedsDataUpdate);
+
+    /* Perform an update to clear state flags as well as verify the index /
+       vertex buffer population doesn't trip up on any of these */
+    UnsignedInt dataIds[]{
+        dataHandleId(strip),
+        dataHandleId(ring),
+        dataHandleId(singlePointRing)
+    };
+    CORRADE_COMPARE(Containers::arraySize(dataIds), layer.usedCount());
+    Vector2 nodeOffsets[1];
+    Vector2 nodeSizes[1];
+    Float nodeOpacities[1];
+    UnsignedByte nodesEnabled[1]{};
+    layer.update(layer.state(), dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, Containers::BitArrayView{nodesEnabled, 0, 1}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* One segment for the strip, a segment and a join for every point in the
+       capacity of both rings, even though they aren't all drawn */
+    CORRADE_COMPARE(layer.stateData().indices.size(), 1*6 + 4*12 + 2*12);
+
+    /* Appending to a full ring drops the oldest point, reusing its slot. The
+       run stays the same. */
+    layer.appendRingStrip(ring, {{5.0f, 0.0f}}, {});
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    CORRADE_COMPARE(layer.pointCount(ring), 4);
+    CORRADE_COMPARE(layer.indexCount(ring), 6);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::LineLayerData::run), Containers::arrayView({
+        0u, 1u, 2u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointOffset), Containers::arrayView({
+        0u, 1u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointCount), Containers::arrayView({
+        0xffffffffu, 4u, 1u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::joinCount), Containers::arrayView({
+        0u, 2*2u, 0u
+    }), TestSuite::Compare::Container);
+    Containers::Pair<UnsignedInt, UnsignedInt> expectedRingPointIndices[]{
+        /* The first segment is no longer used. Its neighbors are left
+           dangling, they're ignored when generating the index buffer. */
+        {0, 0xffffffffu}, {1, 3},
+        /* The second segment is the first now, so it has no neighbor at the
+           start */
+        {1, 0xffffffffu}, {2, 5},
+        {2, 2}, {3, 7},
+        /* The segment wrapping around is now the last */
+        {3, 4}, {0, 0xffffffffu},
+    };
+    CORRADE_COMPARE_AS((Containers::arrayCast<Containers::Pair<UnsignedInt, UnsignedInt>>(layer.stateData().pointIndices).sliceSize(2, 8)),
+        Containers::arrayView(expectedRingPointIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::position).sliceSize(2, 4), Containers::arrayView<Vector2>({
+        {5.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}, {4.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::color).sliceSize(2, 4), Containers::arrayView<Color4>({
+        0xffffff_rgbf, 0x3366ff_rgbf, 0xffffff_rgbf, 0xffffff_rgbf
+    }), TestSuite::Compare::Container);
+
+    /* The wrapping segment is drawn while the first segment degenerates.
+       Only the affected segments get regenerated, the index count is the
+       same as before. */
+    layer.update(LayerState::NeedsCommonDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, Containers::BitArrayView{nodesEnabled, 0, 1}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE(layer.stateData().indices.size(), 1*6 + 4*12 + 2*12);
+    CORRADE_COMPARE_AS(layer.stateData().indices.sliceSize(1*6, 4*12), Containers::arrayView<UnsignedInt>({
+        /* First segment, not drawn */
+        4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4,
+        /* Second segment, joined with the third */
+        10, 8, 9, 9, 11, 10,
+        10, 11, 12, 12, 11, 13,
+        /* Third segment, joined with the fourth */
+        14, 12, 13, 13, 15, 14,
+        14, 15, 16, 16, 15, 17,
+        /* Fourth segment, wrapping around, the last one with no join */
+        18, 16, 17, 17, 19, 18,
+        19, 19, 19, 19, 19, 19,
+    }), TestSuite::Compare::Container);
+
+    /* Appending more points than the capacity only keeps the last ones. The
+       ring got rotated by a full capacity, so the neighbors are the same as
+       above. */
+    layer.appendRingStrip(dataHandleData(ring), {
+        {6.0f, 0.0f}, {7.0f, 0.0f}, {8.0f, 0.0f},
+        {9.0f, 0.0f}, {10.0f, 0.0f}, {11.0f, 0.0f}
+    }, {
+        0x111111_rgbf, 0x222222_rgbf, 0x333333_rgbf,
+        0x444444_rgbf, 0x555555_rgbf, 0x666666_rgbf
+    });
+    CORRADE_COMPARE(layer.pointCount(ring), 4);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointOffset), Containers::arrayView({
+        0u, 1u, 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::arrayCast<Containers::Pair<UnsignedInt, UnsignedInt>>(layer.stateData().pointIndices).sliceSize(2, 8)),
+        Containers::arrayView(expectedRingPointIndices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::position).sliceSize(2, 4), Containers::arrayView<Vector2>({
+        {11.0f, 0.0f}, {8.0f, 0.0f}, {9.0f, 0.0f}, {10.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().points).slice(&Implementation::LineLayerPoint::color).sliceSize(2, 4), Containers::arrayView<Color4>({
+        0x666666_rgbf, 0x333333_rgbf, 0x444444_rgbf, 0x555555_rgbf
+    }), TestSuite::Compare::Container);
+
+    /* Setting a ring to a regular strip makes a new run even if the sizes
+       match, and it's no longer a ring after */
+    layer.setLineStrip(ring, {{}, {}, {}, {}}, {});
+    CORRADE_COMPARE(layer.ringStripCapacity(ring), 0);
+    CORRADE_COMPARE(layer.pointCount(ring), 4);
+    CORRADE_COMPARE(layer.indexCount(ring), 6);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::LineLayerData::run), Containers::arrayView({
+        0u, 3u, 2u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointCount), Containers::arrayView({
+        0xffffffffu, 4u, 1u, 0xffffffffu
+    }), TestSuite::Compare::Container);
+
+    /* The update recompacts the runs, dropping the original ring */
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, Containers::BitArrayView{nodesEnabled, 0, 1}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().runs).slice(&Implementation::LineLayerRun::ringPointCount), Containers::arrayView({
+        0xffffffffu, 1u, 0xffffffffu
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(layer.stateData().indices.size(), 1*6 + 3*6 + 2*2*3 + 2*12);
+}
+
 void LineLayerTest::createSetLoopIndicesNeighbors() {
     /* Verifies neighbor calculation and various edge cases for loops */
 
@@ -2348,12 +2597,16 @@ void LineLayerTest::invalidHandle() {
     layer.indexCount(LayerDataHandle::Null);
     layer.pointCount(DataHandle::Null);
     layer.pointCount(LayerDataHandle::Null);
+    layer.ringStripCapacity(DataHandle::Null);
+    layer.ringStripCapacity(LayerDataHandle::Null);
     layer.setLine(DataHandle::Null, {}, {}, {});
     layer.setLine(LayerDataHandle::Null, {}, {}, {});
     layer.setLineStrip(DataHandle::Null, {}, {});
     layer.setLineStrip(LayerDataHandle::Null, {}, {});
     layer.setLineLoop(DataHandle::Null, {}, {});
     layer.setLineLoop(LayerDataHandle::Null, {}, {});
+    layer.appendRingStrip(DataHandle::Null, {}, {});
+    layer.appendRingStrip(LayerDataHandle::Null, {}, {});
     layer.color(DataHandle::Null);
     layer.color(LayerDataHandle::Null);
     layer.setColor(DataHandle::Null, {});
@@ -2371,12 +2624,16 @@ void LineLayerTest::invalidHandle() {
         "Ui::LineLayer::indexCount(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::pointCount(): invalid handle Ui::DataHandle::Null\n"
         "Ui::LineLayer::pointCount(): invalid handle Ui::LayerDataHandle::Null\n"
+        "Ui::LineLayer::ringStripCapacity(): invalid handle Ui::DataHandle::Null\n"
+        "Ui::LineLayer::ringStripCapacity(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::setLine(): invalid handle Ui::DataHandle::Null\n"
         "Ui::LineLayer::setLine(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::setLineStrip(): invalid handle Ui::DataHandle::Null\n"
         "Ui::LineLayer::setLineStrip(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::setLineLoop(): invalid handle Ui::DataHandle::Null\n"
         "Ui::LineLayer::setLineLoop(): invalid handle Ui::LayerDataHandle::Null\n"
+        "Ui::LineLayer::appendRingStrip(): invalid handle Ui::DataHandle::Null\n"
+        "Ui::LineLayer::appendRingStrip(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::color(): invalid handle Ui::DataHandle::Null\n"
         "Ui::LineLayer::color(): invalid handle Ui::LayerDataHandle::Null\n"
         "Ui::LineLayer::setColor(): invalid handle Ui::DataHandle::Null\n"
@@ -2420,6 +2677,7 @@ void LineLayerTest::createSetInvalid() {
     layer.create(0, indices, points, {});
     layer.createStrip(0, points, {});
     layer.createLoop(0, points, {});
+    DataHandle ring = layer.createRingStrip(0, 3, points, {});
 
     Containers::String out;
     Error redirectError{&out};
@@ -2445,6 +2703,12 @@ void LineLayerTest::createSetInvalid() {
     layer.createLoop(0, twoPoints, {});
     layer.setLineLoop(data, twoPoints, {});
     layer.setLineLoop(dataHandleData(data), twoPoints, {});
+    layer.createRingStrip(0, 1, onePoint, {});
+    layer.createRingStrip(0, 3, points, colorsWrong);
+    layer.appendRingStrip(ring, points, colorsWrong);
+    layer.appendRingStrip(dataHandleData(ring), points, colorsWrong);
+    layer.appendRingStrip(data, points, {});
+    layer.appendRingStrip(dataHandleData(data), points, {});
     CORRADE_COMPARE_AS(out,
         "Ui::LineLayer::create(): expected index count to be divisible by 2 but got 7\n"
         "Ui::LineLayer::setLine(): expected index count to be divisible by 2 but got 7\n"
@@ -2463,7 +2727,13 @@ void LineLayerTest::createSetInvalid() {
         "Ui::LineLayer::setLineStrip(): expected either no or at least two points, got 1\n"
         "Ui::LineLayer::createLoop(): expected either no, one or at least three points, got 2\n"
         "Ui::LineLayer::setLineLoop(): expected either no, one or at least three points, got 2\n"
-        "Ui::LineLayer::setLineLoop(): expected either no, one or at least three points, got 2\n",
+        "Ui::LineLayer::setLineLoop(): expected either no, one or at least three points, got 2\n"
+        "Ui::LineLayer::createRingStrip(): expected capacity to be at least 2, got 1\n"
+        "Ui::LineLayer::createRingStrip(): expected either no or 5 colors, got 6\n"
+        "Ui::LineLayer::appendRingStrip(): expected either no or 5 colors, got 6\n"
+        "Ui::LineLayer::appendRingStrip(): expected either no or 5 colors, got 6\n"
+        "Ui::LineLayer::appendRingStrip(): line wasn't created with createRingStrip()\n"
+        "Ui::LineLayer::appendRingStrip(): line wasn't created with createRingStrip()\n",
         TestSuite::Compare::String);
 }
 
@@ -2674,6 +2944,13 @@ void LineLayerTest::updateCleanDataOrder() {
     /* Just the filled subset is getting updated, and just what was selected in
        states */
     UnsignedInt dataIds[]{9, 5, 7, 3};
+
+    /* Partial updates fill only a subset of the vertex attributes, do a full
+       update first to have the rest filled as well. Which attributes get
+       updated for which states is verified in updatePartialVertexData(). */
+    if(data.expectVertexDataUpdated && !(data.states >= LayerState::NeedsDataUpdate))
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+
     layer.update(data.states, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
 
     if(data.expectIndexDataUpdated) {
@@ -3414,6 +3691,339 @@ void LineLayerTest::updatePadding() {
     }), TestSuite::Compare::Container);
 }
 
+void LineLayerTest::updatePartialVertexData() {
+    /* Verifies that node offset/size updates touch only the positions and
+       node opacity updates only the colors and styles. The rest is checked
+       thoroughly in updateCleanDataOrder(). */
+
+    struct LayerShared: LineLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): LineLayer::Shared{configuration} {}
+
+        void doSetStyle(const LineLayerCommonStyleUniform&, Containers::ArrayView<const LineLayerStyleUniform>) override {}
+    } shared{LineLayer::Shared::Configuration{1}};
+
+    shared.setStyle(LineLayerCommonStyleUniform{},
+        {LineLayerStyleUniform{}},
+        {LineAlignment::TopLeft},
+        {});
+
+    struct Layer: LineLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): LineLayer{handle, shared} {}
+
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    layer.create(0,
+        {0, 1},
+        {{-3.0f, 4.0f}, {5.0f, -6.0f}},
+        {},
+        nodeHandle(1, 1));
+
+    Vector2 nodeOffsets[2];
+    Vector2 nodeSizes[2];
+    Float nodeOpacities[2];
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::BitArrayView nodesEnabled{nodesEnabledData, 0, 2};
+    nodeOffsets[1] = {1.0f, 2.0f};
+    nodeSizes[1] = {10.0f, 15.0f};
+    nodeOpacities[1] = 1.0f;
+    UnsignedInt dataIds[]{0};
+
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertices[0].position, (Vector2{-2.0f, 6.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].nextPosition, (Vector2{6.0f, -4.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].color, Color4{1.0f});
+
+    /* Changing just the offset updates the positions but not the color, even
+       though the opacity changed as well */
+    nodeOffsets[1] = {3.0f, 4.0f};
+    nodeOpacities[1] = 0.5f;
+    layer.update(LayerState::NeedsNodeOffsetSizeUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertices[0].position, (Vector2{0.0f, 8.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].nextPosition, (Vector2{8.0f, -2.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].color, Color4{1.0f});
+
+    /* And vice versa. The annotation bits stay the same. */
+    const UnsignedInt annotationStyleUniform = layer.stateData().vertices[0].annotationStyleUniform;
+    nodeOffsets[1] = {5.0f, 6.0f};
+    layer.update(LayerState::NeedsNodeOpacityUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertices[0].position, (Vector2{0.0f, 8.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].nextPosition, (Vector2{8.0f, -2.0f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].color, (Color4{0.5f, 0.5f}));
+    CORRADE_COMPARE(layer.stateData().vertices[0].annotationStyleUniform, annotationStyleUniform);
+}
+
+void LineLayerTest::updateDirtyRanges() {
+    /* Verifies that per-data changes that don't affect the run layout
+       regenerate and mark for upload just the vertices of given data */
+
+    struct LayerShared: LineLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): LineLayer::Shared{configuration} {}
+
+        void doSetStyle(const LineLayerCommonStyleUniform&, Containers::ArrayView<const LineLayerStyleUniform>) override {}
+    } shared{LineLayer::Shared::Configuration{1}};
+
+    shared.setStyle(LineLayerCommonStyleUniform{},
+        {LineLayerStyleUniform{}},
+        {LineAlignment::TopLeft},
+        {});
+
+    struct Layer: LineLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): LineLayer{handle, shared} {}
+
+        State& stateData() {
+            return static_cast<State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* A strip with one segment, i.e. four vertices, and a strip with two
+       segments, i.e. eight vertices */
+    DataHandle first = layer.createStrip(0, {{}, {}}, {}, nodeHandle(0, 1));
+    DataHandle second = layer.createStrip(0, {{}, {}, {}}, {}, nodeHandle(0, 1));
+
+    Vector2 nodeOffsets[1]{{10.0f, 20.0f}};
+    Vector2 nodeSizes[1]{{100.0f, 100.0f}};
+    Float nodeOpacities[1]{1.0f};
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::BitArrayView nodesEnabled{nodesEnabledData, 0, 1};
+    constexpr std::size_t VertexSize = sizeof(Implementation::LineLayerVertex);
+    constexpr std::size_t IndexSize = sizeof(UnsignedInt);
+    UnsignedInt dataIds[]{
+        dataHandleId(first),
+        dataHandleId(second)
+    };
+
+    layer.update(layer.state(), dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE(layer.stateData().vertices.size(), 4 + 8);
+
+    /* The GL implementation resets the ranges after upload */
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Changing a color marks only vertices of given data and no indices */
+    {
+        layer.setColor(second, 0xff3366_rgbf);
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 4*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, (4 + 8)*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+        CORRADE_COMPARE(layer.stateData().vertices[4].color, 0xff3366ff_rgbaf);
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+
+    /* Setting a strip with the same point count reuses the run, so again just
+       its vertices are marked */
+    {
+        layer.setLineStrip(first, {{1.0f, 0.0f}, {2.0f, 0.0f}}, {});
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 4*VertexSize);
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+        CORRADE_COMPARE(layer.stateData().vertices[0].position, (Vector2{11.0f, 20.0f}));
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+
+    /* A different point count creates a new run, after which all data get
+       recompacted and regenerated. The second data is now first and both have
+       eight vertices. */
+    {
+        layer.setColor(second, 0x3366ff_rgbf);
+        layer.setLineStrip(first, {{1.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}}, {});
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertices.size(), 8 + 8);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, (8 + 8)*VertexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, layer.stateData().indices.size()*IndexSize);
+        CORRADE_COMPARE(layer.stateData().vertices[0].color, 0x3366ffff_rgbaf);
+    }
+}
+
+void LineLayerTest::updateRingStripDirtyRanges() {
+    /* Verifies that appending to a ring strip regenerates and marks for upload
+       just the segments affected by the append. The neighbor calculation is
+       checked thoroughly in createAppendRingStripIndicesNeighbors(). */
+
+    struct LayerShared: LineLayer::Shared {
+        explicit LayerShared(const Configuration& configuration): LineLayer::Shared{configuration} {}
+
+        void doSetStyle(const LineLayerCommonStyleUniform&, Containers::ArrayView<const LineLayerStyleUniform>) override {}
+    } shared{LineLayer::Shared::Configuration{1}};
+
+    shared.setStyle(LineLayerCommonStyleUniform{},
+        {LineLayerStyleUniform{}},
+        {LineAlignment::TopLeft},
+        {});
+
+    struct Layer: LineLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): LineLayer{handle, shared} {}
+
+        State& stateData() {
+            return static_cast<State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* A regular strip to have the ring data not start at zero. It has four
+       vertices and six indices. */
+    DataHandle strip = layer.createStrip(0, {{}, {}}, {}, nodeHandle(0, 1));
+
+    /* A ring strip with space for six points, four of them used initially.
+       Its vertices are four for every segment slot starting at 4, its indices
+       twelve for every segment slot starting at 6. */
+    DataHandle ring = layer.createRingStrip(0, 6, {
+        {1.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}, {4.0f, 0.0f}
+    }, {}, nodeHandle(0, 1));
+
+    Vector2 nodeOffsets[1]{{10.0f, 20.0f}};
+    Vector2 nodeSizes[1]{{100.0f, 100.0f}};
+    Float nodeOpacities[1]{1.0f};
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::BitArrayView nodesEnabled{nodesEnabledData, 0, 1};
+    constexpr std::size_t VertexSize = sizeof(Implementation::LineLayerVertex);
+    constexpr std::size_t IndexSize = sizeof(UnsignedInt);
+    UnsignedInt dataIds[]{
+        dataHandleId(strip),
+        dataHandleId(ring)
+    };
+
+    layer.update(layer.state(), dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+    CORRADE_COMPARE(layer.stateData().vertices.size(), 4 + 6*4);
+    CORRADE_COMPARE(layer.stateData().indices.size(), 6 + 6*12);
+
+    /* The GL implementation resets the ranges after upload */
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Appending a single point makes a new segment after the third, and the
+       third gets a join with it. Just these two are marked. */
+    {
+        layer.appendRingStrip(ring, {{5.0f, 0.0f}}, {});
+        CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+        layer.update(LayerState::NeedsCommonDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, (4 + 2*4)*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, (4 + 4*4)*VertexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, (6 + 2*12)*IndexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, (6 + 4*12)*IndexSize);
+
+        /* The new segment is positioned relative to the node, joined with the
+           previous one and not with the next */
+        CORRADE_COMPARE(layer.stateData().vertices[4 + 3*4 + 0].position, (Vector2{14.0f, 20.0f}));
+        CORRADE_COMPARE(layer.stateData().vertices[4 + 3*4 + 0].previousPosition, (Vector2{13.0f, 20.0f}));
+        CORRADE_COMPARE(layer.stateData().vertices[4 + 3*4 + 2].position, (Vector2{15.0f, 20.0f}));
+        CORRADE_COMPARE(layer.stateData().vertices[4 + 3*4 + 2].nextPosition, (Vector2{10.0f, 20.0f}));
+        CORRADE_COMPARE(layer.stateData().vertices[4 + 2*4 + 2].nextPosition, (Vector2{15.0f, 20.0f}));
+        CORRADE_COMPARE_AS(layer.stateData().indices.sliceSize(6 + 2*12, 2*12), Containers::arrayView<UnsignedInt>({
+            14, 12, 13, 13, 15, 14,
+            14, 15, 16, 16, 15, 17,
+            18, 16, 17, 17, 19, 18,
+            19, 19, 19, 19, 19, 19,
+        }), TestSuite::Compare::Container);
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Appending two more points fills the capacity and drops the oldest point.
+       The marked segments wrap around, which results in the whole ring being
+       marked for upload. The data are however the same as when regenerating
+       everything. */
+    {
+        layer.appendRingStrip(ring, {{6.0f, 0.0f}, {7.0f, 0.0f}}, {});
+        layer.update(LayerState::NeedsCommonDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 4*VertexSize);
+        CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, (4 + 6*4)*VertexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 6*IndexSize);
+        CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, (6 + 6*12)*IndexSize);
+
+        Containers::Array<Implementation::LineLayerVertex> vertices{NoInit, layer.stateData().vertices.size()};
+        Containers::Array<UnsignedInt> indices{NoInit, layer.stateData().indices.size()};
+        Utility::copy(layer.stateData().vertices, vertices);
+        Utility::copy(layer.stateData().indices, indices);
+
+        layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE_AS(layer.stateData().indices, indices,
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().vertices).slice(&Implementation::LineLayerVertex::position),
+            stridedArrayView(vertices).slice(&Implementation::LineLayerVertex::position),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().vertices).slice(&Implementation::LineLayerVertex::previousPosition),
+            stridedArrayView(vertices).slice(&Implementation::LineLayerVertex::previousPosition),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().vertices).slice(&Implementation::LineLayerVertex::nextPosition),
+            stridedArrayView(vertices).slice(&Implementation::LineLayerVertex::nextPosition),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().vertices).slice(&Implementation::LineLayerVertex::color),
+            stridedArrayView(vertices).slice(&Implementation::LineLayerVertex::color),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().vertices).slice(&Implementation::LineLayerVertex::annotationStyleUniform),
+            stridedArrayView(vertices).slice(&Implementation::LineLayerVertex::annotationStyleUniform),
+            TestSuite::Compare::Container);
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Appending another point makes the first segment slot the last drawn
+       segment, with the join from the segment in the last slot wrapping
+       around to the first vertices of the first slot */
+    {
+        layer.appendRingStrip(ring, {{8.0f, 0.0f}}, {});
+        layer.update(LayerState::NeedsCommonDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_COMPARE_AS(layer.stateData().indices.sliceSize(6, 2*12), Containers::arrayView<UnsignedInt>({
+            /* First segment slot, the last drawn, with no join */
+            6, 4, 5, 5, 7, 6,
+            7, 7, 7, 7, 7, 7,
+            /* Second segment slot, not drawn */
+            8, 8, 8, 8, 8, 8,
+            8, 8, 8, 8, 8, 8,
+        }), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(layer.stateData().indices.sliceSize(6 + 5*12, 12), Containers::arrayView<UnsignedInt>({
+            /* Last segment slot, joined with the first */
+            26, 24, 25, 25, 27, 26,
+            26, 27, 4, 4, 27, 5,
+        }), TestSuite::Compare::Container);
+    }
+
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* If the ring isn't drawn, nothing is regenerated or marked */
+    {
+        UnsignedInt dataIdsStripOnly[]{
+            dataHandleId(strip)
+        };
+        layer.update(LayerState::NeedsNodeOrderUpdate, dataIdsStripOnly, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        layer.stateData().vertexDirtyRange.reset();
+        layer.stateData().indexDirtyRange.reset();
+
+        layer.appendRingStrip(ring, {{9.0f, 0.0f}}, {});
+        layer.update(LayerState::NeedsCommonDataUpdate, dataIdsStripOnly, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+        CORRADE_VERIFY(layer.stateData().vertexDirtyRange.isEmpty());
+        CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    }
+}
+
 void LineLayerTest::updateNoStyleSet() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/Text/AbstractFont.h>
+#include <Magnum/Text/AbstractGlyphCache.h>
+#include <Magnum/Text/AbstractShaper.h>
+#include <Magnum/Text/Alignment.h>
+
+#include "Magnum/Ui/Handle.h"
+#include "Magnum/Ui/TextLayer.h"
+#include "Magnum/Ui/TextProperties.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct TextLayerBenchmark: TestSuite::Tester {
+    explicit TextLayerBenchmark();
+
+    void updateVertices();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    TextLayerFlags flags;
+} UpdateVerticesData[]{
+    {"", {}},
+    {"transformable", TextLayerFlag::Transformable},
+};
+
+TextLayerBenchmark::TextLayerBenchmark() {
+    addInstancedBenchmarks({&TextLayerBenchmark::updateVertices}, 10,
+        Containers::arraySize(UpdateVerticesData));
+}
+
+/* 100 texts with 1000 glyphs each */
+constexpr std::size_t DataCount = 100;
+constexpr std::size_t GlyphCount = 1000;
+
+void TextLayerBenchmark::updateVertices() {
+    auto&& data = UpdateVerticesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Benchmarks regenerating vertex data of all glyphs, as happens when node
+       offsets change, such as when scrolling or animating */
+
+    struct Shaper: Text::AbstractShaper {
+        using Text::AbstractShaper::AbstractShaper;
+
+        UnsignedInt doShape(Containers::StringView, UnsignedInt begin, UnsignedInt end, Containers::ArrayView<const Text::FeatureRange>) override {
+            return end - begin;
+        }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<UnsignedInt>& ids) const override {
+            for(UnsignedInt& i: ids)
+                i = 0;
+        }
+        void doGlyphOffsetsAdvancesInto(const Containers::StridedArrayView1D<Vector2>& offsets, const Containers::StridedArrayView1D<Vector2>& advances) const override {
+            for(std::size_t i = 0; i != offsets.size(); ++i) {
+                offsets[i] = {};
+                advances[i] = {8.0f, 0.0f};
+            }
+        }
+        void doGlyphClustersInto(const Containers::StridedArrayView1D<UnsignedInt>&) const override {
+            CORRADE_FAIL("This shouldn't be called.");
+        }
+    };
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 1};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<Shaper>(*this); }
+
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32}};
+    cache.addFont(font.glyphCount(), &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}};
+    shared.setStyle(TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 16.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared, TextLayerFlags flags): TextLayer{handle, shared, flags} {}
+    } layer{layerHandle(0, 1), shared, data.flags};
+
+    /* Required to be called before update() */
+    layer.setSize({1, 1}, {1, 1});
+
+    const Containers::String text{DirectInit, GlyphCount, 'a'};
+    UnsignedInt dataIds[DataCount];
+    Vector2 nodeOffsets[DataCount];
+    Vector2 nodeSizes[DataCount];
+    Float nodeOpacities[DataCount];
+    Containers::BitArray nodesEnabled{DirectInit, DataCount, true};
+    for(std::size_t i = 0; i != DataCount; ++i) {
+        DataHandle handle = layer.create(0, text, {}, nodeHandle(i, 1));
+        if(data.flags >= TextLayerFlag::Transformable)
+            layer.setTransformation(handle, {}, 15.0_degf, 1.5f);
+        dataIds[i] = dataHandleId(handle);
+        nodeOffsets[i] = {0.0f, Float(i)*16.0f};
+        nodeSizes[i] = {8000.0f, 16.0f};
+        nodeOpacities[i] = 1.0f;
+    }
+
+    /* Generate the index data and everything else first so just vertex data
+       are regenerated in the benchmark loop */
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+
+    Int frame = 0;
+    CORRADE_BENCHMARK(10) {
+        nodeOffsets[0].x() = Float(frame++ % 2);
+        layer.update(LayerState::NeedsNodeOffsetSizeUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    }
+
+    CORRADE_VERIFY(!(layer.state() & LayerState::NeedsDataUpdate));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::TextLayerBenchmark)
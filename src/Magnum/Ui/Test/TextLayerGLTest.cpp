@@ -36,12 +36,14 @@
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/PixelFormat.h>
+#include <Magnum/Animation/Easing.h>
 #include <Magnum/DebugTools/CompareImage.h>
 #include <Magnum/GL/Framebuffer.h>
 #include <Magnum/GL/OpenGLTester.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/TextureArray.h>
 #include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Math/Time.h>
 #include <Magnum/Text/AbstractFont.h>
 #include <Magnum/Text/AbstractShaper.h>
 #include <Magnum/Text/Alignment.h>
@@ -54,6 +56,7 @@
 #include "Magnum/Ui/Handle.h"
 #include "Magnum/Ui/NodeFlags.h"
 #include "Magnum/Ui/RendererGL.h"
+#include "Magnum/Ui/TextLayerAnimator.h"
 #include "Magnum/Ui/TextLayerGL.h"
 #include "Magnum/Ui/TextProperties.h"
 
@@ -94,6 +97,7 @@ struct TextLayerGLTest: GL::OpenGLTester {
     void renderChangeText();
 
     void renderDynamicStyles();
+    void renderShaderStyleAnimation();
 
     void drawSetup();
     void drawTeardown();
@@ -1005,7 +1009,7 @@ const struct {
 const struct {
     const char* name;
     const char* filename;
-    bool distanceField, editable, partialUpdate;
+    bool distanceField, compactVertices, editable, partialUpdate;
     Float opacity;
     Float maxThreshold, meanThreshold;
     /* If these are unset, the default gets used */
@@ -1014,25 +1018,35 @@ const struct {
     } llvmpipe21;
 } RenderCustomColorData[]{
     {"", "colored.png",
-        false, false, false, 1.0f, 1.0f, 0.170f, {}},
+        false, false, false, false, 1.0f, 1.0f, 0.170f, {}},
     {"partial update", "colored.png",
-        false, false, true, 1.0f, 1.0f, 0.170f, {}},
+        false, false, false, true, 1.0f, 1.0f, 0.170f, {}},
     {"node opacity", "colored.png",
-        false, false, false, 0.75f, 1.0f, 0.170f, {}},
+        false, false, false, false, 0.75f, 1.0f, 0.170f, {}},
     {"node opacity, partial update", "colored.png",
-        false, false, true, 0.75f, 1.0f, 0.170f, {}},
+        false, false, false, true, 0.75f, 1.0f, 0.170f, {}},
     {"distance field", "distancefield-dilate-outline.png",
-        true, false, false, 1.0f, 5.25f, 0.148f, {10.5f, 0.461f}},
+        true, false, false, false, 1.0f, 5.25f, 0.148f, {10.5f, 0.461f}},
     {"editable", "colored-cursor-selection-text.png",
-        false, true, false, 1.0f, 1.25f, 0.169f, {}},
+        false, false, true, false, 1.0f, 1.25f, 0.169f, {}},
     {"editable, partial update", "colored-cursor-selection-text.png",
-        false, true, true, 1.0f, 1.25f, 0.169f, {}},
+        false, false, true, true, 1.0f, 1.25f, 0.169f, {}},
     {"editable, node opacity", "colored-cursor-selection-text.png",
-        false, true, false, 0.75f, 1.25f, 0.169f, {}},
+        false, false, true, false, 0.75f, 1.25f, 0.169f, {}},
     {"editable, node opacity, partial update", "colored-cursor-selection-text.png",
-        false, true, true, 0.75f, 1.25f, 0.169f, {}},
+        false, false, true, true, 0.75f, 1.25f, 0.169f, {}},
     {"editable, distance field", "distancefield-dilate-outline-cursor-selection-text.png",
-        true, true, false, 1.0f, 5.25f, 0.119f, {10.5f, 0.342f}},
+        true, false, true, false, 1.0f, 5.25f, 0.119f, {10.5f, 0.342f}},
+    {"compact vertices", "colored.png",
+        false, true, false, false, 1.0f, 1.0f, 0.170f, {}},
+    {"compact vertices, node opacity, partial update", "colored.png",
+        false, true, false, true, 0.75f, 1.0f, 0.170f, {}},
+    {"compact vertices, distance field", "distancefield-dilate-outline.png",
+        true, true, false, false, 1.0f, 5.25f, 0.148f, {10.5f, 0.461f}},
+    {"compact vertices, editable", "colored-cursor-selection-text.png",
+        false, true, true, false, 1.0f, 1.25f, 0.169f, {}},
+    {"compact vertices, editable, distance field", "distancefield-dilate-outline-cursor-selection-text.png",
+        true, true, true, false, 1.0f, 5.25f, 0.119f, {10.5f, 0.342f}},
 };
 
 const struct {
@@ -1387,6 +1401,19 @@ const struct {
         false, false, false, true, false, false},
 };
 
+const struct {
+    const char* name;
+    bool editable;
+    Nanoseconds time;
+} RenderShaderStyleAnimationData[]{
+    {"at the start", false, 10_nsec},
+    {"in the middle", false, 60_nsec},
+    {"at the start, editable", true, 10_nsec},
+    {"a quarter in, editable", true, 35_nsec},
+    {"in the middle, editable", true, 60_nsec},
+    {"almost at the end, editable", true, 109_nsec},
+};
+
 const struct {
     const char* name;
     bool editable;
@@ -1546,6 +1573,11 @@ TextLayerGLTest::TextLayerGLTest() {
         &TextLayerGLTest::renderSetup,
         &TextLayerGLTest::renderTeardown);
 
+    addInstancedTests({&TextLayerGLTest::renderShaderStyleAnimation},
+        Containers::arraySize(RenderShaderStyleAnimationData),
+        &TextLayerGLTest::renderSetup,
+        &TextLayerGLTest::renderTeardown);
+
     addInstancedTests({&TextLayerGLTest::drawOrder},
         Containers::arraySize(DrawOrderData),
         &TextLayerGLTest::drawSetup,
@@ -1719,6 +1751,7 @@ void TextLayerGLTest::construct() {
     CORRADE_COMPARE(&layer.shared(), &shared);
     /* Const overload */
     CORRADE_COMPARE(&static_cast<const TextLayerGL&>(layer).shared(), &shared);
+    CORRADE_VERIFY(!layer.isBufferStreamingEnabled());
 }
 
 void TextLayerGLTest::constructDerived() {
@@ -2349,10 +2382,12 @@ void TextLayerGLTest::renderCustomColor() {
     TextLayerGL::Shared layerShared{NoCreate};
     if(data.distanceField)
         layerShared = TextLayerGL::Shared{_fontDistanceFieldGlyphCache, TextLayer::Shared::Configuration{2, 1}
-            .setEditingStyleCount(data.editable ? 2 : 0)};
+            .setEditingStyleCount(data.editable ? 2 : 0)
+            .setFlags(data.compactVertices ? TextLayerSharedFlag::CompactVertices : TextLayerSharedFlags{})};
     else
         layerShared = TextLayerGL::Shared{_fontGlyphCache, TextLayer::Shared::Configuration{2, 1}
-            .setEditingStyleCount(data.editable ? 2 : 0)};
+            .setEditingStyleCount(data.editable ? 2 : 0)
+            .setFlags(data.compactVertices ? TextLayerSharedFlag::CompactVertices : TextLayerSharedFlags{})};
 
     FontHandle fontHandle = layerShared.addFont(data.distanceField ? *_fontDistanceField : *_font, 32.0f, {});
     layerShared.setStyle(
@@ -2939,6 +2974,117 @@ void TextLayerGLTest::renderDynamicStyles() {
         (DebugTools::CompareImageToFile{_importerManager, 1.5f, 0.0762f}));
 }
 
+void TextLayerGLTest::renderShaderStyleAnimation() {
+    auto&& data = RenderShaderStyleAnimationData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(_fontManager.load("StbTrueTypeFont") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("StbTrueTypeFont plugin not found.");
+
+    /* Opened in the constructor together with cache filling to reduce code
+       duplication */
+    CORRADE_VERIFY(_font && _font->isOpened());
+
+    /* Render the same animation first with the style interpolated on the CPU
+       and then in the shader. The output should be the same. */
+    Containers::Optional<Image2D> images[2];
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION((i ? "ShaderStyleAnimation" : "CPU interpolation"));
+
+        AbstractUserInterface ui{RenderSize};
+        ui.setRendererInstance(Containers::pointer<RendererGL>());
+
+        TextLayerGL::Shared layerShared{_fontGlyphCache,
+            TextLayer::Shared::Configuration{3, 2}
+                .setEditingStyleCount(data.editable ? 3 : 0,
+                                      data.editable ? 4 : 0)
+                .addFlags(i ? TextLayerSharedFlag::ShaderStyleAnimation : TextLayerSharedFlags{})
+                .setDynamicStyleCount(1)
+        };
+        FontHandle fontHandle = layerShared.addFont(*_font, 32.0f, {});
+
+        /* The CPU interpolation handles only the text color, which is also
+           the only text style property used without a distance field glyph
+           cache. The editing style properties are all interpolated on the CPU
+           as well, so all of them are different. */
+        layerShared.setStyle(
+            TextLayerCommonStyleUniform{},
+            {TextLayerStyleUniform{}
+                .setColor(0x1f1f1f_rgbf),
+             TextLayerStyleUniform{}
+                .setColor(0xdcdcdc_rgbf),
+             TextLayerStyleUniform{}
+                .setColor(0x2f83cc_rgbf)},
+            /* To verify it's not using the style ID as uniform ID */
+            {1, 2},
+            {fontHandle, fontHandle},
+            {Text::Alignment::MiddleCenter,
+             Text::Alignment::MiddleCenter},
+            {}, {}, {},
+            {data.editable ? 0 : -1,
+             data.editable ? 2 : -1},
+            {data.editable ? 1 : -1,
+             data.editable ? 3 : -1},
+            {});
+        if(data.editable) layerShared.setEditingStyle(
+            TextLayerCommonEditingStyleUniform{},
+            {TextLayerEditingStyleUniform{}
+                .setBackgroundColor(0xcd3431_rgbf)
+                .setCornerRadius(1.0f),
+             TextLayerEditingStyleUniform{}
+                .setBackgroundColor(0x3bd267_rgbf)
+                .setCornerRadius(8.0f),
+             TextLayerEditingStyleUniform{}
+                .setBackgroundColor(0xc7cf2f_rgbf)
+                .setCornerRadius(2.0f)},
+            {0, 1, 2, 0},
+            /* The selection text uniform falls back to the style uniform in
+               the source style and is overriden in the target style */
+            {-1, -1, -1, 0},
+            {{2.0f, 0.0f, 2.0f, 0.0f},
+             {},
+             {2.0f, 0.0f, 2.0f, 0.0f},
+             {}});
+
+        TextLayerGL& layer = ui.setLayerInstance(Containers::pointer<TextLayerGL>(ui.createLayer(), layerShared));
+
+        Containers::Pointer<TextLayerStyleAnimator> animatorInstance{InPlaceInit, ui.createAnimator()};
+        layer.assignAnimator(*animatorInstance);
+        TextLayerStyleAnimator& animator = ui.setAnimatorInstance(Utility::move(animatorInstance));
+
+        NodeHandle node = ui.createNode({8.0f, 8.0f}, {112.0f, 48.0f});
+        DataHandle layerData = layer.create(0, "Maggi", {},
+            data.editable ? TextDataFlag::Editable : TextDataFlags{},
+            node);
+        if(data.editable)
+            layer.setCursor(layerData, 2, 5);
+        animator.create(0, 1, Animation::Easing::linear, 10_nsec, 100_nsec, layerData);
+
+        /* The data is switched to the only dynamic style for the duration of
+           the animation */
+        ui.advanceAnimations(data.time);
+        CORRADE_COMPARE(layer.style(layerData), 2);
+
+        _framebuffer.clear(GL::FramebufferClear::Color);
+        ui.draw();
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        images[i] = _framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm});
+    }
+
+    #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Same problem is with all builtin shaders, so this doesn't seem to be a
+       bug in the text layer shader code */
+    if(GL::Context::current().detectedDriver() & GL::Context::DetectedDriver::SwiftShader)
+        CORRADE_SKIP("UBOs with dynamically indexed arrays don't seem to work on SwiftShader, can't test.");
+    #endif
+    /* There may be slight differences due to the interpolation being done
+       with a different precision */
+    CORRADE_COMPARE_WITH(*images[1], *images[0],
+        (DebugTools::CompareImage{0.75f, 0.01f}));
+}
+
 constexpr Vector2i DrawSize{64, 64};
 
 void TextLayerGLTest::drawSetup() {
@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Cpu.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Ui/Implementation/textLayerGlyphVertices.h"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct TextLayerGlyphVerticesTest: TestSuite::Tester {
+    explicit TextLayerGlyphVerticesTest();
+
+    void fillColorStyle();
+    void translatePositions();
+    void transformPositions();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Cpu::Features features;
+} VariantData[]{
+    {"scalar", Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Cpu::Avx},
+    #endif
+    #ifdef CORRADE_ENABLE_NEON
+    {"NEON", Cpu::Neon},
+    #endif
+};
+
+TextLayerGlyphVerticesTest::TextLayerGlyphVerticesTest() {
+    addInstancedTests({&TextLayerGlyphVerticesTest::fillColorStyle,
+                       &TextLayerGlyphVerticesTest::translatePositions,
+                       &TextLayerGlyphVerticesTest::transformPositions},
+        Containers::arraySize(VariantData));
+}
+
+/* Seven vertices to exercise both the vectorized part and the remainder in
+   all variants */
+constexpr std::size_t VertexCount = 7;
+
+void TextLayerGlyphVerticesTest::fillColorStyle() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(Cpu::runtimeFeatures() >= data.features))
+        CORRADE_SKIP("CPU doesn't support the instruction set.");
+
+    Implementation::TextLayerVertex vertices[VertexCount + 1]{};
+    vertices[VertexCount].color = 0xff3366ff_rgbaf;
+    vertices[VertexCount].styleUniform = 1337;
+
+    Implementation::fillGlyphVertexColorStyleImplementation(data.features)(Containers::arrayView(vertices).prefix(VertexCount), 0x3366ff99_rgbaf, 67);
+
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(vertices[i].color, 0x3366ff99_rgbaf);
+        CORRADE_COMPARE(vertices[i].styleUniform, 67);
+        /* Other attributes stay untouched */
+        CORRADE_COMPARE(vertices[i].position, Vector2{});
+        CORRADE_COMPARE(vertices[i].textureCoordinates, Vector3{});
+    }
+
+    /* The vertex after the view stays untouched as well */
+    CORRADE_COMPARE(vertices[VertexCount].color, 0xff3366ff_rgbaf);
+    CORRADE_COMPARE(vertices[VertexCount].styleUniform, 1337);
+}
+
+void TextLayerGlyphVerticesTest::translatePositions() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(Cpu::runtimeFeatures() >= data.features))
+        CORRADE_SKIP("CPU doesn't support the instruction set.");
+
+    /* Operating on the position slice of a vertex array, like in
+       TextLayer::doUpdate() */
+    Implementation::TextLayerVertex vertices[VertexCount];
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        vertices[i].position = {i*1.5f, i*0.25f - 1.0f};
+        vertices[i].styleUniform = i;
+    }
+
+    Implementation::translateGlyphVertexPositionsImplementation(data.features)(Containers::stridedArrayView(vertices).slice(&Implementation::TextLayerVertex::position), {10.0f, -20.0f});
+
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        /* Y gets flipped */
+        CORRADE_COMPARE(vertices[i].position, (Vector2{10.0f + i*1.5f, -20.0f - (i*0.25f - 1.0f)}));
+        CORRADE_COMPARE(vertices[i].styleUniform, i);
+    }
+}
+
+void TextLayerGlyphVerticesTest::transformPositions() {
+    auto&& data = VariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(!(Cpu::runtimeFeatures() >= data.features))
+        CORRADE_SKIP("CPU doesn't support the instruction set.");
+
+    Implementation::TextLayerVertex vertices[VertexCount];
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        vertices[i].position = {i*1.5f, i*0.25f - 1.0f};
+        vertices[i].styleUniform = i;
+    }
+
+    /* Rotation by 90° scaled 2x, with the Y flip done before the rotation,
+       i.e. (x, y) -> (x, -y) -> (2y, 2x) */
+    Implementation::transformGlyphVertexPositionsImplementation(data.features)(Containers::stridedArrayView(vertices).slice(&Implementation::TextLayerVertex::position), {10.0f, -20.0f}, Complex{0.0f, 2.0f});
+
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(vertices[i].position, (Vector2{10.0f + 2.0f*(i*0.25f - 1.0f), -20.0f + 2.0f*i*1.5f}));
+        CORRADE_COMPARE(vertices[i].styleUniform, i);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::TextLayerGlyphVerticesTest)
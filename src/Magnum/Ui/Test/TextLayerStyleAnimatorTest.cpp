@@ -78,6 +78,7 @@ struct TextLayerStyleAnimatorTest: TestSuite::Tester {
 
     void advance();
     void advanceProperties();
+    void advanceShaderStyleAnimation();
     void advanceNoFreeDynamicStyles();
     void advanceConflictingAnimations();
     /* Nothing like BaseLayerStyleAnimatorTest::advanceExternalStyleChanges()
@@ -90,6 +91,7 @@ struct TextLayerStyleAnimatorTest: TestSuite::Tester {
     void advanceInvalidCursorSelection();
 
     void layerAdvance();
+    void layerAdvanceShaderStyleAnimation();
     void uiAdvance();
     void uiAdvanceEventTransition();
 };
@@ -366,7 +368,8 @@ TextLayerStyleAnimatorTest::TextLayerStyleAnimatorTest() {
     addInstancedTests({&TextLayerStyleAnimatorTest::advanceProperties},
         Containers::arraySize(AdvancePropertiesData));
 
-    addTests({&TextLayerStyleAnimatorTest::advanceNoFreeDynamicStyles});
+    addTests({&TextLayerStyleAnimatorTest::advanceShaderStyleAnimation,
+              &TextLayerStyleAnimatorTest::advanceNoFreeDynamicStyles});
 
     addInstancedTests({&TextLayerStyleAnimatorTest::advanceConflictingAnimations},
         Containers::arraySize(AdvanceConflictingAnimationsData));
@@ -378,7 +381,8 @@ TextLayerStyleAnimatorTest::TextLayerStyleAnimatorTest() {
     addInstancedTests({&TextLayerStyleAnimatorTest::layerAdvance},
         Containers::arraySize(LayerAdvanceData));
 
-    addTests({&TextLayerStyleAnimatorTest::uiAdvance,
+    addTests({&TextLayerStyleAnimatorTest::layerAdvanceShaderStyleAnimation,
+              &TextLayerStyleAnimatorTest::uiAdvance,
               &TextLayerStyleAnimatorTest::uiAdvanceEventTransition});
 }
 
@@ -390,8 +394,8 @@ void TextLayerStyleAnimatorTest::debugAnimatorUpdate() {
 
 void TextLayerStyleAnimatorTest::debugAnimatorUpdates() {
     Containers::String out;
-    Debug{&out} << (TextLayerStyleAnimatorUpdate::Uniform|TextLayerStyleAnimatorUpdate(0xe0)) << TextLayerStyleAnimatorUpdates{};
-    CORRADE_COMPARE(out, "Ui::TextLayerStyleAnimatorUpdate::Uniform|Ui::TextLayerStyleAnimatorUpdate(0xe0) Ui::TextLayerStyleAnimatorUpdates{}\n");
+    Debug{&out} << (TextLayerStyleAnimatorUpdate::Uniform|TextLayerStyleAnimatorUpdate::EditingInterpolation|TextLayerStyleAnimatorUpdate(0x80)) << TextLayerStyleAnimatorUpdates{};
+    CORRADE_COMPARE(out, "Ui::TextLayerStyleAnimatorUpdate::Uniform|Ui::TextLayerStyleAnimatorUpdate::EditingInterpolation|Ui::TextLayerStyleAnimatorUpdate(0x80) Ui::TextLayerStyleAnimatorUpdates{}\n");
 }
 
 void TextLayerStyleAnimatorTest::construct() {
@@ -2339,6 +2343,175 @@ void TextLayerStyleAnimatorTest::advanceProperties() {
     }
 }
 
+void TextLayerStyleAnimatorTest::advanceShaderStyleAnimation() {
+    /* Like advanceProperties(), but with the interpolation done in the shader
+       instead */
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Properties doProperties() override { return {}; }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<EmptyShaper>(*this); }
+    } font;
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
+    cache.addFont(67, &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{4, 4}
+        .setEditingStyleCount(3, 4)
+        .setDynamicStyleCount(2)
+        .addFlags(TextLayerSharedFlag::ShaderStyleAnimation)
+    };
+
+    FontHandle fontHandle = shared.addFont(font, 1.0f, {});
+
+    /* Style 1 and 3 share the same uniform and have no editing styles, so the
+       second animation doesn't need to interpolate anything. Style 0 and 2
+       have both a cursor and a selection style, the selection styles with
+       different text uniform overrides. */
+    shared.setStyle(
+        TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{},
+         TextLayerStyleUniform{},
+         TextLayerStyleUniform{},
+         TextLayerStyleUniform{}},
+        {3, 2, 2, 2},
+        {fontHandle, fontHandle, fontHandle, fontHandle},
+        {Text::Alignment::MiddleCenter,
+         Text::Alignment::MiddleCenter,
+         Text::Alignment::MiddleCenter,
+         Text::Alignment::MiddleCenter},
+        {}, {}, {},
+        {0, -1, 2, -1},
+        {1, -1, 3, -1},
+        {});
+    shared.setEditingStyle(
+        TextLayerCommonEditingStyleUniform{},
+        {TextLayerEditingStyleUniform{},
+         TextLayerEditingStyleUniform{},
+         TextLayerEditingStyleUniform{}},
+        {1, 0, 2, 2},
+        {-1, 1, -1, 0},
+        {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+    } layer{layerHandle(0, 1), shared};
+
+    DataHandle layerData1 = layer.create(0, "", {});
+    DataHandle layerData2 = layer.create(0, "", {});
+
+    TextLayerStyleAnimator animator{animatorHandle(0, 1)};
+    layer.assignAnimator(animator);
+
+    AnimationHandle animation1 = animator.create(2, 0, Animation::Easing::linear, 0_nsec, 20_nsec, layerData1);
+    AnimationHandle animation2 = animator.create(1, 3, Animation::Easing::linear, 0_nsec, 20_nsec, layerData2);
+
+    const auto advance = [&](Nanoseconds time, Containers::ArrayView<TextLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, Containers::ArrayView<TextLayerEditingStyleUniform> dynamicEditingStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicEditingStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicEditingStyleInterpolationFactors, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
+        UnsignedByte activeStorage[1];
+        UnsignedByte startedStorage[1];
+        UnsignedByte stoppedStorage[1];
+        Float factorStorage[2];
+        UnsignedByte removeStorage[1];
+        char cursorStyles[1];
+        char selectionStyles[1];
+        Vector4 dynamicStylePaddings[2];
+        Vector4 dynamicEditingStylePaddings[4];
+
+        return animator.advance(time,
+            Containers::MutableBitArrayView{activeStorage, 0, 2},
+            Containers::MutableBitArrayView{startedStorage, 0, 2},
+            Containers::MutableBitArrayView{stoppedStorage, 0, 2},
+            factorStorage,
+            Containers::MutableBitArrayView{removeStorage, 0, 2},
+            dynamicStyleUniforms, dynamicStyleInterpolationUniforms, dynamicStyleInterpolationFactors,
+            Containers::MutableBitArrayView{cursorStyles, 0, 2},
+            Containers::MutableBitArrayView{selectionStyles, 0, 2},
+            dynamicStylePaddings,
+            dynamicEditingStyleUniforms, dynamicEditingStyleInterpolationUniforms, dynamicEditingStyleInterpolationFactors,
+            dynamicEditingStylePaddings, dataStyles);
+    };
+
+    /* The uniforms are not touched at all, only the interpolations */
+    TextLayerStyleUniform uniforms[6];
+    for(TextLayerStyleUniform& i: uniforms)
+        i.setColor(0xff3366_rgbf);
+    TextLayerEditingStyleUniform editingUniforms[4];
+    for(TextLayerEditingStyleUniform& i: editingUniforms)
+        i.setBackgroundColor(0xff3366_rgbf);
+    Vector2ui interpolationUniforms[6];
+    Float interpolationFactors[6];
+    Vector2ui editingInterpolationUniforms[4];
+    Float editingInterpolationFactors[4];
+    UnsignedInt dataStyles[]{666, 666};
+
+    /* Advancing to 5 allocates dynamic styles, switches to them and fills the
+       interpolation data. (Editing)Interpolation is reported together with
+       Style in order to ensure the data is uploaded even though it won't
+       subsequently change for the second animation. */
+    CORRADE_COMPARE(advance(5_nsec, uniforms, interpolationUniforms, interpolationFactors, editingUniforms, editingInterpolationUniforms, editingInterpolationFactors, dataStyles), TextLayerStyleAnimatorUpdate::Interpolation|TextLayerStyleAnimatorUpdate::EditingInterpolation|TextLayerStyleAnimatorUpdate::Style);
+    CORRADE_COMPARE(animator.dynamicStyle(animation1), 0);
+    CORRADE_COMPARE(animator.dynamicStyle(animation2), 1);
+    CORRADE_COMPARE(interpolationUniforms[0], (Vector2ui{2, 3}));
+    CORRADE_COMPARE(interpolationUniforms[1], (Vector2ui{2, 2}));
+    CORRADE_COMPARE(interpolationFactors[0], 0.25f);
+    CORRADE_COMPARE(interpolationFactors[1], 0.0f);
+    /* Selection text uniform of the first dynamic style */
+    CORRADE_COMPARE(interpolationUniforms[shared.dynamicStyleCount() + 0*2 + 0], (Vector2ui{0, 1}));
+    CORRADE_COMPARE(interpolationFactors[shared.dynamicStyleCount() + 0*2 + 0], 0.25f);
+    /* Cursor and selection uniforms of the first dynamic style */
+    CORRADE_COMPARE(editingInterpolationUniforms[0*2 + 1], (Vector2ui{2, 1}));
+    CORRADE_COMPARE(editingInterpolationFactors[0*2 + 1], 0.25f);
+    CORRADE_COMPARE(editingInterpolationUniforms[0*2 + 0], (Vector2ui{2, 0}));
+    CORRADE_COMPARE(editingInterpolationFactors[0*2 + 0], 0.25f);
+    for(const TextLayerStyleUniform& i: uniforms) {
+        CORRADE_ITERATION(&i - uniforms);
+        CORRADE_COMPARE(i.color, 0xff3366_rgbf);
+    }
+    for(const TextLayerEditingStyleUniform& i: editingUniforms) {
+        CORRADE_ITERATION(&i - editingUniforms);
+        CORRADE_COMPARE(i.backgroundColor, 0xff3366_rgbf);
+    }
+    CORRADE_COMPARE(dataStyles[0], 4);
+    CORRADE_COMPARE(dataStyles[1], 5);
+
+    /* Advancing to 15 changes just the factors of the first */
+    CORRADE_COMPARE(advance(15_nsec, uniforms, interpolationUniforms, interpolationFactors, editingUniforms, editingInterpolationUniforms, editingInterpolationFactors, dataStyles), TextLayerStyleAnimatorUpdate::Interpolation|TextLayerStyleAnimatorUpdate::EditingInterpolation);
+    CORRADE_COMPARE(interpolationUniforms[0], (Vector2ui{2, 3}));
+    CORRADE_COMPARE(interpolationFactors[0], 0.75f);
+    CORRADE_COMPARE(interpolationFactors[1], 0.0f);
+    CORRADE_COMPARE(interpolationUniforms[shared.dynamicStyleCount() + 0*2 + 0], (Vector2ui{0, 1}));
+    CORRADE_COMPARE(interpolationFactors[shared.dynamicStyleCount() + 0*2 + 0], 0.75f);
+    CORRADE_COMPARE(editingInterpolationUniforms[0*2 + 1], (Vector2ui{2, 1}));
+    CORRADE_COMPARE(editingInterpolationFactors[0*2 + 1], 0.75f);
+    CORRADE_COMPARE(editingInterpolationUniforms[0*2 + 0], (Vector2ui{2, 0}));
+    CORRADE_COMPARE(editingInterpolationFactors[0*2 + 0], 0.75f);
+    CORRADE_COMPARE(uniforms[0].color, 0xff3366_rgbf);
+    CORRADE_COMPARE(editingUniforms[0].backgroundColor, 0xff3366_rgbf);
+
+    /* Advancing to 25 changes only the Style */
+    CORRADE_COMPARE(advance(25_nsec, uniforms, interpolationUniforms, interpolationFactors, editingUniforms, editingInterpolationUniforms, editingInterpolationFactors, dataStyles), TextLayerStyleAnimatorUpdate::Style);
+    CORRADE_VERIFY(!animator.isHandleValid(animation1));
+    CORRADE_VERIFY(!animator.isHandleValid(animation2));
+    CORRADE_COMPARE(dataStyles[0], 0);
+    CORRADE_COMPARE(dataStyles[1], 3);
+}
+
 void TextLayerStyleAnimatorTest::advanceNoFreeDynamicStyles() {
     struct: Text::AbstractFont {
         Text::FontFeatures doFeatures() const override { return {}; }
@@ -2679,6 +2852,10 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
     }, sharedEditing{cache, TextLayer::Shared::Configuration{2}
         .setEditingStyleCount(1)
         .setDynamicStyleCount(2)
+    }, sharedShaderStyleAnimation{cache, TextLayer::Shared::Configuration{2}
+        .setEditingStyleCount(1)
+        .setDynamicStyleCount(2)
+        .addFlags(TextLayerSharedFlag::ShaderStyleAnimation)
     };
 
     /* The editing layer has only the non-editing style set to check both
@@ -2694,12 +2871,15 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
     struct Layer: TextLayer {
         explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
     } layer{layerHandle(0, 1), shared},
-      layerEditing{layerHandle(0, 1), sharedEditing};
+      layerEditing{layerHandle(0, 1), sharedEditing},
+      layerShaderStyleAnimation{layerHandle(0, 1), sharedShaderStyleAnimation};
 
     TextLayerStyleAnimator animator{animatorHandle(0, 1)};
     TextLayerStyleAnimator animatorEditing{animatorHandle(0, 1)};
+    TextLayerStyleAnimator animatorShaderStyleAnimation{animatorHandle(0, 1)};
     layer.assignAnimator(animator);
     layerEditing.assignAnimator(animatorEditing);
+    layerShaderStyleAnimation.assignAnimator(animatorShaderStyleAnimation);
 
     animator.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
     animator.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
@@ -2709,6 +2889,10 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
     animatorEditing.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
     animatorEditing.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
 
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
+    animatorShaderStyleAnimation.create(0, 1, Animation::Easing::linear, 0_nsec, 1_nsec, DataHandle::Null);
+
     Containers::BitArray mask{NoInit, 3};
     Containers::BitArray maskInvalid{NoInit, 4};
     Float factors[3];
@@ -2725,6 +2909,10 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
     TextLayerEditingStyleUniform dynamicEditingStyleUniformsInvalid[3];
     Vector4 dynamicEditingStylePaddings[4];
     Vector4 dynamicEditingStylePaddingsInvalid[3];
+    Vector2ui dynamicStyleInterpolationUniforms[6];
+    Float dynamicStyleInterpolationFactors[6];
+    Vector2ui dynamicEditingStyleInterpolationUniforms[4];
+    Float dynamicEditingStyleInterpolationFactors[4];
 
     Containers::String out;
     Error redirectError{&out};
@@ -2855,6 +3043,35 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
         Containers::MutableBitArrayView{dynamicStyleSelectionStyles, 0, 2},
         dynamicStylePaddings,
         {}, {}, {});
+    /* Interpolation views passed to a layer without shader style animation */
+    animator.advance({}, mask, mask, mask, factors, mask,
+        dynamicStyleUniforms,
+        Containers::arrayView(dynamicStyleInterpolationUniforms).prefix(2),
+        Containers::arrayView(dynamicStyleInterpolationFactors).prefix(2),
+        Containers::MutableBitArrayView{dynamicStyleCursorStyles, 0, 2},
+        Containers::MutableBitArrayView{dynamicStyleSelectionStyles, 0, 2},
+        dynamicStylePaddings,
+        {}, {}, {}, {}, {});
+    /* Interpolation views not passed to a layer with shader style animation,
+       or having a wrong size */
+    animatorShaderStyleAnimation.advance({}, mask, mask, mask, factors, mask,
+        dynamicStyleUniformsEditing,
+        Containers::MutableBitArrayView{dynamicStyleCursorStyles, 0, 2},
+        Containers::MutableBitArrayView{dynamicStyleSelectionStyles, 0, 2},
+        dynamicStylePaddings,
+        dynamicEditingStyleUniforms,
+        dynamicEditingStylePaddings, {});
+    animatorShaderStyleAnimation.advance({}, mask, mask, mask, factors, mask,
+        dynamicStyleUniformsEditing,
+        dynamicStyleInterpolationUniforms,
+        dynamicStyleInterpolationFactors,
+        Containers::MutableBitArrayView{dynamicStyleCursorStyles, 0, 2},
+        Containers::MutableBitArrayView{dynamicStyleSelectionStyles, 0, 2},
+        dynamicStylePaddings,
+        dynamicEditingStyleUniforms,
+        dynamicEditingStyleInterpolationUniforms,
+        Containers::arrayView(dynamicEditingStyleInterpolationFactors).prefix(3),
+        dynamicEditingStylePaddings, {});
     /* All views correct but the layer doesn't have styles set */
     animator.advance({}, mask, mask, mask, factors, mask,
         dynamicStyleUniforms,
@@ -2897,6 +3114,10 @@ void TextLayerStyleAnimatorTest::advanceInvalid() {
         "Ui::TextLayerStyleAnimator::advance(): expected dynamic style cursor style, selection style and padding views to have a size of 2, the dynamic style uniform view a size of 6, and the dynamic editing style uniform and padding views a size of 4, but got 2, 2, 2; 6; 4 and 3\n"
         "Ui::TextLayerStyleAnimator::advance(): expected dynamic style cursor style, selection style and padding views to have a size of 2, the dynamic style uniform view a size of 6, and the dynamic editing style uniform and padding views a size of 4, but got 2, 2, 2; 6; 0 and 0\n"
 
+        "Ui::TextLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 0 and dynamic editing style interpolation uniform and factor views a size of 0, but got 2, 2 and 0, 0\n"
+        "Ui::TextLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 6 and dynamic editing style interpolation uniform and factor views a size of 4, but got 0, 0 and 0, 0\n"
+        "Ui::TextLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of 6 and dynamic editing style interpolation uniform and factor views a size of 4, but got 6, 6 and 4, 3\n"
+
         "Ui::TextLayerStyleAnimator::advance(): no style data was set on the layer\n"
         "Ui::TextLayerStyleAnimator::advance(): no editing style data was set on the layer\n",
         TestSuite::Compare::String);
@@ -3205,6 +3426,176 @@ void TextLayerStyleAnimatorTest::layerAdvance() {
     CORRADE_VERIFY(!layer.stateData().dynamicEditingStyleChanged);
 }
 
+void TextLayerStyleAnimatorTest::layerAdvanceShaderStyleAnimation() {
+    /* Like layerAdvance(), but verifying just the differences with the
+       interpolation done in the shader */
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Properties doProperties() override { return {}; }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<EmptyShaper>(*this); }
+    } font;
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
+    cache.addFont(67, &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{3}
+        .setEditingStyleCount(2)
+        .setDynamicStyleCount(2)
+        .addFlags(TextLayerSharedFlag::ShaderStyleAnimation)
+    };
+
+    FontHandle fontHandle = shared.addFont(font, 1.0f, {});
+
+    shared.setStyle(
+        TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}
+            .setColor(Color4{0.25f}),
+         TextLayerStyleUniform{}
+            .setColor(Color4{0.75f}),
+         TextLayerStyleUniform{}},
+        {fontHandle, fontHandle, fontHandle},
+        {Text::Alignment::MiddleCenter,
+         Text::Alignment::MiddleCenter,
+         Text::Alignment::MiddleCenter},
+        {}, {}, {},
+        {1, 0, -1},
+        {0, 1, -1},
+        {});
+    shared.setEditingStyle(
+        TextLayerCommonEditingStyleUniform{},
+        {TextLayerEditingStyleUniform{}
+            .setBackgroundColor(Color4{0.5f}),
+         TextLayerEditingStyleUniform{}
+            .setBackgroundColor(Color4{1.0f})},
+        {-1, 2},
+        {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        TextLayer::State& stateData() {
+            return static_cast<TextLayer::State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Initially the dynamic styles, including the selection text uniforms and
+       the editing styles, reference themselves */
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations.size(), 6);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations.size(), 4);
+    for(std::size_t i = 0; i != 6; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[i].uniforms, (Vector2ui{UnsignedInt(3 + i)}));
+        CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[i].factor, 0.0f);
+    }
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[i].uniforms, (Vector2ui{UnsignedInt(2 + i)}));
+        CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[i].factor, 0.0f);
+    }
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    DataHandle data = layer.create(2, "", {});
+
+    TextLayerStyleAnimator animator{animatorHandle(0, 1)};
+    layer.assignAnimator(animator);
+
+    animator.create(0, 1, Animation::Easing::linear, 0_nsec, 20_nsec, data);
+
+    Containers::BitArray activeStorage{NoInit, 1};
+    Containers::BitArray startedStorage{NoInit, 1};
+    Containers::BitArray stoppedStorage{NoInit, 1};
+    Float factorStorage[1];
+    Containers::BitArray removeStorage{NoInit, 1};
+
+    /* Advancing to 1/4 sets the style and the interpolations, the uniforms
+       stay untouched */
+    layer.advanceAnimations(5_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 1);
+    CORRADE_COMPARE(layer.style(data), shared.styleCount() + 0);
+    CORRADE_COMPARE(layer.dynamicStyleUniforms()[0].color, Color4{1.0f});
+    CORRADE_COMPARE(layer.dynamicEditingStyleUniforms()[2*0 + 1].backgroundColor, Color4{1.0f});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{0, 1}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.25f);
+    /* The selection text uniform falls back to the style uniform in the
+       source style and is overriden in the target style */
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[shared.dynamicStyleCount() + 2*0 + 0].uniforms, (Vector2ui{0, 2}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[shared.dynamicStyleCount() + 2*0 + 0].factor, 0.25f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 1].uniforms, (Vector2ui{1, 0}));
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 1].factor, 0.25f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 0].uniforms, (Vector2ui{0, 1}));
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 0].factor, 0.25f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(!layer.stateData().dynamicEditingStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicEditingStyleInterpolationChanged);
+
+    /* Advancing to 1/2 updates just the interpolations */
+    layer.update(LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    layer.stateData().dynamicStyleInterpolationChanged = false;
+    layer.stateData().dynamicEditingStyleInterpolationChanged = false;
+    layer.advanceAnimations(10_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{0, 1}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.5f);
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[shared.dynamicStyleCount() + 2*0 + 0].factor, 0.5f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 1].factor, 0.5f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 0].factor, 0.5f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(!layer.stateData().dynamicEditingStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicEditingStyleInterpolationChanged);
+
+    /* Advancing to the end switches to the final style, no interpolation
+       update */
+    layer.update(LayerState::NeedsCommonDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    layer.stateData().dynamicStyleInterpolationChanged = false;
+    layer.stateData().dynamicEditingStyleInterpolationChanged = false;
+    layer.advanceAnimations(20_nsec, activeStorage, startedStorage, stoppedStorage, factorStorage, removeStorage, {animator});
+    CORRADE_COMPARE(layer.dynamicStyleUsedCount(), 0);
+    CORRADE_COMPARE(layer.style(data), 1);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    CORRADE_VERIFY(!layer.stateData().dynamicStyleInterpolationChanged);
+    CORRADE_VERIFY(!layer.stateData().dynamicEditingStyleInterpolationChanged);
+
+    /* Setting the dynamic style directly makes all its uniforms reference
+       themselves again */
+    layer.setDynamicStyleWithCursorSelection(0, TextLayerStyleUniform{}, fontHandle, Text::Alignment::MiddleCenter, {}, {}, TextLayerEditingStyleUniform{}, {}, TextLayerEditingStyleUniform{}, {}, {});
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].uniforms, (Vector2ui{3, 3}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[0].factor, 0.0f);
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[shared.dynamicStyleCount() + 2*0 + 0].uniforms, (Vector2ui{5, 5}));
+    CORRADE_COMPARE(layer.stateData().dynamicStyleInterpolations[shared.dynamicStyleCount() + 2*0 + 0].factor, 0.0f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 1].uniforms, (Vector2ui{3, 3}));
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 1].factor, 0.0f);
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 0].uniforms, (Vector2ui{2, 2}));
+    CORRADE_COMPARE(layer.stateData().dynamicEditingStyleInterpolations[2*0 + 0].factor, 0.0f);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|LayerState::NeedsCommonDataUpdate);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicEditingStyleChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicStyleInterpolationChanged);
+    CORRADE_VERIFY(layer.stateData().dynamicEditingStyleInterpolationChanged);
+}
+
 void TextLayerStyleAnimatorTest::uiAdvance() {
     /* Verifies that removing a data with an animation attached properly cleans
        the attached dynamic style (if there's any) in
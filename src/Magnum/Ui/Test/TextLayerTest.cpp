@@ -28,6 +28,7 @@
 /* for keyTextEventSynthesizedFromPointerPress(), an "integration test", for
    debugIntegration() */
 #include <Corrade/Containers/Function.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/StridedBitArrayView.h>
@@ -40,6 +41,7 @@
 #include <Corrade/Utility/Format.h>
 #include <Magnum/PixelFormat.h>
 #include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Packing.h>
 #include <Magnum/Math/Range.h>
 #include <Magnum/Text/AbstractGlyphCache.h>
 #include <Magnum/Text/Alignment.h>
@@ -116,12 +118,14 @@ struct TextLayerTest: TestSuite::Tester {
     void sharedConfigurationSetters();
     void sharedConfigurationSettersSameEditingStyleUniformCount();
     void sharedConfigurationSettersInvalidEditingStyleOrUniformCount();
+    void sharedConfigurationSettersInvalidRecompactionThreshold();
 
     void sharedConstruct();
     void sharedConstructNoCreate();
     void sharedConstructCopy();
     void sharedConstructMove();
     void sharedConstructZeroStyleCount();
+    void sharedConstructCompactVerticesTooManyStyles();
 
     void sharedAddFont();
     void sharedAddFontTakeOwnership();
@@ -179,6 +183,7 @@ struct TextLayerTest: TestSuite::Tester {
     void setCursor();
     void setCursorInvalid();
     void updateText();
+    void updateTextMultiline();
     void updateTextInvalid();
     void editText();
     void editTextInvalid();
@@ -191,6 +196,9 @@ struct TextLayerTest: TestSuite::Tester {
     void createSetTextTextPropertiesEditableInvalid();
 
     void createSetUpdateTextFromLayerItself();
+    void shapeCache();
+    void fillGlyphCacheOnDemand();
+    void fillGlyphCacheDeferred();
 
     void setColor();
     void setPadding();
@@ -215,12 +223,15 @@ struct TextLayerTest: TestSuite::Tester {
     void layoutNoStyleSet();
 
     void updateEmpty();
+    void updateRecompactionThreshold();
+    void updateDirtyRanges();
     void updateCleanDataOrder();
     void updateAlignment();
     void updateAlignmentGlyph();
     void updatePadding();
     void updatePaddingGlyph();
     void updateTransformation();
+    void updateCompactVertices();
     void updateNoStyleSet();
     void updateNoEditingStyleSet();
 
@@ -1420,6 +1431,16 @@ const struct {
         Matrix3::scaling(Vector2{2.5f})},
 };
 
+const struct {
+    const char* name;
+    TextLayerSharedFlags sharedLayerFlags;
+    TextLayerFlags layerFlags;
+} UpdateCompactVerticesData[]{
+    {"", {}, {}},
+    {"distance field", TextLayerSharedFlag::DistanceField, {}},
+    {"transformable", {}, TextLayerFlag::Transformable},
+};
+
 const struct {
     const char* name;
     UnsignedInt editingStyleCount, dynamicStyleCount;
@@ -1644,12 +1665,14 @@ TextLayerTest::TextLayerTest() {
               &TextLayerTest::sharedConfigurationSetters,
               &TextLayerTest::sharedConfigurationSettersSameEditingStyleUniformCount,
               &TextLayerTest::sharedConfigurationSettersInvalidEditingStyleOrUniformCount,
+              &TextLayerTest::sharedConfigurationSettersInvalidRecompactionThreshold,
 
               &TextLayerTest::sharedConstruct,
               &TextLayerTest::sharedConstructNoCreate,
               &TextLayerTest::sharedConstructCopy,
               &TextLayerTest::sharedConstructMove,
               &TextLayerTest::sharedConstructZeroStyleCount,
+              &TextLayerTest::sharedConstructCompactVerticesTooManyStyles,
 
               &TextLayerTest::sharedAddFont,
               &TextLayerTest::sharedAddFontTakeOwnership,
@@ -1733,7 +1756,8 @@ TextLayerTest::TextLayerTest() {
     addInstancedTests({&TextLayerTest::updateText},
         Containers::arraySize(UpdateTextSetPaddingData));
 
-    addTests({&TextLayerTest::updateTextInvalid});
+    addTests({&TextLayerTest::updateTextMultiline,
+              &TextLayerTest::updateTextInvalid});
 
     addInstancedTests({&TextLayerTest::editText},
         Containers::arraySize(EditData));
@@ -1756,7 +1780,10 @@ TextLayerTest::TextLayerTest() {
 
     addRepeatedTests({&TextLayerTest::createSetUpdateTextFromLayerItself}, 10);
 
-    addTests({&TextLayerTest::setColor});
+    addTests({&TextLayerTest::shapeCache,
+              &TextLayerTest::fillGlyphCacheOnDemand,
+              &TextLayerTest::fillGlyphCacheDeferred,
+              &TextLayerTest::setColor});
 
     addInstancedTests({&TextLayerTest::setPadding},
         Containers::arraySize(UpdateTextSetPaddingData));
@@ -1784,7 +1811,9 @@ TextLayerTest::TextLayerTest() {
     addInstancedTests({&TextLayerTest::layoutNoStyleSet},
         Containers::arraySize(CreateLayoutUpdateNoStyleSetData));
 
-    addTests({&TextLayerTest::updateEmpty});
+    addTests({&TextLayerTest::updateEmpty,
+              &TextLayerTest::updateRecompactionThreshold,
+              &TextLayerTest::updateDirtyRanges});
 
     addInstancedTests({&TextLayerTest::updateCleanDataOrder},
         Containers::arraySize(UpdateCleanDataOrderData));
@@ -1798,6 +1827,9 @@ TextLayerTest::TextLayerTest() {
     addInstancedTests({&TextLayerTest::updateTransformation},
         Containers::arraySize(UpdateTransformationData));
 
+    addInstancedTests({&TextLayerTest::updateCompactVertices},
+        Containers::arraySize(UpdateCompactVerticesData));
+
     addInstancedTests({&TextLayerTest::updateNoStyleSet,
                        &TextLayerTest::updateNoEditingStyleSet},
         Containers::arraySize(CreateLayoutUpdateNoStyleSetData));
@@ -2280,8 +2312,8 @@ void TextLayerTest::sharedDebugFlag() {
 
 void TextLayerTest::sharedDebugFlags() {
     Containers::String out;
-    Debug{&out} << (TextLayerSharedFlag::DistanceField|TextLayerSharedFlag(0x80)) << TextLayerSharedFlags{};
-    CORRADE_COMPARE(out, "Ui::TextLayerSharedFlag::DistanceField|Ui::TextLayerSharedFlag(0x80) Ui::TextLayerSharedFlags{}\n");
+    Debug{&out} << (TextLayerSharedFlag::DistanceField|TextLayerSharedFlag::FillGlyphCacheOnDemand|TextLayerSharedFlag::ShaderStyleAnimation|TextLayerSharedFlag(0x80)) << TextLayerSharedFlag::FillGlyphCacheDeferred << TextLayerSharedFlags{};
+    CORRADE_COMPARE(out, "Ui::TextLayerSharedFlag::DistanceField|Ui::TextLayerSharedFlag::FillGlyphCacheOnDemand|Ui::TextLayerSharedFlag::ShaderStyleAnimation|Ui::TextLayerSharedFlag(0x80) Ui::TextLayerSharedFlag::FillGlyphCacheDeferred Ui::TextLayerSharedFlags{}\n");
 }
 
 void TextLayerTest::sharedConfigurationConstruct() {
@@ -2338,11 +2370,15 @@ void TextLayerTest::sharedConfigurationSetters() {
     CORRADE_COMPARE(configuration.editingStyleCount(), 0);
     CORRADE_COMPARE(configuration.dynamicStyleCount(), 0);
     CORRADE_COMPARE(configuration.hasEditingStyles(), false);
+    CORRADE_COMPARE(configuration.recompactionThreshold(), 0.0f);
+    CORRADE_COMPARE(configuration.shapeCacheSize(), 0);
     CORRADE_COMPARE(configuration.flags(), TextLayerSharedFlags{});
 
     configuration
         .setEditingStyleCount(2, 7)
         .setDynamicStyleCount(9)
+        .setRecompactionThreshold(0.25f)
+        .setShapeCacheSize(16)
         .setFlags(TextLayerSharedFlag::DistanceField)
         .addFlags(TextLayerSharedFlag(0xe0))
         .clearFlags(TextLayerSharedFlag(0x70));
@@ -2350,6 +2386,8 @@ void TextLayerTest::sharedConfigurationSetters() {
     CORRADE_COMPARE(configuration.editingStyleCount(), 7);
     CORRADE_COMPARE(configuration.dynamicStyleCount(), 9);
     CORRADE_COMPARE(configuration.hasEditingStyles(), true);
+    CORRADE_COMPARE(configuration.recompactionThreshold(), 0.25f);
+    CORRADE_COMPARE(configuration.shapeCacheSize(), 16);
     CORRADE_COMPARE(configuration.flags(), TextLayerSharedFlag::DistanceField|TextLayerSharedFlag(0x80));
 
     /* Disabling dynamic editing styles if there's non-zero editing style count
@@ -2431,6 +2469,25 @@ void TextLayerTest::sharedConfigurationSettersInvalidEditingStyleOrUniformCount(
         TestSuite::Compare::String);
 }
 
+void TextLayerTest::sharedConfigurationSettersInvalidRecompactionThreshold() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* Both ends of the range are fine */
+    TextLayer::Shared::Configuration configuration{2, 3};
+    configuration
+        .setRecompactionThreshold(0.0f)
+        .setRecompactionThreshold(1.0f);
+
+    Containers::String out;
+    Error redirectError{&out};
+    configuration.setRecompactionThreshold(-0.1f);
+    configuration.setRecompactionThreshold(1.5f);
+    CORRADE_COMPARE_AS(out,
+        "Ui::TextLayer::Shared::Configuration::setRecompactionThreshold(): expected a value in the [0, 1] range, got -0.1\n"
+        "Ui::TextLayer::Shared::Configuration::setRecompactionThreshold(): expected a value in the [0, 1] range, got 1.5\n",
+        TestSuite::Compare::String);
+}
+
 void TextLayerTest::sharedConstruct() {
     struct: Text::AbstractGlyphCache {
         using Text::AbstractGlyphCache::AbstractGlyphCache;
@@ -2447,6 +2504,8 @@ void TextLayerTest::sharedConstruct() {
     } shared{cache, TextLayer::Shared::Configuration{3, 5}
         .setEditingStyleCount(2, 7)
         .setDynamicStyleCount(4)
+        .setRecompactionThreshold(0.75f)
+        .setShapeCacheSize(16)
         .setFlags(TextLayerSharedFlag::DistanceField)
     };
     CORRADE_COMPARE(shared.styleUniformCount(), 3);
@@ -2456,6 +2515,11 @@ void TextLayerTest::sharedConstruct() {
     CORRADE_COMPARE(shared.dynamicStyleCount(), 4);
     CORRADE_VERIFY(shared.hasEditingStyles());
     CORRADE_COMPARE(shared.flags(), TextLayerSharedFlag::DistanceField);
+    CORRADE_COMPARE(shared.recompactionThreshold(), 0.75f);
+    CORRADE_COMPARE(shared.shapeCacheSize(), 16);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 0);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 0);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 0);
 
     CORRADE_COMPARE(&shared.glyphCache(), &cache);
     CORRADE_COMPARE(&static_cast<const Shared&>(shared).glyphCache(), &cache);
@@ -2563,6 +2627,46 @@ void TextLayerTest::sharedConstructZeroStyleCount() {
     CORRADE_COMPARE(out, "Ui::TextLayer::Shared: expected non-zero total style count\n");
 }
 
+void TextLayerTest::sharedConstructCompactVerticesTooManyStyles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32}};
+
+    struct Shared: TextLayer::Shared {
+        explicit Shared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    };
+
+    /* Exactly 65536 is fine, also without compact vertices it's fine */
+    Shared{cache, Shared::Configuration{65536, 1}
+        .setFlags(TextLayerSharedFlag::CompactVertices)};
+    Shared{cache, Shared::Configuration{65535, 1}
+        .setDynamicStyleCount(1)
+        .setFlags(TextLayerSharedFlag::CompactVertices)};
+    Shared{cache, Shared::Configuration{65537, 1}};
+
+    Containers::String out;
+    Error redirectError{&out};
+    Shared{cache, Shared::Configuration{65537, 1}
+        .setFlags(TextLayerSharedFlag::CompactVertices)};
+    /* Dynamic styles with editing styles take three uniforms each */
+    Shared{cache, Shared::Configuration{65534, 1}
+        .setEditingStyleCount(1)
+        .setDynamicStyleCount(1)
+        .setFlags(TextLayerSharedFlag::CompactVertices)};
+    CORRADE_COMPARE_AS(out,
+        "Ui::TextLayer::Shared: expected at most 65536 style uniforms with Ui::TextLayerSharedFlag::CompactVertices but got 65537\n"
+        "Ui::TextLayer::Shared: expected at most 65536 style uniforms with Ui::TextLayerSharedFlag::CompactVertices but got 65537\n",
+        TestSuite::Compare::String);
+}
+
 void TextLayerTest::sharedAddFont() {
     struct: Text::AbstractGlyphCache {
         using Text::AbstractGlyphCache::AbstractGlyphCache;
@@ -7179,30 +7283,56 @@ template<class StyleIndex, class GlyphIndex> void TextLayerTest::createRemoveSet
             /* The edit data references are't modified compared to before */
             0u, 0xffffffffu, 0xffffffffu, 4u, 0xffffffffu, 3u, 0xffffffffu, 4u
         }), TestSuite::Compare::Container);
-        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::TextLayerData::textRun), Containers::arrayView({
-            0u, 0xffffffffu, 0xffffffffu, 6u, 0xffffffffu, 3u, 0xffffffffu, 4u
-        }), TestSuite::Compare::Container);
         /* Also no newly added or freed edit data */
         CORRADE_COMPARE(layer.stateData().firstFreeEditData, 2);
         CORRADE_COMPARE(layer.stateData().editData.size(), 5);
-        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textOffset), Containers::arrayView({
-            0u, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 20u
-        }), TestSuite::Compare::Container);
-        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textSize), Containers::arrayView({
-            5u, 4u, 0u, 2u, 0u, 3u, 4u
-        }), TestSuite::Compare::Container);
-        CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::data), Containers::arrayView({
-            0u, 2u, 4u, 5u, 7u, 3u, 3u
-        }), TestSuite::Compare::Container);
-        CORRADE_COMPARE_AS(layer.stateData().textData,
-            "hello\0"
-            "ahoy\0"    /* now unused */
-            "\0"
-            "hi\0"      /* now unused */
-            "\0"        /* now unused */
-            "hey\0"     /* now unused */
-            "ahoy\0"_s,
-            TestSuite::Compare::String);
+
+        /* The updateText() modifies the `secondGlyph` text in place as it's
+           the last in the text array, setText() adds a new run */
+        if(data.updateEditableTextInsteadOfSet) {
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::TextLayerData::textRun), Containers::arrayView({
+                0u, 0xffffffffu, 0xffffffffu, 5u, 0xffffffffu, 3u, 0xffffffffu, 4u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textOffset), Containers::arrayView({
+                0u, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 16u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textSize), Containers::arrayView({
+                5u, 4u, 0u, 2u, 0u, 4u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::data), Containers::arrayView({
+                0u, 2u, 4u, 5u, 7u, 3u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(layer.stateData().textData,
+                "hello\0"
+                "ahoy\0"    /* now unused */
+                "\0"
+                "hi\0"      /* now unused */
+                "\0"        /* now unused */
+                "ahoy\0"_s,
+                TestSuite::Compare::String);
+        } else {
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::TextLayerData::textRun), Containers::arrayView({
+                0u, 0xffffffffu, 0xffffffffu, 6u, 0xffffffffu, 3u, 0xffffffffu, 4u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textOffset), Containers::arrayView({
+                0u, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 20u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::textSize), Containers::arrayView({
+                5u, 4u, 0u, 2u, 0u, 3u, 4u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().textRuns).slice(&Implementation::TextLayerTextRun::data), Containers::arrayView({
+                0u, 2u, 4u, 5u, 7u, 3u, 3u
+            }), TestSuite::Compare::Container);
+            CORRADE_COMPARE_AS(layer.stateData().textData,
+                "hello\0"
+                "ahoy\0"    /* now unused */
+                "\0"
+                "hi\0"      /* now unused */
+                "\0"        /* now unused */
+                "hey\0"     /* now unused */
+                "ahoy\0"_s,
+                TestSuite::Compare::String);
+        }
     }
 }
 
@@ -7821,22 +7951,29 @@ void TextLayerTest::updateText() {
     CORRADE_COMPARE(layer.glyphCount(text), 9);
 
     /* Clear the state flags. The recompaction removes the unused runs
-       again. */
+       again, which makes the text run the last one. */
     layer.update(LayerState::NeedsDataUpdate|data.expectedExtraState, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
     CORRADE_COMPARE(layer.state(), LayerStates{});
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 3);
     CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
+    CORRADE_COMPARE(layer.stateData().textRuns[2].data, dataHandleId(text));
 
     /* Removal at the very end, putting cursor back at the end; LayerDataHandle
-       overload with implicit selection. Again adds new runs and marks
-       originals as unused. */
+       overload with implicit selection. Adds a new glyph run and marks the
+       original as unused, but as the text is the last in the text array, it's
+       modified in place. */
     layer.updateText(dataHandleData(text), 6, 3, 0, "", 4);
     CORRADE_COMPARE(layer.text(text), "helloo");
     CORRADE_COMPARE(layer.text(text).flags(), Containers::StringViewFlag::NullTerminated);
     CORRADE_COMPARE(layer.cursor(text), Containers::pair(4u, 4u));
     CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|data.expectedExtraState);
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 4);
-    CORRADE_COMPARE(layer.stateData().textRuns.size(), 4);
+    CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
+    CORRADE_COMPARE_AS(layer.stateData().textData,
+        "aaaa\0"
+        "bb\0"
+        "helloo\0"_s,
+        TestSuite::Compare::String);
     /* Lazy verification that the text gets implicitly reshaped */
     CORRADE_COMPARE(layer.glyphCount(text), 6);
 
@@ -7848,14 +7985,20 @@ void TextLayerTest::updateText() {
     CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
 
     /* Insertion at the end after a removed portion, cursor & selection inside
-       it. Again adds new runs and marks originals as unused. */
+       it. Again adds a new glyph run, marks the original as unused and
+       modifies the text in place. */
     layer.updateText(text, 1, 4, 2, "vercrafts", 5, 3);
     CORRADE_COMPARE(layer.text(text), "hovercrafts");
     CORRADE_COMPARE(layer.text(text).flags(), Containers::StringViewFlag::NullTerminated);
     CORRADE_COMPARE(layer.cursor(text), Containers::pair(5u, 3u));
     CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|data.expectedExtraState);
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 4);
-    CORRADE_COMPARE(layer.stateData().textRuns.size(), 4);
+    CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
+    CORRADE_COMPARE_AS(layer.stateData().textData,
+        "aaaa\0"
+        "bb\0"
+        "hovercrafts\0"_s,
+        TestSuite::Compare::String);
     /* Lazy verification that the text gets implicitly reshaped */
     CORRADE_COMPARE(layer.glyphCount(text), 11);
 
@@ -7867,15 +8010,20 @@ void TextLayerTest::updateText() {
     CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
 
     /* Insertion before a removed portion, cursor inside it; LayerDataHandle
-       overload with explicit selection. Again adds new runs and marks
-       originals as unused. */
+       overload with explicit selection. Again adds a new glyph run, marks the
+       original as unused and modifies the text in place. */
     layer.updateText(dataHandleData(text), 5, 5, 2, "ldo", 4, 3);
     CORRADE_COMPARE(layer.text(text), "holdovers");
     CORRADE_COMPARE(layer.text(text).flags(), Containers::StringViewFlag::NullTerminated);
     CORRADE_COMPARE(layer.cursor(text), Containers::pair(4u, 3u));
     CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|data.expectedExtraState);
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 4);
-    CORRADE_COMPARE(layer.stateData().textRuns.size(), 4);
+    CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
+    CORRADE_COMPARE_AS(layer.stateData().textData,
+        "aaaa\0"
+        "bb\0"
+        "holdovers\0"_s,
+        TestSuite::Compare::String);
     /* Lazy verification that the text gets implicitly reshaped */
     CORRADE_COMPARE(layer.glyphCount(text), 9);
 
@@ -7886,15 +8034,20 @@ void TextLayerTest::updateText() {
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 3);
     CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
 
-    /* Removing everything. Adds a new text run. doesn't add any new glyph run.
-       Marks both the original runs as unused. */
+    /* Removing everything. Modifies the text in place, doesn't add any new
+       glyph run and marks the original glyph run as unused. */
     layer.updateText(text, 0, 9, 0, "", 0);
     CORRADE_COMPARE(layer.text(text), "");
     CORRADE_COMPARE(layer.text(text).flags(), Containers::StringViewFlag::NullTerminated);
     CORRADE_COMPARE(layer.cursor(text), Containers::pair(0u, 0u));
     CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate|data.expectedExtraState);
     CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 3);
-    CORRADE_COMPARE(layer.stateData().textRuns.size(), 4);
+    CORRADE_COMPARE(layer.stateData().textRuns.size(), 3);
+    CORRADE_COMPARE_AS(layer.stateData().textData,
+        "aaaa\0"
+        "bb\0"
+        "\0"_s,
+        TestSuite::Compare::String);
     /* Lazy verification that the text gets implicitly reshaped */
     CORRADE_COMPARE(layer.glyphCount(text), 0);
 
@@ -7921,6 +8074,181 @@ void TextLayerTest::updateText() {
         caching */
 }
 
+void TextLayerTest::updateTextMultiline() {
+    /* Shaper that produces a glyph for each byte, with the ID being the
+       character and wider glyphs for 'w'. Unlike ThreeGlyphShaper the output
+       doesn't depend on where the shaped range is in the text, which is what
+       a real shaper does as well. Records how many bytes got shaped to verify
+       that only the edited line is reshaped if possible. */
+    struct Shaper: Text::AbstractShaper {
+        explicit Shaper(Text::AbstractFont& font, std::size_t& shapedByteCount): Text::AbstractShaper{font}, _shapedByteCount(shapedByteCount) {}
+
+        UnsignedInt doShape(Containers::StringView text, UnsignedInt begin, UnsignedInt end, Containers::ArrayView<const Text::FeatureRange>) override {
+            _text = text.slice(begin, end);
+            _begin = begin;
+            _shapedByteCount += end - begin;
+            return end - begin;
+        }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<UnsignedInt>& ids) const override {
+            for(std::size_t i = 0; i != ids.size(); ++i)
+                ids[i] = _text[i];
+        }
+        void doGlyphOffsetsAdvancesInto(const Containers::StridedArrayView1D<Vector2>& offsets, const Containers::StridedArrayView1D<Vector2>& advances) const override {
+            for(std::size_t i = 0; i != offsets.size(); ++i) {
+                offsets[i] = {};
+                advances[i] = {_text[i] == 'w' ? 4.0f : 2.0f, 0.0f};
+            }
+        }
+        void doGlyphClustersInto(const Containers::StridedArrayView1D<UnsignedInt>& clusters) const override {
+            for(std::size_t i = 0; i != clusters.size(); ++i)
+                clusters[i] = _begin + i;
+        }
+
+        private:
+            std::size_t& _shapedByteCount;
+            Containers::StringView _text;
+            UnsignedInt _begin;
+    };
+
+    struct Font: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {1.0f, 1.0f, -0.5f, 2.0f, 256};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<Shaper>(*this, shapedByteCount); }
+
+        std::size_t shapedByteCount = 0;
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32}};
+    cache.addFont(256, &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}};
+    shared.setStyle(TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 1.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* The incrementally updated text should result in the same glyphs and
+       size as the same text shaped from scratch */
+    const auto verify = [&](DataHandle text) {
+        DataHandle expected = layer.create(0, layer.text(text), {}, TextDataFlag::Editable);
+        const Implementation::TextLayerData& textData = layer.stateData().data[dataHandleId(text)];
+        const Implementation::TextLayerData& expectedData = layer.stateData().data[dataHandleId(expected)];
+        CORRADE_COMPARE(layer.size(text), layer.size(expected));
+        CORRADE_COMPARE(textData.alignment, expectedData.alignment);
+        const Implementation::TextLayerGlyphRun& glyphRun = layer.stateData().glyphRuns[textData.glyphRun];
+        const Implementation::TextLayerGlyphRun& expectedGlyphRun = layer.stateData().glyphRuns[expectedData.glyphRun];
+        const Containers::StridedArrayView1D<const Implementation::TextLayerGlyphData> glyphData = layer.stateData().glyphData.sliceSize(glyphRun.glyphOffset, glyphRun.glyphCount);
+        const Containers::StridedArrayView1D<const Implementation::TextLayerGlyphData> expectedGlyphData = layer.stateData().glyphData.sliceSize(expectedGlyphRun.glyphOffset, expectedGlyphRun.glyphCount);
+        CORRADE_COMPARE_AS(glyphData.slice(&Implementation::TextLayerGlyphData::position),
+            expectedGlyphData.slice(&Implementation::TextLayerGlyphData::position),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(glyphData.slice(&Implementation::TextLayerGlyphData::glyphId),
+            expectedGlyphData.slice(&Implementation::TextLayerGlyphData::glyphId),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(glyphData.slice(&Implementation::TextLayerGlyphData::glyphCluster),
+            expectedGlyphData.slice(&Implementation::TextLayerGlyphData::glyphCluster),
+            TestSuite::Compare::Container);
+        layer.remove(expected);
+    };
+
+    /* Line widths are 8, 4 and 12 units */
+    DataHandle text = layer.create(0, "aaaa\nbb\naaaaaa", {}, TextDataFlag::Editable);
+    CORRADE_COMPARE(font.shapedByteCount, 12);
+
+    /* Inserting into a line that isn't the widest one reshapes just the new
+       and the previous version of it */
+    font.shapedByteCount = 0;
+    layer.updateText(text, 0, 0, 7, "cc", 9);
+    CORRADE_COMPARE(layer.text(text), "aaaa\nbbcc\naaaaaa");
+    CORRADE_COMPARE(font.shapedByteCount, 4 + 2);
+    CORRADE_COMPARE(layer.glyphCount(text), 14);
+    {
+        CORRADE_ITERATION("insert into a line");
+        verify(text);
+    }
+
+    /* Making the first line the widest reshapes just the new version of it,
+       as it's clear it defines the new size */
+    font.shapedByteCount = 0;
+    layer.updateText(text, 1, 2, 1, "www", 4);
+    CORRADE_COMPARE(layer.text(text), "awwwa\nbbcc\naaaaaa");
+    CORRADE_COMPARE(font.shapedByteCount, 5);
+    CORRADE_COMPARE(layer.glyphCount(text), 15);
+    {
+        CORRADE_ITERATION("make a line the widest");
+        verify(text);
+    }
+
+    /* Making the widest line narrower can't be done incrementally as it's not
+       known what's the width of the other lines, the whole text is
+       reshaped */
+    font.shapedByteCount = 0;
+    layer.updateText(text, 1, 3, 1, "", 1);
+    CORRADE_COMPARE(layer.text(text), "aa\nbbcc\naaaaaa");
+    CORRADE_COMPARE(font.shapedByteCount, 2 + 5 + 12);
+    CORRADE_COMPARE(layer.glyphCount(text), 12);
+    {
+        CORRADE_ITERATION("make the widest line narrower");
+        verify(text);
+    }
+
+    /* Adding a line changes the vertical alignment, the whole text is
+       reshaped */
+    font.shapedByteCount = 0;
+    layer.updateText(text, 0, 0, 2, "\nbb", 5);
+    CORRADE_COMPARE(layer.text(text), "aa\nbb\nbbcc\naaaaaa");
+    CORRADE_COMPARE(font.shapedByteCount, 14);
+    CORRADE_COMPARE(layer.glyphCount(text), 14);
+    {
+        CORRADE_ITERATION("add a line");
+        verify(text);
+    }
+
+    /* Removing all glyphs from a line keeps the run with the remaining
+       lines */
+    font.shapedByteCount = 0;
+    layer.updateText(text, 3, 2, 3, "", 3);
+    CORRADE_COMPARE(layer.text(text), "aa\n\nbbcc\naaaaaa");
+    CORRADE_COMPARE(font.shapedByteCount, 2);
+    CORRADE_COMPARE(layer.glyphCount(text), 12);
+    {
+        CORRADE_ITERATION("remove all glyphs from a line");
+        verify(text);
+    }
+}
+
 void TextLayerTest::updateTextInvalid() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -9150,93 +9478,482 @@ void TextLayerTest::createSetUpdateTextFromLayerItself() {
     CORRADE_COMPARE(layer.text(third).flags(), Containers::StringViewFlag::NullTerminated);
 }
 
-void TextLayerTest::setColor() {
+void TextLayerTest::shapeCache() {
+    /* A font that counts how many times the shaper was called */
+    struct Shaper: ThreeGlyphShaper {
+        explicit Shaper(Text::AbstractFont& font, int& shapeCalled): ThreeGlyphShaper{font}, shapeCalled(shapeCalled) {}
+
+        UnsignedInt doShape(Containers::StringView text, UnsignedInt begin, UnsignedInt end, Containers::ArrayView<const Text::FeatureRange> features) override {
+            ++shapeCalled;
+            return ThreeGlyphShaper::doShape(text, begin, end, features);
+        }
+
+        int& shapeCalled;
+    };
     struct: Text::AbstractFont {
         Text::FontFeatures doFeatures() const override { return {}; }
-        bool doIsOpened() const override { return true; }
-        void doClose() override {}
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 98};
+        }
+        void doClose() override { _opened = false; }
 
-        Properties doProperties() override { return {}; }
         void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
         Vector2 doGlyphSize(UnsignedInt) override { return {}; }
         Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
-        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<OneGlyphShaper>(*this); }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<Shaper>(*this, shapeCalled); }
+
+        int shapeCalled = 0;
+        bool _opened = false;
     } font;
+    font.openFile({}, {});
 
     struct: Text::AbstractGlyphCache {
         using Text::AbstractGlyphCache::AbstractGlyphCache;
 
         Text::GlyphCacheFeatures doFeatures() const override { return {}; }
         void doSetImage(const Vector2i&, const ImageView2D&) override {}
-    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
-    cache.addFont(67, &font);
+    /* Default padding is 1, resetting to 0 for simplicity */
+    } cache{PixelFormat::R8Unorm, {32, 32}, {}};
+    {
+        UnsignedInt fontId = cache.addFont(font.glyphCount(), &font);
+        cache.addGlyph(fontId, 97, {}, {});
+        cache.addGlyph(fontId, 13, {}, {});
+    }
 
     struct LayerShared: TextLayer::Shared {
         explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
 
         void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
         void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
-    } shared{cache, TextLayer::Shared::Configuration{1}};
+    } shared{cache, TextLayer::Shared::Configuration{1}
+        .setShapeCacheSize(2)
+    };
     shared.setStyle(TextLayerCommonStyleUniform{},
         {TextLayerStyleUniform{}},
-        {shared.addFont(font, 1.0f, {})},
+        /* The font is scaled to 0.5 */
+        {shared.addFont(font, 8.0f, {})},
         {Text::Alignment::MiddleCenter},
         {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(shared.shapeCacheSize(), 2);
 
     struct Layer: TextLayer {
         explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
-    } layer{layerHandle(0, 1), shared};
-
-    /* Required to be called before update() (because AbstractUserInterface
-       guarantees the same on a higher level), not needed for anything here */
-    layer.setSize({1, 1}, {1, 1});
 
-    /* Just to be sure the setters aren't picking up the first ever data
-       always */
-    layer.create(0, "", {});
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
 
-    /* There's nothing that would work differently for createGlyph() */
-    DataHandle data = layer.create(0, "", {});
-    CORRADE_COMPARE(layer.color(data), 0xffffffff_rgbaf);
-    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    /* First time the text is shaped and put into the cache */
+    DataHandle first = layer.create(0, "hello", {});
+    CORRADE_COMPARE(font.shapeCalled, 1);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 1);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 0);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 1);
 
-    /* Clear the state flags */
-    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
-    CORRADE_COMPARE(layer.state(), LayerStates{});
+    /* Second time it's taken from the cache, producing the same output */
+    DataHandle second = layer.create(0, "hello", {});
+    CORRADE_COMPARE(font.shapeCalled, 1);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 1);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 1);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 1);
+    CORRADE_COMPARE(layer.glyphCount(second), 5);
+    CORRADE_COMPARE(layer.size(second), layer.size(first));
+    {
+        const Implementation::TextLayerData& firstData = layer.stateData().data[dataHandleId(first)];
+        const Implementation::TextLayerData& secondData = layer.stateData().data[dataHandleId(second)];
+        CORRADE_COMPARE(secondData.rectangle, firstData.rectangle);
+        CORRADE_COMPARE(secondData.alignment, firstData.alignment);
+        const Implementation::TextLayerGlyphRun& firstRun = layer.stateData().glyphRuns[firstData.glyphRun];
+        const Implementation::TextLayerGlyphRun& secondRun = layer.stateData().glyphRuns[secondData.glyphRun];
+        CORRADE_COMPARE(secondRun.data, dataHandleId(second));
+        CORRADE_COMPARE(secondRun.scale, firstRun.scale);
+        CORRADE_COMPARE(secondRun.glyphOffset, firstRun.glyphOffset + 5);
+        const Containers::StridedArrayView1D<const Implementation::TextLayerGlyphData> glyphData = stridedArrayView(layer.stateData().glyphData);
+        CORRADE_COMPARE_AS(glyphData.sliceSize(secondRun.glyphOffset, secondRun.glyphCount).slice(&Implementation::TextLayerGlyphData::position),
+            glyphData.sliceSize(firstRun.glyphOffset, firstRun.glyphCount).slice(&Implementation::TextLayerGlyphData::position),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(glyphData.sliceSize(secondRun.glyphOffset, secondRun.glyphCount).slice(&Implementation::TextLayerGlyphData::glyphId),
+            glyphData.sliceSize(firstRun.glyphOffset, firstRun.glyphCount).slice(&Implementation::TextLayerGlyphData::glyphId),
+            TestSuite::Compare::Container);
+    }
 
-    /* Setting a color marks the layer as dirty */
-    layer.setColor(data, 0xaabbccdd_rgbaf);
-    CORRADE_COMPARE(layer.color(data), 0xaabbccdd_rgbaf);
-    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    /* Different properties are a different entry */
+    layer.create(0, "hello", TextProperties{}
+        .setAlignment(Text::Alignment::TopLeft));
+    CORRADE_COMPARE(font.shapeCalled, 2);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 1);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 2);
 
-    /* Clear the state flags */
-    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
-    CORRADE_COMPARE(layer.state(), LayerStates{});
+    /* Setting the same text and properties to an existing data is a hit */
+    layer.setText(first, "hello", {});
+    CORRADE_COMPARE(font.shapeCalled, 2);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 2);
+    CORRADE_COMPARE(layer.glyphCount(first), 5);
+    CORRADE_COMPARE(layer.size(first), layer.size(second));
 
-    /* Testing also the other overload */
-    layer.setColor(dataHandleData(data), 0x11223344_rgbaf);
-    CORRADE_COMPARE(layer.color(dataHandleData(data)), 0x11223344_rgbaf);
-    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
-}
+    /* A different feature set evicts the least recently used entry, which is
+       the one with TopLeft alignment */
+    layer.create(0, "hello", TextProperties{}
+        .setFeatures({Text::Feature::Kerning}));
+    CORRADE_COMPARE(font.shapeCalled, 3);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 3);
 
-void TextLayerTest::setPadding() {
-    auto&& data = UpdateTextSetPaddingData[testCaseInstanceId()];
-    setTestCaseDescription(data.name);
+    /* So the original text is still a hit, but TopLeft is a miss again */
+    layer.create(0, "hello", {});
+    CORRADE_COMPARE(font.shapeCalled, 3);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 3);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 3);
+    layer.create(0, "hello", TextProperties{}
+        .setAlignment(Text::Alignment::TopLeft));
+    CORRADE_COMPARE(font.shapeCalled, 4);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 2);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 3);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 4);
 
+    /* Editable text bypasses the cache and doesn't affect the counters */
+    DataHandle editable = layer.create(0, "hello", {}, TextDataFlag::Editable);
+    CORRADE_COMPARE(font.shapeCalled, 5);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 3);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 4);
+    CORRADE_COMPARE(layer.glyphCount(editable), 5);
+
+    /* Clearing the cache makes everything a miss again, while the counters
+       stay */
+    shared.clearShapeCache();
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 0);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 3);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 4);
+    layer.create(0, "hello", {});
+    CORRADE_COMPARE(font.shapeCalled, 6);
+    CORRADE_COMPARE(shared.shapeCacheUsedCount(), 1);
+    CORRADE_COMPARE(shared.shapeCacheHitCount(), 3);
+    CORRADE_COMPARE(shared.shapeCacheMissCount(), 5);
+}
+
+void TextLayerTest::fillGlyphCacheOnDemand() {
+    /* A font that records which glyphs it was asked to put into the cache */
     struct: Text::AbstractFont {
         Text::FontFeatures doFeatures() const override { return {}; }
-        bool doIsOpened() const override { return true; }
-        void doClose() override {}
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 98};
+        }
+        void doClose() override { _opened = false; }
 
-        Properties doProperties() override { return {}; }
         void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
         Vector2 doGlyphSize(UnsignedInt) override { return {}; }
         Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
-        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<OneGlyphShaper>(*this); }
-    } font;
-
-    struct: Text::AbstractGlyphCache {
-        using Text::AbstractGlyphCache::AbstractGlyphCache;
+        bool doFillGlyphCache(Text::AbstractGlyphCache& cache, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds) override {
+            for(const UnsignedInt glyphId: glyphIds)
+                arrayAppend(filled, glyphId);
+            if(full) {
+                Error{} << "Full!";
+                return false;
+            }
+            const UnsignedInt fontId = *cache.findFont(*this);
+            for(const UnsignedInt glyphId: glyphIds)
+                cache.addGlyph(fontId, glyphId, {}, {});
+            return true;
+        }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<ThreeGlyphShaper>(*this); }
+
+        Containers::Array<UnsignedInt> filled;
+        bool full = false;
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    /* Default padding is 1, resetting to 0 for simplicity */
+    } cache{PixelFormat::R8Unorm, {32, 32}, {}};
+    UnsignedInt fontId = cache.addFont(font.glyphCount(), &font);
+    cache.addGlyph(fontId, 97, {}, {});
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}
+        .setFlags(TextLayerSharedFlag::FillGlyphCacheOnDemand)
+    };
+    shared.setStyle(TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 8.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        Containers::StridedArrayView1D<const UnsignedInt> glyphIds(DataHandle handle) const {
+            const State& state = static_cast<const State&>(*_state);
+            const Implementation::TextLayerGlyphRun& run = state.glyphRuns[state.data[dataHandleId(handle)].glyphRun];
+            return stridedArrayView(state.glyphData).sliceSize(run.glyphOffset, run.glyphCount).slice(&Implementation::TextLayerGlyphData::glyphId);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* The shaper produces 22, 13, 97, ..., of which only 97 is in the cache.
+       The remaining two get added, each just once, and the text then
+       references them. */
+    DataHandle first = layer.create(0, "hello", {});
+    CORRADE_COMPARE_AS(font.filled, Containers::arrayView({22u, 13u}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layer.glyphIds(first), Containers::arrayView({
+        cache.glyphId(fontId, 22),
+        cache.glyphId(fontId, 13),
+        cache.glyphId(fontId, 97),
+        cache.glyphId(fontId, 22),
+        cache.glyphId(fontId, 13),
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(cache.glyphId(fontId, 22));
+    CORRADE_VERIFY(cache.glyphId(fontId, 13));
+
+    /* Text with all glyphs already present doesn't fill anything */
+    layer.create(0, "hey", {});
+    CORRADE_COMPARE(font.filled.size(), 2);
+
+    /* Single glyphs get filled as well */
+    DataHandle glyph = layer.createGlyph(0, 55, {});
+    CORRADE_COMPARE_AS(font.filled, Containers::arrayView({22u, 13u, 55u}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layer.glyphIds(glyph), Containers::arrayView({
+        cache.glyphId(fontId, 55)
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(cache.glyphId(fontId, 55));
+
+    /* If filling fails, it's not attempted again and the glyph stays
+       missing */
+    font.full = true;
+    {
+        Containers::String out;
+        Error redirectError{&out};
+        DataHandle failed = layer.createGlyph(0, 56, {});
+        CORRADE_COMPARE(out, "Full!\n");
+        CORRADE_COMPARE_AS(layer.glyphIds(failed), Containers::arrayView({
+            0u
+        }), TestSuite::Compare::Container);
+    }
+    CORRADE_COMPARE_AS(font.filled, Containers::arrayView({22u, 13u, 55u, 56u}),
+        TestSuite::Compare::Container);
+
+    layer.createGlyph(0, 57, {});
+    CORRADE_COMPARE(font.filled.size(), 4);
+}
+
+void TextLayerTest::fillGlyphCacheDeferred() {
+    /* A font that records which glyphs it was asked to put into the cache */
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 98};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        bool doFillGlyphCache(Text::AbstractGlyphCache& cache, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds) override {
+            const UnsignedInt fontId = *cache.findFont(*this);
+            for(const UnsignedInt glyphId: glyphIds) {
+                arrayAppend(filled, glyphId);
+                cache.addGlyph(fontId, glyphId, {}, {});
+            }
+            return true;
+        }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<ThreeGlyphShaper>(*this); }
+
+        Containers::Array<UnsignedInt> filled;
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    /* Default padding is 1, resetting to 0 for simplicity */
+    } cache{PixelFormat::R8Unorm, {32, 32}, {}};
+    UnsignedInt fontId = cache.addFont(font.glyphCount(), &font);
+    cache.addGlyph(fontId, 97, {}, {});
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}
+        .setFlags(TextLayerSharedFlag::FillGlyphCacheDeferred)
+    };
+    shared.setStyle(TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 8.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        Containers::StridedArrayView1D<const UnsignedInt> glyphIds(DataHandle handle) const {
+            const State& state = static_cast<const State&>(*_state);
+            const Implementation::TextLayerGlyphRun& run = state.glyphRuns[state.data[dataHandleId(handle)].glyphRun];
+            return stridedArrayView(state.glyphData).sliceSize(run.glyphOffset, run.glyphCount).slice(&Implementation::TextLayerGlyphData::glyphId);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* The shaper produces 22, 13, 97, ..., of which only 97 is in the cache.
+       Nothing gets filled, the missing glyphs are just remembered. */
+    DataHandle first = layer.create(0, "hello", {});
+    DataHandle second = layer.create(0, "hey", {});
+    CORRADE_COMPARE(font.filled.size(), 0);
+    CORRADE_COMPARE(layer.pendingGlyphCount(), 6);
+    CORRADE_COMPARE_AS(layer.glyphIds(first), Containers::arrayView({
+        0u, 0u, cache.glyphId(fontId, 97), 0u, 0u
+    }), TestSuite::Compare::Container);
+
+    /* Changing the text makes the original pending glyphs stale */
+    layer.setText(second, "ab", {});
+    CORRADE_COMPARE(layer.pendingGlyphCount(), 8);
+
+    /* Filling just a single glyph patches all its occurences and discards the
+       stale glyphs */
+    CORRADE_COMPARE(layer.fillPendingGlyphs(1), 1);
+    CORRADE_COMPARE_AS(font.filled, Containers::arrayView({22u}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(layer.pendingGlyphCount(), 3);
+    CORRADE_COMPARE_AS(layer.glyphIds(first), Containers::arrayView({
+        cache.glyphId(fontId, 22), 0u, cache.glyphId(fontId, 97), cache.glyphId(fontId, 22), 0u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(layer.glyphIds(second), Containers::arrayView({
+        cache.glyphId(fontId, 22), 0u
+    }), TestSuite::Compare::Container);
+
+    /* Filling the rest adds just the one remaining distinct glyph */
+    CORRADE_COMPARE(layer.fillPendingGlyphs(5), 1);
+    CORRADE_COMPARE_AS(font.filled, Containers::arrayView({22u, 13u}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(layer.pendingGlyphCount(), 0);
+    CORRADE_COMPARE_AS(layer.glyphIds(first), Containers::arrayView({
+        cache.glyphId(fontId, 22),
+        cache.glyphId(fontId, 13),
+        cache.glyphId(fontId, 97),
+        cache.glyphId(fontId, 22),
+        cache.glyphId(fontId, 13)
+    }), TestSuite::Compare::Container);
+
+    /* With nothing pending, it's a no-op */
+    CORRADE_COMPARE(layer.fillPendingGlyphs(5), 0);
+}
+
+void TextLayerTest::setColor() {
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Properties doProperties() override { return {}; }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<OneGlyphShaper>(*this); }
+    } font;
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
+    cache.addFont(67, &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}};
+    shared.setStyle(TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 1.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* Just to be sure the setters aren't picking up the first ever data
+       always */
+    layer.create(0, "", {});
+
+    /* There's nothing that would work differently for createGlyph() */
+    DataHandle data = layer.create(0, "", {});
+    CORRADE_COMPARE(layer.color(data), 0xffffffff_rgbaf);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+    /* Clear the state flags */
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Setting a color marks the layer as dirty */
+    layer.setColor(data, 0xaabbccdd_rgbaf);
+    CORRADE_COMPARE(layer.color(data), 0xaabbccdd_rgbaf);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+
+    /* Clear the state flags */
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.state(), LayerStates{});
+
+    /* Testing also the other overload */
+    layer.setColor(dataHandleData(data), 0x11223344_rgbaf);
+    CORRADE_COMPARE(layer.color(dataHandleData(data)), 0x11223344_rgbaf);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+}
+
+void TextLayerTest::setPadding() {
+    auto&& data = UpdateTextSetPaddingData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Properties doProperties() override { return {}; }
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<OneGlyphShaper>(*this); }
+    } font;
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
 
         Text::GlyphCacheFeatures doFeatures() const override { return {}; }
         void doSetImage(const Vector2i&, const ImageView2D&) override {}
@@ -10411,6 +11128,226 @@ void TextLayerTest::updateEmpty() {
     CORRADE_VERIFY(true);
 }
 
+void TextLayerTest::updateRecompactionThreshold() {
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 98};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<ThreeGlyphShaper>(*this); }
+
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
+    cache.addFont(font.glyphCount(), &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}
+        .setRecompactionThreshold(0.5f)
+    };
+    shared.setStyle(
+        TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 8.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* The ThreeGlyphShaper produces one glyph for each byte */
+    DataHandle first = layer.create(0, "aaaa", {});
+    DataHandle second = layer.create(0, "hello", {});
+    DataHandle third = layer.create(0, "bb", {});
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 3);
+    CORRADE_COMPARE(layer.stateData().glyphData.size(), 11);
+
+    /* Changing a color doesn't produce any unused runs, nothing changes */
+    layer.setColor(second, 0xff3366_rgbf);
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 3);
+    CORRADE_COMPARE(layer.stateData().glyphData.size(), 11);
+
+    /* Changing the first text makes 4 out of 15 glyphs unused, which is less
+       than the threshold, so the unused run is kept. The vertex data are
+       still sized to all glyph data. */
+    layer.setText(first, "aaaa", {});
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 4);
+    CORRADE_COMPARE(layer.stateData().glyphData.size(), 15);
+    CORRADE_COMPARE(layer.stateData().vertices.size(), 15*4*sizeof(Implementation::TextLayerVertex));
+    CORRADE_COMPARE(layer.glyphCount(first), 4);
+
+    /* Changing the second makes it 9 out of 20, still less than the
+       threshold */
+    layer.setText(second, "hello", {});
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().glyphRuns.size(), 5);
+    CORRADE_COMPARE(layer.stateData().glyphData.size(), 20);
+    CORRADE_COMPARE(layer.glyphCount(second), 5);
+
+    /* Changing the third makes it 11 out of 22, which finally triggers the
+       recompaction. The runs are now in order the texts were changed. */
+    layer.setText(third, "bb", {});
+    layer.update(LayerState::NeedsDataUpdate, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().glyphData.size(), 11);
+    CORRADE_COMPARE(layer.stateData().vertices.size(), 11*4*sizeof(Implementation::TextLayerVertex));
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().data).slice(&Implementation::TextLayerData::glyphRun), Containers::arrayView({
+        0u, 1u, 2u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().glyphRuns).slice(&Implementation::TextLayerGlyphRun::glyphOffset), Containers::arrayView({
+        0u, 4u, 9u
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(stridedArrayView(layer.stateData().glyphRuns).slice(&Implementation::TextLayerGlyphRun::glyphCount), Containers::arrayView({
+        4u, 5u, 2u
+    }), TestSuite::Compare::Container);
+}
+
+void TextLayerTest::updateDirtyRanges() {
+    /* Verifies that just the parts of the vertex and index data that got
+       regenerated are marked for upload by the GL implementation */
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {16.0f, 8.0f, -4.0f, 16.0f, 98};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override { return Containers::pointer<ThreeGlyphShaper>(*this); }
+
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 2}};
+    cache.addFont(font.glyphCount(), &font);
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{1}};
+    shared.setStyle(
+        TextLayerCommonStyleUniform{},
+        {TextLayerStyleUniform{}},
+        {shared.addFont(font, 8.0f, {})},
+        {Text::Alignment::MiddleCenter},
+        {}, {}, {}, {}, {}, {});
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared): TextLayer{handle, shared} {}
+
+        State& stateData() {
+            return static_cast<State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared};
+
+    /* Required to be called before update() (because AbstractUserInterface
+       guarantees the same on a higher level), not needed for anything here */
+    layer.setSize({1, 1}, {1, 1});
+
+    /* The ThreeGlyphShaper produces one glyph for each byte. The last text is
+       editable. */
+    layer.create(0, "aa", {}, nodeHandle(0, 1));
+    DataHandle second = layer.create(0, "hello", {}, nodeHandle(1, 1));
+    DataHandle third = layer.create(0, "bb", {}, TextDataFlag::Editable, nodeHandle(2, 1));
+
+    Vector2 nodeOffsets[3]{};
+    Vector2 nodeSizes[3]{};
+    Float nodeOpacities[3]{1.0f, 1.0f, 1.0f};
+    UnsignedByte nodesEnabledData[1]{};
+    Containers::BitArrayView nodesEnabled{nodesEnabledData, 0, 3};
+    constexpr std::size_t GlyphVertexSize = 4*sizeof(Implementation::TextLayerVertex);
+    UnsignedInt dataIds[]{0, 1, 2};
+
+    /* The initial update marks all vertices and indices */
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 0);
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 9*GlyphVertexSize);
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, 9*6*sizeof(UnsignedInt));
+
+    /* The GL implementation resets the ranges after upload */
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Changing a color of one data marks only its vertices and no indices,
+       even though it's a data update */
+    layer.setColor(second, 0xff3366_rgbf);
+    CORRADE_COMPARE(layer.state(), LayerState::NeedsDataUpdate);
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 2*GlyphVertexSize);
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 7*GlyphVertexSize);
+    CORRADE_VERIFY(layer.stateData().indexDirtyRange.isEmpty());
+    CORRADE_COMPARE(Containers::arrayCast<Implementation::TextLayerVertex>(layer.stateData().vertices)[2*4].color, 0xff3366ff_rgbaf);
+
+    layer.stateData().vertexDirtyRange.reset();
+
+    /* Changing an editable data updates everything, as the style could
+       affect presence of the cursor and selection quads */
+    layer.setColor(third, 0x3366ff_rgbf);
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.begin, 0);
+    CORRADE_COMPARE(layer.stateData().vertexDirtyRange.end, 9*GlyphVertexSize);
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, 9*6*sizeof(UnsignedInt));
+
+    layer.stateData().vertexDirtyRange.reset();
+    layer.stateData().indexDirtyRange.reset();
+
+    /* Changing a text together with a color updates everything as well */
+    layer.setColor(second, 0x3366ff_rgbf);
+    layer.setText(second, "hey", {});
+    layer.update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.begin, 0);
+    CORRADE_COMPARE(layer.stateData().indexDirtyRange.end, 7*6*sizeof(UnsignedInt));
+    CORRADE_VERIFY(!layer.stateData().vertexDirtyRange.isEmpty());
+}
+
 void TextLayerTest::updateCleanDataOrder() {
     auto&& data = UpdateCleanDataOrderData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -12351,6 +13288,153 @@ void TextLayerTest::updateTransformation() {
     }
 }
 
+void TextLayerTest::updateCompactVertices() {
+    auto&& data = UpdateCompactVerticesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Renders the same data with and without compact vertices and verifies
+       the compact output is the same as the regular one, just packed */
+
+    struct: Text::AbstractFont {
+        Text::FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doOpenFile(Containers::StringView, Float, UnsignedInt) override {
+            _opened = true;
+        }
+        Properties doProperties() override {
+            return {100.0f, 7.0f, -4.0f, 10000.0f, 1};
+        }
+        void doClose() override { _opened = false; }
+
+        void doGlyphIdsInto(const Containers::StridedArrayView1D<const char32_t>&, const Containers::StridedArrayView1D<UnsignedInt>&) override {}
+        Vector2 doGlyphSize(UnsignedInt) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<Text::AbstractShaper> doCreateShaper() override {
+            struct Shaper: Text::AbstractShaper {
+                explicit Shaper(Text::AbstractFont& font): Text::AbstractShaper{font} {}
+
+                UnsignedInt doShape(Containers::StringView text, UnsignedInt, UnsignedInt, Containers::ArrayView<const Text::FeatureRange>) override {
+                    return text.size();
+                }
+                void doGlyphIdsInto(const Containers::StridedArrayView1D<UnsignedInt>& ids) const override {
+                    for(std::size_t i = 0; i != ids.size(); ++i)
+                        ids[i] = i % 2;
+                }
+                void doGlyphOffsetsAdvancesInto(const Containers::StridedArrayView1D<Vector2>& offsets, const Containers::StridedArrayView1D<Vector2>& advances) const override {
+                    for(std::size_t i = 0; i != offsets.size(); ++i) {
+                        offsets[i] = {};
+                        advances[i] = {3.0f, 0.0f};
+                    }
+                }
+                void doGlyphClustersInto(const Containers::StridedArrayView1D<UnsignedInt>&) const override {
+                    CORRADE_FAIL("This shouldn't be called.");
+                }
+            };
+            return Containers::pointer<Shaper>(*this);
+        }
+
+        bool _opened = false;
+    } font;
+    font.openFile({}, {});
+
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{PixelFormat::R8Unorm, {32, 32, 3}, {}};
+    /* Glyphs in different layers to verify the layer gets propagated */
+    UnsignedInt fontId = cache.addFont(2, &font);
+    cache.addGlyph(fontId, 0, {}, 1, {{4, 8}, {12, 24}});
+    cache.addGlyph(fontId, 1, {}, 2, {{0, 3}, {7, 31}});
+
+    struct LayerShared: TextLayer::Shared {
+        explicit LayerShared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): TextLayer::Shared{glyphCache, configuration} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{cache, TextLayer::Shared::Configuration{3, 2}
+        .setFlags(data.sharedLayerFlags)
+    }, sharedCompact{cache, TextLayer::Shared::Configuration{3, 2}
+        .setFlags(data.sharedLayerFlags|TextLayerSharedFlag::CompactVertices)
+    };
+
+    struct Layer: TextLayer {
+        explicit Layer(LayerHandle handle, Shared& shared, TextLayerFlags flags): TextLayer{handle, shared, flags} {}
+
+        const State& stateData() const {
+            return static_cast<const State&>(*_state);
+        }
+    } layer{layerHandle(0, 1), shared, data.layerFlags},
+      layerCompact{layerHandle(1, 1), sharedCompact, data.layerFlags};
+
+    /* Two glyph runs with different style uniforms, one with a color that
+       gets clamped */
+    for(Layer* l: {&layer, &layerCompact}) {
+        LayerShared& s = static_cast<LayerShared&>(l->shared());
+        FontHandle fontHandle = s.addFont(font, 50.0f, {});
+        s.setStyle(TextLayerCommonStyleUniform{},
+            {TextLayerStyleUniform{}, TextLayerStyleUniform{}, TextLayerStyleUniform{}},
+            {2, 1},
+            {fontHandle, fontHandle},
+            {Text::Alignment::MiddleCenter, Text::Alignment::TopLeft},
+            {}, {}, {}, {}, {}, {});
+
+        l->setSize({1, 1}, {1, 1});
+        DataHandle first = l->create(0, "hello", {}, nodeHandle(0, 0x1));
+        DataHandle second = l->create(1, "hey", {}, nodeHandle(1, 0x1));
+        l->setColor(first, 0x3366ff_rgbf);
+        l->setColor(second, Color4{2.0f, 0.5f, -1.0f, 0.75f});
+        if(data.layerFlags >= TextLayerFlag::Transformable)
+            l->setTransformation(second, {1.5f, -3.0f}, 35.0_degf, 2.0f);
+
+        Vector2 nodeOffsets[]{{10.0f, 20.0f}, {-5.0f, 7.5f}};
+        Vector2 nodeSizes[]{{100.0f, 50.0f}, {20.0f, 30.0f}};
+        Float nodeOpacities[]{1.0f, 0.5f};
+        UnsignedByte nodesEnabledData[1]{};
+        Containers::BitArrayView nodesEnabled{nodesEnabledData, 0, 2};
+        UnsignedInt dataIds[]{0, 1};
+        l->update(LayerState::NeedsDataUpdate, dataIds, {}, {}, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, {}, {}, {}, {});
+    }
+
+    const bool distanceField = data.sharedLayerFlags >= TextLayerSharedFlag::DistanceField;
+    Containers::StridedArrayView1D<const Implementation::TextLayerVertex> vertices = distanceField ?
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerDistanceFieldVertex>(layer.stateData().vertices)).slice(&Implementation::TextLayerDistanceFieldVertex::vertex) :
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerVertex>(layer.stateData().vertices));
+    Containers::StridedArrayView1D<const Implementation::TextLayerCompactVertex> verticesCompact = distanceField ?
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerCompactDistanceFieldVertex>(layerCompact.stateData().vertices)).slice(&Implementation::TextLayerCompactDistanceFieldVertex::vertex) :
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerCompactVertex>(layerCompact.stateData().vertices));
+    CORRADE_COMPARE(vertices.size(), 8*4);
+    CORRADE_COMPARE(verticesCompact.size(), 8*4);
+
+    /* The compact format is half the size, or a bit more with distance
+       field */
+    CORRADE_COMPARE(layerCompact.stateData().vertices.size(),
+        distanceField ? 8*4*24 : 8*4*20);
+
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(verticesCompact[i].position, vertices[i].position);
+        CORRADE_COMPARE(verticesCompact[i].textureCoordinates, Math::pack<Vector2us>(vertices[i].textureCoordinates.xy()));
+        CORRADE_COMPARE(Float(verticesCompact[i].textureLayer), vertices[i].textureCoordinates.z());
+        CORRADE_COMPARE(verticesCompact[i].styleUniform, vertices[i].styleUniform);
+        CORRADE_COMPARE(verticesCompact[i].color, Math::pack<Color4ub>(Color4{Math::clamp(vertices[i].color, 0.0f, 1.0f)}));
+    }
+
+    /* Verify the layers, style and clamping also explicitly to not rely
+       only on the uncompressed implementation */
+    CORRADE_COMPARE(verticesCompact[0].textureLayer, 1);
+    CORRADE_COMPARE(verticesCompact[4].textureLayer, 2);
+    CORRADE_COMPARE(verticesCompact[0].styleUniform, 2);
+    CORRADE_COMPARE(verticesCompact[5*4].styleUniform, 1);
+    CORRADE_COMPARE(verticesCompact[5*4].color, (Color4ub{255, 64, 0, 96}));
+
+    if(distanceField) CORRADE_COMPARE_AS(
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerCompactDistanceFieldVertex>(layerCompact.stateData().vertices)).slice(&Implementation::TextLayerCompactDistanceFieldVertex::invertedRunScale),
+        stridedArrayView(Containers::arrayCast<const Implementation::TextLayerDistanceFieldVertex>(layer.stateData().vertices)).slice(&Implementation::TextLayerDistanceFieldVertex::invertedRunScale),
+        TestSuite::Compare::Container);
+}
+
 void TextLayerTest::updateNoStyleSet() {
     auto&& data = CreateLayoutUpdateNoStyleSetData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -32,6 +32,7 @@
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Compare/String.h>
 #include <Corrade/Utility/Format.h>
 #include <Magnum/PixelFormat.h>
@@ -71,6 +72,9 @@ struct ThemeTest: TestSuite::Tester {
     void textStyleDark();
     void layoutStyleDark();
 
+    void baseStyleTransition();
+    void textStyleTransition();
+
     void passwordFont();
     void passwordFontShape();
 
@@ -188,6 +192,9 @@ ThemeTest::ThemeTest() {
               &ThemeTest::textStyleDark,
               &ThemeTest::layoutStyleDark,
 
+              &ThemeTest::baseStyleTransition,
+              &ThemeTest::textStyleTransition,
+
               &ThemeTest::passwordFont});
 
     addInstancedTests({&ThemeTest::passwordFontShape},
@@ -394,6 +401,126 @@ void ThemeTest::layoutStyleDark() {
     CORRADE_COMPARE(Int(LayoutStyle::Count), Containers::arraySize(LayoutStyles));
 }
 
+void ThemeTest::baseStyleTransition() {
+    /* The theme precomputes the transition tables, which calls all transition
+       functions for all styles including the disabled ones that are never
+       transitioned from in practice. Verify the result is in bounds for each
+       and that transitioning a disabled style is a no-op. */
+    for(UnsignedInt i = 0; i != UnsignedInt(BaseStyle::Count); ++i) {
+        CORRADE_ITERATION(i);
+        const BaseStyle style = BaseStyle(i);
+        const BaseStyle disabled = Implementation::styleTransitionToDisabled(style);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToInactiveOut(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToInactiveOver(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToFocusedOut(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToFocusedOver(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToPressedOut(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToPressedOver(style)), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(disabled), UnsignedInt(BaseStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToDisabled(disabled)), UnsignedInt(disabled));
+        if(disabled != style) {
+            CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToInactiveOut(disabled)), UnsignedInt(disabled));
+            CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToPressedOver(disabled)), UnsignedInt(disabled));
+        }
+    }
+
+    /* Precomputing the tables the same way as the theme does shouldn't
+       assert */
+    struct BaseLayerShared: BaseLayer::Shared {
+        explicit BaseLayerShared(): BaseLayer::Shared{Configuration{UnsignedInt(BaseStyle::Count)}} {}
+
+        void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
+    } shared;
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        shared.setStyleTransition<BaseStyle,
+                Implementation::styleTransitionToInactiveOut,
+                Implementation::styleTransitionToInactiveOver,
+                Implementation::styleTransitionToFocusedOut,
+                Implementation::styleTransitionToFocusedOver,
+                Implementation::styleTransitionToPressedOut,
+                Implementation::styleTransitionToPressedOver,
+                Implementation::styleTransitionToDisabled>()
+            .precomputeStyleTransitionTables();
+    }
+    CORRADE_COMPARE(out, "");
+}
+
+void ThemeTest::textStyleTransition() {
+    /* Same as above, but for the text styles which additionally have the
+       blinking cursor variants */
+    for(UnsignedInt i = 0; i != UnsignedInt(TextStyle::Count); ++i) {
+        CORRADE_ITERATION(i);
+        const TextStyle style = TextStyle(i);
+        const TextStyle disabled = Implementation::styleTransitionToDisabled(style);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToInactiveOut(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToInactiveOver(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToFocusedOut(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToFocusedOver(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToPressedOut(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(Implementation::styleTransitionToPressedOver(style)), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE_AS(UnsignedInt(disabled), UnsignedInt(TextStyle::Count),
+            TestSuite::Compare::Less);
+        CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToDisabled(disabled)), UnsignedInt(disabled));
+        if(disabled != style) {
+            CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToInactiveOut(disabled)), UnsignedInt(disabled));
+            CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToPressedOver(disabled)), UnsignedInt(disabled));
+        }
+    }
+
+    /* The blinking cursor style transitions the same way as the focused
+       style */
+    CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToInactiveOut(TextStyle::InputDefaultFocusedBlink)), UnsignedInt(TextStyle::InputDefault));
+    CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToPressedOver(TextStyle::InputDefaultFocusedBlink)), UnsignedInt(TextStyle::InputDefaultPressed));
+    CORRADE_COMPARE(UnsignedInt(Implementation::styleTransitionToDisabled(TextStyle::InputDefaultFocusedBlink)), UnsignedInt(TextStyle::InputDefaultDisabled));
+
+    /* Precomputing the tables the same way as the theme does shouldn't
+       assert */
+    struct: Text::AbstractGlyphCache {
+        using Text::AbstractGlyphCache::AbstractGlyphCache;
+
+        Text::GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } glyphCache{PixelFormat::R8Unorm, {32, 32}};
+
+    struct TextLayerShared: TextLayer::Shared {
+        explicit TextLayerShared(Text::AbstractGlyphCache& glyphCache): TextLayer::Shared{glyphCache, Configuration{UnsignedInt(TextStyle::Count)}} {}
+
+        void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
+        void doSetEditingStyle(const TextLayerCommonEditingStyleUniform&, Containers::ArrayView<const TextLayerEditingStyleUniform>) override {}
+    } shared{glyphCache};
+
+    Containers::String out;
+    {
+        Error redirectError{&out};
+        shared.setStyleTransition<TextStyle,
+                Implementation::styleTransitionToInactiveOut,
+                Implementation::styleTransitionToInactiveOver,
+                Implementation::styleTransitionToFocusedOut,
+                Implementation::styleTransitionToFocusedOver,
+                Implementation::styleTransitionToPressedOut,
+                Implementation::styleTransitionToPressedOver,
+                Implementation::styleTransitionToDisabled>()
+            .precomputeStyleTransitionTables();
+    }
+    CORRADE_COMPARE(out, "");
+}
+
 void ThemeTest::passwordFont() {
     struct: Text::AbstractFont {
         Text::FontFeatures doFeatures() const override {
@@ -0,0 +1,422 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Function.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Compare/String.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/NodeFlags.h"
+#include "Magnum/Ui/Theme.h"
+#include "Magnum/Ui/VirtualList.h"
+#include "Magnum/Ui/Test/WidgetTester.hpp"
+
+namespace Magnum { namespace Ui { namespace Test { namespace {
+
+struct VirtualListTest: WidgetTester {
+    explicit VirtualListTest();
+
+    void construct();
+    void constructNonOwned();
+    void constructNoCreate();
+    void constructInvalid();
+
+    void setItemCount();
+    void setItemCountLessThanSlots();
+    void setOverscanRowCount();
+    void scroll();
+    void refresh();
+
+    void slotOutOfRange();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt columnCount;
+    ScrollAreaFlags flags;
+} ConstructData[]{
+    {"", 1, {}},
+    {"grid", 5, {}},
+    {"only Y", 1, ScrollAreaFlag::OnlyY},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt columnCount;
+    Float percentage;
+    std::size_t expectedBegin, expectedEnd;
+    Vector2 expectedFirstOffset;
+} ScrollData[]{
+    /* The UI is 1000 units high, items 20 units, so there's 50 rows covering
+       the UI, plus one for a partially visible row, plus one overscan row on
+       each side. The item count is 10000, the view 300 units, which gives
+       199700 scrollable units. */
+    {"list, 0%", 1, 0.0f,
+        0, 53, {}},
+    {"list, 50%", 1, 50.0f,
+        /* 99850/20 is row 4992.5, minus one overscan row */
+        4991, 4991 + 53, {0.0f, 4991*20.0f}},
+    {"list, 100%", 1, 100.0f,
+        /* 199700/20 is row 9985, minus one overscan row, then clamped to the
+           item count */
+        9984, 10000, {0.0f, 9984*20.0f}},
+    {"grid, 0%", 4, 0.0f,
+        0, 53*4, {}},
+    {"grid, 50%", 4, 50.0f,
+        /* 2500 rows, 49700 scrollable units, 24850/20 is row 1242.5 */
+        1241*4, 1241*4 + 53*4, {0.0f, 1241*20.0f}},
+    {"grid, 100%", 4, 100.0f,
+        /* 49700/20 is row 2485 */
+        2484*4, 10000, {0.0f, 2484*20.0f}},
+};
+
+VirtualListTest::VirtualListTest() {
+    addInstancedTests<VirtualListTest>({&VirtualListTest::construct},
+        Containers::arraySize(ConstructData),
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
+    addTests<VirtualListTest>({&VirtualListTest::constructNonOwned},
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
+    addTests<VirtualListTest>({&VirtualListTest::constructNoCreate},
+        &WidgetTester::setupNoCreate,
+        &WidgetTester::teardownNoCreate);
+
+    addTests<VirtualListTest>({&VirtualListTest::constructInvalid,
+                               &VirtualListTest::setItemCount,
+                               &VirtualListTest::setItemCountLessThanSlots,
+                               &VirtualListTest::setOverscanRowCount},
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
+    addInstancedTests<VirtualListTest>({&VirtualListTest::scroll},
+        Containers::arraySize(ScrollData),
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
+    addTests<VirtualListTest>({&VirtualListTest::refresh,
+                               &VirtualListTest::slotOutOfRange},
+        &WidgetTester::setup,
+        &WidgetTester::teardown);
+
+    /* Need the LayoutLayer populated with actual real paddings and min sizes,
+       same as in ScrollAreaTest */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(DarkTheme{}.apply(ui, ThemeFeature::LayoutLayer, {}));
+}
+
+void VirtualListTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::size_t createCalled = 0, bindCalled = 0;
+    VirtualList list{Anchor{root, {}, {320, 240}}, {100.0f, 20.0f}, data.columnCount, [&createCalled](std::size_t, const Anchor&) {
+        ++createCalled;
+    }, [&bindCalled](std::size_t, NodeHandle, std::size_t) {
+        ++bindCalled;
+    }, data.flags};
+    CORRADE_COMPARE(ui.nodeParent(list), root);
+    CORRADE_COMPARE(ui.nodeSize(list), (Vector2{320, 240}));
+    CORRADE_VERIFY(list.isOwned());
+    CORRADE_COMPARE(list.flags(), data.flags);
+    CORRADE_COMPARE(list.itemSize(), (Vector2{100.0f, 20.0f}));
+    CORRADE_COMPARE(list.columnCount(), data.columnCount);
+    CORRADE_COMPARE(list.itemCount(), 0);
+    CORRADE_COMPARE(list.overscanRowCount(), 1);
+    CORRADE_COMPARE(list.slotCount(), 0);
+    CORRADE_COMPARE(list.boundItemRange(), Containers::pair(std::size_t{}, std::size_t{}));
+
+    /* One storage for each scrollbar, one for the list */
+    CORRADE_COMPARE(ui.dataLayer().storageUsedCount(), data.flags >= ScrollAreaFlag::OnlyY ? 2 : 3);
+    CORRADE_COMPARE(ui.dataLayer().storageUsedAllocatedCount(), 1);
+
+    /* Updating with no items shouldn't create or bind anything and the
+       contents should be zero-size */
+    ui.update();
+    CORRADE_COMPARE(createCalled, 0);
+    CORRADE_COMPARE(bindCalled, 0);
+    CORRADE_COMPARE(list.slotCount(), 0);
+    CORRADE_COMPARE(ui.nodeSize(list.contentsNode()).y(), 0.0f);
+}
+
+void VirtualListTest::constructNonOwned() {
+    /* All the properties are verified in construct() above, check just that
+       it propagates all arguments properly */
+
+    VirtualList list{NonOwned, Anchor{root, {}, {32, 16}}, {10.0f, 4.0f}, 3, [](std::size_t, const Anchor&) {}, [](std::size_t, NodeHandle, std::size_t) {}, ScrollAreaFlags{0x80}};
+    CORRADE_COMPARE(ui.nodeParent(list), root);
+    CORRADE_COMPARE(ui.nodeSize(list), (Vector2{32, 16}));
+    CORRADE_VERIFY(!list.isOwned());
+
+    CORRADE_COMPARE(list.flags(), ScrollAreaFlags{0x80});
+    CORRADE_COMPARE(list.itemSize(), (Vector2{10.0f, 4.0f}));
+    CORRADE_COMPARE(list.columnCount(), 3);
+}
+
+void VirtualListTest::constructNoCreate() {
+    VirtualList list{NoCreate};
+    CORRADE_COMPARE(list.node(), NodeHandle::Null);
+    CORRADE_COMPARE(list.contentsNode(), NodeHandle::Null);
+    CORRADE_COMPARE(list.scrollYStorage(), StorageHandle::Null);
+}
+
+void VirtualListTest::constructInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Containers::String out;
+    Error redirectError{&out};
+    VirtualList{Anchor{root, {}, {32, 16}}, {10.0f, 4.0f}, 1, [](std::size_t, const Anchor&) {}, [](std::size_t, NodeHandle, std::size_t) {}, ScrollAreaFlag::OnlyX};
+    VirtualList{Anchor{root, {}, {32, 16}}, {10.0f, 0.0f}, 1, [](std::size_t, const Anchor&) {}, [](std::size_t, NodeHandle, std::size_t) {}};
+    VirtualList{Anchor{root, {}, {32, 16}}, {10.0f, 4.0f}, 0, [](std::size_t, const Anchor&) {}, [](std::size_t, NodeHandle, std::size_t) {}};
+    VirtualList{Anchor{root, {}, {32, 16}}, {10.0f, 4.0f}, 1, nullptr, [](std::size_t, NodeHandle, std::size_t) {}};
+    CORRADE_COMPARE_AS(out,
+        "Ui::VirtualList: Ui::ScrollAreaFlag::OnlyX is not supported\n"
+        "Ui::VirtualList: expected a positive item size, got {10, 0}\n"
+        "Ui::VirtualList: expected a non-zero column count\n"
+        "Ui::VirtualList: callbacks expected to be non-null\n",
+        TestSuite::Compare::String);
+}
+
+void VirtualListTest::setItemCount() {
+    Containers::Array<Containers::Pair<std::size_t, NodeHandle>> created;
+    Containers::Array<Containers::Pair<std::size_t, std::size_t>> bound;
+    VirtualList list{Anchor{root, {}, {320, 300}}, {100.0f, 20.0f}, 1, [&created](std::size_t slot, const Anchor& anchor) {
+        arrayAppend(created, InPlaceInit, slot, anchor.node());
+    }, [&bound](std::size_t slot, NodeHandle, std::size_t item) {
+        arrayAppend(bound, InPlaceInit, slot, item);
+    }};
+
+    /* A million items creates only as many slots as needed to cover the UI
+       height of 1000 units, plus one partially visible row and one overscan
+       row on each side */
+    list.setItemCount(1000000);
+    CORRADE_COMPARE(list.itemCount(), 1000000);
+    CORRADE_COMPARE(list.slotCount(), 53);
+    CORRADE_COMPARE(created.size(), 53);
+    CORRADE_COMPARE(bound.size(), 53);
+    for(std::size_t i = 0; i != 53; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(created[i].first(), i);
+        CORRADE_COMPARE(created[i].second(), list.slotNode(i));
+        CORRADE_COMPARE(ui.nodeParent(list.slotNode(i)), list.contentsNode());
+        CORRADE_COMPARE(ui.nodeSize(list.slotNode(i)), (Vector2{100.0f, 20.0f}));
+        CORRADE_COMPARE(ui.nodeOffset(list.slotNode(i)), (Vector2{0.0f, i*20.0f}));
+        CORRADE_COMPARE(ui.nodeFlags(list.slotNode(i)), NodeFlags{});
+        CORRADE_COMPARE(list.slotItem(i), i);
+        CORRADE_COMPARE(bound[i], Containers::pair(i, i));
+    }
+    CORRADE_COMPARE(list.boundItemRange(), Containers::pair(std::size_t{0}, std::size_t{53}));
+
+    /* Update resizes the contents to fit all items and calls the scroll
+       binding for the first time, which doesn't bind anything new */
+    ui.update();
+    CORRADE_COMPARE(ui.nodeSize(list.contentsNode()).y(), 20000000.0f);
+    CORRADE_COMPARE(bound.size(), 53);
+
+    /* Setting the same count again is a no-op */
+    list.setItemCount(1000000);
+    CORRADE_COMPARE(created.size(), 53);
+    CORRADE_COMPARE(bound.size(), 53);
+}
+
+void VirtualListTest::setItemCountLessThanSlots() {
+    std::size_t createCalled = 0;
+    Containers::Array<Containers::Pair<std::size_t, std::size_t>> bound;
+    VirtualList list{Anchor{root, {}, {320, 300}}, {100.0f, 20.0f}, 3, [&createCalled](std::size_t, const Anchor&) {
+        ++createCalled;
+    }, [&bound](std::size_t slot, NodeHandle, std::size_t item) {
+        arrayAppend(bound, InPlaceInit, slot, item);
+    }};
+
+    /* Creates only as many slots as there are items, laid out in a grid */
+    list.setItemCount(7);
+    CORRADE_COMPARE(list.slotCount(), 7);
+    CORRADE_COMPARE(createCalled, 7);
+    CORRADE_COMPARE(bound.size(), 7);
+    CORRADE_COMPARE(ui.nodeOffset(list.slotNode(4)), (Vector2{100.0f, 20.0f}));
+    CORRADE_COMPARE(ui.nodeOffset(list.slotNode(6)), (Vector2{0.0f, 40.0f}));
+
+    ui.update();
+    CORRADE_COMPARE(ui.nodeSize(list.contentsNode()).y(), 60.0f);
+
+    /* Making the count smaller hides the extra slots, the pool doesn't
+       shrink. Nothing gets rebound. */
+    list.setItemCount(4);
+    CORRADE_COMPARE(list.slotCount(), 7);
+    CORRADE_COMPARE(createCalled, 7);
+    CORRADE_COMPARE(bound.size(), 7);
+    CORRADE_COMPARE(list.boundItemRange(), Containers::pair(std::size_t{0}, std::size_t{4}));
+    CORRADE_COMPARE(list.slotItem(3), 3);
+    CORRADE_COMPARE(list.slotItem(4), ~std::size_t{});
+    CORRADE_COMPARE(list.slotItem(6), ~std::size_t{});
+    CORRADE_COMPARE(ui.nodeFlags(list.slotNode(3)), NodeFlags{});
+    CORRADE_COMPARE(ui.nodeFlags(list.slotNode(4)), NodeFlag::Hidden);
+    CORRADE_COMPARE(ui.nodeFlags(list.slotNode(6)), NodeFlag::Hidden);
+
+    ui.update();
+    CORRADE_COMPARE(ui.nodeSize(list.contentsNode()).y(), 40.0f);
+
+    /* Making it larger again unhides them and binds them again */
+    list.setItemCount(6);
+    CORRADE_COMPARE(list.slotCount(), 7);
+    CORRADE_COMPARE(createCalled, 7);
+    CORRADE_COMPARE(bound.size(), 9);
+    CORRADE_COMPARE(bound[7], Containers::pair(std::size_t{4}, std::size_t{4}));
+    CORRADE_COMPARE(bound[8], Containers::pair(std::size_t{5}, std::size_t{5}));
+    CORRADE_COMPARE(ui.nodeFlags(list.slotNode(5)), NodeFlags{});
+    CORRADE_COMPARE(ui.nodeFlags(list.slotNode(6)), NodeFlag::Hidden);
+}
+
+void VirtualListTest::setOverscanRowCount() {
+    std::size_t createCalled = 0;
+    VirtualList list{Anchor{root, {}, {320, 300}}, {100.0f, 20.0f}, 2, [&createCalled](std::size_t, const Anchor&) {
+        ++createCalled;
+    }, [](std::size_t, NodeHandle, std::size_t) {}};
+    list.setItemCount(1000);
+    CORRADE_COMPARE(list.slotCount(), 53*2);
+    CORRADE_COMPARE(createCalled, 53*2);
+
+    /* Three more rows on each side */
+    list.setOverscanRowCount(4);
+    CORRADE_COMPARE(list.overscanRowCount(), 4);
+    CORRADE_COMPARE(list.slotCount(), 59*2);
+    CORRADE_COMPARE(createCalled, 59*2);
+
+    /* Making it smaller doesn't shrink the pool */
+    list.setOverscanRowCount(0);
+    CORRADE_COMPARE(list.overscanRowCount(), 0);
+    CORRADE_COMPARE(list.slotCount(), 59*2);
+    CORRADE_COMPARE(createCalled, 59*2);
+}
+
+void VirtualListTest::scroll() {
+    auto&& data = ScrollData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Containers::Pair<std::size_t, std::size_t>> bound;
+    VirtualList list{Anchor{root, {}, {400, 300}}, {100.0f, 20.0f}, data.columnCount, [](std::size_t, const Anchor&) {}, [&bound](std::size_t slot, NodeHandle, std::size_t item) {
+        arrayAppend(bound, InPlaceInit, slot, item);
+    }, ScrollAreaFlag::OnlyY};
+    list.setItemCount(10000);
+    CORRADE_COMPARE(list.slotCount(), 53*data.columnCount);
+
+    /* First update to populate the view size, after that it's possible to
+       scroll */
+    ui.update();
+    list.scrollToPercentageY(data.percentage);
+    arrayResize(bound, 0);
+    ui.update();
+
+    CORRADE_COMPARE(list.boundItemRange(), Containers::pair(data.expectedBegin, data.expectedEnd));
+    CORRADE_COMPARE(ui.nodeOffset(list.slotNode(data.expectedBegin % list.slotCount())), data.expectedFirstOffset);
+
+    /* Every slot has the item in range or is hidden */
+    for(std::size_t i = 0; i != list.slotCount(); ++i) {
+        CORRADE_ITERATION(i);
+        const std::size_t item = list.slotItem(i);
+        if(item == ~std::size_t{}) {
+            CORRADE_COMPARE(ui.nodeFlags(list.slotNode(i)), NodeFlag::Hidden);
+            continue;
+        }
+        CORRADE_COMPARE_AS(item, data.expectedBegin, TestSuite::Compare::GreaterOrEqual);
+        CORRADE_COMPARE_AS(item, data.expectedEnd, TestSuite::Compare::Less);
+        CORRADE_COMPARE(item % list.slotCount(), i);
+        CORRADE_COMPARE(ui.nodeFlags(list.slotNode(i)), NodeFlags{});
+    }
+
+    /* Scrolling by exactly one row down from the middle rebinds only one row
+       of items. Not testing this at the ends, where the overscan or the item
+       count gets clamped. */
+    if(data.percentage == 50.0f) {
+        arrayResize(bound, 0);
+        list.scrollToPercentageY(data.percentage + 2000.0f/(10000/data.columnCount*20.0f - 300.0f));
+        ui.update();
+        CORRADE_COMPARE(bound.size(), data.columnCount);
+        CORRADE_COMPARE(list.boundItemRange(), Containers::pair(data.expectedBegin + data.columnCount, data.expectedEnd + data.columnCount));
+    }
+}
+
+void VirtualListTest::refresh() {
+    Containers::Array<Containers::Pair<std::size_t, std::size_t>> bound;
+    VirtualList list{Anchor{root, {}, {320, 300}}, {100.0f, 20.0f}, 1, [](std::size_t, const Anchor&) {}, [&bound](std::size_t slot, NodeHandle, std::size_t item) {
+        arrayAppend(bound, InPlaceInit, slot, item);
+    }};
+    list.setItemCount(5);
+    list.setItemCount(3);
+    CORRADE_COMPARE(bound.size(), 5);
+
+    /* Rebinds all bound slots, skipping the hidden ones */
+    arrayResize(bound, 0);
+    list.refresh();
+    CORRADE_COMPARE_AS(bound, (Containers::arrayView<Containers::Pair<std::size_t, std::size_t>>({
+        {0, 0},
+        {1, 1},
+        {2, 2},
+    })), TestSuite::Compare::Container);
+
+    /* With the UI made larger, the refresh creates new slots and binds items
+       to them. Each slot is bound exactly once, not once for the new item and
+       then again for being bound. */
+    list.setItemCount(100);
+    CORRADE_COMPARE(list.slotCount(), 53);
+    ui.setSize({1000, 1100});
+    arrayResize(bound, 0);
+    list.refresh();
+    CORRADE_COMPARE(list.slotCount(), 58);
+    CORRADE_COMPARE(bound.size(), 58);
+    for(std::size_t i = 0; i != bound.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(bound[i], Containers::pair(i, i));
+    }
+
+    /* Restore the original size for other tests */
+    ui.setSize({1000, 1000});
+}
+
+void VirtualListTest::slotOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    VirtualList list{Anchor{root, {}, {320, 300}}, {100.0f, 20.0f}, 1, [](std::size_t, const Anchor&) {}, [](std::size_t, NodeHandle, std::size_t) {}};
+    list.setItemCount(3);
+
+    Containers::String out;
+    Error redirectError{&out};
+    list.slotNode(3);
+    list.slotItem(3);
+    CORRADE_COMPARE_AS(out,
+        "Ui::VirtualList::slotNode(): index 3 out of range for 3 slots\n"
+        "Ui::VirtualList::slotItem(): index 3 out of range for 3 slots\n",
+        TestSuite::Compare::String);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Ui::Test::VirtualListTest)
@@ -82,7 +82,9 @@ struct TestBaseLayerShared: BaseLayer::Shared {
             Implementation::styleTransitionToFocusedOver,
             Implementation::styleTransitionToPressedOut,
             Implementation::styleTransitionToPressedOver,
-            Implementation::styleTransitionToDisabled>();
+            Implementation::styleTransitionToDisabled>()
+            /* Same as done by the theme */
+            .precomputeStyleTransitionTables();
     }
 
     void doSetStyle(const BaseLayerCommonStyleUniform&, Containers::ArrayView<const BaseLayerStyleUniform>) override {}
@@ -117,7 +119,9 @@ struct TestTextLayerShared: TextLayer::Shared {
             Implementation::styleTransitionToFocusedOver,
             Implementation::styleTransitionToPressedOut,
             Implementation::styleTransitionToPressedOver,
-            Implementation::styleTransitionToDisabled>();
+            Implementation::styleTransitionToDisabled>()
+            /* Same as done by the theme */
+            .precomputeStyleTransitionTables();
     }
 
     void doSetStyle(const TextLayerCommonStyleUniform&, Containers::ArrayView<const TextLayerStyleUniform>) override {}
@@ -29,6 +29,15 @@ struct StyleEntry {
     mediump vec4 cornerRadiusReserved;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 1
@@ -36,6 +45,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #define style_smoothness smoothnessReserved.x
@@ -50,12 +62,19 @@ uniform highp vec3 projection; /* xy = UI size to unit square scaling,
 flat in mediump vec2 halfQuadSize;
 NOPERSPECTIVE in mediump vec2 interpolatedCenterDistance;
 flat in lowp float interpolatedOpacity;
+#ifndef SHADER_STYLE_ANIMATION
 flat in mediump uint interpolatedStyle;
+#define styleValue(member) styles[interpolatedStyle].member
+#else
+flat in mediump uvec2 interpolatedStyles; /* source, target */
+flat in mediump float interpolatedStyleFactor;
+#define styleValue(member) mix(styles[interpolatedStyles.x].member, styles[interpolatedStyles.y].member, interpolatedStyleFactor)
+#endif
 
 out lowp vec4 fragmentColor;
 
 void main() {
-    mediump float radius = styles[interpolatedStyle].style_cornerRadius;
+    mediump float radius = styleValue(style_cornerRadius);
 
     /* Is (0, 0) in centers of corner radii, positive in corners, negative at
        the edges */
@@ -72,5 +91,5 @@ void main() {
 
     /* Final color */
     lowp float smoothness = style_smoothness*projection.z;
-    fragmentColor = smoothstep(-smoothness, +smoothness, edgeDistance)*styles[interpolatedStyle].backgroundColor*interpolatedOpacity;
+    fragmentColor = smoothstep(-smoothness, +smoothness, edgeDistance)*styleValue(backgroundColor)*interpolatedOpacity;
 }
@@ -29,6 +29,15 @@ struct StyleEntry {
     mediump vec4 cornerRadiusReserved;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 1
@@ -36,6 +45,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #define style_smoothness smoothnessReserved.x
@@ -54,7 +66,12 @@ layout(location = 3) in mediump uint style;
 flat out mediump vec2 halfQuadSize;
 NOPERSPECTIVE out mediump vec2 interpolatedCenterDistance;
 flat out lowp float interpolatedOpacity;
+#ifndef SHADER_STYLE_ANIMATION
 flat out mediump uint interpolatedStyle;
+#else
+flat out mediump uvec2 interpolatedStyles; /* source, target */
+flat out mediump float interpolatedStyleFactor;
+#endif
 
 void main() {
     /* Expand the quad by the smoothness radius to avoid the edges looking cut
@@ -65,7 +82,24 @@ void main() {
     halfQuadSize = abs(centerDistance);
     interpolatedCenterDistance = centerDistance + smoothnessExpansion;
     interpolatedOpacity = opacity;
+    #ifndef SHADER_STYLE_ANIMATION
     interpolatedStyle = style;
+    #else
+    /* Dynamic styles reference a source and target style to interpolate
+       between, which is the dynamic style itself if it's not animated. Other
+       styles are used as-is. */
+    mediump uint sourceStyle = style;
+    mediump uint targetStyle = style;
+    mediump float styleFactor = 0.0;
+    if(style >= uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT)) {
+        mediump uint dynamicStyle = style - uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT);
+        sourceStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.x;
+        targetStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.y;
+        styleFactor = styleInterpolations[dynamicStyle].factor;
+    }
+    interpolatedStyles = uvec2(sourceStyle, targetStyle);
+    interpolatedStyleFactor = styleFactor;
+    #endif
 
     /* The projection scales from UI size to the 2x2 unit square and Y-flips,
        the (-1, 1) then translates the origin from top left to center */
@@ -26,8 +26,9 @@
 
 #include "TextLayer.h"
 
+#include <cstring> /* std::memcmp(), std::memcpy(), std::memmove() */
 #include <Corrade/Containers/Array.h>
-#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/BitArray.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Iterable.h>
@@ -39,6 +40,7 @@
 #include <Corrade/Utility/Unicode.h>
 #include <Magnum/Math/Functions.h>
 #include <Magnum/Math/Matrix3.h>
+#include <Magnum/Math/Packing.h>
 #include <Magnum/Math/Swizzle.h>
 #include <Magnum/Math/Time.h>
 #include <Magnum/Text/AbstractGlyphCache.h>
@@ -50,6 +52,7 @@
 #include "Magnum/Ui/Event.h"
 #include "Magnum/Ui/Handle.h"
 #include "Magnum/Ui/TextProperties.h"
+#include "Magnum/Ui/Implementation/textLayerGlyphVertices.h"
 #include "Magnum/Ui/Implementation/textLayerState.h"
 
 namespace Magnum { namespace Ui {
@@ -141,6 +144,10 @@ Debug& operator<<(Debug& debug, const TextLayerSharedFlag value) {
         /* LCOV_EXCL_START */
         #define _c(value) case TextLayerSharedFlag::value: return debug << "::" #value;
         _c(DistanceField)
+        _c(FillGlyphCacheDeferred)
+        _c(FillGlyphCacheOnDemand)
+        _c(CompactVertices)
+        _c(ShaderStyleAnimation)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -150,17 +157,258 @@ Debug& operator<<(Debug& debug, const TextLayerSharedFlag value) {
 
 Debug& operator<<(Debug& debug, const TextLayerSharedFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Ui::TextLayerSharedFlags{}", {
-        TextLayerSharedFlag::DistanceField
+        TextLayerSharedFlag::DistanceField,
+        /* Implies FillGlyphCacheOnDemand, has to be before */
+        TextLayerSharedFlag::FillGlyphCacheDeferred,
+        TextLayerSharedFlag::FillGlyphCacheOnDemand,
+        TextLayerSharedFlag::CompactVertices,
+        TextLayerSharedFlag::ShaderStyleAnimation
     });
 }
 
-TextLayer::Shared::State::State(Shared& self, Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): AbstractVisualLayer::Shared::State{self, configuration.styleCount(), configuration.dynamicStyleCount()}, hasEditingStyles{configuration.hasEditingStyles()}, flags{configuration.flags()}, styleUniformCount{configuration.styleUniformCount()}, editingStyleUniformCount{configuration.editingStyleUniformCount()}, glyphCache(glyphCache) {
+namespace {
+
+/* FNV-1a, the keys are mostly short enough for anything more elaborate to not
+   make a difference */
+UnsignedLong shapeCacheHash(const Containers::ArrayView<const char> data) {
+    UnsignedLong hash = 0xcbf29ce484222325ull;
+    for(const char c: data) {
+        hash ^= UnsignedByte(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+template<class T> char* shapeCacheKeyWrite(char* const out, const T& value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+char* shapeCacheKeyWrite(char* const out, const Containers::StringView value) {
+    Utility::copy(Containers::arrayView(value.data(), value.size()), Containers::arrayView(out, value.size()));
+    return out + value.size();
+}
+
+/* Serializes everything that affects the shaping result into cache.key and
+   returns its hash. The font handle implies the font size and glyph cache
+   font ID as well, fonts can't be removed so a handle can't be reused for a
+   different font either. The text is last so its size doesn't need to be
+   stored, the language size is stored to not have it ambiguous with the text
+   that follows. */
+UnsignedLong shapeCacheKey(Implementation::TextLayerShapeCache& cache, const FontHandle font, const Text::Alignment alignment, const TextProperties& properties, const Containers::ArrayView<const Text::FeatureRange> features, const Containers::StringView text) {
+    const Containers::StringView language = properties.language();
+    arrayResize(cache.key, NoInit,
+        sizeof(FontHandle) +
+        sizeof(Text::Script) +
+        sizeof(Text::ShapeDirection) +
+        sizeof(Text::LayoutDirection) +
+        sizeof(Text::Alignment) +
+        2*sizeof(UnsignedInt) +
+        features.size()*(sizeof(Text::Feature) + 3*sizeof(UnsignedInt)) +
+        language.size() +
+        text.size());
+
+    char* out = cache.key.data();
+    out = shapeCacheKeyWrite(out, font);
+    out = shapeCacheKeyWrite(out, properties.script());
+    out = shapeCacheKeyWrite(out, properties.shapeDirection());
+    out = shapeCacheKeyWrite(out, properties.layoutDirection());
+    out = shapeCacheKeyWrite(out, alignment);
+    out = shapeCacheKeyWrite(out, UnsignedInt(language.size()));
+    out = shapeCacheKeyWrite(out, UnsignedInt(features.size()));
+    for(const Text::FeatureRange& feature: features) {
+        out = shapeCacheKeyWrite(out, feature.feature());
+        out = shapeCacheKeyWrite(out, feature.value());
+        out = shapeCacheKeyWrite(out, feature.begin());
+        out = shapeCacheKeyWrite(out, feature.end());
+    }
+    out = shapeCacheKeyWrite(out, language);
+    out = shapeCacheKeyWrite(out, text);
+    CORRADE_INTERNAL_DEBUG_ASSERT(out == cache.key.end());
+
+    return shapeCacheHash(cache.key);
+}
+
+/* Returns ID of an entry matching cache.key or ~0 if there's none. As the
+   bucket count is at least twice the entry count, there's always an empty
+   bucket terminating the probe sequence. */
+UnsignedInt shapeCacheFind(const Implementation::TextLayerShapeCache& cache, const UnsignedLong hash) {
+    const std::size_t mask = cache.buckets.size() - 1;
+    for(std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+        const UnsignedInt id = cache.buckets[i];
+        if(id == ~UnsignedInt{})
+            return ~UnsignedInt{};
+
+        const Implementation::TextLayerShapeCacheEntry& entry = cache.entries[id];
+        if(entry.hash == hash && entry.key.size() == cache.key.size() && std::memcmp(entry.key.data(), cache.key.data(), cache.key.size()) == 0)
+            return id;
+    }
+}
+
+void shapeCacheUnlink(Implementation::TextLayerShapeCache& cache, const UnsignedInt id) {
+    const Implementation::TextLayerShapeCacheEntry& entry = cache.entries[id];
+    if(entry.previous != ~UnsignedInt{})
+        cache.entries[entry.previous].next = entry.next;
+    else
+        cache.mostRecent = entry.next;
+    if(entry.next != ~UnsignedInt{})
+        cache.entries[entry.next].previous = entry.previous;
+    else
+        cache.leastRecent = entry.previous;
+}
+
+void shapeCacheLinkMostRecent(Implementation::TextLayerShapeCache& cache, const UnsignedInt id) {
+    Implementation::TextLayerShapeCacheEntry& entry = cache.entries[id];
+    entry.previous = ~UnsignedInt{};
+    entry.next = cache.mostRecent;
+    if(cache.mostRecent != ~UnsignedInt{})
+        cache.entries[cache.mostRecent].previous = id;
+    else
+        cache.leastRecent = id;
+    cache.mostRecent = id;
+}
+
+void shapeCacheUse(Implementation::TextLayerShapeCache& cache, const UnsignedInt id) {
+    if(cache.mostRecent == id)
+        return;
+    shapeCacheUnlink(cache, id);
+    shapeCacheLinkMostRecent(cache, id);
+}
+
+/* Adds an entry for the key currently in cache.key, which is assumed to not
+   be present in the cache yet, evicting the least recently used entry if the
+   cache is full. The caller is expected to fill in the shaping results. */
+Implementation::TextLayerShapeCacheEntry& shapeCacheInsert(Implementation::TextLayerShapeCache& cache, const UnsignedLong hash) {
+    const std::size_t mask = cache.buckets.size() - 1;
+
+    UnsignedInt id;
+    if(cache.usedCount < cache.entries.size())
+        id = cache.usedCount++;
+    else {
+        id = cache.leastRecent;
+        shapeCacheUnlink(cache, id);
+
+        /* Find the bucket referencing the evicted entry and remove it. To
+           not terminate probe sequences of other entries prematurely, the
+           following entries that would be reachable from the hole get shifted
+           back into it. */
+        std::size_t i = cache.entries[id].hash & mask;
+        while(cache.buckets[i] != id)
+            i = (i + 1) & mask;
+        for(std::size_t j = (i + 1) & mask; cache.buckets[j] != ~UnsignedInt{}; j = (j + 1) & mask) {
+            const std::size_t ideal = cache.entries[cache.buckets[j]].hash & mask;
+            if(((j - ideal) & mask) >= ((j - i) & mask)) {
+                cache.buckets[i] = cache.buckets[j];
+                i = j;
+            }
+        }
+        cache.buckets[i] = ~UnsignedInt{};
+    }
+
+    Implementation::TextLayerShapeCacheEntry& entry = cache.entries[id];
+    arrayResize(entry.key, NoInit, cache.key.size());
+    Utility::copy(cache.key, entry.key);
+    entry.hash = hash;
+
+    std::size_t i = hash & mask;
+    while(cache.buckets[i] != ~UnsignedInt{})
+        i = (i + 1) & mask;
+    cache.buckets[i] = id;
+
+    shapeCacheLinkMostRecent(cache, id);
+    return entry;
+}
+
+void shapeCacheClear(Implementation::TextLayerShapeCache& cache) {
+    /* The entries are kept to reuse their allocations */
+    for(UnsignedInt& i: cache.buckets)
+        i = ~UnsignedInt{};
+    cache.usedCount = 0;
+    cache.mostRecent = cache.leastRecent = ~UnsignedInt{};
+}
+
+/* Used by TextLayerSharedFlag::FillGlyphCacheOnDemand. The rendered glyph
+   data contain only glyph cache IDs, which are 0 for glyphs not present in the
+   cache. If there are any, the text is shaped again line by line, the same way
+   the renderer does, to get the font-specific IDs, which are then in the same
+   order as the rendered glyphs. Returns an empty array if nothing is
+   missing. */
+Containers::Array<UnsignedInt> missingGlyphFontIds(Text::AbstractShaper& shaper, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds, const Containers::StringView text, const Containers::ArrayView<const Text::FeatureRange> features) {
+    /* Most of the time everything is in the cache already */
+    bool anyMissing = false;
+    for(const UnsignedInt glyphId: glyphIds) if(!glyphId) {
+        anyMissing = true;
+        break;
+    }
+    if(!anyMissing)
+        return {};
+
+    Containers::Array<UnsignedInt> fontGlyphIds;
+    for(std::size_t begin = 0; begin <= text.size(); ) {
+        const std::size_t end = text.exceptPrefix(begin).findOr('\n', text.end()).begin() - text.begin();
+        shaper.glyphIdsInto(arrayAppend(fontGlyphIds, NoInit, shaper.shape(text, begin, end, features)));
+        begin = end + 1;
+    }
+
+    return fontGlyphIds;
+}
+
+/* Puts glyphs from `fontGlyphIds` that aren't in the cache yet there. Returns
+   true if any glyphs were added, if filling the cache fails, the font is
+   marked as such to not attempt to fill it again. */
+bool fillGlyphCacheOnDemand(Text::AbstractGlyphCache& glyphCache, Implementation::TextLayerFont& fontState, const Containers::ArrayView<const UnsignedInt> fontGlyphIds) {
+    Containers::BitArray collected{ValueInit, fontState.font->glyphCount()};
+    Containers::Array<UnsignedInt> missing;
+    for(const UnsignedInt glyphId: fontGlyphIds) {
+        if(collected[glyphId] || glyphCache.glyphId(fontState.glyphCacheFontId, glyphId))
+            continue;
+        collected.set(glyphId);
+        arrayAppend(missing, glyphId);
+    }
+
+    if(missing.isEmpty())
+        return false;
+    if(!fontState.font->fillGlyphCache(glyphCache, missing)) {
+        fontState.glyphCacheFull = true;
+        return false;
+    }
+
+    return true;
+}
+
+/* Used by doUpdate() if TextLayerSharedFlag::CompactVertices is enabled. The
+   texture layer is an exact integer stored in a float, so it can be converted
+   without rounding. */
+void packGlyphVertices(const Containers::StridedArrayView1D<const Implementation::TextLayerVertex>& vertices, const Containers::StridedArrayView1D<Implementation::TextLayerCompactVertex>& compactVertices) {
+    CORRADE_INTERNAL_DEBUG_ASSERT(vertices.size() == compactVertices.size());
+    for(std::size_t i = 0, max = vertices.size(); i != max; ++i) {
+        const Implementation::TextLayerVertex& vertex = vertices[i];
+        Implementation::TextLayerCompactVertex& compactVertex = compactVertices[i];
+        compactVertex.position = vertex.position;
+        compactVertex.textureCoordinates = Math::pack<Vector2us>(vertex.textureCoordinates.xy());
+        compactVertex.textureLayer = UnsignedShort(vertex.textureCoordinates.z());
+        compactVertex.styleUniform = UnsignedShort(vertex.styleUniform);
+        compactVertex.color = Math::pack<Color4ub>(Color4{Math::clamp(vertex.color, 0.0f, 1.0f)});
+    }
+}
+
+}
+
+TextLayer::Shared::State::State(Shared& self, Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): AbstractVisualLayer::Shared::State{self, configuration.styleCount(), configuration.dynamicStyleCount()}, hasEditingStyles{configuration.hasEditingStyles()}, flags{configuration.flags()}, styleUniformCount{configuration.styleUniformCount()}, editingStyleUniformCount{configuration.editingStyleUniformCount()}, recompactionThreshold{configuration.recompactionThreshold()}, glyphCache(glyphCache) {
     styleStorage = Containers::ArrayTuple{
         {NoInit, configuration.styleCount(), styles},
         {NoInit, configuration.dynamicStyleCount() ? configuration.styleUniformCount() : 0, styleUniforms},
         {NoInit, configuration.editingStyleCount(), editingStyles},
         {NoInit, configuration.dynamicStyleCount() ? configuration.editingStyleUniformCount() : 0, editingStyleUniforms},
     };
+
+    if(const UnsignedInt shapeCacheSize = configuration.shapeCacheSize()) {
+        std::size_t bucketCount = 1;
+        while(bucketCount < 2*std::size_t{shapeCacheSize})
+            bucketCount <<= 1;
+        shapeCache.entries = Containers::Array<Implementation::TextLayerShapeCacheEntry>{ValueInit, shapeCacheSize};
+        shapeCache.buckets = Containers::Array<UnsignedInt>{DirectInit, bucketCount, ~UnsignedInt{}};
+    }
 }
 
 TextLayer::Shared::Shared(Containers::Pointer<State>&& state): AbstractVisualLayer::Shared{Utility::move(state)} {
@@ -169,6 +417,11 @@ TextLayer::Shared::Shared(Containers::Pointer<State>&& state): AbstractVisualLay
     #endif
     CORRADE_ASSERT(s.styleCount + s.dynamicStyleCount,
         "Ui::TextLayer::Shared: expected non-zero total style count", );
+    /* Keep the uniform count in sync with TextLayerGL::Shared::State */
+    CORRADE_ASSERT(!(s.flags >= TextLayerSharedFlag::CompactVertices) || s.styleUniformCount + s.dynamicStyleCount*(s.hasEditingStyles ? 3 : 1) <= 65536,
+        "Ui::TextLayer::Shared: expected at most 65536 style uniforms with" << TextLayerSharedFlag::CompactVertices << "but got" << s.styleUniformCount + s.dynamicStyleCount*(s.hasEditingStyles ? 3 : 1), );
+    CORRADE_ASSERT(!(s.flags >= TextLayerSharedFlag::CompactVertices) || s.glyphCache.size().z() <= 65536,
+        "Ui::TextLayer::Shared: expected at most 65536 glyph cache layers with" << TextLayerSharedFlag::CompactVertices << "but got" << s.glyphCache.size().z(), );
 }
 
 TextLayer::Shared::Shared(Text::AbstractGlyphCache& glyphCache, const Configuration& configuration): Shared{Containers::pointer<State>(*this, glyphCache, configuration)} {}
@@ -203,6 +456,30 @@ const Text::AbstractGlyphCache& TextLayer::Shared::glyphCache() const {
     return static_cast<const State&>(*_state).glyphCache;
 }
 
+Float TextLayer::Shared::recompactionThreshold() const {
+    return static_cast<const State&>(*_state).recompactionThreshold;
+}
+
+UnsignedInt TextLayer::Shared::shapeCacheSize() const {
+    return static_cast<const State&>(*_state).shapeCache.entries.size();
+}
+
+UnsignedInt TextLayer::Shared::shapeCacheUsedCount() const {
+    return static_cast<const State&>(*_state).shapeCache.usedCount;
+}
+
+std::size_t TextLayer::Shared::shapeCacheHitCount() const {
+    return static_cast<const State&>(*_state).shapeCache.hitCount;
+}
+
+std::size_t TextLayer::Shared::shapeCacheMissCount() const {
+    return static_cast<const State&>(*_state).shapeCache.missCount;
+}
+
+void TextLayer::Shared::clearShapeCache() {
+    shapeCacheClear(static_cast<State&>(*_state).shapeCache);
+}
+
 std::size_t TextLayer::Shared::fontCount() const {
     return static_cast<const State&>(*_state).fonts.size();
 }
@@ -279,7 +556,7 @@ FontHandle TextLayer::Shared::addFontInternal(
     Containers::Array<UnsignedInt> glyphMappingArray{NoInit, glyphMapping.size()};
     Utility::copy(glyphMapping, glyphMappingArray);
 
-    arrayAppend(state.fonts, InPlaceInit, nullptr, font, nullptr, scale, glyphCacheFontId, Utility::move(glyphMappingArray));
+    arrayAppend(state.fonts, InPlaceInit, nullptr, font, nullptr, scale, glyphCacheFontId, Utility::move(glyphMappingArray), false);
     return fontHandle(state.fonts.size() - 1, 1);
 }
 
@@ -555,11 +832,21 @@ TextLayer::Shared::Configuration& TextLayer::Shared::Configuration::setDynamicSt
     return *this;
 }
 
+TextLayer::Shared::Configuration& TextLayer::Shared::Configuration::setRecompactionThreshold(const Float threshold) {
+    CORRADE_ASSERT(threshold >= 0.0f && threshold <= 1.0f,
+        "Ui::TextLayer::Shared::Configuration::setRecompactionThreshold(): expected a value in the [0, 1] range, got" << threshold, *this);
+    _recompactionThreshold = threshold;
+    return *this;
+}
+
 TextLayer::State::State(Shared::State& shared, const TextLayerFlags flags):
     AbstractVisualLayer::State{shared},
     styleUpdateStamp{shared.styleUpdateStamp},
     editingStyleUpdateStamp{shared.editingStyleUpdateStamp},
     flags{flags},
+    fillGlyphVertexColorStyle{Implementation::fillGlyphVertexColorStyleImplementation(Cpu::runtimeFeatures())},
+    translateGlyphVertexPositions{Implementation::translateGlyphVertexPositionsImplementation(Cpu::runtimeFeatures())},
+    transformGlyphVertexPositions{Implementation::transformGlyphVertexPositionsImplementation(Cpu::runtimeFeatures())},
     /* These get created below, just to not have to do nasty things to
        deduplicate allocator lambda definitions */
     renderer{NoCreate},
@@ -577,8 +864,23 @@ TextLayer::State::State(Shared::State& shared, const TextLayerFlags flags):
            style */
         {ValueInit, shared.hasEditingStyles ? shared.dynamicStyleCount*2 : 0, dynamicEditingStyleUniforms},
         {ValueInit, shared.hasEditingStyles ? shared.dynamicStyleCount*2 : 0, dynamicEditingStylePaddings},
+        /* If shader-side interpolation is enabled, there's one interpolation
+           for each dynamic uniform and dynamic editing uniform */
+        {NoInit, shared.flags >= TextLayerSharedFlag::ShaderStyleAnimation ? shared.dynamicStyleCount*(shared.hasEditingStyles ? 3 : 1) : 0, dynamicStyleInterpolations},
+        {NoInit, shared.flags >= TextLayerSharedFlag::ShaderStyleAnimation && shared.hasEditingStyles ? shared.dynamicStyleCount*2 : 0, dynamicEditingStyleInterpolations},
     };
 
+    /* Initially each dynamic uniform interpolates just between itself, i.e.
+       is drawn with its own uniform */
+    for(std::size_t i = 0; i != dynamicStyleInterpolations.size(); ++i) {
+        const UnsignedInt uniform = shared.styleUniformCount + i;
+        dynamicStyleInterpolations[i] = {{uniform, uniform}, 0.0f};
+    }
+    for(std::size_t i = 0; i != dynamicEditingStyleInterpolations.size(); ++i) {
+        const UnsignedInt uniform = shared.editingStyleUniformCount + i;
+        dynamicEditingStyleInterpolations[i] = {{uniform, uniform}, 0.0f};
+    }
+
     const auto glyphAllocator = [](void* const state_, const UnsignedInt glyphCount, Containers::StridedArrayView1D<Vector2>& glyphPositions, Containers::StridedArrayView1D<UnsignedInt>& glyphIds, Containers::StridedArrayView1D<UnsignedInt>* const glyphClusters, Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
         State& state = *static_cast<TextLayer::State*>(state_);
 
@@ -766,6 +1068,31 @@ void TextLayer::setDynamicStyleInternal(
     setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
     state.dynamicStyleChanged = true;
 
+    /* If the style animations are interpolated in the shader, make all
+       uniforms belonging to the dynamic style reference just themselves, in
+       case they were used by an animation before. The cursor and selection
+       variants call this function first, so it's done for all of them. */
+    if(!state.dynamicStyleInterpolations.isEmpty()) {
+        const Shared::State& sharedState = static_cast<const Shared::State&>(state.shared);
+        const UnsignedInt styleUniform = sharedState.styleUniformCount + id;
+        state.dynamicStyleInterpolations[id] = {{styleUniform, styleUniform}, 0.0f};
+        state.dynamicStyleInterpolationChanged = true;
+        if(sharedState.hasEditingStyles) {
+            const UnsignedInt selectionTextStyle = Implementation::selectionStyleTextUniformForDynamicStyle(sharedState.dynamicStyleCount, id);
+            const UnsignedInt selectionTextUniform = sharedState.styleUniformCount + selectionTextStyle;
+            state.dynamicStyleInterpolations[selectionTextStyle] = {{selectionTextUniform, selectionTextUniform}, 0.0f};
+
+            const UnsignedInt cursorStyle = Implementation::cursorStyleForDynamicStyle(id);
+            const UnsignedInt cursorUniform = sharedState.editingStyleUniformCount + cursorStyle;
+            state.dynamicEditingStyleInterpolations[cursorStyle] = {{cursorUniform, cursorUniform}, 0.0f};
+
+            const UnsignedInt selectionStyle = Implementation::selectionStyleForDynamicStyle(id);
+            const UnsignedInt selectionUniform = sharedState.editingStyleUniformCount + selectionStyle;
+            state.dynamicEditingStyleInterpolations[selectionStyle] = {{selectionUniform, selectionUniform}, 0.0f};
+            state.dynamicEditingStyleInterpolationChanged = true;
+        }
+    }
+
     /* Mark the layer as changed only if the padding actually changes,
        otherwise it's not needed to trigger an update(). OTOH changing the
        font, alignment or feature list doesn't / cannot trigger an update
@@ -1057,6 +1384,45 @@ void TextLayer::shapeTextInternal(const UnsignedInt id, const UnsignedInt style,
         features[i] = styleFeatures[i];
     Utility::copy(properties.features(), features.exceptPrefix(styleFeatures.size()));
 
+    /* If the shape cache is enabled, look up whether the same text with the
+       same properties was shaped already. Editable text needs glyph clusters
+       and the shape direction resolved by the shaper, which aren't stored in
+       the cache, so it's always shaped directly. */
+    Implementation::TextLayerShapeCache& shapeCache = sharedState.shapeCache;
+    const bool useShapeCache = shapeCache.entries && !(flags >= TextDataFlag::Editable);
+    UnsignedLong shapeCacheKeyHash{};
+    if(useShapeCache) {
+        shapeCacheKeyHash = shapeCacheKey(shapeCache, font, alignment, properties, features, text);
+        const UnsignedInt shapeCacheId = shapeCacheFind(shapeCache, shapeCacheKeyHash);
+        if(shapeCacheId != ~UnsignedInt{}) {
+            ++shapeCache.hitCount;
+            shapeCacheUse(shapeCache, shapeCacheId);
+            const Implementation::TextLayerShapeCacheEntry& entry = shapeCache.entries[shapeCacheId];
+
+            /* Append the glyphs and a run referencing them the same way the
+               renderer would. The clusters are unspecified for non-editable
+               text, zero them instead of leaving random memory there. */
+            Implementation::TextLayerData& data = state.data[id];
+            if(const std::size_t glyphCount = entry.glyphIds.size()) {
+                const UnsignedInt glyphOffset = state.glyphData.size();
+                const Containers::StridedArrayView1D<Implementation::TextLayerGlyphData> glyphData = arrayAppend(state.glyphData, NoInit, glyphCount);
+                Utility::copy(entry.glyphPositions, glyphData.slice(&Implementation::TextLayerGlyphData::position));
+                Utility::copy(entry.glyphIds, glyphData.slice(&Implementation::TextLayerGlyphData::glyphId));
+                for(UnsignedInt& i: glyphData.slice(&Implementation::TextLayerGlyphData::glyphCluster))
+                    i = 0;
+                data.glyphRun = state.glyphRuns.size();
+                arrayAppend(state.glyphRuns, InPlaceInit, glyphOffset, UnsignedInt(glyphCount), id, entry.scale);
+            } else data.glyphRun = ~UnsignedInt{};
+
+            data.rectangle = entry.rectangle;
+            data.alignment = entry.alignment;
+            data.usedDirection = Text::ShapeDirection::Unspecified;
+            return;
+        }
+
+        ++shapeCache.missCount;
+    }
+
     /* Get a shaper instance */
     if(!fontState.shaper)
         fontState.shaper = fontState.font->createShaper();
@@ -1079,11 +1445,44 @@ void TextLayer::shapeTextInternal(const UnsignedInt id, const UnsignedInt style,
     shaper.setScript(properties.script());
     shaper.setLanguage(properties.language());
     shaper.setDirection(properties.shapeDirection());
-    const Containers::Pair<Range2D, Range1Dui> rectangleRunRange = renderer
+    Containers::Pair<Range2D, Range1Dui> rectangleRunRange = renderer
         .setAlignment(alignment)
         .setLayoutDirection(properties.layoutDirection())
         .render(shaper, fontState.scale*fontState.font->size(), text, features);
 
+    /* If the glyph cache is filled on demand and some glyphs weren't there,
+       add them and render the text again to pick up their new IDs. The
+       reset() discards the runs and glyphs rendered above, the allocators then
+       append to the arrays again, so they're truncated to the original size
+       first. If the filling is deferred, the missing glyphs are only
+       remembered and get their IDs patched in fillPendingGlyphs() later. */
+    bool hasPendingGlyphs = false;
+    if(sharedState.flags >= TextLayerSharedFlag::FillGlyphCacheOnDemand && !fontState.glyphCacheFull) {
+        const Containers::StridedArrayView1D<const UnsignedInt> glyphIds = Containers::stridedArrayView(state.glyphData).exceptPrefix(glyphOffset).slice(&Implementation::TextLayerGlyphData::glyphId);
+        const Containers::Array<UnsignedInt> fontGlyphIds = missingGlyphFontIds(shaper, glyphIds, text, features);
+        if(!fontGlyphIds.isEmpty()) {
+            if(sharedState.flags >= TextLayerSharedFlag::FillGlyphCacheDeferred) {
+                /* There's at most one run, as asserted below, so the glyph
+                   index is relative to it */
+                CORRADE_INTERNAL_ASSERT(fontGlyphIds.size() == glyphIds.size());
+                for(UnsignedInt i = 0; i != glyphIds.size(); ++i) {
+                    if(glyphIds[i])
+                        continue;
+                    arrayAppend(state.pendingGlyphs, InPlaceInit, id, glyphRunOffset, i, fontHandleId(font), fontGlyphIds[i]);
+                }
+                hasPendingGlyphs = true;
+            } else if(fillGlyphCacheOnDemand(sharedState.glyphCache, fontState, fontGlyphIds)) {
+                renderer.reset();
+                arrayRemoveSuffix(state.glyphData, state.glyphData.size() - glyphOffset);
+                arrayRemoveSuffix(state.glyphRuns, state.glyphRuns.size() - glyphRunOffset);
+                rectangleRunRange = renderer
+                    .setAlignment(alignment)
+                    .setLayoutDirection(properties.layoutDirection())
+                    .render(shaper, fontState.scale*fontState.font->size(), text, features);
+            }
+        }
+    }
+
     /* Fill in remaining properties for all runs allocated by the renderer. So
        far assuming there's either one or none at all if the text has no
        glyphs, once BIDI support is in or we call add() multiple times there
@@ -1126,6 +1525,189 @@ void TextLayer::shapeTextInternal(const UnsignedInt id, const UnsignedInt style,
        accidentally relying on some random value. The clusters aren't reset
        though, as that is extra overhead. */
     } else data.usedDirection = Text::ShapeDirection::Unspecified;
+
+    /* Remember the result if the shape cache is used. As the text isn't
+       editable, there's at most one run. Results with glyphs that are still
+       pending to be added to the glyph cache aren't remembered, as the IDs get
+       patched only in the glyph data. */
+    if(useShapeCache && !hasPendingGlyphs) {
+        Implementation::TextLayerShapeCacheEntry& entry = shapeCacheInsert(shapeCache, shapeCacheKeyHash);
+        const Containers::StridedArrayView1D<const Implementation::TextLayerGlyphData> glyphData = state.glyphData.exceptPrefix(glyphOffset);
+        arrayResize(entry.glyphPositions, NoInit, glyphData.size());
+        arrayResize(entry.glyphIds, NoInit, glyphData.size());
+        Utility::copy(glyphData.slice(&Implementation::TextLayerGlyphData::position), entry.glyphPositions);
+        Utility::copy(glyphData.slice(&Implementation::TextLayerGlyphData::glyphId), entry.glyphIds);
+        entry.rectangle = data.rectangle;
+        entry.scale = data.glyphRun == ~UnsignedInt{} ? 0.0f : state.glyphRuns[data.glyphRun].scale;
+        entry.alignment = data.alignment;
+    }
+}
+
+bool TextLayer::shapeTextLineInternal(const UnsignedInt id, const Containers::StringView text, const TextProperties& properties, const FontHandle font, const UnsignedInt lineBegin, const UnsignedInt lineEnd, const Containers::StringView previousLine, const UnsignedInt lineIndex, const UnsignedInt lineCount) {
+    State& state = static_cast<State&>(*_state);
+    Implementation::TextLayerData& data = state.data[id];
+    CORRADE_INTERNAL_DEBUG_ASSERT(data.glyphRun != ~UnsignedInt{} && lineIndex < lineCount);
+
+    /* Getting a copy of the previous run and not a reference, as the
+       glyphRuns array is getting reallocated below */
+    const UnsignedInt previousGlyphRunId = data.glyphRun;
+    const Implementation::TextLayerGlyphRun previousGlyphRun = state.glyphRuns[previousGlyphRunId];
+    const Range2D previousRectangle = data.rectangle;
+    const Text::Alignment previousAlignment = data.alignment;
+    const Text::ShapeDirection previousDirection = data.usedDirection;
+
+    /* Glyphs of each line are contiguous in the run and lines are in order,
+       find the ones that belong to the edited line by their clusters. The
+       newline characters themselves don't produce any glyphs. */
+    const UnsignedInt previousLineEnd = lineBegin + previousLine.size();
+    UnsignedInt lineGlyphBegin = 0;
+    UnsignedInt lineGlyphEnd = 0;
+    {
+        const Containers::StridedArrayView1D<const UnsignedInt> previousGlyphClusters = Containers::stridedArrayView(state.glyphData).sliceSize(previousGlyphRun.glyphOffset, previousGlyphRun.glyphCount).slice(&Implementation::TextLayerGlyphData::glyphCluster);
+        while(lineGlyphBegin != previousGlyphClusters.size() && previousGlyphClusters[lineGlyphBegin] < lineBegin)
+            ++lineGlyphBegin;
+        lineGlyphEnd = lineGlyphBegin;
+        while(lineGlyphEnd != previousGlyphClusters.size() && previousGlyphClusters[lineGlyphEnd] < previousLineEnd)
+            ++lineGlyphEnd;
+    }
+
+    /* Horizontal alignment is applied to each line separately and the
+       vertical alignment depends only on the line count and font metrics, not
+       on the line contents. Thus, shaping just the edited line surrounded by
+       the same number of empty lines as there is in the whole text results in
+       exactly the same glyph positions as shaping the whole text would,
+       without having to shape the other lines again. The line is appended as a
+       new glyph run to the end, remember where to be able to undo it. */
+    const auto shapeLine = [&](const Containers::StringView line) {
+        Containers::String paddedLine{NoInit, lineCount - 1 + line.size()};
+        for(std::size_t i = 0; i != lineIndex; ++i)
+            paddedLine[i] = '\n';
+        Utility::copy(line, paddedLine.sliceSize(lineIndex, line.size()));
+        for(std::size_t i = lineIndex + line.size(); i != paddedLine.size(); ++i)
+            paddedLine[i] = '\n';
+        shapeTextInternal(id, data.style, paddedLine, properties, font, data.flags);
+    };
+    const UnsignedInt glyphOffset = state.glyphData.size();
+    const UnsignedInt glyphRunOffset = state.glyphRuns.size();
+    const UnsignedInt pendingGlyphOffset = state.pendingGlyphs.size();
+    const auto restore = [&]() {
+        arrayRemoveSuffix(state.glyphData, state.glyphData.size() - glyphOffset);
+        arrayRemoveSuffix(state.glyphRuns, state.glyphRuns.size() - glyphRunOffset);
+        arrayRemoveSuffix(state.pendingGlyphs, state.pendingGlyphs.size() - pendingGlyphOffset);
+        data.glyphRun = previousGlyphRunId;
+        data.rectangle = previousRectangle;
+        data.alignment = previousAlignment;
+        data.usedDirection = previousDirection;
+    };
+    shapeLine(text.slice(lineBegin, lineEnd));
+
+    /* If the shaper detected a different direction for the line than it did
+       for the whole text, the result wouldn't match, reshape everything */
+    if(data.usedDirection != previousDirection) {
+        restore();
+        return false;
+    }
+
+    /* The rectangle of the whole text spans all lines. If the edited line
+       doesn't reach its edge anymore, it's not known whether it was the line
+       that defined the edge before or some other, so shape the previous line
+       as well to find out. If it was, the rectangle of the whole text isn't
+       known without shaping all other lines, reshape everything. */
+    const Range2D lineRectangle = data.rectangle;
+    const UnsignedInt lineGlyphRun = data.glyphRun;
+    if(lineRectangle.min().x() > previousRectangle.min().x() ||
+       lineRectangle.max().x() < previousRectangle.max().x())
+    {
+        const UnsignedInt lineGlyphOffset = state.glyphData.size();
+        const UnsignedInt lineGlyphRunOffset = state.glyphRuns.size();
+        const UnsignedInt linePendingGlyphOffset = state.pendingGlyphs.size();
+        shapeLine(previousLine);
+        const Range2D previousLineRectangle = data.rectangle;
+        arrayRemoveSuffix(state.glyphData, state.glyphData.size() - lineGlyphOffset);
+        arrayRemoveSuffix(state.glyphRuns, state.glyphRuns.size() - lineGlyphRunOffset);
+        arrayRemoveSuffix(state.pendingGlyphs, state.pendingGlyphs.size() - linePendingGlyphOffset);
+        data.glyphRun = lineGlyphRun;
+
+        if((lineRectangle.min().x() > previousRectangle.min().x() && previousLineRectangle.min().x() <= previousRectangle.min().x()) ||
+           (lineRectangle.max().x() < previousRectangle.max().x() && previousLineRectangle.max().x() >= previousRectangle.max().x()))
+        {
+            restore();
+            return false;
+        }
+    }
+
+    /* Copy out the glyphs of the newly shaped line, if any, and put together
+       a new glyph run out of the glyphs of the preceding lines, the new line
+       and the following lines */
+    const UnsignedInt lineGlyphCount = state.glyphData.size() - glyphOffset;
+    Containers::Array<Implementation::TextLayerGlyphData> lineGlyphs{NoInit, lineGlyphCount};
+    Utility::copy(state.glyphData.exceptPrefix(glyphOffset), lineGlyphs);
+    arrayRemoveSuffix(state.glyphData, lineGlyphCount);
+    const UnsignedInt suffixGlyphCount = previousGlyphRun.glyphCount - lineGlyphEnd;
+    const UnsignedInt glyphCount = lineGlyphBegin + lineGlyphCount + suffixGlyphCount;
+    if(glyphCount) {
+        arrayAppend(state.glyphData, NoInit, glyphCount);
+        const Containers::ArrayView<const Implementation::TextLayerGlyphData> previousGlyphs = state.glyphData.sliceSize(previousGlyphRun.glyphOffset, previousGlyphRun.glyphCount);
+        const Containers::ArrayView<Implementation::TextLayerGlyphData> glyphs = state.glyphData.exceptPrefix(glyphOffset);
+        Utility::copy(previousGlyphs.prefix(lineGlyphBegin), glyphs.prefix(lineGlyphBegin));
+        Utility::copy(lineGlyphs, glyphs.sliceSize(lineGlyphBegin, lineGlyphCount));
+        Utility::copy(previousGlyphs.exceptPrefix(lineGlyphEnd), glyphs.exceptPrefix(lineGlyphBegin + lineGlyphCount));
+
+        /* Clusters of the new line are relative to the padded line, clusters
+           of the following lines are shifted by the size difference. The
+           arithmetic is done with wraparound in case the line got shorter. */
+        for(Implementation::TextLayerGlyphData& glyph: glyphs.sliceSize(lineGlyphBegin, lineGlyphCount))
+            glyph.glyphCluster = glyph.glyphCluster - lineIndex + lineBegin;
+        for(Implementation::TextLayerGlyphData& glyph: glyphs.exceptPrefix(lineGlyphBegin + lineGlyphCount))
+            glyph.glyphCluster = glyph.glyphCluster + lineEnd - previousLineEnd;
+
+        /* Reuse the run allocated for the line if there's one, otherwise the
+           line has no glyphs and a new run is added */
+        if(lineGlyphRun != ~UnsignedInt{}) {
+            Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[lineGlyphRun];
+            glyphRun.glyphOffset = glyphOffset;
+            glyphRun.glyphCount = glyphCount;
+        } else {
+            data.glyphRun = state.glyphRuns.size();
+            arrayAppend(state.glyphRuns, InPlaceInit, glyphOffset, glyphCount, id, previousGlyphRun.scale);
+        }
+    } else data.glyphRun = ~UnsignedInt{};
+
+    /* Glyphs pending to be added to the glyph cache that were in the newly
+       shaped line are now after the preceding lines. Pending glyphs from the
+       preceding and following lines of the previous run get moved over to the
+       new one, those from the previous version of the line get discarded
+       together with the run in fillPendingGlyphs() or during recompaction. */
+    for(std::size_t i = 0; i != state.pendingGlyphs.size(); ++i) {
+        Implementation::TextLayerPendingGlyph& glyph = state.pendingGlyphs[i];
+        if(i >= pendingGlyphOffset)
+            glyph.glyph += lineGlyphBegin;
+        else if(glyph.data == id && glyph.glyphRun == previousGlyphRunId) {
+            if(glyph.glyph < lineGlyphBegin)
+                glyph.glyphRun = data.glyphRun;
+            else if(glyph.glyph >= lineGlyphEnd) {
+                glyph.glyphRun = data.glyphRun;
+                glyph.glyph = glyph.glyph - lineGlyphEnd + lineGlyphBegin + lineGlyphCount;
+            }
+        }
+    }
+
+    /* Mark the previous glyph run as unused. It'll be removed during the next
+       recompaction in doUpdate(). */
+    Implementation::TextLayerGlyphRun& previousGlyphRunRef = state.glyphRuns[previousGlyphRunId];
+    previousGlyphRunRef.glyphOffset = ~UnsignedInt{};
+    state.unusedGlyphCount += previousGlyphRunRef.glyphCount;
+    state.firstUnusedGlyphRun = Math::min(state.firstUnusedGlyphRun, previousGlyphRunId);
+
+    /* The vertical extent is the same as before as the line count didn't
+       change, the horizontal extent is either the edited line or the other
+       lines, as verified above */
+    data.rectangle = Range2D{
+        {Math::min(lineRectangle.min().x(), previousRectangle.min().x()),
+         previousRectangle.min().y()},
+        {Math::max(lineRectangle.max().x(), previousRectangle.max().x()),
+         previousRectangle.max().y()}};
+    return true;
 }
 
 void TextLayer::shapeRememberTextInternal(
@@ -1290,8 +1872,8 @@ void TextLayer::shapeGlyphInternal(
        TextProperties */
     const Text::Alignment resolvedAlignment = Text::alignmentForDirection(alignment, properties.layoutDirection(), properties.shapeDirection());
 
-    const Implementation::TextLayerFont& fontState = sharedState.fonts[fontHandleId(font)];
-    const Text::AbstractGlyphCache& glyphCache = sharedState.glyphCache;
+    Implementation::TextLayerFont& fontState = sharedState.fonts[fontHandleId(font)];
+    Text::AbstractGlyphCache& glyphCache = sharedState.glyphCache;
 
     #ifndef CORRADE_NO_ASSERT
     const UnsignedInt glyphCount = fontState.glyphMapping ? fontState.glyphMapping.size() : glyphCache.fontGlyphCount(fontState.glyphCacheFontId);
@@ -1299,15 +1881,21 @@ void TextLayer::shapeGlyphInternal(
     CORRADE_ASSERT(glyphId < glyphCount,
         messagePrefix << "glyph" << glyphId << "out of range for" << glyphCount << "glyphs in" << font, );
 
-    /* Query the glyph rectangle in order to align it. Compared to a regular
-       text run, where the glyphs might not be present in the glyph cache yet
-       (and can thus be filled in on-demand), here we require those to be
-       present upfront.
+    /* Query the glyph rectangle in order to align it. Unless
+       TextLayerSharedFlag::FillGlyphCacheOnDemand is set and the font has an
+       instance, the glyph is required to be present in the cache upfront.
 
        The mapping array isn't filled with a trivial glyph mapping sequence if
        none was provided as that'd be an unnecessary and potentially large
        allocation, in that case the glyph ID is simply used as-is. */
-    const UnsignedInt cacheGlobalGlyphId = glyphCache.glyphId(fontState.glyphCacheFontId, fontState.glyphMapping ? fontState.glyphMapping[glyphId] : glyphId);
+    const UnsignedInt fontGlyphId = fontState.glyphMapping ? fontState.glyphMapping[glyphId] : glyphId;
+    UnsignedInt cacheGlobalGlyphId = glyphCache.glyphId(fontState.glyphCacheFontId, fontGlyphId);
+    if(!cacheGlobalGlyphId && fontState.font && !fontState.glyphCacheFull && sharedState.flags >= TextLayerSharedFlag::FillGlyphCacheOnDemand) {
+        if(fontState.font->fillGlyphCache(glyphCache, Containers::arrayView(&fontGlyphId, 1)))
+            cacheGlobalGlyphId = glyphCache.glyphId(fontState.glyphCacheFontId, fontGlyphId);
+        else
+            fontState.glyphCacheFull = true;
+    }
     const Containers::Triple<Vector2i, Int, Range2Di> glyph = glyphCache.glyph(cacheGlobalGlyphId);
     const Range2D glyphRectangle = Range2D{Range2Di::fromSize(glyph.first(), glyph.third().size())}
         .scaled(fontState.scale);
@@ -1375,6 +1963,11 @@ DataHandle TextLayer::createInternal(const NodeHandle node) {
        `glyphRun` or `textRun` doesn't need to be initialized as they're not
        recycled in any way. */
     data.editData = ~UnsignedInt{};
+
+    /* AbstractLayer::create() sets LayerState::NeedsDataUpdate already, but
+       the new data add glyph runs and thus all indices and vertices have to
+       be regenerated, not just the ones marked by setNeedsDataUpdate() */
+    setNeedsUpdate(LayerState::NeedsDataUpdate);
     return handle;
 }
 
@@ -1457,13 +2050,19 @@ void TextLayer::removeInternal(const UnsignedInt id) {
 
     /* Mark the glyph run as unused. It'll be removed during the next
        recompaction in doUpdate(). */
-    if(data.glyphRun != ~UnsignedInt{})
-        state.glyphRuns[data.glyphRun].glyphOffset = ~UnsignedInt{};
+    if(data.glyphRun != ~UnsignedInt{}) {
+        Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[data.glyphRun];
+        glyphRun.glyphOffset = ~UnsignedInt{};
+        state.unusedGlyphCount += glyphRun.glyphCount;
+        state.firstUnusedGlyphRun = Math::min(state.firstUnusedGlyphRun, data.glyphRun);
+    }
 
     /* If there's a text run, mark it as unused as well; it'll be removed in
        doUpdate() too */
-    if(data.textRun != ~UnsignedInt{})
+    if(data.textRun != ~UnsignedInt{}) {
         state.textRuns[data.textRun].textOffset = ~UnsignedInt{};
+        state.firstUnusedTextRun = Math::min(state.firstUnusedTextRun, data.textRun);
+    }
 
     /* If the text is editable, put the edit data on the free list */
     if(data.editData != ~UnsignedInt{}) {
@@ -1514,6 +2113,86 @@ UnsignedInt TextLayer::glyphCount(const LayerDataHandle handle) const {
     return glyphRun == ~UnsignedInt{} ? 0 : state.glyphRuns[glyphRun].glyphCount;
 }
 
+std::size_t TextLayer::pendingGlyphCount() const {
+    return static_cast<const State&>(*_state).pendingGlyphs.size();
+}
+
+std::size_t TextLayer::fillPendingGlyphs(const std::size_t count) {
+    State& state = static_cast<State&>(*_state);
+    Shared::State& sharedState = static_cast<Shared::State&>(state.shared);
+    Text::AbstractGlyphCache& glyphCache = sharedState.glyphCache;
+
+    /* Collect at most `count` distinct glyphs that aren't in the cache yet.
+       The same glyph is usually pending in many texts, so this is expected to
+       be small, and a linear search is fine. */
+    Containers::Array<Containers::Pair<UnsignedInt, UnsignedInt>> glyphsToFill;
+    for(const Implementation::TextLayerPendingGlyph& glyph: state.pendingGlyphs) {
+        if(glyphsToFill.size() == count)
+            break;
+        const Implementation::TextLayerGlyphRun& run = state.glyphRuns[glyph.glyphRun];
+        const Implementation::TextLayerFont& fontState = sharedState.fonts[glyph.font];
+        if(run.glyphOffset == ~UnsignedInt{} || run.data != glyph.data || fontState.glyphCacheFull || glyphCache.glyphId(fontState.glyphCacheFontId, glyph.fontGlyphId))
+            continue;
+
+        bool found = false;
+        for(const Containers::Pair<UnsignedInt, UnsignedInt>& i: glyphsToFill) if(i.first() == glyph.font && i.second() == glyph.fontGlyphId) {
+            found = true;
+            break;
+        }
+        if(!found)
+            arrayAppend(glyphsToFill, InPlaceInit, glyph.font, glyph.fontGlyphId);
+    }
+
+    /* Fill the glyphs font by font */
+    std::size_t filledCount = 0;
+    Containers::Array<UnsignedInt> fontGlyphIds;
+    for(std::size_t i = 0; i != glyphsToFill.size(); ++i) {
+        const UnsignedInt font = glyphsToFill[i].first();
+        /* Skip fonts already processed in a previous iteration */
+        if(font == ~UnsignedInt{})
+            continue;
+
+        arrayResize(fontGlyphIds, 0);
+        for(std::size_t j = i; j != glyphsToFill.size(); ++j) if(glyphsToFill[j].first() == font) {
+            arrayAppend(fontGlyphIds, glyphsToFill[j].second());
+            glyphsToFill[j].first() = ~UnsignedInt{};
+        }
+
+        Implementation::TextLayerFont& fontState = sharedState.fonts[font];
+        if(fontState.font->fillGlyphCache(glyphCache, fontGlyphIds))
+            filledCount += fontGlyphIds.size();
+        else
+            fontState.glyphCacheFull = true;
+    }
+
+    /* Patch the glyphs that are now in the cache, discard ones that are no
+       longer relevant or that will never get filled */
+    bool updated = false;
+    std::size_t outputOffset = 0;
+    for(const Implementation::TextLayerPendingGlyph& glyph: state.pendingGlyphs) {
+        const Implementation::TextLayerGlyphRun& run = state.glyphRuns[glyph.glyphRun];
+        if(run.glyphOffset == ~UnsignedInt{} || run.data != glyph.data)
+            continue;
+
+        const Implementation::TextLayerFont& fontState = sharedState.fonts[glyph.font];
+        if(const UnsignedInt glyphId = glyphCache.glyphId(fontState.glyphCacheFontId, glyph.fontGlyphId)) {
+            state.glyphData[run.glyphOffset + glyph.glyph].glyphId = glyphId;
+            updated = true;
+            continue;
+        }
+        if(fontState.glyphCacheFull)
+            continue;
+
+        state.pendingGlyphs[outputOffset++] = glyph;
+    }
+    arrayResize(state.pendingGlyphs, outputOffset);
+
+    if(updated)
+        setNeedsUpdate(LayerState::NeedsDataUpdate);
+
+    return filledCount;
+}
+
 Vector2 TextLayer::size(const DataHandle handle) const {
     CORRADE_ASSERT(isHandleValid(handle),
         "Ui::TextLayer::size(): invalid handle" << handle, {});
@@ -1678,13 +2357,19 @@ void TextLayer::setTextInternal(const UnsignedInt id, const Containers::StringVi
 
     /* If the text has any glyphs, mark the original glyph run as unused. It'll
        be removed during the next recompaction in doUpdate(). */
-    if(data.glyphRun != ~UnsignedInt{})
-        state.glyphRuns[data.glyphRun].glyphOffset = ~UnsignedInt{};
+    if(data.glyphRun != ~UnsignedInt{}) {
+        Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[data.glyphRun];
+        glyphRun.glyphOffset = ~UnsignedInt{};
+        state.unusedGlyphCount += glyphRun.glyphCount;
+        state.firstUnusedGlyphRun = Math::min(state.firstUnusedGlyphRun, data.glyphRun);
+    }
 
     /* If there's a text run, mark it as unused as well; it'll be removed in
        doUpdate() too */
-    if(data.textRun != ~UnsignedInt{})
+    if(data.textRun != ~UnsignedInt{}) {
         state.textRuns[data.textRun].textOffset = ~UnsignedInt{};
+        state.firstUnusedTextRun = Math::min(state.firstUnusedTextRun, data.textRun);
+    }
 
     /* Shape the text, save its properties and optionally also the source
        string if it's editable; mark the layer as needing an update */
@@ -1742,6 +2427,34 @@ void TextLayer::updateTextInternal(const UnsignedInt id, const UnsignedInt remov
         return;
     }
 
+    /* If the edit is contained within a single line of a multi-line text,
+       only that line gets reshaped below, the other lines stay as they are.
+       Remember where the line is and make a copy of it, as the previous text
+       may get modified in place. */
+    const Containers::StringView previousText = state.textData.sliceSize(previousRun.textOffset, previousRun.textSize);
+    UnsignedInt lineBegin = 0;
+    UnsignedInt previousLineEnd = previousRun.textSize;
+    UnsignedInt lineIndex = 0;
+    UnsignedInt lineCount = 1;
+    Containers::String previousLine;
+    if(data.glyphRun != ~UnsignedInt{} && !insertText.find('\n') && !previousText.slice(removeOffset, removeOffset + removeSize).find('\n')) {
+        /* If nothing is removed, the line is where the text is inserted */
+        const UnsignedInt editOffset = removeSize ? removeOffset : insertOffset;
+        if(const Containers::StringView found = previousText.prefix(editOffset).findLast('\n'))
+            lineBegin = UnsignedInt(found.end() - previousText.data());
+        if(const Containers::StringView found = previousText.exceptPrefix(editOffset + removeSize).find('\n'))
+            previousLineEnd = UnsignedInt(found.data() - previousText.data());
+        if(insertOffset >= lineBegin && insertOffset <= previousLineEnd - removeSize) {
+            for(const char c: previousText.prefix(lineBegin))
+                if(c == '\n') ++lineIndex;
+            lineCount = lineIndex + 1;
+            for(const char c: previousText.exceptPrefix(previousLineEnd))
+                if(c == '\n') ++lineCount;
+            if(lineCount > 1)
+                previousLine = previousText.slice(lineBegin, previousLineEnd);
+        }
+    }
+
     /* Check if the text is a slice of our internal text array (i.e., coming
        from another widget, possibly). In that case we'll have to relocate the
        view when we copy() it below to not copy garbage from a location that
@@ -1755,83 +2468,113 @@ void TextLayer::updateTextInternal(const UnsignedInt id, const UnsignedInt remov
     if(insertTextRelocateOffset >= arrayCapacity(state.textData))
         insertTextRelocateOffset = ~std::size_t{};
 
-    /* Add a new text run for the modified contents */
-    const UnsignedInt textRun = state.textRuns.size();
-    const UnsignedInt textOffset = state.textData.size();
-    /* Append one extra byte and put a null terminator there */
-    arrayAppend(state.textData, NoInit, textSize + 1);
-    state.textData.back() = '\0';
-    const Containers::MutableStringView text{
-        state.textData.sliceSize(textOffset, textSize),
-        Containers::StringViewFlag::NullTerminated};
-    Implementation::TextLayerTextRun& run = arrayAppend(state.textRuns, NoInit, 1).front();
-
-    /* Fill the new run properties */
-    run.textOffset = textOffset;
-    run.textSize = textSize;
-    run.data = id;
-
-    /* We can insert either before the removed range, in which case the copy
-       before the removed range has to be split */
-    UnsignedInt copySrcBegin[3];
-    UnsignedInt copyDstBegin[3];
-    UnsignedInt copySrcEnd[3];
-    copySrcBegin[0] = 0;
-    copyDstBegin[0] = 0;
-    if(insertOffset < removeOffset) {
-        copySrcEnd[0] = insertOffset;
-
-        copySrcBegin[1] = insertOffset;
-        copyDstBegin[1] = insertOffset + insertText.size();
-        copySrcEnd[1] = removeOffset;
-
-        copySrcBegin[2] = removeOffset + removeSize;
-        copyDstBegin[2] = removeOffset + insertText.size();
-
-    /* Or insert after the removed range, in which case the copy after the
-       removed range has to be split (and the offsets there include the removed
-       size as well because the source doesn't have it removed yet) */
+    /* If the text is the last in the array, which is the case for a text
+       that's being repeatedly edited, and the inserted text isn't coming from
+       the array, modify it in place, the end of the array capacity acting as
+       a gap. Only the part after the edited range gets moved, instead of the
+       whole text being copied to a new run. */
+    Containers::MutableStringView text;
+    if(previousRun.textOffset + previousRun.textSize + 1 == state.textData.size() && insertTextRelocateOffset == ~std::size_t{}) {
+        if(textSize > previousRun.textSize)
+            arrayAppend(state.textData, NoInit, textSize - previousRun.textSize);
+        char* const textData = state.textData.data() + previousRun.textOffset;
+
+        /* First remove, then insert, moving the null terminator as well */
+        if(removeSize) std::memmove(
+            textData + removeOffset,
+            textData + removeOffset + removeSize,
+            textSizeBeforeInsert - removeOffset + 1);
+        if(insertText) {
+            std::memmove(
+                textData + insertOffset + insertText.size(),
+                textData + insertOffset,
+                textSizeBeforeInsert - insertOffset + 1);
+            Utility::copy(insertText, Containers::MutableStringView{textData + insertOffset, insertText.size()});
+        }
+
+        if(textSize < previousRun.textSize)
+            arrayRemoveSuffix(state.textData, previousRun.textSize - textSize);
+        state.textRuns[data.textRun].textSize = textSize;
+        text = Containers::MutableStringView{textData, textSize, Containers::StringViewFlag::NullTerminated};
+
+    /* Otherwise add a new text run for the modified contents */
     } else {
-        copySrcEnd[0] = removeOffset;
+        const UnsignedInt textRun = state.textRuns.size();
+        const UnsignedInt textOffset = state.textData.size();
+        /* Append one extra byte and put a null terminator there */
+        arrayAppend(state.textData, NoInit, textSize + 1);
+        state.textData.back() = '\0';
+        text = Containers::MutableStringView{
+            state.textData.sliceSize(textOffset, textSize),
+            Containers::StringViewFlag::NullTerminated};
+        Implementation::TextLayerTextRun& run = arrayAppend(state.textRuns, NoInit, 1).front();
 
-        copySrcBegin[1] = removeOffset + removeSize;
-        copyDstBegin[1] = removeOffset;
-        copySrcEnd[1] = removeSize + insertOffset;
+        /* Fill the new run properties */
+        run.textOffset = textOffset;
+        run.textSize = textSize;
+        run.data = id;
 
-        copySrcBegin[2] = removeSize + insertOffset;
-        copyDstBegin[2] = insertOffset + insertText.size();
-    }
-    copySrcEnd[2] = previousRun.textSize;
+        /* We can insert either before the removed range, in which case the
+           copy before the removed range has to be split */
+        UnsignedInt copySrcBegin[3];
+        UnsignedInt copyDstBegin[3];
+        UnsignedInt copySrcEnd[3];
+        copySrcBegin[0] = 0;
+        copyDstBegin[0] = 0;
+        if(insertOffset < removeOffset) {
+            copySrcEnd[0] = insertOffset;
+
+            copySrcBegin[1] = insertOffset;
+            copyDstBegin[1] = insertOffset + insertText.size();
+            copySrcEnd[1] = removeOffset;
+
+            copySrcBegin[2] = removeOffset + removeSize;
+            copyDstBegin[2] = removeOffset + insertText.size();
+
+        /* Or insert after the removed range, in which case the copy after the
+           removed range has to be split (and the offsets there include the
+           removed size as well because the source doesn't have it removed
+           yet) */
+        } else {
+            copySrcEnd[0] = removeOffset;
 
-    /* Copy the bits of the previous text, if not empty */
-    const Containers::StringView previousText = state.textData.sliceSize(previousRun.textOffset, previousRun.textSize);
-    for(std::size_t i: {0, 1, 2}) {
-        const UnsignedInt size = copySrcEnd[i] - copySrcBegin[i];
-        if(size) Utility::copy(
-            previousText.slice(copySrcBegin[i], copySrcEnd[i]),
-            text.sliceSize(copyDstBegin[i], size));
-    }
+            copySrcBegin[1] = removeOffset + removeSize;
+            copyDstBegin[1] = removeOffset;
+            copySrcEnd[1] = removeSize + insertOffset;
 
-    /* Copy the inserted text, if not empty */
-    if(insertText) {
-        Utility::copy(
-            /* If text to insert was a slice of our textData array, relocate
-               the view relative to the (potentially) reallocated array */
-            insertTextRelocateOffset != ~std::size_t{} ? state.textData.sliceSize(insertTextRelocateOffset, insertText.size())
-                : insertText,
-            text.sliceSize(insertOffset, insertText.size()));
-    }
+            copySrcBegin[2] = removeSize + insertOffset;
+            copyDstBegin[2] = insertOffset + insertText.size();
+        }
+        copySrcEnd[2] = previousRun.textSize;
+
+        /* Copy the bits of the previous text (potentially reallocated
+           somewhere), if not empty */
+        const Containers::StringView previousTextRelocated = state.textData.sliceSize(previousRun.textOffset, previousRun.textSize);
+        for(std::size_t i: {0, 1, 2}) {
+            const UnsignedInt size = copySrcEnd[i] - copySrcBegin[i];
+            if(size) Utility::copy(
+                previousTextRelocated.slice(copySrcBegin[i], copySrcEnd[i]),
+                text.sliceSize(copyDstBegin[i], size));
+        }
 
-    /* If the text has any glyphs, mark the original glyph run as unused. It'll
-       be removed during the next recompaction in doUpdate(). */
-    if(data.glyphRun != ~UnsignedInt{})
-        state.glyphRuns[data.glyphRun].glyphOffset = ~UnsignedInt{};
+        /* Copy the inserted text, if not empty */
+        if(insertText) {
+            Utility::copy(
+                /* If text to insert was a slice of our textData array,
+                   relocate the view relative to the (potentially) reallocated
+                   array */
+                insertTextRelocateOffset != ~std::size_t{} ? state.textData.sliceSize(insertTextRelocateOffset, insertText.size())
+                    : insertText,
+                text.sliceSize(insertOffset, insertText.size()));
+        }
 
-    /* Mark the previous run (potentially reallocated somewhere) as unused.
-       It'll be removed during the next recompaction run in doUpdate(). Save
-       the new run reference. */
-    state.textRuns[data.textRun].textOffset = ~UnsignedInt{};
-    data.textRun = textRun;
+        /* Mark the previous run (potentially reallocated somewhere) as
+           unused. It'll be removed during the next recompaction run in
+           doUpdate(). Save the new run reference. */
+        state.textRuns[data.textRun].textOffset = ~UnsignedInt{};
+        state.firstUnusedTextRun = Math::min(state.firstUnusedTextRun, data.textRun);
+        data.textRun = textRun;
+    }
 
     /* Shape the new text using properties saved in the edit data and mark the
        layer as needing an update. Forming a TextProperties from the internal
@@ -1848,7 +2591,22 @@ void TextLayer::updateTextInternal(const UnsignedInt id, const UnsignedInt remov
     /* Similarly, the direction is both the layout and shape directions
        together, verbatim copy them back */
     properties._direction = editData.direction;
-    shapeTextInternal(id, data.style, text, properties, editData.font, data.flags);
+
+    /* If just a single line of a multi-line text was edited, try to reshape
+       only that line. If that isn't possible, or if the text has a single
+       line, mark the original glyph run as unused, if the text has any
+       glyphs, and reshape the whole text. The unused run will be removed
+       during the next recompaction in doUpdate(). */
+    if(lineCount == 1 || !shapeTextLineInternal(id, text, properties, editData.font, lineBegin, previousLineEnd - removeSize + insertText.size(), previousLine, lineIndex, lineCount)) {
+        if(data.glyphRun != ~UnsignedInt{}) {
+            Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[data.glyphRun];
+            glyphRun.glyphOffset = ~UnsignedInt{};
+            state.unusedGlyphCount += glyphRun.glyphCount;
+            state.firstUnusedGlyphRun = Math::min(state.firstUnusedGlyphRun, data.glyphRun);
+        }
+
+        shapeTextInternal(id, data.style, text, properties, editData.font, data.flags);
+    }
 
     /* Update the cursor position and all related state */
     setCursorInternal(id, cursor, selection);
@@ -2123,13 +2881,19 @@ void TextLayer::setGlyphInternal(const UnsignedInt id, const UnsignedInt glyph,
        setTextInternal() could do that too), but this way makes the
        often-updated data clustered to the end, allowing potential savings in
        data upload. */
-    if(data.glyphRun != ~UnsignedInt{})
-        state.glyphRuns[data.glyphRun].glyphOffset = ~UnsignedInt{};
+    if(data.glyphRun != ~UnsignedInt{}) {
+        Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[data.glyphRun];
+        glyphRun.glyphOffset = ~UnsignedInt{};
+        state.unusedGlyphCount += glyphRun.glyphCount;
+        state.firstUnusedGlyphRun = Math::min(state.firstUnusedGlyphRun, data.glyphRun);
+    }
 
     /* If there's a text run, mark it as unused as well; it'll be removed in
        doUpdate() too */
-    if(data.textRun != ~UnsignedInt{})
+    if(data.textRun != ~UnsignedInt{}) {
         state.textRuns[data.textRun].textOffset = ~UnsignedInt{};
+        state.firstUnusedTextRun = Math::min(state.firstUnusedTextRun, data.textRun);
+    }
 
     /* If there were edit data before, put them on the free list. Unlike with
        setTextInternal(), where shapeRememberTextInternal() may reuse the edit
@@ -2182,7 +2946,7 @@ void TextLayer::setColor(const LayerDataHandle handle, const Color4& color) {
 
 void TextLayer::setColorInternal(const UnsignedInt id, const Color4& color) {
     static_cast<State&>(*_state).data[id].color = color;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 }
 
 Vector4 TextLayer::padding(const DataHandle handle) const {
@@ -2221,7 +2985,7 @@ void TextLayer::setPaddingInternal(const UnsignedInt id, const Vector4& padding)
     CORRADE_ASSERT(!(state.flags >= TextLayerFlag::Transformable),
         "Ui::TextLayer::setPadding(): per-data padding not available on a" << TextLayerFlag::Transformable << "layer", );
     state.data[id].padding = padding;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
 
     /* If the the text is attached, trigger also layout update. Padding cannot
        be set for a transformable layer, that's already asserted above. */
@@ -2274,7 +3038,7 @@ void TextLayer::setTransformationInternal(const UnsignedInt id, const Vector2& t
     CORRADE_ASSERT(state.flags >= TextLayerFlag::Transformable,
         "Ui::TextLayer::setTransformation(): layer isn't" << TextLayerFlag::Transformable, );
     state.data[id].transformation = {translation, rotation*scaling};
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
     /* Transformable layer isn't providing layout properties, so no
        NeedsLayoutUpdate here */
     CORRADE_INTERNAL_DEBUG_ASSERT(!(features() >= LayerFeature::Layout));
@@ -2297,7 +3061,7 @@ void TextLayer::translateInternal(const UnsignedInt id, const Vector2& translati
     CORRADE_ASSERT(state.flags >= TextLayerFlag::Transformable,
         "Ui::TextLayer::translate(): layer isn't" << TextLayerFlag::Transformable, );
     state.data[id].transformation.translation += translation;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
     /* Transformable layer isn't providing layout properties, so no
        NeedsLayoutUpdate here */
     CORRADE_INTERNAL_DEBUG_ASSERT(!(features() >= LayerFeature::Layout));
@@ -2329,7 +3093,7 @@ void TextLayer::rotateInternal(const UnsignedInt id, const Complex& rotation) {
         "Ui::TextLayer::rotate(): layer isn't" << TextLayerFlag::Transformable, );
     Implementation::TextLayerData::Transformation& transformation = state.data[id].transformation;
     transformation.rotationScaling = rotation*transformation.rotationScaling;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
     /* Transformable layer isn't providing layout properties, so no
        NeedsLayoutUpdate here */
     CORRADE_INTERNAL_DEBUG_ASSERT(!(features() >= LayerFeature::Layout));
@@ -2352,7 +3116,7 @@ void TextLayer::scaleInternal(const UnsignedInt id, const Float scaling) {
     CORRADE_ASSERT(state.flags >= TextLayerFlag::Transformable,
         "Ui::TextLayer::scale(): layer isn't" << TextLayerFlag::Transformable, );
     state.data[id].transformation.rotationScaling *= scaling;
-    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    setNeedsDataUpdate(id);
     /* Transformable layer isn't providing layout properties, so no
        NeedsLayoutUpdate here */
     CORRADE_INTERNAL_DEBUG_ASSERT(!(features() >= LayerFeature::Layout));
@@ -2419,10 +3183,14 @@ void TextLayer::doAdvanceAnimations(const Nanoseconds time, const Containers::Mu
             factorStorage.prefix(capacity),
             removeStorage.prefix(capacity),
             state.dynamicStyleUniforms,
+            stridedArrayView(state.dynamicStyleInterpolations).slice(&Implementation::TextLayerStyleInterpolation::uniforms),
+            stridedArrayView(state.dynamicStyleInterpolations).slice(&Implementation::TextLayerStyleInterpolation::factor),
             state.dynamicStyleCursorStyles,
             state.dynamicStyleSelectionStyles,
             stridedArrayView(state.dynamicStyles).slice(&Implementation::TextLayerDynamicStyle::padding),
             state.dynamicEditingStyleUniforms,
+            stridedArrayView(state.dynamicEditingStyleInterpolations).slice(&Implementation::TextLayerStyleInterpolation::uniforms),
+            stridedArrayView(state.dynamicEditingStyleInterpolations).slice(&Implementation::TextLayerStyleInterpolation::factor),
             state.dynamicEditingStylePaddings,
             stridedArrayView(state.data).slice(&Implementation::TextLayerData::style));
     }
@@ -2441,6 +3209,14 @@ void TextLayer::doAdvanceAnimations(const Nanoseconds time, const Containers::Mu
         setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
         state.dynamicEditingStyleChanged = true;
     }
+    if(updates >= TextLayerStyleAnimatorUpdate::Interpolation) {
+        setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+        state.dynamicStyleInterpolationChanged = true;
+    }
+    if(updates >= TextLayerStyleAnimatorUpdate::EditingInterpolation) {
+        setNeedsUpdate(LayerState::NeedsCommonDataUpdate);
+        state.dynamicEditingStyleInterpolationChanged = true;
+    }
 }
 
 void TextLayer::doLayout(const Containers::BitArrayView dataIdsToLayout, const Containers::StridedArrayView1D<Vector2>& nodeMinSizes, const Containers::StridedArrayView1D<Vector2>&, const Containers::StridedArrayView1D<Float>&, const Containers::StridedArrayView1D<Vector4>&, const Containers::StridedArrayView1D<Vector4>&) {
@@ -2507,23 +3283,60 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
     CORRADE_ASSERT(!sharedState.hasEditingStyles || sharedState.setEditingStyleCalled,
         "Ui::TextLayer::update(): no editing style data was set", );
 
+    /* If the data update was caused only by per-data setters such as
+       setColor(), setPadding() or setStyle(), just the marked data get their
+       vertices regenerated. That's not possible if any of them is editable,
+       as the style affects whether the cursor and selection quads are drawn
+       and thus the editing index data of all other data as well. */
+    bool dirtyDataOnly = state.updateDirtyDataOnly;
+    const Containers::BitArrayView dirtyData = state.dirtyData;
+    if(dirtyDataOnly) for(const UnsignedInt id: dataIds) {
+        if(dirtyData[id] && state.data[id].editData != ~UnsignedInt{}) {
+            dirtyDataOnly = false;
+            break;
+        }
+    }
+
     /* Recompact the glyph / text data by removing unused runs. Do this only if
-       data actually change, this isn't affected by anything node-related */
+       data actually change, this isn't affected by anything node-related.
+       Runs before the first one that got marked as unused since the last
+       recompaction stay where they are, which makes this a no-op for all
+       irrelevant style / color / ... updates, and cheap when just a small set
+       of data is repeatedly updated as those stay at the end. Additionally,
+       if the unused glyphs don't make up enough of the glyph data yet, the
+       glyph recompaction is postponed. The unused runs aren't referenced from
+       anywhere and the vertex data are sized for all glyph data below, so
+       leaving them there is harmless. */
     /** @todo further restrict this to just NeedsCommonDataUpdate which gets
         set by setText(), remove() etc that actually produces unused runs, but
         not setColor() and such? the recompaction however implies a need to
         update the actual index buffer etc anyway, so a dedicated state won't
         make that update any smaller, and we'd now trigger it from clean() and
         remove() as well, which we didn't need to before */
-    /** @todo or, rather, maintain an index of the lowest glyph / text run that
-        got marked as unused and recompact only from there, which makes this a
-        no-op for all irrelevent style / color / ... updates, and much more
-        performant when just a small set of data is repeatedly updated as those
-        will stay at the end */
-    if(states >= LayerState::NeedsDataUpdate) {
+    if(states >= LayerState::NeedsDataUpdate && !dirtyDataOnly &&
+       state.firstUnusedGlyphRun != ~UnsignedInt{} &&
+       Float(state.unusedGlyphCount) >= sharedState.recompactionThreshold*Float(state.glyphData.size()))
+    {
+        /* The runs are ordered by offset and the glyph data contain nothing
+           else than the runs, so the first unused run starts where the
+           previous one ends */
+        /* Glyphs pending to be added to the glyph cache reference the runs by
+           their ID, which changes. Discard those in unused runs, the rest
+           gets updated from the data after. */
+        for(Implementation::TextLayerPendingGlyph& glyph: state.pendingGlyphs) {
+            const Implementation::TextLayerGlyphRun& run = state.glyphRuns[glyph.glyphRun];
+            if(run.glyphOffset == ~UnsignedInt{} || run.data != glyph.data)
+                glyph.glyphRun = ~UnsignedInt{};
+        }
+
+        std::size_t outputGlyphRunOffset = state.firstUnusedGlyphRun;
         std::size_t outputGlyphDataOffset = 0;
-        std::size_t outputGlyphRunOffset = 0;
-        for(std::size_t i = 0; i != state.glyphRuns.size(); ++i) {
+        if(outputGlyphRunOffset) {
+            const Implementation::TextLayerGlyphRun& previousRun = state.glyphRuns[outputGlyphRunOffset - 1];
+            CORRADE_INTERNAL_DEBUG_ASSERT(previousRun.glyphOffset != ~UnsignedInt{});
+            outputGlyphDataOffset = previousRun.glyphOffset + previousRun.glyphCount;
+        }
+        for(std::size_t i = outputGlyphRunOffset; i != state.glyphRuns.size(); ++i) {
             Implementation::TextLayerGlyphRun& run = state.glyphRuns[i];
             if(run.glyphOffset == ~UnsignedInt{})
                 continue;
@@ -2559,13 +3372,36 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         CORRADE_INTERNAL_ASSERT(outputGlyphRunOffset <= state.glyphRuns.size());
         arrayResize(state.glyphData, outputGlyphDataOffset);
         arrayResize(state.glyphRuns, outputGlyphRunOffset);
+        state.firstUnusedGlyphRun = ~UnsignedInt{};
+        state.unusedGlyphCount = 0;
+
+        std::size_t outputPendingGlyphOffset = 0;
+        for(const Implementation::TextLayerPendingGlyph& glyph: state.pendingGlyphs) {
+            if(glyph.glyphRun == ~UnsignedInt{})
+                continue;
+            Implementation::TextLayerPendingGlyph& output = state.pendingGlyphs[outputPendingGlyphOffset++];
+            output = glyph;
+            output.glyphRun = state.data[glyph.data].glyphRun;
+        }
+        arrayResize(state.pendingGlyphs, outputPendingGlyphOffset);
     }
     /* Another scope to avoid accidental variable reuse, flattening it to avoid
-       excessive indentation */
-    if(states & LayerState::NeedsDataUpdate) {
+       excessive indentation. The text runs are always recompacted on a full
+       data update, as the editing vertex data are sized based on their
+       count. With just the marked data being updated no text runs get
+       created, so the editing vertex data size stays the same. */
+    if(states >= LayerState::NeedsDataUpdate && !dirtyDataOnly &&
+       state.firstUnusedTextRun != ~UnsignedInt{})
+    {
+        std::size_t outputTextRunOffset = state.firstUnusedTextRun;
         std::size_t outputTextDataOffset = 0;
-        std::size_t outputTextRunOffset = 0;
-        for(std::size_t i = 0; i != state.textRuns.size(); ++i) {
+        if(outputTextRunOffset) {
+            const Implementation::TextLayerTextRun& previousRun = state.textRuns[outputTextRunOffset - 1];
+            CORRADE_INTERNAL_DEBUG_ASSERT(previousRun.textOffset != ~UnsignedInt{});
+            /* Including the null terminator */
+            outputTextDataOffset = previousRun.textOffset + previousRun.textSize + 1;
+        }
+        for(std::size_t i = outputTextRunOffset; i != state.textRuns.size(); ++i) {
             Implementation::TextLayerTextRun& run = state.textRuns[i];
             if(run.textOffset == ~UnsignedInt{})
                 continue;
@@ -2607,6 +3443,7 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         CORRADE_INTERNAL_ASSERT(outputTextRunOffset <= state.textRuns.size());
         arrayResize(state.textData, outputTextDataOffset);
         arrayResize(state.textRuns, outputTextRunOffset);
+        state.firstUnusedTextRun = ~UnsignedInt{};
 
         /* As currently there should be exactly one text run for each editable
            text, the count of used `state.editData` items should match the size
@@ -2615,10 +3452,11 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
     }
 
     /* Fill in indices in desired order if either the data themselves or the
-       node order changed. Keep the checks in sync with
-       TextLayerGL::doUpdate(). */
+       node order changed. The marked data alone don't change the glyph count
+       or order, so the indices stay the same in that case. Keep the checks in
+       sync with TextLayerGL::doUpdate(). */
     if(states >= LayerState::NeedsNodeOrderUpdate ||
-       states >= LayerState::NeedsDataUpdate)
+       (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly))
     {
         /* Index offsets for each run, plus one more for the last run */
         arrayResize(state.indexDrawOffsets, NoInit, dataIds.size() + 1);
@@ -2735,33 +3573,54 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
         CORRADE_INTERNAL_ASSERT(indexOffset == drawGlyphCount*6);
         CORRADE_INTERNAL_ASSERT(editingRectOffset == drawEditingRectCount);
         state.indexDrawOffsets[dataIds.size()] = {indexOffset, editingRectOffset*6};
+
+        /* All indices got regenerated, so all of them have to be uploaded */
+        state.indexDirtyRange.add(0, state.indices.size()*sizeof(UnsignedInt));
+        state.editingIndexDirtyRange.add(0, state.editingIndices.size()*sizeof(UnsignedInt));
     }
 
     /* Fill in vertex data if the data themselves, the node offset/size or node
        enablement (and thus calculated styles) or opacities (and thus
-       calculated colors) changed. Keep the checks in sync with
-       TextLayerGL::doUpdate(). */
+       calculated colors) changed. If only the marked data changed, only their
+       vertices are regenerated and added to the dirty range. Keep the checks
+       in sync with TextLayerGL::doUpdate(). */
     /** @todo split this further to just position-related data update and other
         data if it shows to help with perf */
-    if(states >= LayerState::NeedsNodeOffsetSizeUpdate ||
-       states >= LayerState::NeedsNodeEnabledUpdate ||
-       states >= LayerState::NeedsNodeOpacityUpdate ||
-       states >= LayerState::NeedsDataUpdate)
-    {
-        /* Calculate how many glyphs there are in total */
-        UnsignedInt totalGlyphCount = 0;
-        for(const Implementation::TextLayerGlyphRun& run: state.glyphRuns)
-            totalGlyphCount += run.glyphCount;
+    const bool updateAllVertices =
+        states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+        states >= LayerState::NeedsNodeEnabledUpdate ||
+        states >= LayerState::NeedsNodeOpacityUpdate ||
+        (states >= LayerState::NeedsDataUpdate && !dirtyDataOnly);
+    if(updateAllVertices || states >= LayerState::NeedsDataUpdate) {
+        /* The vertex data are indexed by glyph offsets, so they have to span
+           all glyph data including unused runs that weren't recompacted
+           yet */
+        const std::size_t totalGlyphCount = state.glyphData.size();
 
         const Containers::StridedArrayView1D<const Ui::NodeHandle> nodes = this->nodes();
 
         /* Resize the vertex array to fit all data, make a view on the common
-           type prefix */
-        const std::size_t typeSize = sharedState.flags >= TextLayerSharedFlag::DistanceField ?
-            sizeof(Implementation::TextLayerDistanceFieldVertex) :
-            sizeof(Implementation::TextLayerVertex);
+           type prefix. With compact vertices the common prefix is different
+           and each glyph run is first generated into a scratch array of the
+           full vertex type, packed only once all its properties are known. */
+        const bool compactVertices = sharedState.flags >= TextLayerSharedFlag::CompactVertices;
+        const bool distanceField = sharedState.flags >= TextLayerSharedFlag::DistanceField;
+        const std::size_t typeSize = compactVertices ?
+            (distanceField ?
+                sizeof(Implementation::TextLayerCompactDistanceFieldVertex) :
+                sizeof(Implementation::TextLayerCompactVertex)) :
+            (distanceField ?
+                sizeof(Implementation::TextLayerDistanceFieldVertex) :
+                sizeof(Implementation::TextLayerVertex));
         arrayResize(state.vertices, NoInit, totalGlyphCount*4*typeSize);
-        const Containers::StridedArrayView1D<Implementation::TextLayerVertex> vertices{
+        Containers::StridedArrayView1D<Implementation::TextLayerVertex> vertices;
+        Containers::StridedArrayView1D<Implementation::TextLayerCompactVertex> verticesCompact;
+        if(compactVertices) verticesCompact = {
+            state.vertices,
+            reinterpret_cast<Implementation::TextLayerCompactVertex*>(state.vertices.data()),
+            state.vertices.size()/typeSize,
+            std::ptrdiff_t(typeSize)};
+        else vertices = {
             state.vertices,
             reinterpret_cast<Implementation::TextLayerVertex*>(state.vertices.data()),
             state.vertices.size()/typeSize,
@@ -2771,20 +3630,32 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
            if distance field is enabled. Doing it like this instead of casting
            the typeless state.vertices array to ensure it's not accidentally in
            some entirely different type. */
-        const Containers::ArrayView<Implementation::TextLayerDistanceFieldVertex> distanceFieldVertices = sharedState.flags >= TextLayerSharedFlag::DistanceField ?
+        const Containers::ArrayView<Implementation::TextLayerDistanceFieldVertex> distanceFieldVertices = distanceField && !compactVertices ?
             Containers::arrayCast<Implementation::TextLayerDistanceFieldVertex>(vertices).asContiguous() :
             nullptr;
+        const Containers::ArrayView<Implementation::TextLayerCompactDistanceFieldVertex> distanceFieldVerticesCompact = distanceField && compactVertices ?
+            Containers::arrayCast<Implementation::TextLayerCompactDistanceFieldVertex>(verticesCompact).asContiguous() :
+            nullptr;
 
         /* If any selection or cursor style is present, make room in the
            editing vertex array as well. Using size of the text runs array and
            not of `state.editData`, as those were recompacted at the top of
            this function to be without gaps and with a smaller size bound than
            editData, thus better suited for sizing a vertex array */
-        if(sharedState.hasEditingStyles)
+        if(sharedState.hasEditingStyles) {
             arrayResize(state.editingVertices, NoInit, state.textRuns.size()*2*4);
+            /* Not tracking the editing quads individually, there's usually
+               just a handful of them. The marked data are never editable, see
+               `dirtyDataOnly` above, so they don't need any update then. */
+            if(updateAllVertices)
+                state.editingVertexDirtyRange.add(0, state.editingVertices.size()*sizeof(Implementation::TextLayerEditingVertex));
+        }
 
         /* Generate vertex data */
         for(const UnsignedInt dataId: dataIds) {
+            if(!updateAllVertices && !dirtyData[dataId])
+                continue;
+
             const UnsignedInt nodeId = nodeHandleId(nodes[dataId]);
             const Implementation::TextLayerData& data = state.data[dataId];
 
@@ -2800,7 +3671,12 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                 /** @todo ideally this would only be done if some text actually
                     changes, not on every visibility change */
                 glyphData = state.glyphData.sliceSize(glyphRun.glyphOffset, glyphRun.glyphCount);
-                vertexData = vertices.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4);
+                if(compactVertices) {
+                    if(state.compactVertexScratch.size() < glyphRun.glyphCount*4)
+                        state.compactVertexScratch = Containers::Array<Implementation::TextLayerVertex>{NoInit, glyphRun.glyphCount*4};
+                    vertexData = state.compactVertexScratch.prefix(glyphRun.glyphCount*4);
+                } else vertexData = vertices.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4);
+                state.vertexDirtyRange.add(glyphRun.glyphOffset*4*typeSize, (glyphRun.glyphOffset + glyphRun.glyphCount)*4*typeSize);
                 Text::renderGlyphQuadsInto(
                     sharedState.glyphCache,
                     glyphRun.scale,
@@ -2813,7 +3689,7 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                    field rendering if enabled */
                 /** @todo again ideally this would only be done if some text
                     actually changes, not on every visibility change */
-                if(sharedState.flags >= TextLayerSharedFlag::DistanceField) {
+                if(distanceField) {
                     /* We very neatly save four bytes and two multiplications
                        per data by combining transformation scaling with the
                        rotation. Unfortunately for distance field we then need
@@ -2822,7 +3698,9 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                     const Float invertedRunScale = 1.0f/(glyphRun.scale*
                         (state.flags >= TextLayerFlag::Transformable ?
                             data.transformation.rotationScaling.length() : 1.0f));
-                    for(Implementation::TextLayerDistanceFieldVertex& i: distanceFieldVertices.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4))
+                    if(compactVertices) for(Implementation::TextLayerCompactDistanceFieldVertex& i: distanceFieldVerticesCompact.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4))
+                        i.invertedRunScale = invertedRunScale;
+                    else for(Implementation::TextLayerDistanceFieldVertex& i: distanceFieldVertices.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4))
                         i.invertedRunScale = invertedRunScale;
                 }
             }
@@ -2870,34 +3748,25 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                     offset.y() += size.y()*0.5f;
             } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-            /* Fill color and style */
-            const Float opacity = nodeOpacities[nodeId];
-            for(Implementation::TextLayerVertex& vertex: vertexData) {
-                vertex.color = data.color*opacity;
-                /* For dynamic styles the uniform mapping is implicit and
-                   they're placed right after all non-dynamic styles */
-                vertex.styleUniform = data.calculatedStyle < sharedState.styleCount ?
+            /* Fill color and style. For dynamic styles the uniform mapping is
+               implicit and they're placed right after all non-dynamic
+               styles. */
+            state.fillGlyphVertexColorStyle(vertexData,
+                data.color*nodeOpacities[nodeId],
+                data.calculatedStyle < sharedState.styleCount ?
                     sharedState.styles[data.calculatedStyle].uniform :
-                    sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount;
-            }
-
-            /* Translate the (aligned) glyph run. If transformation is enabled,
-               first perform a full transformation relative to the glyph run
-               origin. The glyph quad coordinates are produced with Y up, and
-               the Y flip makes them consistent with the UI coordinate system
-               being Y down. In case of the transformation the Y flip is done
-               even before rotation, which then causes positive rotation angle
-               to be interpreted clockwise without needing to do any additional
-               sign flips. */
-            if(state.flags >= TextLayerFlag::Transformable) {
-                /** @todo batch, SIMD-infused utility for this */
-                const Vector2 translation = offset + data.transformation.translation;
-                for(Implementation::TextLayerVertex& vertex: vertexData)
-                    vertex.position = translation + data.transformation.rotationScaling.transformVector(vertex.position*Vector2::yScale(-1.0f));
-            } else {
-                for(Implementation::TextLayerVertex& vertex: vertexData)
-                    vertex.position = offset + vertex.position*Vector2::yScale(-1.0f);
-            }
+                    sharedState.styleUniformCount + data.calculatedStyle - sharedState.styleCount);
+
+            /* Translate the (aligned) glyph run, flipping it to be Y down. If
+               transformation is enabled, first perform a full transformation
+               relative to the glyph run origin. */
+            const Containers::StridedArrayView1D<Vector2> vertexPositions = vertexData.slice(&Implementation::TextLayerVertex::position);
+            if(state.flags >= TextLayerFlag::Transformable)
+                state.transformGlyphVertexPositions(vertexPositions,
+                    offset + data.transformation.translation,
+                    data.transformation.rotationScaling);
+            else
+                state.translateGlyphVertexPositions(vertexPositions, offset);
 
             /* If the text is editable, generate also the cursor and selection
                mesh, unless they don't have any style */
@@ -3029,6 +3898,14 @@ void TextLayer::doUpdate(const LayerStates states, const Containers::StridedArra
                         nodeOpacities[nodeId]);
                 }
             }
+
+            /* With compact vertices pack the scratch glyph run vertices only
+               now, after the editing styles possibly overrode the style
+               uniform for the selected range */
+            if(compactVertices && data.glyphRun != ~UnsignedInt{}) {
+                const Implementation::TextLayerGlyphRun& glyphRun = state.glyphRuns[data.glyphRun];
+                packGlyphVertices(vertexData, verticesCompact.sliceSize(glyphRun.glyphOffset*4, glyphRun.glyphCount*4));
+            }
         }
     }
 
@@ -1631,6 +1631,14 @@ animation to be subsequently automatically discarded again, as described in
 
 @snippet Ui.cpp TextLayer-style-animations
 
+Every running animation occupies a dynamic style, whose uniform contents are by
+default interpolated on the CPU and uploaded to the GPU every frame, including
+the editing style uniforms and the selected text uniform overrides. Similarly
+to @ref Ui-BaseLayer-performance-animations "the BaseLayer equivalent",
+enabling @ref TextLayerSharedFlag::ShaderStyleAnimation moves the
+interpolation to the shader, with just a single factor per dynamic uniform
+updated every frame.
+
 @section Ui-TextLayer-debug-integration Debug layer integration
 
 When using @ref Ui-DebugLayer-node-inspect "DebugLayer node inspect" and
@@ -2686,6 +2694,13 @@ class MAGNUM_UI_EXPORT TextLayer: public AbstractVisualLayer {
          * If the text actually changes and a text edit callback is set with
          * @ref setTextEditCallback() it's called with the new text.
          *
+         * If the text consists of multiple lines and the removed and inserted
+         * text are both within a single line and don't contain any newline
+         * characters, only that line gets reshaped, which makes editing of
+         * large texts significantly cheaper. If the line was the widest in the
+         * text and it gets narrower, the whole text is reshaped in order to
+         * calculate the new text size.
+         *
          * Calling this function causes @ref LayerState::NeedsDataUpdate to be
          * set, unless the operation performed is a no-op, which is when both
          * @p removeSize and @p insertText size are both @cpp 0 @ce and
@@ -2942,6 +2957,32 @@ class MAGNUM_UI_EXPORT TextLayer: public AbstractVisualLayer {
             return setGlyph(handle, UnsignedInt(glyph), properties);
         }
 
+        /**
+         * @brief Count of glyphs waiting to be added to the glyph cache
+         *
+         * Non-zero only if @ref TextLayerSharedFlag::FillGlyphCacheDeferred
+         * is enabled. Counts each occurence in each text, and may include
+         * glyphs of data that were removed or had their text changed since,
+         * which get discarded in the next @ref fillPendingGlyphs() call.
+         */
+        std::size_t pendingGlyphCount() const;
+
+        /**
+         * @brief Add pending glyphs to the glyph cache
+         * @return Count of glyphs added to the glyph cache
+         *
+         * Rasterizes at most @p count distinct glyphs from
+         * @ref pendingGlyphCount() into the glyph cache with
+         * @ref Text::AbstractFont::fillGlyphCache() and updates texts
+         * referencing them, the remaining ones stay pending for the next call.
+         * Meant to be called once a frame, outside of the time-critical part,
+         * with @p count limiting how much time is spent on rasterization in a
+         * single frame. If any texts were updated, causes
+         * @ref LayerState::NeedsDataUpdate to be set.
+         * @see @ref TextLayerSharedFlag::FillGlyphCacheDeferred
+         */
+        std::size_t fillPendingGlyphs(std::size_t count);
+
         /**
          * @brief Custom text base color
          *
@@ -3313,6 +3354,7 @@ class MAGNUM_UI_EXPORT TextLayer: public AbstractVisualLayer {
             UnsignedInt id, const TextLayerEditingStyleUniform& uniform, const Containers::Optional<TextLayerStyleUniform>& textUniform, const Vector4& padding);
         MAGNUM_UI_LOCAL DataHandle createInternal(NodeHandle node);
         MAGNUM_UI_LOCAL void shapeTextInternal(UnsignedInt id, UnsignedInt style, Containers::StringView text, const TextProperties& properties, FontHandle font, TextDataFlags flags);
+        MAGNUM_UI_LOCAL bool shapeTextLineInternal(UnsignedInt id, Containers::StringView text, const TextProperties& properties, FontHandle font, UnsignedInt lineBegin, UnsignedInt lineEnd, Containers::StringView previousLine, UnsignedInt lineIndex, UnsignedInt lineCount);
         MAGNUM_UI_LOCAL void shapeRememberTextInternal(
             #ifndef CORRADE_NO_ASSERT
             const char* messagePrefix,
@@ -3377,7 +3419,75 @@ enum class TextLayerSharedFlag: UnsignedByte {
      * or @ref TextLayerGL::Shared::Shared(Text::GlyphCacheArrayGL&&, const Configuration&)
      * constructors.
      */
-    DistanceField = 1 << 0
+    DistanceField = 1 << 0,
+
+    /**
+     * Fill the glyph cache on demand. If a shaped text or a glyph passed to
+     * @ref TextLayer::create(UnsignedInt, UnsignedInt, NodeHandle, const TextProperties&)
+     * references glyphs that aren't in the glyph cache yet, they're
+     * rasterized into it with @ref Text::AbstractFont::fillGlyphCache()
+     * right away, so they're available for the next draw. Makes it possible
+     * to not prefill the cache upfront, which is impractical for scripts with
+     * large glyph sets. Applies only to fonts added with an instance, which
+     * is expected to implement glyph cache filling.
+     *
+     * The glyph cache doesn't support removing glyphs, so once it runs out of
+     * space, the failure is printed and no further on-demand filling is
+     * attempted for given font, with the missing glyphs not being drawn.
+     */
+    FillGlyphCacheOnDemand = 1 << 1,
+
+    /**
+     * Defer on-demand filling of the glyph cache. Compared to
+     * @ref TextLayerSharedFlag::FillGlyphCacheOnDemand, which this flag
+     * implies, glyphs missing from the cache are only remembered in shaped
+     * text, and are rasterized into the cache and made visible in the text
+     * with @ref TextLayer::fillPendingGlyphs(), which makes it possible to
+     * spread the rasterization cost over multiple frames instead of stalling
+     * the frame in which the text appeared. Until then, the missing glyphs
+     * aren't drawn. Glyphs passed to
+     * @ref TextLayer::createGlyph() are still filled right away, as their
+     * size is needed for aligning them.
+     */
+    FillGlyphCacheDeferred = FillGlyphCacheOnDemand|(1 << 2),
+
+    /**
+     * Use a compact vertex format. Texture coordinates are stored as
+     * normalized 16-bit values, texture layer and style uniform index as
+     * 16-bit integers and the color as normalized 8-bit values, halving the
+     * vertex data size and thus also the amount of data uploaded to the GPU
+     * on every update. Positions stay 32-bit floats as they're in absolute UI
+     * coordinates at that point, where 16-bit precision wouldn't be enough
+     * for large UIs.
+     *
+     * The total count of style uniforms, including the extra uniforms for
+     * dynamic styles, is then expected to not exceed @cpp 65536 @ce, and
+     * neither the layer count of the glyph cache. The data color multiplied
+     * by node opacity is clamped to the @f$ [0, 1] @f$ range.
+     */
+    CompactVertices = 1 << 3,
+
+    /**
+     * Interpolate style animations in the shader. Equivalent to
+     * @ref BaseLayerSharedFlag::ShaderStyleAnimation --- instead of
+     * @ref TextLayerStyleAnimator calculating interpolated
+     * @ref TextLayerStyleUniform and @ref TextLayerEditingStyleUniform
+     * contents on the CPU every frame, each dynamic style uniform, each
+     * dynamic editing style uniform and each uniform override for selected
+     * text references a source and target uniform together with an
+     * interpolation factor, and the shaders blend between the two. A running
+     * animation then updates just the factors. Dynamic styles set with
+     * @ref TextLayer::setDynamicStyle() and related APIs reference just
+     * themselves and are drawn the same as without this flag. Style and
+     * editing style paddings are still interpolated on the CPU.
+     *
+     * Compared to the CPU interpolation, which interpolates just
+     * @ref TextLayerStyleUniform::color, all properties including outline
+     * color, outline width, edge offset and smoothness get interpolated. Has
+     * no effect if @ref TextLayer::Shared::Configuration::setDynamicStyleCount()
+     * is zero. See @ref Ui-TextLayer-style-animations for more information.
+     */
+    ShaderStyleAnimation = 1 << 4
 };
 
 /**
@@ -3485,6 +3595,68 @@ class MAGNUM_UI_EXPORT TextLayer::Shared: public AbstractVisualLayer::Shared {
         Text::AbstractGlyphCache& glyphCache();
         const Text::AbstractGlyphCache& glyphCache() const; /**< @overload */
 
+        /**
+         * @brief Recompaction threshold
+         *
+         * Fraction of unused glyph data at which @ref TextLayer::update()
+         * removes unused glyph runs.
+         * @see @ref Configuration::setRecompactionThreshold()
+         */
+        Float recompactionThreshold() const;
+
+        /**
+         * @brief Shape cache size
+         *
+         * Max count of shaping results remembered for reuse by all layers
+         * referencing this @ref Shared instance. If @cpp 0 @ce, the cache is
+         * disabled.
+         * @see @ref Configuration::setShapeCacheSize(),
+         *      @ref shapeCacheUsedCount()
+         */
+        UnsignedInt shapeCacheSize() const;
+
+        /**
+         * @brief Count of used shape cache entries
+         *
+         * Always at most @ref shapeCacheSize().
+         * @see @ref clearShapeCache()
+         */
+        UnsignedInt shapeCacheUsedCount() const;
+
+        /**
+         * @brief Count of shape cache hits
+         *
+         * Count of times a text was taken from the shape cache instead of
+         * being shaped again since this @ref Shared instance was created.
+         * Stays at @cpp 0 @ce if the cache is disabled.
+         * @see @ref shapeCacheMissCount(), @ref shapeCacheSize()
+         */
+        std::size_t shapeCacheHitCount() const;
+
+        /**
+         * @brief Count of shape cache misses
+         *
+         * Count of times a text had to be shaped and was then put into the
+         * shape cache since this @ref Shared instance was created. Texts with
+         * @ref TextDataFlag::Editable bypass the cache and aren't counted
+         * here. Stays at @cpp 0 @ce if the cache is disabled.
+         * @see @ref shapeCacheHitCount(), @ref shapeCacheSize()
+         */
+        std::size_t shapeCacheMissCount() const;
+
+        /**
+         * @brief Clear the shape cache
+         *
+         * Discards all shape cache entries, leaving hit and miss counters
+         * unchanged. The cache stores cache-global glyph IDs, which means
+         * that if the @ref glyphCache() gets new glyphs added for any fonts
+         * used by this instance, the cache should be cleared in order to
+         * not reuse shaping results referencing glyphs that weren't present
+         * in the glyph cache before. Has no effect if the cache is disabled.
+         * @see @ref shapeCacheUsedCount()
+         */
+        void clearShapeCache();
+
         /**
          * @brief Count of added fonts
          *
@@ -4078,6 +4250,59 @@ class MAGNUM_UI_EXPORT TextLayer::Shared::Configuration {
          */
         Configuration& setDynamicStyleCount(UnsignedInt count, bool withEditingStyles);
 
+        /** @brief Recompaction threshold */
+        Float recompactionThreshold() const { return _recompactionThreshold; }
+
+        /**
+         * @brief Set recompaction threshold
+         * @return Reference to self (for method chaining)
+         *
+         * Every time a text is removed or changed, its glyph run is marked
+         * as unused and the new glyphs are put at the end. Unused glyph runs
+         * are removed during @ref TextLayer::update(), going only from the
+         * first run that was marked as unused since the last removal, so
+         * texts that are frequently changed get eventually moved to the end
+         * and their changes don't cause the static data before them to be
+         * moved again. With a non-zero @p threshold the removal is
+         * additionally postponed until the unused glyphs make up at least
+         * given fraction of all glyph data, trading memory and vertex data
+         * size for fewer moves of the glyph data if a text in the middle is
+         * changed often. Expected to be in the @f$ [0, 1] @f$ range.
+         *
+         * Default is @cpp 0.0f @ce, i.e. unused glyph runs are removed on
+         * every update that follows a text removal or change.
+         */
+        Configuration& setRecompactionThreshold(Float threshold);
+
+        /** @brief Shape cache size */
+        UnsignedInt shapeCacheSize() const { return _shapeCacheSize; }
+
+        /**
+         * @brief Set shape cache size
+         * @return Reference to self (for method chaining)
+         *
+         * If non-zero, results of shaping non-editable text in
+         * @ref TextLayer::create(), @ref TextLayer::setText() and related
+         * APIs are remembered in a cache of given size shared among all
+         * layers referencing the @ref Shared instance. When a text with the
+         * same contents, font, script, language, shape and layout direction,
+         * alignment and font features is shaped again, the glyph positions,
+         * IDs and the bounding rectangle are taken from the cache instead of
+         * going through the font shaper. If the cache is full, the least
+         * recently used entry gets replaced. Texts with
+         * @ref TextDataFlag::Editable are never cached, as they need
+         * additional information that isn't stored in the cache.
+         *
+         * Default is @cpp 0 @ce, i.e. no caching.
+         * @see @ref Shared::shapeCacheHitCount(),
+         *      @ref Shared::shapeCacheMissCount(),
+         *      @ref Shared::clearShapeCache()
+         */
+        Configuration& setShapeCacheSize(UnsignedInt size) {
+            _shapeCacheSize = size;
+            return *this;
+        }
+
         /** @brief Shared layer flags */
         TextLayerSharedFlags flags() const { return _flags; }
 
@@ -4123,6 +4348,8 @@ class MAGNUM_UI_EXPORT TextLayer::Shared::Configuration {
         UnsignedInt _styleUniformCount, _styleCount;
         UnsignedInt _editingStyleUniformCount = 0, _editingStyleCount = 0;
         UnsignedInt _dynamicStyleCount = 0;
+        UnsignedInt _shapeCacheSize = 0;
+        Float _recompactionThreshold = 0.0f;
         TextLayerSharedFlags _flags;
         bool _dynamicEditingStyles = false;
 };
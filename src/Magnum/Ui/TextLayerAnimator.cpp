@@ -53,6 +53,8 @@ Debug& operator<<(Debug& debug, const TextLayerStyleAnimatorUpdate value) {
         _c(EditingUniform)
         _c(EditingPadding)
         _c(Style)
+        _c(Interpolation)
+        _c(EditingInterpolation)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -66,7 +68,9 @@ Debug& operator<<(Debug& debug, const TextLayerStyleAnimatorUpdates value) {
         TextLayerStyleAnimatorUpdate::Padding,
         TextLayerStyleAnimatorUpdate::EditingUniform,
         TextLayerStyleAnimatorUpdate::EditingPadding,
-        TextLayerStyleAnimatorUpdate::Style
+        TextLayerStyleAnimatorUpdate::Style,
+        TextLayerStyleAnimatorUpdate::Interpolation,
+        TextLayerStyleAnimatorUpdate::EditingInterpolation
     });
 }
 
@@ -101,6 +105,13 @@ struct Animation {
 
     UnsignedInt expectedStyle, sourceStyle, targetStyle, dynamicStyle;
 
+    /* Used instead of the uniforms above if
+       TextLayerSharedFlag::ShaderStyleAnimation is enabled */
+    UnsignedInt sourceUniformId, targetUniformId;
+    UnsignedInt sourceCursorUniformId, targetCursorUniformId;
+    UnsignedInt sourceSelectionUniformId, targetSelectionUniformId;
+    UnsignedInt sourceSelectionTextUniformId, targetSelectionTextUniformId;
+
     /** @todo pack the booleans to a single flag */
     bool hasCursorStyle,
         hasSelectionStyle;
@@ -233,6 +244,10 @@ TextLayerEditingStyleUniform interpolateUniform(const TextLayerEditingStyleUnifo
 }
 
 TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds time, const Containers::MutableBitArrayView active, const Containers::MutableBitArrayView started, const Containers::MutableBitArrayView stopped, const Containers::StridedArrayView1D<Float>& factors, const Containers::MutableBitArrayView remove, const Containers::ArrayView<TextLayerStyleUniform> dynamicStyleUniforms, const Containers::MutableBitArrayView dynamicStyleCursorStyles, const Containers::MutableBitArrayView dynamicStyleSelectionStyles, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::ArrayView<TextLayerEditingStyleUniform> dynamicEditingStyleUniforms, const Containers::StridedArrayView1D<Vector4>& dynamicEditingStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
+    return advance(time, active, started, stopped, factors, remove, dynamicStyleUniforms, {}, {}, dynamicStyleCursorStyles, dynamicStyleSelectionStyles, dynamicStylePaddings, dynamicEditingStyleUniforms, {}, {}, dynamicEditingStylePaddings, dataStyles);
+}
+
+TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds time, const Containers::MutableBitArrayView active, const Containers::MutableBitArrayView started, const Containers::MutableBitArrayView stopped, const Containers::StridedArrayView1D<Float>& factors, const Containers::MutableBitArrayView remove, const Containers::ArrayView<TextLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, const Containers::MutableBitArrayView dynamicStyleCursorStyles, const Containers::MutableBitArrayView dynamicStyleSelectionStyles, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, const Containers::ArrayView<TextLayerEditingStyleUniform> dynamicEditingStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicEditingStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicEditingStyleInterpolationFactors, const Containers::StridedArrayView1D<Vector4>& dynamicEditingStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles) {
     /* The time...remove fields are checked inside update() right below, no
        need to repeat the check here again, especially since it's an internal
        API */
@@ -282,6 +297,17 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                 "Ui::TextLayerStyleAnimator::advance(): expected dynamic style cursor style, selection style and padding views to have a size of" << layerSharedState.dynamicStyleCount << Debug::nospace << ", the dynamic style uniform view a size of" << layerSharedState.dynamicStyleCount*3 << Debug::nospace << ", and the dynamic editing style uniform and padding views a size of" << layerSharedState.dynamicStyleCount*2 << Debug::nospace << ", but got" << dynamicStyleCursorStyles.size() << Debug::nospace << "," << dynamicStyleSelectionStyles.size() << Debug::nospace << "," << dynamicStylePaddings.size() << Debug::nospace << ";" << dynamicStyleUniforms.size() << Debug::nospace << ";" << dynamicEditingStyleUniforms.size() << "and" << dynamicEditingStylePaddings.size(), {});
         }
         #endif
+        const bool interpolateInShader = layerSharedState.flags >= TextLayerSharedFlag::ShaderStyleAnimation;
+        #ifndef CORRADE_NO_ASSERT
+        const std::size_t expectedInterpolationCount = interpolateInShader ? dynamicStyleUniforms.size() : 0;
+        const std::size_t expectedEditingInterpolationCount = interpolateInShader ? dynamicEditingStyleUniforms.size() : 0;
+        #endif
+        CORRADE_ASSERT(
+            dynamicStyleInterpolationUniforms.size() == expectedInterpolationCount &&
+            dynamicStyleInterpolationFactors.size() == expectedInterpolationCount &&
+            dynamicEditingStyleInterpolationUniforms.size() == expectedEditingInterpolationCount &&
+            dynamicEditingStyleInterpolationFactors.size() == expectedEditingInterpolationCount,
+            "Ui::TextLayerStyleAnimator::advance(): expected dynamic style interpolation uniform and factor views to have a size of" << expectedInterpolationCount << "and dynamic editing style interpolation uniform and factor views a size of" << expectedEditingInterpolationCount << Debug::nospace << ", but got" << dynamicStyleInterpolationUniforms.size() << Debug::nospace << "," << dynamicStyleInterpolationFactors.size() << "and" << dynamicEditingStyleInterpolationUniforms.size() << Debug::nospace << "," << dynamicEditingStyleInterpolationFactors.size(), {});
         CORRADE_ASSERT(layerSharedState.setStyleCalled,
             "Ui::TextLayerStyleAnimator::advance(): no style data was set on the layer", {});
         /* Like in TextLayer::doUpdate(), technically needed only if there's
@@ -296,7 +322,9 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
         if(updatesBase.first())
             updates |= TextLayerStyleAnimatorUpdate::Style;
         if(updatesBase.second())
-            updates |= TextLayerStyleAnimatorUpdate::Uniform;
+            updates |= interpolateInShader ?
+                TextLayerStyleAnimatorUpdate::Interpolation :
+                TextLayerStyleAnimatorUpdate::Uniform;
 
         const Containers::StridedArrayView1D<const AnimationFlags> flags = this->flags();
 
@@ -326,8 +354,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                    *data* may still be the same even if the ID is different,
                    but checking for that is too much work and any reasonable
                    style should deduplicate those anyway. */
-                animation.sourceUniform = layerSharedState.styleUniforms[sourceStyleData.uniform];
-                animation.targetUniform = layerSharedState.styleUniforms[targetStyleData.uniform];
+                if(interpolateInShader) {
+                    animation.sourceUniformId = sourceStyleData.uniform;
+                    animation.targetUniformId = targetStyleData.uniform;
+                } else {
+                    animation.sourceUniform = layerSharedState.styleUniforms[sourceStyleData.uniform];
+                    animation.targetUniform = layerSharedState.styleUniforms[targetStyleData.uniform];
+                }
                 animation.uniformDifferent = sourceStyleData.uniform != targetStyleData.uniform;
 
                 /* Animate also cursor style, if present */
@@ -342,8 +375,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
 
                     /* Like with the base, remember if the actual uniform ID is
                        different to skip the interpolation */
-                    animation.sourceCursorUniform = layerSharedState.editingStyleUniforms[sourceEditingStyleData.uniform];
-                    animation.targetCursorUniform = layerSharedState.editingStyleUniforms[targetEditingStyleData.uniform];
+                    if(interpolateInShader) {
+                        animation.sourceCursorUniformId = sourceEditingStyleData.uniform;
+                        animation.targetCursorUniformId = targetEditingStyleData.uniform;
+                    } else {
+                        animation.sourceCursorUniform = layerSharedState.editingStyleUniforms[sourceEditingStyleData.uniform];
+                        animation.targetCursorUniform = layerSharedState.editingStyleUniforms[targetEditingStyleData.uniform];
+                    }
                     animation.cursorUniformDifferent = sourceEditingStyleData.uniform != targetEditingStyleData.uniform;
 
                     animation.hasCursorStyle = true;
@@ -363,8 +401,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                        different to skip the interpolation. OR that with the
                        difference from the cursor, as both lead to upload of
                        the same uniform buffer. */
-                    animation.sourceSelectionUniform = layerSharedState.editingStyleUniforms[sourceEditingStyleData.uniform];
-                    animation.targetSelectionUniform = layerSharedState.editingStyleUniforms[targetEditingStyleData.uniform];
+                    if(interpolateInShader) {
+                        animation.sourceSelectionUniformId = sourceEditingStyleData.uniform;
+                        animation.targetSelectionUniformId = targetEditingStyleData.uniform;
+                    } else {
+                        animation.sourceSelectionUniform = layerSharedState.editingStyleUniforms[sourceEditingStyleData.uniform];
+                        animation.targetSelectionUniform = layerSharedState.editingStyleUniforms[targetEditingStyleData.uniform];
+                    }
                     animation.selectionUniformDifferent = sourceEditingStyleData.uniform != targetEditingStyleData.uniform;
 
                     /* Finally, if the selection style references an override
@@ -373,8 +416,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                        difference. */
                     const UnsignedInt sourceTextUniform = sourceEditingStyleData.textUniform != -1 ? sourceEditingStyleData.textUniform : sourceStyleData.uniform;
                     const UnsignedInt targetTextUniform = targetEditingStyleData.textUniform != -1 ? targetEditingStyleData.textUniform : targetStyleData.uniform;
-                    animation.sourceSelectionTextUniform = layerSharedState.styleUniforms[sourceTextUniform];
-                    animation.targetSelectionTextUniform = layerSharedState.styleUniforms[targetTextUniform];
+                    if(interpolateInShader) {
+                        animation.sourceSelectionTextUniformId = sourceTextUniform;
+                        animation.targetSelectionTextUniformId = targetTextUniform;
+                    } else {
+                        animation.sourceSelectionTextUniform = layerSharedState.styleUniforms[sourceTextUniform];
+                        animation.targetSelectionTextUniform = layerSharedState.styleUniforms[targetTextUniform];
+                    }
                     animation.selectionTextUniformDifferent = sourceTextUniform != targetTextUniform;
 
                     animation.hasSelectionStyle = true;
@@ -426,7 +474,9 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                    advance() did it for TextLayerStyleAnimatorUpdate::Uniform
                    already, trigger it here for EditingUniform as well. */
                 if(animation.hasCursorStyle || animation.hasSelectionStyle)
-                    updates |= TextLayerStyleAnimatorUpdate::EditingUniform;
+                    updates |= interpolateInShader ?
+                        TextLayerStyleAnimatorUpdate::EditingInterpolation :
+                        TextLayerStyleAnimatorUpdate::EditingUniform;
 
                 /* If the animation is attached to some data, the above already
                    triggers a Style update, which results in appropriate
@@ -440,13 +490,25 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
 
             const Float factor = animation.easing(factors[i]);
 
+            /* If interpolating in the shader, reference the source and target
+               uniform and update just the factor. Same as below, if the source
+               and target uniforms are the same, the factor isn't reported as
+               changed, except for the first ever switch to the dynamic style
+               which is handled in the base advance() above. */
+            if(interpolateInShader) {
+                dynamicStyleInterpolationUniforms[animation.dynamicStyle] = {animation.sourceUniformId, animation.targetUniformId};
+                if(animation.uniformDifferent) {
+                    dynamicStyleInterpolationFactors[animation.dynamicStyle] = factor;
+                    updates |= TextLayerStyleAnimatorUpdate::Interpolation;
+                } else dynamicStyleInterpolationFactors[animation.dynamicStyle] = 0.0f;
+
             /* Interpolate the uniform. If the source and target uniforms were
                the same, just copy one of them and don't report that the
                uniforms got changed. The only exception is the first ever
                switch to the dynamic uniform in which case the data has to be
                uploaded. That's handled in the animation.styleDynamic
                allocation above. */
-            if(animation.uniformDifferent) {
+            } else if(animation.uniformDifferent) {
                 dynamicStyleUniforms[animation.dynamicStyle] = interpolateUniform(animation.sourceUniform, animation.targetUniform, factor);
                 updates |= TextLayerStyleAnimatorUpdate::Uniform;
             } else dynamicStyleUniforms[animation.dynamicStyle] = animation.targetUniform;
@@ -467,7 +529,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
             if(animation.hasCursorStyle) {
                 const UnsignedInt editingStyleId = Implementation::cursorStyleForDynamicStyle(animation.dynamicStyle);
 
-                if(animation.cursorUniformDifferent) {
+                if(interpolateInShader) {
+                    dynamicEditingStyleInterpolationUniforms[editingStyleId] = {animation.sourceCursorUniformId, animation.targetCursorUniformId};
+                    if(animation.cursorUniformDifferent) {
+                        dynamicEditingStyleInterpolationFactors[editingStyleId] = factor;
+                        updates |= TextLayerStyleAnimatorUpdate::EditingInterpolation;
+                    } else dynamicEditingStyleInterpolationFactors[editingStyleId] = 0.0f;
+                } else if(animation.cursorUniformDifferent) {
                     dynamicEditingStyleUniforms[editingStyleId] = interpolateUniform(animation.sourceCursorUniform, animation.targetCursorUniform, factor);
                     updates |= TextLayerStyleAnimatorUpdate::EditingUniform;
                 } else dynamicEditingStyleUniforms[editingStyleId] = animation.targetCursorUniform;
@@ -486,7 +554,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
             if(animation.hasSelectionStyle) {
                 const UnsignedInt editingStyleId = Implementation::selectionStyleForDynamicStyle(animation.dynamicStyle);
 
-                if(animation.selectionUniformDifferent) {
+                if(interpolateInShader) {
+                    dynamicEditingStyleInterpolationUniforms[editingStyleId] = {animation.sourceSelectionUniformId, animation.targetSelectionUniformId};
+                    if(animation.selectionUniformDifferent) {
+                        dynamicEditingStyleInterpolationFactors[editingStyleId] = factor;
+                        updates |= TextLayerStyleAnimatorUpdate::EditingInterpolation;
+                    } else dynamicEditingStyleInterpolationFactors[editingStyleId] = 0.0f;
+                } else if(animation.selectionUniformDifferent) {
                     dynamicEditingStyleUniforms[editingStyleId] = interpolateUniform(animation.sourceSelectionUniform, animation.targetSelectionUniform, factor);
                     updates |= TextLayerStyleAnimatorUpdate::EditingUniform;
                 } else dynamicEditingStyleUniforms[editingStyleId] = animation.targetSelectionUniform;
@@ -500,7 +574,13 @@ TextLayerStyleAnimatorUpdates TextLayerStyleAnimator::advance(const Nanoseconds
                 }
 
                 const UnsignedInt textStyleId = Implementation::selectionStyleTextUniformForDynamicStyle(layerSharedState.dynamicStyleCount, animation.dynamicStyle);
-                if(animation.selectionTextUniformDifferent) {
+                if(interpolateInShader) {
+                    dynamicStyleInterpolationUniforms[textStyleId] = {animation.sourceSelectionTextUniformId, animation.targetSelectionTextUniformId};
+                    if(animation.selectionTextUniformDifferent) {
+                        dynamicStyleInterpolationFactors[textStyleId] = factor;
+                        updates |= TextLayerStyleAnimatorUpdate::Interpolation;
+                    } else dynamicStyleInterpolationFactors[textStyleId] = 0.0f;
+                } else if(animation.selectionTextUniformDifferent) {
                     dynamicStyleUniforms[textStyleId] = interpolateUniform(animation.sourceSelectionTextUniform, animation.targetSelectionTextUniform, factor);
                     updates |= TextLayerStyleAnimatorUpdate::Uniform;
                 } else dynamicStyleUniforms[textStyleId] = animation.targetSelectionTextUniform;
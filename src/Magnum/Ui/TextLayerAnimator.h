@@ -88,7 +88,23 @@ enum class TextLayerStyleAnimatorUpdate: UnsignedByte {
      * Style assignment. Equivalently to calling @ref TextLayer::setStyle(),
      * causes @ref LayerState::NeedsDataUpdate to be set.
      */
-    Style = 1 << 4
+    Style = 1 << 4,
+
+    /**
+     * Style interpolation references and factors. Returned instead of
+     * @ref TextLayerStyleAnimatorUpdate::Uniform if
+     * @ref TextLayerSharedFlag::ShaderStyleAnimation is enabled, causes
+     * @ref LayerState::NeedsCommonDataUpdate to be set.
+     */
+    Interpolation = 1 << 5,
+
+    /**
+     * Editing style interpolation references and factors. Returned instead
+     * of @ref TextLayerStyleAnimatorUpdate::EditingUniform if
+     * @ref TextLayerSharedFlag::ShaderStyleAnimation is enabled, causes
+     * @ref LayerState::NeedsCommonDataUpdate to be set.
+     */
+    EditingInterpolation = 1 << 6
 };
 
 /**
@@ -225,7 +241,10 @@ you can reuse existing animations even after the style is updated.
     a transparent selection color instead of a style without a cursor or
     selection.
 
-At the moment, only animation between predefined styles is possible.
+At the moment, only animation between predefined styles is possible. If
+@ref TextLayerSharedFlag::ShaderStyleAnimation is enabled for the layer, the
+text, editing and selected text uniforms aren't interpolated on the CPU but in
+the shader, with just the interpolation factors updated every frame.
 
 @section Ui-TextLayerStyleAnimator-robustness Resolving style conflicts
 
@@ -555,9 +574,71 @@ class MAGNUM_UI_EXPORT TextLayerStyleAnimator: public AbstractVisualLayerStyleAn
          * also @ref TextLayer::Shared::setEditingStyle() if editing styles are
          * enabled, is expected to be already called for the layer this
          * animator is assigned to.
+         *
+         * Can be used only if @ref TextLayerSharedFlag::ShaderStyleAnimation
+         * isn't enabled for the layer, otherwise use the overload below.
          */
         TextLayerStyleAnimatorUpdates advance(Nanoseconds time, Containers::MutableBitArrayView activeStorage, Containers::MutableBitArrayView startedStorage, Containers::MutableBitArrayView stoppedStorage, const Containers::StridedArrayView1D<Float>& factorStorage, Containers::MutableBitArrayView removeStorage, Containers::ArrayView<TextLayerStyleUniform> dynamicStyleUniforms, Containers::MutableBitArrayView dynamicStyleCursorStyles, Containers::MutableBitArrayView dynamicStyleSelectionStyles, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, Containers::ArrayView<TextLayerEditingStyleUniform> dynamicEditingStyleUniforms, const Containers::StridedArrayView1D<Vector4>& dynamicEditingStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles);
 
+        /**
+         * @brief Advance the animations with shader-side interpolation
+         * @param[in] time                      Time to which to advance
+         * @param[in,out] activeStorage         Storage for the animator to put
+         *      a mask of active animations into
+         * @param[in,out] startedStorage        Storage for the animator to put
+         *      a mask of started animations into
+         * @param[in,out] stoppedStorage        Storage for the animator to put
+         *      a mask of stopped animations into
+         * @param[in,out] factorStorage         Storage for the animator to put
+         *      animation interpolation factors into
+         * @param[in,out] removeStorage         Storage for the animator to put
+         *      a mask of animations to remove into
+         * @param[in,out] dynamicStyleUniforms  Uniforms to animate indexed by
+         *      dynamic style ID or dynamic editing style text uniform ID
+         * @param[in,out] dynamicStyleInterpolationUniforms Source and target
+         *      uniform IDs to interpolate between, indexed the same as
+         *      @p dynamicStyleUniforms
+         * @param[in,out] dynamicStyleInterpolationFactors Factors to
+         *      interpolate the uniforms with, indexed the same as
+         *      @p dynamicStyleUniforms
+         * @param[in,out] dynamicStyleCursorStyles  Cursor style association to
+         *      animate indexed by dynamic style ID
+         * @param[in,out] dynamicStyleSelectionStyles  Selection style
+         *      association to animate indexed by dynamic style ID
+         * @param[in,out] dynamicStylePaddings  Paddings to animate indexed by
+         *      dynamic style ID
+         * @param[in,out] dynamicEditingStyleUniforms  Editing uniforms to
+         *      animate indexed by dynamic editing style ID
+         * @param[in,out] dynamicEditingStyleInterpolationUniforms Source and
+         *      target editing uniform IDs to interpolate between, indexed by
+         *      dynamic editing style ID
+         * @param[in,out] dynamicEditingStyleInterpolationFactors Factors to
+         *      interpolate the editing uniforms with, indexed by dynamic
+         *      editing style ID
+         * @param[in,out] dynamicEditingStylePaddings  Editing paddings to
+         *      animate indexed by dynamic editing style ID
+         * @param[in,out] dataStyles            Style assignments of all layer
+         *      data indexed by data ID
+         * @return Style properties that were affected by the animation
+         *
+         * Like @ref advance(Nanoseconds, Containers::MutableBitArrayView, Containers::MutableBitArrayView, Containers::MutableBitArrayView, const Containers::StridedArrayView1D<Float>&, Containers::MutableBitArrayView, Containers::ArrayView<TextLayerStyleUniform>, Containers::MutableBitArrayView, Containers::MutableBitArrayView, const Containers::StridedArrayView1D<Vector4>&, Containers::ArrayView<TextLayerEditingStyleUniform>, const Containers::StridedArrayView1D<Vector4>&, const Containers::StridedArrayView1D<UnsignedInt>&),
+         * but if @ref TextLayerSharedFlag::ShaderStyleAnimation is enabled for
+         * the layer, instead of interpolating @p dynamicStyleUniforms and
+         * @p dynamicEditingStyleUniforms, it writes IDs of the source and
+         * target uniforms to @p dynamicStyleInterpolationUniforms and
+         * @p dynamicEditingStyleInterpolationUniforms and the eased
+         * interpolation factor to @p dynamicStyleInterpolationFactors and
+         * @p dynamicEditingStyleInterpolationFactors, returning
+         * @ref TextLayerStyleAnimatorUpdate::Interpolation and
+         * @relativeref{TextLayerStyleAnimatorUpdate,EditingInterpolation}
+         * instead of @relativeref{TextLayerStyleAnimatorUpdate,Uniform} and
+         * @relativeref{TextLayerStyleAnimatorUpdate,EditingUniform}. Expects
+         * that the interpolation uniform and factor views have the same size
+         * as @p dynamicStyleUniforms and @p dynamicEditingStyleUniforms,
+         * respectively, if the flag is enabled and are empty otherwise.
+         */
+        TextLayerStyleAnimatorUpdates advance(Nanoseconds time, Containers::MutableBitArrayView activeStorage, Containers::MutableBitArrayView startedStorage, Containers::MutableBitArrayView stoppedStorage, const Containers::StridedArrayView1D<Float>& factorStorage, Containers::MutableBitArrayView removeStorage, Containers::ArrayView<TextLayerStyleUniform> dynamicStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicStyleInterpolationFactors, Containers::MutableBitArrayView dynamicStyleCursorStyles, Containers::MutableBitArrayView dynamicStyleSelectionStyles, const Containers::StridedArrayView1D<Vector4>& dynamicStylePaddings, Containers::ArrayView<TextLayerEditingStyleUniform> dynamicEditingStyleUniforms, const Containers::StridedArrayView1D<Vector2ui>& dynamicEditingStyleInterpolationUniforms, const Containers::StridedArrayView1D<Float>& dynamicEditingStyleInterpolationFactors, const Containers::StridedArrayView1D<Vector4>& dynamicEditingStylePaddings, const Containers::StridedArrayView1D<UnsignedInt>& dataStyles);
+
     private:
         struct State;
 
@@ -46,6 +46,7 @@
 #include <Magnum/GL/Version.h>
 #include <Magnum/Text/DistanceFieldGlyphCacheGL.h>
 
+#include "Magnum/Ui/Implementation/bufferUploadGL.h"
 #include "Magnum/Ui/Implementation/textLayerState.h"
 
 #ifdef MAGNUM_UI_BUILD_STATIC
@@ -69,7 +70,9 @@ class TextShaderGL: public GL::AbstractShaderProgram {
 
     public:
         enum Flag: UnsignedByte {
-            DistanceField = 1 << 0
+            DistanceField = 1 << 0,
+            CompactVertices = 1 << 1,
+            ShaderStyleAnimation = 1 << 2
         };
 
         typedef Containers::EnumSet<Flag> Flags;
@@ -79,8 +82,13 @@ class TextShaderGL: public GL::AbstractShaderProgram {
         typedef GL::Attribute<2, Vector4> Color4;
         typedef GL::Attribute<3, UnsignedInt> Style;
         typedef GL::Attribute<4, Float> Scale;
+        /* Used only with Flag::CompactVertices, otherwise the layer is the
+           third component of TextureCoordinates */
+        typedef GL::Attribute<5, Float> TextureLayer;
 
-        explicit TextShaderGL(Flags flags, UnsignedInt styleCount);
+        /* The dynamicStyleCount is used only if ShaderStyleAnimation is
+           set, styleCount includes it */
+        explicit TextShaderGL(Flags flags, UnsignedInt styleCount, UnsignedInt dynamicStyleCount);
 
         TextShaderGL& setProjection(const Vector2& scaling, const Float pixelScaling, const Float distanceFieldScaling) {
             /* XY is Y-flipped scale from the UI size to the 2x2 unit square,
@@ -115,7 +123,7 @@ CORRADE_ENUMSET_OPERATORS(TextShaderGL::Flags)
 #pragma clang diagnostic pop
 #endif
 
-TextShaderGL::TextShaderGL(const Flags flags, const UnsignedInt styleCount) {
+TextShaderGL::TextShaderGL(const Flags flags, const UnsignedInt styleCount, const UnsignedInt dynamicStyleCount) {
     GL::Context& context = GL::Context::current();
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::explicit_attrib_location);
@@ -138,14 +146,21 @@ TextShaderGL::TextShaderGL(const Flags flags, const UnsignedInt styleCount) {
         #endif
     });
 
+    const Containers::String shaderStyleAnimationDefines = flags >= Flag::ShaderStyleAnimation ? Utility::format(
+        "#define SHADER_STYLE_ANIMATION\n"
+        "#define DYNAMIC_STYLE_COUNT {}\n", dynamicStyleCount) : Containers::String{};
+
     GL::Shader vert{version, GL::Shader::Type::Vertex};
     vert.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(flags >= Flag::DistanceField ? "#define DISTANCE_FIELD\n"_s : ""_s)
+        .addSource(flags >= Flag::CompactVertices ? "#define COMPACT_VERTICES\n"_s : ""_s)
         .addSource(rs.getString("compatibility.glsl"_s))
         .addSource(rs.getString("TextShader.vert"_s));
 
     GL::Shader frag{version, GL::Shader::Type::Fragment};
     frag.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(flags >= Flag::DistanceField ? "#define DISTANCE_FIELD\n"_s : ""_s)
         .addSource(rs.getString("compatibility.glsl"_s))
         .addSource(rs.getString("TextShader.frag"_s));
@@ -190,7 +205,9 @@ class TextEditingShaderGL: public GL::AbstractShaderProgram {
         typedef GL::Attribute<3, UnsignedInt> Style;
 
         explicit TextEditingShaderGL(NoCreateT): GL::AbstractShaderProgram{NoCreate} {}
-        explicit TextEditingShaderGL(UnsignedInt styleCount);
+        /* If dynamicStyleCount is non-zero, the last dynamicStyleCount
+           styles are interpolated in the shader, styleCount includes them */
+        explicit TextEditingShaderGL(UnsignedInt styleCount, UnsignedInt dynamicStyleCount);
 
         TextEditingShaderGL& setProjection(const Vector2& scaling, const Float pixelScaling) {
             /* XY is Y-flipped scale from the UI size to the 2x2 unit square,
@@ -210,7 +227,7 @@ class TextEditingShaderGL: public GL::AbstractShaderProgram {
         Int _projectionUniform = 0;
 };
 
-TextEditingShaderGL::TextEditingShaderGL(const UnsignedInt styleCount) {
+TextEditingShaderGL::TextEditingShaderGL(const UnsignedInt styleCount, const UnsignedInt dynamicStyleCount) {
     GL::Context& context = GL::Context::current();
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::explicit_attrib_location);
@@ -233,13 +250,19 @@ TextEditingShaderGL::TextEditingShaderGL(const UnsignedInt styleCount) {
         #endif
     });
 
+    const Containers::String shaderStyleAnimationDefines = dynamicStyleCount ? Utility::format(
+        "#define SHADER_STYLE_ANIMATION\n"
+        "#define DYNAMIC_STYLE_COUNT {}\n", dynamicStyleCount) : Containers::String{};
+
     GL::Shader vert{version, GL::Shader::Type::Vertex};
     vert.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(rs.getString("compatibility.glsl"_s))
         .addSource(rs.getString("TextEditingShader.vert"_s));
 
     GL::Shader frag{version, GL::Shader::Type::Fragment};
     frag.addSource(Utility::format("#define STYLE_COUNT {}\n", styleCount))
+        .addSource(shaderStyleAnimationDefines)
         .addSource(rs.getString("compatibility.glsl"_s))
         .addSource(rs.getString("TextEditingShader.frag"_s));
 
@@ -304,12 +327,16 @@ struct TextLayerGL::Shared::State: TextLayer::Shared::State {
 TextLayerGL::Shared::State::State(Shared& self, Text::AbstractGlyphCache& glyphCache, const Configuration& configuration):
     TextLayer::Shared::State{self, glyphCache, configuration},
     shader{
-        configuration.flags() >= TextLayerSharedFlag::DistanceField ? TextShaderGL::Flag::DistanceField : TextShaderGL::Flags{},
+        (configuration.flags() >= TextLayerSharedFlag::DistanceField ? TextShaderGL::Flag::DistanceField : TextShaderGL::Flags{})|
+        (configuration.flags() >= TextLayerSharedFlag::CompactVertices ? TextShaderGL::Flag::CompactVertices : TextShaderGL::Flags{})|
+        /* Interpolation in the shader makes sense only with dynamic styles */
+        (configuration.flags() >= TextLayerSharedFlag::ShaderStyleAnimation && configuration.dynamicStyleCount() ? TextShaderGL::Flag::ShaderStyleAnimation : TextShaderGL::Flags{}),
         /* If dynamic editing styles are enabled, there's two extra styles for
            each dynamic style, one reserved for under-cursor text and one for
            selected text. If there are no dynamic styles, the editing styles
            pick those from the regular styleUniformCount range. */
-        configuration.styleUniformCount() + configuration.dynamicStyleCount()*(configuration.hasEditingStyles() ? 3 : 1)}
+        configuration.styleUniformCount() + configuration.dynamicStyleCount()*(configuration.hasEditingStyles() ? 3 : 1),
+        configuration.dynamicStyleCount()*(configuration.hasEditingStyles() ? 3 : 1)}
 {
     if(!dynamicStyleCount) {
         styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(TextLayerCommonStyleUniform) + sizeof(TextLayerStyleUniform)*styleUniformCount}};
@@ -318,7 +345,8 @@ TextLayerGL::Shared::State::State(Shared& self, Text::AbstractGlyphCache& glyphC
     if(hasEditingStyles)
         /* Each dynamic style has two associated editing styles, one for cursor
            and one for selection */
-        editingShader = TextEditingShaderGL{configuration.editingStyleUniformCount() + 2*configuration.dynamicStyleCount()};
+        editingShader = TextEditingShaderGL{configuration.editingStyleUniformCount() + 2*configuration.dynamicStyleCount(),
+            configuration.flags() >= TextLayerSharedFlag::ShaderStyleAnimation ? 2*configuration.dynamicStyleCount() : 0};
 }
 
 TextLayerGL::Shared::State::State(Shared& self, Text::GlyphCacheArrayGL& glyphCache, const Configuration& configuration): State{self, static_cast<Text::AbstractGlyphCache&>(glyphCache), configuration} {
@@ -421,17 +449,77 @@ void TextLayerGL::Shared::doSetEditingStyle(const TextLayerCommonEditingStyleUni
     state.editingStyleBuffer.setSubData(sizeof(TextLayerCommonEditingStyleUniform), uniforms);
 }
 
+namespace {
+
+/* Called from the constructor and then again each time the buffers get
+   recreated */
+void setupMesh(GL::Mesh& mesh, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, const TextLayerSharedFlags flags) {
+    /* The compact attributes are in the order of
+       Implementation::TextLayerCompactVertex members */
+    if(flags >= TextLayerSharedFlag::CompactVertices) {
+        const TextShaderGL::Position position;
+        const TextShaderGL::TextureCoordinates textureCoordinates{
+            TextShaderGL::TextureCoordinates::Components::Two,
+            TextShaderGL::TextureCoordinates::DataType::UnsignedShort,
+            TextShaderGL::TextureCoordinates::DataOption::Normalized};
+        const TextShaderGL::TextureLayer textureLayer{
+            TextShaderGL::TextureLayer::DataType::UnsignedShort};
+        const TextShaderGL::Style style{
+            TextShaderGL::Style::DataType::UnsignedShort};
+        const TextShaderGL::Color4 color{
+            TextShaderGL::Color4::DataType::UnsignedByte,
+            TextShaderGL::Color4::DataOption::Normalized};
+        if(flags >= TextLayerSharedFlag::DistanceField)
+            mesh.addVertexBuffer(vertexBuffer, 0,
+                position,
+                textureCoordinates,
+                textureLayer,
+                style,
+                color,
+                TextShaderGL::Scale{});
+        else
+            mesh.addVertexBuffer(vertexBuffer, 0,
+                position,
+                textureCoordinates,
+                textureLayer,
+                style,
+                color);
+    } else if(flags >= TextLayerSharedFlag::DistanceField)
+        mesh.addVertexBuffer(vertexBuffer, 0,
+            TextShaderGL::Position{},
+            TextShaderGL::TextureCoordinates{},
+            TextShaderGL::Color4{},
+            TextShaderGL::Style{},
+            TextShaderGL::Scale{});
+    else
+        mesh.addVertexBuffer(vertexBuffer, 0,
+            TextShaderGL::Position{},
+            TextShaderGL::TextureCoordinates{},
+            TextShaderGL::Color4{},
+            TextShaderGL::Style{});
+    mesh.setIndexBuffer(indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+}
+
+}
+
 struct TextLayerGL::State: TextLayer::State {
     explicit State(Shared::State& shared, const TextLayerFlags flags): TextLayer::State{shared, flags} {}
 
     GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array},
         indexBuffer{GL::Buffer::TargetHint::ElementArray};
+    BufferUploadGL vertexUpload, indexUpload;
     GL::Mesh mesh;
     Vector2 clipScale;
     Vector2i framebufferSize;
 
+    /* Used only if setBufferStreamingEnabled() is set. Applies only to the
+       glyph mesh, the editing mesh goes through the regular path. */
+    BufferStreamGL bufferStream;
+    bool bufferStreaming = false;
+
     /* Used only if shared.hasEditingStyles is set */
     GL::Buffer editingVertexBuffer{NoCreate}, editingIndexBuffer{NoCreate};
+    BufferUploadGL editingVertexUpload, editingIndexUpload;
     GL::Mesh editingMesh{NoCreate};
 
     /* Used only if shared.dynamicStyleCount is non-zero (and then also
@@ -447,20 +535,7 @@ struct TextLayerGL::State: TextLayer::State {
 TextLayerGL::TextLayerGL(const LayerHandle handle, Shared& sharedState_, const TextLayerFlags flags): TextLayer{handle, Containers::pointer<State>(static_cast<Shared::State&>(*sharedState_._state), flags)} {
     auto& state = static_cast<State&>(*_state);
     auto& sharedState = static_cast<Shared::State&>(state.shared);
-    if(sharedState.flags >= TextLayerSharedFlag::DistanceField)
-        state.mesh.addVertexBuffer(state.vertexBuffer, 0,
-            TextShaderGL::Position{},
-            TextShaderGL::TextureCoordinates{},
-            TextShaderGL::Color4{},
-            TextShaderGL::Style{},
-            TextShaderGL::Scale{});
-    else
-        state.mesh.addVertexBuffer(state.vertexBuffer, 0,
-            TextShaderGL::Position{},
-            TextShaderGL::TextureCoordinates{},
-            TextShaderGL::Color4{},
-            TextShaderGL::Style{});
-    state.mesh.setIndexBuffer(state.indexBuffer, 0, GL::MeshIndexType::UnsignedInt);
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, sharedState.flags);
 
     if(sharedState.hasEditingStyles) {
         state.editingVertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
@@ -475,6 +550,30 @@ TextLayerGL::TextLayerGL(const LayerHandle handle, Shared& sharedState_, const T
     }
 }
 
+bool TextLayerGL::isBufferStreamingEnabled() const {
+    return static_cast<const State&>(*_state).bufferStreaming;
+}
+
+TextLayerGL& TextLayerGL::setBufferStreamingEnabled(const bool enabled) {
+    auto& state = static_cast<State&>(*_state);
+    if(state.bufferStreaming == enabled)
+        return *this;
+
+    /* Persistently mapped buffers have an immutable storage that can't be
+       used by the regular upload path and vice versa, so start from scratch
+       and trigger a full upload */
+    state.bufferStreaming = enabled;
+    state.vertexBuffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+    state.indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+    state.vertexUpload = BufferUploadGL{};
+    state.indexUpload = BufferUploadGL{};
+    bufferStreamReset(state.bufferStream);
+    state.mesh = GL::Mesh{};
+    setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, static_cast<Shared::State&>(state.shared).flags);
+    setNeedsUpdate(LayerState::NeedsDataUpdate);
+    return *this;
+}
+
 LayerFeatures TextLayerGL::doFeatures() const {
     return TextLayer::doFeatures()|LayerFeature::DrawUsesBlending|LayerFeature::DrawUsesScissor;
 }
@@ -504,19 +603,47 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
        order to be correctly handled below. */
     const bool sharedStyleChanged = sharedState.styleUpdateStamp != state.styleUpdateStamp;
     const bool sharedEditingStyleChanged = sharedState.editingStyleUpdateStamp != state.editingStyleUpdateStamp;
-    CORRADE_INTERNAL_ASSERT(!sharedState.dynamicStyleCount || (!sharedStyleChanged && !sharedEditingStyleChanged && !state.dynamicStyleChanged && !state.dynamicEditingStyleChanged) || states >= LayerState::NeedsCommonDataUpdate);
+    CORRADE_INTERNAL_ASSERT(!sharedState.dynamicStyleCount || (!sharedStyleChanged && !sharedEditingStyleChanged && !state.dynamicStyleChanged && !state.dynamicEditingStyleChanged && !state.dynamicStyleInterpolationChanged && !state.dynamicEditingStyleInterpolationChanged) || states >= LayerState::NeedsCommonDataUpdate);
 
     TextLayer::doUpdate(states, dataIds, clipRectIds, clipRectDataCounts, nodeOffsets, nodeSizes, nodeOpacities, nodesEnabled, clipRectOffsets, clipRectSizes, compositeRectOffsets, compositeRectSizes);
 
     /* The branching here mirrors how TextLayer::doUpdate() restricts the
-       updates. Keep in sync. */
+       updates. Keep in sync. With buffer streaming, both glyph vertices and
+       indices are written to a new place every time, so they're uploaded
+       together. */
+    if(state.bufferStreaming && (
+        states >= LayerState::NeedsNodeOrderUpdate ||
+        states >= LayerState::NeedsNodeOffsetSizeUpdate ||
+        states >= LayerState::NeedsNodeEnabledUpdate ||
+        states >= LayerState::NeedsNodeOpacityUpdate ||
+        states >= LayerState::NeedsDataUpdate))
+    {
+        const std::size_t vertexStride = sharedState.flags >= TextLayerSharedFlag::CompactVertices ?
+            (sharedState.flags >= TextLayerSharedFlag::DistanceField ?
+                sizeof(Implementation::TextLayerCompactDistanceFieldVertex) :
+                sizeof(Implementation::TextLayerCompactVertex)) :
+            (sharedState.flags >= TextLayerSharedFlag::DistanceField ?
+                sizeof(Implementation::TextLayerDistanceFieldVertex) :
+                sizeof(Implementation::TextLayerVertex));
+        if(bufferStreamUpload(state.vertexBuffer, state.indexBuffer, state.bufferStream, state.vertices, vertexStride, state.indices)) {
+            state.mesh = GL::Mesh{};
+            setupMesh(state.mesh, state.vertexBuffer, state.indexBuffer, sharedState.flags);
+        }
+        state.mesh.setCount(state.indices.size());
+
+        /* Everything got copied, so the modified ranges aren't needed */
+        state.vertexDirtyRange.reset();
+        state.indexDirtyRange.reset();
+    }
     if(states >= LayerState::NeedsNodeOrderUpdate ||
        states >= LayerState::NeedsDataUpdate)
     {
-        state.indexBuffer.setData(state.indices);
-        state.mesh.setCount(state.indices.size());
+        if(!state.bufferStreaming) {
+            bufferUploadDirty(state.indexBuffer, state.indexUpload, state.indices, state.indexDirtyRange);
+            state.mesh.setCount(state.indices.size());
+        }
         if(sharedState.hasEditingStyles) {
-            state.editingIndexBuffer.setData(state.editingIndices);
+            bufferUploadDirty(state.editingIndexBuffer, state.editingIndexUpload, state.editingIndices, state.editingIndexDirtyRange);
             state.editingMesh.setCount(state.editingIndices.size());
         }
     }
@@ -525,9 +652,10 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
        states >= LayerState::NeedsNodeOpacityUpdate ||
        states >= LayerState::NeedsDataUpdate)
     {
-        state.vertexBuffer.setData(state.vertices);
+        if(!state.bufferStreaming)
+            bufferUploadDirty(state.vertexBuffer, state.vertexUpload, state.vertices, state.vertexDirtyRange);
         if(sharedState.hasEditingStyles)
-            state.editingVertexBuffer.setData(state.editingVertices);
+            bufferUploadDirty(state.editingVertexBuffer, state.editingVertexUpload, state.editingVertices, state.editingVertexDirtyRange);
     }
 
     /* If we have dynamic styles and either NeedsCommonDataUpdate is set
@@ -538,9 +666,11 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
         if(needsFirstUpload) {
             /* If dynamic editing styles are enabled, there's two extra styles
                for each dynamic style, one for reserved for under-cursor text
-               and one for selected text */
+               and one for selected text. With ShaderStyleAnimation the style
+               interpolations are placed after all style uniforms, otherwise
+               the view is empty. */
             /** @todo check if DynamicDraw has any effect on perf */
-            state.styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(TextLayerCommonStyleUniform) + sizeof(TextLayerStyleUniform)*(sharedState.styleUniformCount + sharedState.dynamicStyleCount*(sharedState.hasEditingStyles ? 3 : 1))}, GL::BufferUsage::DynamicDraw};
+            state.styleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(TextLayerCommonStyleUniform) + sizeof(TextLayerStyleUniform)*(sharedState.styleUniformCount + state.dynamicStyleUniforms.size()) + sizeof(Implementation::TextLayerStyleInterpolation)*state.dynamicStyleInterpolations.size()}, GL::BufferUsage::DynamicDraw};
         }
         if(needsFirstUpload || sharedStyleChanged) {
             state.styleBuffer.setSubData(0, {&sharedState.commonStyleUniform, 1});
@@ -555,6 +685,12 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
             state.styleBuffer.setSubData(sizeof(TextLayerCommonStyleUniform) + sizeof(TextLayerStyleUniform)*sharedState.styleUniformCount, state.dynamicStyleUniforms);
             state.dynamicStyleChanged = false;
         }
+        /* With ShaderStyleAnimation, a running animation changes just the
+           interpolations, which are a fraction of the size of the uniforms */
+        if(!state.dynamicStyleInterpolations.isEmpty() && (needsFirstUpload || state.dynamicStyleInterpolationChanged)) {
+            state.styleBuffer.setSubData(sizeof(TextLayerCommonStyleUniform) + sizeof(TextLayerStyleUniform)*(sharedState.styleUniformCount + state.dynamicStyleUniforms.size()), state.dynamicStyleInterpolations);
+            state.dynamicStyleInterpolationChanged = false;
+        }
     }
 
     /* If we have any dynamic editing styles and either NeedsCommonDataUpdate
@@ -564,9 +700,10 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
         const bool needsFirstUpload = !state.editingStyleBuffer.id();
         if(needsFirstUpload) {
             /* Each dynamic style has two associated editing styles, one for
-               cursor and one for selection */
+               cursor and one for selection. Interpolations, if any, are again
+               placed after. */
             /** @todo check if DynamicDraw has any effect on perf */
-            state.editingStyleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(TextLayerCommonEditingStyleUniform) + sizeof(TextLayerEditingStyleUniform)*(sharedState.editingStyleUniformCount + 2*sharedState.dynamicStyleCount)}, GL::BufferUsage::DynamicDraw};
+            state.editingStyleBuffer = GL::Buffer{GL::Buffer::TargetHint::Uniform, {nullptr, sizeof(TextLayerCommonEditingStyleUniform) + sizeof(TextLayerEditingStyleUniform)*(sharedState.editingStyleUniformCount + 2*sharedState.dynamicStyleCount) + sizeof(Implementation::TextLayerStyleInterpolation)*state.dynamicEditingStyleInterpolations.size()}, GL::BufferUsage::DynamicDraw};
         }
         if(needsFirstUpload || sharedEditingStyleChanged) {
             state.editingStyleBuffer.setSubData(0, {&sharedState.commonEditingStyleUniform, 1});
@@ -578,6 +715,10 @@ void TextLayerGL::doUpdate(const LayerStates states, const Containers::StridedAr
             state.editingStyleBuffer.setSubData(sizeof(TextLayerCommonEditingStyleUniform) + sizeof(TextLayerEditingStyleUniform)*sharedState.editingStyleUniformCount, state.dynamicEditingStyleUniforms);
             state.dynamicEditingStyleChanged = false;
         }
+        if(!state.dynamicEditingStyleInterpolations.isEmpty() && (needsFirstUpload || state.dynamicEditingStyleInterpolationChanged)) {
+            state.editingStyleBuffer.setSubData(sizeof(TextLayerCommonEditingStyleUniform) + sizeof(TextLayerEditingStyleUniform)*(sharedState.editingStyleUniformCount + 2*sharedState.dynamicStyleCount), state.dynamicEditingStyleInterpolations);
+            state.dynamicEditingStyleInterpolationChanged = false;
+        }
     }
 }
 
@@ -634,7 +775,7 @@ void TextLayerGL::doDraw(const Containers::StridedArrayView1D<const UnsignedInt>
         }
 
         state.mesh
-            .setIndexOffset(state.indexDrawOffsets[clipDataOffset].first())
+            .setIndexOffset(state.bufferStream.indexOffset + state.indexDrawOffsets[clipDataOffset].first())
             .setCount(state.indexDrawOffsets[clipDataOffset + clipRectDataCount].first() - state.indexDrawOffsets[clipDataOffset].first());
         sharedState.shader
             .draw(state.mesh);
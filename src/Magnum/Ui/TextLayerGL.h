@@ -85,6 +85,30 @@ class MAGNUM_UI_EXPORT TextLayerGL: public TextLayer {
         /** @overload */
         inline const Shared& shared() const;
 
+        /**
+         * @brief Whether buffer streaming is enabled
+         *
+         * @see @ref setBufferStreamingEnabled()
+         */
+        bool isBufferStreamingEnabled() const;
+
+        /**
+         * @brief Enable or disable buffer streaming
+         * @return Reference to self (for method chaining)
+         *
+         * Useful for texts that change every frame, such as counters or
+         * animated labels. If enabled, glyph vertex and index data are
+         * written to a triple-buffered persistently mapped ring if
+         * @gl_extension{ARB,buffer_storage} (or
+         * @gl_extension{EXT,buffer_storage} on OpenGL ES) is available, or
+         * the buffers get orphaned on every upload otherwise. Cursor and
+         * selection quads for @ref TextLayerFlag::Editable texts are
+         * unaffected. See @ref BaseLayerGL::setBufferStreamingEnabled() for
+         * more information. Changing the value causes
+         * @ref LayerState::NeedsDataUpdate to be set. Disabled by default.
+         */
+        TextLayerGL& setBufferStreamingEnabled(bool enabled);
+
     protected:
         /**
          * @copybrief AbstractLayer::doDraw()
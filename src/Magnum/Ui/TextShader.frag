@@ -31,6 +31,15 @@ struct StyleEntry {
     mediump vec4 outlineWidthEdgeOffsetSmoothnessReserved;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 0
@@ -38,6 +47,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #define commonStyle_smoothness smoothnessReserved.x
@@ -61,7 +73,14 @@ uniform lowp sampler2DArray glyphTextureData;
 NOPERSPECTIVE in mediump vec3 interpolatedTextureCoordinates;
 flat in lowp vec4 interpolatedColor;
 #ifdef DISTANCE_FIELD
+#ifndef SHADER_STYLE_ANIMATION
 flat in mediump uint interpolatedStyle;
+#define styleValue(member) styles[interpolatedStyle].member
+#else
+flat in mediump uvec2 interpolatedStyles; /* source, target */
+flat in mediump float interpolatedStyleFactor;
+#define styleValue(member) mix(styles[interpolatedStyles.x].member, styles[interpolatedStyles.y].member, interpolatedStyleFactor)
+#endif
 flat in mediump float interpolatedInvertedRunScale;
 #endif
 
@@ -82,15 +101,15 @@ void main() {
        field value delta. */
     lowp float smoothness = max(
         commonStyle_smoothness*projection.z*interpolatedInvertedRunScale,
-        styles[interpolatedStyle].style_smoothness*scale);
+        styleValue(style_smoothness)*scale);
 
     /* For consistency with SVG, the outline is by default centered on the
        edge, instead of just growing outwards. Thus, assuming distance field
        value 0.5 represents the edge and larger values are inside, the actual
        inner edge is *minus* the edge offset (scaled to distance field value
        delta) and *minus* (again scaled) half of outline width. */
-    lowp float outlineWidth = styles[interpolatedStyle].style_outlineWidth*scale;
-    lowp float innerEdge = 0.5 - styles[interpolatedStyle].style_edgeOffset*scale + 0.5*outlineWidth;
+    lowp float outlineWidth = styleValue(style_outlineWidth)*scale;
+    lowp float innerEdge = 0.5 - styleValue(style_edgeOffset)*scale + 0.5*outlineWidth;
     /* The outer edge is then the inner edge plus the whole outline width. Need
        to ensure that it's always zero for distance value 0.0, as otherwise the
        whole quad would be colored if either the edge offset or the outline
@@ -116,6 +135,6 @@ void main() {
        simpler. But the goal is again that if there's zero outline width, the
        outline color shouldn't leak anywhere, and if the edge offset makes the
        inside disappear, the base color doesn't leak anywhere either. */
-    fragmentColor = innerEdgeFactor*interpolatedColor + (outerEdgeFactor - innerEdgeFactor)*styles[interpolatedStyle].outlineColor;
+    fragmentColor = innerEdgeFactor*interpolatedColor + (outerEdgeFactor - innerEdgeFactor)*styleValue(outlineColor);
     #endif
 }
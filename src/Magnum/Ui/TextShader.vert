@@ -30,6 +30,15 @@ struct StyleEntry {
     mediump vec4 outlineWidthEdgeOffsetSmoothnessReserved;
 };
 
+#ifdef SHADER_STYLE_ANIMATION
+/* Used for dynamic styles, which are the last DYNAMIC_STYLE_COUNT styles */
+struct StyleInterpolationEntry {
+    mediump uvec2 sourceTargetStyle;
+    mediump float factor;
+    mediump float reserved;
+};
+#endif
+
 layout(std140
     #ifdef EXPLICIT_BINDING
     , binding = 0
@@ -37,6 +46,9 @@ layout(std140
 ) uniform Style {
     lowp vec4 smoothnessReserved;
     StyleEntry styles[STYLE_COUNT];
+    #ifdef SHADER_STYLE_ANIMATION
+    StyleInterpolationEntry styleInterpolations[DYNAMIC_STYLE_COUNT];
+    #endif
 };
 
 #ifdef EXPLICIT_UNIFORM_LOCATION
@@ -47,7 +59,12 @@ uniform highp vec4 projection; /* xy = UI size to unit square scaling,
                                   w = one UI unit as a distance value delta */
 
 layout(location = 0) in highp vec2 position;
+#ifndef COMPACT_VERTICES
 layout(location = 1) in mediump vec3 textureCoordinates;
+#else
+layout(location = 1) in mediump vec2 textureCoordinates;
+layout(location = 5) in mediump float textureLayer;
+#endif
 layout(location = 2) in lowp vec4 color;
 layout(location = 3) in mediump uint style;
 #ifdef DISTANCE_FIELD
@@ -57,18 +74,53 @@ layout(location = 4) in mediump float invertedRunScale;
 NOPERSPECTIVE out mediump vec3 interpolatedTextureCoordinates;
 flat out lowp vec4 interpolatedColor;
 #ifdef DISTANCE_FIELD
+#ifndef SHADER_STYLE_ANIMATION
 flat out mediump uint interpolatedStyle;
+#else
+flat out mediump uvec2 interpolatedStyles; /* source, target */
+flat out mediump float interpolatedStyleFactor;
+#endif
 flat out mediump float interpolatedInvertedRunScale;
 #endif
 
+#ifndef SHADER_STYLE_ANIMATION
+#define styleValue(member) styles[style].member
+#else
+#define styleValue(member) mix(styles[sourceStyle].member, styles[targetStyle].member, styleFactor)
+#endif
+
 void main() {
+    #ifndef COMPACT_VERTICES
     interpolatedTextureCoordinates = textureCoordinates;
+    #else
+    interpolatedTextureCoordinates = vec3(textureCoordinates, textureLayer);
+    #endif
+    #ifdef SHADER_STYLE_ANIMATION
+    /* Dynamic styles reference a source and target style to interpolate
+       between, which is the dynamic style itself if it's not animated. Other
+       styles are used as-is. */
+    mediump uint sourceStyle = style;
+    mediump uint targetStyle = style;
+    mediump float styleFactor = 0.0;
+    if(style >= uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT)) {
+        mediump uint dynamicStyle = style - uint(STYLE_COUNT - DYNAMIC_STYLE_COUNT);
+        sourceStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.x;
+        targetStyle = styleInterpolations[dynamicStyle].sourceTargetStyle.y;
+        styleFactor = styleInterpolations[dynamicStyle].factor;
+    }
+    #endif
+
     /* Calculate the combined base color here already to save a vec4 load in
        each fragment shader invocation. Outline color, if used, is fetched in
        the fragment shader always alongside other properties. */
-    interpolatedColor = styles[style].color*color;
+    interpolatedColor = styleValue(color)*color;
     #ifdef DISTANCE_FIELD
+    #ifndef SHADER_STYLE_ANIMATION
     interpolatedStyle = style;
+    #else
+    interpolatedStyles = uvec2(sourceStyle, targetStyle);
+    interpolatedStyleFactor = styleFactor;
+    #endif
     interpolatedInvertedRunScale = invertedRunScale;
     #endif
 
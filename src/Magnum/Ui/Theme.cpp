@@ -347,7 +347,10 @@ bool DarkTheme::doApply(UserInterface& ui, const ThemeFeatures features, PluginM
                 Implementation::styleTransitionToFocusedOver,
                 Implementation::styleTransitionToPressedOut,
                 Implementation::styleTransitionToPressedOver,
-                Implementation::styleTransitionToDisabled>();
+                Implementation::styleTransitionToDisabled>()
+            /* The transitions are large switches, turn them into tables to
+               not have to call them on every event */
+            .precomputeStyleTransitionTables();
     }
 
     /* Animations for the base layer. Advertised only if they were enabled
@@ -391,25 +394,33 @@ bool DarkTheme::doApply(UserInterface& ui, const ThemeFeatures features, PluginM
             Error{} << "Ui::DarkTheme::apply(): cannot open a font";
             return {};
         }
-        /** @todo configurable way to fill the cache, or switch to on-demand
-            by default once AbstractFont can fill the cache with glyph IDs */
-        for(Text::AbstractFont* const i: {&*font, &*fontLarge}) if(!i->fillGlyphCache(glyphCache,
-            "abcdefghijklmnopqrstuvwxyz"
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-            "0123456789 _.,-+=*:;?!@$&#/\\|`\"'<>()[]{}%…"
-            /* Bullet used by the password font */
-            "•")
-        ) {
-            Error{} << "Ui::DarkTheme::apply(): cannot fill a glyph cache";
-            return {};
-        }
-        /* Use the glyph mapping array to pick just the icons that are actually
-           used */
-        /** @todo here in particular we likely don't need all icon x size
-            combinations, switch to on-demand here as well */
-        for(Text::AbstractFont* const i: {&*iconFont, &*iconFontLarge}) if(!i->fillGlyphCache(glyphCache, IconGlyphMapping)) {
-            Error{} << "Ui::DarkTheme::apply(): cannot fill a glyph cache with icons";
-            return {};
+        /* If the glyph cache is filled on demand, only the bullet glyph used by
+           the password font has to be present upfront, as the password font
+           only references it and cannot fill the cache on its own */
+        if(shared.flags() >= TextLayerSharedFlag::FillGlyphCacheOnDemand) {
+            if(!font->fillGlyphCache(glyphCache, "•")) {
+                Error{} << "Ui::DarkTheme::apply(): cannot fill a glyph cache";
+                return {};
+            }
+        } else {
+            for(Text::AbstractFont* const i: {&*font, &*fontLarge}) if(!i->fillGlyphCache(glyphCache,
+                "abcdefghijklmnopqrstuvwxyz"
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "0123456789 _.,-+=*:;?!@$&#/\\|`\"'<>()[]{}%…"
+                /* Bullet used by the password font */
+                "•")
+            ) {
+                Error{} << "Ui::DarkTheme::apply(): cannot fill a glyph cache";
+                return {};
+            }
+            /* Use the glyph mapping array to pick just the icons that are
+               actually used */
+            /** @todo here in particular we likely don't need all icon x size
+                combinations, on-demand filling solves that */
+            for(Text::AbstractFont* const i: {&*iconFont, &*iconFontLarge}) if(!i->fillGlyphCache(glyphCache, IconGlyphMapping)) {
+                Error{} << "Ui::DarkTheme::apply(): cannot fill a glyph cache with icons";
+                return {};
+            }
         }
 
         /* Password font. Takes the bullet glyph from the main font. The
@@ -465,7 +476,10 @@ bool DarkTheme::doApply(UserInterface& ui, const ThemeFeatures features, PluginM
                 Implementation::styleTransitionToFocusedOver,
                 Implementation::styleTransitionToPressedOut,
                 Implementation::styleTransitionToPressedOver,
-                Implementation::styleTransitionToDisabled>();
+                Implementation::styleTransitionToDisabled>()
+            /* The transitions are large switches, turn them into tables to
+               not have to call them on every event */
+            .precomputeStyleTransitionTables();
     }
 
     /* Animations for the text layer. Advertised only if they were enabled
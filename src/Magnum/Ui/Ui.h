@@ -81,7 +81,7 @@ class BaseLayerStyleAnimator;
 #ifdef MAGNUM_TARGET_GL
 class BaseLayerGL;
 #endif
-enum class BaseLayerSharedFlag: UnsignedByte;
+enum class BaseLayerSharedFlag: UnsignedShort;
 typedef Containers::EnumSet<BaseLayerSharedFlag> BaseLayerSharedFlags;
 
 class DataLayer;
@@ -127,6 +127,8 @@ class TextLayerStyleAnimator;
 #ifdef MAGNUM_TARGET_GL
 class TextLayerGL;
 #endif
+enum class TextLayerSharedFlag: UnsignedByte;
+typedef Containers::EnumSet<TextLayerSharedFlag> TextLayerSharedFlags;
 class TextFeatureValue;
 class TextProperties;
 
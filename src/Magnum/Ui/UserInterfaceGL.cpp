@@ -236,7 +236,8 @@ bool UserInterfaceGL::trySetTheme(const AbstractTheme& theme, const ThemeFeature
                                              theme.textLayerStyleCount()}
                 .setEditingStyleCount(theme.textLayerEditingStyleUniformCount(),
                                       theme.textLayerEditingStyleCount())
-                .setDynamicStyleCount(theme.textLayerDynamicStyleCount())};
+                .setDynamicStyleCount(theme.textLayerDynamicStyleCount())
+                .setFlags(theme.textLayerFlags())};
         setTextLayerInstance(Containers::pointer<TextLayerGL>(createLayer(), state.textLayerShared));
 
         /* Create a local font plugin manager if external wasn't passed. If the
@@ -0,0 +1,281 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VirtualList.h"
+
+#include <Corrade/Containers/Function.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Magnum/Math/Functions.h>
+
+#include "Magnum/Ui/Anchor.h"
+#include "Magnum/Ui/DataLayer.h"
+#include "Magnum/Ui/Handle.h"
+#include "Magnum/Ui/NodeFlags.h"
+#include "Magnum/Ui/UserInterface.h"
+#include "Magnum/Ui/Implementation/scrollAreaStorage.h"
+
+namespace Magnum { namespace Ui {
+
+using Implementation::ScrollAreaStorage;
+
+namespace {
+
+struct VirtualListState {
+    struct Slot {
+        NodeHandle node;
+        /* Item the slot is bound to or ~std::size_t{} if the slot isn't bound
+           to anything, in which case the node is hidden */
+        std::size_t item;
+    };
+
+    explicit VirtualListState(UserInterface& ui, NodeHandle contentsNode, const Vector2& itemSize, UnsignedInt columnCount, Containers::Function<void(std::size_t, const Anchor&)>&& create, Containers::Function<void(std::size_t, NodeHandle, std::size_t)>&& bind): ui(ui), contentsNode{contentsNode}, itemSize{itemSize}, columnCount{columnCount}, create{Utility::move(create)}, bind{Utility::move(bind)} {}
+
+    /* Creates new slots if the current pool isn't enough to cover the whole
+       UI size plus overscan. Called only from the public API, never from the
+       DataLayer binding, as the create() callback may want to create new data
+       bindings, which isn't possible while the DataLayer is iterating
+       through them. */
+    void growSlots() {
+        const std::size_t rowCount = std::size_t(Math::ceil(ui.size().y()/itemSize.y())) + 1 + 2*overscanRowCount;
+        const std::size_t slotCount = Math::min(rowCount*columnCount, itemCount);
+        for(std::size_t i = slots.size(); i < slotCount; ++i) {
+            const NodeHandle node = ui.createNode(contentsNode, {}, itemSize, NodeFlag::Hidden);
+            arrayAppend(slots, InPlaceInit, node, ~std::size_t{});
+            create(i, Anchor{ui, node});
+        }
+    }
+
+    /* Binds items intersecting the view to slots. Slots are assigned to items
+       in a ring fashion, i.e. an item is always bound to slot
+       `item % slots.size()`, which means that scrolling by a single row
+       rebinds just the slots that went out of the view. If `rebindAll` is
+       set, the bind() callback is called also for slots that are already
+       bound to the same item, exactly once for each. */
+    void bindItems(const bool rebindAll = false) {
+        const std::size_t slotCount = slots.size();
+        if(!slotCount) {
+            itemBegin = itemEnd = 0;
+            return;
+        }
+
+        /* The contents offset is negative. It could be positive only if the
+           scroll area would be scrolled before the begin, which it can't. */
+        const std::size_t firstVisibleRow = std::size_t(Math::max(-contentsOffset, 0.0f)/itemSize.y());
+        const std::size_t firstRow = firstVisibleRow - Math::min(firstVisibleRow, std::size_t(overscanRowCount));
+        itemBegin = Math::min(firstRow*columnCount, itemCount);
+        itemEnd = Math::min(itemBegin + slotCount, itemCount);
+
+        for(std::size_t i = itemBegin; i != itemEnd; ++i) {
+            const std::size_t slotId = i % slotCount;
+            Slot& slot = slots[slotId];
+            if(slot.item == i) {
+                if(rebindAll)
+                    bind(slotId, slot.node, i);
+                continue;
+            }
+
+            if(slot.item == ~std::size_t{})
+                ui.clearNodeFlags(slot.node, NodeFlag::Hidden);
+            slot.item = i;
+            ui.setNodeOffset(slot.node, itemSize*Vector2{Float(i % columnCount), Float(i/columnCount)});
+            bind(slotId, slot.node, i);
+        }
+
+        /* Hide slots that ended up not bound to anything, which happens if
+           there's less items remaining than slots */
+        for(Slot& slot: slots) {
+            if(slot.item != ~std::size_t{} && (slot.item < itemBegin || slot.item >= itemEnd)) {
+                ui.addNodeFlags(slot.node, NodeFlag::Hidden);
+                slot.item = ~std::size_t{};
+            }
+        }
+    }
+
+    UserInterface& ui;
+    NodeHandle contentsNode;
+    Vector2 itemSize;
+    UnsignedInt columnCount;
+    UnsignedInt overscanRowCount = 1;
+    std::size_t itemCount = 0;
+    /* Last known contents offset, updated from the ScrollAreaStorage binding.
+       Is zero or negative. */
+    Float contentsOffset = 0.0f;
+    std::size_t itemBegin = 0, itemEnd = 0;
+    Containers::Array<Slot> slots;
+    Containers::Function<void(std::size_t, const Anchor&)> create;
+    Containers::Function<void(std::size_t, NodeHandle, std::size_t)> bind;
+};
+
+/* The slot pool and the callbacks aren't trivially copyable so they're
+   allocated. The storage is ReferenceCounted in order to be deleted together
+   with the bindings on the contents node, which makes it possible to have the
+   widget non-owned. */
+struct VirtualListStorage: AbstractStorage {
+    explicit VirtualListStorage(DataLayer& layer, UserInterface& ui, NodeHandle contentsNode, const Vector2& itemSize, UnsignedInt columnCount, Containers::Function<void(std::size_t, const Anchor&)>&& create, Containers::Function<void(std::size_t, NodeHandle, std::size_t)>&& bind): AbstractStorage{layer, StorageFlag::ReferenceCounted} {
+        createAllocated(new VirtualListState{ui, contentsNode, itemSize, columnCount, Utility::move(create), Utility::move(bind)}, sizeof(VirtualListState), [](void* data, std::size_t) {
+            delete static_cast<VirtualListState*>(data);
+        });
+    }
+
+    VirtualListState& state() const {
+        return *AbstractStorage::data<VirtualListState>();
+    }
+
+    /* When this changes, the storage is marked as dirty, and setNodeSize()
+       gets called on the contents node */
+    StorageQuery<Vector2> contentsSize() const {
+        return {*this, {}, [](const VirtualListStorage& storage, StorageOperation) {
+            const VirtualListState& state = storage.state();
+            const std::size_t rowCount = (state.itemCount + state.columnCount - 1)/state.columnCount;
+            return state.itemSize*Vector2{Float(state.columnCount), Float(rowCount)};
+        }};
+    }
+
+    /* Called from the scroll area storage binding */
+    /** @todo const for the same reason as ScrollAreaStorage::scrollViewBy() */
+    void scrollTo(Float contentsOffset) const {
+        VirtualListState& state = this->state();
+        state.contentsOffset = contentsOffset;
+        state.bindItems();
+    }
+};
+
+}
+
+VirtualList::VirtualList(const Anchor anchor, const Vector2& itemSize, const UnsignedInt columnCount, Containers::Function<void(std::size_t, const Anchor&)>&& create, Containers::Function<void(std::size_t, NodeHandle, std::size_t)>&& bind, const ScrollAreaFlags flags): ScrollArea{anchor, flags} {
+    CORRADE_ASSERT(!(flags >= ScrollAreaFlag::OnlyX),
+        "Ui::VirtualList:" << ScrollAreaFlag::OnlyX << "is not supported", );
+    CORRADE_ASSERT(itemSize.x() > 0.0f && itemSize.y() > 0.0f,
+        "Ui::VirtualList: expected a positive item size, got" << Debug::packed << itemSize, );
+    CORRADE_ASSERT(columnCount,
+        "Ui::VirtualList: expected a non-zero column count", );
+    CORRADE_ASSERT(create && bind,
+        "Ui::VirtualList: callbacks expected to be non-null", );
+
+    DataLayer& dataLayer = ui().dataLayer();
+    VirtualListStorage storage{dataLayer, ui(), contentsNode(), itemSize, columnCount, Utility::move(create), Utility::move(bind)};
+    _storage = storageHandleStorage(storage.handle());
+
+    /* Resize the contents based on item count. Happens on the first update()
+       and then every time setItemCount() marks the storage as dirty. */
+    {
+        /** @todo clean this up once I can use C++14 named captures */
+        const NodeHandle contentsNode = this->contentsNode();
+        UserInterface& ui = this->ui();
+        storage.contentsSize().onUpdate([&ui, contentsNode](const Vector2& size) {
+            ui.setNodeSize(contentsNode, size);
+        }, contentsNode);
+    }
+
+    /* Rebind items every time the view gets scrolled. The initial call that
+       DataLayer does for all newly created bindings then performs the
+       initial binding. The scroll area view size isn't needed as the slot
+       pool is large enough to cover the whole UI. */
+    {
+        /** @todo clean this up once I can use C++14 named captures */
+        const DataLayerStorageHandle listStorage = _storage;
+        dataLayer.storage<ScrollAreaStorage>(scrollYStorage()).contentsOffset().onUpdate([&dataLayer, listStorage](const Float& offset) {
+            dataLayer.storage<VirtualListStorage>(listStorage).scrollTo(offset);
+        }, contentsNode());
+    }
+}
+
+VirtualList::VirtualList(NonOwnedT, const Anchor anchor, const Vector2& itemSize, const UnsignedInt columnCount, Containers::Function<void(std::size_t, const Anchor&)>&& create, Containers::Function<void(std::size_t, NodeHandle, std::size_t)>&& bind, const ScrollAreaFlags flags): VirtualList{anchor, itemSize, columnCount, Utility::move(create), Utility::move(bind), flags} {
+    makeNonOwned();
+}
+
+Vector2 VirtualList::itemSize() const {
+    return ui().dataLayer().storage<VirtualListStorage>(_storage).state().itemSize;
+}
+
+UnsignedInt VirtualList::columnCount() const {
+    return ui().dataLayer().storage<VirtualListStorage>(_storage).state().columnCount;
+}
+
+std::size_t VirtualList::itemCount() const {
+    return ui().dataLayer().storage<VirtualListStorage>(_storage).state().itemCount;
+}
+
+VirtualList& VirtualList::setItemCount(const std::size_t count) {
+    const VirtualListStorage storage = ui().dataLayer().storage<VirtualListStorage>(_storage);
+    VirtualListState& state = storage.state();
+    if(state.itemCount == count)
+        return *this;
+
+    state.itemCount = count;
+    state.growSlots();
+    state.bindItems();
+    /* Makes the contents resized on the next update() */
+    storage.setDirty();
+    return *this;
+}
+
+UnsignedInt VirtualList::overscanRowCount() const {
+    return ui().dataLayer().storage<VirtualListStorage>(_storage).state().overscanRowCount;
+}
+
+VirtualList& VirtualList::setOverscanRowCount(const UnsignedInt count) {
+    VirtualListState& state = ui().dataLayer().storage<VirtualListStorage>(_storage).state();
+    state.overscanRowCount = count;
+    state.growSlots();
+    state.bindItems();
+    return *this;
+}
+
+VirtualList& VirtualList::refresh() {
+    VirtualListState& state = ui().dataLayer().storage<VirtualListStorage>(_storage).state();
+    state.growSlots();
+    /* Slots that are already bound to the same item get the callback called
+       again, slots that got a new item only once */
+    state.bindItems(true);
+    return *this;
+}
+
+std::size_t VirtualList::slotCount() const {
+    return ui().dataLayer().storage<VirtualListStorage>(_storage).state().slots.size();
+}
+
+NodeHandle VirtualList::slotNode(const std::size_t slot) const {
+    const VirtualListState& state = ui().dataLayer().storage<VirtualListStorage>(_storage).state();
+    CORRADE_ASSERT(slot < state.slots.size(),
+        "Ui::VirtualList::slotNode(): index" << slot << "out of range for" << state.slots.size() << "slots", {});
+    return state.slots[slot].node;
+}
+
+std::size_t VirtualList::slotItem(const std::size_t slot) const {
+    const VirtualListState& state = ui().dataLayer().storage<VirtualListStorage>(_storage).state();
+    CORRADE_ASSERT(slot < state.slots.size(),
+        "Ui::VirtualList::slotItem(): index" << slot << "out of range for" << state.slots.size() << "slots", {});
+    return state.slots[slot].item;
+}
+
+Containers::Pair<std::size_t, std::size_t> VirtualList::boundItemRange() const {
+    const VirtualListState& state = ui().dataLayer().storage<VirtualListStorage>(_storage).state();
+    return {state.itemBegin, state.itemEnd};
+}
+
+}}
@@ -0,0 +1,186 @@
+#ifndef Magnum_Ui_VirtualList_h
+#define Magnum_Ui_VirtualList_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022, 2023, 2024, 2025, 2026
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Ui::VirtualList
+ * @m_since_latest_{extras}
+ */
+
+#include "Magnum/Ui/ScrollArea.h"
+
+namespace Magnum { namespace Ui {
+
+/**
+@brief Virtualized item list or grid widget
+@m_since_latest_{extras}
+
+A vertically scrolling @ref ScrollArea that doesn't create a node for every
+item. Instead it keeps a pool of *slots*, each being a single node placed in
+@ref contents(), and binds them to actual items based on which of them
+intersect the view, plus a configurable number of overscan rows above and
+below. The pool is sized to cover the whole @ref AbstractUserInterface::size()
+and thus the memory use and the per-scroll cost depend only on the view size,
+not on @ref itemCount().
+
+Each slot is populated once using the @p create callback passed to the
+constructor, for example by creating a @ref Label in it, and then the @p bind
+callback is called every time the slot gets assigned to a different item, for
+example to update the label text. Items are laid out in rows of
+@ref columnCount() items, each being @ref itemSize() large. With a column
+count of @cpp 1 @ce the widget is a list, with more than one it's a grid.
+
+Items get rebound from a @ref DataLayer binding on the vertical scroll
+storage, i.e. during @ref AbstractUserInterface::update(), and only the slots
+that changed their item get the @p bind callback called. If the underlying
+data change without the item count changing, call @ref refresh() to rebind
+all currently visible items.
+*/
+class MAGNUM_UI_EXPORT VirtualList: public ScrollArea {
+    public:
+        /**
+         * @brief Constructor
+         * @param anchor        Positioning anchor
+         * @param itemSize      Size of a single item
+         * @param columnCount   Count of items in a single row
+         * @param create        Function called once for every newly created
+         *      slot, receiving the slot index and an anchor for the slot node
+         * @param bind          Function called every time a slot gets bound
+         *      to a different item, receiving the slot index, the slot node
+         *      and the item index
+         * @param flags         Scroll area flags
+         *
+         * Expects that @p itemSize is positive, @p columnCount is non-zero and
+         * @p flags don't contain @ref ScrollAreaFlag::OnlyX. The item count
+         * is initially @cpp 0 @ce, use @ref setItemCount() to populate the
+         * list.
+         */
+        explicit VirtualList(Anchor anchor, const Vector2& itemSize, UnsignedInt columnCount, Containers::Function<void(std::size_t slot, const Anchor& anchor)>&& create, Containers::Function<void(std::size_t slot, NodeHandle node, std::size_t item)>&& bind, ScrollAreaFlags flags = {});
+
+        /**
+         * @brief Construct a non-owned virtual list
+         *
+         * Like @ref VirtualList(Anchor, const Vector2&, UnsignedInt, Containers::Function<void(std::size_t, const Anchor&)>&&, Containers::Function<void(std::size_t, NodeHandle, std::size_t)>&&, ScrollAreaFlags)
+         * but the widget node doesn't get removed on destruction. The slot
+         * pool and the callbacks are kept alive as long as the widget node
+         * exists, independently of the widget instance.
+         * @see @ref isOwned()
+         */
+        explicit VirtualList(NonOwnedT, Anchor anchor, const Vector2& itemSize, UnsignedInt columnCount, Containers::Function<void(std::size_t slot, const Anchor& anchor)>&& create, Containers::Function<void(std::size_t slot, NodeHandle node, std::size_t item)>&& bind, ScrollAreaFlags flags = {});
+
+        /** @copydoc AbstractWidget::AbstractWidget(NoCreateT) */
+        explicit VirtualList(NoCreateT): ScrollArea{NoCreate}, _storage{} {}
+
+        /** @brief Item size */
+        Vector2 itemSize() const;
+
+        /** @brief Count of items in a single row */
+        UnsignedInt columnCount() const;
+
+        /** @brief Item count */
+        std::size_t itemCount() const;
+
+        /**
+         * @brief Set item count
+         * @return Reference to self (for method chaining)
+         *
+         * Resizes @ref contents() to fit all items, grows the slot pool if
+         * needed and rebinds the visible items. Slots that don't have any item
+         * to bind to are hidden. The pool never shrinks.
+         */
+        VirtualList& setItemCount(std::size_t count);
+
+        /**
+         * @brief Overscan row count
+         *
+         * Count of rows materialized above and below the visible area to
+         * avoid visible pop-in when scrolling. Default is @cpp 1 @ce.
+         */
+        UnsignedInt overscanRowCount() const;
+
+        /**
+         * @brief Set overscan row count
+         * @return Reference to self (for method chaining)
+         *
+         * Grows the slot pool if needed and rebinds the visible items.
+         */
+        VirtualList& setOverscanRowCount(UnsignedInt count);
+
+        /**
+         * @brief Rebind all bound slots
+         * @return Reference to self (for method chaining)
+         *
+         * Calls the @p bind function passed to the constructor again for all
+         * slots that are currently bound to an item. Use when the data source
+         * changed without the item count changing. Also grows the slot pool
+         * if @ref AbstractUserInterface::size() got larger since the last
+         * time.
+         */
+        VirtualList& refresh();
+
+        /**
+         * @brief Slot count
+         *
+         * Count of slot nodes created so far. At most @ref itemCount().
+         */
+        std::size_t slotCount() const;
+
+        /**
+         * @brief Slot node
+         *
+         * Expects that @p slot is less than @ref slotCount().
+         */
+        NodeHandle slotNode(std::size_t slot) const;
+
+        /**
+         * @brief Item bound to a slot
+         *
+         * Expects that @p slot is less than @ref slotCount(). If the slot
+         * isn't bound to any item and thus its node is hidden, returns
+         * @cpp ~std::size_t{} @ce.
+         */
+        std::size_t slotItem(std::size_t slot) const;
+
+        /**
+         * @brief Range of currently bound items
+         *
+         * Begin and end of the contiguous range of items that are currently
+         * bound to slots, including the overscan rows.
+         */
+        Containers::Pair<std::size_t, std::size_t> boundItemRange() const;
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        _MAGNUM_UI_WIDGET_SUBCLASS_IMPLEMENTATION(VirtualList) /* LCOV_EXCL_LINE */
+        #endif
+
+    private:
+        DataLayerStorageHandle _storage;
+};
+
+}}
+
+#endif